@@ -7,6 +7,42 @@
 // Purpose:	A quick test bench to determine if the basic cordic module
 //		works.
 //
+//	Given -j <n> (or TB_THREADS=<n>), the phase sweep is split across n
+//	independent copies of the core, each on its own thread.
+//
+//	Tracing is off unless --trace, --trace-window=<start>:<stop>, or
+//	--trace-ring=<cycles> is given.  See testb.h for details.
+//
+//	The SFDR is estimated from 2^20 point segments of the sweep (see
+//	spectrum.h), or 2^<lg> point segments given --fft=<lg>.
+//
+//	Given --search[=<probes>], rather than sweeping every phase, the test
+//	bench hunts for the worst case error instead (see errsearch.h), and
+//	checks only that.
+//
+//	Given --lockstep, every output of either is also checked, bit for bit,
+//	against the core's software model as it emerges, and the test stops
+//	at the first mismatch.
+//
+//	Given --dump[=<file>], every input of the sweep, the output it
+//	produced, and the output it should have produced are written to
+//	<core>_tb.dump (or <file>), in the format described in resdump.h.
+//
+//	Given --profile[=<file>], the time of the run is split between
+//	Verilator's eval(), tracing, lockstep checks, stimulus, the FFTs, and
+//	the closing statistics, with a progress line every second and a JSON
+//	summary written on exit to <core>_tb.profile.json (or <file>).  See
+//	profile.h.
+//
+//	Inputs to a pipelined core are queued up, and clocked into it
+//	TB_BATCH clocks at a time through TESTB::tick_fast().
+//
+//	A core shared between channels (-DCHANNELS) is handed each sample on
+//	a channel picked at random, and every result must come back out on
+//	the channel it went in on.  Should each channel keep its own phase,
+//	the phase each sample needs is reached by stepping its channel's
+//	phase there.
+//
 // Creator:	Dan Gisselquist, Ph.D.
 //		Gisselquist Technology, LLC
 //
@@ -40,24 +76,144 @@
 
 #include <verilated.h>
 #include <verilated_vcd_c.h>
-#ifdef	CLOCKS_PER_OUTPUT
+#if	defined(CLOCKS_PER_OUTPUT) && defined(ITERATIVE)
+# include "Vitercordic.h"
+# include "itercordic.h"
+# include "itercordic_model.h"
+# define MODEL_P2R itercordic_p2r
+# define BASECLASS Vitercordic
+# define CORE_MODEL itercordic_model_t
+# define CORENAME "itercordic"
+# define VCDNAME "itercordic_tb.vcd"
+#elif	defined(CLOCKS_PER_OUTPUT) && defined(ENGINES)
+# include "Vmulticordic.h"
+# include "multicordic.h"
+# include "multicordic_model.h"
+# define MODEL_P2R multicordic_p2r
+# define BASECLASS Vmulticordic
+# define CORENAME "multicordic"
+# define VCDNAME "multicordic_tb.vcd"
+#elif	defined(CLOCKS_PER_OUTPUT)
 # include "Vseqcordic.h"
 # include "seqcordic.h"
+# include "seqcordic_model.h"
+# define MODEL_P2R seqcordic_p2r
 # define BASECLASS Vseqcordic
+# define CORENAME "seqcordic"
+# define VCDNAME "seqcordic_tb.vcd"
+#elif	defined(CHANNELS)
+# include "Vtdmcordic.h"
+# include "tdmcordic.h"
+# include "tdmcordic_model.h"
+# define MODEL_P2R tdmcordic_p2r
+# define BASECLASS Vtdmcordic
+# define CORE_MODEL tdmcordic_model_t
+# define CORENAME "tdmcordic"
+# define VCDNAME "tdmcordic_tb.vcd"
+#elif	defined(PAIRED)
+# include "Vpaircordic.h"
+# include "paircordic.h"
+# include "paircordic_model.h"
+# define MODEL_P2R paircordic_p2r
+# define BASECLASS Vpaircordic
+# define CORE_MODEL paircordic_model_t
+# define CORENAME "paircordic"
+# define VCDNAME "paircordic_tb.vcd"
+#elif	defined(RADIX4)
+# include "Vradix4cordic.h"
+# include "radix4cordic.h"
+# include "radix4cordic_model.h"
+# define MODEL_P2R radix4cordic_p2r
+# define BASECLASS Vradix4cordic
+# define CORENAME "radix4cordic"
+# define VCDNAME "radix4cordic_tb.vcd"
+#elif	defined(HYBRID)
+# include "Vhybridcordic.h"
+# include "hybridcordic.h"
+# include "hybridcordic_model.h"
+# define MODEL_P2R hybridcordic_p2r
+# define BASECLASS Vhybridcordic
+# define CORENAME "hybridcordic"
+# define VCDNAME "hybridcordic_tb.vcd"
 #else
 # include "Vcordic.h"
 # include "cordic.h"
+# include "cordic_model.h"
+# define MODEL_P2R cordic_p2r
 # define BASECLASS Vcordic
+# define CORE_MODEL cordic_model_t
+# define CORENAME "cordic"
+# define VCDNAME "cordic_tb.vcd"
 #endif
-#include "fft.h"
 #include "testb.h"
+#include "shard.h"
+#include "errstats.h"
+#include "spectrum.h"
+#include "errsearch.h"
+#include "resdump.h"
+
+//
+// LOCKSTEP_IN
+//
+// An input the core has accepted, kept until its output can be checked
+// against the software model.
+typedef	struct	{
+	unsigned long	clock;
+	int32_t		xval, yval;
+	uint32_t	phase;
+} LOCKSTEP_IN;
+
+//
+// CORDIC_OUT
+//
+// A result, as the core produced it.
+typedef	struct	{
+	uint32_t	xval, yval;
+} CORDIC_OUT;
+
+#if	!defined(CLOCKS_PER_OUTPUT) && !defined(CHANNELS)
+// The most clocks queue() will hold before feeding them to the core.  The
+// results of a batch must fit within a SAMPLE_FIFO.
+#define	TB_BATCH	128
+#endif
 
 class	CORDIC_TB : public TESTB<BASECLASS> {
 	bool		m_debug;
+	SAMPLE_FIFO<LOCKSTEP_IN>	m_lsfifo;
+#ifdef	CHANNELS
+	// The channel of each sample, until its result comes back out, and
+	// the generator picking those channels
+	SAMPLE_FIFO<int>	m_chanq;
+	uint32_t		m_chrng;
+#ifdef	PHASE_ACCUMULATOR
+	// Each channel's phase, as stepped by the test bench, and as followed
+	// from the core's inputs by lockstep_in()
+	uint32_t		m_chphase[NCHANNELS], m_lsphase[NCHANNELS];
+#endif
+#endif
+#ifdef	TB_BATCH
+	// The inputs of each clock queued, and yet to be fed to the core
+	uint32_t	m_bphase[TB_BATCH];
+	uint8_t		m_baux[TB_BATCH];
+	int		m_nbatch;
+#endif
 public:
+	// Every result the core has produced, in order, until it is read
+	SAMPLE_FIFO<CORDIC_OUT>	m_outq;
 
 	CORDIC_TB(void) {
 		m_debug = true;
+#ifdef	TB_BATCH
+		m_nbatch = 0;
+#endif
+#ifdef	CHANNELS
+		m_chrng = 1;
+		m_core->i_chan = 0;
+#ifdef	PHASE_ACCUMULATOR
+		for(int k=0; k<NCHANNELS; k++)
+			m_chphase[k] = m_lsphase[k] = 0;
+#endif
+#endif
 #ifdef	CLOCKS_PER_OUTPUT
 		m_core->i_stb   = 0;
 #else	// CLOCKS_PER_OUTPUT
@@ -76,118 +232,184 @@ public:
 		tick();
 #endif
 	}
-};
 
-const int	LGNSAMPLES=PW;
-const int	NSAMPLES=(1ul<<LGNSAMPLES);
+	// Keeps the core's result, should it have just produced one
+	void	collect(void) {
+		CORDIC_OUT	out;
 
-int main(int  argc, char **argv) {
-	Verilated::commandArgs(argc, argv);
-	CORDIC_TB	*tb = new CORDIC_TB;
-	int	*pdata, *xval, *yval,
-		*ixval, *iyval, idx;
-	double	scale;
+#ifdef	CLOCKS_PER_OUTPUT
+		if (!m_core->o_done)
+			return;
+#endif
+		if (!m_core->o_aux)
+			return;
+		out.xval = m_core->o_xval;
+		out.yval = m_core->o_yval;
+		m_outq.push(out);
 
-	pdata = new int[NSAMPLES];
-	xval  = new int[NSAMPLES];
-	yval  = new int[NSAMPLES];
-	ixval  = new int[NSAMPLES];
-	iyval  = new int[NSAMPLES];
+#ifdef	CHANNELS
+		int	chan = (m_chanq.empty()) ? -1 : m_chanq.pop();
 
-	// This only works on DUT's with the aux flag turned on.
-	assert(HAS_AUX);
+		TBASSERT(*this, chan == (int)m_core->o_chan);
+#endif
+	}
 
-#ifdef	CLOCKS_PER_OUTPUT
-	tb->opentrace("seqcordic_tb.vcd");
-#else
-	tb->opentrace("cordic_tb.vcd");
+#ifdef	TB_BATCH
+	// Queues up the inputs now on the core for the next clock, feeding
+	// them (and every clock queued before them) to the core once the
+	// queue is full.  With a trace open, the queue is fed every clock, so
+	// that any failure is caught while its clocks are still in the ring.
+	void	queue(void) {
+		m_bphase[m_nbatch] = m_core->i_phase;
+		m_baux[m_nbatch++] = m_core->i_aux;
+		if ((m_nbatch >= TB_BATCH)||(m_trace))
+			feed();
+	}
+
+	void	feed(void) {
+		tick_fast(m_nbatch, *this);
+		m_nbatch = 0;
+	}
+
+	// tick_fast()'s hooks, from within feed()
+	void	fast_in(unsigned long k) {
+		m_core->i_phase = m_bphase[k];
+		m_core->i_aux   = m_baux[k];
+	}
+
+	void	fast_out(unsigned long k) { (void)k; collect(); }
 #endif
-	tb->reset();
 
-	scale  = tb->m_core->i_xval * (double)tb->m_core->i_xval;
-	scale += tb->m_core->i_yval * (double)tb->m_core->i_yval;
-	scale  = sqrt(scale);
+#ifdef	CHANNELS
+	// Puts the sample now on the core's inputs onto a channel picked at
+	// random.  With a phase per channel, i_phase becomes the step taking
+	// that channel's phase to the one the sample needs.
+	void	channel_in(void) {
+		int	chan;
+
+		m_chrng = m_chrng * 1103515245u + 12345u;
+		chan = (m_chrng >> 16) % NCHANNELS;
+		m_core->i_chan = chan;
+		if (m_core->i_aux)
+			m_chanq.push(chan);
+#ifdef	PHASE_ACCUMULATOR
+		const uint32_t	pmsk = (PW >= 32) ? 0xffffffffu : ((1u<<PW)-1);
+		uint32_t	phase = m_core->i_phase;
+
+		m_core->i_phase = (phase - m_chphase[chan]) & pmsk;
+		m_chphase[chan] = phase;
+#endif
+	}
+#endif
 
-	idx = 0;
-	for(int i=0; i<NSAMPLES; i++) {
-		int	shift = (PW-LGNSAMPLES);
-		if (shift < 0) {
-			int	sv = i;
-			if (i & (1ul<<(-shift)))
-				// Odd value, round down
-				sv += (1ul<<(-shift-1))-1;
-			else
-				sv += (1ul<<(-shift-1));
-			tb->m_core->i_phase = sv >> (-shift);
-		} else
-			tb->m_core->i_phase = i << shift;
-		pdata[i] = tb->m_core->i_phase;
-		ixval[i] = tb->m_core->i_xval;
-		iyval[i] = tb->m_core->i_yval;
-		tb->m_core->i_aux   = 1;
+	void	lockstep_in(void) {
+		LOCKSTEP_IN	in;
+#ifdef	PHASE_ACCUMULATOR
+		const uint32_t	pmsk = (PW >= 32) ? 0xffffffffu : ((1u<<PW)-1);
 
-#ifdef	CLOCKS_PER_OUTPUT
-		tb->m_core->i_stb = 1;
-		for(int j=0; j<CLOCKS_PER_OUTPUT-1; j++) {
-			tb->tick();
-			tb->m_core->i_stb = 0;
-			assert(!tb->m_core->o_done);
-		}
+		// Every sample steps its channel's phase, whether or not its
+		// result is to be checked
+		if (m_core->i_ce)
+			m_lsphase[m_core->i_chan] = (m_lsphase[m_core->i_chan]
+					+ m_core->i_phase) & pmsk;
+#endif
 
-		tb->tick();
-		assert(tb->m_core->o_done);
-		assert(tb->m_core->o_aux);
+#ifdef	CLOCKS_PER_OUTPUT
+		if ((!m_core->i_stb)||(m_core->o_busy)||(!m_core->i_aux))
+			return;
 #else
-		tb->tick();
+		if ((!m_core->i_ce)||(!m_core->i_aux))
+			return;
 #endif
-
-		if (tb->m_core->o_aux) {
-			shift = (8*sizeof(int)-OW);
-			// Make our values signed..
-			xval[idx] = tb->m_core->o_xval << (shift);
-			yval[idx] = tb->m_core->o_yval << (shift);
-			xval[idx] >>= shift;
-			yval[idx] >>= shift;
-			// printf("%08x<<%d: %08x %08x\n", (unsigned)pdata[i], shift, xval[idx], yval[idx]);
-			idx++;
-		}
+		in.clock = m_tickcount;
+		in.xval  = m_core->i_xval;
+		in.yval  = m_core->i_yval;
+#ifdef	PHASE_ACCUMULATOR
+		in.phase = m_lsphase[m_core->i_chan];
+#else
+		in.phase = m_core->i_phase;
+#endif
+		m_lsfifo.push(in);
 	}
 
-#ifndef	CLOCKS_PER_OUTPUT
-	tb->m_core->i_aux = 0;
-	while(tb->m_core->o_aux) {
-		int	shift = (8*sizeof(int)-OW);
-		tb->m_core->i_aux   = 0;
-		tb->tick();
+	int	lockstep_out(char *msg, size_t len) {
+		const uint32_t	omsk = (OW >= 32) ? 0xffffffffu : ((1u<<OW)-1);
+		int32_t		mx, my;
 
-		if (tb->m_core->o_aux) {
-			xval[idx] = tb->m_core->o_xval << (shift);
-			yval[idx] = tb->m_core->o_yval << (shift);
-			xval[idx] >>= shift;
-			yval[idx] >>= shift;
-			// printf("%08x %08x\n", xval[idx], yval[idx]);
-			idx++;
-			assert(idx <= NSAMPLES);
+#ifdef	CLOCKS_PER_OUTPUT
+		if (!m_core->o_done)
+			return 0;
+#endif
+		if (!m_core->o_aux)
+			return 0;
+		if (m_lsfifo.empty()) {
+			snprintf(msg, len, "an output, with no input to match it");
+			return -1;
 		}
+
+		const LOCKSTEP_IN	&in = m_lsfifo.pop();
+
+		MODEL_P2R(in.xval, in.yval, in.phase, &mx, &my);
+		if (((((uint32_t)m_core->o_xval ^ (uint32_t)mx)
+				|((uint32_t)m_core->o_yval ^ (uint32_t)my))
+					& omsk) == 0)
+			return 1;
+
+		snprintf(msg, len, "(0x%x, 0x%x) at phase 0x%x, given on "
+			"clock %lu, became (0x%x, 0x%x), not (0x%x, 0x%x)",
+			(uint32_t)in.xval & ((1u<<IW)-1),
+			(uint32_t)in.yval & ((1u<<IW)-1), in.phase, in.clock,
+			(uint32_t)m_core->o_xval & omsk,
+			(uint32_t)m_core->o_yval & omsk,
+			(uint32_t)mx & omsk, (uint32_t)my & omsk);
+		return -1;
 	}
+};
+
+const int	LGNSAMPLES=PW;
+const long	NSAMPLES=(1l<<LGNSAMPLES);
+
+// The clocks each sample takes, for the --profile ETA
+#if	defined(CLOCKS_PER_OUTPUT) && defined(NENGINES)
+const long	TICKS_PER_SAMPLE=(CLOCKS_PER_OUTPUT+NENGINES-1)/NENGINES;
+#elif	defined(CLOCKS_PER_OUTPUT)
+const long	TICKS_PER_SAMPLE=CLOCKS_PER_OUTPUT;
+#else
+const long	TICKS_PER_SAMPLE=1;
 #endif
 
-	double	mxerr = 0.0, averr = 0.0, mag = 0, imag=0, sumxy = 0.0,
-		sumsq = 0.0, sumd = 0.0;
-	for(int i=0; i<NSAMPLES; i++) {
-		int	odata[5], shift;
-		double	ph, dxval, dyval, err;
+//
+// CORDIC_IN
+//
+// What went into the core, kept only until the result comes back out.
+typedef	struct	{
+	long	idx;
+	int	phase, ixval, iyval;
+} CORDIC_IN;
+
+//
+// CORDIC_STATS
+//
+// Running totals of everything the test bench needs to know about the
+// results.  Each shard keeps its own, and they are merged at the end.
+class	CORDIC_STATS {
+public:
+	ERRSTAT	err;
+	double	mag, imag, sumxy, sumsq, sumd;
+
+	CORDIC_STATS(void) : mag(0.0), imag(0.0), sumxy(0.0), sumsq(0.0),
+			sumd(0.0) {}
 
-		odata[0] = pdata[i];
-		odata[1] = ixval[i];
-		odata[2] = iyval[i];
-		odata[3] = xval[i];
-		odata[4] = yval[i];
+	// Returns the expected output for input in, scaled to output units
+	static void	predict(const CORDIC_IN &in, double &dxval,
+			double &dyval) {
+		double	ph;
+		int	shift;
 
-		ph = odata[0];
-		ph = ph * M_PI * 2.0 / (double)(1u<<PW);
-		dxval = cos(ph) * ixval[i] - sin(ph) * iyval[i];
-		dyval = sin(ph) * ixval[i] + cos(ph) * iyval[i];
+		ph = in.phase;
+		ph = ph * M_PI * 2.0 / (double)(1ul<<PW);
+		dxval = cos(ph) * in.ixval - sin(ph) * in.iyval;
+		dyval = sin(ph) * in.ixval + cos(ph) * in.iyval;
 
 		dxval *= GAIN;
 		dyval *= GAIN;
@@ -200,7 +422,13 @@ int main(int  argc, char **argv) {
 			dxval *= 1./(double)(1u>>(-shift));
 			dyval *= 1./(double)(1u>>(-shift));
 		}
+	}
+
+	// Returns the magnitude of the error in this sample
+	double	add(const CORDIC_IN &in, int xval, int yval) {
+		double	dxval, dyval, e;
 
+		predict(in, dxval, dyval);
 
 		// Solve min_a sum (d-a*v)^2
 		//	min_a sum d^2 + a*d*v + a^2 v*v
@@ -208,38 +436,391 @@ int main(int  argc, char **argv) {
 		// a = sumxw / 2 / sumsq
 		//
 		// Measure the magnitude of what we placed into the input
-		imag+=ixval[i] *(double)ixval[i] +iyval[i] *(double)iyval[i];
+		imag+=in.ixval *(double)in.ixval +in.iyval *(double)in.iyval;
 		// The magnitude we get on the output
-		mag += xval[i] * (double)xval[i] + yval[i] * (double)yval[i];
+		mag += xval * (double)xval + yval * (double)yval;
 		// The error between the value requested and the value resulting
-		err = (dxval - xval[i]) * (dxval - xval[i]);
-		err+= (dyval - yval[i]) * (dyval - yval[i]);
+		e = (dxval - xval) * (dxval - xval);
+		e+= (dyval - yval) * (dyval - yval);
 
 		// Let's run some other tests, to see if we managed to get the
 		// gain right
-		sumxy += dxval * xval[i];
-		sumxy += dyval * yval[i];
-		sumsq += xval[i] * (double)xval[i] + yval[i]*(double)yval[i];
+		sumxy += dxval * xval;
+		sumxy += dyval * yval;
+		sumsq += xval * (double)xval + yval*(double)yval;
 		sumd  += dxval   *dxval    +dyval * dyval;
-		averr += err;
+
+		e = sqrt(e);
+		err.add(e);
 
 		if (PW<10) {
 		printf("%6d %6d -> %9.2f %9.2f (predicted) -> %f err (%f), mag=%f\n",
-			xval[i], yval[i], dxval, dyval, err, averr, mag);
+			xval, yval, dxval, dyval, e*e, err.m_sumsq, mag);
 		}
-		err = sqrt(err);
-		if (err > mxerr)
-			mxerr = err;
+
+		return e;
 	}
 
+	void	merge(const CORDIC_STATS &s) {
+		err.merge(s.err);
+		mag   += s.mag;
+		imag  += s.imag;
+		sumxy += s.sumxy;
+		sumsq += s.sumsq;
+		sumd  += s.sumd;
+	}
+};
+
+static	CORDIC_STATS	stats[MAX_SHARDS];
+static	SPECTRUM	spectra[MAX_SHARDS];
+static	TRACEOPTS	traceopts;
+static	bool		lockstep;
+static	unsigned	lgfft;
+// The results of the sweep, should --dump ask for them
+static	RESDUMP		dump;
+static	int		dcol_phase, dcol_ixval, dcol_iyval, dcol_oxval,
+			dcol_oyval, dcol_xref, dcol_yref;
+
+//
+// step
+//
+// Clocks one sample into the core, and (eventually) one result out, onto
+// tb->m_outq.  A pipelined core is fed TB_BATCH samples at a time, so a
+// result may not show up until the step that fills the batch.
+static void	step(CORDIC_TB *tb) {
+#if	defined(CLOCKS_PER_OUTPUT) && defined(NENGINES)
+	// Hold the sample until an engine is free to take it.  Any of the
+	// others may finish in the meantime.
+	bool	accepted;
+
+	tb->m_core->i_stb = 1;
+	do {
+		accepted = !tb->m_core->o_busy;
+		tb->tick();
+		tb->collect();
+	} while(!accepted);
+	tb->m_core->i_stb = 0;
+#elif	defined(CLOCKS_PER_OUTPUT)
+	tb->m_core->i_stb = 1;
+	for(int j=0; j<CLOCKS_PER_OUTPUT-1; j++) {
+		tb->tick();
+		tb->m_core->i_stb = 0;
+		TBASSERT(*tb, !tb->m_core->o_done);
+	}
+
+	tb->tick();
+	TBASSERT(*tb, tb->m_core->o_done);
+	TBASSERT(*tb, tb->m_core->o_aux);
+	tb->collect();
+#elif	defined(CHANNELS)
+	uint32_t	phase = tb->m_core->i_phase;
+
+	tb->channel_in();
+	tb->tick();
+	// Leave i_phase as the phase wanted, rather than the step to it
+	tb->m_core->i_phase = phase;
+	tb->collect();
+#else
+	tb->queue();
+#endif
+}
+
+//
+// result
+//
+// Reads the (sign extended) result of input res from the core's output, out.
+static void	result(CORDIC_TB *tb, const CORDIC_OUT &out, const CORDIC_IN &res,
+		int &xval, int &yval) {
+	const int	oshift = (8*sizeof(int)-OW);
+
+	xval = out.xval << (oshift);
+	yval = out.yval << (oshift);
+	xval >>= oshift;
+	yval >>= oshift;
+#if	defined(CORE_MODEL) && (__cplusplus >= 201402L)
+	// The header's template model must match bit for bit
+	{
+		int32_t	mx, my;
+
+		CORE_MODEL::p2r(res.ixval, res.iyval,
+			(uint32_t)res.phase, &mx, &my);
+		TBASSERT(*tb, (mx == xval)&&(my == yval));
+	}
+#else
+	(void)res;
+#endif
+}
+
+//
+// max_error
+//
+// The largest error any one sample should have, given the quantization and
+// phase variances the generator predicted.
+static double	max_error(void) {
+	return 5.2 * sqrt(QUANTIZATION_VARIANCE
+			+ PHASE_VARIANCE_RAD*GAIN*GAIN
+				*((1ul<<(IW-1))-1)*(double)((1ul<<(IW-1))-1));
+}
+
+//
+// sweep
+//
+// Runs the samples [lo,hi) through a freshly built and reset core,
+// accumulating the error statistics and the spectrum of the samples as they
+// emerge.  lo and hi must fall on spectral segment boundaries.
+static void	sweep(int shard, long lo, long hi, void *arg) {
+	CORDIC_TB	*tb = new CORDIC_TB;
+	SAMPLE_FIFO<CORDIC_IN>	fifo;
+	CORDIC_STATS	*st = &stats[shard];
+	SPECTRUM	*sp = &spectra[shard];
+	RESDUMP_SHARD	ds(&dump, lo);
+	CORDIC_IN	in;
+	long		nout;
+	const double	mxerr = max_error();
+
+	// Only the first shard gets a trace--unless we are keeping a trace
+	// ring, in which case every shard keeps its own.
+	if (shard == 0)
+		tb->opentrace(traceopts, VCDNAME);
+	else if (traceopts.mode == TRACE_RING) {
+		char	fname[64];
+
+		sprintf(fname, "%.*s-%d.vcd", (int)strlen(VCDNAME)-4,
+			VCDNAME, shard);
+		tb->opentrace(traceopts, fname);
+	}
+	tb->reset();
+	tb->lockstep(lockstep);
+
+	sp->init(LGNSAMPLES, lgfft);
+
+	nout = 0;
+	for(long i=lo; i<hi || !fifo.empty(); i++) {
+		if (i < hi) {
+			long	p = sp->sweep_index(i);
+			int	shift = (PW-LGNSAMPLES);
+			if (shift < 0) {
+				int	sv = p;
+				if (p & (1ul<<(-shift)))
+					// Odd value, round down
+					sv += (1ul<<(-shift-1))-1;
+				else
+					sv += (1ul<<(-shift-1));
+				tb->m_core->i_phase = sv >> (-shift);
+			} else
+				tb->m_core->i_phase = p << shift;
+			in.idx   = i;
+			in.phase = tb->m_core->i_phase;
+			in.ixval = tb->m_core->i_xval;
+			in.iyval = tb->m_core->i_yval;
+			fifo.push(in);
+			tb->m_core->i_aux   = 1;
+		} else
+			tb->m_core->i_aux   = 0;
+
+		step(tb);
+
+		while(!tb->m_outq.empty()) {
+			const CORDIC_OUT	&out = tb->m_outq.pop();
+			int	xval, yval;
+
+			TBASSERT(*tb, !fifo.empty());
+			const CORDIC_IN	&res = fifo.pop();
+
+			result(tb, out, res, xval, yval);
+			// printf("%08x<<%d: %08x %08x\n", (unsigned)res.phase, oshift, xval, yval);
+			sp->m_seg[res.idx & (sp->m_fftlen-1)]
+						= COMPLEX(xval, yval);
+			if ((res.idx & (sp->m_fftlen-1)) == sp->m_fftlen-1)
+				sp->add();
+
+			// When keeping a trace ring, save it as soon as any
+			// one sample exceeds the maximum error threshold.
+			if ((st->add(res, xval, yval) > mxerr)
+					&&(traceopts.mode == TRACE_RING))
+				tb->failtrace();
+
+			if (ds.active()) {
+				double	dxval, dyval;
+
+				CORDIC_STATS::predict(res, dxval, dyval);
+				ds.i32(dcol_phase, res.phase);
+				ds.i32(dcol_ixval, res.ixval);
+				ds.i32(dcol_iyval, res.iyval);
+				ds.i32(dcol_oxval, xval);
+				ds.i32(dcol_oyval, yval);
+				ds.f64(dcol_xref,  dxval);
+				ds.f64(dcol_yref,  dyval);
+				ds.next();
+			}
+			nout++;
+		}
+	}
+	TBASSERT(*tb, nout == hi-lo);
+	ds.flush();
+
+	sp->release();
+	delete tb;
+}
+
+//
+// CORDIC_SEARCH
+//
+// The core, and the running statistics, shared by every probe of a search.
+typedef	struct	{
+	CORDIC_TB	*tb;
+	CORDIC_STATS	st;
+	double		mxerr;
+} CORDIC_SEARCH;
+
+//
+// probe
+//
+// Runs each of n phases through the core, rotating the same input vector
+// the sweep does, and returns the error of each result.
+static void	probe(const long *pts, int n, double *err, void *arg) {
+	CORDIC_SEARCH	*s = (CORDIC_SEARCH *)arg;
+	CORDIC_TB	*tb = s->tb;
+	SAMPLE_FIFO<CORDIC_IN>	fifo;
+	CORDIC_IN	in;
+	int		nout = 0;
+
+	for(int i=0; i<n || !fifo.empty(); i++) {
+		if (i < n) {
+			tb->m_core->i_phase = pts[i];
+			in.idx   = i;
+			in.phase = tb->m_core->i_phase;
+			in.ixval = tb->m_core->i_xval;
+			in.iyval = tb->m_core->i_yval;
+			fifo.push(in);
+			tb->m_core->i_aux   = 1;
+		} else
+			tb->m_core->i_aux   = 0;
+
+		step(tb);
+
+		while(!tb->m_outq.empty()) {
+			const CORDIC_OUT	&out = tb->m_outq.pop();
+			int	xval, yval;
+
+			TBASSERT(*tb, !fifo.empty());
+			const CORDIC_IN	&res = fifo.pop();
+
+			result(tb, out, res, xval, yval);
+			err[res.idx] = s->st.add(res, xval, yval);
+			if ((err[res.idx] > s->mxerr)
+					&&(traceopts.mode == TRACE_RING))
+				tb->failtrace();
+			nout++;
+		}
+	}
+	TBASSERT(*tb, nout == n);
+}
+
+//
+// search
+//
+// Rather than sweeping every phase, hunts for the worst one with an
+// ERRSEARCH of budget probes.  Only the maximum error is checked, since the
+// probes are (deliberately) anything but a uniform sample.
+static int	search(long budget) {
+	CORDIC_SEARCH	s;
+	const long	space = 1l<<PW;
+	long		cell;
+
+	s.tb    = new CORDIC_TB;
+	s.mxerr = max_error();
+	s.tb->opentrace(traceopts, VCDNAME);
+	s.tb->reset();
+	s.tb->lockstep(lockstep);
+
+	// The phase error comes from the quantized angles, and from whatever
+	// the last (smallest) rotation leaves behind.  Both change on the
+	// scale of that last rotation, so that's where to start climbing.
+	cell = (long)(atan2(1., pow(2., NSTAGES)) * space / (2.0 * M_PI));
+
+	ERRSEARCH	es(space, cell, probe, &s);
+
+	// The pre-rotation switches from one octant to the next at every
+	// multiple of 45 degrees
+	for(int k=0; k<8; k++)
+		es.hotspot(k * (space >> 3), 2);
+	es.search(budget);
+	es.report(stdout);
+	if (lockstep)
+		printf("LOCKSTEP: All %lu outputs matched the model\n",
+			es.m_nprobes);
+	delete s.tb;
+
+	printf("MAX Err: %.6f Units (%.6f threshold)\n", es.m_max, s.mxerr);
+	if (es.m_max > s.mxerr) {
+		printf("ERR: Maximum error is out of bounds\n");
+		printf("TEST FAILURE\n");
+		return EXIT_FAILURE;
+	}
+
+	printf("SUCCESS!!\n");
+	return EXIT_SUCCESS;
+}
+
+int main(int  argc, char **argv) {
+	Verilated::commandArgs(argc, argv);
+	int	nshards;
+	long	budget;
+	double	scale;
+
+	tb_traceopts(&traceopts, argc, argv);
+	nshards = tb_nshards(argc, argv);
+	budget  = tb_search(argc, argv);
+	lockstep= tb_lockstep(argc, argv);
+	tb_profile(argc, argv, CORENAME "_tb");
+	tbprofile.expect(((budget > 0) ? budget : NSAMPLES) * TICKS_PER_SAMPLE);
+
+	// This only works on DUT's with the aux flag turned on.
+	assert(HAS_AUX);
+
+	if (budget > 0)
+		exit(search(budget));
+
+	// Every shard drives the same (constant) input vector
+	scale  = ((1ul<<(IW-1))-1) * (double)((1ul<<(IW-1))-1);
+	scale  = sqrt(scale);
+
+	lgfft = tb_lgfft(argc, argv, LGNSAMPLES);
+
+	if (const char *fname = tb_dump(argc, argv, CORENAME "_tb.dump")) {
+		if (!dump.open(fname, CORENAME, IW, OW, PW, GAIN, NSAMPLES))
+			exit(EXIT_FAILURE);
+		dcol_phase = dump.column("i_phase", RESDUMP_I32);
+		dcol_ixval = dump.column("i_xval",  RESDUMP_I32);
+		dcol_iyval = dump.column("i_yval",  RESDUMP_I32);
+		dcol_oxval = dump.column("o_xval",  RESDUMP_I32);
+		dcol_oyval = dump.column("o_yval",  RESDUMP_I32);
+		dcol_xref  = dump.column("xval",    RESDUMP_F64);
+		dcol_yref  = dump.column("yval",    RESDUMP_F64);
+	}
+
+	run_shards_aligned(nshards, NSAMPLES, 1l<<lgfft, sweep, NULL);
+	tbprofile.enter(PROF_STATS);
+	dump.close();
+	if (lockstep)
+		printf("LOCKSTEP: All %ld outputs matched the model\n", NSAMPLES);
+
+	for(int k=1; k<MAX_SHARDS; k++) {
+		stats[0].merge(stats[k]);
+		spectra[0].merge(spectra[k]);
+	}
+
+	double	mxerr = stats[0].err.max(), averr = stats[0].err.rms(),
+		mag = stats[0].mag, imag = stats[0].imag,
+		sumxy = stats[0].sumxy, sumsq = stats[0].sumsq;
+
 	bool	failed = false;
 	double	expected_err;
 
 	expected_err = QUANTIZATION_VARIANCE
 			+ PHASE_VARIANCE_RAD*scale*scale*GAIN*GAIN;
 
-	averr /= (NSAMPLES);
-	averr  = sqrt(averr);
 	if (mag <= 0) {
 		printf("ERR: Negative magnitude, %f\n", mag);
 		goto test_failed;
@@ -283,38 +864,7 @@ int main(int  argc, char **argv) {
 		goto test_failed;
 
 	// Estimate the spurious free dynamic range
-	if ((PW < 26)&&(NSAMPLES == (1ul << PW))) {
-		typedef	std::complex<double>	COMPLEX;
-		COMPLEX	*outpt;
-		const	unsigned long	FFTLEN=(1ul<<PW);
-
-		outpt = new COMPLEX[FFTLEN];
-
-		for(unsigned k=0; k<FFTLEN; k++) {
-			outpt[k].real(xval[k]);
-			outpt[k].imag(yval[k]);
-		}
-
-		// Now we need to do an FFT
-		cfft((double *)outpt, FFTLEN);
-
-		double	master, spur, tmp;
-
-		// Master is the energy in the signal of interest
-		master = norm(outpt[1]);
-
-		// SPUR is the energy in any other FFT bin output
-		spur = norm(outpt[0]);
-		for(unsigned k=2; k<FFTLEN; k++) {
-			tmp = norm(outpt[k]);
-			if (tmp > spur)
-				spur = tmp;
-		}
-
-		printf("SFDR = %7.2f dBc\n",
-			10*log(master / spur)/log(10.));
-	} else if (PW >= 26)
-		printf("Too many phase bits ... skipping SFDR calculation\n");
+	spectra[0].report(stdout);
 
 	printf("SUCCESS!!\n");
 	exit(EXIT_SUCCESS);
@@ -0,0 +1,440 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	corebench.cpp
+//
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	Measures how fast a core is, rather than whether it works.
+//		Built once per core, with -D CORE_<name> choosing the core,
+//	this finds:
+//
+//	latency		The clocks from a sample's i_aux to its o_aux
+//	samples_per_clock	How many samples the core accepts per clock,
+//			once running, when fed as fast as it will go
+//	verilator_sps	Samples per second the Verilated core manages on this
+//			host, feeding it as fast as it will go
+//	model_sps	Samples per second the bit-accurate C++ model (from
+//			gencordic -m) manages on this host
+//
+//	The results are written as one CSV line, so that the output of every
+//	core's bench may be gathered into one table.  --header writes the
+//	header line instead, and --samples=<n> sets the number of samples
+//	timed (2^20 by default).
+//
+//	Tracing is off unless --trace, --trace-window=<start>:<stop>, or
+//	--trace-ring=<cycles> is given, as in the test benches--but any trace
+//	slows the core down, and so its numbers along with it.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2017, Gisselquist Technology, LLC
+//
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+//
+// License:	GPL, v3, as defined and found on www.gnu.org,
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+//
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include <verilated.h>
+#include <verilated_vcd_c.h>
+#if	defined(CORE_SEQCORDIC)
+# include "Vseqcordic.h"
+# include "seqcordic_model.h"
+# define BASECLASS	Vseqcordic
+# define CORENAME	"seqcordic"
+# define MDL(X)		SEQCORDIC_##X
+# define MODEL_P2R	seqcordic_p2r
+# define STROBED
+#elif	defined(CORE_MULTICORDIC)
+# include "Vmulticordic.h"
+# include "multicordic_model.h"
+# define BASECLASS	Vmulticordic
+# define CORENAME	"multicordic"
+# define MDL(X)		MULTICORDIC_##X
+# define MODEL_P2R	multicordic_p2r
+# define STROBED
+#elif	defined(CORE_ITERCORDIC)
+# include "Vitercordic.h"
+# include "itercordic_model.h"
+# define BASECLASS	Vitercordic
+# define CORENAME	"itercordic"
+# define MDL(X)		ITERCORDIC_##X
+# define MODEL_P2R	itercordic_p2r
+# define STROBED
+#elif	defined(CORE_PAIRCORDIC)
+# include "Vpaircordic.h"
+# include "paircordic_model.h"
+# define BASECLASS	Vpaircordic
+# define CORENAME	"paircordic"
+# define MDL(X)		PAIRCORDIC_##X
+# define MODEL_P2R	paircordic_p2r
+#elif	defined(CORE_RADIX4CORDIC)
+# include "Vradix4cordic.h"
+# include "radix4cordic_model.h"
+# define BASECLASS	Vradix4cordic
+# define CORENAME	"radix4cordic"
+# define MDL(X)		RADIX4CORDIC_##X
+# define MODEL_P2R	radix4cordic_p2r
+#elif	defined(CORE_HYBRIDCORDIC)
+# include "Vhybridcordic.h"
+# include "hybridcordic_model.h"
+# define BASECLASS	Vhybridcordic
+# define CORENAME	"hybridcordic"
+# define MDL(X)		HYBRIDCORDIC_##X
+# define MODEL_P2R	hybridcordic_p2r
+#elif	defined(CORE_TDMCORDIC)
+# include "Vtdmcordic.h"
+# include "tdmcordic_model.h"
+# define BASECLASS	Vtdmcordic
+# define CORENAME	"tdmcordic"
+# define MDL(X)		TDMCORDIC_##X
+# define MODEL_P2R	tdmcordic_p2r
+#elif	defined(CORE_TOPOLAR)
+# include "Vtopolar.h"
+# include "topolar_model.h"
+# define BASECLASS	Vtopolar
+# define CORENAME	"topolar"
+# define MDL(X)		TOPOLAR_##X
+# define MODEL_R2P	topolar_r2p
+#elif	defined(CORE_SEQPOLAR)
+# include "Vseqpolar.h"
+# include "seqpolar_model.h"
+# define BASECLASS	Vseqpolar
+# define CORENAME	"seqpolar"
+# define MDL(X)		SEQPOLAR_##X
+# define MODEL_R2P	seqpolar_r2p
+# define STROBED
+#elif	defined(CORE_MULTIPOLAR)
+# include "Vmultipolar.h"
+# include "multipolar_model.h"
+# define BASECLASS	Vmultipolar
+# define CORENAME	"multipolar"
+# define MDL(X)		MULTIPOLAR_##X
+# define MODEL_R2P	multipolar_r2p
+# define STROBED
+#elif	defined(CORE_ITERPOLAR)
+# include "Viterpolar.h"
+# include "iterpolar_model.h"
+# define BASECLASS	Viterpolar
+# define CORENAME	"iterpolar"
+# define MDL(X)		ITERPOLAR_##X
+# define MODEL_R2P	iterpolar_r2p
+# define STROBED
+#elif	defined(CORE_PAIRPOLAR)
+# include "Vpairpolar.h"
+# include "pairpolar_model.h"
+# define BASECLASS	Vpairpolar
+# define CORENAME	"pairpolar"
+# define MDL(X)		PAIRPOLAR_##X
+# define MODEL_R2P	pairpolar_r2p
+#elif	defined(CORE_RADIX4POLAR)
+# include "Vradix4polar.h"
+# include "radix4polar_model.h"
+# define BASECLASS	Vradix4polar
+# define CORENAME	"radix4polar"
+# define MDL(X)		RADIX4POLAR_##X
+# define MODEL_R2P	radix4polar_r2p
+#elif	defined(CORE_SINTABLE)
+# include "Vsintable.h"
+# include "sintable_model.h"
+# define BASECLASS	Vsintable
+# define CORENAME	"sintable"
+# define MDL(X)		SINTABLE_##X
+# define MODEL_SIN	sintable_sin
+# define O_SIN		o_val
+#elif	defined(CORE_QUARTERWAV)
+# include "Vquarterwav.h"
+# include "quarterwav_model.h"
+# define BASECLASS	Vquarterwav
+# define CORENAME	"quarterwav"
+# define MDL(X)		QUARTERWAV_##X
+# define MODEL_SIN	quarterwav_sin
+# define O_SIN		o_val
+#elif	defined(CORE_SINCTBL)
+# include "Vsinctbl.h"
+# include "sinctbl_model.h"
+# define BASECLASS	Vsinctbl
+# define CORENAME	"sinctbl"
+# define MDL(X)		SINCTBL_##X
+# define MODEL_SIN	sinctbl_sin
+# define O_SIN		o_val
+#elif	defined(CORE_QUADTBL)
+# include "Vquadtbl.h"
+# include "quadtbl_model.h"
+# define BASECLASS	Vquadtbl
+# define CORENAME	"quadtbl"
+# define MDL(X)		QUADTBL_##X
+# define MODEL_SIN	quadtbl_sin
+# define O_SIN		o_sin
+#else
+# include "Vcordic.h"
+# include "cordic_model.h"
+# define BASECLASS	Vcordic
+# define CORENAME	"cordic"
+# define MDL(X)		CORDIC_##X
+# define MODEL_P2R	cordic_p2r
+#endif
+#include "testb.h"
+
+#define	DEF_BENCH_SAMPLES	(1l<<20)
+// No core should take anywhere near this long to produce its first output
+#define	MAX_LATENCY		1000
+
+static const uint32_t	PMASK = (MDL(PW) >= 32) ? 0xffffffffu
+				: ((1u << MDL(PW))-1);
+
+//
+// The benchmark inputs, random but the same from one run to the next
+//
+static	long		nsamples;
+static	uint32_t	*in_phase;
+#ifndef	MODEL_SIN
+static	int32_t		*in_xval, *in_yval;
+#endif
+
+static void	bench_inputs(long n) {
+	srand(1);
+	nsamples = n;
+	in_phase = new uint32_t[n];
+#ifndef	MODEL_SIN
+	in_xval  = new int32_t[n];
+	in_yval  = new int32_t[n];
+#endif
+	for(long k=0; k<n; k++) {
+		in_phase[k] = ((uint32_t)rand() ^ ((uint32_t)rand() << 16)) & PMASK;
+#ifndef	MODEL_SIN
+		// Random inputs, sign extended from IW bits
+		in_xval[k] = (int32_t)((uint32_t)rand() << (32-MDL(IW))) >> (32-MDL(IW));
+		in_yval[k] = (int32_t)((uint32_t)rand() << (32-MDL(IW))) >> (32-MDL(IW));
+#endif
+	}
+}
+
+static double	now(void) {
+	struct timespec	ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+class	BENCH_TB : public TESTB<BASECLASS> {
+public:
+	BENCH_TB(void) {
+		idle();
+		reset();
+	}
+
+	void	reset(void) {
+		m_core->i_reset = 1;
+		tick();
+		m_core->i_reset = 0;
+	}
+
+	// Present sample k to the core, marked with aux
+	void	load(long k, bool aux) {
+#ifdef	MODEL_R2P
+		m_core->i_xval  = in_xval[k] & ((1u<<MDL(IW))-1);
+		m_core->i_yval  = in_yval[k] & ((1u<<MDL(IW))-1);
+#elif	defined(MODEL_P2R)
+		m_core->i_xval  = in_xval[k] & ((1u<<MDL(IW))-1);
+		m_core->i_yval  = in_yval[k] & ((1u<<MDL(IW))-1);
+		m_core->i_phase = in_phase[k];
+#else
+		m_core->i_phase = in_phase[k];
+#endif
+		m_core->i_aux = (aux) ? 1:0;
+#ifdef	STROBED
+		m_core->i_stb = 1;
+#else
+		m_core->i_ce  = 1;
+#endif
+	}
+
+	// Present nothing to the core, while letting it run
+	void	idle(void) {
+		m_core->i_aux = 0;
+#ifdef	STROBED
+		m_core->i_stb = 0;
+#else
+		m_core->i_ce  = 1;
+#endif
+	}
+
+	// True if the core will take a new sample on this clock
+	bool	ready(void) {
+#ifdef	STROBED
+		return !m_core->o_busy;
+#else
+		return true;
+#endif
+	}
+
+	// True if the core has produced an output on this clock
+	bool	output(void) {
+#ifdef	STROBED
+		return m_core->o_done;
+#else
+		return m_core->o_aux;
+#endif
+	}
+};
+
+//
+// bench_latency
+//
+// Returns the number of clocks from one sample's i_aux to its o_aux, or -1
+// should o_aux never arrive.
+static int	bench_latency(BENCH_TB *tb) {
+	int	clocks;
+
+	tb->reset();
+	tb->load(0, true);
+	tb->tick();
+	tb->idle();
+	for(clocks = 1; clocks < MAX_LATENCY && !tb->m_core->o_aux; clocks++)
+		tb->tick();
+	return (tb->m_core->o_aux) ? clocks : -1;
+}
+
+//
+// bench_core
+//
+// Feeds every sample to the core as fast as it will take them, and keeps
+// going until every result has come back out.  Returns the wall clock time
+// this took, and the number of clocks from the first output to the last in
+// *span.
+static double	bench_core(BENCH_TB *tb, unsigned long *span) {
+	long		nin = 0, nout = 0;
+	unsigned long	first = 0, last = 0, clocks = 0;
+	double		start;
+
+	tb->reset();
+	start = now();
+	while(nout < nsamples) {
+		if ((nin < nsamples)&&(tb->ready()))
+			tb->load(nin++, true);
+		else
+			tb->idle();
+		tb->tick();
+		clocks++;
+
+		if (tb->output()) {
+			if (nout == 0)
+				first = clocks;
+			last = clocks;
+			nout++;
+		} else if (clocks - last > MAX_LATENCY) {
+			fprintf(stderr, "ERR: %s stopped producing outputs\n",
+				CORENAME);
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	*span = last - first;
+	return now() - start;
+}
+
+//
+// bench_model
+//
+// Runs the software model across every sample, returning the wall clock
+// time this took.
+static double	bench_model(void) {
+	volatile int64_t	sink = 0;
+	int64_t			acc = 0;
+	double			start;
+
+	start = now();
+	for(long k=0; k<nsamples; k++) {
+#if	defined(MODEL_P2R)
+		int32_t	ox, oy;
+
+		MODEL_P2R(in_xval[k], in_yval[k], in_phase[k], &ox, &oy);
+		acc += ox ^ oy;
+#elif	defined(MODEL_R2P)
+		int32_t		mag;
+		uint32_t	ph;
+
+		MODEL_R2P(in_xval[k], in_yval[k], &mag, &ph);
+		acc += mag ^ (int32_t)ph;
+#else
+		acc += MODEL_SIN(in_phase[k]);
+#endif
+	}
+	// Keep the compiler from optimizing the model away
+	sink = acc;
+	(void)sink;
+	return now() - start;
+}
+
+int	main(int argc, char **argv) {
+	Verilated::commandArgs(argc, argv);
+	TRACEOPTS	traceopts;
+	BENCH_TB	*tb;
+	long		n = DEF_BENCH_SAMPLES;
+	int		latency;
+	unsigned long	span;
+	double		tcore, tmodel;
+
+	for(int k=1; k<argc; k++) {
+		if (strcmp(argv[k], "--header")==0) {
+			printf("core,latency,samples_per_clock,verilator_sps,model_sps\n");
+			exit(EXIT_SUCCESS);
+		} else if (strncmp(argv[k], "--samples=", 10)==0) {
+			n = atol(&argv[k][10]);
+			if (n < 2) {
+				fprintf(stderr, "ERR: Bad number of samples, %s\n",
+					argv[k]);
+				exit(EXIT_FAILURE);
+			}
+		}
+	}
+
+	tb_traceopts(&traceopts, argc, argv);
+	bench_inputs(n);
+	tb = new BENCH_TB;
+	tb->opentrace(traceopts, CORENAME "_bench.vcd");
+
+	latency = bench_latency(tb);
+	if (latency < 0) {
+		fprintf(stderr, "ERR: %s never produced an o_aux\n", CORENAME);
+		exit(EXIT_FAILURE);
+	} else if (latency != MDL(LATENCY))
+		fprintf(stderr, "WARNING: %s took %d clocks, not the %d its model claims\n",
+			CORENAME, latency, MDL(LATENCY));
+
+	tcore  = bench_core(tb, &span);
+	tmodel = bench_model();
+
+	printf("%s,%d,%.4f,%.0f,%.0f\n", CORENAME, latency,
+		(span > 0) ? (double)(nsamples-1) / (double)span : 0.0,
+		nsamples / tcore, nsamples / tmodel);
+
+	delete	tb;
+	exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,348 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename: 	errsearch.h
+//
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	An adaptive search for the worst case error of a core, for
+//		those cores whose input space is too large to sweep.  Rather
+//	than trying every input, an ERRSEARCH spends half of its budget on a
+//	first pass: probing densely around the "hot spots" the test bench knows
+//	of--the places the error structure of the core says the error should
+//	peak, such as the segment boundaries of an interpolated table--and
+//	sparsely, at one random point per stratum, everywhere else.  The worst
+//	points found are then each hill-climbed, stepping first by the scale
+//	over which the error is expected to change and then by ever smaller
+//	steps, until each sits on a local maximum, and the very worst of those
+//	are scanned input by input across a cell either side.  What's left of
+//	the budget then goes to further, sparser, rounds of the same.
+//
+//	The core is only ever fed batches of inputs, through a PROBE_FN the
+//	test bench supplies, so that its pipeline stays full.
+//
+//	The result is the largest error found.  Strictly, that's only a lower
+//	bound on the true maximum, but one that is reached in minutes rather
+//	than the days an exhaustive 2^32 sweep would take.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2017, Gisselquist Technology, LLC
+//
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+//
+// License:	GPL, v3, as defined and found on www.gnu.org,
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+//
+#ifndef	ERRSEARCH_H
+#define	ERRSEARCH_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+// The number of probes given a bare --search
+#define	ERRSEARCH_BUDGET	(1l<<22)
+// The number of worst points from the first pass that are then climbed
+#define	ERRSEARCH_SEEDS		64
+// The most inputs handed to the core at once during the first pass
+#define	ERRSEARCH_BATCH		4096
+
+//
+// PROBE_FN
+//
+// Runs the n inputs pts[0..n-1] through the core, setting err[k] to the
+// error of the result from pts[k].
+typedef	void	(*PROBE_FN)(const long *pts, int n, double *err, void *arg);
+
+//
+// tb_search
+//
+// Returns the number of probes requested on the command line by
+// --search[=<probes>], or zero if no search was requested.
+static long	tb_search(int argc, char **argv) {
+	for(int k=1; k<argc; k++) {
+		const char	*a = argv[k];
+
+		if (strcmp(a, "--search")==0)
+			return ERRSEARCH_BUDGET;
+		else if (strncmp(a, "--search=", 9)==0) {
+			long	n = strtol(&a[9], NULL, 0);
+
+			if (n < 1) {
+				fprintf(stderr, "ERR: Bad search budget, %s\n", a);
+				exit(EXIT_FAILURE);
+			}
+			return n;
+		}
+	}
+	return 0;
+}
+
+class	ERRSEARCH {
+	typedef	struct	{
+		long	pt, step;
+		double	err;
+	} SEED;
+
+	long		m_space, m_cell;
+	PROBE_FN	m_fn;
+	void		*m_arg;
+	std::vector<long>	m_hot, m_pts;
+	std::vector<double>	m_err;
+	SEED		m_seed[ERRSEARCH_SEEDS];
+	int		m_nseeds;
+	unsigned long	m_rng;
+
+	// A xorshift generator, so that every run probes the same points
+	unsigned long	rnd(void) {
+		m_rng ^= m_rng << 13;
+		m_rng ^= m_rng >> 7;
+		m_rng ^= m_rng << 17;
+		return m_rng;
+	}
+
+	long	wrap(long pt) const {
+		pt %= m_space;
+		return (pt < 0) ? pt + m_space : pt;
+	}
+
+	long	distance(long a, long b) const {
+		long	d = wrap(a - b);
+
+		return (d > m_space/2) ? m_space - d : d;
+	}
+
+	// Keeps pt as a seed if it is among the worst points found so far.
+	// Points within a cell of an existing seed replace that seed, if
+	// they are worse, so that the seeds don't all pile onto one peak.
+	void	keep(long pt, double err) {
+		int	w;
+
+		for(int k=0; k<m_nseeds; k++)
+			if (distance(pt, m_seed[k].pt) < m_cell) {
+				if (err > m_seed[k].err) {
+					m_seed[k].pt   = pt;
+					m_seed[k].err  = err;
+					m_seed[k].step = m_cell;
+				} return;
+			}
+
+		if (m_nseeds < ERRSEARCH_SEEDS)
+			w = m_nseeds++;
+		else {
+			w = 0;
+			for(int k=1; k<m_nseeds; k++)
+				if (m_seed[k].err < m_seed[w].err)
+					w = k;
+			if (err <= m_seed[w].err)
+				return;
+		}
+		m_seed[w].pt   = pt;
+		m_seed[w].err  = err;
+		m_seed[w].step = m_cell;
+	}
+
+	// Runs every point in m_pts through the core
+	void	probe(void) {
+		int	n = (int)m_pts.size();
+
+		if (n == 0)
+			return;
+		m_err.resize(n);
+		m_fn(&m_pts[0], n, &m_err[0], m_arg);
+		m_nprobes += n;
+		for(int k=0; k<n; k++)
+			if (m_err[k] > m_max) {
+				m_max    = m_err[k];
+				m_argmax = m_pts[k];
+			}
+	}
+
+	// As above, keeping the worst of them as seeds
+	void	probe_and_keep(void) {
+		probe();
+		for(unsigned k=0; k<m_pts.size(); k++)
+			keep(m_pts[k], m_err[k]);
+		m_pts.clear();
+	}
+
+	// Climbs each seed, one step either side of it at a time, all seeds
+	// at once, until every seed sits on a local maximum or the budget is
+	// spent
+	void	climb(long budget) {
+		while((long)m_nprobes < budget) {
+			std::vector<int>	who;
+
+			for(int k=0; k<m_nseeds; k++) {
+				if (m_seed[k].step <= 0)
+					continue;
+				who.push_back(k);
+				m_pts.push_back(wrap(m_seed[k].pt - m_seed[k].step));
+				m_pts.push_back(wrap(m_seed[k].pt + m_seed[k].step));
+			}
+			if (who.empty())
+				break;
+			probe();
+
+			for(unsigned j=0; j<who.size(); j++) {
+				SEED	*s = &m_seed[who[j]];
+				int	b = (m_err[2*j] > m_err[2*j+1]) ? 2*j : 2*j+1;
+
+				// Move uphill at the same stride, or try a
+				// finer one
+				if (m_err[b] > s->err) {
+					s->pt  = m_pts[b];
+					s->err = m_err[b];
+				} else
+					s->step >>= 1;
+			}
+			m_pts.clear();
+		}
+	}
+
+	// Rounding makes the error rough on the finest scales, so a climb
+	// can stall just short of the peak.  Once the climbs have converged,
+	// this probes every input within a cell of the worst seeds--as many
+	// of them as fit within budget probes--marking each seed it scans.
+	void	polish(long budget) {
+		long	used = 0;
+
+		while(used + 2*m_cell+1 <= budget) {
+			int	w = -1;
+
+			for(int k=0; k<m_nseeds; k++)
+				if ((m_seed[k].step == 0)&&((w < 0)
+						||(m_seed[k].err > m_seed[w].err)))
+					w = k;
+			if (w < 0)
+				break;
+			m_seed[w].step = -1;
+			for(long d=-m_cell; d<=m_cell; d++) {
+				m_pts.push_back(wrap(m_seed[w].pt + d));
+				if (m_pts.size() >= ERRSEARCH_BATCH) {
+					probe();
+					m_pts.clear();
+				}
+			} probe();
+			m_pts.clear();
+			used += 2*m_cell+1;
+		}
+	}
+
+public:
+	unsigned long	m_nprobes;
+	double		m_max;
+	long		m_argmax;
+
+	//
+	// Inputs run from 0 to space-1, and wrap around.  cell is the
+	// distance, in inputs, over which the error is expected to change
+	// appreciably, and so the first step each hill-climb takes.
+	ERRSEARCH(long space, long cell, PROBE_FN fn, void *arg)
+		: m_space(space), m_cell((cell < 1) ? 1 : cell), m_fn(fn),
+		m_arg(arg), m_nseeds(0), m_rng(0x2545f4914f6cdd1dul),
+		m_nprobes(0), m_max(0.0), m_argmax(0) {}
+
+	//
+	// hotspot
+	//
+	// Asks for pt, and every input within radius of it, to be probed
+	// during the first pass.
+	void	hotspot(long pt, int radius = 0) {
+		for(int d=-radius; d<=radius; d++)
+			m_hot.push_back(wrap(pt + d));
+	}
+
+	//
+	// search
+	//
+	// Spends (about) budget probes looking for the worst error.
+	void	search(long budget) {
+		long	nhot, stride, nstrata, first, quarter;
+
+		// There's no point in probing more inputs than there are
+		if (budget > m_space)
+			budget = m_space;
+		quarter = (budget/4 > 0) ? budget/4 : 1;
+
+		// Up to a quarter of the budget goes to the hot spots, spread
+		// evenly across them should there be more of them than that
+		nhot = (long)m_hot.size();
+		stride = 1;
+		if (nhot > quarter)
+			stride = (nhot + quarter - 1) / quarter;
+		first = (stride > 1) ? (long)(rnd() % stride) : 0;
+		for(long k=first; k<nhot; k+=stride) {
+			m_pts.push_back(m_hot[k]);
+			if (m_pts.size() >= ERRSEARCH_BATCH)
+				probe_and_keep();
+		} probe_and_keep();
+
+		// Then, round by round, one random point per stratum, and a
+		// climb from the worst points found.  The first round's
+		// strata take the rest of half the budget, each later round's
+		// half of whatever remains once the climbs have converged.
+		for(int round=0; (long)m_nprobes < budget; round++) {
+			if (round == 0)
+				nstrata = budget/2 - (long)m_nprobes;
+			else
+				nstrata = (budget - (long)m_nprobes) / 2;
+			if (nstrata > m_space)
+				nstrata = m_space;
+			if (nstrata < ERRSEARCH_SEEDS)
+				break;
+			for(long s=0; s<nstrata; s++) {
+				long	lo = (long)((double)m_space * s / nstrata),
+					hi = (long)((double)m_space * (s+1) / nstrata);
+
+				if (hi <= lo)
+					continue;
+				m_pts.push_back(lo + (long)(rnd() % (hi - lo)));
+				if (m_pts.size() >= ERRSEARCH_BATCH)
+					probe_and_keep();
+			} probe_and_keep();
+
+			// Should the strata have covered every input, there's
+			// nothing left to climb
+			if (nstrata >= m_space)
+				break;
+			climb(budget);
+			if ((long)m_nprobes < budget)
+				polish((budget - (long)m_nprobes) / 2);
+		}
+	}
+
+	//
+	// report
+	//
+	// Describes how much of the space was searched, and what was found.
+	void	report(FILE *fp) const {
+		fprintf(fp, "Searched %lu of %ld inputs (%.4f%%), worst error "
+			"%f at input 0x%lx\n", m_nprobes, m_space,
+			100.0 * (double)m_nprobes / (double)m_space,
+			m_max, m_argmax);
+	}
+};
+
+#endif
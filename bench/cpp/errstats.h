@@ -0,0 +1,115 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename: 	errstats.h
+//
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	Streaming error statistics for the test benches.  Rather than
+//		recording every input and every output, and then comparing
+//	them in a second pass, a test bench pushes each input into a
+//	SAMPLE_FIFO as it goes into the core.  When the aux flag says a result
+//	has come out of the pipeline, the matching input is popped off of the
+//	FIFO, and the two are handed to one or more ERRSTAT accumulators.  The
+//	FIFO never holds more than a pipeline's worth of inputs, so the memory
+//	required no longer grows with the number of samples.
+//
+//	ERRSTATs may be merged, so each shard of a sweep may keep its own.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2017, Gisselquist Technology, LLC
+//
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+//
+// License:	GPL, v3, as defined and found on www.gnu.org,
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+//
+#ifndef	ERRSTATS_H
+#define	ERRSTATS_H
+
+#include <math.h>
+#include <assert.h>
+
+//
+// SAMPLE_FIFO
+//
+// Holds the inputs given to the core until their results emerge.  2^LGDEPTH
+// must be larger than the core's latency (in samples), else the FIFO will
+// overflow.
+template <class T, int LGDEPTH=8>	class SAMPLE_FIFO {
+	T		m_buf[1<<LGDEPTH];
+	unsigned	m_rd, m_wr;
+public:
+	SAMPLE_FIFO(void) : m_rd(0), m_wr(0) {}
+
+	bool	empty(void) const { return m_rd == m_wr; }
+	unsigned	size(void) const { return m_wr - m_rd; }
+
+	void	push(const T &v) {
+		assert(size() < (1u<<LGDEPTH));
+		m_buf[(m_wr++) & ((1u<<LGDEPTH)-1)] = v;
+	}
+
+	const T	&pop(void) {
+		assert(!empty());
+		return m_buf[(m_rd++) & ((1u<<LGDEPTH)-1)];
+	}
+};
+
+//
+// ERRSTAT
+//
+// Keeps a running count, sum, sum of squares, and maximum magnitude of an
+// error term.
+class	ERRSTAT {
+public:
+	unsigned long	m_count;
+	double		m_sum, m_sumsq, m_max;
+
+	ERRSTAT(void) : m_count(0), m_sum(0.0), m_sumsq(0.0), m_max(0.0) {}
+
+	void	add(double err) {
+		m_count++;
+		m_sum   += err;
+		m_sumsq += err * err;
+		if (fabs(err) > m_max)
+			m_max = fabs(err);
+	}
+
+	void	merge(const ERRSTAT &s) {
+		m_count += s.m_count;
+		m_sum   += s.m_sum;
+		m_sumsq += s.m_sumsq;
+		if (s.m_max > m_max)
+			m_max = s.m_max;
+	}
+
+	unsigned long	count(void) const { return m_count; }
+	double	mean(void) const {
+		return (m_count > 0) ? m_sum / m_count : 0.0; }
+	double	rms(void) const {
+		return (m_count > 0) ? sqrt(m_sumsq / m_count) : 0.0; }
+	double	max(void) const { return m_max; }
+};
+
+#endif
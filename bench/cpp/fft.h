@@ -47,6 +47,10 @@ extern	"C"	{
 // The actual method may, or may not therefore, be Numerical Recipes based
 extern	void	numer_fft(double *data, unsigned nn, int isign);
 extern	unsigned	nextlg(unsigned long vl);
+// Memory allocated by fft_malloc (nn complex values) can be transformed in
+// place without being copied
+extern	double	*fft_malloc(unsigned long nn);
+extern	void	fft_free(double *data);
 }
 #endif
 
@@ -7,6 +7,13 @@
 // Purpose:	To call the Fastest Fourier Transform in the West library
 //		for generic FFT requests.
 //
+//	Plans are made once per size and direction, and then executed
+//	directly upon the caller's data whenever its alignment allows.  Any
+//	wisdom gained while planning is kept in a wisdom file, fftw.wisdom
+//	unless $FFTW_WISDOM names another, so that later runs need not plan
+//	again.  Set $FFTW_NTHREADS to have FFTW use more than one thread per
+//	transform.
+//
 // Creator:	Dan Gisselquist, Ph.D.
 //		Gisselquist Technology, LLC
 //
@@ -36,12 +43,17 @@
 ////////////////////////////////////////////////////////////////////////////////
 //
 //
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
 #include <math.h>
 #include "fft.h"
 #include <fftw3.h>
 // #include <fftw.h>
 
 #include <assert.h>
+#include <pthread.h>
 
 unsigned	nextlg(unsigned long vl) {
 	unsigned long	r;
@@ -73,50 +85,125 @@ static	int	initialized = 0;
 typedef	struct	{
 	fftw_plan	ip;
 	fftw_plan	fp;
-	double		*buf;
+	unsigned	nn;
+	int		align;	// The alignment the plans were made with
 } FFTWCPLAN;
 
 FFTWCPLAN	cplans[32];
+// FFTW's planner isn't thread safe, although executing a plan is.  This lock
+// protects the planner and our table of plans.
+static	pthread_mutex_t	fftlock = PTHREAD_MUTEX_INITIALIZER;
+static	const char	*wisdom_file = "fftw.wisdom";
+
+// Allocate memory suitably aligned for transforming in place, without any
+// copies.
+double	*fft_malloc(unsigned long nn) {
+	return (double *)fftw_malloc(sizeof(fftw_complex)*nn);
+}
 
-void	numer_fft(double *data, unsigned nn, int isign) {
-	fftw_plan p;
-	static	double	*alt = NULL;
+void	fft_free(double *data) {
+	fftw_free(data);
+}
+
+static	void	fft_init(void) {
+	const char	*str;
 	unsigned	i;
 
-	if (!initialized) {
-		for(i=0; i<32; i++) {
-			cplans[i].ip  = NULL;
-			cplans[i].fp  = NULL;
-			cplans[i].buf = NULL;
-		}
-		initialized = 1;
+	for(i=0; i<32; i++) {
+		cplans[i].ip  = NULL;
+		cplans[i].fp  = NULL;
+		cplans[i].nn  = 0;
 	}
 
-	{
-		unsigned long	shft;
-		for(shft=0, i=2; i<nn; i<<=1, shft++)
-			;
-		if (cplans[shft].ip == NULL) {
-			cplans[shft].buf =
-				(double *)fftw_malloc(sizeof(fftw_complex)*(nn<<1));
-			alt = cplans[shft].buf;
-
-			cplans[shft].ip = fftw_plan_dft_1d(nn,
-				(fftw_complex *)alt, (fftw_complex *)alt,
-				FFTW_BACKWARD, FFTW_MEASURE);
-
-			cplans[shft].fp = fftw_plan_dft_1d(nn,
-				(fftw_complex *)alt, (fftw_complex *)alt,
-				FFTW_FORWARD, FFTW_MEASURE);
-		}
-
-		p = (isign < 0) ? cplans[shft].fp : cplans[shft].ip;
-		alt = cplans[shft].buf;
+	if ((str = getenv("FFTW_NTHREADS"))&&(atoi(str) > 1)) {
+		if (fftw_init_threads())
+			fftw_plan_with_nthreads(atoi(str));
+	}
+
+	if ((str = getenv("FFTW_WISDOM"))&&(str[0]))
+		wisdom_file = str;
+	// If there's no wisdom file (yet), we'll just have to plan things
+	// the hard way
+	fftw_import_wisdom_from_filename(wisdom_file);
+
+	initialized = 1;
+}
+
+// Write out our wisdom, so that the next run needn't plan again.  Write it to
+// a temporary file first, so that other test benches reading the same wisdom
+// file never see it half written.
+static	void	fft_save_wisdom(void) {
+	char	*tmpname;
+
+	tmpname = (char *)malloc(strlen(wisdom_file)+16);
+	sprintf(tmpname, "%s.%d", wisdom_file, (int)getpid());
+	if ((!fftw_export_wisdom_to_filename(tmpname))
+			||(rename(tmpname, wisdom_file) != 0)) {
+		fprintf(stderr, "WARNING: Could not save FFTW wisdom to %s\n",
+			wisdom_file);
+		unlink(tmpname);
+	} free(tmpname);
+}
+
+static	FFTWCPLAN	*fft_plan(unsigned nn) {
+	unsigned long	shft;
+	unsigned	i;
+	FFTWCPLAN	*p;
+
+	pthread_mutex_lock(&fftlock);
+	if (!initialized)
+		fft_init();
+
+	for(shft=0, i=2; i<nn; i<<=1, shft++)
+		;
+	p = &cplans[shft];
+	if (p->ip == NULL) {
+		double	*buf;
+
+		// Plan on a scratch buffer of our own, since planning
+		// destroys its contents.  The plans are then executed on the
+		// caller's data.
+		buf = fft_malloc(nn);
+		p->align = fftw_alignment_of(buf);
+
+		p->ip = fftw_plan_dft_1d(nn,
+			(fftw_complex *)buf, (fftw_complex *)buf,
+			FFTW_BACKWARD, FFTW_MEASURE);
+
+		p->fp = fftw_plan_dft_1d(nn,
+			(fftw_complex *)buf, (fftw_complex *)buf,
+			FFTW_FORWARD, FFTW_MEASURE);
+		p->nn = nn;
+
+		fft_free(buf);
+		fft_save_wisdom();
 	}
+	pthread_mutex_unlock(&fftlock);
+
+	assert(p->nn == nn);
+	return p;
+}
 
-	for(i=0; i<(((unsigned long)nn)<<1); i++)
-		alt[i] = data[i];
-	fftw_execute(p);
-	for(i=0; i<(((unsigned long)nn)<<1); i++)
-		data[i] = alt[i];
+void	numer_fft(double *data, unsigned nn, int isign) {
+	FFTWCPLAN	*plan = fft_plan(nn);
+	fftw_plan	p;
+
+	p = (isign < 0) ? plan->fp : plan->ip;
+
+	if (fftw_alignment_of(data) == plan->align) {
+		fftw_execute_dft(p, (fftw_complex *)data, (fftw_complex *)data);
+	} else {
+		// The plan can't be run on this data as it is aligned.  Copy
+		// it somewhere that's aligned properly and transform it
+		// there.
+		double		*alt = fft_malloc(nn);
+		unsigned long	i;
+
+		for(i=0; i<(((unsigned long)nn)<<1); i++)
+			alt[i] = data[i];
+		fftw_execute_dft(p, (fftw_complex *)alt, (fftw_complex *)alt);
+		for(i=0; i<(((unsigned long)nn)<<1); i++)
+			data[i] = alt[i];
+		fft_free(alt);
+	}
 }
@@ -0,0 +1,247 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	lanes_tb.cpp
+//
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	A test bench for the table cores built with -P, taking
+//		several phases per clock, each in its own lane of i_phase.
+//	Every lane of every output is checked, bit for bit, against the core's
+//	software model as it emerges, and the test stops at the first
+//	mismatch.
+//
+//	Such a core shares each copy of its table between two lanes, one
+//	through each of its two read ports, and so lanes 2k and 2k+1 are given
+//	both different phases and the same phase.  With an odd number of
+//	lanes, the last copy of the table is left with only the one port.  The
+//	bench runs in three parts:
+//
+//	1. Every phase is swept through every lane, each lane a little over
+//		1/NLANES of the way around the sweep from the one before.
+//	2. Each pair of lanes in turn is given the same phase on both ports,
+//		while the others are held at zero.
+//	3. Random phases are given to every lane, while i_ce is dropped on
+//		one clock in four.
+//
+//	Tracing is off unless --trace, --trace-window=<start>:<stop>, or
+//	--trace-ring=<cycles> is given.  See testb.h for details.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2017, Gisselquist Technology, LLC
+//
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+//
+// License:	GPL, v3, as defined and found on www.gnu.org,
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+//
+#include <stdio.h>
+
+#include <verilated.h>
+#include <verilated_vcd_c.h>
+#include "Vqtrlanes.h"
+#include "qtrlanes_model.h"
+#define	BASECLASS	Vqtrlanes
+#define	CORENAME	"qtrlanes"
+#define	MDL(X)		QTRLANES_##X
+#define	MODEL_SIN	qtrlanes_sin
+#include "testb.h"
+#include "errstats.h"
+
+const int	PW = MDL(PW), OW = MDL(OW), NLANES = MDL(NLANES);
+
+static const uint32_t	PMASK = (PW >= 32) ? 0xffffffffu : ((1u<<PW)-1),
+			OMASK = (OW >= 32) ? 0xffffffffu : ((1u<<OW)-1);
+
+// The number of random clocks run at the end
+#define	NRANDOM		(1l<<16)
+
+//
+// LANES_IN
+//
+// The phases the core has accepted on one clock, one per lane, kept until
+// its outputs can be checked against the software model.
+typedef	struct	{
+	unsigned long	clock;
+	uint32_t	phase[MDL(NLANES)];
+} LANES_IN;
+
+class	LANES_TB : public TESTB<BASECLASS> {
+	SAMPLE_FIFO<LANES_IN>	m_lsfifo;
+public:
+	unsigned long	m_nchecked;
+
+	LANES_TB(void) : m_nchecked(0) {
+		m_core->i_ce    = 1;
+		m_core->i_phase = 0;
+		m_core->i_aux   = 0;
+		lockstep(true);
+	}
+
+	// The table cores have no -c header to define HAS_RESET_WIRE
+	void	reset(void) {
+		m_core->i_reset = 1;
+		tick();
+		m_core->i_reset = 0;
+	}
+
+	// Places phase ph into lane k of the core's input
+	void	set_lane(int k, uint32_t ph) {
+		uint64_t	v = m_core->i_phase;
+
+		v &= ~((uint64_t)PMASK << (k*PW));
+		v |= (uint64_t)(ph & PMASK) << (k*PW);
+		m_core->i_phase = v;
+	}
+
+	// Gives each lane k phase ph[k], on the next clock
+	void	load(const uint32_t *ph, bool ce) {
+		for(int k=0; k<NLANES; k++)
+			set_lane(k, ph[k]);
+		m_core->i_ce  = (ce) ? 1:0;
+		m_core->i_aux = 1;
+		tick();
+	}
+
+	// Reads lane k back out of the core's output, sign extended
+	int32_t	lane(int k) {
+		uint32_t	v = (uint32_t)(m_core->o_val >> (k*OW)) & OMASK;
+
+		return (int32_t)(v << (32-OW)) >> (32-OW);
+	}
+
+	void	lockstep_in(void) {
+		LANES_IN	in;
+
+		if ((!m_core->i_ce)||(!m_core->i_aux))
+			return;
+		in.clock = m_tickcount;
+		for(int k=0; k<NLANES; k++)
+			in.phase[k] = (uint32_t)(m_core->i_phase >> (k*PW)) & PMASK;
+		m_lsfifo.push(in);
+	}
+
+	int	lockstep_out(char *msg, size_t len) {
+		// Nothing moves, so nothing new comes out, without i_ce
+		if ((!m_core->i_ce)||(!m_core->o_aux))
+			return 0;
+		if (m_lsfifo.empty()) {
+			snprintf(msg, len, "an output, with no input to match it");
+			return -1;
+		}
+
+		const LANES_IN	&in = m_lsfifo.pop();
+
+		for(int k=0; k<NLANES; k++) {
+			int32_t	msin = MODEL_SIN(in.phase[k]);
+
+			if (lane(k) == msin)
+				continue;
+			snprintf(msg, len, "lane %d (of %d), phase 0x%x, given on "
+				"clock %lu, became 0x%x, not 0x%x", k, NLANES,
+				in.phase[k], in.clock,
+				(uint32_t)lane(k) & OMASK, (uint32_t)msin & OMASK);
+			return -1;
+		}
+		m_nchecked++;
+		return NLANES;
+	}
+
+	// Runs the pipeline dry, checking everything still within it
+	void	flush(void) {
+		m_core->i_ce  = 1;
+		m_core->i_aux = 0;
+		for(int k=0; k<MDL(LATENCY); k++)
+			tick();
+	}
+};
+
+int main(int  argc, char **argv) {
+	Verilated::commandArgs(argc, argv);
+	LANES_TB	*tb;
+	TRACEOPTS	traceopts;
+	uint32_t	ph[MDL(NLANES)];
+	unsigned long	nclocks = 0;
+
+	// Verilator packs ports of up to 64 bits into a single word
+	if ((NLANES*PW > 64)||(NLANES*OW > 64)) {
+		fprintf(stderr, "ERR: This test bench needs every lane within one 64-bit word\n");
+		exit(EXIT_FAILURE);
+	}
+
+	tb_traceopts(&traceopts, argc, argv);
+	tb = new LANES_TB;
+	tb->opentrace(traceopts, CORENAME "_tb.vcd");
+	tb->reset();
+
+	// 1. Sweep every phase through every lane, each lane starting its
+	// sweep (1<<PW)/NLANES phases past the last, so that no two lanes
+	// sharing a table ever read the same address
+	for(long i=0; i<(1l<<PW); i++) {
+		for(int k=0; k<NLANES; k++)
+			ph[k] = (uint32_t)(i + k * ((1l<<PW)/NLANES + 1));
+		tb->load(ph, true);
+		nclocks++;
+	}
+
+	// 2. Both ports of each table given the same phase.  With an odd
+	// number of lanes, the last lane is on its own
+	for(int k=0; k<NLANES; k+=2) {
+		for(long i=0; i<(1l<<PW); i+=(1l<<PW)/64 + 1) {
+			for(int j=0; j<NLANES; j++)
+				ph[j] = ((j|1) == (k|1)) ? (uint32_t)i : 0;
+			tb->load(ph, true);
+			nclocks++;
+		}
+	}
+
+	// 3. Random phases in every lane, against a random clock enable
+	srand(1);
+	for(long i=0; i<NRANDOM; i++) {
+		bool	ce = (rand() & 3) != 0;
+
+		for(int k=0; k<NLANES; k++)
+			ph[k] = (uint32_t)rand() ^ ((uint32_t)rand() << 16);
+		tb->load(ph, ce);
+		if (ce)
+			nclocks++;
+	}
+
+	tb->flush();
+
+	printf("LOCKSTEP: All %lu outputs, %d lanes each, matched the model\n",
+		tb->m_nchecked, NLANES);
+	if (tb->m_nchecked != nclocks) {
+		printf("Only %lu of %lu clocks produced an output\n",
+			tb->m_nchecked, nclocks);
+		tb->closetrace();
+		delete tb;
+		printf("TEST FAILURE\n");
+		exit(EXIT_FAILURE);
+	}
+
+	tb->closetrace();
+	delete tb;
+	printf("SUCCESS!!\n");
+	exit(EXIT_SUCCESS);
+}
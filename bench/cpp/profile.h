@@ -0,0 +1,329 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename: 	profile.h
+//
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	Optional timing instrumentation for the test benches, so as
+//		to tell where the time of a run actually goes.  Given
+//	--profile[=<file>], every TESTB splits the time it sees into:
+//
+//	eval		Verilator's m_core->eval()
+//	trace		Writing the VCD trace: dump(), flush(), and the like
+//	lockstep	Checking each output against the software model
+//	stimulus	Everything between one tick() and the next: generating
+//			the next input, and collecting and checking the last
+//			output
+//
+//	while the benches themselves mark out:
+//
+//	fft		Transforming spectral segments, and reporting the SFDR,
+//			each within a PROFILE_SCOPE
+//	stats		The post-pass, from tbprofile.enter(PROF_STATS) on:
+//			merging shards, and computing and reporting the
+//			statistics
+//
+//	Once a second or so a progress line, with ticks per second and (if
+//	the bench has said how many ticks to expect) an ETA, is written to
+//	stderr.  On exit, a JSON summary of all of the above is written to
+//	<file>, or to <bench>.profile.json given a bare --profile.
+//
+//	Intervals are measured with RDTSC where there is one, and the
+//	monotonic (steady) clock elsewhere.  Each TESTB keeps its own counts,
+//	handing them on to the process wide totals every PROFILE_FLUSH ticks,
+//	so the shards of a sweep never contend over them.  Times are summed
+//	across every thread, and so may add up to more than the wall clock.
+//
+//	Without --profile, none of this costs more than a test of a flag.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2017, Gisselquist Technology, LLC
+//
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+//
+// License:	GPL, v3, as defined and found on www.gnu.org,
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+//
+#ifndef	PROFILE_H
+#define	PROFILE_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#if	defined(__x86_64__)||defined(__i386__)
+#include <x86intrin.h>
+#define	PROFILE_RDTSC
+#endif
+
+// Ticks between hand-offs of each TESTB's counts to the totals
+#define	PROFILE_FLUSH	(1ul<<16)
+
+typedef	enum	{
+	PROF_EVAL = 0, PROF_TRACE, PROF_LOCKSTEP, PROF_STIMULUS,
+	PROF_FFT, PROF_STATS, PROF_NPHASES
+} PROFILE_PHASE;
+
+static	const char	*PROFILE_NAMES[PROF_NPHASES] = {
+	"eval", "trace", "lockstep", "stimulus", "fft", "stats" };
+
+typedef	struct	{
+	uint64_t	count[PROF_NPHASES];	// In profile_now() units
+	unsigned long	ticks;
+} PROFILE_COUNTS;
+
+static	double	profile_seconds(void) {
+	struct timespec	ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// A timestamp: the cycle counter if we have one, nanoseconds otherwise
+static inline uint64_t	profile_now(void) {
+#ifdef	PROFILE_RDTSC
+	return __rdtsc();
+#else
+	struct timespec	ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+#endif
+}
+
+// Time spent within a PROFILE_SCOPE, by this thread, so that the TESTB
+// on this thread needn't count it again as stimulus
+static	__thread uint64_t	profile_scoped = 0;
+
+class	TBPROFILE {
+	pthread_mutex_t	m_lock;
+	PROFILE_COUNTS	m_total;
+	uint64_t	m_start;
+	double		m_start_sec, m_last_report;
+	unsigned long	m_expect;
+	const char	*m_fname, *m_bench;
+
+	// profile_now() units per second, measured across the run so far
+	double	rate(void) const {
+#ifdef	PROFILE_RDTSC
+		double	dt = profile_seconds() - m_start_sec;
+
+		if (dt <= 0.0)
+			return 1e9;
+		return (double)(profile_now() - m_start) / dt;
+#else
+		return 1e9;
+#endif
+	}
+
+	void	progress(void) {
+		double	t = profile_seconds(), dt = t - m_start_sec,
+			tps = (dt > 0.0) ? m_total.ticks / dt : 0.0;
+
+		m_last_report = t;
+		fprintf(stderr, "PROFILE: %lu ticks, %.0f ticks/s",
+			m_total.ticks, tps);
+		if ((m_expect > 0)&&(tps > 0.0)) {
+			double	done = (double)m_total.ticks / m_expect;
+
+			if (done > 1.0)
+				done = 1.0;
+			fprintf(stderr, ", %5.1f%% done, ETA %.0fs",
+				100.0 * done, (m_expect > m_total.ticks)
+				? (m_expect - m_total.ticks) / tps : 0.0);
+		}
+		fprintf(stderr, "\n");
+	}
+
+	// An open ended phase, begun by enter(), that runs until the next
+	// enter() or the end of the run
+	int		m_open;
+	uint64_t	m_open_start, m_open_scoped;
+
+	void	close_open(void) {
+		if (m_open >= 0) {
+			uint64_t	dt = profile_now() - m_open_start,
+					sc = profile_scoped - m_open_scoped;
+
+			m_total.count[m_open] += (dt > sc) ? dt - sc : 0;
+		} m_open = -1;
+	}
+
+	static	void	atexit_report(void);
+public:
+	bool	m_on;
+
+	TBPROFILE(void) : m_start(0), m_start_sec(0.0), m_last_report(0.0),
+			m_expect(0), m_fname(NULL), m_bench(NULL),
+			m_open(-1), m_open_start(0), m_open_scoped(0),
+			m_on(false) {
+		pthread_mutex_init(&m_lock, NULL);
+		memset(&m_total, 0, sizeof(m_total));
+	}
+
+	void	start(const char *fname, const char *bench) {
+		if (m_on)
+			return;
+		m_fname = fname;
+		m_bench = bench;
+		m_start = profile_now();
+		m_start_sec = m_last_report = profile_seconds();
+		m_on = true;
+		atexit(atexit_report);
+	}
+
+	// The number of ticks the bench expects to run, for the ETA
+	void	expect(unsigned long nticks) { m_expect = nticks; }
+
+	// Adds one TESTB's (or scope's) counts to the totals
+	void	add(const PROFILE_COUNTS &c) {
+		pthread_mutex_lock(&m_lock);
+		for(int k=0; k<PROF_NPHASES; k++)
+			m_total.count[k] += c.count[k];
+		m_total.ticks += c.ticks;
+		if (profile_seconds() - m_last_report >= 1.0)
+			progress();
+		pthread_mutex_unlock(&m_lock);
+	}
+
+	//
+	// enter
+	//
+	// Charges the time this thread spends from now on, outside of any
+	// PROFILE_SCOPE, to phase.  Unlike a PROFILE_SCOPE, this survives an
+	// exit(), and so suits the post-pass of a bench's main().
+	void	enter(PROFILE_PHASE phase) {
+		if (!m_on)
+			return;
+		pthread_mutex_lock(&m_lock);
+		close_open();
+		m_open = phase;
+		m_open_start  = profile_now();
+		m_open_scoped = profile_scoped;
+		pthread_mutex_unlock(&m_lock);
+	}
+
+	void	add(PROFILE_PHASE phase, uint64_t count) {
+		pthread_mutex_lock(&m_lock);
+		m_total.count[phase] += count;
+		pthread_mutex_unlock(&m_lock);
+	}
+
+	void	report(FILE *fp) {
+		double	scl, wall, sum = 0.0;
+
+		pthread_mutex_lock(&m_lock);
+		close_open();
+		scl  = 1.0 / rate();
+		wall = profile_seconds() - m_start_sec;
+		for(int k=0; k<PROF_NPHASES; k++)
+			sum += m_total.count[k] * scl;
+
+		fprintf(fp, "{\n"
+			"  \"bench\": \"%s\",\n"
+			"  \"timer\": \"%s\",\n"
+			"  \"ticks\": %lu,\n"
+			"  \"wall_seconds\": %.6f,\n"
+			"  \"ticks_per_second\": %.1f,\n"
+			"  \"phases\": {\n", m_bench,
+#ifdef	PROFILE_RDTSC
+			"rdtsc",
+#else
+			"steady_clock",
+#endif
+			m_total.ticks, wall,
+			(wall > 0.0) ? m_total.ticks / wall : 0.0);
+		for(int k=0; k<PROF_NPHASES; k++) {
+			double	s = m_total.count[k] * scl;
+
+			fprintf(fp, "    \"%s\": { \"seconds\": %.6f, "
+				"\"fraction\": %.4f, \"ns_per_tick\": %.2f }%s\n",
+				PROFILE_NAMES[k], s,
+				(sum > 0.0) ? s / sum : 0.0,
+				(m_total.ticks > 0)
+					? 1e9 * s / m_total.ticks : 0.0,
+				(k+1 < PROF_NPHASES) ? ",":"");
+		}
+		fprintf(fp, "  }\n}\n");
+		pthread_mutex_unlock(&m_lock);
+	}
+};
+
+static	TBPROFILE	tbprofile;
+
+inline void	TBPROFILE::atexit_report(void) {
+	FILE	*fp;
+
+	if (NULL == (fp = fopen(tbprofile.m_fname, "w"))) {
+		fprintf(stderr, "ERR: Could not write the profile to %s\n",
+			tbprofile.m_fname);
+		return;
+	}
+	tbprofile.report(fp);
+	fclose(fp);
+	fprintf(stderr, "PROFILE: Written to %s\n", tbprofile.m_fname);
+}
+
+//
+// tb_profile
+//
+// Starts profiling if --profile[=<file>] is on the command line, with the
+// summary going to <file>, or to <bench>.profile.json.
+static inline void	tb_profile(int argc, char **argv, const char *bench) {
+	static	char	dflt[256];
+
+	for(int k=1; k<argc; k++) {
+		if (strcmp(argv[k], "--profile")==0) {
+			snprintf(dflt, sizeof(dflt), "%s.profile.json", bench);
+			tbprofile.start(dflt, bench);
+		} else if (strncmp(argv[k], "--profile=", 10)==0)
+			tbprofile.start(&argv[k][10], bench);
+	}
+}
+
+//
+// PROFILE_SCOPE
+//
+// Charges the time from its construction to its destruction to phase.
+class	PROFILE_SCOPE {
+	PROFILE_PHASE	m_phase;
+	uint64_t	m_start;
+public:
+	PROFILE_SCOPE(PROFILE_PHASE phase) : m_phase(phase), m_start(0) {
+		if (tbprofile.m_on)
+			m_start = profile_now();
+	}
+	~PROFILE_SCOPE(void) {
+		if ((tbprofile.m_on)&&(m_start != 0)) {
+			uint64_t	dt = profile_now() - m_start;
+
+			profile_scoped += dt;
+			tbprofile.add(m_phase, dt);
+		}
+	}
+};
+
+#endif	// PROFILE_H
@@ -7,6 +7,42 @@
 // Purpose:	A quick test bench to determine if the sine wave generator
 //		based upon a table of quadratic coefficients works.
 //
+//	Given -j <n> (or TB_THREADS=<n>), the phase sweep is split across n
+//	independent copies of the core, each on its own thread.
+//
+//	Tracing is off unless --trace, --trace-window=<start>:<stop>, or
+//	--trace-ring=<cycles> is given.  See testb.h for details.
+//
+//	The SFDR is estimated from 2^20 point segments of the sweep (see
+//	spectrum.h), or 2^<lg> point segments given --fft=<lg>.
+//
+//	No more than 2^26 phases are ever swept.  Given --search[=<probes>],
+//	the test bench instead hunts for the worst case error across every
+//	phase (see errsearch.h), concentrating on the places each segment's
+//	minimax fit puts its error peaks.
+//
+//	Given --lockstep, every output of either is also checked, bit for bit,
+//	against the core's software model as it emerges, and the test stops
+//	at the first mismatch.
+//
+//	Given --dump[=<file>], every phase swept, the output it produced, and
+//	the true sine wave value are written to quadtbl_tb.dump (or <file>),
+//	in the format described in resdump.h.
+//
+//	Given --profile[=<file>], the time of the run is split between
+//	Verilator's eval(), tracing, lockstep checks, stimulus, the FFTs, and
+//	the closing statistics, with a progress line every second and a JSON
+//	summary written on exit to quadtbl_tb.profile.json (or <file>).  See
+//	profile.h.
+//
+//	Inputs are queued up, and clocked into the core TB_BATCH clocks at a
+//	time through TESTB::tick_fast(), with its results read back out of
+//	QUADTBL_TB::m_outq.
+//
+//	Built with -DDSPQUADTBL, this tests dspquadtbl.v instead, the same
+//	core with its multiplies sized and pipelined for a DSP (-D and -L),
+//	and with its file names to match.
+//
 // Creator:	Dan Gisselquist, Ph.D.
 //		Gisselquist Technology, LLC
 //
@@ -40,20 +76,69 @@
 
 #include <verilated.h>
 #include <verilated_vcd_c.h>
-#include "Vquadtbl.h"
-#include "quadtbl.h"
-#include "fft.h"
+#ifdef	DSPQUADTBL
+# include "Vdspquadtbl.h"
+# include "dspquadtbl.h"
+# include "dspquadtbl_model.h"
+# define BASECLASS Vdspquadtbl
+# define MODEL_SIN dspquadtbl_sin
+# define CORENAME "dspquadtbl"
+#else
+# include "Vquadtbl.h"
+# include "quadtbl.h"
+# include "quadtbl_model.h"
+# define BASECLASS Vquadtbl
+# define MODEL_SIN quadtbl_sin
+# define CORENAME "quadtbl"
+#endif
 #include "testb.h"
+#include "shard.h"
+#include "errstats.h"
+#include "spectrum.h"
+#include "errsearch.h"
+#include "resdump.h"
 
 #ifndef	HAS_AUX_WIRES
 #error "This test-bench depends upon the quadtbl component having\n\tbeen configured for an aux wire."
 #endif
 
-class	QUADTBL_TB : public TESTB<Vquadtbl> {
+//
+// LOCKSTEP_IN
+//
+// A phase the core has accepted, kept until its output can be checked
+// against the software model.
+typedef	struct	{
+	unsigned long	clock;
+	uint32_t	phase;
+} LOCKSTEP_IN;
+
+//
+// QUADTBL_OUT
+//
+// A result, as the core produced it, together with the number of phases the
+// core had accepted by then.
+typedef	struct	{
+	uint32_t	sin;
+	unsigned long	nin;
+} QUADTBL_OUT;
+
+// The most clocks queue() will hold before feeding them to the core.  The
+// results of a batch must fit within a SAMPLE_FIFO.
+#define	TB_BATCH	128
+
+class	QUADTBL_TB : public TESTB<BASECLASS> {
 	bool		m_debug;
+	SAMPLE_FIFO<LOCKSTEP_IN>	m_lsfifo;
+	// The inputs of each clock queued, and yet to be fed to the core
+	uint32_t	m_bphase[TB_BATCH];
+	uint8_t		m_baux[TB_BATCH];
+	int		m_nbatch;
+	unsigned long	m_nin;
 public:
+	// Every result the core has produced, in order, until it is read
+	SAMPLE_FIFO<QUADTBL_OUT>	m_outq;
 
-	QUADTBL_TB(void) {
+	QUADTBL_TB(void) : m_nbatch(0), m_nin(0) {
 		m_debug = true;
 		m_core->i_ce    = 1;
 		m_core->i_phase = 0;
@@ -67,97 +152,375 @@ public:
 		tick();
 #endif
 	}
+
+	// Queues up the inputs now on the core for the next clock, feeding
+	// them (and every clock queued before them) to the core once the
+	// queue is full.  With a trace open, the queue is fed every clock, so
+	// that any failure is caught while its clocks are still in the ring.
+	void	queue(void) {
+		m_bphase[m_nbatch] = m_core->i_phase;
+		m_baux[m_nbatch++] = m_core->i_aux;
+		if ((m_nbatch >= TB_BATCH)||(m_trace))
+			feed();
+	}
+
+	void	feed(void) {
+		tick_fast(m_nbatch, *this);
+		m_nbatch = 0;
+	}
+
+	// tick_fast()'s hooks, from within feed()
+	void	fast_in(unsigned long k) {
+		m_core->i_phase = m_bphase[k];
+		m_core->i_aux   = m_baux[k];
+	}
+
+	void	fast_out(unsigned long k) {
+		QUADTBL_OUT	out;
+
+		(void)k;
+		if (m_core->i_aux)
+			m_nin++;
+		if (!m_core->o_aux)
+			return;
+		out.sin = m_core->o_sin;
+		out.nin = m_nin;
+		m_outq.push(out);
+	}
+
+	void	lockstep_in(void) {
+		LOCKSTEP_IN	in;
+
+		if ((!m_core->i_ce)||(!m_core->i_aux))
+			return;
+		in.clock = m_tickcount;
+		in.phase = m_core->i_phase;
+		m_lsfifo.push(in);
+	}
+
+	int	lockstep_out(char *msg, size_t len) {
+		const uint32_t	omsk = (OW >= 32) ? 0xffffffffu : ((1u<<OW)-1);
+		int32_t		msin;
+
+		if (!m_core->o_aux)
+			return 0;
+		if (m_lsfifo.empty()) {
+			snprintf(msg, len, "an output, with no input to match it");
+			return -1;
+		}
+
+		const LOCKSTEP_IN	&in = m_lsfifo.pop();
+
+		msin = MODEL_SIN(in.phase);
+		if ((((uint32_t)m_core->o_sin ^ (uint32_t)msin) & omsk) == 0)
+			return 1;
+
+		snprintf(msg, len, "phase 0x%x, given on clock %lu, became "
+			"0x%x, not 0x%x", in.phase, in.clock,
+			(uint32_t)m_core->o_sin & omsk, (uint32_t)msin & omsk);
+		return -1;
+	}
 };
 
 const long	LGNSAMPLES=(PW>26)?26:PW;
 const long	NSAMPLES=(1ul<<LGNSAMPLES);
 
-int main(int  argc, char **argv) {
-	Verilated::commandArgs(argc, argv);
-	QUADTBL_TB	*tb = new QUADTBL_TB;
-	long	*pdata, *sdata, idx;
-	int	shift;
-	bool	failed = false;
+//
+// QUADTBL_STATS
+//
+// Running error statistics, together with the largest and smallest values
+// produced.  Each shard keeps its own, and they are merged at the end.
+class	QUADTBL_STATS {
+public:
+	ERRSTAT	err;
+	int	imxv, imnv;
 
-	pdata = new long[NSAMPLES];
-	sdata = new long[NSAMPLES];
+	QUADTBL_STATS(void) : imxv(0), imnv(0) {}
 
-	// This only works on DUT's with the aux flag turned on.
-	assert(HAS_AUX);
+	// Returns the expected value of this sample, given its phase
+	static double	predict(long phase) {
+		double	ph, scl;
 
-	// tb->opentrace("quadtbl_tb.vcd");
-	tb->reset();
+		ph = phase;
+		ph = ph * M_PI * 2.0 / (double)(1ul<<PW);
+		scl= ((1<<(OW-1))-1);
+		return sin(ph) * scl;
+	}
+
+	// Returns the magnitude of the error in this sample
+	double	add(double dsin, long sdata) {
+		double	e;
+
+		e = fabs(dsin-sdata);
+		err.add(e);
+		if (sdata > imxv)
+			imxv = sdata;
+		else if (sdata < imnv)
+			imnv = sdata;
+		return e;
+	}
 
+	void	merge(const QUADTBL_STATS &s) {
+		err.merge(s.err);
+		if (s.imxv > imxv)
+			imxv = s.imxv;
+		if (s.imnv < imnv)
+			imnv = s.imnv;
+	}
+};
+
+static	QUADTBL_STATS	stats[MAX_SHARDS];
+static	SPECTRUM	spectra[MAX_SHARDS];
+static	TRACEOPTS	traceopts;
+static	bool		lockstep;
+static	unsigned	lgfft;
+// The results of the sweep, should --dump ask for them.  Each shard writes
+// its own slice of every column.
+static	RESDUMP		dump;
+static	int		dcol_phase, dcol_sin, dcol_ref;
+
+//
+// result
+//
+// Reads the (sign extended) sine wave from one of the core's outputs.
+static long	result(const QUADTBL_OUT &out) {
+	const int	shift = (8*sizeof(long)-OW);
+	long	sv;
+
+	sv = out.sin;
+	sv <<= shift;
+	sv >>= shift;
+	return sv;
+}
 
-	idx = 0;
-	for(long i=0; i<NSAMPLES; i++) {
-		shift = (PW-LGNSAMPLES);
-		if (shift < 0) {
-			long	sv = i;
-			if (i & (1ul<<(-shift)))
-				// Odd value, round down
-				sv += (1ul<<(-shift-1))-1;
-			else
-				sv += (1ul<<(-shift-1));
-			tb->m_core->i_phase = sv >> (-shift);
+//
+// sweep
+//
+// Runs the samples [lo,hi) through a freshly built and reset core,
+// accumulating the error statistics and the spectrum of the samples as they
+// emerge.  lo and hi must fall on spectral segment boundaries.
+static void	sweep(int shard, long lo, long hi, void *arg) {
+	QUADTBL_TB	*tb = new QUADTBL_TB;
+	SAMPLE_FIFO<long>	fifo;
+	QUADTBL_STATS	*st = &stats[shard];
+	SPECTRUM	*sp = &spectra[shard];
+	RESDUMP_SHARD	ds(&dump, lo);
+	long		*sdata;
+	long		nout;
+	int		shift;
+
+	// Only the first shard gets a trace--unless we are keeping a trace
+	// ring, in which case every shard keeps its own.
+	if (shard == 0)
+		tb->opentrace(traceopts, CORENAME "_tb.vcd");
+	else if (traceopts.mode == TRACE_RING) {
+		char	fname[64];
+
+		sprintf(fname, CORENAME "_tb-%d.vcd", shard);
+		tb->opentrace(traceopts, fname);
+	}
+	tb->reset();
+	tb->lockstep(lockstep);
+
+	sp->init(LGNSAMPLES, lgfft);
+	sdata = new long[sp->m_fftlen];
+
+	nout = 0;
+	for(long i=lo; i<hi || !fifo.empty(); i++) {
+		if (i < hi) {
+			long	p = sp->sweep_index(i);
+			shift = (PW-LGNSAMPLES);
+			if (shift < 0) {
+				long	sv = p;
+				if (p & (1ul<<(-shift)))
+					// Odd value, round down
+					sv += (1ul<<(-shift-1))-1;
+				else
+					sv += (1ul<<(-shift-1));
+				tb->m_core->i_phase = sv >> (-shift);
+			} else
+				tb->m_core->i_phase = p << shift;
+			fifo.push((long)tb->m_core->i_phase);
+			tb->m_core->i_aux   = 1;
 		} else
-			tb->m_core->i_phase = ((long)i) << shift;
-		pdata[i] = (long)tb->m_core->i_phase;
-		tb->m_core->i_aux   = 1;
-		tb->tick();
-
-		if (tb->m_core->o_aux) {
-			shift = (8*sizeof(sdata[0])-OW);
-			// Make our values signed..
-			sdata[idx] = tb->m_core->o_sin;
-			sdata[idx] <<= shift;
-			sdata[idx] >>= shift;
-			idx++;
+			tb->m_core->i_aux   = 0;
+		tb->queue();
+
+		while(!tb->m_outq.empty()) {
+			const QUADTBL_OUT	&out = tb->m_outq.pop();
+			long	pdata, sv;
+			double	dsin;
+
+			TBASSERT(*tb, !fifo.empty());
+			// A sample entered the core on every clock, so the
+			// first result should emerge LATENCY clocks in
+			TBASSERT(*tb, (nout > 0)||(out.nin == LATENCY));
+			pdata = fifo.pop();
+			sv = result(out);
+			{
+				// Once we have a whole segment, turn it into
+				// a complex exponential and add it to our
+				// spectrum
+				const unsigned long	L = sp->m_fftlen,
+							k = (lo+nout) & (L-1);
+
+				sdata[k] = sv;
+				if (k == L-1) {
+					for(unsigned long j=0; j<L; j++) {
+						sp->m_seg[j].real(sdata[(j+(L/4))&(L-1)]);
+						sp->m_seg[j].imag(sdata[j]);
+					}
+					sp->add();
+				}
+			}
+
+			dsin = QUADTBL_STATS::predict(pdata);
+			ds.i32(dcol_phase, pdata);
+			ds.i32(dcol_sin,   sv);
+			ds.f64(dcol_ref,   dsin);
+			ds.next();
+
+			// When keeping a trace ring, save it as soon as any
+			// one sample is out of bounds.
+			if ((st->add(dsin, sv) > fabs(TBL_ERR) + 2.)
+					&&(traceopts.mode == TRACE_RING))
+				tb->failtrace();
+			nout++;
 		}
 	}
+	TBASSERT(*tb, nout == hi-lo);
+	ds.flush();
 
-	tb->m_core->i_aux = 0;
-	shift = (8*sizeof(sdata[0])-OW);
-	while(tb->m_core->o_aux) {
-		tb->m_core->i_aux   = 0;
-		tb->tick();
+	delete[] sdata;
+	sp->release();
+	delete tb;
+}
 
-		if (tb->m_core->o_aux) {
-			sdata[idx]   = tb->m_core->o_sin;
-			sdata[idx] <<= shift;
-			sdata[idx] >>= shift;
-			idx++;
-			assert(idx <= NSAMPLES);
+//
+// probe
+//
+// Runs each of n phases through the core, returning the error of each
+// result.
+static void	probe(const long *pts, int n, double *err, void *arg) {
+	QUADTBL_TB	*tb = (QUADTBL_TB *)arg;
+	SAMPLE_FIFO<int>	fifo;
+	int		nout = 0;
+
+	for(int i=0; i<n || !fifo.empty(); i++) {
+		if (i < n) {
+			tb->m_core->i_phase = pts[i];
+			fifo.push(i);
+			tb->m_core->i_aux   = 1;
+		} else
+			tb->m_core->i_aux   = 0;
+		tb->queue();
+
+		while(!tb->m_outq.empty()) {
+			const QUADTBL_OUT	&out = tb->m_outq.pop();
+			int	k;
+
+			TBASSERT(*tb, !fifo.empty());
+			k = fifo.pop();
+			err[k] = stats[0].add(QUADTBL_STATS::predict(pts[k]),
+					result(out));
+			if ((err[k] > fabs(TBL_ERR) + 2.)
+					&&(traceopts.mode == TRACE_RING))
+				tb->failtrace();
+			nout++;
 		}
 	}
+	TBASSERT(*tb, nout == n);
+}
 
-	FILE	*fdbg = fopen("quadtbl.32t","w");
+//
+// search
+//
+// Rather than sweeping (at most 2^26 of) the phases, hunts for the worst
+// one with an ERRSEARCH of budget probes.
+static int	search(long budget) {
+	QUADTBL_TB	*tb = new QUADTBL_TB;
+	const long	space = 1l<<PW,
+			seg = 1l<<(PW-TBL_LGSZ);
 
-	double	mxerr = 0.0;
-	int	imxv = 0, imnv = 0;
-	for(int i=0; i<NSAMPLES; i++) {
-		int	odata[3];
-		double	ph, scl, dsin, err;
+	tb->opentrace(traceopts, CORENAME "_tb.vcd");
+	tb->reset();
+	tb->lockstep(lockstep);
+
+	ERRSEARCH	es(space, seg/8, probe, tb);
+
+	// Each segment of the table is fit by its own minimax quadratic, so
+	// its error peaks at either end, where one segment gives way to the
+	// next, and (roughly) at the extrema of a third order Chebyshev
+	// polynomial in between: a quarter and three quarters of the way in.
+	for(long k=0; k<(1l<<TBL_LGSZ); k++) {
+		es.hotspot(k*seg, 1);
+		es.hotspot(k*seg + seg/4);
+		es.hotspot(k*seg + 3*seg/4);
+	}
+	es.search(budget);
+	es.report(stdout);
+	if (lockstep)
+		printf("LOCKSTEP: All %lu outputs matched the model\n",
+			es.m_nprobes);
+	delete tb;
+
+	printf("MXERR: %f (Expected %f)\n", es.m_max, TBL_ERR);
+	printf("MXVAL: 0x%08x\n", stats[0].imxv);
+	printf("MNVAL: 0x%08x\n", stats[0].imnv);
+	if (fabs(es.m_max) > fabs(TBL_ERR) + 2.) {
+		printf("TEST FAILURE\n");
+		return EXIT_FAILURE;
+	}
 
-		odata[0] = pdata[i];
-		odata[1] = sdata[i];
+	printf("SUCCESS!!\n");
+	return EXIT_SUCCESS;
+}
 
-		ph = odata[0];
-		ph = ph * M_PI * 2.0 / (double)(1ul<<PW);
-		scl= ((1<<(OW-1))-1);
-		dsin = sin(ph) * scl;
-		odata[2] = (int)dsin;
+int main(int  argc, char **argv) {
+	Verilated::commandArgs(argc, argv);
+	bool	failed = false;
+	long	budget;
+
+	tb_traceopts(&traceopts, argc, argv);
+	budget = tb_search(argc, argv);
+	lockstep = tb_lockstep(argc, argv);
+	tb_profile(argc, argv, CORENAME "_tb");
+	tbprofile.expect((budget > 0) ? budget : NSAMPLES);
+
+	// This only works on DUT's with the aux flag turned on.
+	assert(HAS_AUX);
+
+	if (budget > 0)
+		exit(search(budget));
+	if (LGNSAMPLES < PW)
+		printf("Sweeping only 2^%ld of the 2^%d phases.  Use --search to hunt across all of them\n",
+			LGNSAMPLES, PW);
+
+	if (const char *fname = tb_dump(argc, argv, CORENAME "_tb.dump")) {
+		if (!dump.open(fname, CORENAME, 0, OW, PW, 1.0, NSAMPLES))
+			exit(EXIT_FAILURE);
+		dcol_phase = dump.column("i_phase", RESDUMP_I32);
+		dcol_sin   = dump.column("o_sin",   RESDUMP_I32);
+		dcol_ref   = dump.column("sin",     RESDUMP_F64);
+	}
+
+	lgfft = tb_lgfft(argc, argv, LGNSAMPLES);
 
-		fwrite(odata, sizeof(int), 3, fdbg);
+	run_shards_aligned(tb_nshards(argc, argv), NSAMPLES, 1l<<lgfft,
+		sweep, NULL);
+	tbprofile.enter(PROF_STATS);
+	if (lockstep)
+		printf("LOCKSTEP: All %ld outputs matched the model\n", NSAMPLES);
 
-		err = fabs(dsin-sdata[i]);
-		if (err>mxerr)
-			mxerr = fabs(dsin-sdata[i]);
-		if (sdata[i] > imxv)
-			imxv = sdata[i];
-		else if (sdata[i] < imnv)
-			imnv = sdata[i];
-	} fclose(fdbg);
+	dump.close();
+
+	for(int k=1; k<MAX_SHARDS; k++) {
+		stats[0].merge(stats[k]);
+		spectra[0].merge(spectra[k]);
+	}
+
+	double	mxerr = stats[0].err.max();
+	int	imxv = stats[0].imxv, imnv = stats[0].imnv;
 
 	printf("MXERR: %f (Expected %f)\n", mxerr, TBL_ERR);
 	if (fabs(mxerr) > fabs(TBL_ERR) + 2.)
@@ -169,38 +532,7 @@ int main(int  argc, char **argv) {
 		goto test_failed;
 
 	// Estimate the spurious free dynamic range
-	if ((PW < 26)&&(NSAMPLES == (1ul << PW))) {
-		typedef	std::complex<double>	COMPLEX;
-		COMPLEX	*outpt;
-		const	unsigned long	FFTLEN=(1ul<<PW);
-
-		outpt = new COMPLEX[FFTLEN];
-
-		for(unsigned k=0; k<FFTLEN; k++) {
-			outpt[k].real(sdata[(k+(FFTLEN/4))&(FFTLEN-1)]);
-			outpt[k].imag(sdata[k]);
-		}
-
-		// Now we need to do an FFT
-		cfft((double *)outpt, (int)FFTLEN);
-
-		double	master, spur, tmp;
-
-		// Master is the energy in the signal of interest
-		master = norm(outpt[1]);
-
-		// SPUR is the energy in any other FFT bin output
-		spur = norm(outpt[0]);
-		for(unsigned k=2; k<FFTLEN; k++) {
-			tmp = norm(outpt[k]);
-			if (tmp > spur)
-				spur = tmp;
-		}
-
-		printf("SFDR = %7.2f dBc\n",
-			10*log(master / spur)/log(10.));
-	} else if (PW >= 26)
-		printf("Too many phase bits ... skipping SFDR calculation\n");
+	spectra[0].report(stdout);
 
 	printf("SUCCESS!!\n");
 	exit(EXIT_SUCCESS);
@@ -0,0 +1,137 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename: 	resdump.cpp
+//
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	Reads back a dump written by one of the test benches given
+//		--dump (see resdump.h).  With only a file name, describes the
+//	core the dump came from, and summarizes every column.  Given a range of
+//	samples as well, prints those samples as CSV.
+//
+//	Usage:	resdump <file> [<first>[:<count>]]
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2017, Gisselquist Technology, LLC
+//
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+//
+// License:	GPL, v3, as defined and found on www.gnu.org,
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+//
+#include <stdio.h>
+#include <stdlib.h>
+#include "resdump.h"
+
+static double	value(const RESDUMP_MAP &m, int col, unsigned long k) {
+	if (m.m_hdr->col[col].type == RESDUMP_F64)
+		return ((const double *)m.column(col))[k];
+	return ((const int32_t *)m.column(col))[k];
+}
+
+static void	summarize(const RESDUMP_MAP &m) {
+	const RESDUMP_HEADER	*h = m.m_hdr;
+
+	printf("Core:     %.*s\n", (int)sizeof(h->core), h->core);
+	printf("IW/OW/PW: %d/%d/%d\n", h->iw, h->ow, h->pw);
+	printf("GAIN:     %.16f\n", h->gain);
+	printf("Samples:  %lu\n", (unsigned long)h->nsamples);
+	printf("%-16s %-4s %12s %16s %16s %16s\n", "Column", "Type",
+		"Offset", "Min", "Max", "Mean");
+
+	for(unsigned c=0; c<h->ncols; c++) {
+		double	mn = 0.0, mx = 0.0, sum = 0.0;
+
+		for(unsigned long k=0; k<h->nsamples; k++) {
+			double	v = value(m, c, k);
+
+			if ((k == 0)||(v < mn))
+				mn = v;
+			if ((k == 0)||(v > mx))
+				mx = v;
+			sum += v;
+		}
+
+		printf("%-16.*s %-4s %12lu %16.4f %16.4f %16.4f\n",
+			(int)sizeof(h->col[c].name), h->col[c].name,
+			(h->col[c].type == RESDUMP_F64) ? "f64" : "i32",
+			(unsigned long)h->col[c].offset, mn, mx,
+			(h->nsamples > 0) ? sum / h->nsamples : 0.0);
+	}
+}
+
+static void	rows(const RESDUMP_MAP &m, unsigned long first, unsigned long n) {
+	const RESDUMP_HEADER	*h = m.m_hdr;
+
+	if (first >= h->nsamples)
+		return;
+	if (n > h->nsamples - first)
+		n = h->nsamples - first;
+
+	printf("sample");
+	for(unsigned c=0; c<h->ncols; c++)
+		printf(",%.*s", (int)sizeof(h->col[c].name), h->col[c].name);
+	printf("\n");
+
+	for(unsigned long k=first; k<first+n; k++) {
+		printf("%lu", k);
+		for(unsigned c=0; c<h->ncols; c++) {
+			if (h->col[c].type == RESDUMP_F64)
+				printf(",%.6f", value(m, c, k));
+			else
+				printf(",%d", ((const int32_t *)m.column(c))[k]);
+		}
+		printf("\n");
+	}
+}
+
+int	main(int argc, char **argv) {
+	RESDUMP_MAP	m;
+
+	if ((argc < 2)||(argc > 3)) {
+		fprintf(stderr, "Usage: resdump <file> [<first>[:<count>]]\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if (!m.open(argv[1]))
+		exit(EXIT_FAILURE);
+
+	if (argc == 2)
+		summarize(m);
+	else {
+		unsigned long	first, n = 1;
+		char		*ptr;
+
+		first = strtoul(argv[2], &ptr, 0);
+		if (*ptr == ':')
+			n = strtoul(ptr+1, &ptr, 0);
+		if (*ptr) {
+			fprintf(stderr, "ERR: Bad sample range, %s\n", argv[2]);
+			exit(EXIT_FAILURE);
+		}
+		rows(m, first, n);
+	}
+
+	exit(EXIT_SUCCESS);
+}
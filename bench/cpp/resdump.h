@@ -0,0 +1,386 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename: 	resdump.h
+//
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	A common, binary, format for capturing everything a test bench
+//		put into a core and got out of it, so that a long run can be
+//	post-processed without simulating it again.
+//
+//	A dump starts with a RESDUMP_HEADER describing the core (its type,
+//	IW, OW, PW, and GAIN), the number of samples, and the columns that
+//	follow.  Each column is then a plain array of one value per sample,
+//	starting on its own RESDUMP_ALIGN boundary, so that any one column may
+//	be mapped and used in place:  from numpy, for example, with
+//
+//		np.memmap(fname, dtype='<i4', mode='r', offset=col_offset,
+//			shape=(nsamples,))
+//
+//	Everything is stored in the host's (little endian) byte order.  The
+//	header is only written once every column is complete, so a run that
+//	dies part way through leaves a file without a valid magic number.
+//
+//	Every shard of a sweep writes its own slice of each column, through
+//	its own RESDUMP_SHARD, RESDUMP_BLOCK samples at a time.
+//
+//	RESDUMP_MAP is the matching reader.  It maps the whole file, checks
+//	the header, and hands back a pointer to any column by name.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2017, Gisselquist Technology, LLC
+//
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+//
+// License:	GPL, v3, as defined and found on www.gnu.org,
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+//
+#ifndef	RESDUMP_H
+#define	RESDUMP_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define	RESDUMP_MAGIC		"GCRESDMP"
+#define	RESDUMP_VERSION		1
+#define	RESDUMP_MAXCOLS		14
+// Every column starts on a page boundary, so each may be mapped on its own
+#define	RESDUMP_ALIGN		4096
+// The number of samples each shard buffers before writing them out
+#define	RESDUMP_BLOCK		(1<<16)
+
+typedef	enum	{
+	RESDUMP_I32 = 1,	// int32_t
+	RESDUMP_F64 = 2		// double
+} RESDUMP_TYPE;
+
+//
+// RESDUMP_COLUMN, RESDUMP_HEADER
+//
+// The header is the first sizeof(RESDUMP_HEADER) (512) bytes of the file.
+// Every field is of a fixed size, and naturally aligned.
+//
+typedef	struct	{
+	char		name[16];	// Zero padded, such as "o_xval"
+	uint32_t	type;		// A RESDUMP_TYPE
+	uint32_t	size;		// Bytes per sample
+	uint64_t	offset;		// From the start of the file
+} RESDUMP_COLUMN;
+
+typedef	struct	{
+	char		magic[8];	// RESDUMP_MAGIC, with no terminator
+	uint32_t	version;	// RESDUMP_VERSION
+	uint32_t	ncols;
+	char		core[16];	// Zero padded, such as "quadtbl"
+	int32_t		iw, ow, pw;	// iw is zero for the sine wave tables
+	int32_t		unused;
+	uint64_t	nsamples;
+	double		gain;
+	RESDUMP_COLUMN	col[RESDUMP_MAXCOLS];
+} RESDUMP_HEADER;
+
+//
+// tb_dump
+//
+// Returns the file named by --dump=<file>, dflt given a bare --dump, or NULL
+// if no dump was requested.
+static inline const char	*tb_dump(int argc, char **argv, const char *dflt) {
+	for(int k=1; k<argc; k++) {
+		if (strcmp(argv[k], "--dump")==0)
+			return dflt;
+		else if (strncmp(argv[k], "--dump=", 7)==0)
+			return &argv[k][7];
+	}
+	return NULL;
+}
+
+//
+// RESDUMP
+//
+// A dump being written.  Columns are all declared up front, then filled in
+// (in any order, by any number of threads) by write(), and the header is
+// written by close().
+//
+class	RESDUMP {
+	int		m_fd;
+	uint64_t	m_end;
+	RESDUMP_HEADER	m_hdr;
+	const char	*m_fname;
+public:
+	RESDUMP(void) : m_fd(-1), m_end(0), m_fname(NULL) {}
+	~RESDUMP(void) { close(); }
+
+	bool	is_open(void) const { return m_fd >= 0; }
+
+	const RESDUMP_HEADER	&header(void) const { return m_hdr; }
+
+	bool	open(const char *fname, const char *core, int iw, int ow,
+			int pw, double gain, long nsamples) {
+		m_fd = ::open(fname, O_WRONLY|O_CREAT|O_TRUNC, 0644);
+		if (m_fd < 0) {
+			perror(fname);
+			return false;
+		}
+		m_fname = fname;
+
+		memset(&m_hdr, 0, sizeof(m_hdr));
+		m_hdr.version  = RESDUMP_VERSION;
+		strncpy(m_hdr.core, core, sizeof(m_hdr.core)-1);
+		m_hdr.iw       = iw;
+		m_hdr.ow       = ow;
+		m_hdr.pw       = pw;
+		m_hdr.nsamples = nsamples;
+		m_hdr.gain     = gain;
+		m_end = RESDUMP_ALIGN;
+		return true;
+	}
+
+	// Adds a column, returning its index, or -1 if the dump isn't open
+	int	column(const char *name, RESDUMP_TYPE type) {
+		RESDUMP_COLUMN	*c;
+
+		if (m_fd < 0)
+			return -1;
+		assert(m_hdr.ncols < RESDUMP_MAXCOLS);
+		c = &m_hdr.col[m_hdr.ncols];
+		strncpy(c->name, name, sizeof(c->name)-1);
+		c->type   = type;
+		c->size   = (type == RESDUMP_F64) ? sizeof(double)
+					: sizeof(int32_t);
+		c->offset = m_end;
+		m_end += c->size * m_hdr.nsamples;
+		m_end  = (m_end + RESDUMP_ALIGN-1) & ~(uint64_t)(RESDUMP_ALIGN-1);
+		return m_hdr.ncols++;
+	}
+
+	// Writes samples [first, first+n) of column col
+	void	write(int col, long first, const void *data, long n) {
+		const RESDUMP_COLUMN	*c = &m_hdr.col[col];
+		const char	*ptr = (const char *)data;
+		size_t		len = n * c->size;
+		off_t		pos = c->offset + first * c->size;
+
+		assert((col >= 0)&&(col < (int)m_hdr.ncols));
+		assert((first >= 0)&&(first + n <= (long)m_hdr.nsamples));
+		while(len > 0) {
+			ssize_t	nw = pwrite(m_fd, ptr, len, pos);
+
+			if (nw <= 0) {
+				perror(m_fname);
+				return;
+			}
+			ptr += nw; pos += nw; len -= nw;
+		}
+	}
+
+	// Completes the file, by writing its header
+	void	close(void) {
+		const void	*hp = &m_hdr;
+
+		if (m_fd < 0)
+			return;
+		memcpy(m_hdr.magic, RESDUMP_MAGIC, sizeof(m_hdr.magic));
+		if ((ftruncate(m_fd, m_end) != 0)
+				||(pwrite(m_fd, hp, sizeof(m_hdr), 0)
+					!= (ssize_t)sizeof(m_hdr)))
+			perror(m_fname);
+		::close(m_fd);
+		m_fd = -1;
+	}
+};
+
+//
+// RESDUMP_SHARD
+//
+// One shard's slice of a dump, starting at sample first.  Each sample is
+// built up column by column with i32() and f64(), and then finished with
+// next().  Given a NULL (or unopened) dump, this does nothing at all.
+//
+class	RESDUMP_SHARD {
+	RESDUMP	*m_dump;
+	long	m_first;
+	int	m_n;
+	char	*m_buf[RESDUMP_MAXCOLS];
+public:
+	RESDUMP_SHARD(RESDUMP *dump, long first) : m_dump(NULL),
+			m_first(first), m_n(0) {
+		if ((!dump)||(!dump->is_open()))
+			return;
+		m_dump = dump;
+		for(unsigned k=0; k<m_dump->header().ncols; k++)
+			m_buf[k] = new char[(size_t)RESDUMP_BLOCK
+					* m_dump->header().col[k].size];
+	}
+
+	~RESDUMP_SHARD(void) {
+		if (!m_dump)
+			return;
+		flush();
+		for(unsigned k=0; k<m_dump->header().ncols; k++)
+			delete[] m_buf[k];
+	}
+
+	// True if anything is being dumped at all
+	bool	active(void) const { return m_dump != NULL; }
+
+	void	i32(int col, int32_t v) {
+		if (!m_dump)
+			return;
+		assert(m_dump->header().col[col].type == RESDUMP_I32);
+		((int32_t *)m_buf[col])[m_n] = v;
+	}
+
+	void	f64(int col, double v) {
+		if (!m_dump)
+			return;
+		assert(m_dump->header().col[col].type == RESDUMP_F64);
+		((double *)m_buf[col])[m_n] = v;
+	}
+
+	void	next(void) {
+		if ((m_dump)&&(++m_n >= RESDUMP_BLOCK))
+			flush();
+	}
+
+	void	flush(void) {
+		if ((!m_dump)||(m_n == 0))
+			return;
+		for(unsigned k=0; k<m_dump->header().ncols; k++)
+			m_dump->write(k, m_first, m_buf[k], m_n);
+		m_first += m_n;
+		m_n = 0;
+	}
+};
+
+//
+// RESDUMP_MAP
+//
+// Maps a completed dump into memory, read only.
+//
+class	RESDUMP_MAP {
+	int	m_fd;
+	void	*m_base;
+	size_t	m_len;
+public:
+	const RESDUMP_HEADER	*m_hdr;
+
+	RESDUMP_MAP(void) : m_fd(-1), m_base(NULL), m_len(0), m_hdr(NULL) {}
+	~RESDUMP_MAP(void) { close(); }
+
+	// Returns false, having said why, if fname isn't a complete dump
+	bool	open(const char *fname) {
+		struct stat	sb;
+
+		m_fd = ::open(fname, O_RDONLY);
+		if ((m_fd < 0)||(fstat(m_fd, &sb) != 0)) {
+			perror(fname);
+			close();
+			return false;
+		}
+		m_len = sb.st_size;
+		if (m_len < sizeof(RESDUMP_HEADER)) {
+			fprintf(stderr, "ERR: %s is too short to be a dump\n",
+				fname);
+			close();
+			return false;
+		}
+		m_base = mmap(NULL, m_len, PROT_READ, MAP_SHARED, m_fd, 0);
+		if (m_base == MAP_FAILED) {
+			m_base = NULL;
+			perror(fname);
+			close();
+			return false;
+		}
+		m_hdr = (const RESDUMP_HEADER *)m_base;
+
+		if ((memcmp(m_hdr->magic, RESDUMP_MAGIC, sizeof(m_hdr->magic))!=0)
+				||(m_hdr->version != RESDUMP_VERSION)
+				||(m_hdr->ncols > RESDUMP_MAXCOLS)) {
+			fprintf(stderr, "ERR: %s is not a (complete) version "
+				"%d dump\n", fname, RESDUMP_VERSION);
+			close();
+			return false;
+		}
+		for(unsigned k=0; k<m_hdr->ncols; k++) {
+			const RESDUMP_COLUMN	*c = &m_hdr->col[k];
+
+			if (c->offset + c->size * m_hdr->nsamples > m_len) {
+				fprintf(stderr, "ERR: %s has been truncated\n",
+					fname);
+				close();
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void	close(void) {
+		if (m_base)
+			munmap(m_base, m_len);
+		if (m_fd >= 0)
+			::close(m_fd);
+		m_base = NULL;
+		m_hdr  = NULL;
+		m_fd   = -1;
+	}
+
+	// Returns the index of the named column, or -1 if there's none
+	int	find(const char *name) const {
+		for(unsigned k=0; k<m_hdr->ncols; k++)
+			if (strncmp(m_hdr->col[k].name, name,
+					sizeof(m_hdr->col[k].name))==0)
+				return k;
+		return -1;
+	}
+
+	const void	*column(int col) const {
+		return (const char *)m_base + m_hdr->col[col].offset;
+	}
+
+	// Return the named column, or NULL if there's none of that type
+	const int32_t	*i32(const char *name) const {
+		int	k = find(name);
+
+		if ((k < 0)||(m_hdr->col[k].type != RESDUMP_I32))
+			return NULL;
+		return (const int32_t *)column(k);
+	}
+
+	const double	*f64(const char *name) const {
+		int	k = find(name);
+
+		if ((k < 0)||(m_hdr->col[k].type != RESDUMP_F64))
+			return NULL;
+		return (const double *)column(k);
+	}
+};
+
+#endif
@@ -0,0 +1,175 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename: 	shard.h
+//
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	Splits a test bench's phase sweep into contiguous shards, and
+//		runs each shard on its own thread.  Every shard is expected
+//	to build (and reset) its own Verilated model, so the shards share
+//	nothing but the disjoint slices of the result arrays they fill.  The
+//	error statistics are then computed across all slices once every
+//	shard has finished.
+//
+//	The number of shards comes from a "-j <n>" command line argument, or
+//	failing that from the TB_THREADS environment variable.  With neither
+//	given, the sweep runs as a single shard on the calling thread--just
+//	as the test benches have always run.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2017, Gisselquist Technology, LLC
+//
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+//
+// License:	GPL, v3, as defined and found on www.gnu.org,
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+//
+#ifndef	SHARD_H
+#define	SHARD_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <pthread.h>
+
+// Don't bother splitting any shard below this many samples.  The reset and
+// pipeline fill/flush of each shard's model costs a handful of clocks, so
+// tiny shards only add overhead.
+#define	MIN_SHARD_SAMPLES	4096
+#define	MAX_SHARDS		256
+
+typedef	void	(*SHARD_FN)(int shard, long lo, long hi, void *arg);
+
+typedef	struct	{
+	SHARD_FN	fn;
+	void		*arg;
+	int		shard;
+	long		lo, hi;
+} SHARD;
+
+//
+// tb_nshards
+//
+// Returns the number of shards requested on the command line (-j <n>) or
+// in the environment (TB_THREADS), or one if neither is present.
+static int	tb_nshards(int argc, char **argv) {
+	const char	*str = NULL;
+	int		n;
+
+	for(int k=1; k<argc; k++) {
+		if (strcmp(argv[k], "-j")==0 && k+1 < argc)
+			str = argv[++k];
+		else if (strncmp(argv[k], "-j", 2)==0 && argv[k][2])
+			str = &argv[k][2];
+	}
+
+	if (!str)
+		str = getenv("TB_THREADS");
+	if (!str)
+		return 1;
+
+	n = atoi(str);
+	if (n < 1)
+		n = 1;
+	if (n > MAX_SHARDS)
+		n = MAX_SHARDS;
+	return n;
+}
+
+static void	*shard_thread(void *vp) {
+	SHARD	*s = (SHARD *)vp;
+
+	s->fn(s->shard, s->lo, s->hi, s->arg);
+	return NULL;
+}
+
+//
+// run_shards_aligned
+//
+// Splits [0,nsamples) into nshards contiguous slices and calls fn on each,
+// one slice per thread.  Every slice boundary falls on a multiple of align.
+// Shard zero always runs on the calling thread, so that a single shard
+// behaves exactly as an unsharded sweep.  Returns once every shard has
+// completed.
+static void	run_shards_aligned(int nshards, long nsamples, long align,
+			SHARD_FN fn, void *arg) {
+	SHARD		shards[MAX_SHARDS];
+	pthread_t	threads[MAX_SHARDS];
+	long		nblocks;
+	int		nthreads;
+
+	if (align < 1)
+		align = 1;
+	nblocks = (nsamples + align - 1) / align;
+
+	if (nshards > MAX_SHARDS)
+		nshards = MAX_SHARDS;
+	if ((long)nshards * MIN_SHARD_SAMPLES > nsamples)
+		nshards = (int)(nsamples / MIN_SHARD_SAMPLES);
+	if (nshards > nblocks)
+		nshards = (int)nblocks;
+	if (nshards < 1)
+		nshards = 1;
+
+	for(int k=0; k<nshards; k++) {
+		shards[k].fn    = fn;
+		shards[k].arg   = arg;
+		shards[k].shard = k;
+		shards[k].lo    = align * (nblocks *  k    / nshards);
+		shards[k].hi    = align * (nblocks * (k+1) / nshards);
+		if (shards[k].hi > nsamples)
+			shards[k].hi = nsamples;
+	}
+
+	nthreads = 0;
+	for(int k=1; k<nshards; k++) {
+		if (pthread_create(&threads[k], NULL, shard_thread,
+				&shards[k]) != 0) {
+			fprintf(stderr, "ERR: Could not start shard %d\n", k);
+			// Run it on this thread, after everything else
+			break;
+		} nthreads++;
+	}
+
+	fn(0, shards[0].lo, shards[0].hi, arg);
+
+	for(int k=1+nthreads; k<nshards; k++)
+		fn(k, shards[k].lo, shards[k].hi, arg);
+	for(int k=1; k<=nthreads; k++)
+		pthread_join(threads[k], NULL);
+
+	if (nshards > 1)
+		printf("Swept %ld samples across %d shards\n", nsamples, nshards);
+}
+
+//
+// run_shards
+//
+// As above, but with no constraint on where the slices begin and end.
+static inline void	run_shards(int nshards, long nsamples, SHARD_FN fn, void *arg) {
+	run_shards_aligned(nshards, nsamples, 1, fn, arg);
+}
+
+#endif
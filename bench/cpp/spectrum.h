@@ -0,0 +1,211 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename: 	spectrum.h
+//
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	Estimates the spurious free dynamic range of a core from a
+//		stream of its outputs, using a bounded amount of memory no
+//	matter how many phase bits the core has.
+//
+//	A full sweep of N=2^LGN phases produces one cycle of a complex
+//	exponential, so the spurs of interest are the harmonics of that one
+//	cycle.  Rather than taking one giant N point FFT, the sweep is taken in
+//	N/L interleaved segments of L=2^LGFFT samples each.  Segment j holds
+//	phases j, j+N/L, j+2N/L, and so on, so every segment contains exactly
+//	one cycle, every phase is visited exactly once across all segments,
+//	and no window is needed.  Harmonic h of the full sweep lands in bin
+//	(h mod L) of every segment.  The segment spectra are then averaged
+//	(Welch), so when several harmonics alias into the same bin the bin
+//	holds the sum of their powers--the SFDR reported is therefore never
+//	better than that of the full length FFT, and it is identical to it
+//	whenever L == N.
+//
+//	Use sweep_index() to turn a sweep index into the phase index to drive
+//	into the core, fill m_seg with each segment's samples, and call add()
+//	once per completed segment.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2017, Gisselquist Technology, LLC
+//
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+//
+// License:	GPL, v3, as defined and found on www.gnu.org,
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+//
+#ifndef	SPECTRUM_H
+#define	SPECTRUM_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "fft.h"
+#include "profile.h"
+
+// The default segment length, and the largest allowed (log base two)
+#define	DEF_LGFFT	20
+#define	MAX_LGFFT	26
+// How many of the largest spurs to report
+#define	NSPURS		4
+
+//
+// tb_lgfft
+//
+// Returns the log (base two) of the segment length requested on the
+// command line via --fft=<lg>, limited to the number of samples in the
+// sweep, lgn.
+static unsigned	tb_lgfft(int argc, char **argv, unsigned lgn) {
+	unsigned	lg = DEF_LGFFT;
+
+	for(int k=1; k<argc; k++) {
+		if (strncmp(argv[k], "--fft=", 6)==0) {
+			lg = atoi(&argv[k][6]);
+			if ((lg < 2)||(lg > MAX_LGFFT)) {
+				fprintf(stderr, "ERR: Bad FFT size, %s\n",
+					argv[k]);
+				exit(EXIT_FAILURE);
+			}
+		}
+	}
+
+	if (lg > lgn)
+		lg = lgn;
+	return lg;
+}
+
+class	SPECTRUM {
+public:
+	unsigned	m_lgn, m_lgfft;
+	unsigned long	m_fftlen, m_nsegs;
+	double		*m_psd;
+	COMPLEX		*m_seg;	// The segment being built
+
+	SPECTRUM(void) : m_lgn(0), m_lgfft(0), m_fftlen(0), m_nsegs(0),
+			m_psd(NULL), m_seg(NULL) {}
+	~SPECTRUM(void) { release(); delete[] m_psd; }
+
+	// Free everything but the accumulated spectrum
+	void	release(void) {
+		if (m_seg)
+			fft_free((double *)m_seg);
+		m_seg = NULL;
+	}
+
+	void	init(unsigned lgn, unsigned lgfft) {
+		m_lgn    = lgn;
+		m_lgfft  = lgfft;
+		m_fftlen = 1ul << lgfft;
+		m_nsegs  = 0;
+		delete[] m_psd;
+		m_psd = new double[m_fftlen];
+		for(unsigned long k=0; k<m_fftlen; k++)
+			m_psd[k] = 0.0;
+		// Allocated so that the FFT can run in place, without copies
+		release();
+		m_seg = (COMPLEX *)fft_malloc(m_fftlen);
+	}
+
+	// The phase index to place at sweep index i.  Each run of m_fftlen
+	// sweep indices makes up one segment.
+	unsigned long	sweep_index(unsigned long i) const {
+		unsigned long	seg = i >> m_lgfft,
+				k   = i & (m_fftlen-1);
+
+		return (k << (m_lgn - m_lgfft)) + seg;
+	}
+
+	// Transform the segment in m_seg, in place, and add it to our
+	// average.
+	void	add(void) {
+		PROFILE_SCOPE	prof(PROF_FFT);
+
+		cfft(m_seg, (unsigned)m_fftlen);
+		for(unsigned long k=0; k<m_fftlen; k++)
+			m_psd[k] += norm(m_seg[k]);
+		m_nsegs++;
+	}
+
+	void	merge(const SPECTRUM &s) {
+		if (s.m_nsegs == 0)
+			return;
+		for(unsigned long k=0; k<m_fftlen; k++)
+			m_psd[k] += s.m_psd[k];
+		m_nsegs += s.m_nsegs;
+	}
+
+	//
+	// report
+	//
+	// Prints the SFDR, given that the signal of interest is in bin one,
+	// together with the largest few spurs.
+	void	report(FILE *fp) const {
+		PROFILE_SCOPE	prof(PROF_FFT);
+		unsigned long	spur[NSPURS] = { 0 };
+		double		master;
+		int		nspurs = 0;
+
+		if (m_nsegs == 0)
+			return;
+
+		// Master is the energy in the signal of interest
+		master = m_psd[1];
+
+		// SPURs are the energy in any other FFT bin output.  Keep
+		// the largest few, sorted by power.
+		for(unsigned long k=0; k<m_fftlen; k++) {
+			int	p;
+
+			if (k == 1)
+				continue;
+			if ((nspurs == NSPURS)
+					&&(m_psd[k] <= m_psd[spur[NSPURS-1]]))
+				continue;
+			if (nspurs < NSPURS)
+				nspurs++;
+			for(p=nspurs-1; p>0 && m_psd[k] > m_psd[spur[p-1]]; p--)
+				spur[p] = spur[p-1];
+			spur[p] = k;
+		}
+
+		if (m_nsegs > 1)
+			fprintf(fp, "(Averaged over %lu %lu-point segments)\n",
+				m_nsegs, m_fftlen);
+		fprintf(fp, "SFDR = %7.2f dBc\n",
+			10*log(master / m_psd[spur[0]])/log(10.));
+		for(int p=0; p<nspurs; p++) {
+			// Bin k holds harmonics k, k+L, k+2L, etc.  Report
+			// those from the negative side of the spectrum as
+			// negative harmonics.
+			long	h = (spur[p] >= m_fftlen/2)
+				? (long)spur[p]-(long)m_fftlen : (long)spur[p];
+
+			fprintf(fp, "  Spur: harmonic %6ld%s, %7.2f dBc\n", h,
+				(m_fftlen < (1ul<<m_lgn)) ? " (mod L)" : "",
+				10*log(m_psd[spur[p]] / master)/log(10.));
+		}
+	}
+};
+
+#endif
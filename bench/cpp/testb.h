@@ -41,23 +41,205 @@
 
 #include <stdio.h>
 #include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <string>
 #include <verilated_vcd_c.h>
+#include "profile.h"
 
-#define	TBASSERT(TB,A) do { if (!(A)) { (TB).closetrace(); } assert(A); } while(0);
+#define	TBASSERT(TB,A) do { if (!(A)) { (TB).failtrace(); } assert(A); } while(0);
+
+// The longest description of a lockstep mismatch
+#define	LOCKSTEP_MSGLEN	256
+
+//
+// Trace control
+//
+// Tracing is off unless asked for on the command line:
+//
+//	--trace[=<file>]		Trace every clock
+//	--trace-window=<start>:<stop>	Trace only ticks start through stop-1
+//	--trace-ring=<cycles>		Keep (at least) the last <cycles> clocks
+//					in memory, and only write them out if
+//					the test fails
+//
+// A --trace-window or --trace-ring may be combined with --trace=<file> to
+// pick the file name.
+//
+typedef	enum	{ TRACE_OFF = 0, TRACE_FULL, TRACE_WINDOW, TRACE_RING
+			} TRACE_MODE;
+
+typedef	struct	{
+	TRACE_MODE	mode;
+	const char	*fname;
+	unsigned long	start, stop, ring;
+} TRACEOPTS;
+
+static void	tb_traceopts(TRACEOPTS *opts, int argc, char **argv) {
+	opts->mode  = TRACE_OFF;
+	opts->fname = NULL;
+	opts->start = opts->stop = opts->ring = 0;
+
+	for(int k=1; k<argc; k++) {
+		const char	*a = argv[k];
+
+		if (strcmp(a, "--trace")==0) {
+			if (opts->mode == TRACE_OFF)
+				opts->mode = TRACE_FULL;
+		} else if (strncmp(a, "--trace=", 8)==0) {
+			if (opts->mode == TRACE_OFF)
+				opts->mode = TRACE_FULL;
+			opts->fname = &a[8];
+		} else if (strncmp(a, "--trace-window=", 15)==0) {
+			char	*ptr;
+
+			opts->mode  = TRACE_WINDOW;
+			opts->start = strtoul(&a[15], &ptr, 0);
+			if (*ptr == ':')
+				opts->stop = strtoul(ptr+1, &ptr, 0);
+			if ((*ptr)||(opts->stop <= opts->start)) {
+				fprintf(stderr, "ERR: Bad trace window, %s\n", a);
+				exit(EXIT_FAILURE);
+			}
+		} else if (strncmp(a, "--trace-ring=", 13)==0) {
+			opts->mode = TRACE_RING;
+			opts->ring = strtoul(&a[13], NULL, 0);
+			if (opts->ring < 1) {
+				fprintf(stderr, "ERR: Bad trace ring length, %s\n", a);
+				exit(EXIT_FAILURE);
+			}
+		}
+	}
+}
+
+//
+// Lockstep checking
+//
+//	--lockstep	Run the core's bit-accurate software model alongside the
+//			core, checking every output against it as soon as the
+//			output emerges, and stopping at the first mismatch.
+//
+// Only a pipeline's worth of inputs is ever held, so this costs nothing
+// like the O(N) storage a second, comparison, pass would.
+//
+static inline bool	tb_lockstep(int argc, char **argv) {
+	for(int k=1; k<argc; k++)
+		if (strcmp(argv[k], "--lockstep")==0)
+			return true;
+	return false;
+}
+
+//
+// VCDRING
+//
+// A trace "file" that lives in memory.  The trace is broken into segments,
+// each started with VerilatedVcdC::openNext() so that it begins with a full
+// dump of every signal.  Only the last two segments are kept.  Should save()
+// be called, the VCD header and those two segments are written to disk, and
+// anything traced afterwards goes straight to the file.
+//
+class	VCDRING : public VerilatedVcdFile {
+	std::string	m_name, m_head, m_prev, m_cur;
+	FILE		*m_fp;
+
+	// Separate the VCD header, written only once by VerilatedVcdC::open(),
+	// from the data that follows it.
+	void	split_header(void) {
+		size_t	pos;
+
+		if (!m_head.empty())
+			return;
+		pos = m_cur.find("$enddefinitions");
+		if (pos == std::string::npos)
+			return;
+		pos = m_cur.find('\n', pos);
+		if (pos == std::string::npos)
+			return;
+		m_head = m_cur.substr(0, pos+1);
+		m_cur.erase(0, pos+1);
+	}
+public:
+	VCDRING(void) : m_fp(NULL) {}
+	virtual ~VCDRING(void) {
+		if (m_fp)
+			fclose(m_fp);
+	}
+
+	virtual	bool	open(const std::string &name) {
+		m_name = name;
+		if (!m_fp) {
+			split_header();
+			m_prev.swap(m_cur);
+			m_cur.clear();
+		} return true;
+	}
+
+	virtual	void	close(void) {
+		if (m_fp)
+			fflush(m_fp);
+	}
+
+	virtual	ssize_t	write(const char *bufp, ssize_t len) {
+		if (m_fp)
+			return fwrite(bufp, 1, len, m_fp);
+		m_cur.append(bufp, len);
+		return len;
+	}
+
+	bool	saved(void) const { return m_fp != NULL; }
+
+	bool	save(void) {
+		if (m_fp)
+			return true;
+		split_header();
+		m_fp = fopen(m_name.c_str(), "w");
+		if (!m_fp) {
+			fprintf(stderr, "ERR: Could not save trace to %s\n",
+				m_name.c_str());
+			return false;
+		}
+		fwrite(m_head.data(), 1, m_head.size(), m_fp);
+		fwrite(m_prev.data(), 1, m_prev.size(), m_fp);
+		fwrite(m_cur.data(),  1, m_cur.size(),  m_fp);
+		fflush(m_fp);
+		m_head.clear(); m_prev.clear(); m_cur.clear();
+		return true;
+	}
+};
 
 template <class VA>	class TESTB {
 public:
 	VA		*m_core;
 	VerilatedVcdC*	m_trace;
+	VCDRING		*m_ring;
 	unsigned long	m_tickcount;
+	TRACE_MODE	m_trace_mode;
+	unsigned long	m_trace_start, m_trace_stop, m_trace_len, m_seg_start;
+	bool		m_lockstep;
+	// Profiling, given --profile (see profile.h).  m_lap is the time the
+	// last interval ended, m_lap_scoped the PROFILE_SCOPE time this
+	// thread had seen by then.
+	bool		m_profile;
+	PROFILE_COUNTS	m_prof;
+	uint64_t	m_lap, m_lap_scoped;
 
-	TESTB(void) : m_trace(NULL), m_tickcount(0l) {
+	TESTB(void) : m_trace(NULL), m_ring(NULL), m_tickcount(0l),
+			m_trace_mode(TRACE_OFF), m_lockstep(false),
+			m_profile(tbprofile.m_on), m_lap(0), m_lap_scoped(0) {
+		memset(&m_prof, 0, sizeof(m_prof));
+		if (m_profile) {
+			m_lap = profile_now();
+			m_lap_scoped = profile_scoped;
+		}
 		m_core = new VA;
 		Verilated::traceEverOn(true);
 		m_core->i_clk = 0;
 		eval(); // Get our initial values set properly.
 	}
 	virtual ~TESTB(void) {
+		if (m_profile)
+			tbprofile.add(m_prof);
 		closetrace();
 		delete m_core;
 		m_core = NULL;
@@ -65,43 +247,227 @@ public:
 
 	virtual	void	opentrace(const char *vcdname) {
 		if (!m_trace) {
-			m_trace = new VerilatedVcdC;
+			if (m_trace_mode == TRACE_OFF)
+				m_trace_mode = TRACE_FULL;
+			if (m_trace_mode == TRACE_RING) {
+				m_ring  = new VCDRING;
+				m_trace = new VerilatedVcdC(m_ring);
+			} else
+				m_trace = new VerilatedVcdC;
 			m_core->trace(m_trace, 99);
 			m_trace->open(vcdname);
+			m_seg_start = m_tickcount;
 		}
 	}
 
+	// Open a trace as directed by the command line options, if at all.
+	virtual	void	opentrace(const TRACEOPTS &opts, const char *vcdname) {
+		if (opts.mode == TRACE_OFF)
+			return;
+		m_trace_mode  = opts.mode;
+		m_trace_start = opts.start;
+		m_trace_stop  = opts.stop;
+		m_trace_len   = opts.ring;
+		opentrace((opts.fname) ? opts.fname : vcdname);
+	}
+
 	virtual	void	closetrace(void) {
 		if (m_trace) {
 			m_trace->close();
 			delete m_trace;
 			m_trace = NULL;
+			lap(PROF_TRACE);
 		}
+		if (m_ring) {
+			delete m_ring;
+			m_ring = NULL;
+		}
+	}
+
+	// Something has gone wrong.  Make sure whatever trace we have makes it
+	// to disk.  In ring mode, that means saving the ring and then tracing
+	// for another ring's length past the failure.
+	virtual	void	failtrace(void) {
+		if (!m_trace)
+			return;
+		if ((m_ring)&&(!m_ring->saved())) {
+			m_trace->flush();
+			if (m_ring->save()) {
+				m_trace_mode = TRACE_WINDOW;
+				m_trace_start= 0;
+				m_trace_stop = m_tickcount + m_trace_len;
+			}
+		} else
+			m_trace->flush();
+		lap(PROF_TRACE);
 	}
 
 	virtual	void	eval(void) {
 		m_core->eval();
 	}
 
+	// Charges the time since the last lap to phase
+	void	lap(PROFILE_PHASE phase) {
+		if (m_profile) {
+			uint64_t	t = profile_now();
+
+			m_prof.count[phase] += t - m_lap;
+			m_lap = t;
+		}
+	}
+
+	// Charges the time since the last tick to stimulus, less whatever
+	// this thread spent within a PROFILE_SCOPE in the meantime
+	void	lap_stimulus(void) {
+		if (m_profile) {
+			uint64_t	t = profile_now(), dt = t - m_lap,
+					sc = profile_scoped - m_lap_scoped;
+
+			m_prof.count[PROF_STIMULUS] += (dt > sc) ? dt - sc : 0;
+			m_lap = t;
+		}
+	}
+
+	// Ends a tick's profile, handing the counts on every so often
+	void	lap_tick(void) {
+		if (m_profile) {
+			m_lap_scoped = profile_scoped;
+			if (++m_prof.ticks >= PROFILE_FLUSH) {
+				tbprofile.add(m_prof);
+				memset(&m_prof, 0, sizeof(m_prof));
+			}
+		}
+	}
+
+	// Lockstep checking, for those test benches with a software model to
+	// check against.  lockstep_in() is called just before every rising
+	// edge of the clock, to note whatever input the core is about to
+	// accept.  lockstep_out() is called just after, to check whatever the
+	// core has just produced against the model.  It returns the number of
+	// outputs checked, or -1 (having described the input, and both the
+	// core's and the model's outputs, in msg) on a mismatch.
+	virtual	void	lockstep(bool on) { m_lockstep = on; }
+	virtual	void	lockstep_in(void) {}
+	virtual	int	lockstep_out(char *msg, size_t len) {
+		(void)msg; (void)len;
+		return 0;
+	}
+
+	// Something the core produced didn't match its model.  Save what
+	// trace there is, and stop.
+	virtual	void	lockstep_fail(const char *msg) {
+		printf("LOCKSTEP MISMATCH on clock %lu: %s\n", m_tickcount, msg);
+		failtrace();
+		closetrace();
+		printf("TEST FAILURE\n");
+		exit(EXIT_FAILURE);
+	}
+
 	virtual	void	tick(void) {
+		bool	dump = false;
+
+		lap_stimulus();
 		m_tickcount++;
 
+		if (m_trace) {
+			if (m_trace_mode == TRACE_WINDOW) {
+				if (m_tickcount >= m_trace_stop) {
+					closetrace();
+				} else
+					dump = (m_tickcount >= m_trace_start);
+			} else if (m_trace_mode == TRACE_RING) {
+				// Start a new segment, dropping the oldest
+				if (m_tickcount - m_seg_start >= m_trace_len) {
+					m_trace->openNext(false);
+					m_seg_start = m_tickcount;
+					lap(PROF_TRACE);
+				}
+				dump = true;
+			} else
+				dump = true;
+		}
+
 		// Make sure we have our evaluations straight before the top
 		// of the clock.  This is necessary since some of the 
 		// connection modules may have made changes, for which some
 		// logic depends.  This forces that logic to be recalculated
 		// before the top of the clock.
 		eval();
-		if (m_trace) m_trace->dump(10*m_tickcount-2);
+		lap(PROF_EVAL);
+		if (dump) { m_trace->dump(10*m_tickcount-2); lap(PROF_TRACE); }
+		if (m_lockstep) {
+			lockstep_in();
+			lap(PROF_LOCKSTEP);
+		}
 		m_core->i_clk = 1;
 		eval();
-		if (m_trace) m_trace->dump(10*m_tickcount);
+		lap(PROF_EVAL);
+		if (dump) { m_trace->dump(10*m_tickcount); lap(PROF_TRACE); }
 		m_core->i_clk = 0;
 		eval();
-		if (m_trace) {
-			m_trace->dump(10*m_tickcount+5);
-			m_trace->flush();
+		lap(PROF_EVAL);
+		if (dump) { m_trace->dump(10*m_tickcount+5); lap(PROF_TRACE); }
+
+		if (m_lockstep) {
+			char	msg[LOCKSTEP_MSGLEN];
+
+			if (lockstep_out(msg, sizeof(msg)) < 0)
+				lockstep_fail(msg);
+			lap(PROF_LOCKSTEP);
 		}
+		lap_tick();
+	}
+
+	//
+	// tick_fast
+	//
+	// Runs n clocks in one call, for the purely synchronous cores, taking
+	// the inputs for each from stim.fast_in(k) and handing the outputs
+	// to stim.fast_out(k), for k = 0 ... n-1.  fast_in() is called with
+	// the clock low, just as before a tick(), and fast_out() just after
+	// the rising edge--where nothing but the clock has changed since
+	// tick() would have left the outputs.
+	//
+	// With no trace open, and no lockstep check to make, only two evals
+	// are needed per clock rather than tick()'s three: the first both
+	// settles the new inputs and lets Verilator see the clock low, the
+	// second takes the rising edge.  The falling edge is left for the
+	// next clock's first eval(), where it changes nothing.  Otherwise,
+	// this falls back on tick(), so that the trace and checks are just
+	// as they would be.
+	//
+	template <class STIM>	void	tick_fast(unsigned long n, STIM &stim) {
+		if ((m_trace)||(m_lockstep)) {
+			for(unsigned long k=0; k<n; k++) {
+				stim.fast_in(k);
+				tick();
+				stim.fast_out(k);
+			} return;
+		}
+
+		if (m_profile) {
+			for(unsigned long k=0; k<n; k++) {
+				stim.fast_in(k);
+				lap_stimulus();
+				m_core->eval();
+				m_core->i_clk = 1;
+				m_core->eval();
+				m_core->i_clk = 0;
+				m_tickcount++;
+				lap(PROF_EVAL);
+				lap_tick();
+				stim.fast_out(k);
+			} return;
+		}
+
+		for(unsigned long k=0; k<n; k++) {
+			stim.fast_in(k);
+			m_core->eval();
+			m_core->i_clk = 1;
+			m_core->eval();
+			m_core->i_clk = 0;
+			stim.fast_out(k);
+		} m_tickcount += n;
 	}
 
 	virtual	void	reset(void) {
@@ -7,6 +7,30 @@
 // Purpose:	A quick test bench to determine if the rectangular to polar
 //		cordic module works.
 //
+//	Given -j <n> (or TB_THREADS=<n>), the phase sweep is split across n
+//	independent copies of the core, each on its own thread.
+//
+//	Tracing is off unless --trace, --trace-window=<start>:<stop>, or
+//	--trace-ring=<cycles> is given.  See testb.h for details.
+//
+//	Given --search[=<probes>], rather than sweeping every angle, the test
+//	bench hunts for the worst case phase and magnitude errors instead (see
+//	errsearch.h).
+//
+//	Given --lockstep, every output of either is also checked, bit for bit,
+//	against the core's software model as it emerges, and the test stops
+//	at the first mismatch.
+//
+//	Given --dump[=<file>], every input of the sweep, the output it
+//	produced, and the output it should have produced are written to
+//	<core>_tb.dump (or <file>), in the format described in resdump.h.
+//
+//	Given --profile[=<file>], the time of the run is split between
+//	Verilator's eval(), tracing, lockstep checks, stimulus, the FFTs, and
+//	the closing statistics, with a progress line every second and a JSON
+//	summary written on exit to <core>_tb.profile.json (or <file>).  See
+//	profile.h.
+//
 // Creator:	Dan Gisselquist, Ph.D.
 //		Gisselquist Technology, LLC
 //
@@ -40,20 +64,85 @@
 
 #include <verilated.h>
 #include <verilated_vcd_c.h>
-#ifdef	CLOCKS_PER_OUTPUT
+#if	defined(CLOCKS_PER_OUTPUT) && defined(ITERATIVE)
+# include "Viterpolar.h"
+# include "iterpolar.h"
+# include "iterpolar_model.h"
+# define MODEL_R2P iterpolar_r2p
+# define BASECLASS Viterpolar
+# define CORENAME "iterpolar"
+# define VCDNAME "iterpolar_tb.vcd"
+#elif	defined(CLOCKS_PER_OUTPUT) && defined(ENGINES)
+# include "Vmultipolar.h"
+# include "multipolar.h"
+# include "multipolar_model.h"
+# define MODEL_R2P multipolar_r2p
+# define BASECLASS Vmultipolar
+# define CORENAME "multipolar"
+# define VCDNAME "multipolar_tb.vcd"
+#elif	defined(CLOCKS_PER_OUTPUT)
 # include "Vseqpolar.h"
 # include "seqpolar.h"
+# include "seqpolar_model.h"
+# define MODEL_R2P seqpolar_r2p
 # define BASECLASS Vseqpolar
+# define CORENAME "seqpolar"
+# define VCDNAME "seqpolar_tb.vcd"
+#elif	defined(PAIRED)
+# include "Vpairpolar.h"
+# include "pairpolar.h"
+# include "pairpolar_model.h"
+# define MODEL_R2P pairpolar_r2p
+# define BASECLASS Vpairpolar
+# define CORENAME "pairpolar"
+# define VCDNAME "pairpolar_tb.vcd"
+#elif	defined(RADIX4)
+# include "Vradix4polar.h"
+# include "radix4polar.h"
+# include "radix4polar_model.h"
+# define MODEL_R2P radix4polar_r2p
+# define BASECLASS Vradix4polar
+# define CORENAME "radix4polar"
+# define VCDNAME "radix4polar_tb.vcd"
 #else
 # include "Vtopolar.h"
 # include "topolar.h"
+# include "topolar_model.h"
+# define MODEL_R2P topolar_r2p
 # define BASECLASS Vtopolar
+# define CORENAME "topolar"
+# define VCDNAME "topolar_tb.vcd"
 #endif
 #include "testb.h"
+#include "shard.h"
+#include "errstats.h"
+#include "errsearch.h"
+#include "resdump.h"
+
+//
+// LOCKSTEP_IN
+//
+// An input the core has accepted, kept until its output can be checked
+// against the software model.
+typedef	struct	{
+	unsigned long	clock;
+	int32_t		xval, yval;
+} LOCKSTEP_IN;
+
+//
+// TOPOLAR_OUT
+//
+// A result, as the core produced it.
+typedef	struct	{
+	uint32_t	mag, phase;
+} TOPOLAR_OUT;
 
 class	TOPOLAR_TB : public TESTB<BASECLASS> {
 	bool		m_debug;
+	SAMPLE_FIFO<LOCKSTEP_IN>	m_lsfifo;
 public:
+	// Every result the core has produced, in order, until it is read
+	SAMPLE_FIFO<TOPOLAR_OUT>	m_outq;
 
 	TOPOLAR_TB(void) {
 		m_debug = true;
@@ -74,183 +163,470 @@ public:
 		m_core->i_aux   = 0;
 		tick();
 	}
-};
-
-const int	LGNSAMPLES=PW;
-const int	NSAMPLES=(1<<LGNSAMPLES);
 
-int main(int  argc, char **argv) {
-	Verilated::commandArgs(argc, argv);
-	TOPOLAR_TB	*tb = new TOPOLAR_TB;
-	int	*ipdata, *ixval,  *iyval,
-		*imag,   *ophase, *omag,
-		idx, shift, pshift;
-	double	*dpdata, sum_perr = 0.0;
+	// Keeps the core's result, should it have just produced one
+	void	collect(void) {
+		TOPOLAR_OUT	out;
 
-	const	double	MAXPHASE = pow(2.0,PW);
-	const	double	RAD_TO_PHASE = MAXPHASE / M_PI / 2.0;
+#ifdef	CLOCKS_PER_OUTPUT
+		if (!m_core->o_done)
+			return;
+#endif
+		if (!m_core->o_aux)
+			return;
+		out.mag   = m_core->o_mag;
+		out.phase = m_core->o_phase;
+		m_outq.push(out);
+	}
 
-	ipdata = new int[NSAMPLES];
-	ixval  = new int[NSAMPLES];
-	iyval  = new int[NSAMPLES];
-	imag   = new int[NSAMPLES];
-	omag   = new int[NSAMPLES];
-	ophase = new int[NSAMPLES];
-	dpdata = new double[NSAMPLES];
+	void	lockstep_in(void) {
+		LOCKSTEP_IN	in;
 
 #ifdef	CLOCKS_PER_OUTPUT
-	tb->opentrace("seqpolar_tb.vcd");
+		if ((!m_core->i_stb)||(m_core->o_busy)||(!m_core->i_aux))
+			return;
 #else
-	tb->opentrace("topolar_tb.vcd");
+		if ((!m_core->i_ce)||(!m_core->i_aux))
+			return;
 #endif
+		in.clock = m_tickcount;
+		in.xval  = m_core->i_xval;
+		in.yval  = m_core->i_yval;
+		m_lsfifo.push(in);
+	}
 
-	tb->reset();
-
-	shift  = (8*sizeof(long)-OW);
-	pshift = (8*sizeof(long)-PW);
-	idx = 0;
-	for(int i=0; i<NSAMPLES; i++) {
-		double	ph, cs, sn, mg;
-		long	lv;
-
-		lv = (((long)i) << (PW-(LGNSAMPLES-1)));
-		ipdata[i] = (int)lv;
-		ph = ipdata[i] * M_PI / (1ul << (PW-1));
-		mg = ((1l<<(IW-1))-1);
-		cs = mg * cos(ph);
-		sn = mg * sin(ph);
-
-		ixval[i] = (int)cs;
-		iyval[i] = (int)sn;
-		imag[i]  = (int)mg;
-		dpdata[i] = atan2(iyval[i], ixval[i]);
-		// dpdata[i] = ph;
-		tb->m_core->i_xval  = ixval[i];
-		tb->m_core->i_yval  = iyval[i];
-		tb->m_core->i_aux   = 1;
+	int	lockstep_out(char *msg, size_t len) {
+		const uint32_t	omsk = (OW >= 32) ? 0xffffffffu : ((1u<<OW)-1),
+				pmsk = (PW >= 32) ? 0xffffffffu : ((1u<<PW)-1);
+		int32_t		mmag;
+		uint32_t	mphase;
 
 #ifdef	CLOCKS_PER_OUTPUT
-		tb->m_core->i_stb = 1;
-		for(int j=0; j<CLOCKS_PER_OUTPUT-1; j++) {
-			tb->tick();
-			tb->m_core->i_stb = 0;
-			assert(!tb->m_core->o_done);
-			assert( tb->m_core->o_busy);
-		}
-
-		tb->tick();
-		assert(!tb->m_core->o_busy);
-		assert(tb->m_core->o_done);
-		assert(tb->m_core->o_aux);
-#else
-		tb->tick();
+		if (!m_core->o_done)
+			return 0;
 #endif
-
-		if (tb->m_core->o_aux) {
-			long	lv;
-			lv = (long)tb->m_core->o_mag;
-			lv <<= shift;
-			lv >>= shift;
-			omag[idx]   = (int)lv;
-
-			lv = tb->m_core->o_phase;
-			lv <<= pshift;
-			lv >>= pshift;
-			ophase[idx] = (int)lv;
-			//printf("%08x %08x -> %08x %08x\n",
-			//	ixval[idx], iyval[idx],
-			//	omag[idx], ophase[idx]);
-			idx++;
+		if (!m_core->o_aux)
+			return 0;
+		if (m_lsfifo.empty()) {
+			snprintf(msg, len, "an output, with no input to match it");
+			return -1;
 		}
+
+		const LOCKSTEP_IN	&in = m_lsfifo.pop();
+
+		MODEL_R2P(in.xval, in.yval, &mmag, &mphase);
+		if (((((uint32_t)m_core->o_mag ^ (uint32_t)mmag) & omsk) == 0)
+			&&((((uint32_t)m_core->o_phase ^ mphase) & pmsk) == 0))
+			return 1;
+
+		snprintf(msg, len, "(0x%x, 0x%x), given on clock %lu, became "
+			"0x%x at phase 0x%x, not 0x%x at phase 0x%x",
+			(uint32_t)in.xval & ((1u<<IW)-1),
+			(uint32_t)in.yval & ((1u<<IW)-1), in.clock,
+			(uint32_t)m_core->o_mag & omsk,
+			(uint32_t)m_core->o_phase & pmsk,
+			(uint32_t)mmag & omsk, mphase & pmsk);
+		return -1;
 	}
+};
 
-#ifndef	CLOCKS_PER_OUTPUT
-	tb->m_core->i_aux = 0;
-	while(tb->m_core->o_aux) {
-		tb->m_core->i_aux   = 0;
-		tb->tick();
+const int	LGNSAMPLES=PW;
+const long	NSAMPLES=(1l<<LGNSAMPLES);
 
-		if (tb->m_core->o_aux) {
-			long	lv;
-			lv = (long)tb->m_core->o_mag;
-			lv <<= shift;
-			lv >>= shift;
-			omag[idx]   = (int)lv;
-
-			lv = tb->m_core->o_phase;
-			lv <<= pshift;
-			lv >>= pshift;
-			ophase[idx] = (int)lv;
-			//printf("%08x %08x -> %08x %08x\n",
-			//	ixval[idx], iyval[idx],
-			//	omag[idx], ophase[idx]);
-			idx++;
-		}
-	}
+// The clocks each sample takes, for the --profile ETA
+#if	defined(CLOCKS_PER_OUTPUT) && defined(NENGINES)
+const long	TICKS_PER_SAMPLE=(CLOCKS_PER_OUTPUT+NENGINES-1)/NENGINES;
+#elif	defined(CLOCKS_PER_OUTPUT)
+const long	TICKS_PER_SAMPLE=CLOCKS_PER_OUTPUT;
+#else
+const long	TICKS_PER_SAMPLE=1;
 #endif
 
-	double	mxperr = 0.0, mxverr = 0.0;
-	for(int i=0; i<NSAMPLES; i++) {
-		double	mgerr, epdata, dperr, emag;
+//
+// TOPOLAR_IN
+//
+// What went into the core, kept only until the result comes back out.
+typedef	struct	{
+	int	ixval, iyval;
+	int	imag;
+	double	dphase;	// The true phase of the (quantized) input
+} TOPOLAR_IN;
 
-		epdata = dpdata[i] * RAD_TO_PHASE;
+//
+// TOPOLAR_STATS
+//
+// Running phase and magnitude error statistics.  Each shard keeps its own,
+// and they are merged at the end.
+class	TOPOLAR_STATS {
+public:
+	ERRSTAT	perr, verr;
+
+	// Returns the expected magnitude, in output units, and the expected
+	// phase, in PW-bit phase units, for input in
+	static void	predict(const TOPOLAR_IN &in, double &emag,
+			double &epdata) {
+		const	double	MAXPHASE = pow(2.0,PW);
+		const	double	RAD_TO_PHASE = MAXPHASE / M_PI / 2.0;
+
+		epdata = in.dphase * RAD_TO_PHASE;
 		if (epdata < 0.0)
 			epdata += MAXPHASE;
-		dperr = ophase[i] - epdata;
-		while (dperr > MAXPHASE/2.)
-			dperr -= MAXPHASE;
-		while (dperr < -MAXPHASE/2.)
-			dperr += MAXPHASE;
-		if (fabs(dperr) > mxperr)
-			mxperr = fabs(dperr);
-		sum_perr += dperr * dperr;
 
-		emag = imag[i] * GAIN;// * sqrt(2);
+		emag = in.imag * GAIN;// * sqrt(2);
 		if (IW+1 > OW)
 			emag = emag / pow(2.,(IW-1-OW))/4/sqrt(2);
 		else if (OW > IW+1)
 			emag = emag * pow(2.,(IW-1-OW));
+	}
+
+	// Returns the larger of this sample's phase and magnitude errors, each
+	// relative to its bound, so that anything over 1.0 is out of bounds
+	double	add(const TOPOLAR_IN &in, int omag, int ophase) {
+		const	double	MAXPHASE = pow(2.0,PW);
+		const	double	RAD_TO_PHASE = MAXPHASE / M_PI / 2.0;
+		double	mgerr, epdata, dperr, emag, mxperr;
+
+		predict(in, emag, epdata);
+		dperr = ophase - epdata;
+		while (dperr > MAXPHASE/2.)
+			dperr -= MAXPHASE;
+		while (dperr < -MAXPHASE/2.)
+			dperr += MAXPHASE;
+		perr.add(dperr);
 
 		// omag should equal imag * GAIN
-		mgerr = fabs(omag[i] - emag);
-		if (mgerr > mxverr)
-			mxverr = mgerr;
-
-		if (epdata > MAXPHASE/2)
-			epdata -= MAXPHASE;
-		//printf("%08x %08x -> %6d %08x/%12d [%9.6f %12.1f],[%9.6f %13.1f]\n",
-		//	ixval[i], iyval[i],
-		//	omag[i], ophase[i],ophase[i],
+		mgerr = fabs(omag - emag);
+		verr.add(mgerr);
+
+		//printf("%6d %08x/%12d [%9.6f %12.1f],[%9.6f %13.1f]\n",
+		//	omag, ophase, ophase,
 		//	emag, epdata,
 		//	mgerr, dperr);
+
+		mxperr = sqrt(PHASE_VARIANCE_RAD) * RAD_TO_PHASE;
+		if (mxperr < 1.0)
+			mxperr = 1.0;
+		dperr = fabs(dperr) / (3.4 * mxperr);
+		mgerr = mgerr / (2.0 * sqrt(QUANTIZATION_VARIANCE));
+		return (dperr > mgerr) ? dperr : mgerr;
+	}
+
+	void	merge(const TOPOLAR_STATS &s) {
+		perr.merge(s.perr);
+		verr.merge(s.verr);
+	}
+};
+
+static	TOPOLAR_STATS	stats[MAX_SHARDS];
+static	TRACEOPTS	traceopts;
+static	bool		lockstep;
+// The results of the sweep, should --dump ask for them
+static	RESDUMP		dump;
+static	int		dcol_ixval, dcol_iyval, dcol_omag, dcol_ophase,
+			dcol_mref, dcol_pref;
+
+//
+// input
+//
+// Places a full scale input, at an angle of ipdata (PW-bit phase units),
+// into the core, returning what the core was given.
+static TOPOLAR_IN	input(TOPOLAR_TB *tb, long ipdata) {
+	TOPOLAR_IN	in;
+	double	ph, cs, sn, mg;
+	int	ixval, iyval;
+
+	ph = (int)ipdata * M_PI / (1ul << (PW-1));
+	mg = ((1l<<(IW-1))-1);
+	cs = mg * cos(ph);
+	sn = mg * sin(ph);
+
+	ixval = (int)cs;
+	iyval = (int)sn;
+	in.ixval  = ixval;
+	in.iyval  = iyval;
+	in.imag   = (int)mg;
+	in.dphase = atan2(iyval, ixval);
+	// in.dphase = ph;
+	tb->m_core->i_xval  = ixval;
+	tb->m_core->i_yval  = iyval;
+	return in;
+}
+
+//
+// step
+//
+// Clocks one sample into the core, and (eventually) one result out, onto
+// tb->m_outq.
+static void	step(TOPOLAR_TB *tb) {
+#if	defined(CLOCKS_PER_OUTPUT) && defined(NENGINES)
+	// Hold the sample until an engine is free to take it.  Any of the
+	// others may finish in the meantime.
+	bool	accepted;
+
+	tb->m_core->i_stb = 1;
+	do {
+		accepted = !tb->m_core->o_busy;
+		tb->tick();
+		tb->collect();
+	} while(!accepted);
+	tb->m_core->i_stb = 0;
+#elif	defined(CLOCKS_PER_OUTPUT)
+	tb->m_core->i_stb = 1;
+	for(int j=0; j<CLOCKS_PER_OUTPUT-1; j++) {
+		tb->tick();
+		tb->m_core->i_stb = 0;
+		TBASSERT(*tb, !tb->m_core->o_done);
+		TBASSERT(*tb,  tb->m_core->o_busy);
 	}
 
-	if(false) {
-		FILE	*dbgfp;
-		dbgfp = fopen("topolar.32t", "w");
-		assert(dbgfp);
-
-		for(int k=0; k<NSAMPLES; k++) {
-			int	ovals[5];
-			double	epdata, dperr;
-			ovals[0] = ixval[k];
-			ovals[1] = iyval[k];
-			ovals[2] = omag[k];
-			ovals[3] = ophase[k];
-
-			epdata = dpdata[k] * RAD_TO_PHASE;
-			dperr = ophase[k] - epdata;
-			while (dperr > MAXPHASE/2.)
-				dperr -= MAXPHASE;
-			while (dperr < -MAXPHASE/2.)
-				dperr += MAXPHASE;
-			ovals[4] = (int)dperr;
-			fwrite(ovals, sizeof(ovals[0]), sizeof(ovals)/sizeof(ovals[0]), dbgfp);
+	tb->tick();
+	TBASSERT(*tb, !tb->m_core->o_busy);
+	TBASSERT(*tb, tb->m_core->o_done);
+	TBASSERT(*tb, tb->m_core->o_aux);
+	tb->collect();
+#else
+	tb->tick();
+	tb->collect();
+#endif
+}
+
+//
+// result
+//
+// Reads the (sign extended) magnitude and phase from the core's output, out.
+static void	result(const TOPOLAR_OUT &out, int &omag, int &ophase) {
+	const int	shift  = (8*sizeof(long)-OW),
+			pshift = (8*sizeof(long)-PW);
+	long	lv;
+
+	lv = (long)out.mag;
+	lv <<= shift;
+	lv >>= shift;
+	omag   = (int)lv;
+
+	lv = out.phase;
+	lv <<= pshift;
+	lv >>= pshift;
+	ophase = (int)lv;
+}
+
+//
+// sweep
+//
+// Runs the samples [lo,hi) through a freshly built and reset core,
+// accumulating the error statistics of each sample as it emerges.
+static void	sweep(int shard, long lo, long hi, void *arg) {
+	TOPOLAR_TB	*tb = new TOPOLAR_TB;
+	SAMPLE_FIFO<TOPOLAR_IN>	fifo;
+	TOPOLAR_STATS	*st = &stats[shard];
+	RESDUMP_SHARD	ds(&dump, lo);
+	long		nout;
+
+	// Only the first shard gets a trace--unless we are keeping a trace
+	// ring, in which case every shard keeps its own.
+	if (shard == 0)
+		tb->opentrace(traceopts, VCDNAME);
+	else if (traceopts.mode == TRACE_RING) {
+		char	fname[64];
+
+		sprintf(fname, "%.*s-%d.vcd", (int)strlen(VCDNAME)-4,
+			VCDNAME, shard);
+		tb->opentrace(traceopts, fname);
+	}
+
+	tb->reset();
+	tb->lockstep(lockstep);
+
+	nout = 0;
+	for(long i=lo; i<hi || !fifo.empty(); i++) {
+		if (i < hi) {
+			fifo.push(input(tb, ((long)i) << (PW-(LGNSAMPLES-1))));
+			tb->m_core->i_aux   = 1;
+		} else
+			tb->m_core->i_aux   = 0;
+
+		step(tb);
+
+		while(!tb->m_outq.empty()) {
+			const TOPOLAR_OUT	&out = tb->m_outq.pop();
+			int	omag, ophase;
+
+			result(out, omag, ophase);
+
+			TBASSERT(*tb, !fifo.empty());
+			const TOPOLAR_IN	&res = fifo.pop();
+
+			// When keeping a trace ring, save it as soon as any
+			// one sample exceeds either the phase or the
+			// magnitude error threshold.
+			if ((st->add(res, omag, ophase) > 1.0)
+					&&(traceopts.mode == TRACE_RING))
+				tb->failtrace();
+
+			if (ds.active()) {
+				double	emag, epdata;
+
+				// The phase is dumped unsigned, as is its
+				// reference
+				TOPOLAR_STATS::predict(res, emag, epdata);
+				ds.i32(dcol_ixval,  res.ixval);
+				ds.i32(dcol_iyval,  res.iyval);
+				ds.i32(dcol_omag,   omag);
+				ds.i32(dcol_ophase, out.phase);
+				ds.f64(dcol_mref,   emag);
+				ds.f64(dcol_pref,   epdata);
+				ds.next();
+			}
+			nout++;
 		}
+	}
+	TBASSERT(*tb, nout == hi-lo);
+	ds.flush();
 
-		fclose(dbgfp);
+	delete tb;
+}
+
+//
+// TOPOLAR_SEARCH
+//
+// The core, and the running statistics, shared by every probe of a search.
+typedef	struct	{
+	TOPOLAR_TB	*tb;
+	TOPOLAR_STATS	st;
+} TOPOLAR_SEARCH;
+
+//
+// probe
+//
+// Runs a full scale input at each of n angles through the core, returning
+// the error of each result relative to its bound.
+static void	probe(const long *pts, int n, double *err, void *arg) {
+	TOPOLAR_SEARCH	*s = (TOPOLAR_SEARCH *)arg;
+	TOPOLAR_TB	*tb = s->tb;
+	SAMPLE_FIFO<TOPOLAR_IN>	fifo;
+	SAMPLE_FIFO<int>	idx;
+	int		nout = 0;
+
+	for(int i=0; i<n || !fifo.empty(); i++) {
+		if (i < n) {
+			fifo.push(input(tb, pts[i]));
+			idx.push(i);
+			tb->m_core->i_aux   = 1;
+		} else
+			tb->m_core->i_aux   = 0;
+
+		step(tb);
+
+		while(!tb->m_outq.empty()) {
+			const TOPOLAR_OUT	&out = tb->m_outq.pop();
+			int	omag, ophase, k;
+
+			result(out, omag, ophase);
+
+			TBASSERT(*tb, !fifo.empty());
+			k = idx.pop();
+			err[k] = s->st.add(fifo.pop(), omag, ophase);
+			if ((err[k] > 1.0)&&(traceopts.mode == TRACE_RING))
+				tb->failtrace();
+			nout++;
+		}
 	}
+	TBASSERT(*tb, nout == n);
+}
+
+//
+// search
+//
+// Rather than sweeping every angle, hunts for the worst one with an
+// ERRSEARCH of budget probes, checking the largest phase and magnitude
+// errors found.
+static int	search(long budget) {
+	TOPOLAR_SEARCH	s;
+	const long	space = 1l<<PW;
+	long		cell, qcell;
+
+	s.tb = new TOPOLAR_TB;
+	s.tb->opentrace(traceopts, VCDNAME);
+	s.tb->reset();
+	s.tb->lockstep(lockstep);
+
+	// The phase error changes on the scale of the last (smallest)
+	// rotation, and the inputs themselves only change once the angle has
+	// moved far enough to change x or y by one.  Start climbing at
+	// whichever is coarser.
+	cell  = (long)(atan2(1., pow(2., NSTAGES)) * space / (2.0 * M_PI));
+	qcell = (long)(space / (2.0 * M_PI * ((1l<<(IW-1))-1)));
+	if (qcell > cell)
+		cell = qcell;
+
+	ERRSEARCH	es(space, cell, probe, &s);
+
+	// The first stage rotates by an odd multiple of 45 degrees, chosen
+	// by the quadrant.  On the axes, where that choice changes, the
+	// remaining stages are left with the full 45 degrees to work off.
+	for(int k=0; k<4; k++)
+		es.hotspot(k * (space >> 2), 2);
+	es.search(budget);
+	es.report(stdout);
+	if (lockstep)
+		printf("LOCKSTEP: All %lu outputs matched the model\n",
+			es.m_nprobes);
+	delete s.tb;
+
+	printf("Max phase     error: %.2f (%.6f Rel)\n", s.st.perr.max(),
+		s.st.perr.max() / (2.0 * (1ul<<(PW-1))));
+	printf("Max magnitude error: %9.6f, expect %.2f\n", s.st.verr.max(),
+		sqrt(QUANTIZATION_VARIANCE));
+
+	if (es.m_max > 1.0) {
+		printf("TEST FAILED!!\n");
+		return EXIT_FAILURE;
+	}
+
+	printf("SUCCESS\n");
+	return EXIT_SUCCESS;
+}
+
+int main(int  argc, char **argv) {
+	Verilated::commandArgs(argc, argv);
+	double	sum_perr;
+	long	budget;
+
+	const	double	MAXPHASE = pow(2.0,PW);
+	const	double	RAD_TO_PHASE = MAXPHASE / M_PI / 2.0;
+
+	tb_traceopts(&traceopts, argc, argv);
+
+	budget = tb_search(argc, argv);
+	lockstep = tb_lockstep(argc, argv);
+	tb_profile(argc, argv, CORENAME "_tb");
+	tbprofile.expect(((budget > 0) ? budget : NSAMPLES) * TICKS_PER_SAMPLE);
+	if (budget > 0)
+		exit(search(budget));
+
+	if (const char *fname = tb_dump(argc, argv, CORENAME "_tb.dump")) {
+		if (!dump.open(fname, CORENAME, IW, OW, PW, GAIN, NSAMPLES))
+			exit(EXIT_FAILURE);
+		dcol_ixval  = dump.column("i_xval",  RESDUMP_I32);
+		dcol_iyval  = dump.column("i_yval",  RESDUMP_I32);
+		dcol_omag   = dump.column("o_mag",   RESDUMP_I32);
+		dcol_ophase = dump.column("o_phase", RESDUMP_I32);
+		dcol_mref   = dump.column("mag",     RESDUMP_F64);
+		dcol_pref   = dump.column("phase",   RESDUMP_F64);
+	}
+
+	run_shards(tb_nshards(argc, argv), NSAMPLES, sweep, NULL);
+	tbprofile.enter(PROF_STATS);
+	dump.close();
+	if (lockstep)
+		printf("LOCKSTEP: All %ld outputs matched the model\n", NSAMPLES);
+
+	for(int k=1; k<MAX_SHARDS; k++)
+		stats[0].merge(stats[k]);
+
+	double	mxperr = stats[0].perr.max(), mxverr = stats[0].verr.max();
 
+	sum_perr = stats[0].perr.m_sumsq;
 	sum_perr /= NSAMPLES;
 
 	bool	failed_test = false;
@@ -281,7 +657,7 @@ int main(int  argc, char **argv) {
 		failed_test = true;
 
 	printf("Max phase     error: %.2f (%.6f Rel)\n", mxperr,
-		mxperr / (2.0 * (1<<(PW-1))));
+		mxperr / (2.0 * (1ul<<(PW-1))));
 	printf("Max magnitude error: %9.6f, expect %.2f\n", mxverr,
 		sqrt(QUANTIZATION_VARIANCE));
 	printf("Avg phase err:       %9.6f, expect %.2f\n", sqrt(sum_perr),
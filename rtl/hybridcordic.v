@@ -0,0 +1,266 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename: 	../rtl/hybridcordic.v
+//
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	This file executes a vector rotation on the values
+//		(i_xval, i_yval).  This vector is rotated left by
+//	i_phase.  The top LGTBL bits of i_phase look up a coarse rotation
+//	in a table of sines and cosines, applied with a complex multiply,
+//	and the CORDIC then only needs to apply the fine stages.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2017-2018, Gisselquist Technology, LLC
+//
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+//
+// License:	GPL, v3, as defined and found on www.gnu.org,
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+//
+`default_nettype	none
+//
+module	hybridcordic(i_clk, i_reset, i_ce, i_xval, i_yval, i_phase, i_aux,
+		o_xval, o_yval, o_aux);
+	localparam	IW=12,	// The number of bits in our inputs
+			OW=12,	// The number of output bits to produce
+			NSTAGES= 7,	// CORDIC stages following the table
+			FIRST= 8,	// Stages replaced by the table
+			LGTBL=10,	// Log_2 of the number of table entries
+			TW=15,	// Bits in each table entry
+			XTRA= 3,// Extra bits for internal precision
+			WW=15,	// Our working bit-width
+			PW=19;	// Bits in our phase variables
+	input	wire				i_clk, i_reset, i_ce;
+	input	wire	signed	[(IW-1):0]		i_xval, i_yval;
+	input	wire		[(PW-1):0]			i_phase;
+	output	reg	signed	[(OW-1):0]	o_xval, o_yval;
+	input	wire				i_aux;
+	output	reg				o_aux;
+	// First step: expand our input to our working width.
+	// This is going to involve extending our input by one
+	// (or more) bits in addition to adding any xtra bits on
+	// bits on the right.  The one bit extra on the left is to
+	// allow for any accumulation due to the cordic gain
+	// within the algorithm.
+	// 
+	wire	signed [(WW-1):0]	e_xval, e_yval;
+	assign	e_xval = { {i_xval[(IW-1)]}, i_xval, {(WW-IW-1){1'b0}} };
+	assign	e_yval = { {i_yval[(IW-1)]}, i_yval, {(WW-IW-1){1'b0}} };
+
+	// Declare variables for all of the separate stages
+	reg	signed	[(WW-1):0]	xv	[0:(NSTAGES)];
+	reg	signed	[(WW-1):0]	yv	[0:(NSTAGES)];
+	reg		[(PW-1):0]	ph	[0:(NSTAGES)];
+
+	//
+	// Handle the auxilliary logic.
+	//
+	// The auxilliary bit is designed so that you can place a valid bit into
+	// the CORDIC function, and see when it comes out.  While the bit is
+	// allowed to be anything, the requirement of this bit is that it *must*
+	// be aligned with the output when done.  That is, if i_xval and i_yval
+	// are input together with i_aux, then when o_xval and o_yval are set
+	// to this value, o_aux *must* contain the value that was in i_aux.
+	//
+	reg		[(NSTAGES+2):0]	ax;
+
+	always @(posedge i_clk)
+	if (i_reset)
+		ax <= {(NSTAGES+3){1'b0}};
+	else if (i_ce)
+		ax <= { ax[(NSTAGES+1):0], i_aux };
+
+	//
+	// The coarse rotation.  Entry k of the table holds the
+	// cosine and sine of (k+1/2)*2pi/2^LGTBL, scaled by 2^(TW-1).
+	//
+	reg	[(TW-1):0]	ctbl [0:((1<<LGTBL)-1)];
+	reg	[(TW-1):0]	stbl [0:((1<<LGTBL)-1)];
+
+	initial begin
+		$readmemh("hybridcordic_ctbl.hex", ctbl);
+		$readmemh("hybridcordic_stbl.hex", stbl);
+	end
+
+	reg	signed	[(TW-1):0]	cv, sv;
+	reg	signed	[(WW-1):0]	tx, ty;
+	reg		[(PW-1):0]	tph, mph;
+	reg	signed	[(WW+TW-1):0]	pxc, pys, pxs, pyc;
+
+	// Clock one: Look up the coarse rotation.  What remains of the
+	// phase is its (signed) offset from the center of the table
+	// entry's segment.
+	always @(posedge i_clk)
+	if (i_reset)
+	begin
+		cv  <= 0;
+		sv  <= 0;
+		tx  <= 0;
+		ty  <= 0;
+		tph <= 0;
+	end else if (i_ce)
+	begin
+		cv  <= ctbl[i_phase[(PW-1):(PW-LGTBL)]];
+		sv  <= stbl[i_phase[(PW-1):(PW-LGTBL)]];
+		tx  <= e_xval;
+		ty  <= e_yval;
+		tph <= { {(LGTBL+1){!i_phase[(PW-LGTBL-1)]}},
+				i_phase[(PW-LGTBL-2):0] };
+	end
+
+	// Clock two: The four products of the complex multiply
+	always @(posedge i_clk)
+	if (i_reset)
+	begin
+		pxc <= 0;
+		pys <= 0;
+		pxs <= 0;
+		pyc <= 0;
+		mph <= 0;
+	end else if (i_ce)
+	begin
+		pxc <= tx * cv;
+		pys <= ty * sv;
+		pxs <= tx * sv;
+		pyc <= ty * cv;
+		mph <= tph;
+	end
+
+	// Clock three: Add the products together, and round them
+	// back down to our working width
+	wire	signed	[(WW+TW):0]	rx, ry;
+
+	assign	rx = pxc - pys
+			+ $signed({ {(WW+2){1'b0}}, 1'b1, {(TW-2){1'b0}} });
+	assign	ry = pxs + pyc
+			+ $signed({ {(WW+2){1'b0}}, 1'b1, {(TW-2){1'b0}} });
+
+	always @(posedge i_clk)
+	if (i_reset)
+	begin
+		xv[0] <= 0;
+		yv[0] <= 0;
+		ph[0] <= 0;
+	end else if (i_ce)
+	begin
+		xv[0] <= rx[(WW+TW-2):(TW-1)];
+		yv[0] <= ry[(WW+TW-2):(TW-1)];
+		ph[0] <= mph;
+	end
+
+	// Make Verilator happy with the bits of r.
+	// verilator lint_off UNUSED
+	wire	[(2*TW+1):0] unused_rv;
+	assign	unused_rv = {
+		rx[(WW+TW):(WW+TW-1)], rx[(TW-2):0],
+		ry[(WW+TW):(WW+TW-1)], ry[(TW-2):0]
+		};
+	// verilator lint_on UNUSED
+
+	//
+	// The angles of the CORDIC stages remaining after the table
+	// lookup.  cordic_angle[i] is atan(2^-(i+FIRST+1)), in units
+	// of our phase variable.
+	//
+	wire	[18:0]	cordic_angle [0:(NSTAGES-1)];
+
+	assign	cordic_angle[ 0] = 19'h0_00a2; //   0.111906 deg
+	assign	cordic_angle[ 1] = 19'h0_0051; //   0.055953 deg
+	assign	cordic_angle[ 2] = 19'h0_0028; //   0.027976 deg
+	assign	cordic_angle[ 3] = 19'h0_0014; //   0.013988 deg
+	assign	cordic_angle[ 4] = 19'h0_000a; //   0.006994 deg
+	assign	cordic_angle[ 5] = 19'h0_0005; //   0.003497 deg
+	assign	cordic_angle[ 6] = 19'h0_0002; //   0.001749 deg
+	// Phase Quantization: 0.000018 (Radians)
+	// Gain is 1.000003
+
+	genvar	i;
+	generate for(i=0; i<NSTAGES; i=i+1) begin : CORDICops
+		// The CORDIC stages that the table couldn't replace.
+		// Stage i here is stage i+FIRST of a full CORDIC.
+	always @(posedge i_clk)
+	if (i_reset)
+		begin
+			xv[i+1] <= 0;
+			yv[i+1] <= 0;
+			ph[i+1] <= 0;
+		end else if (i_ce)
+		begin
+			if ((cordic_angle[i] == 0)||(i+FIRST >= WW))
+			begin // Do nothing but move our outputs
+			// forward one stage, since we have more
+			// stages than valid data
+				xv[i+1] <= xv[i];
+				yv[i+1] <= yv[i];
+				ph[i+1] <= ph[i];
+			end else if (ph[i][(PW-1)]) // Negative phase
+			begin
+				// If the phase is negative, rotate by the
+				// CORDIC angle in a clockwise direction.
+				xv[i+1] <= xv[i] + (yv[i]>>>(i+FIRST+1));
+				yv[i+1] <= yv[i] - (xv[i]>>>(i+FIRST+1));
+				ph[i+1] <= ph[i] + cordic_angle[i];
+			end else begin
+				// On the other hand, if the phase is
+				// positive ... rotate in the
+				// counter-clockwise direction
+				xv[i+1] <= xv[i] - (yv[i]>>>(i+FIRST+1));
+				yv[i+1] <= yv[i] + (xv[i]>>>(i+FIRST+1));
+				ph[i+1] <= ph[i] - cordic_angle[i];
+			end
+		end
+	end endgenerate
+
+	// Round our result towards even
+	wire	[(WW-1):0]	pre_xval, pre_yval;
+
+	assign	pre_xval = xv[NSTAGES] + $signed({{(OW){1'b0}},
+				xv[NSTAGES][(WW-OW)],
+				{(WW-OW-1){!xv[NSTAGES][WW-OW]}}});
+	assign	pre_yval = yv[NSTAGES] + $signed({{(OW){1'b0}},
+				yv[NSTAGES][(WW-OW)],
+				{(WW-OW-1){!yv[NSTAGES][WW-OW]}}});
+
+	always @(posedge i_clk)
+	if (i_reset)
+	begin
+		o_xval <= 0;
+		o_yval <= 0;
+	end else if (i_ce)
+	begin
+		o_xval <= pre_xval[(WW-1):(WW-OW)];
+		o_yval <= pre_yval[(WW-1):(WW-OW)];
+		o_aux <= ax[NSTAGES+2];
+	end
+
+	// Make Verilator happy with pre_.val
+	// verilator lint_off UNUSED
+	wire	[(2*(WW-OW)-1):0] unused_val;
+	assign	unused_val = {
+		pre_xval[(WW-OW-1):0],
+		pre_yval[(WW-OW-1):0]
+		};
+	// verilator lint_on UNUSED
+endmodule
@@ -0,0 +1,529 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename: 	hybridcordic_model.h
+//
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	This is a bit-accurate C++ software model of the core
+//		found in the Verilog file of the same name.  It was generated
+//	from the same parameters as that core, and should produce
+//	identical outputs for identical inputs.  Call it in place of
+//	running Verilator when you need the core's exact outputs at native
+//	speed.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2017-2018, Gisselquist Technology, LLC
+//
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+//
+// License:	GPL, v3, as defined and found on www.gnu.org,
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+//
+#ifndef	HYBRIDCORDIC_MODEL_H
+#define	HYBRIDCORDIC_MODEL_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifndef	GENCORDIC_MODEL_HELPERS
+#define	GENCORDIC_MODEL_HELPERS
+//
+// mdl_sext
+//
+// Sign extend the bottom w bits of v, dropping everything above them.
+// This captures the wrap-around of a w-bit Verilog register.
+static inline int64_t	mdl_sext(int64_t v, int w) {
+	return (int64_t)((uint64_t)v << (64-w)) >> (64-w);
+}
+
+//
+// mdl_shl
+//
+// A left shift, done unsigned so that it's defined even when v is
+// negative.
+static inline int64_t	mdl_shl(int64_t v, int s) {
+	return (int64_t)((uint64_t)v << s);
+}
+
+//
+// mdl_asr
+//
+// An arithmetic right shift that, like Verilog's >>>, doesn't mind
+// shifting by more bits than are in the word.
+static inline int64_t	mdl_asr(int64_t v, int s) {
+	return (s >= 63) ? ((v < 0) ? -1 : 0) : (v >> s);
+}
+
+//
+// mdl_round
+//
+// Drop a ww bit value down to ow bits.  If more than one bit is
+// dropped, round towards even first, just like the generated cores do.
+static inline int64_t	mdl_round(int64_t v, int ww, int ow) {
+	int	drop = ww - ow;
+
+	if (drop > 1) {
+		int64_t	half = (1ll<<(drop-1));
+
+		v += ((v >> drop)&1) ? half : (half-1);
+	}
+	return mdl_sext(v >> drop, ow);
+}
+#endif	// GENCORDIC_MODEL_HELPERS
+
+static const int	HYBRIDCORDIC_IW = 12,	// The number of bits in our inputs
+		HYBRIDCORDIC_OW = 12,	// The number of output bits to produce
+		HYBRIDCORDIC_NSTAGES = 7,
+		HYBRIDCORDIC_XTRA = 3,	// Extra bits for internal precision
+		HYBRIDCORDIC_WW = 15,	// Our working bit-width
+		HYBRIDCORDIC_PW = 19,	// Bits in our phase variables
+		HYBRIDCORDIC_LATENCY = 11;	// Clocks from input to output
+static const uint64_t	HYBRIDCORDIC_PMASK = 0x7ffffull;
+
+static const int	HYBRIDCORDIC_FIRST = 8,	// Stages replaced by the table
+		HYBRIDCORDIC_LGTBL = 10,	// Log_2 of the number of table entries
+		HYBRIDCORDIC_TW = 15;	// Bits in each table entry
+
+static const uint32_t	hybridcordic_angle[HYBRIDCORDIC_NSTAGES] = {
+	0x000a2, 0x00051, 0x00028, 0x00014,
+	0x0000a, 0x00005, 0x00002
+};
+
+static const int32_t	hybridcordic_ctbl[1024] = {
+	16383, 16383, 16382, 16380, 16378, 16375,
+	16371, 16367, 16362, 16356, 16350, 16343,
+	16336, 16328, 16319, 16310, 16300, 16290,
+	16279, 16267, 16255, 16242, 16228, 16214,
+	16199, 16184, 16168, 16151, 16134, 16116,
+	16098, 16079, 16059, 16039, 16018, 15997,
+	15975, 15952, 15929, 15905, 15881, 15856,
+	15830, 15804, 15777, 15750, 15722, 15693,
+	15664, 15634, 15604, 15573, 15541, 15509,
+	15476, 15443, 15409, 15375, 15340, 15304,
+	15268, 15231, 15194, 15156, 15118, 15078,
+	15039, 14999, 14958, 14917, 14875, 14832,
+	14789, 14746, 14702, 14657, 14612, 14566,
+	14520, 14473, 14426, 14378, 14329, 14280,
+	14231, 14181, 14130, 14079, 14027, 13975,
+	13922, 13869, 13815, 13761, 13706, 13651,
+	13595, 13538, 13482, 13424, 13366, 13308,
+	13249, 13190, 13130, 13069, 13008, 12947,
+	12885, 12823, 12760, 12697, 12633, 12569,
+	12504, 12439, 12373, 12307, 12240, 12173,
+	12106, 12038, 11970, 11901, 11831, 11762,
+	11691, 11621, 11550, 11478, 11406, 11334,
+	11261, 11188, 11114, 11040, 10966, 10891,
+	10815, 10740, 10663, 10587, 10510, 10433,
+	10355, 10277, 10198, 10120, 10040, 9961,
+	9881, 9800, 9720, 9638, 9557, 9475,
+	9393, 9310, 9227, 9144, 9061, 8977,
+	8892, 8808, 8723, 8638, 8552, 8466,
+	8380, 8293, 8207, 8119, 8032, 7944,
+	7856, 7768, 7679, 7590, 7501, 7411,
+	7321, 7231, 7141, 7050, 6960, 6868,
+	6777, 6685, 6593, 6501, 6409, 6316,
+	6223, 6130, 6037, 5943, 5850, 5756,
+	5661, 5567, 5472, 5377, 5282, 5187,
+	5092, 4996, 4900, 4804, 4708, 4612,
+	4515, 4418, 4321, 4224, 4127, 4030,
+	3932, 3835, 3737, 3639, 3541, 3442,
+	3344, 3246, 3147, 3048, 2949, 2851,
+	2752, 2652, 2553, 2454, 2354, 2255,
+	2155, 2055, 1956, 1856, 1756, 1656,
+	1556, 1456, 1356, 1255, 1155, 1055,
+	955, 854, 754, 653, 553, 452,
+	352, 251, 151, 50, -50, -151,
+	-251, -352, -452, -553, -653, -754,
+	-854, -955, -1055, -1155, -1255, -1356,
+	-1456, -1556, -1656, -1756, -1856, -1956,
+	-2055, -2155, -2255, -2354, -2454, -2553,
+	-2652, -2752, -2851, -2949, -3048, -3147,
+	-3246, -3344, -3442, -3541, -3639, -3737,
+	-3835, -3932, -4030, -4127, -4224, -4321,
+	-4418, -4515, -4612, -4708, -4804, -4900,
+	-4996, -5092, -5187, -5282, -5377, -5472,
+	-5567, -5661, -5756, -5850, -5943, -6037,
+	-6130, -6223, -6316, -6409, -6501, -6593,
+	-6685, -6777, -6868, -6960, -7050, -7141,
+	-7231, -7321, -7411, -7501, -7590, -7679,
+	-7768, -7856, -7944, -8032, -8119, -8207,
+	-8293, -8380, -8466, -8552, -8638, -8723,
+	-8808, -8892, -8977, -9061, -9144, -9227,
+	-9310, -9393, -9475, -9557, -9638, -9720,
+	-9800, -9881, -9961, -10040, -10120, -10198,
+	-10277, -10355, -10433, -10510, -10587, -10663,
+	-10740, -10815, -10891, -10966, -11040, -11114,
+	-11188, -11261, -11334, -11406, -11478, -11550,
+	-11621, -11691, -11762, -11831, -11901, -11970,
+	-12038, -12106, -12173, -12240, -12307, -12373,
+	-12439, -12504, -12569, -12633, -12697, -12760,
+	-12823, -12885, -12947, -13008, -13069, -13130,
+	-13190, -13249, -13308, -13366, -13424, -13482,
+	-13538, -13595, -13651, -13706, -13761, -13815,
+	-13869, -13922, -13975, -14027, -14079, -14130,
+	-14181, -14231, -14280, -14329, -14378, -14426,
+	-14473, -14520, -14566, -14612, -14657, -14702,
+	-14746, -14789, -14832, -14875, -14917, -14958,
+	-14999, -15039, -15078, -15118, -15156, -15194,
+	-15231, -15268, -15304, -15340, -15375, -15409,
+	-15443, -15476, -15509, -15541, -15573, -15604,
+	-15634, -15664, -15693, -15722, -15750, -15777,
+	-15804, -15830, -15856, -15881, -15905, -15929,
+	-15952, -15975, -15997, -16018, -16039, -16059,
+	-16079, -16098, -16116, -16134, -16151, -16168,
+	-16184, -16199, -16214, -16228, -16242, -16255,
+	-16267, -16279, -16290, -16300, -16310, -16319,
+	-16328, -16336, -16343, -16350, -16356, -16362,
+	-16367, -16371, -16375, -16378, -16380, -16382,
+	-16383, -16383, -16383, -16383, -16382, -16380,
+	-16378, -16375, -16371, -16367, -16362, -16356,
+	-16350, -16343, -16336, -16328, -16319, -16310,
+	-16300, -16290, -16279, -16267, -16255, -16242,
+	-16228, -16214, -16199, -16184, -16168, -16151,
+	-16134, -16116, -16098, -16079, -16059, -16039,
+	-16018, -15997, -15975, -15952, -15929, -15905,
+	-15881, -15856, -15830, -15804, -15777, -15750,
+	-15722, -15693, -15664, -15634, -15604, -15573,
+	-15541, -15509, -15476, -15443, -15409, -15375,
+	-15340, -15304, -15268, -15231, -15194, -15156,
+	-15118, -15078, -15039, -14999, -14958, -14917,
+	-14875, -14832, -14789, -14746, -14702, -14657,
+	-14612, -14566, -14520, -14473, -14426, -14378,
+	-14329, -14280, -14231, -14181, -14130, -14079,
+	-14027, -13975, -13922, -13869, -13815, -13761,
+	-13706, -13651, -13595, -13538, -13482, -13424,
+	-13366, -13308, -13249, -13190, -13130, -13069,
+	-13008, -12947, -12885, -12823, -12760, -12697,
+	-12633, -12569, -12504, -12439, -12373, -12307,
+	-12240, -12173, -12106, -12038, -11970, -11901,
+	-11831, -11762, -11691, -11621, -11550, -11478,
+	-11406, -11334, -11261, -11188, -11114, -11040,
+	-10966, -10891, -10815, -10740, -10663, -10587,
+	-10510, -10433, -10355, -10277, -10198, -10120,
+	-10040, -9961, -9881, -9800, -9720, -9638,
+	-9557, -9475, -9393, -9310, -9227, -9144,
+	-9061, -8977, -8892, -8808, -8723, -8638,
+	-8552, -8466, -8380, -8293, -8207, -8119,
+	-8032, -7944, -7856, -7768, -7679, -7590,
+	-7501, -7411, -7321, -7231, -7141, -7050,
+	-6960, -6868, -6777, -6685, -6593, -6501,
+	-6409, -6316, -6223, -6130, -6037, -5943,
+	-5850, -5756, -5661, -5567, -5472, -5377,
+	-5282, -5187, -5092, -4996, -4900, -4804,
+	-4708, -4612, -4515, -4418, -4321, -4224,
+	-4127, -4030, -3932, -3835, -3737, -3639,
+	-3541, -3442, -3344, -3246, -3147, -3048,
+	-2949, -2851, -2752, -2652, -2553, -2454,
+	-2354, -2255, -2155, -2055, -1956, -1856,
+	-1756, -1656, -1556, -1456, -1356, -1255,
+	-1155, -1055, -955, -854, -754, -653,
+	-553, -452, -352, -251, -151, -50,
+	50, 151, 251, 352, 452, 553,
+	653, 754, 854, 955, 1055, 1155,
+	1255, 1356, 1456, 1556, 1656, 1756,
+	1856, 1956, 2055, 2155, 2255, 2354,
+	2454, 2553, 2652, 2752, 2851, 2949,
+	3048, 3147, 3246, 3344, 3442, 3541,
+	3639, 3737, 3835, 3932, 4030, 4127,
+	4224, 4321, 4418, 4515, 4612, 4708,
+	4804, 4900, 4996, 5092, 5187, 5282,
+	5377, 5472, 5567, 5661, 5756, 5850,
+	5943, 6037, 6130, 6223, 6316, 6409,
+	6501, 6593, 6685, 6777, 6868, 6960,
+	7050, 7141, 7231, 7321, 7411, 7501,
+	7590, 7679, 7768, 7856, 7944, 8032,
+	8119, 8207, 8293, 8380, 8466, 8552,
+	8638, 8723, 8808, 8892, 8977, 9061,
+	9144, 9227, 9310, 9393, 9475, 9557,
+	9638, 9720, 9800, 9881, 9961, 10040,
+	10120, 10198, 10277, 10355, 10433, 10510,
+	10587, 10663, 10740, 10815, 10891, 10966,
+	11040, 11114, 11188, 11261, 11334, 11406,
+	11478, 11550, 11621, 11691, 11762, 11831,
+	11901, 11970, 12038, 12106, 12173, 12240,
+	12307, 12373, 12439, 12504, 12569, 12633,
+	12697, 12760, 12823, 12885, 12947, 13008,
+	13069, 13130, 13190, 13249, 13308, 13366,
+	13424, 13482, 13538, 13595, 13651, 13706,
+	13761, 13815, 13869, 13922, 13975, 14027,
+	14079, 14130, 14181, 14231, 14280, 14329,
+	14378, 14426, 14473, 14520, 14566, 14612,
+	14657, 14702, 14746, 14789, 14832, 14875,
+	14917, 14958, 14999, 15039, 15078, 15118,
+	15156, 15194, 15231, 15268, 15304, 15340,
+	15375, 15409, 15443, 15476, 15509, 15541,
+	15573, 15604, 15634, 15664, 15693, 15722,
+	15750, 15777, 15804, 15830, 15856, 15881,
+	15905, 15929, 15952, 15975, 15997, 16018,
+	16039, 16059, 16079, 16098, 16116, 16134,
+	16151, 16168, 16184, 16199, 16214, 16228,
+	16242, 16255, 16267, 16279, 16290, 16300,
+	16310, 16319, 16328, 16336, 16343, 16350,
+	16356, 16362, 16367, 16371, 16375, 16378,
+	16380, 16382, 16383, 16383
+};
+
+static const int32_t	hybridcordic_stbl[1024] = {
+	50, 151, 251, 352, 452, 553,
+	653, 754, 854, 955, 1055, 1155,
+	1255, 1356, 1456, 1556, 1656, 1756,
+	1856, 1956, 2055, 2155, 2255, 2354,
+	2454, 2553, 2652, 2752, 2851, 2949,
+	3048, 3147, 3246, 3344, 3442, 3541,
+	3639, 3737, 3835, 3932, 4030, 4127,
+	4224, 4321, 4418, 4515, 4612, 4708,
+	4804, 4900, 4996, 5092, 5187, 5282,
+	5377, 5472, 5567, 5661, 5756, 5850,
+	5943, 6037, 6130, 6223, 6316, 6409,
+	6501, 6593, 6685, 6777, 6868, 6960,
+	7050, 7141, 7231, 7321, 7411, 7501,
+	7590, 7679, 7768, 7856, 7944, 8032,
+	8119, 8207, 8293, 8380, 8466, 8552,
+	8638, 8723, 8808, 8892, 8977, 9061,
+	9144, 9227, 9310, 9393, 9475, 9557,
+	9638, 9720, 9800, 9881, 9961, 10040,
+	10120, 10198, 10277, 10355, 10433, 10510,
+	10587, 10663, 10740, 10815, 10891, 10966,
+	11040, 11114, 11188, 11261, 11334, 11406,
+	11478, 11550, 11621, 11691, 11762, 11831,
+	11901, 11970, 12038, 12106, 12173, 12240,
+	12307, 12373, 12439, 12504, 12569, 12633,
+	12697, 12760, 12823, 12885, 12947, 13008,
+	13069, 13130, 13190, 13249, 13308, 13366,
+	13424, 13482, 13538, 13595, 13651, 13706,
+	13761, 13815, 13869, 13922, 13975, 14027,
+	14079, 14130, 14181, 14231, 14280, 14329,
+	14378, 14426, 14473, 14520, 14566, 14612,
+	14657, 14702, 14746, 14789, 14832, 14875,
+	14917, 14958, 14999, 15039, 15078, 15118,
+	15156, 15194, 15231, 15268, 15304, 15340,
+	15375, 15409, 15443, 15476, 15509, 15541,
+	15573, 15604, 15634, 15664, 15693, 15722,
+	15750, 15777, 15804, 15830, 15856, 15881,
+	15905, 15929, 15952, 15975, 15997, 16018,
+	16039, 16059, 16079, 16098, 16116, 16134,
+	16151, 16168, 16184, 16199, 16214, 16228,
+	16242, 16255, 16267, 16279, 16290, 16300,
+	16310, 16319, 16328, 16336, 16343, 16350,
+	16356, 16362, 16367, 16371, 16375, 16378,
+	16380, 16382, 16383, 16383, 16383, 16383,
+	16382, 16380, 16378, 16375, 16371, 16367,
+	16362, 16356, 16350, 16343, 16336, 16328,
+	16319, 16310, 16300, 16290, 16279, 16267,
+	16255, 16242, 16228, 16214, 16199, 16184,
+	16168, 16151, 16134, 16116, 16098, 16079,
+	16059, 16039, 16018, 15997, 15975, 15952,
+	15929, 15905, 15881, 15856, 15830, 15804,
+	15777, 15750, 15722, 15693, 15664, 15634,
+	15604, 15573, 15541, 15509, 15476, 15443,
+	15409, 15375, 15340, 15304, 15268, 15231,
+	15194, 15156, 15118, 15078, 15039, 14999,
+	14958, 14917, 14875, 14832, 14789, 14746,
+	14702, 14657, 14612, 14566, 14520, 14473,
+	14426, 14378, 14329, 14280, 14231, 14181,
+	14130, 14079, 14027, 13975, 13922, 13869,
+	13815, 13761, 13706, 13651, 13595, 13538,
+	13482, 13424, 13366, 13308, 13249, 13190,
+	13130, 13069, 13008, 12947, 12885, 12823,
+	12760, 12697, 12633, 12569, 12504, 12439,
+	12373, 12307, 12240, 12173, 12106, 12038,
+	11970, 11901, 11831, 11762, 11691, 11621,
+	11550, 11478, 11406, 11334, 11261, 11188,
+	11114, 11040, 10966, 10891, 10815, 10740,
+	10663, 10587, 10510, 10433, 10355, 10277,
+	10198, 10120, 10040, 9961, 9881, 9800,
+	9720, 9638, 9557, 9475, 9393, 9310,
+	9227, 9144, 9061, 8977, 8892, 8808,
+	8723, 8638, 8552, 8466, 8380, 8293,
+	8207, 8119, 8032, 7944, 7856, 7768,
+	7679, 7590, 7501, 7411, 7321, 7231,
+	7141, 7050, 6960, 6868, 6777, 6685,
+	6593, 6501, 6409, 6316, 6223, 6130,
+	6037, 5943, 5850, 5756, 5661, 5567,
+	5472, 5377, 5282, 5187, 5092, 4996,
+	4900, 4804, 4708, 4612, 4515, 4418,
+	4321, 4224, 4127, 4030, 3932, 3835,
+	3737, 3639, 3541, 3442, 3344, 3246,
+	3147, 3048, 2949, 2851, 2752, 2652,
+	2553, 2454, 2354, 2255, 2155, 2055,
+	1956, 1856, 1756, 1656, 1556, 1456,
+	1356, 1255, 1155, 1055, 955, 854,
+	754, 653, 553, 452, 352, 251,
+	151, 50, -50, -151, -251, -352,
+	-452, -553, -653, -754, -854, -955,
+	-1055, -1155, -1255, -1356, -1456, -1556,
+	-1656, -1756, -1856, -1956, -2055, -2155,
+	-2255, -2354, -2454, -2553, -2652, -2752,
+	-2851, -2949, -3048, -3147, -3246, -3344,
+	-3442, -3541, -3639, -3737, -3835, -3932,
+	-4030, -4127, -4224, -4321, -4418, -4515,
+	-4612, -4708, -4804, -4900, -4996, -5092,
+	-5187, -5282, -5377, -5472, -5567, -5661,
+	-5756, -5850, -5943, -6037, -6130, -6223,
+	-6316, -6409, -6501, -6593, -6685, -6777,
+	-6868, -6960, -7050, -7141, -7231, -7321,
+	-7411, -7501, -7590, -7679, -7768, -7856,
+	-7944, -8032, -8119, -8207, -8293, -8380,
+	-8466, -8552, -8638, -8723, -8808, -8892,
+	-8977, -9061, -9144, -9227, -9310, -9393,
+	-9475, -9557, -9638, -9720, -9800, -9881,
+	-9961, -10040, -10120, -10198, -10277, -10355,
+	-10433, -10510, -10587, -10663, -10740, -10815,
+	-10891, -10966, -11040, -11114, -11188, -11261,
+	-11334, -11406, -11478, -11550, -11621, -11691,
+	-11762, -11831, -11901, -11970, -12038, -12106,
+	-12173, -12240, -12307, -12373, -12439, -12504,
+	-12569, -12633, -12697, -12760, -12823, -12885,
+	-12947, -13008, -13069, -13130, -13190, -13249,
+	-13308, -13366, -13424, -13482, -13538, -13595,
+	-13651, -13706, -13761, -13815, -13869, -13922,
+	-13975, -14027, -14079, -14130, -14181, -14231,
+	-14280, -14329, -14378, -14426, -14473, -14520,
+	-14566, -14612, -14657, -14702, -14746, -14789,
+	-14832, -14875, -14917, -14958, -14999, -15039,
+	-15078, -15118, -15156, -15194, -15231, -15268,
+	-15304, -15340, -15375, -15409, -15443, -15476,
+	-15509, -15541, -15573, -15604, -15634, -15664,
+	-15693, -15722, -15750, -15777, -15804, -15830,
+	-15856, -15881, -15905, -15929, -15952, -15975,
+	-15997, -16018, -16039, -16059, -16079, -16098,
+	-16116, -16134, -16151, -16168, -16184, -16199,
+	-16214, -16228, -16242, -16255, -16267, -16279,
+	-16290, -16300, -16310, -16319, -16328, -16336,
+	-16343, -16350, -16356, -16362, -16367, -16371,
+	-16375, -16378, -16380, -16382, -16383, -16383,
+	-16383, -16383, -16382, -16380, -16378, -16375,
+	-16371, -16367, -16362, -16356, -16350, -16343,
+	-16336, -16328, -16319, -16310, -16300, -16290,
+	-16279, -16267, -16255, -16242, -16228, -16214,
+	-16199, -16184, -16168, -16151, -16134, -16116,
+	-16098, -16079, -16059, -16039, -16018, -15997,
+	-15975, -15952, -15929, -15905, -15881, -15856,
+	-15830, -15804, -15777, -15750, -15722, -15693,
+	-15664, -15634, -15604, -15573, -15541, -15509,
+	-15476, -15443, -15409, -15375, -15340, -15304,
+	-15268, -15231, -15194, -15156, -15118, -15078,
+	-15039, -14999, -14958, -14917, -14875, -14832,
+	-14789, -14746, -14702, -14657, -14612, -14566,
+	-14520, -14473, -14426, -14378, -14329, -14280,
+	-14231, -14181, -14130, -14079, -14027, -13975,
+	-13922, -13869, -13815, -13761, -13706, -13651,
+	-13595, -13538, -13482, -13424, -13366, -13308,
+	-13249, -13190, -13130, -13069, -13008, -12947,
+	-12885, -12823, -12760, -12697, -12633, -12569,
+	-12504, -12439, -12373, -12307, -12240, -12173,
+	-12106, -12038, -11970, -11901, -11831, -11762,
+	-11691, -11621, -11550, -11478, -11406, -11334,
+	-11261, -11188, -11114, -11040, -10966, -10891,
+	-10815, -10740, -10663, -10587, -10510, -10433,
+	-10355, -10277, -10198, -10120, -10040, -9961,
+	-9881, -9800, -9720, -9638, -9557, -9475,
+	-9393, -9310, -9227, -9144, -9061, -8977,
+	-8892, -8808, -8723, -8638, -8552, -8466,
+	-8380, -8293, -8207, -8119, -8032, -7944,
+	-7856, -7768, -7679, -7590, -7501, -7411,
+	-7321, -7231, -7141, -7050, -6960, -6868,
+	-6777, -6685, -6593, -6501, -6409, -6316,
+	-6223, -6130, -6037, -5943, -5850, -5756,
+	-5661, -5567, -5472, -5377, -5282, -5187,
+	-5092, -4996, -4900, -4804, -4708, -4612,
+	-4515, -4418, -4321, -4224, -4127, -4030,
+	-3932, -3835, -3737, -3639, -3541, -3442,
+	-3344, -3246, -3147, -3048, -2949, -2851,
+	-2752, -2652, -2553, -2454, -2354, -2255,
+	-2155, -2055, -1956, -1856, -1756, -1656,
+	-1556, -1456, -1356, -1255, -1155, -1055,
+	-955, -854, -754, -653, -553, -452,
+	-352, -251, -151, -50
+};
+
+//
+// hybridcordic_p2r
+//
+// Rotates (i_xval, i_yval) left by i_phase, producing exactly what
+// hybridcordic.v would produce in o_xval and o_yval 11 clocks later.
+//
+static inline void	hybridcordic_p2r(int32_t i_xval, int32_t i_yval,
+			uint32_t i_phase, int32_t *o_xval, int32_t *o_yval) {
+	int64_t		e_xval, e_yval, xv, yv, nx, ny, cv, sv;
+	uint64_t	ph, idx;
+
+	// First step: expand our input to our working width.
+	e_xval = mdl_shl(mdl_sext(i_xval, HYBRIDCORDIC_IW), HYBRIDCORDIC_WW-HYBRIDCORDIC_IW-1);
+	e_yval = mdl_shl(mdl_sext(i_yval, HYBRIDCORDIC_IW), HYBRIDCORDIC_WW-HYBRIDCORDIC_IW-1);
+	ph = i_phase & HYBRIDCORDIC_PMASK;
+
+	// Look up the coarse rotation, leaving the phase offset from the
+	// center of the table entry's segment
+	idx = ph >> (HYBRIDCORDIC_PW-HYBRIDCORDIC_LGTBL);
+	ph  = ((ph & ((1ull<<(HYBRIDCORDIC_PW-HYBRIDCORDIC_LGTBL))-1))
+		- (1ull<<(HYBRIDCORDIC_PW-HYBRIDCORDIC_LGTBL-1))) & HYBRIDCORDIC_PMASK;
+	cv  = hybridcordic_ctbl[idx];
+	sv  = hybridcordic_stbl[idx];
+
+	// Apply it with a complex multiply, rounding the result back
+	// down to our working width
+	xv = e_xval * cv - e_yval * sv + (1ll<<(HYBRIDCORDIC_TW-2));
+	yv = e_xval * sv + e_yval * cv + (1ll<<(HYBRIDCORDIC_TW-2));
+	xv = mdl_sext(xv >> (HYBRIDCORDIC_TW-1), HYBRIDCORDIC_WW);
+	yv = mdl_sext(yv >> (HYBRIDCORDIC_TW-1), HYBRIDCORDIC_WW);
+
+	for(int k=0; k<HYBRIDCORDIC_NSTAGES; k++) {
+		int	s = k + HYBRIDCORDIC_FIRST + 1;
+
+		if ((hybridcordic_angle[k] == 0)||(s > HYBRIDCORDIC_WW))
+			continue;
+		if ((ph >> (HYBRIDCORDIC_PW-1))&1) {
+			// Negative phase, rotate clockwise
+			nx = xv + mdl_asr(yv, s);
+			ny = yv - mdl_asr(xv, s);
+			ph = ph + hybridcordic_angle[k];
+		} else {
+			nx = xv - mdl_asr(yv, s);
+			ny = yv + mdl_asr(xv, s);
+			ph = ph - hybridcordic_angle[k];
+		}
+		xv = mdl_sext(nx, HYBRIDCORDIC_WW);
+		yv = mdl_sext(ny, HYBRIDCORDIC_WW);
+		ph &= HYBRIDCORDIC_PMASK;
+	}
+
+	*o_xval = (int32_t)mdl_round(xv, HYBRIDCORDIC_WW, HYBRIDCORDIC_OW);
+	*o_yval = (int32_t)mdl_round(yv, HYBRIDCORDIC_WW, HYBRIDCORDIC_OW);
+}
+
+//
+// hybridcordic_p2r_batch
+//
+// Applies hybridcordic_p2r() to each of n samples.
+//
+static inline void	hybridcordic_p2r_batch(const int32_t *i_xval,
+			const int32_t *i_yval, const uint32_t *i_phase,
+			int32_t *o_xval, int32_t *o_yval, size_t n) {
+	// The table lookups keep this off of the vectorized fast path
+	for(size_t i=0; i<n; i++)
+		hybridcordic_p2r(i_xval[i], i_yval[i], i_phase[i], &o_xval[i], &o_yval[i]);
+}
+
+#endif	// HYBRIDCORDIC_MODEL_H
@@ -0,0 +1,350 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename: 	../rtl/itercordic.v
+//
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	This file executes a vector rotation on the values
+//		(i_xval, i_yval).  This vector is rotated left by
+//	i_phase.  i_phase is given by the angle, in radians, multiplied by
+//	2^32/(2pi).  In that fashion, a two pi value is zero just as a zero
+//	angle is zero.
+//
+//	This particular version of the CORDIC processes one value at a
+//	time, applying ITERS CORDIC stages on every clock.  It therefore
+//	takes NPASS clocks to rotate each value, where NPASS is NSTAGES
+//	divided by ITERS and rounded up, and then one more to round the
+//	result.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2017-2018, Gisselquist Technology, LLC
+//
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+//
+// License:	GPL, v3, as defined and found on www.gnu.org,
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+//
+`default_nettype	none
+//
+module	itercordic(i_clk, i_reset, i_stb, i_xval, i_yval, i_phase, i_aux,
+		o_busy, o_done, o_xval, o_yval, o_aux);
+	localparam	IW=12,	// The number of bits in our inputs
+			OW=12,	// The number of output bits to produce
+			NSTAGES=15,
+			XTRA= 3,// Extra bits for internal precision
+			WW=15,	// Our working bit-width
+			PW=19,	// Bits in our phase variables
+			ITERS= 4,// CORDIC stages applied per clock
+			NPASS= 4;// Clocks required to apply them all
+	input	wire				i_clk, i_reset, i_stb;
+	input	wire	signed	[(IW-1):0]	i_xval, i_yval;
+	input	wire		[(PW-1):0]	i_phase;
+	output	wire				o_busy;
+	output	reg				o_done;
+	output	reg	signed	[(OW-1):0]	o_xval, o_yval;
+	input	wire				i_aux;
+	output	reg				o_aux;
+	// First step: expand our input to our working width.
+	// This is going to involve extending our input by one
+	// (or more) bits in addition to adding any xtra bits on
+	// bits on the right.  The one bit extra on the left is to
+	// allow for any accumulation due to the cordic gain
+	// within the algorithm.
+	// 
+	wire	signed [(WW-1):0]	e_xval, e_yval;
+	assign	e_xval = { {i_xval[(IW-1)]}, i_xval, {(WW-IW-1){1'b0}} };
+	assign	e_yval = { {i_yval[(IW-1)]}, i_yval, {(WW-IW-1){1'b0}} };
+
+	// Declare variables for all of the separate stages
+	reg	signed	[(WW-1):0]	xv, yv;
+	reg		[(PW-1):0]	ph;
+	reg				idle, last;
+	reg		[3:0]		stage;
+	wire				last_pass;
+
+	//
+	// Handle the auxilliary logic.
+	//
+	// The auxilliary bit is designed so that you can place a valid bit into
+	// the CORDIC function, and see when it comes out.  While the bit is
+	// allowed to be anything, the requirement of this bit is that it *must*
+	// be aligned with the output when done.  That is, if i_xval and i_yval
+	// are input together with i_aux, then when o_xval and o_yval are set
+	// to this value, o_aux *must* contain the value that was in i_aux.
+	//
+	reg		aux;
+
+	always @(posedge i_clk)
+	if (i_reset)
+		aux <= 0;
+	else if ((i_stb)&&(!o_busy))
+		aux <= i_aux;
+
+	assign	last_pass = (!idle)&&(stage == 4'd12);
+
+	initial	idle = 1'b1;
+	always @(posedge i_clk)
+	if (i_reset)
+		idle <= 1'b1;
+	else if ((i_stb)&&(!o_busy))
+		idle <= 1'b0;
+	else if (last_pass)
+		idle <= 1'b1;
+
+	initial	last = 1'b0;
+	always @(posedge i_clk)
+	if (i_reset)
+		last <= 1'b0;
+	else
+		last <= last_pass;
+
+	// The first of the ITERS stages applied on this clock
+	initial	stage = 0;
+	always @(posedge i_clk)
+	if (i_reset)
+		stage <= 0;
+	else if ((idle)||(last_pass))
+		stage <= 0;
+	else
+		stage <= stage + 4'd4;
+
+	//
+	// In many ways, the key to this whole algorithm lies in the angles
+	// necessary to do this.  These angles are also our basic reason for
+	// building this CORDIC in C++: Verilog just can't parameterize this
+	// much.  Further, these angle's risk becoming unsupportable magic
+	// numbers, hence we define these and set them in C++, based upon
+	// the needs of our problem, specifically the number of stages and
+	// the number of bits required in our phase accumulator
+	//
+	wire	[18:0]	cordic_angle [0:(NSTAGES-1)];
+
+	assign	cordic_angle[ 0] = 19'h0_9720; //  26.565051 deg
+	assign	cordic_angle[ 1] = 19'h0_4fd9; //  14.036243 deg
+	assign	cordic_angle[ 2] = 19'h0_2888; //   7.125016 deg
+	assign	cordic_angle[ 3] = 19'h0_1458; //   3.576334 deg
+	assign	cordic_angle[ 4] = 19'h0_0a2e; //   1.789911 deg
+	assign	cordic_angle[ 5] = 19'h0_0517; //   0.895174 deg
+	assign	cordic_angle[ 6] = 19'h0_028b; //   0.447614 deg
+	assign	cordic_angle[ 7] = 19'h0_0145; //   0.223811 deg
+	assign	cordic_angle[ 8] = 19'h0_00a2; //   0.111906 deg
+	assign	cordic_angle[ 9] = 19'h0_0051; //   0.055953 deg
+	assign	cordic_angle[10] = 19'h0_0028; //   0.027976 deg
+	assign	cordic_angle[11] = 19'h0_0014; //   0.013988 deg
+	assign	cordic_angle[12] = 19'h0_000a; //   0.006994 deg
+	assign	cordic_angle[13] = 19'h0_0005; //   0.003497 deg
+	assign	cordic_angle[14] = 19'h0_0002; //   0.001749 deg
+	// Std-Dev    : 0.00 (Units)
+	// Phase Quantization: 0.000030 (Radians)
+	// Gain is 1.164435
+	// You can annihilate this gain by multiplying by 32'hdbd95b17
+	// and right shifting by 32 bits.
+
+	// Here's where we are going to put the actual CORDIC
+	// we've been studying and discussing.  Each clock, the
+	// vector in xv, yv, and ph works its way through ITERS
+	// CORDIC stages, one feeding the next, before being
+	// registered again.
+	wire	signed	[(WW-1):0]	ix	[0:ITERS];
+	wire	signed	[(WW-1):0]	iy	[0:ITERS];
+	wire		[(PW-1):0]	iph	[0:ITERS];
+	wire		[3:0]		istage	[0:(ITERS-1)];
+	wire		[(PW-1):0]	iangle	[0:(ITERS-1)];
+
+	assign	ix[0]  = xv;
+	assign	iy[0]  = yv;
+	assign	iph[0] = ph;
+
+	// Iteration 0
+	assign	istage[0] = stage + 4'd0;
+	assign	iangle[0] = (istage[0] < 4'd15)
+			? cordic_angle[istage[0]] : {(PW){1'b0}};
+
+	wire	thru_0;
+	assign	thru_0 = (iangle[0] == 0);
+	// If the phase is negative, rotate by the CORDIC angle in a
+	// clockwise direction, otherwise counter-clockwise
+	assign	ix[1] = (thru_0) ? ix[0]
+		: (iph[0][PW-1]) ? (ix[0] + (iy[0] >>> (istage[0]+1)))
+		: (ix[0] - (iy[0] >>> (istage[0]+1)));
+	assign	iy[1] = (thru_0) ? iy[0]
+		: (iph[0][PW-1]) ? (iy[0] - (ix[0] >>> (istage[0]+1)))
+		: (iy[0] + (ix[0] >>> (istage[0]+1)));
+	assign	iph[1] = (thru_0) ? iph[0]
+		: (iph[0][PW-1]) ? (iph[0] + iangle[0])
+		: (iph[0] - iangle[0]);
+
+	// Iteration 1
+	assign	istage[1] = stage + 4'd1;
+	assign	iangle[1] = (istage[1] < 4'd15)
+			? cordic_angle[istage[1]] : {(PW){1'b0}};
+
+	wire	thru_1;
+	assign	thru_1 = (iangle[1] == 0);
+	// If the phase is negative, rotate by the CORDIC angle in a
+	// clockwise direction, otherwise counter-clockwise
+	assign	ix[2] = (thru_1) ? ix[1]
+		: (iph[1][PW-1]) ? (ix[1] + (iy[1] >>> (istage[1]+1)))
+		: (ix[1] - (iy[1] >>> (istage[1]+1)));
+	assign	iy[2] = (thru_1) ? iy[1]
+		: (iph[1][PW-1]) ? (iy[1] - (ix[1] >>> (istage[1]+1)))
+		: (iy[1] + (ix[1] >>> (istage[1]+1)));
+	assign	iph[2] = (thru_1) ? iph[1]
+		: (iph[1][PW-1]) ? (iph[1] + iangle[1])
+		: (iph[1] - iangle[1]);
+
+	// Iteration 2
+	assign	istage[2] = stage + 4'd2;
+	assign	iangle[2] = (istage[2] < 4'd15)
+			? cordic_angle[istage[2]] : {(PW){1'b0}};
+
+	wire	thru_2;
+	assign	thru_2 = (iangle[2] == 0);
+	// If the phase is negative, rotate by the CORDIC angle in a
+	// clockwise direction, otherwise counter-clockwise
+	assign	ix[3] = (thru_2) ? ix[2]
+		: (iph[2][PW-1]) ? (ix[2] + (iy[2] >>> (istage[2]+1)))
+		: (ix[2] - (iy[2] >>> (istage[2]+1)));
+	assign	iy[3] = (thru_2) ? iy[2]
+		: (iph[2][PW-1]) ? (iy[2] - (ix[2] >>> (istage[2]+1)))
+		: (iy[2] + (ix[2] >>> (istage[2]+1)));
+	assign	iph[3] = (thru_2) ? iph[2]
+		: (iph[2][PW-1]) ? (iph[2] + iangle[2])
+		: (iph[2] - iangle[2]);
+
+	// Iteration 3
+	assign	istage[3] = stage + 4'd3;
+	assign	iangle[3] = (istage[3] < 4'd15)
+			? cordic_angle[istage[3]] : {(PW){1'b0}};
+
+	wire	thru_3;
+	assign	thru_3 = (iangle[3] == 0);
+	// If the phase is negative, rotate by the CORDIC angle in a
+	// clockwise direction, otherwise counter-clockwise
+	assign	ix[4] = (thru_3) ? ix[3]
+		: (iph[3][PW-1]) ? (ix[3] + (iy[3] >>> (istage[3]+1)))
+		: (ix[3] - (iy[3] >>> (istage[3]+1)));
+	assign	iy[4] = (thru_3) ? iy[3]
+		: (iph[3][PW-1]) ? (iy[3] - (ix[3] >>> (istage[3]+1)))
+		: (iy[3] + (ix[3] >>> (istage[3]+1)));
+	assign	iph[4] = (thru_3) ? iph[3]
+		: (iph[3][PW-1]) ? (iph[3] + iangle[3])
+		: (iph[3] - iangle[3]);
+
+	// Accept a new value, getting rid of all but the last 45
+	// degrees as we do so, or otherwise apply the next ITERS
+	// stages.  The resulting phase needs to be between -45
+	// and 45 degrees but in units of normalized phase
+	always @(posedge i_clk)
+	if ((i_stb)&&(!o_busy))
+	begin
+		// Walk through all possible quick phase shifts necessary
+		// to constrain the input to within +/- 45 degrees.
+		case(i_phase[(PW-1):(PW-3)])
+		3'b000: begin	// 0 .. 45, No change
+			xv <=  e_xval;
+			yv <=  e_yval;
+			ph <= i_phase;
+			end
+		3'b001: begin	// 45 .. 90
+			xv <= -e_yval;
+			yv <=  e_xval;
+			ph <= i_phase - 19'h20000;
+			end
+		3'b010: begin	// 90 .. 135
+			xv <= -e_yval;
+			yv <=  e_xval;
+			ph <= i_phase - 19'h20000;
+			end
+		3'b011: begin	// 135 .. 180
+			xv <= -e_xval;
+			yv <= -e_yval;
+			ph <= i_phase - 19'h40000;
+			end
+		3'b100: begin	// 180 .. 225
+			xv <= -e_xval;
+			yv <= -e_yval;
+			ph <= i_phase - 19'h40000;
+			end
+		3'b101: begin	// 225 .. 270
+			xv <=  e_yval;
+			yv <= -e_xval;
+			ph <= i_phase - 19'h60000;
+			end
+		3'b110: begin	// 270 .. 315
+			xv <=  e_yval;
+			yv <= -e_xval;
+			ph <= i_phase - 19'h60000;
+			end
+		3'b111: begin	// 315 .. 360, No change
+			xv <=  e_xval;
+			yv <=  e_yval;
+			ph <= i_phase;
+			end
+		endcase
+	end else if (!idle)
+	begin
+		xv <= ix[ITERS];
+		yv <= iy[ITERS];
+		ph <= iph[ITERS];
+	end
+
+	// Round our result towards even
+	wire	[(WW-1):0]	final_xv, final_yv;
+
+	assign	final_xv = xv + $signed({{(OW){1'b0}},
+				xv[(WW-OW)],
+				{(WW-OW-1){!xv[WW-OW]}}});
+	assign	final_yv = yv + $signed({{(OW){1'b0}},
+				yv[(WW-OW)],
+				{(WW-OW-1){!yv[WW-OW]}}});
+
+	initial	o_done = 1'b0;
+	always @(posedge i_clk)
+	if (i_reset)
+		o_done <= 1'b0;
+	else
+		o_done <= last;
+
+	always @(posedge i_clk)
+	if (i_reset)
+	begin
+		o_xval <= 0;
+		o_yval <= 0;
+		o_aux  <= 0;
+	end else if (last)
+	begin
+		o_xval <= final_xv[WW-1:WW-OW];
+		o_yval <= final_yv[WW-1:WW-OW];
+		o_aux  <= aux;
+	end
+
+	assign	o_busy = (!idle)||(last);
+
+	// Make Verilator happy with final_.v
+	// verilator lint_off UNUSED
+	wire	[(2*WW-2*OW-1):0] unused_val;
+	assign	unused_val = { final_xv[WW-OW-1:0], final_yv[WW-OW-1:0] };
+	// verilator lint_on UNUSED
+endmodule
@@ -0,0 +1,330 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename: 	iterpolar_model.h
+//
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	This is a bit-accurate C++ software model of the core
+//		found in the Verilog file of the same name.  It was generated
+//	from the same parameters as that core, and should produce
+//	identical outputs for identical inputs.  Call it in place of
+//	running Verilator when you need the core's exact outputs at native
+//	speed.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2017-2018, Gisselquist Technology, LLC
+//
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+//
+// License:	GPL, v3, as defined and found on www.gnu.org,
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+//
+#ifndef	ITERPOLAR_MODEL_H
+#define	ITERPOLAR_MODEL_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifndef	GENCORDIC_MODEL_HELPERS
+#define	GENCORDIC_MODEL_HELPERS
+//
+// mdl_sext
+//
+// Sign extend the bottom w bits of v, dropping everything above them.
+// This captures the wrap-around of a w-bit Verilog register.
+static inline int64_t	mdl_sext(int64_t v, int w) {
+	return (int64_t)((uint64_t)v << (64-w)) >> (64-w);
+}
+
+//
+// mdl_shl
+//
+// A left shift, done unsigned so that it's defined even when v is
+// negative.
+static inline int64_t	mdl_shl(int64_t v, int s) {
+	return (int64_t)((uint64_t)v << s);
+}
+
+//
+// mdl_asr
+//
+// An arithmetic right shift that, like Verilog's >>>, doesn't mind
+// shifting by more bits than are in the word.
+static inline int64_t	mdl_asr(int64_t v, int s) {
+	return (s >= 63) ? ((v < 0) ? -1 : 0) : (v >> s);
+}
+
+//
+// mdl_round
+//
+// Drop a ww bit value down to ow bits.  If more than one bit is
+// dropped, round towards even first, just like the generated cores do.
+static inline int64_t	mdl_round(int64_t v, int ww, int ow) {
+	int	drop = ww - ow;
+
+	if (drop > 1) {
+		int64_t	half = (1ll<<(drop-1));
+
+		v += ((v >> drop)&1) ? half : (half-1);
+	}
+	return mdl_sext(v >> drop, ow);
+}
+#endif	// GENCORDIC_MODEL_HELPERS
+
+static const int	ITERPOLAR_IW = 12,	// The number of bits in our inputs
+		ITERPOLAR_OW = 12,	// The number of output bits to produce
+		ITERPOLAR_NSTAGES = 16,
+		ITERPOLAR_XTRA = 3,	// Extra bits for internal precision
+		ITERPOLAR_WW = 18,	// Our working bit-width
+		ITERPOLAR_PW = 19,	// Bits in our phase variables
+		ITERPOLAR_LATENCY = 6;	// Clocks from input to output
+static const uint64_t	ITERPOLAR_PMASK = 0x7ffffull;
+
+static const uint32_t	iterpolar_angle[ITERPOLAR_NSTAGES] = {
+	0x09720, 0x04fd9, 0x02888, 0x01458,
+	0x00a2e, 0x00517, 0x0028b, 0x00145,
+	0x000a2, 0x00051, 0x00028, 0x00014,
+	0x0000a, 0x00005, 0x00002, 0x00001
+};
+
+//
+// iterpolar_r2p
+//
+// Converts (i_xval, i_yval) to polar coordinates, producing exactly
+// what iterpolar.v would produce in o_mag and o_phase 6 clocks later.
+//
+static inline void	iterpolar_r2p(int32_t i_xval, int32_t i_yval,
+			int32_t *o_mag, uint32_t *o_phase) {
+	int64_t		e_xval, e_yval, xv, yv, nx, ny;
+	uint64_t	ph;
+
+	// First step: expand our input to our working width.
+	e_xval = mdl_shl(mdl_sext(i_xval, ITERPOLAR_IW), ITERPOLAR_WW-ITERPOLAR_IW-2);
+	e_yval = mdl_shl(mdl_sext(i_yval, ITERPOLAR_IW), ITERPOLAR_WW-ITERPOLAR_IW-2);
+
+	// First stage, map to within +/- 45 degrees
+	switch(((e_xval < 0)?2:0)|((e_yval < 0)?1:0)) {
+	case 1:	// Rotate by -315 degrees
+		xv =  e_xval - e_yval; yv =  e_xval + e_yval; ph = 0x70000ull; break;
+	case 2:	// Rotate by -135 degrees
+		xv = -e_xval + e_yval; yv = -e_xval - e_yval; ph = 0x30000ull; break;
+	case 3:	// Rotate by -225 degrees
+		xv = -e_xval - e_yval; yv =  e_xval - e_yval; ph = 0x50000ull; break;
+	default:	// Rotate by -45 degrees
+		xv =  e_xval + e_yval; yv = -e_xval + e_yval; ph = 0x10000ull; break;
+	}
+	xv = mdl_sext(xv, ITERPOLAR_WW);
+	yv = mdl_sext(yv, ITERPOLAR_WW);
+
+	for(int k=0; k<ITERPOLAR_NSTAGES; k++) {
+		if ((iterpolar_angle[k] == 0)||(k >= ITERPOLAR_WW))
+			continue;
+		if (yv < 0) {
+			// Below the axis, rotate in the positive direction
+			nx = xv - mdl_asr(yv, k+1);
+			ny = yv + mdl_asr(xv, k+1);
+			ph = ph - iterpolar_angle[k];
+		} else {
+			nx = xv + mdl_asr(yv, k+1);
+			ny = yv - mdl_asr(xv, k+1);
+			ph = ph + iterpolar_angle[k];
+		}
+		xv = mdl_sext(nx, ITERPOLAR_WW);
+		yv = mdl_sext(ny, ITERPOLAR_WW);
+		ph &= ITERPOLAR_PMASK;
+	}
+
+	*o_mag   = (int32_t)mdl_round(xv, ITERPOLAR_WW, ITERPOLAR_OW);
+	*o_phase = (uint32_t)ph;
+}
+
+//
+// iterpolar_r2p_batch
+//
+// Applies iterpolar_r2p() to each of n samples.
+//
+static inline void	iterpolar_r2p_batch(const int32_t *i_xval,
+			const int32_t *i_yval,
+			int32_t *o_mag, uint32_t *o_phase, size_t n) {
+	const uint32_t	LOWMSK = 0xffffc000u;
+
+#if defined(__clang__)
+#pragma clang loop vectorize(enable) interleave(enable)
+#elif defined(__GNUC__)
+#pragma GCC ivdep
+#endif
+	for(size_t i=0; i<n; i++) {
+		uint32_t	ex, ey, xv, yv, ph, m, t, u;
+
+		// Expand our inputs to our (left justified) working width
+		ex = (uint32_t)((int32_t)((uint32_t)i_xval[i] << 20) >> 2);
+		ey = (uint32_t)((int32_t)((uint32_t)i_yval[i] << 20) >> 2);
+
+		// First stage, map to within +/- 45 degrees
+		t  = (uint32_t)((int32_t)ex >> 31);
+		u  = (uint32_t)((int32_t)ey >> 31);
+		ph = 0x20000000u + (t & 0x40000000u) + (u & 0xc0000000u)
+			+ (t & u & 0x80000000u);
+		m  = t ^ u;
+		xv = ((ex + ey) & ~m) | ((ex - ey) & m);
+		yv = ((ey - ex) & ~m) | ((ex + ey) & m);
+		xv = (xv ^ t) - t;
+		yv = (yv ^ t) - t;
+
+		// Rotate by atan(2^-1)
+		m  = (uint32_t)((int32_t)yv >> 31);
+		t  = (uint32_t)((int32_t)yv >> 1) & LOWMSK;
+		u  = (uint32_t)((int32_t)xv >> 1) & LOWMSK;
+		xv += (t ^ m) - m;
+		yv -= (u ^ m) - m;
+		ph += (0x12e40000u ^ m) - m;
+
+		// Rotate by atan(2^-2)
+		m  = (uint32_t)((int32_t)yv >> 31);
+		t  = (uint32_t)((int32_t)yv >> 2) & LOWMSK;
+		u  = (uint32_t)((int32_t)xv >> 2) & LOWMSK;
+		xv += (t ^ m) - m;
+		yv -= (u ^ m) - m;
+		ph += (0x09fb2000u ^ m) - m;
+
+		// Rotate by atan(2^-3)
+		m  = (uint32_t)((int32_t)yv >> 31);
+		t  = (uint32_t)((int32_t)yv >> 3) & LOWMSK;
+		u  = (uint32_t)((int32_t)xv >> 3) & LOWMSK;
+		xv += (t ^ m) - m;
+		yv -= (u ^ m) - m;
+		ph += (0x05110000u ^ m) - m;
+
+		// Rotate by atan(2^-4)
+		m  = (uint32_t)((int32_t)yv >> 31);
+		t  = (uint32_t)((int32_t)yv >> 4) & LOWMSK;
+		u  = (uint32_t)((int32_t)xv >> 4) & LOWMSK;
+		xv += (t ^ m) - m;
+		yv -= (u ^ m) - m;
+		ph += (0x028b0000u ^ m) - m;
+
+		// Rotate by atan(2^-5)
+		m  = (uint32_t)((int32_t)yv >> 31);
+		t  = (uint32_t)((int32_t)yv >> 5) & LOWMSK;
+		u  = (uint32_t)((int32_t)xv >> 5) & LOWMSK;
+		xv += (t ^ m) - m;
+		yv -= (u ^ m) - m;
+		ph += (0x0145c000u ^ m) - m;
+
+		// Rotate by atan(2^-6)
+		m  = (uint32_t)((int32_t)yv >> 31);
+		t  = (uint32_t)((int32_t)yv >> 6) & LOWMSK;
+		u  = (uint32_t)((int32_t)xv >> 6) & LOWMSK;
+		xv += (t ^ m) - m;
+		yv -= (u ^ m) - m;
+		ph += (0x00a2e000u ^ m) - m;
+
+		// Rotate by atan(2^-7)
+		m  = (uint32_t)((int32_t)yv >> 31);
+		t  = (uint32_t)((int32_t)yv >> 7) & LOWMSK;
+		u  = (uint32_t)((int32_t)xv >> 7) & LOWMSK;
+		xv += (t ^ m) - m;
+		yv -= (u ^ m) - m;
+		ph += (0x00516000u ^ m) - m;
+
+		// Rotate by atan(2^-8)
+		m  = (uint32_t)((int32_t)yv >> 31);
+		t  = (uint32_t)((int32_t)yv >> 8) & LOWMSK;
+		u  = (uint32_t)((int32_t)xv >> 8) & LOWMSK;
+		xv += (t ^ m) - m;
+		yv -= (u ^ m) - m;
+		ph += (0x0028a000u ^ m) - m;
+
+		// Rotate by atan(2^-9)
+		m  = (uint32_t)((int32_t)yv >> 31);
+		t  = (uint32_t)((int32_t)yv >> 9) & LOWMSK;
+		u  = (uint32_t)((int32_t)xv >> 9) & LOWMSK;
+		xv += (t ^ m) - m;
+		yv -= (u ^ m) - m;
+		ph += (0x00144000u ^ m) - m;
+
+		// Rotate by atan(2^-10)
+		m  = (uint32_t)((int32_t)yv >> 31);
+		t  = (uint32_t)((int32_t)yv >> 10) & LOWMSK;
+		u  = (uint32_t)((int32_t)xv >> 10) & LOWMSK;
+		xv += (t ^ m) - m;
+		yv -= (u ^ m) - m;
+		ph += (0x000a2000u ^ m) - m;
+
+		// Rotate by atan(2^-11)
+		m  = (uint32_t)((int32_t)yv >> 31);
+		t  = (uint32_t)((int32_t)yv >> 11) & LOWMSK;
+		u  = (uint32_t)((int32_t)xv >> 11) & LOWMSK;
+		xv += (t ^ m) - m;
+		yv -= (u ^ m) - m;
+		ph += (0x00050000u ^ m) - m;
+
+		// Rotate by atan(2^-12)
+		m  = (uint32_t)((int32_t)yv >> 31);
+		t  = (uint32_t)((int32_t)yv >> 12) & LOWMSK;
+		u  = (uint32_t)((int32_t)xv >> 12) & LOWMSK;
+		xv += (t ^ m) - m;
+		yv -= (u ^ m) - m;
+		ph += (0x00028000u ^ m) - m;
+
+		// Rotate by atan(2^-13)
+		m  = (uint32_t)((int32_t)yv >> 31);
+		t  = (uint32_t)((int32_t)yv >> 13) & LOWMSK;
+		u  = (uint32_t)((int32_t)xv >> 13) & LOWMSK;
+		xv += (t ^ m) - m;
+		yv -= (u ^ m) - m;
+		ph += (0x00014000u ^ m) - m;
+
+		// Rotate by atan(2^-14)
+		m  = (uint32_t)((int32_t)yv >> 31);
+		t  = (uint32_t)((int32_t)yv >> 14) & LOWMSK;
+		u  = (uint32_t)((int32_t)xv >> 14) & LOWMSK;
+		xv += (t ^ m) - m;
+		yv -= (u ^ m) - m;
+		ph += (0x0000a000u ^ m) - m;
+
+		// Rotate by atan(2^-15)
+		m  = (uint32_t)((int32_t)yv >> 31);
+		t  = (uint32_t)((int32_t)yv >> 15) & LOWMSK;
+		u  = (uint32_t)((int32_t)xv >> 15) & LOWMSK;
+		xv += (t ^ m) - m;
+		yv -= (u ^ m) - m;
+		ph += (0x00004000u ^ m) - m;
+
+		// Rotate by atan(2^-16)
+		m  = (uint32_t)((int32_t)yv >> 31);
+		t  = (uint32_t)((int32_t)yv >> 16) & LOWMSK;
+		u  = (uint32_t)((int32_t)xv >> 16) & LOWMSK;
+		xv += (t ^ m) - m;
+		yv -= (u ^ m) - m;
+		ph += (0x00002000u ^ m) - m;
+
+		// Round our result towards even
+		xv += 0x0007c000u + (((xv >> 20)&1) << 14);
+		o_mag[i]   = (int32_t)xv >> 20;
+		o_phase[i] = ph >> 13;
+	}
+}
+
+#endif	// ITERPOLAR_MODEL_H
@@ -0,0 +1,297 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename: 	../rtl/multicordic.v
+//
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	This file executes a vector rotation on the values
+//		(i_xval, i_yval).  This vector is rotated left by
+//	i_phase.  i_phase is given by the angle, in radians, multiplied by
+//	2^32/(2pi).  In that fashion, a two pi value is zero just as a zero
+//	angle is zero.
+//
+//	This particular version of the CORDIC processes one value at a
+//	time in a sequential, vs pipelined or parallel, fashion.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2017-2018, Gisselquist Technology, LLC
+//
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+//
+// License:	GPL, v3, as defined and found on www.gnu.org,
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+//
+`default_nettype	none
+//
+module	multicordic(i_clk, i_reset, i_stb, i_xval, i_yval, i_phase, i_aux,
+		o_busy, o_done, o_xval, o_yval, o_aux);
+	localparam	IW=12,	// The number of bits in our inputs
+			OW=12,	// The number of output bits to produce
+			NSTAGES=15,
+			XTRA= 3,// Extra bits for internal precision
+			WW=15,	// Our working bit-width
+			PW=19;	// Bits in our phase variables
+	input	wire				i_clk, i_reset, i_stb;
+	input	wire	signed	[(IW-1):0]	i_xval, i_yval;
+	input	wire		[(PW-1):0]	i_phase;
+	output	wire				o_busy;
+	output	reg				o_done;
+	output	reg	signed	[(OW-1):0]	o_xval, o_yval;
+	input	wire				i_aux;
+	output	reg				o_aux;
+	// First step: expand our input to our working width.
+	// This is going to involve extending our input by one
+	// (or more) bits in addition to adding any xtra bits on
+	// bits on the right.  The one bit extra on the left is to
+	// allow for any accumulation due to the cordic gain
+	// within the algorithm.
+	// 
+	wire	signed [(WW-1):0]	e_xval, e_yval;
+	assign	e_xval = { {i_xval[(IW-1)]}, i_xval, {(WW-IW-1){1'b0}} };
+	assign	e_yval = { {i_yval[(IW-1)]}, i_yval, {(WW-IW-1){1'b0}} };
+
+	// Declare variables for all of the separate stages
+	reg	signed	[(WW-1):0]	prex, prey;
+	reg		[(PW-1):0]	preph;
+
+	// First step, get rid of all but the last 45 degrees
+	//	The resulting phase needs to be between -45 and 45
+	//		degrees but in units of normalized phase
+	always @(posedge i_clk)
+		// Walk through all possible quick phase shifts necessary
+		// to constrain the input to within +/- 45 degrees.
+		case(i_phase[(PW-1):(PW-3)])
+		3'b000: begin	// 0 .. 45, No change
+			prex  <=  e_xval;
+			prey  <=  e_yval;
+			preph <= i_phase;
+			end
+		3'b001: begin	// 45 .. 90
+			prex  <= -e_yval;
+			prey  <=  e_xval;
+			preph <= i_phase - 19'h20000;
+			end
+		3'b010: begin	// 90 .. 135
+			prex  <= -e_yval;
+			prey  <=  e_xval;
+			preph <= i_phase - 19'h20000;
+			end
+		3'b011: begin	// 135 .. 180
+			prex  <= -e_xval;
+			prey  <= -e_yval;
+			preph <= i_phase - 19'h40000;
+			end
+		3'b100: begin	// 180 .. 225
+			prex  <= -e_xval;
+			prey  <= -e_yval;
+			preph <= i_phase - 19'h40000;
+			end
+		3'b101: begin	// 225 .. 270
+			prex  <=  e_yval;
+			prey  <= -e_xval;
+			preph <= i_phase - 19'h60000;
+			end
+		3'b110: begin	// 270 .. 315
+			prex  <=  e_yval;
+			prey  <= -e_xval;
+			preph <= i_phase - 19'h60000;
+			end
+		3'b111: begin	// 315 .. 360, No change
+			prex  <=  e_xval;
+			prey  <=  e_yval;
+			preph <= i_phase;
+			end
+		endcase
+
+	//
+	// In many ways, the key to this whole algorithm lies in the angles
+	// necessary to do this.  These angles are also our basic reason for
+	// building this CORDIC in C++: Verilog just can't parameterize this
+	// much.  Further, these angle's risk becoming unsupportable magic
+	// numbers, hence we define these and set them in C++, based upon
+	// the needs of our problem, specifically the number of stages and
+	// the number of bits required in our phase accumulator
+	//
+	reg	[18:0]	cordic_angle [0:15];
+	reg	[18:0]	cangle [0:3];
+
+	initial	cordic_angle[ 0] = 19'h0_9720; //  26.565051 deg
+	initial	cordic_angle[ 1] = 19'h0_4fd9; //  14.036243 deg
+	initial	cordic_angle[ 2] = 19'h0_2888; //   7.125016 deg
+	initial	cordic_angle[ 3] = 19'h0_1458; //   3.576334 deg
+	initial	cordic_angle[ 4] = 19'h0_0a2e; //   1.789911 deg
+	initial	cordic_angle[ 5] = 19'h0_0517; //   0.895174 deg
+	initial	cordic_angle[ 6] = 19'h0_028b; //   0.447614 deg
+	initial	cordic_angle[ 7] = 19'h0_0145; //   0.223811 deg
+	initial	cordic_angle[ 8] = 19'h0_00a2; //   0.111906 deg
+	initial	cordic_angle[ 9] = 19'h0_0051; //   0.055953 deg
+	initial	cordic_angle[10] = 19'h0_0028; //   0.027976 deg
+	initial	cordic_angle[11] = 19'h0_0014; //   0.013988 deg
+	initial	cordic_angle[12] = 19'h0_000a; //   0.006994 deg
+	initial	cordic_angle[13] = 19'h0_0005; //   0.003497 deg
+	initial	cordic_angle[14] = 19'h0_0002; //   0.001749 deg
+	initial	cordic_angle[15] = 19'h0_0001; //   0.000874 deg
+	// Std-Dev    : 0.00 (Units)
+	// Phase Quantization: 0.000030 (Radians)
+	// Gain is 1.164435
+	// You can annihilate this gain by multiplying by 32'hdbd95b16
+	// and right shifting by 32 bits.
+
+
+	//
+	// Engine dispatch
+	//
+	// Each new sample goes to the next engine in turn, wr_engine, as
+	// soon as that engine is idle.  Since every engine takes just as
+	// long, the engines also finish in turn, and rd_engine follows
+	// wr_engine around to pick out the engine whose result is next.
+	//
+	localparam	NENGINES = 4;
+	reg	[1:0]		wr_engine, rd_engine;
+	reg	[(NENGINES-1):0]	idle, pre_valid;
+	wire	[(NENGINES-1):0]	start, last_state;
+	wire			accept;
+
+	assign	accept = (i_stb)&&(idle[wr_engine]);
+	assign	start  = (accept) ? ({ {(NENGINES-1){1'b0}}, 1'b1 }
+					<< wr_engine) : 0;
+
+	initial	wr_engine = 0;
+	always @(posedge i_clk)
+	if (i_reset)
+		wr_engine <= 0;
+	else if (accept)
+		wr_engine <= wr_engine + 1'b1;
+
+	initial	rd_engine = 0;
+	always @(posedge i_clk)
+	if (i_reset)
+		rd_engine <= 0;
+	else if (last_state[rd_engine])
+		rd_engine <= rd_engine + 1'b1;
+
+	// Load the engine that's just been handed a sample
+	initial	pre_valid = 0;
+	always @(posedge i_clk)
+	if (i_reset)
+		pre_valid <= 0;
+	else
+		pre_valid <= start;
+
+	reg	signed	[(WW-1):0]	xv [0:(NENGINES-1)];
+	reg	signed	[(WW-1):0]	yv [0:(NENGINES-1)];
+	reg		[(PW-1):0]	ph [0:(NENGINES-1)];
+	reg		[3:0]		state [0:(NENGINES-1)];
+	// Each engine keeps the aux bit of its own sample, so that it
+	// comes back out alongside that sample's result
+	reg	[(NENGINES-1):0]	aux;
+
+	genvar	k;
+	generate for(k=0; k<NENGINES; k=k+1) begin : ENGINE
+		assign	last_state[k] = (state[k] == 14);
+
+		initial	idle[k] = 1'b1;
+		always @(posedge i_clk)
+		if (i_reset)
+			idle[k] <= 1'b1;
+		else if (start[k])
+			idle[k] <= 1'b0;
+		else if (last_state[k])
+			idle[k] <= 1'b1;
+
+		initial	state[k] = 0;
+		always @(posedge i_clk)
+		if (i_reset)
+			state[k] <= 0;
+		else if ((idle[k])||(last_state[k]))
+			state[k] <= 0;
+		else
+			state[k] <= state[k] + 1;
+
+		// This engine's own read of the angle table
+		always @(posedge i_clk)
+			cangle[k] <= cordic_angle[state[k]];
+
+		always @(posedge i_clk)
+		if (i_reset)
+			aux[k] <= 0;
+		else if (start[k])
+			aux[k] <= i_aux;
+
+		always @(posedge i_clk)
+		if (pre_valid[k])
+		begin
+			xv[k] <= prex;
+			yv[k] <= prey;
+			ph[k] <= preph;
+		end else if (ph[k][PW-1])
+		begin
+			xv[k] <= xv[k] + (yv[k] >>> state[k]);
+			yv[k] <= yv[k] - (xv[k] >>> state[k]);
+			ph[k] <= ph[k] + (cangle[k]);
+		end else begin
+			xv[k] <= xv[k] - (yv[k] >>> state[k]);
+			yv[k] <= yv[k] + (xv[k] >>> state[k]);
+			ph[k] <= ph[k] - (cangle[k]);
+		end
+	end endgenerate
+
+	// Only the engine finishing its sample gets rounded
+	wire	signed	[(WW-1):0]	rd_xv, rd_yv;
+	wire	[(WW-1):0]	final_xv, final_yv;
+
+	assign	rd_xv = xv[rd_engine];
+	assign	rd_yv = yv[rd_engine];
+
+	// Round our result towards even
+	assign	final_xv = rd_xv + $signed({{(OW){1'b0}},
+				rd_xv[(WW-OW)],
+				{(WW-OW-1){!rd_xv[WW-OW]}}});
+	assign	final_yv = rd_yv + $signed({{(OW){1'b0}},
+				rd_yv[(WW-OW)],
+				{(WW-OW-1){!rd_yv[WW-OW]}}});
+
+	initial	o_done = 1'b0;
+	always @(posedge i_clk)
+	if (i_reset)
+		o_done <= 1'b0;
+	else
+		o_done <= last_state[rd_engine];
+
+	always @(posedge i_clk)
+	if (last_state[rd_engine])
+	begin
+		o_xval <= final_xv[WW-1:WW-OW];
+		o_yval <= final_yv[WW-1:WW-OW];
+		o_aux <= aux[rd_engine];
+	end
+
+	assign	o_busy = !idle[wr_engine];
+
+	// Make Verilator happy with pre_.val
+	// verilator lint_off UNUSED
+	wire	[(2*WW-2*OW-1):0] unused_val;
+	assign	unused_val = { final_xv[WW-OW-1:0], final_yv[WW-OW-1:0] };
+	// verilator lint_on UNUSED
+endmodule
@@ -0,0 +1,216 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename: 	paircordic.h
+//
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	This .h file notes the default parameter values from
+//		within the generated file.  It is used to communicate
+//	information about the design to the bench testing code.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2017-2018, Gisselquist Technology, LLC
+//
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+//
+// License:	GPL, v3, as defined and found on www.gnu.org,
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+//
+#ifndef	PAIRCORDIC_H
+#define	PAIRCORDIC_H
+const int	IW = 12;
+const int	OW = 12;
+const int	NEXTRA = 3;
+const int	WW = 15;
+const int	PW = 19;
+const int	NSTAGES = 16;
+const int	KSTAGES = 2;
+const int	NPIPE = 8;
+const double	QUANTIZATION_VARIANCE = 2.8025e-01; // (Units^2)
+const double	PHASE_VARIANCE_RAD = 8.8785e-10; // (Radians^2)
+const double	GAIN = 1.1644353454607288;
+const double	BEST_POSSIBLE_CNR = 72.90;
+const bool	HAS_RESET = true;
+const bool	HAS_AUX   = true;
+#define	HAS_RESET_WIRE
+#define	HAS_AUX_WIRES
+#ifndef	GENCORDIC_CORDIC_MODEL
+#define	GENCORDIC_CORDIC_MODEL
+#if	(__cplusplus >= 201402L)
+#include <stdint.h>
+#include <utility>
+
+//
+// tmdl_atan_pow2
+//
+// atan(2^-n), for n > 0, from its Taylor series--summed smallest term
+// first, so that the compiler can evaluate it to within a bit of what
+// atan2() would return.
+constexpr double	tmdl_atan_pow2(int n) {
+	double	x = 1.0, sum = 0.0;
+
+	for(int k=0; k<n; k++)
+		x *= 0.5;
+	const double	x2 = x * x;
+	for(int k=30; k>=0; k--)
+		sum = ((k&1) ? -1.0 : 1.0) / (2*k+1) + x2 * sum;
+	return x * sum;
+}
+
+//
+// tmdl_angle_value
+//
+// The k'th CORDIC angle, atan(2^-(k+1)), in pw-bit phase units, truncated
+// just as cordic_angle_value() truncates it for the Verilog.
+constexpr uint32_t	tmdl_angle_value(int k, int pw) {
+	double	x = tmdl_atan_pow2(k+1);
+
+	x *= (4.0 * (double)(1ull<<(pw-2))) / (3.14159265358979323846 * 2.0);
+	return (uint32_t)x;
+}
+
+template<int NSTAGES>
+struct	TMDL_ANGLES {
+	uint32_t	v[NSTAGES];
+};
+
+template<int NSTAGES, int PW>
+constexpr TMDL_ANGLES<NSTAGES>	tmdl_angles(void) {
+	TMDL_ANGLES<NSTAGES>	a = {};
+
+	for(int k=0; k<NSTAGES; k++)
+		a.v[k] = tmdl_angle_value(k, PW);
+	return a;
+}
+
+//
+// cordic_model
+//
+// A header-only version of the polar to rectangular software model, for
+// any IW, OW, NSTAGES, PW, and XTRA.  The angle table is built by the
+// compiler, and each stage is unrolled with its shift and angle as
+// constants, so there's nothing to set up at run time and no table to load.
+// p2r() may itself be evaluated at compile time.
+//
+template<int IW, int OW, int NSTAGES, int PW, int XTRA>
+struct	cordic_model {
+	static constexpr int	WW = ((IW > OW) ? IW : OW) + XTRA;
+	static constexpr uint64_t	PMASK = (1ull << PW) - 1ull;
+	static constexpr TMDL_ANGLES<NSTAGES>	angle = tmdl_angles<NSTAGES, PW>();
+
+	static_assert((PW > 3)&&(PW <= 32), "PW must be between 4 and 32");
+	static_assert((XTRA >= 1)&&(WW < 62), "WW must be between IW+1 and 61");
+	static_assert((NSTAGES > 0)&&(OW <= 32), "Unsupported NSTAGES or OW");
+
+	static constexpr int64_t	sext(int64_t v, int w) {
+		return (int64_t)((uint64_t)v << (64-w)) >> (64-w);
+	}
+
+	static constexpr int64_t	shl(int64_t v, int s) {
+		return (int64_t)((uint64_t)v << s);
+	}
+
+	static constexpr int64_t	asr(int64_t v, int s) {
+		return (s >= 63) ? ((v < 0) ? -1 : 0) : (v >> s);
+	}
+
+	static constexpr int64_t	round(int64_t v) {
+		if (WW - OW > 1)
+			v += ((v >> (WW-OW))&1) ? (1ll<<(WW-OW-1))
+				: ((1ll<<(WW-OW-1))-1);
+		return sext(v >> (WW-OW), OW);
+	}
+
+	template<int K>
+	static constexpr int	stage(int64_t &xv, int64_t &yv, uint64_t &ph) {
+		constexpr uint64_t	a = angle.v[K];
+		int64_t	nx = xv, ny = yv;
+
+		if ((a == 0)||(K >= WW))
+			return 0;
+		if ((ph >> (PW-1))&1) {
+			// Negative phase, rotate clockwise
+			nx = xv + asr(yv, K+1);
+			ny = yv - asr(xv, K+1);
+			ph = ph + a;
+		} else {
+			nx = xv - asr(yv, K+1);
+			ny = yv + asr(xv, K+1);
+			ph = ph - a;
+		}
+		xv = sext(nx, WW);
+		yv = sext(ny, WW);
+		ph &= PMASK;
+		return 0;
+	}
+
+	template<int... K>
+	static constexpr void	stages(int64_t &xv, int64_t &yv, uint64_t &ph,
+			std::integer_sequence<int, K...>) {
+		int	order[] = { 0, stage<K>(xv, yv, ph)... };
+		(void)order;
+	}
+
+	//
+	// p2r
+	//
+	// Rotates (i_xval, i_yval) left by i_phase, producing exactly what
+	// the core would produce in o_xval and o_yval.
+	static constexpr void	p2r(int32_t i_xval, int32_t i_yval,
+			uint32_t i_phase, int32_t *o_xval, int32_t *o_yval) {
+		int64_t		e_xval = shl(sext(i_xval, IW), WW-IW-1),
+				e_yval = shl(sext(i_yval, IW), WW-IW-1),
+				xv = e_xval, yv = e_yval;
+		uint64_t	ph = i_phase & PMASK;
+
+		// First stage, get rid of all but 45 degrees
+		switch((ph >> (PW-3))&7) {
+		case 1: case 2:	// 45 .. 135
+			xv = -e_yval; yv =  e_xval; ph -= 1ull << (PW-2); break;
+		case 3: case 4:	// 135 .. 225
+			xv = -e_xval; yv = -e_yval; ph -= 2ull << (PW-2); break;
+		case 5: case 6:	// 225 .. 315
+			xv =  e_yval; yv = -e_xval; ph -= 3ull << (PW-2); break;
+		default:	// -45 .. 45, No change
+			break;
+		}
+		xv = sext(xv, WW);
+		yv = sext(yv, WW);
+		ph &= PMASK;
+
+		stages(xv, yv, ph, std::make_integer_sequence<int, NSTAGES>());
+
+		*o_xval = (int32_t)round(xv);
+		*o_yval = (int32_t)round(yv);
+	}
+};
+
+template<int IW, int OW, int NSTAGES, int PW, int XTRA>
+constexpr TMDL_ANGLES<NSTAGES>	cordic_model<IW, OW, NSTAGES, PW, XTRA>::angle;
+#endif	// C++14
+#endif	// GENCORDIC_CORDIC_MODEL
+#if	(__cplusplus >= 201402L)
+typedef	cordic_model<IW, OW, NSTAGES, PW, NEXTRA>	paircordic_model_t;
+#endif
+#endif	// PAIRCORDIC_H
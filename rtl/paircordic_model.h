@@ -0,0 +1,327 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename: 	paircordic_model.h
+//
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	This is a bit-accurate C++ software model of the core
+//		found in the Verilog file of the same name.  It was generated
+//	from the same parameters as that core, and should produce
+//	identical outputs for identical inputs.  Call it in place of
+//	running Verilator when you need the core's exact outputs at native
+//	speed.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2017-2018, Gisselquist Technology, LLC
+//
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+//
+// License:	GPL, v3, as defined and found on www.gnu.org,
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+//
+#ifndef	PAIRCORDIC_MODEL_H
+#define	PAIRCORDIC_MODEL_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifndef	GENCORDIC_MODEL_HELPERS
+#define	GENCORDIC_MODEL_HELPERS
+//
+// mdl_sext
+//
+// Sign extend the bottom w bits of v, dropping everything above them.
+// This captures the wrap-around of a w-bit Verilog register.
+static inline int64_t	mdl_sext(int64_t v, int w) {
+	return (int64_t)((uint64_t)v << (64-w)) >> (64-w);
+}
+
+//
+// mdl_shl
+//
+// A left shift, done unsigned so that it's defined even when v is
+// negative.
+static inline int64_t	mdl_shl(int64_t v, int s) {
+	return (int64_t)((uint64_t)v << s);
+}
+
+//
+// mdl_asr
+//
+// An arithmetic right shift that, like Verilog's >>>, doesn't mind
+// shifting by more bits than are in the word.
+static inline int64_t	mdl_asr(int64_t v, int s) {
+	return (s >= 63) ? ((v < 0) ? -1 : 0) : (v >> s);
+}
+
+//
+// mdl_round
+//
+// Drop a ww bit value down to ow bits.  If more than one bit is
+// dropped, round towards even first, just like the generated cores do.
+static inline int64_t	mdl_round(int64_t v, int ww, int ow) {
+	int	drop = ww - ow;
+
+	if (drop > 1) {
+		int64_t	half = (1ll<<(drop-1));
+
+		v += ((v >> drop)&1) ? half : (half-1);
+	}
+	return mdl_sext(v >> drop, ow);
+}
+#endif	// GENCORDIC_MODEL_HELPERS
+
+static const int	PAIRCORDIC_IW = 12,	// The number of bits in our inputs
+		PAIRCORDIC_OW = 12,	// The number of output bits to produce
+		PAIRCORDIC_NSTAGES = 16,
+		PAIRCORDIC_XTRA = 3,	// Extra bits for internal precision
+		PAIRCORDIC_WW = 15,	// Our working bit-width
+		PAIRCORDIC_PW = 19,	// Bits in our phase variables
+		PAIRCORDIC_LATENCY = 10;	// Clocks from input to output
+static const uint64_t	PAIRCORDIC_PMASK = 0x7ffffull;
+
+static const uint32_t	paircordic_angle[PAIRCORDIC_NSTAGES] = {
+	0x09720, 0x04fd9, 0x02888, 0x01458,
+	0x00a2e, 0x00517, 0x0028b, 0x00145,
+	0x000a2, 0x00051, 0x00028, 0x00014,
+	0x0000a, 0x00005, 0x00002, 0x00001
+};
+
+//
+// paircordic_p2r
+//
+// Rotates (i_xval, i_yval) left by i_phase, producing exactly what
+// paircordic.v would produce in o_xval and o_yval 10 clocks later.
+//
+static inline void	paircordic_p2r(int32_t i_xval, int32_t i_yval,
+			uint32_t i_phase, int32_t *o_xval, int32_t *o_yval) {
+	int64_t		e_xval, e_yval, xv, yv, nx, ny;
+	uint64_t	ph;
+
+	// First step: expand our input to our working width.
+	e_xval = mdl_shl(mdl_sext(i_xval, PAIRCORDIC_IW), PAIRCORDIC_WW-PAIRCORDIC_IW-1);
+	e_yval = mdl_shl(mdl_sext(i_yval, PAIRCORDIC_IW), PAIRCORDIC_WW-PAIRCORDIC_IW-1);
+	ph = i_phase & PAIRCORDIC_PMASK;
+
+	// First stage, get rid of all but 45 degrees
+	switch((ph >> (PAIRCORDIC_PW-3))&7) {
+	case 1: case 2:	// 45 .. 135
+		xv = -e_yval; yv =  e_xval; ph -= 0x20000ull; break;
+	case 3: case 4:	// 135 .. 225
+		xv = -e_xval; yv = -e_yval; ph -= 0x40000ull; break;
+	case 5: case 6:	// 225 .. 315
+		xv =  e_yval; yv = -e_xval; ph -= 0x60000ull; break;
+	default:	// -45 .. 45, No change
+		xv =  e_xval; yv =  e_yval; break;
+	}
+	xv = mdl_sext(xv, PAIRCORDIC_WW);
+	yv = mdl_sext(yv, PAIRCORDIC_WW);
+	ph &= PAIRCORDIC_PMASK;
+
+	for(int k=0; k<PAIRCORDIC_NSTAGES; k++) {
+		if ((paircordic_angle[k] == 0)||(k >= PAIRCORDIC_WW))
+			continue;
+		if ((ph >> (PAIRCORDIC_PW-1))&1) {
+			// Negative phase, rotate clockwise
+			nx = xv + mdl_asr(yv, k+1);
+			ny = yv - mdl_asr(xv, k+1);
+			ph = ph + paircordic_angle[k];
+		} else {
+			nx = xv - mdl_asr(yv, k+1);
+			ny = yv + mdl_asr(xv, k+1);
+			ph = ph - paircordic_angle[k];
+		}
+		xv = mdl_sext(nx, PAIRCORDIC_WW);
+		yv = mdl_sext(ny, PAIRCORDIC_WW);
+		ph &= PAIRCORDIC_PMASK;
+	}
+
+	*o_xval = (int32_t)mdl_round(xv, PAIRCORDIC_WW, PAIRCORDIC_OW);
+	*o_yval = (int32_t)mdl_round(yv, PAIRCORDIC_WW, PAIRCORDIC_OW);
+}
+
+//
+// paircordic_p2r_batch
+//
+// Applies paircordic_p2r() to each of n samples.
+//
+static inline void	paircordic_p2r_batch(const int32_t *i_xval,
+			const int32_t *i_yval, const uint32_t *i_phase,
+			int32_t *o_xval, int32_t *o_yval, size_t n) {
+	const uint32_t	LOWMSK = 0xfffe0000u;
+
+#if defined(__clang__)
+#pragma clang loop vectorize(enable) interleave(enable)
+#elif defined(__GNUC__)
+#pragma GCC ivdep
+#endif
+	for(size_t i=0; i<n; i++) {
+		uint32_t	ex, ey, xv, yv, ph, m, t, u;
+
+		// Expand our inputs to our (left justified) working width
+		ex = (uint32_t)((int32_t)((uint32_t)i_xval[i] << 20) >> 1);
+		ey = (uint32_t)((int32_t)((uint32_t)i_yval[i] << 20) >> 1);
+		ph = (uint32_t)i_phase[i] << 13;
+
+		// First stage, rotate by a multiple of 90 degrees to get
+		// rid of all but 45 degrees
+		t  = (ph + 0x20000000u) >> 30;	// Quadrant
+		ph -= t << 30;
+		m  = -(t & 1);
+		u  = (ex & ~m) | (ey & m);
+		ey = (ey & ~m) | (ex & m);
+		m  = -(((t+1)>>1)&1);
+		xv = (u ^ m) - m;
+		m  = -(t>>1);
+		yv = (ey ^ m) - m;
+
+		// Rotate by atan(2^-1)
+		m  = (uint32_t)((int32_t)ph >> 31);
+		t  = (uint32_t)((int32_t)yv >> 1) & LOWMSK;
+		u  = (uint32_t)((int32_t)xv >> 1) & LOWMSK;
+		xv -= (t ^ m) - m;
+		yv += (u ^ m) - m;
+		ph -= (0x12e40000u ^ m) - m;
+
+		// Rotate by atan(2^-2)
+		m  = (uint32_t)((int32_t)ph >> 31);
+		t  = (uint32_t)((int32_t)yv >> 2) & LOWMSK;
+		u  = (uint32_t)((int32_t)xv >> 2) & LOWMSK;
+		xv -= (t ^ m) - m;
+		yv += (u ^ m) - m;
+		ph -= (0x09fb2000u ^ m) - m;
+
+		// Rotate by atan(2^-3)
+		m  = (uint32_t)((int32_t)ph >> 31);
+		t  = (uint32_t)((int32_t)yv >> 3) & LOWMSK;
+		u  = (uint32_t)((int32_t)xv >> 3) & LOWMSK;
+		xv -= (t ^ m) - m;
+		yv += (u ^ m) - m;
+		ph -= (0x05110000u ^ m) - m;
+
+		// Rotate by atan(2^-4)
+		m  = (uint32_t)((int32_t)ph >> 31);
+		t  = (uint32_t)((int32_t)yv >> 4) & LOWMSK;
+		u  = (uint32_t)((int32_t)xv >> 4) & LOWMSK;
+		xv -= (t ^ m) - m;
+		yv += (u ^ m) - m;
+		ph -= (0x028b0000u ^ m) - m;
+
+		// Rotate by atan(2^-5)
+		m  = (uint32_t)((int32_t)ph >> 31);
+		t  = (uint32_t)((int32_t)yv >> 5) & LOWMSK;
+		u  = (uint32_t)((int32_t)xv >> 5) & LOWMSK;
+		xv -= (t ^ m) - m;
+		yv += (u ^ m) - m;
+		ph -= (0x0145c000u ^ m) - m;
+
+		// Rotate by atan(2^-6)
+		m  = (uint32_t)((int32_t)ph >> 31);
+		t  = (uint32_t)((int32_t)yv >> 6) & LOWMSK;
+		u  = (uint32_t)((int32_t)xv >> 6) & LOWMSK;
+		xv -= (t ^ m) - m;
+		yv += (u ^ m) - m;
+		ph -= (0x00a2e000u ^ m) - m;
+
+		// Rotate by atan(2^-7)
+		m  = (uint32_t)((int32_t)ph >> 31);
+		t  = (uint32_t)((int32_t)yv >> 7) & LOWMSK;
+		u  = (uint32_t)((int32_t)xv >> 7) & LOWMSK;
+		xv -= (t ^ m) - m;
+		yv += (u ^ m) - m;
+		ph -= (0x00516000u ^ m) - m;
+
+		// Rotate by atan(2^-8)
+		m  = (uint32_t)((int32_t)ph >> 31);
+		t  = (uint32_t)((int32_t)yv >> 8) & LOWMSK;
+		u  = (uint32_t)((int32_t)xv >> 8) & LOWMSK;
+		xv -= (t ^ m) - m;
+		yv += (u ^ m) - m;
+		ph -= (0x0028a000u ^ m) - m;
+
+		// Rotate by atan(2^-9)
+		m  = (uint32_t)((int32_t)ph >> 31);
+		t  = (uint32_t)((int32_t)yv >> 9) & LOWMSK;
+		u  = (uint32_t)((int32_t)xv >> 9) & LOWMSK;
+		xv -= (t ^ m) - m;
+		yv += (u ^ m) - m;
+		ph -= (0x00144000u ^ m) - m;
+
+		// Rotate by atan(2^-10)
+		m  = (uint32_t)((int32_t)ph >> 31);
+		t  = (uint32_t)((int32_t)yv >> 10) & LOWMSK;
+		u  = (uint32_t)((int32_t)xv >> 10) & LOWMSK;
+		xv -= (t ^ m) - m;
+		yv += (u ^ m) - m;
+		ph -= (0x000a2000u ^ m) - m;
+
+		// Rotate by atan(2^-11)
+		m  = (uint32_t)((int32_t)ph >> 31);
+		t  = (uint32_t)((int32_t)yv >> 11) & LOWMSK;
+		u  = (uint32_t)((int32_t)xv >> 11) & LOWMSK;
+		xv -= (t ^ m) - m;
+		yv += (u ^ m) - m;
+		ph -= (0x00050000u ^ m) - m;
+
+		// Rotate by atan(2^-12)
+		m  = (uint32_t)((int32_t)ph >> 31);
+		t  = (uint32_t)((int32_t)yv >> 12) & LOWMSK;
+		u  = (uint32_t)((int32_t)xv >> 12) & LOWMSK;
+		xv -= (t ^ m) - m;
+		yv += (u ^ m) - m;
+		ph -= (0x00028000u ^ m) - m;
+
+		// Rotate by atan(2^-13)
+		m  = (uint32_t)((int32_t)ph >> 31);
+		t  = (uint32_t)((int32_t)yv >> 13) & LOWMSK;
+		u  = (uint32_t)((int32_t)xv >> 13) & LOWMSK;
+		xv -= (t ^ m) - m;
+		yv += (u ^ m) - m;
+		ph -= (0x00014000u ^ m) - m;
+
+		// Rotate by atan(2^-14)
+		m  = (uint32_t)((int32_t)ph >> 31);
+		t  = (uint32_t)((int32_t)yv >> 14) & LOWMSK;
+		u  = (uint32_t)((int32_t)xv >> 14) & LOWMSK;
+		xv -= (t ^ m) - m;
+		yv += (u ^ m) - m;
+		ph -= (0x0000a000u ^ m) - m;
+
+		// Rotate by atan(2^-15)
+		m  = (uint32_t)((int32_t)ph >> 31);
+		t  = (uint32_t)((int32_t)yv >> 15) & LOWMSK;
+		u  = (uint32_t)((int32_t)xv >> 15) & LOWMSK;
+		xv -= (t ^ m) - m;
+		yv += (u ^ m) - m;
+		ph -= (0x00004000u ^ m) - m;
+
+		// Round our result towards even
+		xv += 0x00060000u + (((xv >> 20)&1) << 17);
+		yv += 0x00060000u + (((yv >> 20)&1) << 17);
+		o_xval[i] = (int32_t)xv >> 20;
+		o_yval[i] = (int32_t)yv >> 20;
+	}
+}
+
+#endif	// PAIRCORDIC_MODEL_H
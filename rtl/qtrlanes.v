@@ -0,0 +1,127 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename: 	../rtl/qtrlanes.v
+//
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	This is a touch more complicated than the simple sinewave table
+//		lookup approach to generating a sine wave.  This approach
+//	exploits the fact that a sinewave table has symmetry within it,
+//	enough symmetry so as to cut the necessary size of the table
+//	in fourths.  Generating the sinewave value, though, requires
+//	a little more logic to make this possible.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2017-2018, Gisselquist Technology, LLC
+//
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+//
+// License:	GPL, v3, as defined and found on www.gnu.org,
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+//
+module	qtrlanes(i_clk, i_reset, i_ce, i_phase, i_aux, o_val, o_aux);
+	//
+	parameter	PW =12, // Number of bits in the input phase
+			OW =16; // Number of output bits
+	localparam	NLANES= 3,// Phases per clock
+			NTBLS = 2;// Copies of the table
+	//
+	input				i_clk, i_reset, i_ce;
+	input	wire	[(NLANES*PW-1):0]	i_phase;
+	output	reg	[(NLANES*OW-1):0]	o_val;
+	//
+	input	wire			i_aux;
+	output	reg			o_aux;
+
+	// Phase k of each clock is found in i_phase[k*PW +: PW], and its
+	// result in o_val[k*OW +: OW].  Phase zero is the earliest.
+	reg	[(NLANES-1):0]		negate, negate_1;
+	reg	[(NLANES*(PW-2)-1):0]	index;
+	reg	[(NLANES*OW-1):0]	tblvalue;
+
+	genvar	k;
+	generate for(k=0; k<NLANES; k=k+1)
+	begin : LANE
+		wire	[(PW-1):0]	phase;
+
+		assign	phase = i_phase[k*PW +: PW];
+
+		always @(posedge i_clk)
+		if (i_reset)
+		begin
+			negate[k]   <= 1'b0;
+			negate_1[k] <= 1'b0;
+			index[k*(PW-2) +: (PW-2)] <= 0;
+			o_val[k*OW +: OW] <= 0;
+		end else if (i_ce)
+		begin
+			// Clock #1
+			negate[k] <= phase[(PW-1)];
+			if (phase[(PW-2)])
+				index[k*(PW-2) +: (PW-2)] <= ~phase[(PW-3):0];
+			else
+				index[k*(PW-2) +: (PW-2)] <=  phase[(PW-3):0];
+			// Clock #2, the table lookup itself, is below
+			negate_1[k] <= negate[k];
+			// Output Clock
+			if (negate_1[k])
+				o_val[k*OW +: OW] <= -tblvalue[k*OW +: OW];
+			else
+				o_val[k*OW +: OW] <=  tblvalue[k*OW +: OW];
+		end
+	end endgenerate
+
+	// Each copy of the table serves two lanes, one through each of
+	// its two read ports
+	generate for(k=0; k<NTBLS; k=k+1)
+	begin : TBL
+		reg	[(OW-1):0]	quartertable	[0:((1<<(PW-2))-1)];
+
+		initial	$readmemh("qtrlanes.hex", quartertable);
+
+		always @(posedge i_clk)
+		if (i_reset)
+			tblvalue[(2*k)*OW +: OW] <= 0;
+		else if (i_ce)
+			tblvalue[(2*k)*OW +: OW] <= quartertable[index[(2*k)*(PW-2) +: (PW-2)]];
+
+		// With an odd number of lanes, the last copy only needs
+		// the one port
+		if (2*k+1 < NLANES)
+		begin : PORTB
+			always @(posedge i_clk)
+			if (i_reset)
+				tblvalue[(2*k+1)*OW +: OW] <= 0;
+			else if (i_ce)
+				tblvalue[(2*k+1)*OW +: OW] <= quartertable[index[(2*k+1)*(PW-2) +: (PW-2)]];
+		end
+	end endgenerate
+
+	reg [1:0]	aux;
+	always @(posedge i_clk)
+	if (i_reset)
+		{ o_aux, aux } <= 0;
+	else if (i_ce)
+		{ o_aux, aux } <= { aux, i_aux };
+endmodule
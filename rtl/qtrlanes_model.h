@@ -0,0 +1,296 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename: 	qtrlanes_model.h
+//
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	This is a bit-accurate C++ software model of the core
+//		found in the Verilog file of the same name.  It was generated
+//	from the same parameters as that core, and should produce
+//	identical outputs for identical inputs.  Call it in place of
+//	running Verilator when you need the core's exact outputs at native
+//	speed.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2017-2018, Gisselquist Technology, LLC
+//
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+//
+// License:	GPL, v3, as defined and found on www.gnu.org,
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+//
+#ifndef	QTRLANES_MODEL_H
+#define	QTRLANES_MODEL_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifndef	GENCORDIC_MODEL_HELPERS
+#define	GENCORDIC_MODEL_HELPERS
+//
+// mdl_sext
+//
+// Sign extend the bottom w bits of v, dropping everything above them.
+// This captures the wrap-around of a w-bit Verilog register.
+static inline int64_t	mdl_sext(int64_t v, int w) {
+	return (int64_t)((uint64_t)v << (64-w)) >> (64-w);
+}
+
+//
+// mdl_shl
+//
+// A left shift, done unsigned so that it's defined even when v is
+// negative.
+static inline int64_t	mdl_shl(int64_t v, int s) {
+	return (int64_t)((uint64_t)v << s);
+}
+
+//
+// mdl_asr
+//
+// An arithmetic right shift that, like Verilog's >>>, doesn't mind
+// shifting by more bits than are in the word.
+static inline int64_t	mdl_asr(int64_t v, int s) {
+	return (s >= 63) ? ((v < 0) ? -1 : 0) : (v >> s);
+}
+
+//
+// mdl_round
+//
+// Drop a ww bit value down to ow bits.  If more than one bit is
+// dropped, round towards even first, just like the generated cores do.
+static inline int64_t	mdl_round(int64_t v, int ww, int ow) {
+	int	drop = ww - ow;
+
+	if (drop > 1) {
+		int64_t	half = (1ll<<(drop-1));
+
+		v += ((v >> drop)&1) ? half : (half-1);
+	}
+	return mdl_sext(v >> drop, ow);
+}
+#endif	// GENCORDIC_MODEL_HELPERS
+
+static const int	QTRLANES_PW = 12,	// Number of bits in the input phase
+		QTRLANES_OW = 16,	// Number of output bits
+		QTRLANES_NLANES = 3,	// Phases per clock, each its own lane
+		QTRLANES_LATENCY = 3;	// Clocks from input to output
+
+//
+// The quarter wave table, exactly as found in qtrlanes.hex
+//
+static const int32_t	qtrlanes_tbl[1024] = {
+	25, 75, 125, 175, 226, 276,
+	326, 376, 427, 477, 527, 578,
+	628, 678, 728, 779, 829, 879,
+	929, 980, 1030, 1080, 1130, 1180,
+	1231, 1281, 1331, 1381, 1432, 1482,
+	1532, 1582, 1632, 1683, 1733, 1783,
+	1833, 1883, 1934, 1984, 2034, 2084,
+	2134, 2184, 2235, 2285, 2335, 2385,
+	2435, 2485, 2535, 2585, 2636, 2686,
+	2736, 2786, 2836, 2886, 2936, 2986,
+	3036, 3086, 3136, 3186, 3236, 3286,
+	3336, 3386, 3436, 3486, 3536, 3586,
+	3636, 3686, 3736, 3786, 3836, 3886,
+	3936, 3986, 4035, 4085, 4135, 4185,
+	4235, 4285, 4335, 4384, 4434, 4484,
+	4534, 4584, 4633, 4683, 4733, 4783,
+	4832, 4882, 4932, 4981, 5031, 5081,
+	5130, 5180, 5230, 5279, 5329, 5378,
+	5428, 5478, 5527, 5577, 5626, 5676,
+	5725, 5775, 5824, 5874, 5923, 5972,
+	6022, 6071, 6121, 6170, 6219, 6269,
+	6318, 6367, 6417, 6466, 6515, 6564,
+	6614, 6663, 6712, 6761, 6811, 6860,
+	6909, 6958, 7007, 7056, 7105, 7154,
+	7203, 7252, 7301, 7350, 7399, 7448,
+	7497, 7546, 7595, 7644, 7693, 7742,
+	7790, 7839, 7888, 7937, 7986, 8034,
+	8083, 8132, 8180, 8229, 8278, 8326,
+	8375, 8424, 8472, 8521, 8569, 8618,
+	8666, 8715, 8763, 8812, 8860, 8908,
+	8957, 9005, 9053, 9102, 9150, 9198,
+	9246, 9295, 9343, 9391, 9439, 9487,
+	9535, 9583, 9631, 9679, 9727, 9775,
+	9823, 9871, 9919, 9967, 10015, 10063,
+	10111, 10159, 10206, 10254, 10302, 10349,
+	10397, 10445, 10492, 10540, 10588, 10635,
+	10683, 10730, 10778, 10825, 10873, 10920,
+	10967, 11015, 11062, 11109, 11157, 11204,
+	11251, 11298, 11345, 11393, 11440, 11487,
+	11534, 11581, 11628, 11675, 11722, 11769,
+	11816, 11862, 11909, 11956, 12003, 12050,
+	12096, 12143, 12190, 12236, 12283, 12330,
+	12376, 12423, 12469, 12516, 12562, 12609,
+	12655, 12701, 12748, 12794, 12840, 12886,
+	12933, 12979, 13025, 13071, 13117, 13163,
+	13209, 13255, 13301, 13347, 13393, 13439,
+	13485, 13530, 13576, 13622, 13667, 13713,
+	13759, 13804, 13850, 13895, 13941, 13986,
+	14032, 14077, 14123, 14168, 14213, 14259,
+	14304, 14349, 14394, 14439, 14484, 14530,
+	14575, 14620, 14665, 14709, 14754, 14799,
+	14844, 14889, 14934, 14978, 15023, 15068,
+	15112, 15157, 15201, 15246, 15290, 15335,
+	15379, 15424, 15468, 15512, 15556, 15601,
+	15645, 15689, 15733, 15777, 15821, 15865,
+	15909, 15953, 15997, 16041, 16085, 16128,
+	16172, 16216, 16260, 16303, 16347, 16390,
+	16434, 16477, 16521, 16564, 16607, 16651,
+	16694, 16737, 16780, 16824, 16867, 16910,
+	16953, 16996, 17039, 17082, 17124, 17167,
+	17210, 17253, 17296, 17338, 17381, 17423,
+	17466, 17509, 17551, 17593, 17636, 17678,
+	17720, 17763, 17805, 17847, 17889, 17931,
+	17973, 18015, 18057, 18099, 18141, 18183,
+	18225, 18267, 18308, 18350, 18392, 18433,
+	18475, 18516, 18558, 18599, 18640, 18682,
+	18723, 18764, 18805, 18846, 18888, 18929,
+	18970, 19011, 19051, 19092, 19133, 19174,
+	19215, 19255, 19296, 19337, 19377, 19418,
+	19458, 19499, 19539, 19579, 19620, 19660,
+	19700, 19740, 19780, 19820, 19860, 19900,
+	19940, 19980, 20020, 20060, 20099, 20139,
+	20179, 20218, 20258, 20297, 20337, 20376,
+	20415, 20455, 20494, 20533, 20572, 20611,
+	20650, 20689, 20728, 20767, 20806, 20845,
+	20884, 20922, 20961, 21000, 21038, 21077,
+	21115, 21154, 21192, 21230, 21268, 21307,
+	21345, 21383, 21421, 21459, 21497, 21535,
+	21573, 21611, 21648, 21686, 21724, 21761,
+	21799, 21836, 21874, 21911, 21949, 21986,
+	22023, 22060, 22097, 22135, 22172, 22209,
+	22245, 22282, 22319, 22356, 22393, 22429,
+	22466, 22503, 22539, 22575, 22612, 22648,
+	22685, 22721, 22757, 22793, 22829, 22865,
+	22901, 22937, 22973, 23009, 23045, 23080,
+	23116, 23151, 23187, 23223, 23258, 23293,
+	23329, 23364, 23399, 23434, 23469, 23504,
+	23539, 23574, 23609, 23644, 23679, 23714,
+	23748, 23783, 23817, 23852, 23886, 23921,
+	23955, 23989, 24023, 24058, 24092, 24126,
+	24160, 24194, 24228, 24261, 24295, 24329,
+	24362, 24396, 24430, 24463, 24496, 24530,
+	24563, 24596, 24630, 24663, 24696, 24729,
+	24762, 24795, 24827, 24860, 24893, 24926,
+	24958, 24991, 25023, 25056, 25088, 25120,
+	25152, 25185, 25217, 25249, 25281, 25313,
+	25345, 25376, 25408, 25440, 25472, 25503,
+	25535, 25566, 25598, 25629, 25660, 25691,
+	25723, 25754, 25785, 25816, 25847, 25878,
+	25908, 25939, 25970, 26000, 26031, 26061,
+	26092, 26122, 26153, 26183, 26213, 26243,
+	26273, 26303, 26333, 26363, 26393, 26423,
+	26452, 26482, 26512, 26541, 26570, 26600,
+	26629, 26658, 26688, 26717, 26746, 26775,
+	26804, 26833, 26861, 26890, 26919, 26948,
+	26976, 27005, 27033, 27061, 27090, 27118,
+	27146, 27174, 27202, 27230, 27258, 27286,
+	27314, 27342, 27369, 27397, 27424, 27452,
+	27479, 27507, 27534, 27561, 27588, 27615,
+	27642, 27669, 27696, 27723, 27750, 27777,
+	27803, 27830, 27856, 27883, 27909, 27935,
+	27962, 27988, 28014, 28040, 28066, 28092,
+	28118, 28143, 28169, 28195, 28220, 28246,
+	28271, 28297, 28322, 28347, 28372, 28397,
+	28423, 28447, 28472, 28497, 28522, 28547,
+	28571, 28596, 28620, 28645, 28669, 28694,
+	28718, 28742, 28766, 28790, 28814, 28838,
+	28862, 28886, 28909, 28933, 28956, 28980,
+	29003, 29027, 29050, 29073, 29096, 29119,
+	29142, 29165, 29188, 29211, 29234, 29256,
+	29279, 29302, 29324, 29346, 29369, 29391,
+	29413, 29435, 29457, 29479, 29501, 29523,
+	29545, 29567, 29588, 29610, 29631, 29653,
+	29674, 29695, 29717, 29738, 29759, 29780,
+	29801, 29822, 29842, 29863, 29884, 29904,
+	29925, 29945, 29966, 29986, 30006, 30026,
+	30046, 30066, 30086, 30106, 30126, 30146,
+	30165, 30185, 30205, 30224, 30243, 30263,
+	30282, 30301, 30320, 30339, 30358, 30377,
+	30396, 30415, 30433, 30452, 30470, 30489,
+	30507, 30525, 30544, 30562, 30580, 30598,
+	30616, 30634, 30652, 30669, 30687, 30705,
+	30722, 30739, 30757, 30774, 30791, 30809,
+	30826, 30843, 30860, 30876, 30893, 30910,
+	30927, 30943, 30960, 30976, 30992, 31009,
+	31025, 31041, 31057, 31073, 31089, 31105,
+	31121, 31136, 31152, 31167, 31183, 31198,
+	31214, 31229, 31244, 31259, 31274, 31289,
+	31304, 31319, 31334, 31348, 31363, 31377,
+	31392, 31406, 31420, 31435, 31449, 31463,
+	31477, 31491, 31505, 31518, 31532, 31546,
+	31559, 31573, 31586, 31600, 31613, 31626,
+	31639, 31652, 31665, 31678, 31691, 31704,
+	31716, 31729, 31741, 31754, 31766, 31778,
+	31791, 31803, 31815, 31827, 31839, 31851,
+	31862, 31874, 31886, 31897, 31909, 31920,
+	31931, 31943, 31954, 31965, 31976, 31987,
+	31998, 32008, 32019, 32030, 32040, 32051,
+	32061, 32072, 32082, 32092, 32102, 32112,
+	32122, 32132, 32142, 32152, 32161, 32171,
+	32180, 32190, 32199, 32208, 32218, 32227,
+	32236, 32245, 32254, 32262, 32271, 32280,
+	32288, 32297, 32305, 32314, 32322, 32330,
+	32338, 32346, 32354, 32362, 32370, 32378,
+	32386, 32393, 32401, 32408, 32416, 32423,
+	32430, 32437, 32444, 32451, 32458, 32465,
+	32472, 32478, 32485, 32492, 32498, 32504,
+	32511, 32517, 32523, 32529, 32535, 32541,
+	32547, 32553, 32558, 32564, 32570, 32575,
+	32580, 32586, 32591, 32596, 32601, 32606,
+	32611, 32616, 32621, 32625, 32630, 32635,
+	32639, 32644, 32648, 32652, 32656, 32660,
+	32664, 32668, 32672, 32676, 32680, 32683,
+	32687, 32690, 32694, 32697, 32700, 32703,
+	32706, 32709, 32712, 32715, 32718, 32721,
+	32723, 32726, 32728, 32731, 32733, 32735,
+	32737, 32739, 32741, 32743, 32745, 32747,
+	32749, 32750, 32752, 32753, 32755, 32756,
+	32757, 32758, 32759, 32760, 32761, 32762,
+	32763, 32764, 32764, 32765, 32765, 32766,
+	32766, 32766, 32766, 32766
+};
+
+//
+// qtrlanes_sin
+//
+// Returns what qtrlanes.v would produce in o_val, sign extended, 3 clocks
+// after i_phase is given to it.
+//
+static inline int32_t	qtrlanes_sin(uint32_t i_phase) {
+	uint32_t	index;
+	int64_t		v;
+
+	index = i_phase & ((1u<<(QTRLANES_PW-2))-1);
+	if ((i_phase >> (QTRLANES_PW-2))&1)
+		index = (~index) & ((1u<<(QTRLANES_PW-2))-1);
+	v = qtrlanes_tbl[index];
+	if ((i_phase >> (QTRLANES_PW-1))&1)
+		v = -v;
+	return (int32_t)mdl_sext(v, QTRLANES_OW);
+}
+
+#endif	// QTRLANES_MODEL_H
@@ -42,11 +42,12 @@
 const	int	OW         = 24; // bits
 const	int	NEXTRA     = 3; // bits
 const	int	PW         = 26; // bits
+const	int	LATENCY    = 6; // clocks
 const	long	TBL_LGSZ  = 9; // (Units)
 const	long	TBL_SZ    = 512; // (Units)
 const	long	SCALE     = 8388606; // (Units)
-const	double	ITBL_ERR  = -0.99; // (OW Units)
-const	double	TBL_ERR   = -0.0000000074027647; // (sin Units)
+const	double	ITBL_ERR  = 0.65; // (OW+NEXTRA Units)
+const	double	TBL_ERR   = 0.0000000048129817; // (sin Units)
 const	double	SPURDB    = -162.51; // dB
 const	bool	HAS_RESET = true;
 const	bool	HAS_AUX   = true;
@@ -51,7 +51,7 @@ module	quadtbl(i_clk, i_reset, i_ce,  i_aux,i_phase, o_sin, o_aux);
 	output	reg				o_aux;
 
 	localparam	LGTBL=9,
-			DXBITS= (PW-LGTBL)+1,    // 16
+			DXBITS= (PW-LGTBL)+1,    // 18
 			TBLENTRIES = (1<<LGTBL), // 512
 			QBITS = 14,
 			LBITS = 21,
@@ -111,12 +111,12 @@ module	quadtbl(i_clk, i_reset, i_ce,  i_aux,i_phase, o_sin, o_aux);
 	// the Q, L, and C values.
 
 	// Clock 1
-	reg	signed	[(QBITS+DXBITS-1):0]	qprod; // [29:0]
+	reg	signed	[(QBITS+DXBITS-1):0]	qprod; // [31:0]
 	always @(posedge i_clk)
 	if (i_reset)
 		qprod <= 0;
 	else  if (i_ce)
-		qprod <= qv * dx; // 30 bits
+		qprod <= qv * dx; // 32 bits
 
 	initial	cv_1 = 0;
 	initial	lv_1 = 0;
@@ -138,7 +138,7 @@ module	quadtbl(i_clk, i_reset, i_ce,  i_aux,i_phase, o_sin, o_aux);
 	wire	[(LBITS-1):0]	w_qprod;
 	assign	w_qprod[(LBITS-1):(QBITS+1)] = { (6){qprod[(QBITS+DXBITS-1)]} };
 	assign	w_qprod[QBITS:0] // 15
-			= qprod[(QBITS+DXBITS-1):(DXBITS-1)]; // [29:15]
+			= qprod[(QBITS+DXBITS-1):(DXBITS-1)]; // [31:17]
 	always @(posedge i_clk)
 	if (i_reset)
 		lsum <= 0;
@@ -155,13 +155,13 @@ module	quadtbl(i_clk, i_reset, i_ce,  i_aux,i_phase, o_sin, o_aux);
 		dx_2 <= dx_1;
 	end
 
-	// Clock 2
+	// Clock 3
 	reg	signed	[(LBITS+DXBITS-1):0]	lprod;
 	always @(posedge i_clk)
 	if (i_reset)
 		lprod <= 0;
 	else if (i_ce)
-		lprod <= lsum * dx_2; // 38 bits
+		lprod <= lsum * dx_2; // 40 bits
 
 	initial	cv_3 = 0;
 	always @(posedge i_clk)
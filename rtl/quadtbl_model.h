@@ -0,0 +1,415 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename: 	quadtbl_model.h
+//
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	This is a bit-accurate C++ software model of the core
+//		found in the Verilog file of the same name.  It was generated
+//	from the same parameters as that core, and should produce
+//	identical outputs for identical inputs.  Call it in place of
+//	running Verilator when you need the core's exact outputs at native
+//	speed.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2017-2018, Gisselquist Technology, LLC
+//
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+//
+// License:	GPL, v3, as defined and found on www.gnu.org,
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+//
+#ifndef	QUADTBL_MODEL_H
+#define	QUADTBL_MODEL_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifndef	GENCORDIC_MODEL_HELPERS
+#define	GENCORDIC_MODEL_HELPERS
+//
+// mdl_sext
+//
+// Sign extend the bottom w bits of v, dropping everything above them.
+// This captures the wrap-around of a w-bit Verilog register.
+static inline int64_t	mdl_sext(int64_t v, int w) {
+	return (int64_t)((uint64_t)v << (64-w)) >> (64-w);
+}
+
+//
+// mdl_shl
+//
+// A left shift, done unsigned so that it's defined even when v is
+// negative.
+static inline int64_t	mdl_shl(int64_t v, int s) {
+	return (int64_t)((uint64_t)v << s);
+}
+
+//
+// mdl_asr
+//
+// An arithmetic right shift that, like Verilog's >>>, doesn't mind
+// shifting by more bits than are in the word.
+static inline int64_t	mdl_asr(int64_t v, int s) {
+	return (s >= 63) ? ((v < 0) ? -1 : 0) : (v >> s);
+}
+
+//
+// mdl_round
+//
+// Drop a ww bit value down to ow bits.  If more than one bit is
+// dropped, round towards even first, just like the generated cores do.
+static inline int64_t	mdl_round(int64_t v, int ww, int ow) {
+	int	drop = ww - ow;
+
+	if (drop > 1) {
+		int64_t	half = (1ll<<(drop-1));
+
+		v += ((v >> drop)&1) ? half : (half-1);
+	}
+	return mdl_sext(v >> drop, ow);
+}
+#endif	// GENCORDIC_MODEL_HELPERS
+
+static const int	QUADTBL_PW = 26,	// Bits in our phase variable
+		QUADTBL_OW = 24,	// The number of output bits to produce
+		QUADTBL_XTRA = 3,	// Extra bits for internal precision
+		QUADTBL_LGTBL = 9,
+		QUADTBL_DXBITS = 18,
+		QUADTBL_QBITS = 14,
+		QUADTBL_LBITS = 21,
+		QUADTBL_CBITS = 27,
+		QUADTBL_WW = 27,	// Working width
+		QUADTBL_LATENCY = 6;	// Clocks from input to output
+
+static const int32_t	quadtbl_ctbl[512] = {
+	0, 823528, 1646933, 2470090, 3292875, 4115164,
+	4936833, 5757759, 6577818, 7396886, 8214840, 9031557,
+	9846914, 10660788, 11473057, 12283597, 13092288, 13899008,
+	14703634, 15506046, 16306122, 17103743, 17898789, 18691138,
+	19480673, 20267274, 21050824, 21831202, 22608294, 23381980,
+	24152145, 24918673, 25681449, 26440356, 27195282, 27946113,
+	28692735, 29435036, 30172904, 30906228, 31634897, 32358803,
+	33077836, 33791887, 34500849, 35204616, 35903080, 36596138,
+	37283685, 37965617, 38641831, 39312227, 39976701, 40635156,
+	41287491, 41933608, 42573410, 43206801, 43833685, 44453968,
+	45067556, 45674357, 46274280, 46867234, 47453130, 48031880,
+	48603397, 49167593, 49724386, 50273690, 50815423, 51349504,
+	51875851, 52394386, 52905031, 53407708, 53902343, 54388859,
+	54867186, 55337249, 55798979, 56252305, 56697160, 57133477,
+	57561190, 57980234, 58390547, 58792066, 59184732, 59568484,
+	59943266, 60309020, 60665692, 61013228, 61351576, 61680684,
+	62000503, 62310986, 62612084, 62903754, 63185950, 63458631,
+	63721755, 63975283, 64219176, 64453399, 64677914, 64892690,
+	65097693, 65292892, 65478259, 65653765, 65819383, 65975090,
+	66120861, 66256674, 66382509, 66498348, 66604172, 66699965,
+	66785714, 66861405, 66927027, 66982570, 67028026, 67063387,
+	67088650, 67103808, 67108862, 67103808, 67088650, 67063388,
+	67028026, 66982570, 66927027, 66861405, 66785714, 66699965,
+	66604172, 66498348, 66382509, 66256674, 66120861, 65975090,
+	65819384, 65653765, 65478259, 65292893, 65097693, 64892690,
+	64677915, 64453399, 64219177, 63975283, 63721755, 63458631,
+	63185950, 62903754, 62612085, 62310986, 62000504, 61680684,
+	61351576, 61013228, 60665692, 60309020, 59943266, 59568485,
+	59184732, 58792067, 58390548, 57980235, 57561191, 57133478,
+	56697161, 56252306, 55798979, 55337250, 54867186, 54388860,
+	53902343, 53407709, 52905032, 52394387, 51875852, 51349504,
+	50815424, 50273691, 49724387, 49167594, 48603397, 48031881,
+	47453131, 46867235, 46274281, 45674358, 45067557, 44453969,
+	43833686, 43206802, 42573411, 41933609, 41287492, 40635157,
+	39976702, 39312228, 38641832, 37965618, 37283686, 36596139,
+	35903081, 35204617, 34500850, 33791888, 33077837, 32358804,
+	31634899, 30906229, 30172905, 29435037, 28692736, 27946114,
+	27195284, 26440358, 25681450, 24918674, 24152146, 23381981,
+	22608295, 21831204, 21050825, 20267276, 19480674, 18691140,
+	17898790, 17103745, 16306123, 15506047, 14703635, 13899009,
+	13092290, 12283599, 11473058, 10660789, 9846915, 9031558,
+	8214841, 7396887, 6577819, 5757760, 4936834, 4115165,
+	3292876, 2470091, 1646934, 823529, 0, -823528,
+	-1646933, -2470090, -3292875, -4115164, -4936833, -5757759,
+	-6577818, -7396886, -8214840, -9031557, -9846914, -10660788,
+	-11473057, -12283597, -13092288, -13899008, -14703634, -15506046,
+	-16306122, -17103743, -17898789, -18691138, -19480673, -20267274,
+	-21050824, -21831202, -22608294, -23381980, -24152145, -24918673,
+	-25681449, -26440356, -27195282, -27946113, -28692735, -29435036,
+	-30172904, -30906228, -31634897, -32358803, -33077836, -33791887,
+	-34500849, -35204616, -35903080, -36596138, -37283685, -37965617,
+	-38641831, -39312227, -39976701, -40635156, -41287491, -41933608,
+	-42573410, -43206801, -43833685, -44453968, -45067556, -45674357,
+	-46274280, -46867234, -47453130, -48031880, -48603397, -49167593,
+	-49724386, -50273690, -50815423, -51349504, -51875851, -52394386,
+	-52905031, -53407708, -53902343, -54388859, -54867186, -55337249,
+	-55798979, -56252305, -56697160, -57133477, -57561190, -57980234,
+	-58390547, -58792066, -59184732, -59568484, -59943266, -60309020,
+	-60665692, -61013228, -61351576, -61680684, -62000503, -62310986,
+	-62612084, -62903754, -63185950, -63458631, -63721755, -63975283,
+	-64219176, -64453399, -64677914, -64892690, -65097693, -65292892,
+	-65478259, -65653765, -65819383, -65975090, -66120861, -66256674,
+	-66382509, -66498348, -66604172, -66699965, -66785714, -66861405,
+	-66927027, -66982570, -67028026, -67063387, -67088650, -67103808,
+	-67108862, -67103808, -67088650, -67063388, -67028026, -66982570,
+	-66927027, -66861405, -66785714, -66699965, -66604172, -66498348,
+	-66382509, -66256674, -66120861, -65975090, -65819384, -65653765,
+	-65478259, -65292893, -65097693, -64892690, -64677915, -64453399,
+	-64219177, -63975283, -63721755, -63458631, -63185950, -62903754,
+	-62612085, -62310986, -62000504, -61680684, -61351576, -61013228,
+	-60665692, -60309020, -59943266, -59568485, -59184732, -58792067,
+	-58390548, -57980235, -57561191, -57133478, -56697161, -56252306,
+	-55798979, -55337250, -54867186, -54388860, -53902343, -53407709,
+	-52905032, -52394387, -51875852, -51349504, -50815424, -50273691,
+	-49724387, -49167594, -48603397, -48031881, -47453131, -46867235,
+	-46274281, -45674358, -45067557, -44453969, -43833686, -43206802,
+	-42573411, -41933609, -41287492, -40635157, -39976702, -39312228,
+	-38641832, -37965618, -37283686, -36596139, -35903081, -35204617,
+	-34500850, -33791888, -33077837, -32358804, -31634899, -30906229,
+	-30172905, -29435037, -28692736, -27946114, -27195284, -26440358,
+	-25681450, -24918674, -24152146, -23381981, -22608295, -21831204,
+	-21050825, -20267276, -19480674, -18691140, -17898790, -17103745,
+	-16306123, -15506047, -14703635, -13899009, -13092290, -12283599,
+	-11473058, -10660789, -9846915, -9031558, -8214841, -7396887,
+	-6577819, -5757760, -4936834, -4115165, -3292876, -2470091,
+	-1646934, -823529
+};
+
+static const int32_t	quadtbl_ltbl[512] = {
+	823561, 823499, 823313, 823003, 822569, 822011,
+	821329, 820524, 819595, 818543, 817367, 816069,
+	814647, 813103, 811436, 809647, 807736, 805704,
+	803550, 801275, 798880, 796364, 793728, 790973,
+	788098, 785105, 781994, 778765, 775419, 771956,
+	768376, 764681, 760871, 756946, 752907, 748755,
+	744490, 740113, 735624, 731025, 726316, 721497,
+	716569, 711534, 706392, 701143, 695788, 690329,
+	684766, 679099, 673331, 667461, 661490, 655420,
+	649251, 642984, 636621, 630162, 623607, 616959,
+	610218, 603385, 596461, 589448, 582345, 575155,
+	567878, 560516, 553069, 545539, 537927, 530234,
+	522461, 514610, 506680, 498675, 490594, 482440,
+	474213, 465914, 457546, 449108, 440603, 432031,
+	423395, 414694, 405931, 397107, 388224, 379281,
+	370282, 361227, 352117, 342955, 333740, 324476,
+	315163, 305802, 296395, 286944, 277449, 267912,
+	258336, 248720, 239067, 229377, 219654, 209897,
+	200109, 190290, 180443, 170568, 160668, 150744,
+	140797, 130829, 120841, 110835, 100812, 90774,
+	80723, 70659, 60584, 50501, 40410, 30312,
+	20211, 10106, 0, -10106, -20211, -30313,
+	-40410, -50501, -60584, -70659, -80723, -90774,
+	-100812, -110835, -120841, -130829, -140797, -150744,
+	-160668, -170568, -180443, -190290, -200109, -209897,
+	-219654, -229378, -239067, -248720, -258336, -267913,
+	-277449, -286944, -296395, -305802, -315163, -324476,
+	-333741, -342955, -352117, -361227, -370282, -379281,
+	-388224, -397107, -405931, -414694, -423395, -432031,
+	-440603, -449108, -457546, -465914, -474213, -482440,
+	-490594, -498675, -506680, -514610, -522461, -530234,
+	-537927, -545540, -553069, -560516, -567878, -575155,
+	-582345, -589448, -596461, -603385, -610218, -616959,
+	-623607, -630162, -636621, -642984, -649251, -655420,
+	-661490, -667461, -673331, -679099, -684766, -690329,
+	-695788, -701143, -706392, -711534, -716569, -721497,
+	-726316, -731025, -735624, -740113, -744490, -748755,
+	-752907, -756946, -760871, -764681, -768376, -771956,
+	-775419, -778765, -781994, -785105, -788099, -790973,
+	-793728, -796364, -798880, -801275, -803550, -805704,
+	-807736, -809647, -811436, -813103, -814647, -816069,
+	-817367, -818543, -819595, -820524, -821329, -822011,
+	-822569, -823003, -823313, -823499, -823561, -823499,
+	-823313, -823003, -822569, -822011, -821329, -820524,
+	-819595, -818543, -817367, -816069, -814647, -813103,
+	-811436, -809647, -807736, -805704, -803550, -801275,
+	-798880, -796364, -793728, -790973, -788098, -785105,
+	-781994, -778765, -775419, -771956, -768376, -764681,
+	-760871, -756946, -752907, -748755, -744490, -740113,
+	-735624, -731025, -726316, -721497, -716569, -711534,
+	-706392, -701143, -695788, -690329, -684766, -679099,
+	-673331, -667461, -661490, -655420, -649251, -642984,
+	-636621, -630162, -623607, -616959, -610218, -603385,
+	-596461, -589448, -582345, -575155, -567878, -560516,
+	-553069, -545539, -537927, -530234, -522461, -514610,
+	-506680, -498675, -490594, -482440, -474213, -465914,
+	-457546, -449108, -440603, -432031, -423395, -414694,
+	-405931, -397107, -388224, -379281, -370282, -361227,
+	-352117, -342955, -333740, -324476, -315163, -305802,
+	-296395, -286944, -277449, -267912, -258336, -248720,
+	-239067, -229377, -219654, -209897, -200109, -190290,
+	-180443, -170568, -160668, -150744, -140797, -130829,
+	-120841, -110835, -100812, -90774, -80723, -70659,
+	-60584, -50501, -40410, -30312, -20211, -10106,
+	0, 10106, 20211, 30313, 40410, 50501,
+	60584, 70659, 80723, 90774, 100812, 110835,
+	120841, 130829, 140797, 150744, 160668, 170568,
+	180443, 190290, 200109, 209897, 219654, 229378,
+	239067, 248720, 258336, 267913, 277449, 286944,
+	296395, 305802, 315163, 324476, 333741, 342955,
+	352117, 361227, 370282, 379281, 388224, 397107,
+	405931, 414694, 423395, 432031, 440603, 449108,
+	457546, 465914, 474213, 482440, 490594, 498675,
+	506680, 514610, 522461, 530234, 537927, 545540,
+	553069, 560516, 567878, 575155, 582345, 589448,
+	596461, 603385, 610218, 616959, 623607, 630162,
+	636621, 642984, 649251, 655420, 661490, 667461,
+	673331, 679099, 684766, 690329, 695788, 701143,
+	706392, 711534, 716569, 721497, 726316, 731025,
+	735624, 740113, 744490, 748755, 752907, 756946,
+	760871, 764681, 768376, 771956, 775419, 778765,
+	781994, 785105, 788099, 790973, 793728, 796364,
+	798880, 801275, 803550, 805704, 807736, 809647,
+	811436, 813103, 814647, 816069, 817367, 818543,
+	819595, 820524, 821329, 822011, 822569, 823003,
+	823313, 823499
+};
+
+static const int32_t	quadtbl_qtbl[512] = {
+	-31, -93, -155, -216, -278, -340,
+	-402, -464, -526, -587, -649, -710,
+	-772, -833, -894, -955, -1016, -1076,
+	-1137, -1197, -1257, -1317, -1377, -1437,
+	-1496, -1555, -1614, -1673, -1731, -1789,
+	-1847, -1905, -1962, -2019, -2076, -2132,
+	-2188, -2244, -2299, -2354, -2409, -2463,
+	-2517, -2571, -2624, -2677, -2729, -2781,
+	-2833, -2884, -2934, -2985, -3035, -3084,
+	-3133, -3181, -3229, -3277, -3324, -3370,
+	-3416, -3461, -3506, -3551, -3595, -3638,
+	-3681, -3723, -3764, -3806, -3846, -3886,
+	-3925, -3964, -4002, -4040, -4077, -4113,
+	-4149, -4184, -4218, -4252, -4285, -4318,
+	-4350, -4381, -4411, -4441, -4471, -4499,
+	-4527, -4554, -4581, -4607, -4632, -4656,
+	-4680, -4703, -4725, -4747, -4768, -4788,
+	-4807, -4826, -4844, -4861, -4878, -4894,
+	-4909, -4923, -4937, -4949, -4962, -4973,
+	-4984, -4993, -5002, -5011, -5018, -5025,
+	-5031, -5037, -5041, -5045, -5048, -5050,
+	-5052, -5053, -5053, -5052, -5050, -5048,
+	-5045, -5041, -5037, -5031, -5025, -5018,
+	-5011, -5002, -4993, -4984, -4973, -4962,
+	-4949, -4937, -4923, -4909, -4894, -4878,
+	-4861, -4844, -4826, -4807, -4788, -4768,
+	-4747, -4725, -4703, -4680, -4656, -4632,
+	-4607, -4581, -4554, -4527, -4499, -4471,
+	-4441, -4411, -4381, -4350, -4318, -4285,
+	-4252, -4218, -4184, -4149, -4113, -4077,
+	-4040, -4002, -3964, -3925, -3886, -3846,
+	-3806, -3764, -3723, -3681, -3638, -3595,
+	-3551, -3506, -3461, -3416, -3370, -3324,
+	-3277, -3229, -3181, -3133, -3084, -3035,
+	-2985, -2934, -2884, -2833, -2781, -2729,
+	-2677, -2624, -2571, -2517, -2463, -2409,
+	-2354, -2299, -2244, -2188, -2132, -2076,
+	-2019, -1962, -1905, -1847, -1789, -1731,
+	-1673, -1614, -1555, -1496, -1437, -1377,
+	-1317, -1257, -1197, -1137, -1076, -1016,
+	-955, -894, -833, -772, -710, -649,
+	-587, -526, -464, -402, -340, -278,
+	-216, -155, -93, -31, 31, 93,
+	155, 216, 278, 340, 402, 464,
+	526, 587, 649, 710, 772, 833,
+	894, 955, 1016, 1076, 1137, 1197,
+	1257, 1317, 1377, 1437, 1496, 1555,
+	1614, 1673, 1731, 1789, 1847, 1905,
+	1962, 2019, 2076, 2132, 2188, 2244,
+	2299, 2354, 2409, 2463, 2517, 2571,
+	2624, 2677, 2729, 2781, 2833, 2884,
+	2934, 2985, 3035, 3084, 3133, 3181,
+	3229, 3277, 3324, 3370, 3416, 3461,
+	3506, 3551, 3595, 3638, 3681, 3723,
+	3764, 3806, 3846, 3886, 3925, 3964,
+	4002, 4040, 4077, 4113, 4149, 4184,
+	4218, 4252, 4285, 4318, 4350, 4381,
+	4411, 4441, 4471, 4499, 4527, 4554,
+	4581, 4607, 4632, 4656, 4680, 4703,
+	4725, 4747, 4768, 4788, 4807, 4826,
+	4844, 4861, 4878, 4894, 4909, 4923,
+	4937, 4949, 4962, 4973, 4984, 4993,
+	5002, 5011, 5018, 5025, 5031, 5037,
+	5041, 5045, 5048, 5050, 5052, 5053,
+	5053, 5052, 5050, 5048, 5045, 5041,
+	5037, 5031, 5025, 5018, 5011, 5002,
+	4993, 4984, 4973, 4962, 4949, 4937,
+	4923, 4909, 4894, 4878, 4861, 4844,
+	4826, 4807, 4788, 4768, 4747, 4725,
+	4703, 4680, 4656, 4632, 4607, 4581,
+	4554, 4527, 4499, 4471, 4441, 4411,
+	4381, 4350, 4318, 4285, 4252, 4218,
+	4184, 4149, 4113, 4077, 4040, 4002,
+	3964, 3925, 3886, 3846, 3806, 3764,
+	3723, 3681, 3638, 3595, 3551, 3506,
+	3461, 3416, 3370, 3324, 3277, 3229,
+	3181, 3133, 3084, 3035, 2985, 2934,
+	2884, 2833, 2781, 2729, 2677, 2624,
+	2571, 2517, 2463, 2409, 2354, 2299,
+	2244, 2188, 2132, 2076, 2019, 1962,
+	1905, 1847, 1789, 1731, 1673, 1614,
+	1555, 1496, 1437, 1377, 1317, 1257,
+	1197, 1137, 1076, 1016, 955, 894,
+	833, 772, 710, 649, 587, 526,
+	464, 402, 340, 278, 216, 155,
+	93, 31
+};
+
+//
+// quadtbl_sin
+//
+// Returns what quadtbl.v would produce in o_sin 6 clocks after i_phase
+// is given to it.
+//
+//	Out = (Q*DX+L)*DX+C
+//
+static inline int32_t	quadtbl_sin(uint32_t i_phase) {
+	const	uint64_t	wmsk = (1ull<<QUADTBL_WW)-1;
+	uint32_t	idx;
+	int64_t		dx, qprod, lsum, lprod, r_value;
+	uint64_t	w_value;
+
+	idx = (i_phase >> (QUADTBL_DXBITS-1)) & ((1u<<QUADTBL_LGTBL)-1);
+	dx  = i_phase & ((1u<<(QUADTBL_DXBITS-1))-1);
+
+	qprod = (int64_t)quadtbl_qtbl[idx] * dx;
+	lsum  = mdl_sext(qprod >> (QUADTBL_DXBITS-1), QUADTBL_QBITS+1);
+	lsum  = mdl_sext(lsum + quadtbl_ltbl[idx], QUADTBL_LBITS);
+	lprod = lsum * dx;
+	r_value = mdl_sext(lprod >> (QUADTBL_DXBITS-1), QUADTBL_LBITS+1);
+	r_value = mdl_sext(r_value + quadtbl_ctbl[idx], QUADTBL_CBITS);
+
+	// Round the output, unless doing so would overflow
+	w_value = (uint64_t)r_value & wmsk;
+	if ((!((w_value >> (QUADTBL_WW-1))&1))
+			&&(((w_value >> QUADTBL_XTRA) | (~0ull << (QUADTBL_WW-1-QUADTBL_XTRA)))
+				== ~0ull))
+		;
+	else if (((w_value >> (QUADTBL_WW-2)) == 3)
+			&&(((w_value >> QUADTBL_XTRA)
+				& ((1ull<<(QUADTBL_WW-2-QUADTBL_XTRA))-1)) == 0))
+		;
+	else if ((w_value >> QUADTBL_XTRA)&1)
+		w_value = (w_value + (1ull<<(QUADTBL_XTRA-1))) & wmsk;
+	else
+		w_value = (w_value + (1ull<<(QUADTBL_XTRA-1))-1) & wmsk;
+
+	return (int32_t)mdl_sext((int64_t)(w_value >> QUADTBL_XTRA), QUADTBL_OW);
+}
+
+#endif	// QUADTBL_MODEL_H
@@ -0,0 +1,807 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename: 	quarterwav_model.h
+//
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	This is a bit-accurate C++ software model of the core
+//		found in the Verilog file of the same name.  It was generated
+//	from the same parameters as that core, and should produce
+//	identical outputs for identical inputs.  Call it in place of
+//	running Verilator when you need the core's exact outputs at native
+//	speed.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2017-2018, Gisselquist Technology, LLC
+//
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+//
+// License:	GPL, v3, as defined and found on www.gnu.org,
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+//
+#ifndef	QUARTERWAV_MODEL_H
+#define	QUARTERWAV_MODEL_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifndef	GENCORDIC_MODEL_HELPERS
+#define	GENCORDIC_MODEL_HELPERS
+//
+// mdl_sext
+//
+// Sign extend the bottom w bits of v, dropping everything above them.
+// This captures the wrap-around of a w-bit Verilog register.
+static inline int64_t	mdl_sext(int64_t v, int w) {
+	return (int64_t)((uint64_t)v << (64-w)) >> (64-w);
+}
+
+//
+// mdl_shl
+//
+// A left shift, done unsigned so that it's defined even when v is
+// negative.
+static inline int64_t	mdl_shl(int64_t v, int s) {
+	return (int64_t)((uint64_t)v << s);
+}
+
+//
+// mdl_asr
+//
+// An arithmetic right shift that, like Verilog's >>>, doesn't mind
+// shifting by more bits than are in the word.
+static inline int64_t	mdl_asr(int64_t v, int s) {
+	return (s >= 63) ? ((v < 0) ? -1 : 0) : (v >> s);
+}
+
+//
+// mdl_round
+//
+// Drop a ww bit value down to ow bits.  If more than one bit is
+// dropped, round towards even first, just like the generated cores do.
+static inline int64_t	mdl_round(int64_t v, int ww, int ow) {
+	int	drop = ww - ow;
+
+	if (drop > 1) {
+		int64_t	half = (1ll<<(drop-1));
+
+		v += ((v >> drop)&1) ? half : (half-1);
+	}
+	return mdl_sext(v >> drop, ow);
+}
+#endif	// GENCORDIC_MODEL_HELPERS
+
+static const int	QUARTERWAV_PW = 14,	// Number of bits in the input phase
+		QUARTERWAV_OW = 24,	// Number of output bits
+		QUARTERWAV_LATENCY = 3;	// Clocks from input to output
+
+//
+// The quarter wave table, exactly as found in quarterwav.hex
+//
+static const int32_t	quarterwav_tbl[4096] = {
+	1608, 4825, 8042, 11259, 14476, 17693,
+	20910, 24127, 27344, 30561, 33778, 36995,
+	40212, 43429, 46646, 49863, 53079, 56296,
+	59513, 62730, 65947, 69164, 72381, 75598,
+	78815, 82031, 85248, 88465, 91682, 94899,
+	98115, 101332, 104549, 107766, 110982, 114199,
+	117416, 120632, 123849, 127066, 130282, 133499,
+	136716, 139932, 143149, 146365, 149582, 152798,
+	156015, 159231, 162447, 165664, 168880, 172096,
+	175313, 178529, 181745, 184961, 188178, 191394,
+	194610, 197826, 201042, 204258, 207474, 210690,
+	213906, 217122, 220338, 223554, 226770, 229985,
+	233201, 236417, 239633, 242848, 246064, 249280,
+	252495, 255711, 258926, 262142, 265357, 268572,
+	271788, 275003, 278218, 281433, 284649, 287864,
+	291079, 294294, 297509, 300724, 303939, 307153,
+	310368, 313583, 316798, 320012, 323227, 326442,
+	329656, 332871, 336085, 339299, 342514, 345728,
+	348942, 352156, 355371, 358585, 361799, 365013,
+	368227, 371440, 374654, 377868, 381082, 384295,
+	387509, 390722, 393936, 397149, 400363, 403576,
+	406789, 410002, 413215, 416429, 419642, 422854,
+	426067, 429280, 432493, 435706, 438918, 442131,
+	445343, 448556, 451768, 454980, 458193, 461405,
+	464617, 467829, 471041, 474253, 477464, 480676,
+	483888, 487099, 490311, 493522, 496734, 499945,
+	503156, 506367, 509579, 512790, 516001, 519211,
+	522422, 525633, 528843, 532054, 535265, 538475,
+	541685, 544895, 548106, 551316, 554526, 557736,
+	560945, 564155, 567365, 570574, 573784, 576993,
+	580203, 583412, 586621, 589830, 593039, 596248,
+	599457, 602666, 605874, 609083, 612291, 615500,
+	618708, 621916, 625124, 628332, 631540, 634748,
+	637956, 641163, 644371, 647578, 650785, 653993,
+	657200, 660407, 663614, 666821, 670028, 673234,
+	676441, 679647, 682854, 686060, 689266, 692472,
+	695678, 698884, 702090, 705295, 708501, 711706,
+	714912, 718117, 721322, 724527, 727732, 730937,
+	734141, 737346, 740551, 743755, 746959, 750163,
+	753367, 756571, 759775, 762979, 766182, 769386,
+	772589, 775793, 778996, 782199, 785402, 788604,
+	791807, 795010, 798212, 801414, 804617, 807819,
+	811021, 814223, 817424, 820626, 823828, 827029,
+	830230, 833431, 836632, 839833, 843034, 846235,
+	849435, 852635, 855836, 859036, 862236, 865436,
+	868636, 871835, 875035, 878234, 881433, 884632,
+	887831, 891030, 894229, 897428, 900626, 903824,
+	907023, 910221, 913419, 916616, 919814, 923012,
+	926209, 929406, 932603, 935800, 938997, 942194,
+	945390, 948587, 951783, 954979, 958175, 961371,
+	964567, 967762, 970958, 974153, 977348, 980543,
+	983738, 986933, 990128, 993322, 996516, 999710,
+	1002904, 1006098, 1009292, 1012485, 1015679, 1018872,
+	1022065, 1025258, 1028451, 1031644, 1034836, 1038028,
+	1041221, 1044413, 1047605, 1050796, 1053988, 1057179,
+	1060371, 1063562, 1066753, 1069943, 1073134, 1076324,
+	1079515, 1082705, 1085895, 1089085, 1092274, 1095464,
+	1098653, 1101843, 1105032, 1108220, 1111409, 1114598,
+	1117786, 1120974, 1124162, 1127350, 1130538, 1133726,
+	1136913, 1140100, 1143287, 1146474, 1149661, 1152847,
+	1156034, 1159220, 1162406, 1165592, 1168778, 1171963,
+	1175148, 1178334, 1181519, 1184704, 1187888, 1191073,
+	1194257, 1197441, 1200625, 1203809, 1206992, 1210176,
+	1213359, 1216542, 1219725, 1222908, 1226090, 1229273,
+	1232455, 1235637, 1238819, 1242000, 1245182, 1248363,
+	1251544, 1254725, 1257906, 1261086, 1264267, 1267447,
+	1270627, 1273806, 1276986, 1280165, 1283345, 1286524,
+	1289702, 1292881, 1296060, 1299238, 1302416, 1305594,
+	1308772, 1311949, 1315126, 1318303, 1321480, 1324657,
+	1327834, 1331010, 1334186, 1337362, 1340538, 1343713,
+	1346889, 1350064, 1353239, 1356414, 1359588, 1362762,
+	1365937, 1369111, 1372284, 1375458, 1378631, 1381804,
+	1384977, 1388150, 1391323, 1394495, 1397667, 1400839,
+	1404011, 1407182, 1410353, 1413525, 1416695, 1419866,
+	1423037, 1426207, 1429377, 1432547, 1435716, 1438886,
+	1442055, 1445224, 1448393, 1451561, 1454730, 1457898,
+	1461066, 1464233, 1467401, 1470568, 1473735, 1476902,
+	1480069, 1483235, 1486401, 1489567, 1492733, 1495899,
+	1499064, 1502229, 1505394, 1508559, 1511723, 1514887,
+	1518051, 1521215, 1524379, 1527542, 1530705, 1533868,
+	1537030, 1540193, 1543355, 1546517, 1549679, 1552840,
+	1556002, 1559163, 1562323, 1565484, 1568644, 1571805,
+	1574964, 1578124, 1581284, 1584443, 1587602, 1590760,
+	1593919, 1597077, 1600235, 1603393, 1606551, 1609708,
+	1612865, 1616022, 1619178, 1622335, 1625491, 1628647,
+	1631803, 1634958, 1638113, 1641268, 1644423, 1647577,
+	1650731, 1653885, 1657039, 1660193, 1663346, 1666499,
+	1669652, 1672804, 1675956, 1679108, 1682260, 1685412,
+	1688563, 1691714, 1694865, 1698015, 1701165, 1704315,
+	1707465, 1710615, 1713764, 1716913, 1720062, 1723210,
+	1726359, 1729507, 1732654, 1735802, 1738949, 1742096,
+	1745243, 1748389, 1751535, 1754681, 1757827, 1760973,
+	1764118, 1767263, 1770407, 1773552, 1776696, 1779840,
+	1782983, 1786127, 1789270, 1792413, 1795555, 1798697,
+	1801839, 1804981, 1808123, 1811264, 1814405, 1817546,
+	1820686, 1823826, 1826966, 1830106, 1833245, 1836384,
+	1839523, 1842662, 1845800, 1848938, 1852076, 1855213,
+	1858350, 1861487, 1864624, 1867760, 1870896, 1874032,
+	1877168, 1880303, 1883438, 1886573, 1889707, 1892841,
+	1895975, 1899109, 1902242, 1905375, 1908508, 1911640,
+	1914773, 1917905, 1921036, 1924168, 1927299, 1930429,
+	1933560, 1936690, 1939820, 1942950, 1946079, 1949208,
+	1952337, 1955466, 1958594, 1961722, 1964849, 1967977,
+	1971104, 1974230, 1977357, 1980483, 1983609, 1986735,
+	1989860, 1992985, 1996110, 1999234, 2002358, 2005482,
+	2008606, 2011729, 2014852, 2017975, 2021097, 2024219,
+	2027341, 2030462, 2033584, 2036704, 2039825, 2042945,
+	2046065, 2049185, 2052304, 2055423, 2058542, 2061661,
+	2064779, 2067897, 2071014, 2074131, 2077248, 2080365,
+	2083481, 2086597, 2089713, 2092829, 2095944, 2099059,
+	2102173, 2105287, 2108401, 2111515, 2114628, 2117741,
+	2120853, 2123966, 2127078, 2130189, 2133301, 2136412,
+	2139523, 2142633, 2145743, 2148853, 2151963, 2155072,
+	2158181, 2161289, 2164397, 2167505, 2170613, 2173720,
+	2176827, 2179934, 2183040, 2186146, 2189252, 2192357,
+	2195462, 2198567, 2201671, 2204775, 2207879, 2210982,
+	2214085, 2217188, 2220291, 2223393, 2226494, 2229596,
+	2232697, 2235798, 2238898, 2241998, 2245098, 2248198,
+	2251297, 2254396, 2257494, 2260592, 2263690, 2266787,
+	2269885, 2272981, 2276078, 2279174, 2282270, 2285365,
+	2288460, 2291555, 2294650, 2297744, 2300838, 2303931,
+	2307024, 2310117, 2313209, 2316301, 2319393, 2322485,
+	2325576, 2328666, 2331757, 2334847, 2337937, 2341026,
+	2344115, 2347204, 2350292, 2353380, 2356467, 2359555,
+	2362642, 2365728, 2368814, 2371900, 2374986, 2378071,
+	2381156, 2384240, 2387325, 2390408, 2393492, 2396575,
+	2399658, 2402740, 2405822, 2408904, 2411985, 2415066,
+	2418147, 2421227, 2424307, 2427386, 2430465, 2433544,
+	2436623, 2439701, 2442779, 2445856, 2448933, 2452010,
+	2455086, 2458162, 2461238, 2464313, 2467388, 2470462,
+	2473536, 2476610, 2479683, 2482757, 2485829, 2488902,
+	2491973, 2495045, 2498116, 2501187, 2504258, 2507328,
+	2510397, 2513467, 2516536, 2519604, 2522673, 2525741,
+	2528808, 2531875, 2534942, 2538008, 2541074, 2544140,
+	2547205, 2550270, 2553335, 2556399, 2559463, 2562526,
+	2565589, 2568652, 2571714, 2574776, 2577838, 2580899,
+	2583959, 2587020, 2590080, 2593139, 2596199, 2599258,
+	2602316, 2605374, 2608432, 2611489, 2614546, 2617603,
+	2620659, 2623715, 2626770, 2629825, 2632880, 2635934,
+	2638988, 2642041, 2645094, 2648147, 2651199, 2654251,
+	2657303, 2660354, 2663404, 2666455, 2669505, 2672554,
+	2675603, 2678652, 2681701, 2684749, 2687796, 2690843,
+	2693890, 2696937, 2699983, 2703028, 2706073, 2709118,
+	2712163, 2715207, 2718250, 2721293, 2724336, 2727379,
+	2730421, 2733462, 2736503, 2739544, 2742585, 2745625,
+	2748664, 2751703, 2754742, 2757781, 2760819, 2763856,
+	2766893, 2769930, 2772966, 2776002, 2779038, 2782073,
+	2785108, 2788142, 2791176, 2794209, 2797242, 2800275,
+	2803307, 2806339, 2809371, 2812402, 2815432, 2818462,
+	2821492, 2824522, 2827550, 2830579, 2833607, 2836635,
+	2839662, 2842689, 2845715, 2848741, 2851767, 2854792,
+	2857817, 2860841, 2863865, 2866889, 2869912, 2872934,
+	2875957, 2878978, 2882000, 2885021, 2888041, 2891061,
+	2894081, 2897100, 2900119, 2903138, 2906156, 2909173,
+	2912190, 2915207, 2918223, 2921239, 2924255, 2927270,
+	2930284, 2933298, 2936312, 2939325, 2942338, 2945350,
+	2948362, 2951374, 2954385, 2957396, 2960406, 2963416,
+	2966425, 2969434, 2972442, 2975450, 2978458, 2981465,
+	2984472, 2987478, 2990484, 2993489, 2996494, 2999499,
+	3002503, 3005507, 3008510, 3011513, 3014515, 3017517,
+	3020518, 3023519, 3026520, 3029520, 3032519, 3035519,
+	3038517, 3041516, 3044514, 3047511, 3050508, 3053504,
+	3056501, 3059496, 3062491, 3065486, 3068480, 3071474,
+	3074468, 3077460, 3080453, 3083445, 3086436, 3089428,
+	3092418, 3095408, 3098398, 3101387, 3104376, 3107365,
+	3110353, 3113340, 3116327, 3119313, 3122300, 3125285,
+	3128270, 3131255, 3134239, 3137223, 3140206, 3143189,
+	3146172, 3149154, 3152135, 3155116, 3158097, 3161077,
+	3164056, 3167035, 3170014, 3172992, 3175970, 3178947,
+	3181924, 3184900, 3187876, 3190852, 3193827, 3196801,
+	3199775, 3202749, 3205722, 3208694, 3211666, 3214638,
+	3217609, 3220580, 3223550, 3226520, 3229489, 3232458,
+	3235426, 3238394, 3241361, 3244328, 3247295, 3250261,
+	3253226, 3256191, 3259156, 3262120, 3265083, 3268046,
+	3271009, 3273971, 3276933, 3279894, 3282854, 3285815,
+	3288774, 3291733, 3294692, 3297650, 3300608, 3303565,
+	3306522, 3309479, 3312434, 3315390, 3318344, 3321299,
+	3324253, 3327206, 3330159, 3333111, 3336063, 3339015,
+	3341966, 3344916, 3347866, 3350815, 3353764, 3356713,
+	3359661, 3362608, 3365555, 3368502, 3371448, 3374393,
+	3377338, 3380283, 3383227, 3386170, 3389113, 3392056,
+	3394998, 3397939, 3400880, 3403821, 3406761, 3409700,
+	3412639, 3415578, 3418516, 3421453, 3424390, 3427327,
+	3430263, 3433198, 3436133, 3439067, 3442001, 3444935,
+	3447868, 3450800, 3453732, 3456664, 3459595, 3462525,
+	3465455, 3468384, 3471313, 3474241, 3477169, 3480097,
+	3483024, 3485950, 3488876, 3491801, 3494726, 3497650,
+	3500574, 3503497, 3506420, 3509342, 3512264, 3515185,
+	3518105, 3521026, 3523945, 3526864, 3529783, 3532701,
+	3535619, 3538536, 3541452, 3544368, 3547284, 3550199,
+	3553113, 3556027, 3558940, 3561853, 3564765, 3567677,
+	3570588, 3573499, 3576409, 3579319, 3582228, 3585137,
+	3588045, 3590953, 3593860, 3596766, 3599672, 3602578,
+	3605483, 3608387, 3611291, 3614194, 3617097, 3620000,
+	3622901, 3625803, 3628703, 3631603, 3634503, 3637402,
+	3640301, 3643199, 3646096, 3648993, 3651890, 3654786,
+	3657681, 3660576, 3663470, 3666364, 3669257, 3672149,
+	3675042, 3677933, 3680824, 3683715, 3686605, 3689494,
+	3692383, 3695271, 3698159, 3701046, 3703933, 3706819,
+	3709705, 3712590, 3715474, 3718358, 3721242, 3724124,
+	3727007, 3729888, 3732770, 3735650, 3738530, 3741410,
+	3744289, 3747168, 3750045, 3752923, 3755800, 3758676,
+	3761552, 3764427, 3767301, 3770175, 3773049, 3775922,
+	3778794, 3781666, 3784537, 3787408, 3790278, 3793148,
+	3796017, 3798885, 3801753, 3804621, 3807487, 3810354,
+	3813219, 3816085, 3818949, 3821813, 3824677, 3827539,
+	3830402, 3833263, 3836125, 3838985, 3841845, 3844705,
+	3847564, 3850422, 3853280, 3856137, 3858994, 3861850,
+	3864705, 3867560, 3870415, 3873269, 3876122, 3878975,
+	3881827, 3884678, 3887529, 3890380, 3893229, 3896079,
+	3898927, 3901775, 3904623, 3907470, 3910316, 3913162,
+	3916007, 3918852, 3921696, 3924540, 3927383, 3930225,
+	3933067, 3935908, 3938748, 3941588, 3944428, 3947267,
+	3950105, 3952943, 3955780, 3958617, 3961452, 3964288,
+	3967123, 3969957, 3972791, 3975624, 3978456, 3981288,
+	3984119, 3986950, 3989780, 3992610, 3995439, 3998267,
+	4001095, 4003922, 4006748, 4009574, 4012400, 4015225,
+	4018049, 4020873, 4023696, 4026518, 4029340, 4032161,
+	4034982, 4037802, 4040622, 4043440, 4046259, 4049076,
+	4051894, 4054710, 4057526, 4060341, 4063156, 4065970,
+	4068784, 4071597, 4074409, 4077221, 4080032, 4082842,
+	4085652, 4088462, 4091270, 4094079, 4096886, 4099693,
+	4102499, 4105305, 4108110, 4110915, 4113719, 4116522,
+	4119325, 4122127, 4124928, 4127729, 4130529, 4133329,
+	4136128, 4138927, 4141724, 4144522, 4147318, 4150114,
+	4152910, 4155705, 4158499, 4161292, 4164085, 4166878,
+	4169669, 4172460, 4175251, 4178041, 4180830, 4183619,
+	4186407, 4189194, 4191981, 4194767, 4197553, 4200338,
+	4203122, 4205906, 4208689, 4211472, 4214253, 4217035,
+	4219815, 4222595, 4225375, 4228154, 4230932, 4233709,
+	4236486, 4239262, 4242038, 4244813, 4247587, 4250361,
+	4253134, 4255907, 4258679, 4261450, 4264221, 4266991,
+	4269760, 4272529, 4275297, 4278065, 4280832, 4283598,
+	4286363, 4289128, 4291893, 4294657, 4297420, 4300182,
+	4302944, 4305705, 4308466, 4311226, 4313985, 4316744,
+	4319502, 4322259, 4325016, 4327772, 4330527, 4333282,
+	4336037, 4338790, 4341543, 4344295, 4347047, 4349798,
+	4352548, 4355298, 4358047, 4360796, 4363544, 4366291,
+	4369037, 4371783, 4374528, 4377273, 4380017, 4382760,
+	4385503, 4388245, 4390986, 4393727, 4396467, 4399207,
+	4401946, 4404684, 4407421, 4410158, 4412894, 4415630,
+	4418365, 4421099, 4423833, 4426566, 4429298, 4432030,
+	4434761, 4437491, 4440221, 4442950, 4445678, 4448406,
+	4451133, 4453859, 4456585, 4459310, 4462035, 4464758,
+	4467482, 4470204, 4472926, 4475647, 4478368, 4481088,
+	4483807, 4486525, 4489243, 4491960, 4494677, 4497393,
+	4500108, 4502823, 4505537, 4508250, 4510962, 4513674,
+	4516386, 4519096, 4521806, 4524515, 4527224, 4529932,
+	4532639, 4535346, 4538052, 4540757, 4543462, 4546166,
+	4548869, 4551571, 4554273, 4556975, 4559675, 4562375,
+	4565074, 4567773, 4570471, 4573168, 4575865, 4578561,
+	4581256, 4583950, 4586644, 4589337, 4592030, 4594722,
+	4597413, 4600103, 4602793, 4605482, 4608171, 4610859,
+	4613546, 4616232, 4618918, 4621603, 4624287, 4626971,
+	4629654, 4632336, 4635018, 4637699, 4640379, 4643059,
+	4645738, 4648416, 4651094, 4653771, 4656447, 4659122,
+	4661797, 4664471, 4667145, 4669818, 4672490, 4675161,
+	4677832, 4680502, 4683171, 4685840, 4688508, 4691175,
+	4693842, 4696507, 4699173, 4701837, 4704501, 4707164,
+	4709826, 4712488, 4715149, 4717810, 4720469, 4723128,
+	4725787, 4728444, 4731101, 4733757, 4736413, 4739067,
+	4741721, 4744375, 4747028, 4749680, 4752331, 4754981,
+	4757631, 4760281, 4762929, 4765577, 4768224, 4770870,
+	4773516, 4776161, 4778805, 4781449, 4784092, 4786734,
+	4789376, 4792016, 4794656, 4797296, 4799934, 4802572,
+	4805210, 4807846, 4810482, 4813117, 4815751, 4818385,
+	4821018, 4823650, 4826282, 4828913, 4831543, 4834173,
+	4836801, 4839429, 4842057, 4844683, 4847309, 4849934,
+	4852559, 4855183, 4857806, 4860428, 4863050, 4865670,
+	4868291, 4870910, 4873529, 4876147, 4878764, 4881381,
+	4883997, 4886612, 4889226, 4891840, 4894453, 4897065,
+	4899677, 4902288, 4904898, 4907507, 4910116, 4912724,
+	4915331, 4917938, 4920543, 4923148, 4925753, 4928356,
+	4930959, 4933561, 4936163, 4938764, 4941364, 4943963,
+	4946561, 4949159, 4951756, 4954353, 4956948, 4959543,
+	4962137, 4964731, 4967323, 4969915, 4972507, 4975097,
+	4977687, 4980276, 4982864, 4985452, 4988039, 4990625,
+	4993210, 4995795, 4998379, 5000962, 5003544, 5006126,
+	5008707, 5011287, 5013867, 5016445, 5019024, 5021601,
+	5024177, 5026753, 5029328, 5031903, 5034476, 5037049,
+	5039621, 5042192, 5044763, 5047333, 5049902, 5052470,
+	5055038, 5057605, 5060171, 5062737, 5065301, 5067865,
+	5070428, 5072991, 5075553, 5078113, 5080674, 5083233,
+	5085792, 5088350, 5090907, 5093463, 5096019, 5098574,
+	5101128, 5103682, 5106235, 5108786, 5111338, 5113888,
+	5116438, 5118987, 5121535, 5124082, 5126629, 5129175,
+	5131720, 5134265, 5136808, 5139351, 5141893, 5144435,
+	5146975, 5149515, 5152055, 5154593, 5157131, 5159667,
+	5162203, 5164739, 5167273, 5169807, 5172340, 5174873,
+	5177404, 5179935, 5182465, 5184994, 5187523, 5190050,
+	5192577, 5195104, 5197629, 5200154, 5202678, 5205201,
+	5207723, 5210245, 5212766, 5215286, 5217805, 5220324,
+	5222841, 5225358, 5227875, 5230390, 5232905, 5235419,
+	5237932, 5240444, 5242956, 5245467, 5247977, 5250486,
+	5252995, 5255502, 5258009, 5260516, 5263021, 5265526,
+	5268030, 5270533, 5273035, 5275537, 5278038, 5280538,
+	5283037, 5285535, 5288033, 5290530, 5293026, 5295521,
+	5298016, 5300510, 5303003, 5305495, 5307986, 5310477,
+	5312967, 5315456, 5317944, 5320432, 5322919, 5325405,
+	5327890, 5330374, 5332858, 5335341, 5337823, 5340304,
+	5342785, 5345264, 5347743, 5350221, 5352699, 5355175,
+	5357651, 5360126, 5362600, 5365074, 5367546, 5370018,
+	5372489, 5374959, 5377429, 5379898, 5382365, 5384833,
+	5387299, 5389764, 5392229, 5394693, 5397156, 5399618,
+	5402080, 5404541, 5407001, 5409460, 5411918, 5414376,
+	5416832, 5419288, 5421744, 5424198, 5426652, 5429104,
+	5431556, 5434007, 5436458, 5438907, 5441356, 5443804,
+	5446251, 5448698, 5451143, 5453588, 5456032, 5458475,
+	5460918, 5463359, 5465800, 5468240, 5470679, 5473117,
+	5475555, 5477992, 5480428, 5482863, 5485297, 5487731,
+	5490163, 5492595, 5495026, 5497457, 5499886, 5502315,
+	5504743, 5507170, 5509596, 5512021, 5514446, 5516870,
+	5519293, 5521715, 5524136, 5526557, 5528977, 5531396,
+	5533814, 5536231, 5538647, 5541063, 5543478, 5545892,
+	5548305, 5550718, 5553129, 5555540, 5557950, 5560359,
+	5562767, 5565175, 5567582, 5569988, 5572393, 5574797,
+	5577200, 5579603, 5582005, 5584406, 5586806, 5589205,
+	5591604, 5594001, 5596398, 5598794, 5601189, 5603584,
+	5605977, 5608370, 5610762, 5613153, 5615543, 5617933,
+	5620321, 5622709, 5625096, 5627482, 5629867, 5632252,
+	5634635, 5637018, 5639400, 5641781, 5644162, 5646541,
+	5648920, 5651298, 5653675, 5656051, 5658426, 5660801,
+	5663174, 5665547, 5667919, 5670290, 5672661, 5675030,
+	5677399, 5679767, 5682134, 5684500, 5686865, 5689229,
+	5691593, 5693956, 5696318, 5698679, 5701039, 5703399,
+	5705757, 5708115, 5710472, 5712828, 5715184, 5717538,
+	5719892, 5722244, 5724596, 5726947, 5729297, 5731647,
+	5733995, 5736343, 5738690, 5741036, 5743381, 5745725,
+	5748069, 5750411, 5752753, 5755094, 5757434, 5759773,
+	5762112, 5764449, 5766786, 5769122, 5771457, 5773791,
+	5776124, 5778457, 5780788, 5783119, 5785449, 5787778,
+	5790106, 5792434, 5794760, 5797086, 5799410, 5801734,
+	5804057, 5806380, 5808701, 5811022, 5813341, 5815660,
+	5817978, 5820295, 5822611, 5824927, 5827241, 5829555,
+	5831868, 5834180, 5836491, 5838801, 5841110, 5843419,
+	5845727, 5848033, 5850339, 5852644, 5854949, 5857252,
+	5859555, 5861856, 5864157, 5866457, 5868756, 5871054,
+	5873351, 5875648, 5877943, 5880238, 5882532, 5884825,
+	5887117, 5889408, 5891699, 5893988, 5896277, 5898565,
+	5900852, 5903138, 5905423, 5907707, 5909991, 5912273,
+	5914555, 5916836, 5919116, 5921395, 5923673, 5925951,
+	5928227, 5930503, 5932778, 5935052, 5937325, 5939597,
+	5941868, 5944138, 5946408, 5948677, 5950944, 5953211,
+	5955477, 5957742, 5960007, 5962270, 5964532, 5966794,
+	5969055, 5971315, 5973574, 5975832, 5978089, 5980345,
+	5982601, 5984856, 5987109, 5989362, 5991614, 5993865,
+	5996115, 5998365, 6000613, 6002861, 6005107, 6007353,
+	6009598, 6011842, 6014085, 6016327, 6018569, 6020809,
+	6023049, 6025288, 6027525, 6029762, 6031998, 6034234,
+	6036468, 6038701, 6040934, 6043165, 6045396, 6047626,
+	6049855, 6052083, 6054310, 6056536, 6058762, 6060986,
+	6063210, 6065433, 6067654, 6069875, 6072095, 6074314,
+	6076533, 6078750, 6080966, 6083182, 6085397, 6087610,
+	6089823, 6092035, 6094246, 6096457, 6098666, 6100874,
+	6103082, 6105288, 6107494, 6109699, 6111903, 6114106,
+	6116308, 6118509, 6120709, 6122909, 6125107, 6127305,
+	6129502, 6131698, 6133892, 6136086, 6138280, 6140472,
+	6142663, 6144853, 6147043, 6149231, 6151419, 6153606,
+	6155792, 6157977, 6160161, 6162344, 6164526, 6166708,
+	6168888, 6171068, 6173246, 6175424, 6177601, 6179777,
+	6181952, 6184126, 6186299, 6188471, 6190642, 6192813,
+	6194982, 6197151, 6199319, 6201485, 6203651, 6205816,
+	6207980, 6210143, 6212306, 6214467, 6216627, 6218787,
+	6220945, 6223103, 6225260, 6227416, 6229571, 6231725,
+	6233878, 6236030, 6238181, 6240331, 6242481, 6244629,
+	6246777, 6248923, 6251069, 6253214, 6255358, 6257501,
+	6259643, 6261784, 6263924, 6266064, 6268202, 6270339,
+	6272476, 6274612, 6276746, 6278880, 6281013, 6283145,
+	6285276, 6287406, 6289535, 6291663, 6293790, 6295917,
+	6298042, 6300167, 6302290, 6304413, 6306535, 6308655,
+	6310775, 6312894, 6315012, 6317129, 6319246, 6321361,
+	6323475, 6325588, 6327701, 6329812, 6331923, 6334033,
+	6336141, 6338249, 6340356, 6342462, 6344567, 6346671,
+	6348774, 6350876, 6352977, 6355078, 6357177, 6359276,
+	6361373, 6363470, 6365565, 6367660, 6369754, 6371847,
+	6373939, 6376029, 6378119, 6380209, 6382297, 6384384,
+	6386470, 6388555, 6390640, 6392723, 6394806, 6396887,
+	6398968, 6401048, 6403126, 6405204, 6407281, 6409357,
+	6411432, 6413506, 6415579, 6417651, 6419722, 6421793,
+	6423862, 6425930, 6427998, 6430064, 6432130, 6434194,
+	6436258, 6438321, 6440382, 6442443, 6444503, 6446562,
+	6448620, 6450677, 6452733, 6454788, 6456842, 6458896,
+	6460948, 6462999, 6465049, 6467099, 6469147, 6471195,
+	6473241, 6475287, 6477332, 6479375, 6481418, 6483460,
+	6485501, 6487541, 6489580, 6491617, 6493655, 6495691,
+	6497726, 6499760, 6501793, 6503825, 6505857, 6507887,
+	6509916, 6511945, 6513972, 6515999, 6518024, 6520049,
+	6522072, 6524095, 6526117, 6528137, 6530157, 6532176,
+	6534194, 6536211, 6538227, 6540242, 6542256, 6544269,
+	6546281, 6548292, 6550302, 6552311, 6554320, 6556327,
+	6558333, 6560339, 6562343, 6564346, 6566349, 6568350,
+	6570351, 6572350, 6574349, 6576347, 6578343, 6580339,
+	6582334, 6584327, 6586320, 6588312, 6590303, 6592293,
+	6594282, 6596270, 6598257, 6600243, 6602228, 6604212,
+	6606195, 6608177, 6610158, 6612138, 6614117, 6616096,
+	6618073, 6620049, 6622024, 6623999, 6625972, 6627944,
+	6629916, 6631886, 6633856, 6635824, 6637792, 6639758,
+	6641724, 6643688, 6645652, 6647615, 6649576, 6651537,
+	6653497, 6655455, 6657413, 6659370, 6661326, 6663280,
+	6665234, 6667187, 6669139, 6671090, 6673040, 6674988,
+	6676936, 6678883, 6680829, 6682774, 6684718, 6686661,
+	6688603, 6690544, 6692484, 6694423, 6696362, 6698299,
+	6700235, 6702170, 6704104, 6706037, 6707969, 6709901,
+	6711831, 6713760, 6715688, 6717615, 6719542, 6721467,
+	6723391, 6725315, 6727237, 6729158, 6731078, 6732998,
+	6734916, 6736834, 6738750, 6740665, 6742580, 6744493,
+	6746405, 6748317, 6750227, 6752137, 6754045, 6755952,
+	6757859, 6759764, 6761669, 6763572, 6765475, 6767376,
+	6769277, 6771176, 6773075, 6774972, 6776869, 6778764,
+	6780659, 6782552, 6784445, 6786336, 6788227, 6790116,
+	6792005, 6793892, 6795779, 6797664, 6799549, 6801432,
+	6803315, 6805196, 6807077, 6808956, 6810835, 6812712,
+	6814589, 6816464, 6818339, 6820212, 6822085, 6823956,
+	6825827, 6827696, 6829564, 6831432, 6833298, 6835164,
+	6837028, 6838892, 6840754, 6842616, 6844476, 6846335,
+	6848194, 6850051, 6851908, 6853763, 6855617, 6857471,
+	6859323, 6861175, 6863025, 6864874, 6866723, 6868570,
+	6870416, 6872262, 6874106, 6875949, 6877791, 6879633,
+	6881473, 6883312, 6885150, 6886988, 6888824, 6890659,
+	6892493, 6894326, 6896158, 6897990, 6899820, 6901649,
+	6903477, 6905304, 6907130, 6908955, 6910779, 6912602,
+	6914424, 6916245, 6918065, 6919884, 6921702, 6923519,
+	6925335, 6927149, 6928963, 6930776, 6932588, 6934399,
+	6936208, 6938017, 6939825, 6941632, 6943437, 6945242,
+	6947046, 6948848, 6950650, 6952450, 6954250, 6956049,
+	6957846, 6959643, 6961438, 6963232, 6965026, 6966818,
+	6968610, 6970400, 6972189, 6973978, 6975765, 6977551,
+	6979336, 6981120, 6982904, 6984686, 6986467, 6988247,
+	6990026, 6991804, 6993581, 6995357, 6997132, 6998906,
+	7000679, 7002451, 7004221, 7005991, 7007760, 7009528,
+	7011294, 7013060, 7014825, 7016588, 7018351, 7020112,
+	7021873, 7023632, 7025391, 7027148, 7028905, 7030660,
+	7032414, 7034167, 7035920, 7037671, 7039421, 7041170,
+	7042918, 7044665, 7046411, 7048156, 7049900, 7051643,
+	7053385, 7055126, 7056866, 7058604, 7060342, 7062079,
+	7063815, 7065549, 7067283, 7069015, 7070747, 7072477,
+	7074207, 7075935, 7077662, 7079389, 7081114, 7082838,
+	7084561, 7086283, 7088004, 7089724, 7091443, 7093161,
+	7094878, 7096594, 7098309, 7100023, 7101736, 7103447,
+	7105158, 7106867, 7108576, 7110284, 7111990, 7113695,
+	7115400, 7117103, 7118805, 7120507, 7122207, 7123906,
+	7125604, 7127301, 7128997, 7130692, 7132386, 7134079,
+	7135771, 7137461, 7139151, 7140840, 7142527, 7144214,
+	7145899, 7147584, 7149267, 7150950, 7152631, 7154311,
+	7155990, 7157668, 7159345, 7161022, 7162696, 7164370,
+	7166043, 7167715, 7169386, 7171056, 7172724, 7174392,
+	7176058, 7177724, 7179388, 7181052, 7182714, 7184375,
+	7186035, 7187695, 7189353, 7191010, 7192666, 7194321,
+	7195975, 7197627, 7199279, 7200930, 7202579, 7204228,
+	7205875, 7207522, 7209167, 7210812, 7212455, 7214097,
+	7215738, 7217378, 7219017, 7220655, 7222292, 7223928,
+	7225563, 7227197, 7228829, 7230461, 7232091, 7233721,
+	7235349, 7236977, 7238603, 7240228, 7241852, 7243475,
+	7245097, 7246718, 7248338, 7249957, 7251575, 7253191,
+	7254807, 7256421, 7258035, 7259647, 7261259, 7262869,
+	7264478, 7266086, 7267693, 7269299, 7270904, 7272508,
+	7274111, 7275713, 7277313, 7278913, 7280511, 7282109,
+	7283705, 7285301, 7286895, 7288488, 7290080, 7291671,
+	7293261, 7294850, 7296438, 7298024, 7299610, 7301195,
+	7302778, 7304361, 7305942, 7307522, 7309101, 7310679,
+	7312257, 7313833, 7315407, 7316981, 7318554, 7320126,
+	7321696, 7323266, 7324834, 7326402, 7327968, 7329533,
+	7331097, 7332660, 7334222, 7335783, 7337343, 7338902,
+	7340459, 7342016, 7343571, 7345126, 7346679, 7348231,
+	7349783, 7351333, 7352882, 7354430, 7355977, 7357522,
+	7359067, 7360611, 7362153, 7363695, 7365235, 7366774,
+	7368312, 7369850, 7371386, 7372921, 7374454, 7375987,
+	7377519, 7379049, 7380579, 7382107, 7383635, 7385161,
+	7386686, 7388210, 7389733, 7391255, 7392776, 7394296,
+	7395814, 7397332, 7398848, 7400364, 7401878, 7403391,
+	7404904, 7406415, 7407925, 7409433, 7410941, 7412448,
+	7413953, 7415458, 7416961, 7418464, 7419965, 7421465,
+	7422964, 7424462, 7425959, 7427455, 7428949, 7430443,
+	7431935, 7433427, 7434917, 7436406, 7437894, 7439381,
+	7440867, 7442352, 7443836, 7445319, 7446800, 7448281,
+	7449760, 7451238, 7452715, 7454191, 7455666, 7457140,
+	7458613, 7460085, 7461555, 7463025, 7464493, 7465960,
+	7467427, 7468892, 7470356, 7471819, 7473280, 7474741,
+	7476201, 7477659, 7479117, 7480573, 7482028, 7483482,
+	7484935, 7486387, 7487838, 7489288, 7490736, 7492184,
+	7493630, 7495075, 7496520, 7497963, 7499405, 7500846,
+	7502285, 7503724, 7505162, 7506598, 7508033, 7509468,
+	7510901, 7512333, 7513764, 7515194, 7516622, 7518050,
+	7519477, 7520902, 7522326, 7523750, 7525172, 7526593,
+	7528013, 7529431, 7530849, 7532266, 7533681, 7535095,
+	7536509, 7537921, 7539332, 7540742, 7542151, 7543558,
+	7544965, 7546370, 7547775, 7549178, 7550580, 7551981,
+	7553381, 7554780, 7556178, 7557574, 7558970, 7560364,
+	7561757, 7563149, 7564540, 7565930, 7567319, 7568707,
+	7570093, 7571479, 7572863, 7574246, 7575629, 7577010,
+	7578390, 7579768, 7581146, 7582523, 7583898, 7585272,
+	7586646, 7588018, 7589389, 7590758, 7592127, 7593495,
+	7594861, 7596227, 7597591, 7598954, 7600316, 7601677,
+	7603037, 7604396, 7605753, 7607110, 7608465, 7609819,
+	7611172, 7612524, 7613875, 7615225, 7616574, 7617921,
+	7619267, 7620613, 7621957, 7623300, 7624642, 7625982,
+	7627322, 7628661, 7629998, 7631334, 7632669, 7634004,
+	7635336, 7636668, 7637999, 7639328, 7640657, 7641984,
+	7643310, 7644635, 7645959, 7647282, 7648604, 7649924,
+	7651244, 7652562, 7653879, 7655195, 7656510, 7657824,
+	7659137, 7660448, 7661759, 7663068, 7664376, 7665683,
+	7666989, 7668294, 7669598, 7670900, 7672201, 7673502,
+	7674801, 7676099, 7677396, 7678692, 7679986, 7681280,
+	7682572, 7683863, 7685153, 7686442, 7687730, 7689017,
+	7690303, 7691587, 7692870, 7694153, 7695434, 7696713,
+	7697992, 7699270, 7700546, 7701822, 7703096, 7704369,
+	7705641, 7706912, 7708182, 7709451, 7710718, 7711984,
+	7713250, 7714514, 7715777, 7717038, 7718299, 7719559,
+	7720817, 7722074, 7723330, 7724585, 7725839, 7727092,
+	7728343, 7729594, 7730843, 7732091, 7733338, 7734584,
+	7735829, 7737073, 7738315, 7739556, 7740797, 7742036,
+	7743274, 7744510, 7745746, 7746981, 7748214, 7749446,
+	7750677, 7751907, 7753136, 7754364, 7755590, 7756816,
+	7758040, 7759263, 7760485, 7761706, 7762925, 7764144,
+	7765361, 7766578, 7767793, 7769007, 7770219, 7771431,
+	7772642, 7773851, 7775059, 7776266, 7777472, 7778677,
+	7779881, 7781084, 7782285, 7783485, 7784684, 7785882,
+	7787079, 7788275, 7789469, 7790663, 7791855, 7793046,
+	7794236, 7795425, 7796612, 7797799, 7798984, 7800168,
+	7801351, 7802533, 7803714, 7804894, 7806072, 7807250,
+	7808426, 7809601, 7810775, 7811947, 7813119, 7814289,
+	7815459, 7816627, 7817794, 7818960, 7820124, 7821288,
+	7822450, 7823611, 7824771, 7825930, 7827088, 7828245,
+	7829400, 7830555, 7831708, 7832860, 7834011, 7835160,
+	7836309, 7837456, 7838603, 7839748, 7840892, 7842034,
+	7843176, 7844317, 7845456, 7846594, 7847731, 7848867,
+	7850002, 7851135, 7852268, 7853399, 7854529, 7855658,
+	7856786, 7857913, 7859038, 7860162, 7861286, 7862408,
+	7863528, 7864648, 7865767, 7866884, 7868000, 7869115,
+	7870229, 7871342, 7872454, 7873564, 7874673, 7875781,
+	7876888, 7877994, 7879099, 7880202, 7881305, 7882406,
+	7883506, 7884605, 7885702, 7886799, 7887894, 7888989,
+	7890082, 7891174, 7892264, 7893354, 7894442, 7895530,
+	7896616, 7897701, 7898784, 7899867, 7900948, 7902029,
+	7903108, 7904186, 7905263, 7906338, 7907413, 7908486,
+	7909558, 7910629, 7911699, 7912768, 7913835, 7914901,
+	7915967, 7917031, 7918093, 7919155, 7920216, 7921275,
+	7922333, 7923390, 7924446, 7925501, 7926554, 7927607,
+	7928658, 7929708, 7930757, 7931804, 7932851, 7933896,
+	7934940, 7935983, 7937025, 7938066, 7939105, 7940144,
+	7941181, 7942217, 7943252, 7944286, 7945318, 7946349,
+	7947380, 7948409, 7949436, 7950463, 7951489, 7952513,
+	7953536, 7954558, 7955579, 7956598, 7957617, 7958634,
+	7959650, 7960665, 7961679, 7962692, 7963703, 7964714,
+	7965723, 7966731, 7967737, 7968743, 7969747, 7970751,
+	7971753, 7972754, 7973753, 7974752, 7975749, 7976746,
+	7977741, 7978734, 7979727, 7980719, 7981709, 7982698,
+	7983686, 7984673, 7985659, 7986643, 7987626, 7988609,
+	7989590, 7990569, 7991548, 7992525, 7993502, 7994477,
+	7995451, 7996423, 7997395, 7998365, 7999334, 8000302,
+	8001269, 8002235, 8003199, 8004163, 8005125, 8006086,
+	8007046, 8008004, 8008962, 8009918, 8010873, 8011827,
+	8012780, 8013731, 8014681, 8015631, 8016579, 8017525,
+	8018471, 8019416, 8020359, 8021301, 8022242, 8023182,
+	8024120, 8025058, 8025994, 8026929, 8027863, 8028795,
+	8029727, 8030657, 8031586, 8032514, 8033441, 8034367,
+	8035291, 8036214, 8037136, 8038057, 8038977, 8039895,
+	8040812, 8041729, 8042644, 8043557, 8044470, 8045381,
+	8046291, 8047200, 8048108, 8049015, 8049920, 8050825,
+	8051728, 8052630, 8053530, 8054430, 8055328, 8056226,
+	8057122, 8058016, 8058910, 8059802, 8060694, 8061584,
+	8062473, 8063360, 8064247, 8065132, 8066016, 8066899,
+	8067781, 8068662, 8069541, 8070419, 8071296, 8072172,
+	8073047, 8073920, 8074792, 8075664, 8076533, 8077402,
+	8078270, 8079136, 8080001, 8080865, 8081728, 8082589,
+	8083450, 8084309, 8085167, 8086024, 8086879, 8087734,
+	8088587, 8089439, 8090290, 8091140, 8091988, 8092836,
+	8093682, 8094527, 8095370, 8096213, 8097054, 8097894,
+	8098733, 8099571, 8100408, 8101243, 8102077, 8102910,
+	8103742, 8104573, 8105402, 8106231, 8107058, 8107883,
+	8108708, 8109532, 8110354, 8111175, 8111995, 8112814,
+	8113631, 8114447, 8115263, 8116076, 8116889, 8117701,
+	8118511, 8119320, 8120128, 8120935, 8121741, 8122545,
+	8123348, 8124150, 8124951, 8125751, 8126549, 8127346,
+	8128142, 8128937, 8129731, 8130523, 8131314, 8132104,
+	8132893, 8133681, 8134467, 8135253, 8136037, 8136819,
+	8137601, 8138382, 8139161, 8139939, 8140716, 8141492,
+	8142266, 8143039, 8143811, 8144582, 8145352, 8146120,
+	8146888, 8147654, 8148419, 8149182, 8149945, 8150706,
+	8151466, 8152225, 8152983, 8153739, 8154495, 8155249,
+	8156002, 8156754, 8157504, 8158253, 8159001, 8159748,
+	8160494, 8161239, 8161982, 8162724, 8163465, 8164205,
+	8164943, 8165680, 8166417, 8167151, 8167885, 8168618,
+	8169349, 8170079, 8170808, 8171536, 8172262, 8172987,
+	8173712, 8174434, 8175156, 8175877, 8176596, 8177314,
+	8178031, 8178747, 8179461, 8180174, 8180886, 8181597,
+	8182307, 8183015, 8183723, 8184429, 8185133, 8185837,
+	8186540, 8187241, 8187941, 8188640, 8189337, 8190034,
+	8190729, 8191423, 8192116, 8192807, 8193498, 8194187,
+	8194875, 8195562, 8196247, 8196932, 8197615, 8198297,
+	8198977, 8199657, 8200335, 8201013, 8201688, 8202363,
+	8203037, 8203709, 8204380, 8205050, 8205719, 8206386,
+	8207052, 8207717, 8208381, 8209044, 8209705, 8210366,
+	8211025, 8211683, 8212339, 8212995, 8213649, 8214302,
+	8214954, 8215604, 8216254, 8216902, 8217549, 8218194,
+	8218839, 8219482, 8220124, 8220765, 8221405, 8222043,
+	8222681, 8223317, 8223952, 8224585, 8225218, 8225849,
+	8226479, 8227108, 8227735, 8228362, 8228987, 8229611,
+	8230234, 8230855, 8231476, 8232095, 8232713, 8233329,
+	8233945, 8234559, 8235172, 8235784, 8236395, 8237004,
+	8237612, 8238219, 8238825, 8239430, 8240033, 8240635,
+	8241236, 8241836, 8242435, 8243032, 8243628, 8244223,
+	8244817, 8245409, 8246000, 8246591, 8247179, 8247767,
+	8248353, 8248939, 8249523, 8250105, 8250687, 8251267,
+	8251846, 8252424, 8253001, 8253576, 8254151, 8254724,
+	8255296, 8255866, 8256436, 8257004, 8257571, 8258137,
+	8258701, 8259265, 8259827, 8260388, 8260947, 8261506,
+	8262063, 8262619, 8263174, 8263728, 8264280, 8264831,
+	8265381, 8265930, 8266478, 8267024, 8267569, 8268113,
+	8268656, 8269197, 8269737, 8270276, 8270814, 8271351,
+	8271886, 8272420, 8272953, 8273485, 8274016, 8274545,
+	8275073, 8275600, 8276126, 8276650, 8277173, 8277695,
+	8278216, 8278736, 8279254, 8279771, 8280287, 8280802,
+	8281315, 8281827, 8282338, 8282848, 8283357, 8283864,
+	8284370, 8284875, 8285379, 8285882, 8286383, 8286883,
+	8287382, 8287880, 8288376, 8288871, 8289365, 8289858,
+	8290349, 8290840, 8291329, 8291817, 8292303, 8292789,
+	8293273, 8293756, 8294238, 8294719, 8295198, 8295676,
+	8296153, 8296629, 8297103, 8297576, 8298048, 8298519,
+	8298989, 8299457, 8299924, 8300390, 8300855, 8301318,
+	8301781, 8302242, 8302702, 8303160, 8303618, 8304074,
+	8304529, 8304982, 8305435, 8305886, 8306336, 8306785,
+	8307233, 8307679, 8308124, 8308568, 8309011, 8309452,
+	8309893, 8310332, 8310769, 8311206, 8311641, 8312076,
+	8312509, 8312940, 8313371, 8313800, 8314228, 8314655,
+	8315081, 8315505, 8315928, 8316350, 8316771, 8317190,
+	8317609, 8318026, 8318441, 8318856, 8319269, 8319682,
+	8320093, 8320502, 8320911, 8321318, 8321724, 8322129,
+	8322532, 8322935, 8323336, 8323736, 8324134, 8324532,
+	8324928, 8325323, 8325717, 8326110, 8326501, 8326891,
+	8327280, 8327668, 8328054, 8328439, 8328823, 8329206,
+	8329588, 8329968, 8330347, 8330725, 8331102, 8331477,
+	8331851, 8332224, 8332596, 8332966, 8333336, 8333704,
+	8334071, 8334436, 8334801, 8335164, 8335526, 8335886,
+	8336246, 8336604, 8336961, 8337317, 8337672, 8338025,
+	8338377, 8338728, 8339078, 8339426, 8339773, 8340119,
+	8340464, 8340808, 8341150, 8341491, 8341831, 8342170,
+	8342507, 8342843, 8343178, 8343512, 8343844, 8344176,
+	8344506, 8344835, 8345162, 8345488, 8345814, 8346138,
+	8346460, 8346782, 8347102, 8347421, 8347739, 8348055,
+	8348371, 8348685, 8348998, 8349309, 8349620, 8349929,
+	8350237, 8350543, 8350849, 8351153, 8351456, 8351758,
+	8352059, 8352358, 8352656, 8352953, 8353249, 8353543,
+	8353836, 8354128, 8354419, 8354709, 8354997, 8355284,
+	8355570, 8355854, 8356138, 8356420, 8356701, 8356981,
+	8357259, 8357536, 8357812, 8358087, 8358361, 8358633,
+	8358904, 8359174, 8359443, 8359710, 8359976, 8360241,
+	8360505, 8360767, 8361029, 8361289, 8361547, 8361805,
+	8362061, 8362316, 8362570, 8362823, 8363074, 8363324,
+	8363573, 8363821, 8364068, 8364313, 8364557, 8364800,
+	8365041, 8365282, 8365521, 8365759, 8365995, 8366231,
+	8366465, 8366698, 8366930, 8367160, 8367389, 8367618,
+	8367844, 8368070, 8368294, 8368517, 8368739, 8368960,
+	8369179, 8369398, 8369615, 8369830, 8370045, 8370258,
+	8370470, 8370681, 8370890, 8371099, 8371306, 8371512,
+	8371716, 8371920, 8372122, 8372323, 8372523, 8372721,
+	8372919, 8373115, 8373309, 8373503, 8373695, 8373886,
+	8374076, 8374265, 8374452, 8374639, 8374824, 8375007,
+	8375190, 8375371, 8375551, 8375730, 8375907, 8376084,
+	8376259, 8376433, 8376605, 8376777, 8376947, 8377116,
+	8377284, 8377450, 8377615, 8377779, 8377942, 8378104,
+	8378264, 8378423, 8378581, 8378737, 8378893, 8379047,
+	8379200, 8379352, 8379502, 8379651, 8379799, 8379946,
+	8380092, 8380236, 8380379, 8380521, 8380661, 8380801,
+	8380939, 8381076, 8381211, 8381346, 8381479, 8381611,
+	8381742, 8381871, 8382000, 8382127, 8382252, 8382377,
+	8382500, 8382622, 8382743, 8382863, 8382981, 8383098,
+	8383214, 8383329, 8383443, 8383555, 8383666, 8383776,
+	8383884, 8383991, 8384098, 8384202, 8384306, 8384408,
+	8384510, 8384609, 8384708, 8384806, 8384902, 8384997,
+	8385091, 8385183, 8385274, 8385364, 8385453, 8385541,
+	8385627, 8385712, 8385796, 8385879, 8385960, 8386040,
+	8386119, 8386197, 8386274, 8386349, 8386423, 8386496,
+	8386567, 8386637, 8386707, 8386774, 8386841, 8386906,
+	8386971, 8387033, 8387095, 8387156, 8387215, 8387273,
+	8387329, 8387385, 8387439, 8387492, 8387544, 8387595,
+	8387644, 8387692, 8387739, 8387785, 8387829, 8387872,
+	8387914, 8387955, 8387994, 8388033, 8388070, 8388105,
+	8388140, 8388173, 8388205, 8388236, 8388266, 8388294,
+	8388321, 8388347, 8388372, 8388395, 8388418, 8388439,
+	8388458, 8388477, 8388494, 8388510, 8388525, 8388538,
+	8388551, 8388562, 8388572, 8388580, 8388588, 8388594,
+	8388599, 8388603, 8388605, 8388606
+};
+
+//
+// quarterwav_sin
+//
+// Returns what quarterwav.v would produce in o_val, sign extended, 3 clocks
+// after i_phase is given to it.
+//
+static inline int32_t	quarterwav_sin(uint32_t i_phase) {
+	uint32_t	index;
+	int64_t		v;
+
+	index = i_phase & ((1u<<(QUARTERWAV_PW-2))-1);
+	if ((i_phase >> (QUARTERWAV_PW-2))&1)
+		index = (~index) & ((1u<<(QUARTERWAV_PW-2))-1);
+	v = quarterwav_tbl[index];
+	if ((i_phase >> (QUARTERWAV_PW-1))&1)
+		v = -v;
+	return (int32_t)mdl_sext(v, QUARTERWAV_OW);
+}
+
+#endif	// QUARTERWAV_MODEL_H
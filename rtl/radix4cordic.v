@@ -0,0 +1,531 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename: 	../rtl/radix4cordic.v
+//
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	This file executes a vector rotation on the values
+//		(i_xval, i_yval).  This vector is rotated left by
+//	i_phase.  i_phase is given by the angle, in radians, multiplied by
+//	2^32/(2pi).  In that fashion, a two pi value is zero just as a zero
+//	angle is zero.  Each pipeline stage applies two CORDIC rotations
+//	at once, as a single radix-4 digit.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2017-2018, Gisselquist Technology, LLC
+//
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+//
+// License:	GPL, v3, as defined and found on www.gnu.org,
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+//
+`default_nettype	none
+//
+module	radix4cordic(i_clk, i_reset, i_ce, i_xval, i_yval, i_phase, i_aux,
+		o_xval, o_yval, o_aux);
+	localparam	IW=12,	// The number of bits in our inputs
+			OW=12,	// The number of output bits to produce
+			NSTAGES=15,	// Radix-2 CORDIC stages
+			NPIPE= 8,	// Pipeline stages, two CORDIC stages each
+			XTRA= 3,// Extra bits for internal precision
+			WW=15,	// Our working bit-width
+			PW=19;	// Bits in our phase variables
+	input	wire				i_clk, i_reset, i_ce;
+	input	wire	signed	[(IW-1):0]		i_xval, i_yval;
+	input	wire		[(PW-1):0]			i_phase;
+	output	reg	signed	[(OW-1):0]	o_xval, o_yval;
+	input	wire				i_aux;
+	output	reg				o_aux;
+	// First step: expand our input to our working width.
+	// This is going to involve extending our input by one
+	// (or more) bits in addition to adding any xtra bits on
+	// bits on the right.  The one bit extra on the left is to
+	// allow for any accumulation due to the cordic gain
+	// within the algorithm.
+	// 
+	wire	signed [(WW-1):0]	e_xval, e_yval;
+	assign	e_xval = { {i_xval[(IW-1)]}, i_xval, {(WW-IW-1){1'b0}} };
+	assign	e_yval = { {i_yval[(IW-1)]}, i_yval, {(WW-IW-1){1'b0}} };
+
+	// Declare variables for all of the separate stages
+	reg	signed	[(WW-1):0]	xv	[0:(NPIPE)];
+	reg	signed	[(WW-1):0]	yv	[0:(NPIPE)];
+	reg		[(PW-1):0]	ph	[0:(NPIPE)];
+
+	//
+	// Handle the auxilliary logic.
+	//
+	// The auxilliary bit is designed so that you can place a valid bit into
+	// the CORDIC function, and see when it comes out.  While the bit is
+	// allowed to be anything, the requirement of this bit is that it *must*
+	// be aligned with the output when done.  That is, if i_xval and i_yval
+	// are input together with i_aux, then when the outputs are set
+	// to this value, o_aux *must* contain the value that was in i_aux.
+	//
+	reg		[(NPIPE):0]	ax;
+
+	always @(posedge i_clk)
+	if (i_reset)
+		ax <= {(NPIPE+1){1'b0}};
+	else if (i_ce)
+		ax <= { ax[(NPIPE-1):0], i_aux };
+
+	// First stage, get rid of all but 45 degrees
+	//	The resulting phase needs to be between -45 and 45
+	//		degrees but in units of normalized phase
+	always @(posedge i_clk)
+	if (i_reset)
+	begin
+		xv[0] <= 0;
+		yv[0] <= 0;
+		ph[0] <= 0;
+	end else if (i_ce)
+	begin
+		// Walk through all possible quick phase shifts necessary
+		// to constrain the input to within +/- 45 degrees.
+		case(i_phase[(PW-1):(PW-3)])
+		3'b000: begin	// 0 .. 45, No change
+			xv[0] <= e_xval;
+			yv[0] <= e_yval;
+			ph[0] <= i_phase;
+			end
+		3'b001, 3'b010: begin	// 45 .. 135
+			xv[0] <= -e_yval;
+			yv[0] <= e_xval;
+			ph[0] <= i_phase - 19'h20000;
+			end
+		3'b011, 3'b100: begin	// 135 .. 225
+			xv[0] <= -e_xval;
+			yv[0] <= -e_yval;
+			ph[0] <= i_phase - 19'h40000;
+			end
+		3'b101, 3'b110: begin	// 225 .. 315
+			xv[0] <= e_yval;
+			yv[0] <= -e_xval;
+			ph[0] <= i_phase - 19'h60000;
+			end
+		3'b111: begin	// 315 .. 360, No change
+			xv[0] <= e_xval;
+			yv[0] <= e_yval;
+			ph[0] <= i_phase;
+			end
+		endcase
+	end
+
+	//
+	// Each stage below rotates by one of four angles, picked by its
+	// digit.  The digits +/-3 rotate by atan(2^-s)+atan(2^-(s+1)),
+	// the digits +/-1 by atan(2^-s)-atan(2^-(s+1)), and each of
+	// these is rounded to the nearest phase unit.
+	//
+	// Stage  0: s =  1,   40.601349 or   12.528534 deg
+	// Stage  1: s =  3,   10.701370 or    3.548584 deg
+	// Stage  2: s =  5,    2.684784 or    0.894699 deg
+	// Stage  3: s =  7,    0.671539 or    0.223846 deg
+	// Stage  4: s =  9,    0.167542 or    0.055618 deg
+	// Stage  5: s = 11,    0.041885 or    0.013733 deg
+	// Stage  6: s = 13,    0.010300 or    0.003433 deg
+	// Stage  7: s = 15,    0.001373 deg (radix-2)
+	// Phase Quantization: 0.000012 (Radians)
+	// Gain is 1.164435
+	// You can annihilate this gain by multiplying by 32'hdbd95b17
+	// and right shifting by 32 bits.
+
+	// Stage 0
+	always @(posedge i_clk)
+	if (i_reset)
+	begin
+		xv[1] <= 0;
+		yv[1] <= 0;
+		ph[1] <= 0;
+	end else if (i_ce)
+	begin
+		if ((!ph[0][(PW-1)])&&(ph[0] >= 19'h09720))	// Past the first angle
+		begin
+			xv[1] <= xv[0]
+				- ((yv[0]>>>1) + $signed({ 1'b0, yv[0][0] }))
+				- ((yv[0]>>>2) + $signed({ 1'b0, yv[0][1] }))
+				- ((xv[0]>>>3) + $signed({ 1'b0, xv[0][2] }));
+			yv[1] <= yv[0]
+				+ ((xv[0]>>>1) + $signed({ 1'b0, xv[0][0] }))
+				+ ((xv[0]>>>2) + $signed({ 1'b0, xv[0][1] }))
+				- ((yv[0]>>>3) + $signed({ 1'b0, yv[0][2] }));
+			ph[1] <= ph[0] - 19'h0e6fa;
+		end else if (!ph[0][(PW-1)])	// Short of the first angle
+		begin
+			xv[1] <= xv[0]
+				- ((yv[0]>>>2) + $signed({ 1'b0, yv[0][1] }))
+				+ ((xv[0]>>>3) + $signed({ 1'b0, xv[0][2] }));
+			yv[1] <= yv[0]
+				+ ((xv[0]>>>2) + $signed({ 1'b0, xv[0][1] }))
+				+ ((yv[0]>>>3) + $signed({ 1'b0, yv[0][2] }));
+			ph[1] <= ph[0] - 19'h04746;
+		end else if (ph[0] >= 19'h768e0)	// Short of minus the first angle
+		begin
+			xv[1] <= xv[0]
+				+ ((yv[0]>>>2) + $signed({ 1'b0, yv[0][1] }))
+				+ ((xv[0]>>>3) + $signed({ 1'b0, xv[0][2] }));
+			yv[1] <= yv[0]
+				- ((xv[0]>>>2) + $signed({ 1'b0, xv[0][1] }))
+				+ ((yv[0]>>>3) + $signed({ 1'b0, yv[0][2] }));
+			ph[1] <= ph[0] + 19'h04746;
+		end else begin	// Past minus the first angle
+			xv[1] <= xv[0]
+				+ ((yv[0]>>>1) + $signed({ 1'b0, yv[0][0] }))
+				+ ((yv[0]>>>2) + $signed({ 1'b0, yv[0][1] }))
+				- ((xv[0]>>>3) + $signed({ 1'b0, xv[0][2] }));
+			yv[1] <= yv[0]
+				- ((xv[0]>>>1) + $signed({ 1'b0, xv[0][0] }))
+				- ((xv[0]>>>2) + $signed({ 1'b0, xv[0][1] }))
+				- ((yv[0]>>>3) + $signed({ 1'b0, yv[0][2] }));
+			ph[1] <= ph[0] + 19'h0e6fa;
+		end
+	end
+
+	// Stage 1
+	always @(posedge i_clk)
+	if (i_reset)
+	begin
+		xv[2] <= 0;
+		yv[2] <= 0;
+		ph[2] <= 0;
+	end else if (i_ce)
+	begin
+		if ((!ph[1][(PW-1)])&&(ph[1] >= 19'h02888))	// Past the first angle
+		begin
+			xv[2] <= xv[1]
+				- ((yv[1]>>>3) + $signed({ 1'b0, yv[1][2] }))
+				- ((yv[1]>>>4) + $signed({ 1'b0, yv[1][3] }))
+				- ((xv[1]>>>7) + $signed({ 1'b0, xv[1][6] }));
+			yv[2] <= yv[1]
+				+ ((xv[1]>>>3) + $signed({ 1'b0, xv[1][2] }))
+				+ ((xv[1]>>>4) + $signed({ 1'b0, xv[1][3] }))
+				- ((yv[1]>>>7) + $signed({ 1'b0, yv[1][6] }));
+			ph[2] <= ph[1] - 19'h03ce1;
+		end else if (!ph[1][(PW-1)])	// Short of the first angle
+		begin
+			xv[2] <= xv[1]
+				- ((yv[1]>>>4) + $signed({ 1'b0, yv[1][3] }))
+				+ ((xv[1]>>>7) + $signed({ 1'b0, xv[1][6] }));
+			yv[2] <= yv[1]
+				+ ((xv[1]>>>4) + $signed({ 1'b0, xv[1][3] }))
+				+ ((yv[1]>>>7) + $signed({ 1'b0, yv[1][6] }));
+			ph[2] <= ph[1] - 19'h01430;
+		end else if (ph[1] >= 19'h7d778)	// Short of minus the first angle
+		begin
+			xv[2] <= xv[1]
+				+ ((yv[1]>>>4) + $signed({ 1'b0, yv[1][3] }))
+				+ ((xv[1]>>>7) + $signed({ 1'b0, xv[1][6] }));
+			yv[2] <= yv[1]
+				- ((xv[1]>>>4) + $signed({ 1'b0, xv[1][3] }))
+				+ ((yv[1]>>>7) + $signed({ 1'b0, yv[1][6] }));
+			ph[2] <= ph[1] + 19'h01430;
+		end else begin	// Past minus the first angle
+			xv[2] <= xv[1]
+				+ ((yv[1]>>>3) + $signed({ 1'b0, yv[1][2] }))
+				+ ((yv[1]>>>4) + $signed({ 1'b0, yv[1][3] }))
+				- ((xv[1]>>>7) + $signed({ 1'b0, xv[1][6] }));
+			yv[2] <= yv[1]
+				- ((xv[1]>>>3) + $signed({ 1'b0, xv[1][2] }))
+				- ((xv[1]>>>4) + $signed({ 1'b0, xv[1][3] }))
+				- ((yv[1]>>>7) + $signed({ 1'b0, yv[1][6] }));
+			ph[2] <= ph[1] + 19'h03ce1;
+		end
+	end
+
+	// Stage 2
+	always @(posedge i_clk)
+	if (i_reset)
+	begin
+		xv[3] <= 0;
+		yv[3] <= 0;
+		ph[3] <= 0;
+	end else if (i_ce)
+	begin
+		if ((!ph[2][(PW-1)])&&(ph[2] >= 19'h00a2e))	// Past the first angle
+		begin
+			xv[3] <= xv[2]
+				- ((yv[2]>>>5) + $signed({ 1'b0, yv[2][4] }))
+				- ((yv[2]>>>6) + $signed({ 1'b0, yv[2][5] }))
+				- ((xv[2]>>>11) + $signed({ 1'b0, xv[2][10] }));
+			yv[3] <= yv[2]
+				+ ((xv[2]>>>5) + $signed({ 1'b0, xv[2][4] }))
+				+ ((xv[2]>>>6) + $signed({ 1'b0, xv[2][5] }))
+				- ((yv[2]>>>11) + $signed({ 1'b0, yv[2][10] }));
+			ph[3] <= ph[2] - 19'h00f46;
+		end else if (!ph[2][(PW-1)])	// Short of the first angle
+		begin
+			xv[3] <= xv[2]
+				- ((yv[2]>>>6) + $signed({ 1'b0, yv[2][5] }))
+				+ ((xv[2]>>>11) + $signed({ 1'b0, xv[2][10] }));
+			yv[3] <= yv[2]
+				+ ((xv[2]>>>6) + $signed({ 1'b0, xv[2][5] }))
+				+ ((yv[2]>>>11) + $signed({ 1'b0, yv[2][10] }));
+			ph[3] <= ph[2] - 19'h00517;
+		end else if (ph[2] >= 19'h7f5d2)	// Short of minus the first angle
+		begin
+			xv[3] <= xv[2]
+				+ ((yv[2]>>>6) + $signed({ 1'b0, yv[2][5] }))
+				+ ((xv[2]>>>11) + $signed({ 1'b0, xv[2][10] }));
+			yv[3] <= yv[2]
+				- ((xv[2]>>>6) + $signed({ 1'b0, xv[2][5] }))
+				+ ((yv[2]>>>11) + $signed({ 1'b0, yv[2][10] }));
+			ph[3] <= ph[2] + 19'h00517;
+		end else begin	// Past minus the first angle
+			xv[3] <= xv[2]
+				+ ((yv[2]>>>5) + $signed({ 1'b0, yv[2][4] }))
+				+ ((yv[2]>>>6) + $signed({ 1'b0, yv[2][5] }))
+				- ((xv[2]>>>11) + $signed({ 1'b0, xv[2][10] }));
+			yv[3] <= yv[2]
+				- ((xv[2]>>>5) + $signed({ 1'b0, xv[2][4] }))
+				- ((xv[2]>>>6) + $signed({ 1'b0, xv[2][5] }))
+				- ((yv[2]>>>11) + $signed({ 1'b0, yv[2][10] }));
+			ph[3] <= ph[2] + 19'h00f46;
+		end
+	end
+
+	// Stage 3
+	always @(posedge i_clk)
+	if (i_reset)
+	begin
+		xv[4] <= 0;
+		yv[4] <= 0;
+		ph[4] <= 0;
+	end else if (i_ce)
+	begin
+		if ((!ph[3][(PW-1)])&&(ph[3] >= 19'h0028b))	// Past the first angle
+		begin
+			xv[4] <= xv[3]
+				- ((yv[3]>>>7) + $signed({ 1'b0, yv[3][6] }))
+				- ((yv[3]>>>8) + $signed({ 1'b0, yv[3][7] }));
+			yv[4] <= yv[3]
+				+ ((xv[3]>>>7) + $signed({ 1'b0, xv[3][6] }))
+				+ ((xv[3]>>>8) + $signed({ 1'b0, xv[3][7] }));
+			ph[4] <= ph[3] - 19'h003d2;
+		end else if (!ph[3][(PW-1)])	// Short of the first angle
+		begin
+			xv[4] <= xv[3]
+				- ((yv[3]>>>8) + $signed({ 1'b0, yv[3][7] }));
+			yv[4] <= yv[3]
+				+ ((xv[3]>>>8) + $signed({ 1'b0, xv[3][7] }));
+			ph[4] <= ph[3] - 19'h00146;
+		end else if (ph[3] >= 19'h7fd75)	// Short of minus the first angle
+		begin
+			xv[4] <= xv[3]
+				+ ((yv[3]>>>8) + $signed({ 1'b0, yv[3][7] }));
+			yv[4] <= yv[3]
+				- ((xv[3]>>>8) + $signed({ 1'b0, xv[3][7] }));
+			ph[4] <= ph[3] + 19'h00146;
+		end else begin	// Past minus the first angle
+			xv[4] <= xv[3]
+				+ ((yv[3]>>>7) + $signed({ 1'b0, yv[3][6] }))
+				+ ((yv[3]>>>8) + $signed({ 1'b0, yv[3][7] }));
+			yv[4] <= yv[3]
+				- ((xv[3]>>>7) + $signed({ 1'b0, xv[3][6] }))
+				- ((xv[3]>>>8) + $signed({ 1'b0, xv[3][7] }));
+			ph[4] <= ph[3] + 19'h003d2;
+		end
+	end
+
+	// Stage 4
+	always @(posedge i_clk)
+	if (i_reset)
+	begin
+		xv[5] <= 0;
+		yv[5] <= 0;
+		ph[5] <= 0;
+	end else if (i_ce)
+	begin
+		if ((!ph[4][(PW-1)])&&(ph[4] >= 19'h000a2))	// Past the first angle
+		begin
+			xv[5] <= xv[4]
+				- ((yv[4]>>>9) + $signed({ 1'b0, yv[4][8] }))
+				- ((yv[4]>>>10) + $signed({ 1'b0, yv[4][9] }));
+			yv[5] <= yv[4]
+				+ ((xv[4]>>>9) + $signed({ 1'b0, xv[4][8] }))
+				+ ((xv[4]>>>10) + $signed({ 1'b0, xv[4][9] }));
+			ph[5] <= ph[4] - 19'h000f4;
+		end else if (!ph[4][(PW-1)])	// Short of the first angle
+		begin
+			xv[5] <= xv[4]
+				- ((yv[4]>>>10) + $signed({ 1'b0, yv[4][9] }));
+			yv[5] <= yv[4]
+				+ ((xv[4]>>>10) + $signed({ 1'b0, xv[4][9] }));
+			ph[5] <= ph[4] - 19'h00051;
+		end else if (ph[4] >= 19'h7ff5e)	// Short of minus the first angle
+		begin
+			xv[5] <= xv[4]
+				+ ((yv[4]>>>10) + $signed({ 1'b0, yv[4][9] }));
+			yv[5] <= yv[4]
+				- ((xv[4]>>>10) + $signed({ 1'b0, xv[4][9] }));
+			ph[5] <= ph[4] + 19'h00051;
+		end else begin	// Past minus the first angle
+			xv[5] <= xv[4]
+				+ ((yv[4]>>>9) + $signed({ 1'b0, yv[4][8] }))
+				+ ((yv[4]>>>10) + $signed({ 1'b0, yv[4][9] }));
+			yv[5] <= yv[4]
+				- ((xv[4]>>>9) + $signed({ 1'b0, xv[4][8] }))
+				- ((xv[4]>>>10) + $signed({ 1'b0, xv[4][9] }));
+			ph[5] <= ph[4] + 19'h000f4;
+		end
+	end
+
+	// Stage 5
+	always @(posedge i_clk)
+	if (i_reset)
+	begin
+		xv[6] <= 0;
+		yv[6] <= 0;
+		ph[6] <= 0;
+	end else if (i_ce)
+	begin
+		if ((!ph[5][(PW-1)])&&(ph[5] >= 19'h00028))	// Past the first angle
+		begin
+			xv[6] <= xv[5]
+				- ((yv[5]>>>11) + $signed({ 1'b0, yv[5][10] }))
+				- ((yv[5]>>>12) + $signed({ 1'b0, yv[5][11] }));
+			yv[6] <= yv[5]
+				+ ((xv[5]>>>11) + $signed({ 1'b0, xv[5][10] }))
+				+ ((xv[5]>>>12) + $signed({ 1'b0, xv[5][11] }));
+			ph[6] <= ph[5] - 19'h0003d;
+		end else if (!ph[5][(PW-1)])	// Short of the first angle
+		begin
+			xv[6] <= xv[5]
+				- ((yv[5]>>>12) + $signed({ 1'b0, yv[5][11] }));
+			yv[6] <= yv[5]
+				+ ((xv[5]>>>12) + $signed({ 1'b0, xv[5][11] }));
+			ph[6] <= ph[5] - 19'h00014;
+		end else if (ph[5] >= 19'h7ffd8)	// Short of minus the first angle
+		begin
+			xv[6] <= xv[5]
+				+ ((yv[5]>>>12) + $signed({ 1'b0, yv[5][11] }));
+			yv[6] <= yv[5]
+				- ((xv[5]>>>12) + $signed({ 1'b0, xv[5][11] }));
+			ph[6] <= ph[5] + 19'h00014;
+		end else begin	// Past minus the first angle
+			xv[6] <= xv[5]
+				+ ((yv[5]>>>11) + $signed({ 1'b0, yv[5][10] }))
+				+ ((yv[5]>>>12) + $signed({ 1'b0, yv[5][11] }));
+			yv[6] <= yv[5]
+				- ((xv[5]>>>11) + $signed({ 1'b0, xv[5][10] }))
+				- ((xv[5]>>>12) + $signed({ 1'b0, xv[5][11] }));
+			ph[6] <= ph[5] + 19'h0003d;
+		end
+	end
+
+	// Stage 6
+	always @(posedge i_clk)
+	if (i_reset)
+	begin
+		xv[7] <= 0;
+		yv[7] <= 0;
+		ph[7] <= 0;
+	end else if (i_ce)
+	begin
+		if ((!ph[6][(PW-1)])&&(ph[6] >= 19'h0000a))	// Past the first angle
+		begin
+			xv[7] <= xv[6]
+				- ((yv[6]>>>13) + $signed({ 1'b0, yv[6][12] }))
+				- ((yv[6]>>>14) + $signed({ 1'b0, yv[6][13] }));
+			yv[7] <= yv[6]
+				+ ((xv[6]>>>13) + $signed({ 1'b0, xv[6][12] }))
+				+ ((xv[6]>>>14) + $signed({ 1'b0, xv[6][13] }));
+			ph[7] <= ph[6] - 19'h0000f;
+		end else if (!ph[6][(PW-1)])	// Short of the first angle
+		begin
+			xv[7] <= xv[6]
+				- ((yv[6]>>>14) + $signed({ 1'b0, yv[6][13] }));
+			yv[7] <= yv[6]
+				+ ((xv[6]>>>14) + $signed({ 1'b0, xv[6][13] }));
+			ph[7] <= ph[6] - 19'h00005;
+		end else if (ph[6] >= 19'h7fff6)	// Short of minus the first angle
+		begin
+			xv[7] <= xv[6]
+				+ ((yv[6]>>>14) + $signed({ 1'b0, yv[6][13] }));
+			yv[7] <= yv[6]
+				- ((xv[6]>>>14) + $signed({ 1'b0, xv[6][13] }));
+			ph[7] <= ph[6] + 19'h00005;
+		end else begin	// Past minus the first angle
+			xv[7] <= xv[6]
+				+ ((yv[6]>>>13) + $signed({ 1'b0, yv[6][12] }))
+				+ ((yv[6]>>>14) + $signed({ 1'b0, yv[6][13] }));
+			yv[7] <= yv[6]
+				- ((xv[6]>>>13) + $signed({ 1'b0, xv[6][12] }))
+				- ((xv[6]>>>14) + $signed({ 1'b0, xv[6][13] }));
+			ph[7] <= ph[6] + 19'h0000f;
+		end
+	end
+
+	// Stage 7
+	always @(posedge i_clk)
+	if (i_reset)
+	begin
+		xv[8] <= 0;
+		yv[8] <= 0;
+		ph[8] <= 0;
+	end else if (i_ce)
+	begin
+		if (!ph[7][(PW-1)])
+		begin
+			xv[8] <= xv[7] - (yv[7]>>>15);
+			yv[8] <= yv[7] + (xv[7]>>>15);
+			ph[8] <= ph[7] - 19'h00002;
+		end else begin
+			xv[8] <= xv[7] + (yv[7]>>>15);
+			yv[8] <= yv[7] - (xv[7]>>>15);
+			ph[8] <= ph[7] + 19'h00002;
+		end
+	end
+
+	// Round our result towards even
+	wire	[(WW-1):0]	pre_xval, pre_yval;
+
+	assign	pre_xval = xv[NPIPE] + $signed({{(OW){1'b0}},
+				xv[NPIPE][(WW-OW)],
+				{(WW-OW-1){!xv[NPIPE][WW-OW]}}});
+	assign	pre_yval = yv[NPIPE] + $signed({{(OW){1'b0}},
+				yv[NPIPE][(WW-OW)],
+				{(WW-OW-1){!yv[NPIPE][WW-OW]}}});
+
+	always @(posedge i_clk)
+	if (i_reset)
+	begin
+		o_xval <= 0;
+		o_yval <= 0;
+	end else if (i_ce)
+	begin
+		o_xval <= pre_xval[(WW-1):(WW-OW)];
+		o_yval <= pre_yval[(WW-1):(WW-OW)];
+		o_aux <= ax[NPIPE];
+	end
+
+	// Make Verilator happy with pre_.val
+	// verilator lint_off UNUSED
+	wire	[(2*(WW-OW)-1):0] unused_val;
+	assign	unused_val = {
+		pre_xval[(WW-OW-1):0],
+		pre_yval[(WW-OW-1):0]
+		};
+	// verilator lint_on UNUSED
+endmodule
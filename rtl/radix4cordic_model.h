@@ -0,0 +1,430 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename: 	radix4cordic_model.h
+//
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	This is a bit-accurate C++ software model of the core
+//		found in the Verilog file of the same name.  It was generated
+//	from the same parameters as that core, and should produce
+//	identical outputs for identical inputs.  Call it in place of
+//	running Verilator when you need the core's exact outputs at native
+//	speed.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2017-2018, Gisselquist Technology, LLC
+//
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+//
+// License:	GPL, v3, as defined and found on www.gnu.org,
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+//
+#ifndef	RADIX4CORDIC_MODEL_H
+#define	RADIX4CORDIC_MODEL_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifndef	GENCORDIC_MODEL_HELPERS
+#define	GENCORDIC_MODEL_HELPERS
+//
+// mdl_sext
+//
+// Sign extend the bottom w bits of v, dropping everything above them.
+// This captures the wrap-around of a w-bit Verilog register.
+static inline int64_t	mdl_sext(int64_t v, int w) {
+	return (int64_t)((uint64_t)v << (64-w)) >> (64-w);
+}
+
+//
+// mdl_shl
+//
+// A left shift, done unsigned so that it's defined even when v is
+// negative.
+static inline int64_t	mdl_shl(int64_t v, int s) {
+	return (int64_t)((uint64_t)v << s);
+}
+
+//
+// mdl_asr
+//
+// An arithmetic right shift that, like Verilog's >>>, doesn't mind
+// shifting by more bits than are in the word.
+static inline int64_t	mdl_asr(int64_t v, int s) {
+	return (s >= 63) ? ((v < 0) ? -1 : 0) : (v >> s);
+}
+
+//
+// mdl_round
+//
+// Drop a ww bit value down to ow bits.  If more than one bit is
+// dropped, round towards even first, just like the generated cores do.
+static inline int64_t	mdl_round(int64_t v, int ww, int ow) {
+	int	drop = ww - ow;
+
+	if (drop > 1) {
+		int64_t	half = (1ll<<(drop-1));
+
+		v += ((v >> drop)&1) ? half : (half-1);
+	}
+	return mdl_sext(v >> drop, ow);
+}
+#endif	// GENCORDIC_MODEL_HELPERS
+
+static const int	RADIX4CORDIC_IW = 12,	// The number of bits in our inputs
+		RADIX4CORDIC_OW = 12,	// The number of output bits to produce
+		RADIX4CORDIC_NSTAGES = 15,
+		RADIX4CORDIC_XTRA = 3,	// Extra bits for internal precision
+		RADIX4CORDIC_WW = 15,	// Our working bit-width
+		RADIX4CORDIC_PW = 19,	// Bits in our phase variables
+		RADIX4CORDIC_LATENCY = 10;	// Clocks from input to output
+static const uint64_t	RADIX4CORDIC_PMASK = 0x7ffffull;
+
+static const int	RADIX4CORDIC_NPIPE = 8;	// Pipeline stages
+
+//
+// radix4cordic_p2r
+//
+// Rotates (i_xval, i_yval) left by i_phase, producing exactly what
+// radix4cordic.v would produce in o_xval and o_yval 10 clocks later.
+//
+static inline void	radix4cordic_p2r(int32_t i_xval, int32_t i_yval,
+			uint32_t i_phase, int32_t *o_xval, int32_t *o_yval) {
+	int64_t		e_xval, e_yval, xv, yv, nx, ny;
+	uint64_t	ph;
+
+	// First step: expand our input to our working width.
+	e_xval = mdl_shl(mdl_sext(i_xval, RADIX4CORDIC_IW), RADIX4CORDIC_WW-RADIX4CORDIC_IW-1);
+	e_yval = mdl_shl(mdl_sext(i_yval, RADIX4CORDIC_IW), RADIX4CORDIC_WW-RADIX4CORDIC_IW-1);
+	ph = i_phase & RADIX4CORDIC_PMASK;
+
+	// First stage, get rid of all but 45 degrees
+	switch((ph >> (RADIX4CORDIC_PW-3))&7) {
+	case 1: case 2:	// 45 .. 135
+		xv = -e_yval; yv =  e_xval; ph -= 0x20000ull; break;
+	case 3: case 4:	// 135 .. 225
+		xv = -e_xval; yv = -e_yval; ph -= 0x40000ull; break;
+	case 5: case 6:	// 225 .. 315
+		xv =  e_yval; yv = -e_xval; ph -= 0x60000ull; break;
+	default:	// -45 .. 45, No change
+		xv =  e_xval; yv =  e_yval; break;
+	}
+	xv = mdl_sext(xv, RADIX4CORDIC_WW);
+	yv = mdl_sext(yv, RADIX4CORDIC_WW);
+	ph &= RADIX4CORDIC_PMASK;
+
+	// Stage 0, by atan(2^-1) and atan(2^-2)
+	if ((!((ph >> (RADIX4CORDIC_PW-1))&1))&&(ph >= 0x9720ull)) {
+		nx = xv
+			- (mdl_asr(yv, 1) + (mdl_asr(yv, 0)&1))
+			- (mdl_asr(yv, 2) + (mdl_asr(yv, 1)&1))
+			- (mdl_asr(xv, 3) + (mdl_asr(xv, 2)&1));
+		ny = yv
+			+ (mdl_asr(xv, 1) + (mdl_asr(xv, 0)&1))
+			+ (mdl_asr(xv, 2) + (mdl_asr(xv, 1)&1))
+			- (mdl_asr(yv, 3) + (mdl_asr(yv, 2)&1));
+		ph -= 0xe6faull;
+	} else if (!((ph >> (RADIX4CORDIC_PW-1))&1)) {
+		nx = xv
+			- (mdl_asr(yv, 2) + (mdl_asr(yv, 1)&1))
+			+ (mdl_asr(xv, 3) + (mdl_asr(xv, 2)&1));
+		ny = yv
+			+ (mdl_asr(xv, 2) + (mdl_asr(xv, 1)&1))
+			+ (mdl_asr(yv, 3) + (mdl_asr(yv, 2)&1));
+		ph -= 0x4746ull;
+	} else if (ph >= 0x768e0ull) {
+		nx = xv
+			+ (mdl_asr(yv, 2) + (mdl_asr(yv, 1)&1))
+			+ (mdl_asr(xv, 3) + (mdl_asr(xv, 2)&1));
+		ny = yv
+			- (mdl_asr(xv, 2) + (mdl_asr(xv, 1)&1))
+			+ (mdl_asr(yv, 3) + (mdl_asr(yv, 2)&1));
+		ph += 0x4746ull;
+	} else {
+		nx = xv
+			+ (mdl_asr(yv, 1) + (mdl_asr(yv, 0)&1))
+			+ (mdl_asr(yv, 2) + (mdl_asr(yv, 1)&1))
+			- (mdl_asr(xv, 3) + (mdl_asr(xv, 2)&1));
+		ny = yv
+			- (mdl_asr(xv, 1) + (mdl_asr(xv, 0)&1))
+			- (mdl_asr(xv, 2) + (mdl_asr(xv, 1)&1))
+			- (mdl_asr(yv, 3) + (mdl_asr(yv, 2)&1));
+		ph += 0xe6faull;
+	}
+	xv = mdl_sext(nx, RADIX4CORDIC_WW);
+	yv = mdl_sext(ny, RADIX4CORDIC_WW);
+	ph &= RADIX4CORDIC_PMASK;
+
+	// Stage 1, by atan(2^-3) and atan(2^-4)
+	if ((!((ph >> (RADIX4CORDIC_PW-1))&1))&&(ph >= 0x2888ull)) {
+		nx = xv
+			- (mdl_asr(yv, 3) + (mdl_asr(yv, 2)&1))
+			- (mdl_asr(yv, 4) + (mdl_asr(yv, 3)&1))
+			- (mdl_asr(xv, 7) + (mdl_asr(xv, 6)&1));
+		ny = yv
+			+ (mdl_asr(xv, 3) + (mdl_asr(xv, 2)&1))
+			+ (mdl_asr(xv, 4) + (mdl_asr(xv, 3)&1))
+			- (mdl_asr(yv, 7) + (mdl_asr(yv, 6)&1));
+		ph -= 0x3ce1ull;
+	} else if (!((ph >> (RADIX4CORDIC_PW-1))&1)) {
+		nx = xv
+			- (mdl_asr(yv, 4) + (mdl_asr(yv, 3)&1))
+			+ (mdl_asr(xv, 7) + (mdl_asr(xv, 6)&1));
+		ny = yv
+			+ (mdl_asr(xv, 4) + (mdl_asr(xv, 3)&1))
+			+ (mdl_asr(yv, 7) + (mdl_asr(yv, 6)&1));
+		ph -= 0x1430ull;
+	} else if (ph >= 0x7d778ull) {
+		nx = xv
+			+ (mdl_asr(yv, 4) + (mdl_asr(yv, 3)&1))
+			+ (mdl_asr(xv, 7) + (mdl_asr(xv, 6)&1));
+		ny = yv
+			- (mdl_asr(xv, 4) + (mdl_asr(xv, 3)&1))
+			+ (mdl_asr(yv, 7) + (mdl_asr(yv, 6)&1));
+		ph += 0x1430ull;
+	} else {
+		nx = xv
+			+ (mdl_asr(yv, 3) + (mdl_asr(yv, 2)&1))
+			+ (mdl_asr(yv, 4) + (mdl_asr(yv, 3)&1))
+			- (mdl_asr(xv, 7) + (mdl_asr(xv, 6)&1));
+		ny = yv
+			- (mdl_asr(xv, 3) + (mdl_asr(xv, 2)&1))
+			- (mdl_asr(xv, 4) + (mdl_asr(xv, 3)&1))
+			- (mdl_asr(yv, 7) + (mdl_asr(yv, 6)&1));
+		ph += 0x3ce1ull;
+	}
+	xv = mdl_sext(nx, RADIX4CORDIC_WW);
+	yv = mdl_sext(ny, RADIX4CORDIC_WW);
+	ph &= RADIX4CORDIC_PMASK;
+
+	// Stage 2, by atan(2^-5) and atan(2^-6)
+	if ((!((ph >> (RADIX4CORDIC_PW-1))&1))&&(ph >= 0xa2eull)) {
+		nx = xv
+			- (mdl_asr(yv, 5) + (mdl_asr(yv, 4)&1))
+			- (mdl_asr(yv, 6) + (mdl_asr(yv, 5)&1))
+			- (mdl_asr(xv, 11) + (mdl_asr(xv, 10)&1));
+		ny = yv
+			+ (mdl_asr(xv, 5) + (mdl_asr(xv, 4)&1))
+			+ (mdl_asr(xv, 6) + (mdl_asr(xv, 5)&1))
+			- (mdl_asr(yv, 11) + (mdl_asr(yv, 10)&1));
+		ph -= 0xf46ull;
+	} else if (!((ph >> (RADIX4CORDIC_PW-1))&1)) {
+		nx = xv
+			- (mdl_asr(yv, 6) + (mdl_asr(yv, 5)&1))
+			+ (mdl_asr(xv, 11) + (mdl_asr(xv, 10)&1));
+		ny = yv
+			+ (mdl_asr(xv, 6) + (mdl_asr(xv, 5)&1))
+			+ (mdl_asr(yv, 11) + (mdl_asr(yv, 10)&1));
+		ph -= 0x517ull;
+	} else if (ph >= 0x7f5d2ull) {
+		nx = xv
+			+ (mdl_asr(yv, 6) + (mdl_asr(yv, 5)&1))
+			+ (mdl_asr(xv, 11) + (mdl_asr(xv, 10)&1));
+		ny = yv
+			- (mdl_asr(xv, 6) + (mdl_asr(xv, 5)&1))
+			+ (mdl_asr(yv, 11) + (mdl_asr(yv, 10)&1));
+		ph += 0x517ull;
+	} else {
+		nx = xv
+			+ (mdl_asr(yv, 5) + (mdl_asr(yv, 4)&1))
+			+ (mdl_asr(yv, 6) + (mdl_asr(yv, 5)&1))
+			- (mdl_asr(xv, 11) + (mdl_asr(xv, 10)&1));
+		ny = yv
+			- (mdl_asr(xv, 5) + (mdl_asr(xv, 4)&1))
+			- (mdl_asr(xv, 6) + (mdl_asr(xv, 5)&1))
+			- (mdl_asr(yv, 11) + (mdl_asr(yv, 10)&1));
+		ph += 0xf46ull;
+	}
+	xv = mdl_sext(nx, RADIX4CORDIC_WW);
+	yv = mdl_sext(ny, RADIX4CORDIC_WW);
+	ph &= RADIX4CORDIC_PMASK;
+
+	// Stage 3, by atan(2^-7) and atan(2^-8)
+	if ((!((ph >> (RADIX4CORDIC_PW-1))&1))&&(ph >= 0x28bull)) {
+		nx = xv
+			- (mdl_asr(yv, 7) + (mdl_asr(yv, 6)&1))
+			- (mdl_asr(yv, 8) + (mdl_asr(yv, 7)&1));
+		ny = yv
+			+ (mdl_asr(xv, 7) + (mdl_asr(xv, 6)&1))
+			+ (mdl_asr(xv, 8) + (mdl_asr(xv, 7)&1));
+		ph -= 0x3d2ull;
+	} else if (!((ph >> (RADIX4CORDIC_PW-1))&1)) {
+		nx = xv
+			- (mdl_asr(yv, 8) + (mdl_asr(yv, 7)&1));
+		ny = yv
+			+ (mdl_asr(xv, 8) + (mdl_asr(xv, 7)&1));
+		ph -= 0x146ull;
+	} else if (ph >= 0x7fd75ull) {
+		nx = xv
+			+ (mdl_asr(yv, 8) + (mdl_asr(yv, 7)&1));
+		ny = yv
+			- (mdl_asr(xv, 8) + (mdl_asr(xv, 7)&1));
+		ph += 0x146ull;
+	} else {
+		nx = xv
+			+ (mdl_asr(yv, 7) + (mdl_asr(yv, 6)&1))
+			+ (mdl_asr(yv, 8) + (mdl_asr(yv, 7)&1));
+		ny = yv
+			- (mdl_asr(xv, 7) + (mdl_asr(xv, 6)&1))
+			- (mdl_asr(xv, 8) + (mdl_asr(xv, 7)&1));
+		ph += 0x3d2ull;
+	}
+	xv = mdl_sext(nx, RADIX4CORDIC_WW);
+	yv = mdl_sext(ny, RADIX4CORDIC_WW);
+	ph &= RADIX4CORDIC_PMASK;
+
+	// Stage 4, by atan(2^-9) and atan(2^-10)
+	if ((!((ph >> (RADIX4CORDIC_PW-1))&1))&&(ph >= 0xa2ull)) {
+		nx = xv
+			- (mdl_asr(yv, 9) + (mdl_asr(yv, 8)&1))
+			- (mdl_asr(yv, 10) + (mdl_asr(yv, 9)&1));
+		ny = yv
+			+ (mdl_asr(xv, 9) + (mdl_asr(xv, 8)&1))
+			+ (mdl_asr(xv, 10) + (mdl_asr(xv, 9)&1));
+		ph -= 0xf4ull;
+	} else if (!((ph >> (RADIX4CORDIC_PW-1))&1)) {
+		nx = xv
+			- (mdl_asr(yv, 10) + (mdl_asr(yv, 9)&1));
+		ny = yv
+			+ (mdl_asr(xv, 10) + (mdl_asr(xv, 9)&1));
+		ph -= 0x51ull;
+	} else if (ph >= 0x7ff5eull) {
+		nx = xv
+			+ (mdl_asr(yv, 10) + (mdl_asr(yv, 9)&1));
+		ny = yv
+			- (mdl_asr(xv, 10) + (mdl_asr(xv, 9)&1));
+		ph += 0x51ull;
+	} else {
+		nx = xv
+			+ (mdl_asr(yv, 9) + (mdl_asr(yv, 8)&1))
+			+ (mdl_asr(yv, 10) + (mdl_asr(yv, 9)&1));
+		ny = yv
+			- (mdl_asr(xv, 9) + (mdl_asr(xv, 8)&1))
+			- (mdl_asr(xv, 10) + (mdl_asr(xv, 9)&1));
+		ph += 0xf4ull;
+	}
+	xv = mdl_sext(nx, RADIX4CORDIC_WW);
+	yv = mdl_sext(ny, RADIX4CORDIC_WW);
+	ph &= RADIX4CORDIC_PMASK;
+
+	// Stage 5, by atan(2^-11) and atan(2^-12)
+	if ((!((ph >> (RADIX4CORDIC_PW-1))&1))&&(ph >= 0x28ull)) {
+		nx = xv
+			- (mdl_asr(yv, 11) + (mdl_asr(yv, 10)&1))
+			- (mdl_asr(yv, 12) + (mdl_asr(yv, 11)&1));
+		ny = yv
+			+ (mdl_asr(xv, 11) + (mdl_asr(xv, 10)&1))
+			+ (mdl_asr(xv, 12) + (mdl_asr(xv, 11)&1));
+		ph -= 0x3dull;
+	} else if (!((ph >> (RADIX4CORDIC_PW-1))&1)) {
+		nx = xv
+			- (mdl_asr(yv, 12) + (mdl_asr(yv, 11)&1));
+		ny = yv
+			+ (mdl_asr(xv, 12) + (mdl_asr(xv, 11)&1));
+		ph -= 0x14ull;
+	} else if (ph >= 0x7ffd8ull) {
+		nx = xv
+			+ (mdl_asr(yv, 12) + (mdl_asr(yv, 11)&1));
+		ny = yv
+			- (mdl_asr(xv, 12) + (mdl_asr(xv, 11)&1));
+		ph += 0x14ull;
+	} else {
+		nx = xv
+			+ (mdl_asr(yv, 11) + (mdl_asr(yv, 10)&1))
+			+ (mdl_asr(yv, 12) + (mdl_asr(yv, 11)&1));
+		ny = yv
+			- (mdl_asr(xv, 11) + (mdl_asr(xv, 10)&1))
+			- (mdl_asr(xv, 12) + (mdl_asr(xv, 11)&1));
+		ph += 0x3dull;
+	}
+	xv = mdl_sext(nx, RADIX4CORDIC_WW);
+	yv = mdl_sext(ny, RADIX4CORDIC_WW);
+	ph &= RADIX4CORDIC_PMASK;
+
+	// Stage 6, by atan(2^-13) and atan(2^-14)
+	if ((!((ph >> (RADIX4CORDIC_PW-1))&1))&&(ph >= 0xaull)) {
+		nx = xv
+			- (mdl_asr(yv, 13) + (mdl_asr(yv, 12)&1))
+			- (mdl_asr(yv, 14) + (mdl_asr(yv, 13)&1));
+		ny = yv
+			+ (mdl_asr(xv, 13) + (mdl_asr(xv, 12)&1))
+			+ (mdl_asr(xv, 14) + (mdl_asr(xv, 13)&1));
+		ph -= 0xfull;
+	} else if (!((ph >> (RADIX4CORDIC_PW-1))&1)) {
+		nx = xv
+			- (mdl_asr(yv, 14) + (mdl_asr(yv, 13)&1));
+		ny = yv
+			+ (mdl_asr(xv, 14) + (mdl_asr(xv, 13)&1));
+		ph -= 0x5ull;
+	} else if (ph >= 0x7fff6ull) {
+		nx = xv
+			+ (mdl_asr(yv, 14) + (mdl_asr(yv, 13)&1));
+		ny = yv
+			- (mdl_asr(xv, 14) + (mdl_asr(xv, 13)&1));
+		ph += 0x5ull;
+	} else {
+		nx = xv
+			+ (mdl_asr(yv, 13) + (mdl_asr(yv, 12)&1))
+			+ (mdl_asr(yv, 14) + (mdl_asr(yv, 13)&1));
+		ny = yv
+			- (mdl_asr(xv, 13) + (mdl_asr(xv, 12)&1))
+			- (mdl_asr(xv, 14) + (mdl_asr(xv, 13)&1));
+		ph += 0xfull;
+	}
+	xv = mdl_sext(nx, RADIX4CORDIC_WW);
+	yv = mdl_sext(ny, RADIX4CORDIC_WW);
+	ph &= RADIX4CORDIC_PMASK;
+
+	// Stage 7, by atan(2^-15) alone
+	if (!((ph >> (RADIX4CORDIC_PW-1))&1)) {
+		nx = xv - mdl_asr(yv, 15);
+		ny = yv + mdl_asr(xv, 15);
+		ph -= 0x2ull;
+	} else {
+		nx = xv + mdl_asr(yv, 15);
+		ny = yv - mdl_asr(xv, 15);
+		ph += 0x2ull;
+	}
+	xv = mdl_sext(nx, RADIX4CORDIC_WW);
+	yv = mdl_sext(ny, RADIX4CORDIC_WW);
+	ph &= RADIX4CORDIC_PMASK;
+
+	*o_xval = (int32_t)mdl_round(xv, RADIX4CORDIC_WW, RADIX4CORDIC_OW);
+	*o_yval = (int32_t)mdl_round(yv, RADIX4CORDIC_WW, RADIX4CORDIC_OW);
+}
+
+//
+// radix4cordic_p2r_batch
+//
+// Applies radix4cordic_p2r() to each of n samples.
+//
+static inline void	radix4cordic_p2r_batch(const int32_t *i_xval,
+			const int32_t *i_yval, const uint32_t *i_phase,
+			int32_t *o_xval, int32_t *o_yval, size_t n) {
+	// The digit selection keeps this off of the vectorized fast path
+	for(size_t i=0; i<n; i++)
+		radix4cordic_p2r(i_xval[i], i_yval[i], i_phase[i], &o_xval[i], &o_yval[i]);
+}
+
+#endif	// RADIX4CORDIC_MODEL_H
@@ -0,0 +1,473 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename: 	radix4polar_model.h
+//
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	This is a bit-accurate C++ software model of the core
+//		found in the Verilog file of the same name.  It was generated
+//	from the same parameters as that core, and should produce
+//	identical outputs for identical inputs.  Call it in place of
+//	running Verilator when you need the core's exact outputs at native
+//	speed.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2017-2018, Gisselquist Technology, LLC
+//
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+//
+// License:	GPL, v3, as defined and found on www.gnu.org,
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+//
+#ifndef	RADIX4POLAR_MODEL_H
+#define	RADIX4POLAR_MODEL_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifndef	GENCORDIC_MODEL_HELPERS
+#define	GENCORDIC_MODEL_HELPERS
+//
+// mdl_sext
+//
+// Sign extend the bottom w bits of v, dropping everything above them.
+// This captures the wrap-around of a w-bit Verilog register.
+static inline int64_t	mdl_sext(int64_t v, int w) {
+	return (int64_t)((uint64_t)v << (64-w)) >> (64-w);
+}
+
+//
+// mdl_shl
+//
+// A left shift, done unsigned so that it's defined even when v is
+// negative.
+static inline int64_t	mdl_shl(int64_t v, int s) {
+	return (int64_t)((uint64_t)v << s);
+}
+
+//
+// mdl_asr
+//
+// An arithmetic right shift that, like Verilog's >>>, doesn't mind
+// shifting by more bits than are in the word.
+static inline int64_t	mdl_asr(int64_t v, int s) {
+	return (s >= 63) ? ((v < 0) ? -1 : 0) : (v >> s);
+}
+
+//
+// mdl_round
+//
+// Drop a ww bit value down to ow bits.  If more than one bit is
+// dropped, round towards even first, just like the generated cores do.
+static inline int64_t	mdl_round(int64_t v, int ww, int ow) {
+	int	drop = ww - ow;
+
+	if (drop > 1) {
+		int64_t	half = (1ll<<(drop-1));
+
+		v += ((v >> drop)&1) ? half : (half-1);
+	}
+	return mdl_sext(v >> drop, ow);
+}
+#endif	// GENCORDIC_MODEL_HELPERS
+
+static const int	RADIX4POLAR_IW = 12,	// The number of bits in our inputs
+		RADIX4POLAR_OW = 12,	// The number of output bits to produce
+		RADIX4POLAR_NSTAGES = 16,
+		RADIX4POLAR_XTRA = 3,	// Extra bits for internal precision
+		RADIX4POLAR_WW = 18,	// Our working bit-width
+		RADIX4POLAR_PW = 19,	// Bits in our phase variables
+		RADIX4POLAR_LATENCY = 10;	// Clocks from input to output
+static const uint64_t	RADIX4POLAR_PMASK = 0x7ffffull;
+
+static const int	RADIX4POLAR_NPIPE = 8;	// Pipeline stages
+
+//
+// radix4polar_r2p
+//
+// Converts (i_xval, i_yval) to polar coordinates, producing exactly
+// what radix4polar.v would produce in o_mag and o_phase 10 clocks later.
+//
+static inline void	radix4polar_r2p(int32_t i_xval, int32_t i_yval,
+			int32_t *o_mag, uint32_t *o_phase) {
+	int64_t		e_xval, e_yval, xv, yv, nx, ny, ry;
+	uint64_t	ph;
+
+	// First step: expand our input to our working width.
+	e_xval = mdl_shl(mdl_sext(i_xval, RADIX4POLAR_IW), RADIX4POLAR_WW-RADIX4POLAR_IW-2);
+	e_yval = mdl_shl(mdl_sext(i_yval, RADIX4POLAR_IW), RADIX4POLAR_WW-RADIX4POLAR_IW-2);
+
+	// First stage, map to within +/- 45 degrees
+	switch(((e_xval < 0)?2:0)|((e_yval < 0)?1:0)) {
+	case 1:	// Rotate by -315 degrees
+		xv =  e_xval - e_yval; yv =  e_xval + e_yval; ph = 0x70000ull; break;
+	case 2:	// Rotate by -135 degrees
+		xv = -e_xval + e_yval; yv = -e_xval - e_yval; ph = 0x30000ull; break;
+	case 3:	// Rotate by -225 degrees
+		xv = -e_xval - e_yval; yv =  e_xval - e_yval; ph = 0x50000ull; break;
+	default:	// Rotate by -45 degrees
+		xv =  e_xval + e_yval; yv = -e_xval + e_yval; ph = 0x10000ull; break;
+	}
+	xv = mdl_sext(xv, RADIX4POLAR_WW);
+	yv = mdl_sext(yv, RADIX4POLAR_WW);
+
+	// Stage 0, by atan(2^-1) and atan(2^-2)
+	ry = mdl_sext((yv < 0) ? (yv + mdl_asr(xv, 1))
+			: (yv - mdl_asr(xv, 1)), RADIX4POLAR_WW);
+	if ((yv < 0)&&(ry < 0)) {
+		nx = xv
+			- (mdl_asr(yv, 1) + (mdl_asr(yv, 0)&1))
+			- (mdl_asr(yv, 2) + (mdl_asr(yv, 1)&1))
+			- (mdl_asr(xv, 3) + (mdl_asr(xv, 2)&1));
+		ny = yv
+			+ (mdl_asr(xv, 1) + (mdl_asr(xv, 0)&1))
+			+ (mdl_asr(xv, 2) + (mdl_asr(xv, 1)&1))
+			- (mdl_asr(yv, 3) + (mdl_asr(yv, 2)&1));
+		ph -= 0xe6faull;
+	} else if (yv < 0) {
+		nx = xv
+			- (mdl_asr(yv, 2) + (mdl_asr(yv, 1)&1))
+			+ (mdl_asr(xv, 3) + (mdl_asr(xv, 2)&1));
+		ny = yv
+			+ (mdl_asr(xv, 2) + (mdl_asr(xv, 1)&1))
+			+ (mdl_asr(yv, 3) + (mdl_asr(yv, 2)&1));
+		ph -= 0x4746ull;
+	} else if (ry >= 0) {
+		nx = xv
+			+ (mdl_asr(yv, 1) + (mdl_asr(yv, 0)&1))
+			+ (mdl_asr(yv, 2) + (mdl_asr(yv, 1)&1))
+			- (mdl_asr(xv, 3) + (mdl_asr(xv, 2)&1));
+		ny = yv
+			- (mdl_asr(xv, 1) + (mdl_asr(xv, 0)&1))
+			- (mdl_asr(xv, 2) + (mdl_asr(xv, 1)&1))
+			- (mdl_asr(yv, 3) + (mdl_asr(yv, 2)&1));
+		ph += 0xe6faull;
+	} else {
+		nx = xv
+			+ (mdl_asr(yv, 2) + (mdl_asr(yv, 1)&1))
+			+ (mdl_asr(xv, 3) + (mdl_asr(xv, 2)&1));
+		ny = yv
+			- (mdl_asr(xv, 2) + (mdl_asr(xv, 1)&1))
+			+ (mdl_asr(yv, 3) + (mdl_asr(yv, 2)&1));
+		ph += 0x4746ull;
+	}
+	xv = mdl_sext(nx, RADIX4POLAR_WW);
+	yv = mdl_sext(ny, RADIX4POLAR_WW);
+	ph &= RADIX4POLAR_PMASK;
+
+	// Stage 1, by atan(2^-3) and atan(2^-4)
+	ry = mdl_sext((yv < 0) ? (yv + mdl_asr(xv, 3))
+			: (yv - mdl_asr(xv, 3)), RADIX4POLAR_WW);
+	if ((yv < 0)&&(ry < 0)) {
+		nx = xv
+			- (mdl_asr(yv, 3) + (mdl_asr(yv, 2)&1))
+			- (mdl_asr(yv, 4) + (mdl_asr(yv, 3)&1))
+			- (mdl_asr(xv, 7) + (mdl_asr(xv, 6)&1));
+		ny = yv
+			+ (mdl_asr(xv, 3) + (mdl_asr(xv, 2)&1))
+			+ (mdl_asr(xv, 4) + (mdl_asr(xv, 3)&1))
+			- (mdl_asr(yv, 7) + (mdl_asr(yv, 6)&1));
+		ph -= 0x3ce1ull;
+	} else if (yv < 0) {
+		nx = xv
+			- (mdl_asr(yv, 4) + (mdl_asr(yv, 3)&1))
+			+ (mdl_asr(xv, 7) + (mdl_asr(xv, 6)&1));
+		ny = yv
+			+ (mdl_asr(xv, 4) + (mdl_asr(xv, 3)&1))
+			+ (mdl_asr(yv, 7) + (mdl_asr(yv, 6)&1));
+		ph -= 0x1430ull;
+	} else if (ry >= 0) {
+		nx = xv
+			+ (mdl_asr(yv, 3) + (mdl_asr(yv, 2)&1))
+			+ (mdl_asr(yv, 4) + (mdl_asr(yv, 3)&1))
+			- (mdl_asr(xv, 7) + (mdl_asr(xv, 6)&1));
+		ny = yv
+			- (mdl_asr(xv, 3) + (mdl_asr(xv, 2)&1))
+			- (mdl_asr(xv, 4) + (mdl_asr(xv, 3)&1))
+			- (mdl_asr(yv, 7) + (mdl_asr(yv, 6)&1));
+		ph += 0x3ce1ull;
+	} else {
+		nx = xv
+			+ (mdl_asr(yv, 4) + (mdl_asr(yv, 3)&1))
+			+ (mdl_asr(xv, 7) + (mdl_asr(xv, 6)&1));
+		ny = yv
+			- (mdl_asr(xv, 4) + (mdl_asr(xv, 3)&1))
+			+ (mdl_asr(yv, 7) + (mdl_asr(yv, 6)&1));
+		ph += 0x1430ull;
+	}
+	xv = mdl_sext(nx, RADIX4POLAR_WW);
+	yv = mdl_sext(ny, RADIX4POLAR_WW);
+	ph &= RADIX4POLAR_PMASK;
+
+	// Stage 2, by atan(2^-5) and atan(2^-6)
+	ry = mdl_sext((yv < 0) ? (yv + mdl_asr(xv, 5))
+			: (yv - mdl_asr(xv, 5)), RADIX4POLAR_WW);
+	if ((yv < 0)&&(ry < 0)) {
+		nx = xv
+			- (mdl_asr(yv, 5) + (mdl_asr(yv, 4)&1))
+			- (mdl_asr(yv, 6) + (mdl_asr(yv, 5)&1))
+			- (mdl_asr(xv, 11) + (mdl_asr(xv, 10)&1));
+		ny = yv
+			+ (mdl_asr(xv, 5) + (mdl_asr(xv, 4)&1))
+			+ (mdl_asr(xv, 6) + (mdl_asr(xv, 5)&1))
+			- (mdl_asr(yv, 11) + (mdl_asr(yv, 10)&1));
+		ph -= 0xf46ull;
+	} else if (yv < 0) {
+		nx = xv
+			- (mdl_asr(yv, 6) + (mdl_asr(yv, 5)&1))
+			+ (mdl_asr(xv, 11) + (mdl_asr(xv, 10)&1));
+		ny = yv
+			+ (mdl_asr(xv, 6) + (mdl_asr(xv, 5)&1))
+			+ (mdl_asr(yv, 11) + (mdl_asr(yv, 10)&1));
+		ph -= 0x517ull;
+	} else if (ry >= 0) {
+		nx = xv
+			+ (mdl_asr(yv, 5) + (mdl_asr(yv, 4)&1))
+			+ (mdl_asr(yv, 6) + (mdl_asr(yv, 5)&1))
+			- (mdl_asr(xv, 11) + (mdl_asr(xv, 10)&1));
+		ny = yv
+			- (mdl_asr(xv, 5) + (mdl_asr(xv, 4)&1))
+			- (mdl_asr(xv, 6) + (mdl_asr(xv, 5)&1))
+			- (mdl_asr(yv, 11) + (mdl_asr(yv, 10)&1));
+		ph += 0xf46ull;
+	} else {
+		nx = xv
+			+ (mdl_asr(yv, 6) + (mdl_asr(yv, 5)&1))
+			+ (mdl_asr(xv, 11) + (mdl_asr(xv, 10)&1));
+		ny = yv
+			- (mdl_asr(xv, 6) + (mdl_asr(xv, 5)&1))
+			+ (mdl_asr(yv, 11) + (mdl_asr(yv, 10)&1));
+		ph += 0x517ull;
+	}
+	xv = mdl_sext(nx, RADIX4POLAR_WW);
+	yv = mdl_sext(ny, RADIX4POLAR_WW);
+	ph &= RADIX4POLAR_PMASK;
+
+	// Stage 3, by atan(2^-7) and atan(2^-8)
+	ry = mdl_sext((yv < 0) ? (yv + mdl_asr(xv, 7))
+			: (yv - mdl_asr(xv, 7)), RADIX4POLAR_WW);
+	if ((yv < 0)&&(ry < 0)) {
+		nx = xv
+			- (mdl_asr(yv, 7) + (mdl_asr(yv, 6)&1))
+			- (mdl_asr(yv, 8) + (mdl_asr(yv, 7)&1))
+			- (mdl_asr(xv, 15) + (mdl_asr(xv, 14)&1));
+		ny = yv
+			+ (mdl_asr(xv, 7) + (mdl_asr(xv, 6)&1))
+			+ (mdl_asr(xv, 8) + (mdl_asr(xv, 7)&1))
+			- (mdl_asr(yv, 15) + (mdl_asr(yv, 14)&1));
+		ph -= 0x3d2ull;
+	} else if (yv < 0) {
+		nx = xv
+			- (mdl_asr(yv, 8) + (mdl_asr(yv, 7)&1))
+			+ (mdl_asr(xv, 15) + (mdl_asr(xv, 14)&1));
+		ny = yv
+			+ (mdl_asr(xv, 8) + (mdl_asr(xv, 7)&1))
+			+ (mdl_asr(yv, 15) + (mdl_asr(yv, 14)&1));
+		ph -= 0x146ull;
+	} else if (ry >= 0) {
+		nx = xv
+			+ (mdl_asr(yv, 7) + (mdl_asr(yv, 6)&1))
+			+ (mdl_asr(yv, 8) + (mdl_asr(yv, 7)&1))
+			- (mdl_asr(xv, 15) + (mdl_asr(xv, 14)&1));
+		ny = yv
+			- (mdl_asr(xv, 7) + (mdl_asr(xv, 6)&1))
+			- (mdl_asr(xv, 8) + (mdl_asr(xv, 7)&1))
+			- (mdl_asr(yv, 15) + (mdl_asr(yv, 14)&1));
+		ph += 0x3d2ull;
+	} else {
+		nx = xv
+			+ (mdl_asr(yv, 8) + (mdl_asr(yv, 7)&1))
+			+ (mdl_asr(xv, 15) + (mdl_asr(xv, 14)&1));
+		ny = yv
+			- (mdl_asr(xv, 8) + (mdl_asr(xv, 7)&1))
+			+ (mdl_asr(yv, 15) + (mdl_asr(yv, 14)&1));
+		ph += 0x146ull;
+	}
+	xv = mdl_sext(nx, RADIX4POLAR_WW);
+	yv = mdl_sext(ny, RADIX4POLAR_WW);
+	ph &= RADIX4POLAR_PMASK;
+
+	// Stage 4, by atan(2^-9) and atan(2^-10)
+	ry = mdl_sext((yv < 0) ? (yv + mdl_asr(xv, 9))
+			: (yv - mdl_asr(xv, 9)), RADIX4POLAR_WW);
+	if ((yv < 0)&&(ry < 0)) {
+		nx = xv
+			- (mdl_asr(yv, 9) + (mdl_asr(yv, 8)&1))
+			- (mdl_asr(yv, 10) + (mdl_asr(yv, 9)&1));
+		ny = yv
+			+ (mdl_asr(xv, 9) + (mdl_asr(xv, 8)&1))
+			+ (mdl_asr(xv, 10) + (mdl_asr(xv, 9)&1));
+		ph -= 0xf4ull;
+	} else if (yv < 0) {
+		nx = xv
+			- (mdl_asr(yv, 10) + (mdl_asr(yv, 9)&1));
+		ny = yv
+			+ (mdl_asr(xv, 10) + (mdl_asr(xv, 9)&1));
+		ph -= 0x51ull;
+	} else if (ry >= 0) {
+		nx = xv
+			+ (mdl_asr(yv, 9) + (mdl_asr(yv, 8)&1))
+			+ (mdl_asr(yv, 10) + (mdl_asr(yv, 9)&1));
+		ny = yv
+			- (mdl_asr(xv, 9) + (mdl_asr(xv, 8)&1))
+			- (mdl_asr(xv, 10) + (mdl_asr(xv, 9)&1));
+		ph += 0xf4ull;
+	} else {
+		nx = xv
+			+ (mdl_asr(yv, 10) + (mdl_asr(yv, 9)&1));
+		ny = yv
+			- (mdl_asr(xv, 10) + (mdl_asr(xv, 9)&1));
+		ph += 0x51ull;
+	}
+	xv = mdl_sext(nx, RADIX4POLAR_WW);
+	yv = mdl_sext(ny, RADIX4POLAR_WW);
+	ph &= RADIX4POLAR_PMASK;
+
+	// Stage 5, by atan(2^-11) and atan(2^-12)
+	ry = mdl_sext((yv < 0) ? (yv + mdl_asr(xv, 11))
+			: (yv - mdl_asr(xv, 11)), RADIX4POLAR_WW);
+	if ((yv < 0)&&(ry < 0)) {
+		nx = xv
+			- (mdl_asr(yv, 11) + (mdl_asr(yv, 10)&1))
+			- (mdl_asr(yv, 12) + (mdl_asr(yv, 11)&1));
+		ny = yv
+			+ (mdl_asr(xv, 11) + (mdl_asr(xv, 10)&1))
+			+ (mdl_asr(xv, 12) + (mdl_asr(xv, 11)&1));
+		ph -= 0x3dull;
+	} else if (yv < 0) {
+		nx = xv
+			- (mdl_asr(yv, 12) + (mdl_asr(yv, 11)&1));
+		ny = yv
+			+ (mdl_asr(xv, 12) + (mdl_asr(xv, 11)&1));
+		ph -= 0x14ull;
+	} else if (ry >= 0) {
+		nx = xv
+			+ (mdl_asr(yv, 11) + (mdl_asr(yv, 10)&1))
+			+ (mdl_asr(yv, 12) + (mdl_asr(yv, 11)&1));
+		ny = yv
+			- (mdl_asr(xv, 11) + (mdl_asr(xv, 10)&1))
+			- (mdl_asr(xv, 12) + (mdl_asr(xv, 11)&1));
+		ph += 0x3dull;
+	} else {
+		nx = xv
+			+ (mdl_asr(yv, 12) + (mdl_asr(yv, 11)&1));
+		ny = yv
+			- (mdl_asr(xv, 12) + (mdl_asr(xv, 11)&1));
+		ph += 0x14ull;
+	}
+	xv = mdl_sext(nx, RADIX4POLAR_WW);
+	yv = mdl_sext(ny, RADIX4POLAR_WW);
+	ph &= RADIX4POLAR_PMASK;
+
+	// Stage 6, by atan(2^-13) and atan(2^-14)
+	ry = mdl_sext((yv < 0) ? (yv + mdl_asr(xv, 13))
+			: (yv - mdl_asr(xv, 13)), RADIX4POLAR_WW);
+	if ((yv < 0)&&(ry < 0)) {
+		nx = xv
+			- (mdl_asr(yv, 13) + (mdl_asr(yv, 12)&1))
+			- (mdl_asr(yv, 14) + (mdl_asr(yv, 13)&1));
+		ny = yv
+			+ (mdl_asr(xv, 13) + (mdl_asr(xv, 12)&1))
+			+ (mdl_asr(xv, 14) + (mdl_asr(xv, 13)&1));
+		ph -= 0xfull;
+	} else if (yv < 0) {
+		nx = xv
+			- (mdl_asr(yv, 14) + (mdl_asr(yv, 13)&1));
+		ny = yv
+			+ (mdl_asr(xv, 14) + (mdl_asr(xv, 13)&1));
+		ph -= 0x5ull;
+	} else if (ry >= 0) {
+		nx = xv
+			+ (mdl_asr(yv, 13) + (mdl_asr(yv, 12)&1))
+			+ (mdl_asr(yv, 14) + (mdl_asr(yv, 13)&1));
+		ny = yv
+			- (mdl_asr(xv, 13) + (mdl_asr(xv, 12)&1))
+			- (mdl_asr(xv, 14) + (mdl_asr(xv, 13)&1));
+		ph += 0xfull;
+	} else {
+		nx = xv
+			+ (mdl_asr(yv, 14) + (mdl_asr(yv, 13)&1));
+		ny = yv
+			- (mdl_asr(xv, 14) + (mdl_asr(xv, 13)&1));
+		ph += 0x5ull;
+	}
+	xv = mdl_sext(nx, RADIX4POLAR_WW);
+	yv = mdl_sext(ny, RADIX4POLAR_WW);
+	ph &= RADIX4POLAR_PMASK;
+
+	// Stage 7, by atan(2^-15) and atan(2^-16)
+	ry = mdl_sext((yv < 0) ? (yv + mdl_asr(xv, 15))
+			: (yv - mdl_asr(xv, 15)), RADIX4POLAR_WW);
+	if ((yv < 0)&&(ry < 0)) {
+		nx = xv
+			- (mdl_asr(yv, 15) + (mdl_asr(yv, 14)&1))
+			- (mdl_asr(yv, 16) + (mdl_asr(yv, 15)&1));
+		ny = yv
+			+ (mdl_asr(xv, 15) + (mdl_asr(xv, 14)&1))
+			+ (mdl_asr(xv, 16) + (mdl_asr(xv, 15)&1));
+		ph -= 0x4ull;
+	} else if (yv < 0) {
+		nx = xv
+			- (mdl_asr(yv, 16) + (mdl_asr(yv, 15)&1));
+		ny = yv
+			+ (mdl_asr(xv, 16) + (mdl_asr(xv, 15)&1));
+		ph -= 0x1ull;
+	} else if (ry >= 0) {
+		nx = xv
+			+ (mdl_asr(yv, 15) + (mdl_asr(yv, 14)&1))
+			+ (mdl_asr(yv, 16) + (mdl_asr(yv, 15)&1));
+		ny = yv
+			- (mdl_asr(xv, 15) + (mdl_asr(xv, 14)&1))
+			- (mdl_asr(xv, 16) + (mdl_asr(xv, 15)&1));
+		ph += 0x4ull;
+	} else {
+		nx = xv
+			+ (mdl_asr(yv, 16) + (mdl_asr(yv, 15)&1));
+		ny = yv
+			- (mdl_asr(xv, 16) + (mdl_asr(xv, 15)&1));
+		ph += 0x1ull;
+	}
+	xv = mdl_sext(nx, RADIX4POLAR_WW);
+	yv = mdl_sext(ny, RADIX4POLAR_WW);
+	ph &= RADIX4POLAR_PMASK;
+
+	(void)ry;
+	*o_mag   = (int32_t)mdl_round(xv, RADIX4POLAR_WW, RADIX4POLAR_OW);
+	*o_phase = (uint32_t)ph;
+}
+
+//
+// radix4polar_r2p_batch
+//
+// Applies radix4polar_r2p() to each of n samples.
+//
+static inline void	radix4polar_r2p_batch(const int32_t *i_xval,
+			const int32_t *i_yval,
+			int32_t *o_mag, uint32_t *o_phase, size_t n) {
+	// The digit selection keeps this off of the vectorized fast path
+	for(size_t i=0; i<n; i++)
+		radix4polar_r2p(i_xval[i], i_yval[i], &o_mag[i], &o_phase[i]);
+}
+
+#endif	// RADIX4POLAR_MODEL_H
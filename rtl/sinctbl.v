@@ -0,0 +1,116 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename: 	../rtl/sinctbl.v
+//
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	A quarter-wave sine table lookup, using the symmetry of the
+//		sine wave to cut the table to a quarter of its size, but then
+//	building that quarter wave from two much smaller tables: a coarse
+//	table of the sine wave, and a fine table of the correction to it
+//	across each coarse step.  The two are added together, trading one
+//	adder and a clock for most of the table.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2017-2018, Gisselquist Technology, LLC
+//
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+//
+// License:	GPL, v3, as defined and found on www.gnu.org,
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+//
+module	sinctbl(i_clk, i_reset, i_ce, i_phase, i_aux, o_val, o_aux);
+	//
+	parameter	PW =18, // Number of bits in the input phase
+			OW =16; // Number of output bits
+	//
+	// The quarter wave index, LW bits, is split into AB, BB, and CB
+	// bits, MSB first.  Both tables carry GB bits below the output
+	// LSB, which are dropped once their entries are added.
+	localparam	LW = PW-2,
+			AB = 5, BB = 6, CB = 5,
+			GB = 3,
+			CW = OW+GB,	// Coarse table width
+			FW = 8;	// Fine table width
+	//
+	input				i_clk, i_reset, i_ce;
+	input	wire	[(PW-1):0]	i_phase;
+	output	reg	[(OW-1):0]	o_val;
+	//
+	input	wire			i_aux;
+	output	reg			o_aux;
+
+	reg	[(CW-1):0]	coarse	[0:((1<<(AB+BB))-1)];
+	reg	[(FW-1):0]	fine	[0:((1<<(AB+CB))-1)];
+
+	initial	$readmemh("sinctbl_coarse.hex", coarse);
+	initial	$readmemh("sinctbl_fine.hex", fine);
+
+	reg	[2:0]		negate;
+	reg	[(LW-1):0]	index;
+	reg	[(CW-1):0]	cval, sum;
+	reg	[(FW-1):0]	fval;
+
+	always @(posedge i_clk)
+	if (i_reset)
+	begin
+		negate  <= 3'b000;
+		index   <= 0;
+		cval    <= 0;
+		fval    <= 0;
+		sum     <= 0;
+		o_val   <= 0;
+	end else if (i_ce)
+	begin
+		// Clock #1
+		negate[0] <= i_phase[(PW-1)];
+		if (i_phase[(PW-2)])
+			index <= ~i_phase[(PW-3):0];
+		else
+			index <=  i_phase[(PW-3):0];
+
+		// Clock #2, both tables at once
+		cval <= coarse[index[(LW-1):CB]];
+		fval <= fine[{ index[(LW-1):(LW-AB)], index[(CB-1):0] }];
+		negate[1] <= negate[0];
+
+		// Clock #3, add the correction to the coarse value
+		sum <= cval + { {(CW-FW){fval[FW-1]}}, fval };
+		negate[2] <= negate[1];
+
+		// Output Clock, dropping the guard bits.  The coarse
+		// table already holds the half LSB that rounds them.
+		if (negate[2])
+			o_val <= -sum[(CW-1):GB];
+		else
+			o_val <=  sum[(CW-1):GB];
+	end
+
+	reg [2:0]	aux;
+	always @(posedge i_clk)
+	if (i_reset)
+		{ o_aux, aux } <= 0;
+	else if (i_ce)
+		{ o_aux, aux } <= { aux, i_aux };
+endmodule
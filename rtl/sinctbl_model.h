@@ -0,0 +1,647 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename: 	sinctbl_model.h
+//
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	This is a bit-accurate C++ software model of the core
+//		found in the Verilog file of the same name.  It was generated
+//	from the same parameters as that core, and should produce
+//	identical outputs for identical inputs.  Call it in place of
+//	running Verilator when you need the core's exact outputs at native
+//	speed.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2017-2018, Gisselquist Technology, LLC
+//
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+//
+// License:	GPL, v3, as defined and found on www.gnu.org,
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+//
+#ifndef	SINCTBL_MODEL_H
+#define	SINCTBL_MODEL_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifndef	GENCORDIC_MODEL_HELPERS
+#define	GENCORDIC_MODEL_HELPERS
+//
+// mdl_sext
+//
+// Sign extend the bottom w bits of v, dropping everything above them.
+// This captures the wrap-around of a w-bit Verilog register.
+static inline int64_t	mdl_sext(int64_t v, int w) {
+	return (int64_t)((uint64_t)v << (64-w)) >> (64-w);
+}
+
+//
+// mdl_shl
+//
+// A left shift, done unsigned so that it's defined even when v is
+// negative.
+static inline int64_t	mdl_shl(int64_t v, int s) {
+	return (int64_t)((uint64_t)v << s);
+}
+
+//
+// mdl_asr
+//
+// An arithmetic right shift that, like Verilog's >>>, doesn't mind
+// shifting by more bits than are in the word.
+static inline int64_t	mdl_asr(int64_t v, int s) {
+	return (s >= 63) ? ((v < 0) ? -1 : 0) : (v >> s);
+}
+
+//
+// mdl_round
+//
+// Drop a ww bit value down to ow bits.  If more than one bit is
+// dropped, round towards even first, just like the generated cores do.
+static inline int64_t	mdl_round(int64_t v, int ww, int ow) {
+	int	drop = ww - ow;
+
+	if (drop > 1) {
+		int64_t	half = (1ll<<(drop-1));
+
+		v += ((v >> drop)&1) ? half : (half-1);
+	}
+	return mdl_sext(v >> drop, ow);
+}
+#endif	// GENCORDIC_MODEL_HELPERS
+
+static const int	SINCTBL_PW = 18,	// Number of bits in the input phase
+		SINCTBL_OW = 16,	// Number of output bits
+		SINCTBL_AB = 5,	// Index bits shared by both tables
+		SINCTBL_BB = 6,	// Index bits of the coarse table alone
+		SINCTBL_CB = 5,	// Index bits of the fine table alone
+		SINCTBL_GB = 3,	// Guard bits, below the output LSB
+		SINCTBL_CW = 19,
+		SINCTBL_FW = 8,
+		SINCTBL_LATENCY = 4;	// Clocks from input to output
+
+static const int32_t	sinctbl_coarse[2048] = {
+	105, 306, 507, 708, 909, 1110,
+	1311, 1512, 1713, 1914, 2115, 2316,
+	2517, 2718, 2919, 3120, 3321, 3522,
+	3723, 3924, 4125, 4327, 4528, 4729,
+	4930, 5131, 5332, 5533, 5734, 5935,
+	6136, 6337, 6538, 6739, 6940, 7141,
+	7342, 7543, 7744, 7944, 8145, 8346,
+	8547, 8748, 8949, 9150, 9351, 9552,
+	9753, 9954, 10155, 10356, 10557, 10757,
+	10958, 11159, 11360, 11561, 11762, 11963,
+	12164, 12364, 12565, 12766, 12967, 13168,
+	13368, 13569, 13770, 13971, 14172, 14372,
+	14573, 14774, 14975, 15175, 15376, 15577,
+	15777, 15978, 16179, 16379, 16580, 16781,
+	16981, 17182, 17383, 17583, 17784, 17984,
+	18185, 18386, 18586, 18787, 18987, 19188,
+	19388, 19589, 19789, 19990, 20190, 20391,
+	20591, 20791, 20992, 21192, 21393, 21593,
+	21793, 21994, 22194, 22394, 22595, 22795,
+	22995, 23196, 23396, 23596, 23796, 23997,
+	24197, 24397, 24597, 24797, 24997, 25198,
+	25398, 25598, 25798, 25998, 26198, 26398,
+	26598, 26798, 26998, 27198, 27398, 27598,
+	27798, 27998, 28198, 28398, 28597, 28797,
+	28997, 29197, 29397, 29597, 29796, 29996,
+	30196, 30395, 30595, 30795, 30994, 31194,
+	31394, 31593, 31793, 31992, 32192, 32392,
+	32591, 32791, 32990, 33189, 33389, 33588,
+	33788, 33987, 34186, 34386, 34585, 34784,
+	34984, 35183, 35382, 35581, 35780, 35980,
+	36179, 36378, 36577, 36776, 36975, 37174,
+	37373, 37572, 37771, 37970, 38169, 38368,
+	38567, 38766, 38964, 39163, 39362, 39561,
+	39760, 39958, 40157, 40356, 40554, 40753,
+	40952, 41150, 41349, 41547, 41746, 41944,
+	42143, 42341, 42539, 42738, 42936, 43135,
+	43333, 43531, 43729, 43928, 44126, 44324,
+	44522, 44720, 44918, 45116, 45314, 45512,
+	45710, 45908, 46106, 46304, 46502, 46700,
+	46898, 47096, 47293, 47491, 47689, 47887,
+	48084, 48282, 48479, 48677, 48875, 49072,
+	49270, 49467, 49664, 49862, 50059, 50257,
+	50454, 50651, 50848, 51046, 51243, 51440,
+	51637, 51834, 52031, 52228, 52425, 52622,
+	52819, 53016, 53213, 53410, 53607, 53804,
+	54000, 54197, 54394, 54590, 54787, 54984,
+	55180, 55377, 55573, 55770, 55966, 56163,
+	56359, 56555, 56752, 56948, 57144, 57340,
+	57536, 57733, 57929, 58125, 58321, 58517,
+	58713, 58909, 59105, 59300, 59496, 59692,
+	59888, 60083, 60279, 60475, 60670, 60866,
+	61062, 61257, 61453, 61648, 61843, 62039,
+	62234, 62429, 62625, 62820, 63015, 63210,
+	63405, 63600, 63795, 63990, 64185, 64380,
+	64575, 64770, 64965, 65160, 65354, 65549,
+	65744, 65938, 66133, 66327, 66522, 66716,
+	66911, 67105, 67299, 67494, 67688, 67882,
+	68076, 68270, 68465, 68659, 68853, 69047,
+	69241, 69434, 69628, 69822, 70016, 70210,
+	70403, 70597, 70791, 70984, 71178, 71371,
+	71565, 71758, 71951, 72145, 72338, 72531,
+	72724, 72917, 73111, 73304, 73497, 73690,
+	73883, 74075, 74268, 74461, 74654, 74847,
+	75039, 75232, 75424, 75617, 75809, 76002,
+	76194, 76387, 76579, 76771, 76963, 77156,
+	77348, 77540, 77732, 77924, 78116, 78308,
+	78500, 78691, 78883, 79075, 79266, 79458,
+	79650, 79841, 80033, 80224, 80415, 80607,
+	80798, 80989, 81181, 81372, 81563, 81754,
+	81945, 82136, 82327, 82518, 82708, 82899,
+	83090, 83281, 83471, 83662, 83852, 84043,
+	84233, 84423, 84614, 84804, 84994, 85184,
+	85375, 85565, 85755, 85945, 86135, 86324,
+	86514, 86704, 86894, 87083, 87273, 87463,
+	87652, 87842, 88031, 88220, 88410, 88599,
+	88788, 88977, 89166, 89355, 89544, 89733,
+	89922, 90111, 90300, 90488, 90677, 90866,
+	91054, 91243, 91431, 91620, 91808, 91996,
+	92185, 92373, 92561, 92749, 92937, 93125,
+	93313, 93501, 93689, 93876, 94064, 94252,
+	94439, 94627, 94814, 95002, 95189, 95376,
+	95564, 95751, 95938, 96125, 96312, 96499,
+	96686, 96873, 97060, 97246, 97433, 97620,
+	97806, 97993, 98179, 98365, 98552, 98738,
+	98924, 99110, 99297, 99483, 99669, 99855,
+	100040, 100226, 100412, 100598, 100783, 100969,
+	101154, 101340, 101525, 101711, 101896, 102081,
+	102266, 102451, 102636, 102821, 103006, 103191,
+	103376, 103561, 103745, 103930, 104114, 104299,
+	104483, 104668, 104852, 105036, 105220, 105405,
+	105589, 105773, 105957, 106140, 106324, 106508,
+	106692, 106875, 107059, 107242, 107426, 107609,
+	107792, 107976, 108159, 108342, 108525, 108708,
+	108891, 109074, 109257, 109439, 109622, 109805,
+	109987, 110170, 110352, 110534, 110717, 110899,
+	111081, 111263, 111445, 111627, 111809, 111991,
+	112172, 112354, 112536, 112717, 112899, 113080,
+	113262, 113443, 113624, 113805, 113986, 114167,
+	114348, 114529, 114710, 114891, 115071, 115252,
+	115433, 115613, 115793, 115974, 116154, 116334,
+	116514, 116695, 116875, 117054, 117234, 117414,
+	117594, 117774, 117953, 118133, 118312, 118491,
+	118671, 118850, 119029, 119208, 119387, 119566,
+	119745, 119924, 120103, 120281, 120460, 120639,
+	120817, 120995, 121174, 121352, 121530, 121708,
+	121886, 122064, 122242, 122420, 122598, 122775,
+	122953, 123131, 123308, 123485, 123663, 123840,
+	124017, 124194, 124371, 124548, 124725, 124902,
+	125079, 125255, 125432, 125608, 125785, 125961,
+	126137, 126314, 126490, 126666, 126842, 127018,
+	127194, 127369, 127545, 127721, 127896, 128072,
+	128247, 128422, 128598, 128773, 128948, 129123,
+	129298, 129473, 129647, 129822, 129997, 130171,
+	130346, 130520, 130695, 130869, 131043, 131217,
+	131391, 131565, 131739, 131913, 132086, 132260,
+	132434, 132607, 132780, 132954, 133127, 133300,
+	133473, 133646, 133819, 133992, 134165, 134337,
+	134510, 134683, 134855, 135027, 135200, 135372,
+	135544, 135716, 135888, 136060, 136232, 136404,
+	136575, 136747, 136918, 137090, 137261, 137432,
+	137603, 137775, 137946, 138116, 138287, 138458,
+	138629, 138799, 138970, 139140, 139311, 139481,
+	139651, 139821, 139991, 140161, 140331, 140501,
+	140671, 140840, 141010, 141179, 141348, 141518,
+	141687, 141856, 142025, 142194, 142363, 142532,
+	142700, 142869, 143038, 143206, 143374, 143543,
+	143711, 143879, 144047, 144215, 144383, 144551,
+	144718, 144886, 145053, 145221, 145388, 145555,
+	145723, 145890, 146057, 146224, 146390, 146557,
+	146724, 146890, 147057, 147223, 147390, 147556,
+	147722, 147888, 148054, 148220, 148386, 148551,
+	148717, 148882, 149048, 149213, 149378, 149544,
+	149709, 149874, 150039, 150203, 150368, 150533,
+	150697, 150862, 151026, 151191, 151355, 151519,
+	151683, 151847, 152011, 152174, 152338, 152502,
+	152665, 152829, 152992, 153155, 153318, 153481,
+	153644, 153807, 153970, 154132, 154295, 154458,
+	154620, 154782, 154944, 155107, 155269, 155431,
+	155592, 155754, 155916, 156077, 156239, 156400,
+	156562, 156723, 156884, 157045, 157206, 157367,
+	157528, 157688, 157849, 158009, 158170, 158330,
+	158490, 158650, 158810, 158970, 159130, 159290,
+	159449, 159609, 159768, 159928, 160087, 160246,
+	160405, 160564, 160723, 160882, 161040, 161199,
+	161358, 161516, 161674, 161833, 161991, 162149,
+	162307, 162464, 162622, 162780, 162937, 163095,
+	163252, 163409, 163567, 163724, 163881, 164038,
+	164194, 164351, 164508, 164664, 164820, 164977,
+	165133, 165289, 165445, 165601, 165757, 165912,
+	166068, 166224, 166379, 166534, 166690, 166845,
+	167000, 167155, 167309, 167464, 167619, 167773,
+	167928, 168082, 168236, 168391, 168545, 168698,
+	168852, 169006, 169160, 169313, 169467, 169620,
+	169773, 169926, 170079, 170232, 170385, 170538,
+	170691, 170843, 170996, 171148, 171300, 171452,
+	171604, 171756, 171908, 172060, 172212, 172363,
+	172515, 172666, 172817, 172968, 173119, 173270,
+	173421, 173572, 173722, 173873, 174023, 174174,
+	174324, 174474, 174624, 174774, 174924, 175073,
+	175223, 175372, 175522, 175671, 175820, 175969,
+	176118, 176267, 176416, 176565, 176713, 176862,
+	177010, 177158, 177306, 177454, 177602, 177750,
+	177898, 178045, 178193, 178340, 178488, 178635,
+	178782, 178929, 179076, 179223, 179369, 179516,
+	179662, 179809, 179955, 180101, 180247, 180393,
+	180539, 180685, 180830, 180976, 181121, 181266,
+	181412, 181557, 181702, 181847, 181991, 182136,
+	182280, 182425, 182569, 182713, 182858, 183002,
+	183145, 183289, 183433, 183577, 183720, 183863,
+	184007, 184150, 184293, 184436, 184579, 184721,
+	184864, 185006, 185149, 185291, 185433, 185575,
+	185717, 185859, 186001, 186142, 186284, 186425,
+	186567, 186708, 186849, 186990, 187131, 187271,
+	187412, 187553, 187693, 187833, 187974, 188114,
+	188254, 188393, 188533, 188673, 188812, 188952,
+	189091, 189230, 189369, 189508, 189647, 189786,
+	189925, 190063, 190201, 190340, 190478, 190616,
+	190754, 190892, 191030, 191167, 191305, 191442,
+	191579, 191717, 191854, 191991, 192127, 192264,
+	192401, 192537, 192674, 192810, 192946, 193082,
+	193218, 193354, 193490, 193625, 193761, 193896,
+	194031, 194166, 194301, 194436, 194571, 194706,
+	194840, 194975, 195109, 195243, 195378, 195511,
+	195645, 195779, 195913, 196046, 196180, 196313,
+	196446, 196579, 196712, 196845, 196978, 197110,
+	197243, 197375, 197507, 197640, 197772, 197904,
+	198035, 198167, 198299, 198430, 198561, 198693,
+	198824, 198955, 199085, 199216, 199347, 199477,
+	199608, 199738, 199868, 199998, 200128, 200258,
+	200388, 200517, 200647, 200776, 200905, 201034,
+	201163, 201292, 201421, 201549, 201678, 201806,
+	201935, 202063, 202191, 202319, 202446, 202574,
+	202702, 202829, 202956, 203084, 203211, 203338,
+	203464, 203591, 203718, 203844, 203971, 204097,
+	204223, 204349, 204475, 204601, 204726, 204852,
+	204977, 205102, 205227, 205352, 205477, 205602,
+	205727, 205851, 205976, 206100, 206224, 206348,
+	206472, 206596, 206720, 206843, 206967, 207090,
+	207213, 207336, 207459, 207582, 207705, 207828,
+	207950, 208072, 208195, 208317, 208439, 208561,
+	208682, 208804, 208925, 209047, 209168, 209289,
+	209410, 209531, 209652, 209772, 209893, 210013,
+	210134, 210254, 210374, 210494, 210613, 210733,
+	210853, 210972, 211091, 211210, 211329, 211448,
+	211567, 211686, 211804, 211923, 212041, 212159,
+	212277, 212395, 212513, 212631, 212748, 212865,
+	212983, 213100, 213217, 213334, 213451, 213567,
+	213684, 213800, 213916, 214033, 214149, 214265,
+	214380, 214496, 214611, 214727, 214842, 214957,
+	215072, 215187, 215302, 215417, 215531, 215645,
+	215760, 215874, 215988, 216102, 216215, 216329,
+	216443, 216556, 216669, 216782, 216895, 217008,
+	217121, 217233, 217346, 217458, 217570, 217682,
+	217794, 217906, 218018, 218130, 218241, 218352,
+	218463, 218575, 218685, 218796, 218907, 219017,
+	219128, 219238, 219348, 219458, 219568, 219678,
+	219788, 219897, 220007, 220116, 220225, 220334,
+	220443, 220552, 220660, 220769, 220877, 220985,
+	221093, 221201, 221309, 221417, 221524, 221632,
+	221739, 221846, 221953, 222060, 222167, 222274,
+	222380, 222487, 222593, 222699, 222805, 222911,
+	223016, 223122, 223228, 223333, 223438, 223543,
+	223648, 223753, 223858, 223962, 224067, 224171,
+	224275, 224379, 224483, 224587, 224690, 224794,
+	224897, 225000, 225104, 225207, 225309, 225412,
+	225515, 225617, 225719, 225822, 225924, 226025,
+	226127, 226229, 226330, 226432, 226533, 226634,
+	226735, 226836, 226937, 227037, 227138, 227238,
+	227338, 227438, 227538, 227638, 227737, 227837,
+	227936, 228036, 228135, 228234, 228332, 228431,
+	228530, 228628, 228726, 228825, 228923, 229021,
+	229118, 229216, 229313, 229411, 229508, 229605,
+	229702, 229799, 229895, 229992, 230088, 230185,
+	230281, 230377, 230473, 230568, 230664, 230759,
+	230855, 230950, 231045, 231140, 231235, 231329,
+	231424, 231518, 231612, 231707, 231800, 231894,
+	231988, 232082, 232175, 232268, 232361, 232454,
+	232547, 232640, 232733, 232825, 232917, 233010,
+	233102, 233193, 233285, 233377, 233468, 233560,
+	233651, 233742, 233833, 233924, 234014, 234105,
+	234195, 234286, 234376, 234466, 234556, 234645,
+	234735, 234824, 234914, 235003, 235092, 235181,
+	235269, 235358, 235446, 235535, 235623, 235711,
+	235799, 235887, 235974, 236062, 236149, 236236,
+	236324, 236410, 236497, 236584, 236670, 236757,
+	236843, 236929, 237015, 237101, 237187, 237272,
+	237358, 237443, 237528, 237613, 237698, 237782,
+	237867, 237951, 238036, 238120, 238204, 238288,
+	238372, 238455, 238539, 238622, 238705, 238788,
+	238871, 238954, 239036, 239119, 239201, 239283,
+	239365, 239447, 239529, 239611, 239692, 239773,
+	239855, 239936, 240017, 240097, 240178, 240258,
+	240339, 240419, 240499, 240579, 240659, 240738,
+	240818, 240897, 240976, 241055, 241134, 241213,
+	241292, 241370, 241449, 241527, 241605, 241683,
+	241761, 241838, 241916, 241993, 242071, 242148,
+	242225, 242301, 242378, 242455, 242531, 242607,
+	242683, 242759, 242835, 242911, 242986, 243061,
+	243137, 243212, 243287, 243362, 243436, 243511,
+	243585, 243659, 243733, 243807, 243881, 243955,
+	244028, 244102, 244175, 244248, 244321, 244394,
+	244466, 244539, 244611, 244683, 244755, 244827,
+	244899, 244971, 245042, 245114, 245185, 245256,
+	245327, 245398, 245468, 245539, 245609, 245679,
+	245749, 245819, 245889, 245959, 246028, 246097,
+	246167, 246236, 246305, 246373, 246442, 246510,
+	246579, 246647, 246715, 246783, 246850, 246918,
+	246985, 247053, 247120, 247187, 247254, 247321,
+	247387, 247454, 247520, 247586, 247652, 247718,
+	247783, 247849, 247914, 247980, 248045, 248110,
+	248175, 248239, 248304, 248368, 248432, 248496,
+	248560, 248624, 248688, 248751, 248815, 248878,
+	248941, 249004, 249067, 249129, 249192, 249254,
+	249316, 249378, 249440, 249502, 249564, 249625,
+	249686, 249748, 249809, 249869, 249930, 249991,
+	250051, 250111, 250172, 250232, 250291, 250351,
+	250411, 250470, 250529, 250588, 250647, 250706,
+	250765, 250823, 250882, 250940, 250998, 251056,
+	251114, 251171, 251229, 251286, 251343, 251400,
+	251457, 251514, 251571, 251627, 251683, 251739,
+	251795, 251851, 251907, 251963, 252018, 252073,
+	252128, 252183, 252238, 252293, 252347, 252402,
+	252456, 252510, 252564, 252618, 252671, 252725,
+	252778, 252831, 252884, 252937, 252990, 253042,
+	253095, 253147, 253199, 253251, 253303, 253355,
+	253406, 253458, 253509, 253560, 253611, 253662,
+	253712, 253763, 253813, 253863, 253914, 253963,
+	254013, 254063, 254112, 254162, 254211, 254260,
+	254309, 254357, 254406, 254454, 254502, 254551,
+	254598, 254646, 254694, 254741, 254789, 254836,
+	254883, 254930, 254977, 255023, 255070, 255116,
+	255162, 255208, 255254, 255300, 255345, 255391,
+	255436, 255481, 255526, 255571, 255616, 255660,
+	255704, 255749, 255793, 255837, 255880, 255924,
+	255967, 256011, 256054, 256097, 256140, 256182,
+	256225, 256267, 256310, 256352, 256394, 256435,
+	256477, 256518, 256560, 256601, 256642, 256683,
+	256724, 256764, 256805, 256845, 256885, 256925,
+	256965, 257005, 257044, 257083, 257123, 257162,
+	257201, 257239, 257278, 257317, 257355, 257393,
+	257431, 257469, 257507, 257544, 257582, 257619,
+	257656, 257693, 257730, 257766, 257803, 257839,
+	257875, 257911, 257947, 257983, 258019, 258054,
+	258089, 258125, 258160, 258194, 258229, 258264,
+	258298, 258332, 258366, 258400, 258434, 258467,
+	258501, 258534, 258567, 258600, 258633, 258666,
+	258699, 258731, 258763, 258795, 258827, 258859,
+	258891, 258922, 258953, 258985, 259016, 259047,
+	259077, 259108, 259138, 259168, 259199, 259229,
+	259258, 259288, 259318, 259347, 259376, 259405,
+	259434, 259463, 259491, 259520, 259548, 259576,
+	259604, 259632, 259660, 259687, 259714, 259742,
+	259769, 259796, 259822, 259849, 259875, 259902,
+	259928, 259954, 259980, 260005, 260031, 260056,
+	260082, 260107, 260132, 260156, 260181, 260205,
+	260230, 260254, 260278, 260302, 260325, 260349,
+	260372, 260396, 260419, 260442, 260464, 260487,
+	260509, 260532, 260554, 260576, 260598, 260619,
+	260641, 260662, 260684, 260705, 260726, 260746,
+	260767, 260788, 260808, 260828, 260848, 260868,
+	260888, 260907, 260927, 260946, 260965, 260984,
+	261003, 261021, 261040, 261058, 261076, 261094,
+	261112, 261130, 261147, 261165, 261182, 261199,
+	261216, 261233, 261249, 261266, 261282, 261298,
+	261314, 261330, 261346, 261362, 261377, 261392,
+	261407, 261422, 261437, 261452, 261466, 261481,
+	261495, 261509, 261523, 261536, 261550, 261563,
+	261577, 261590, 261603, 261615, 261628, 261641,
+	261653, 261665, 261677, 261689, 261701, 261712,
+	261724, 261735, 261746, 261757, 261768, 261778,
+	261789, 261799, 261809, 261819, 261829, 261839,
+	261848, 261858, 261867, 261876, 261885, 261894,
+	261903, 261911, 261919, 261928, 261936, 261943,
+	261951, 261959, 261966, 261973, 261980, 261987,
+	261994, 262001, 262007, 262014, 262020, 262026,
+	262032, 262037, 262043, 262048, 262053, 262059,
+	262063, 262068, 262073, 262077, 262082, 262086,
+	262090, 262094, 262097, 262101, 262104, 262108,
+	262111, 262114, 262116, 262119, 262121, 262124,
+	262126, 262128, 262130, 262131, 262133, 262134,
+	262136, 262137, 262138, 262138, 262139, 262140,
+	262140, 262140
+};
+
+static const int32_t	sinctbl_fine[1024] = {
+	-97, -91, -85, -79, -72, -66,
+	-60, -53, -47, -41, -35, -28,
+	-22, -16, -9, -3, 3, 9,
+	16, 22, 28, 35, 41, 47,
+	53, 60, 66, 72, 79, 85,
+	91, 97, -97, -91, -85, -78,
+	-72, -66, -60, -53, -47, -41,
+	-34, -28, -22, -16, -9, -3,
+	3, 9, 16, 22, 28, 34,
+	41, 47, 53, 60, 66, 72,
+	78, 85, 91, 97, -97, -90,
+	-84, -78, -72, -65, -59, -53,
+	-47, -41, -34, -28, -22, -16,
+	-9, -3, 3, 9, 16, 22,
+	28, 34, 41, 47, 53, 59,
+	65, 72, 78, 84, 90, 97,
+	-96, -90, -84, -77, -71, -65,
+	-59, -53, -46, -40, -34, -28,
+	-22, -15, -9, -3, 3, 9,
+	15, 22, 28, 34, 40, 46,
+	53, 59, 65, 71, 77, 84,
+	90, 96, -95, -89, -83, -77,
+	-70, -64, -58, -52, -46, -40,
+	-34, -28, -21, -15, -9, -3,
+	3, 9, 15, 21, 28, 34,
+	40, 46, 52, 58, 64, 70,
+	77, 83, 89, 95, -94, -88,
+	-82, -76, -70, -64, -58, -51,
+	-45, -39, -33, -27, -21, -15,
+	-9, -3, 3, 9, 15, 21,
+	27, 33, 39, 45, 51, 58,
+	64, 70, 76, 82, 88, 94,
+	-92, -87, -81, -75, -69, -63,
+	-57, -51, -45, -39, -33, -27,
+	-21, -15, -9, -3, 3, 9,
+	15, 21, 27, 33, 39, 45,
+	51, 57, 63, 69, 75, 81,
+	87, 92, -91, -85, -79, -73,
+	-67, -62, -56, -50, -44, -38,
+	-32, -26, -21, -15, -9, -3,
+	3, 9, 15, 21, 26, 32,
+	38, 44, 50, 56, 62, 67,
+	73, 79, 85, 91, -89, -83,
+	-78, -72, -66, -60, -55, -49,
+	-43, -37, -32, -26, -20, -14,
+	-9, -3, 3, 9, 14, 20,
+	26, 32, 37, 43, 49, 55,
+	60, 66, 72, 78, 83, 89,
+	-87, -81, -76, -70, -65, -59,
+	-53, -48, -42, -36, -31, -25,
+	-20, -14, -8, -3, 3, 8,
+	14, 20, 25, 31, 36, 42,
+	48, 53, 59, 65, 70, 76,
+	81, 87, -85, -79, -74, -68,
+	-63, -57, -52, -46, -41, -36,
+	-30, -25, -19, -14, -8, -3,
+	3, 8, 14, 19, 25, 30,
+	36, 41, 46, 52, 57, 63,
+	68, 74, 79, 85, -82, -77,
+	-72, -66, -61, -56, -50, -45,
+	-40, -35, -29, -24, -19, -13,
+	-8, -3, 3, 8, 13, 19,
+	24, 29, 35, 40, 45, 50,
+	56, 61, 66, 72, 77, 82,
+	-80, -74, -69, -64, -59, -54,
+	-49, -44, -39, -33, -28, -23,
+	-18, -13, -8, -3, 3, 8,
+	13, 18, 23, 28, 33, 39,
+	44, 49, 54, 59, 64, 69,
+	74, 80, -77, -72, -67, -62,
+	-57, -52, -47, -42, -37, -32,
+	-27, -22, -17, -12, -7, -2,
+	2, 7, 12, 17, 22, 27,
+	32, 37, 42, 47, 52, 57,
+	62, 67, 72, 77, -74, -69,
+	-64, -59, -55, -50, -45, -40,
+	-36, -31, -26, -21, -17, -12,
+	-7, -2, 2, 7, 12, 17,
+	21, 26, 31, 36, 40, 45,
+	50, 55, 59, 64, 69, 74,
+	-71, -66, -61, -57, -52, -48,
+	-43, -39, -34, -30, -25, -20,
+	-16, -11, -7, -2, 2, 7,
+	11, 16, 20, 25, 30, 34,
+	39, 43, 48, 52, 57, 61,
+	66, 71, -67, -63, -58, -54,
+	-50, -45, -41, -37, -32, -28,
+	-24, -19, -15, -11, -6, -2,
+	2, 6, 11, 15, 19, 24,
+	28, 32, 37, 41, 45, 50,
+	54, 58, 63, 67, -64, -60,
+	-55, -51, -47, -43, -39, -35,
+	-31, -27, -23, -18, -14, -10,
+	-6, -2, 2, 6, 10, 14,
+	18, 23, 27, 31, 35, 39,
+	43, 47, 51, 55, 60, 64,
+	-60, -56, -52, -48, -44, -41,
+	-37, -33, -29, -25, -21, -17,
+	-14, -10, -6, -2, 2, 6,
+	10, 14, 17, 21, 25, 29,
+	33, 37, 41, 44, 48, 52,
+	56, 60, -56, -52, -49, -45,
+	-42, -38, -34, -31, -27, -24,
+	-20, -16, -13, -9, -5, -2,
+	2, 5, 9, 13, 16, 20,
+	24, 27, 31, 34, 38, 42,
+	45, 49, 52, 56, -52, -49,
+	-45, -42, -39, -35, -32, -29,
+	-25, -22, -18, -15, -12, -8,
+	-5, -2, 2, 5, 8, 12,
+	15, 18, 22, 25, 29, 32,
+	35, 39, 42, 45, 49, 52,
+	-48, -45, -42, -39, -36, -33,
+	-29, -26, -23, -20, -17, -14,
+	-11, -8, -5, -2, 2, 5,
+	8, 11, 14, 17, 20, 23,
+	26, 29, 33, 36, 39, 42,
+	45, 48, -44, -41, -38, -35,
+	-32, -30, -27, -24, -21, -18,
+	-16, -13, -10, -7, -4, -1,
+	1, 4, 7, 10, 13, 16,
+	18, 21, 24, 27, 30, 32,
+	35, 38, 41, 44, -39, -37,
+	-34, -32, -29, -27, -24, -22,
+	-19, -17, -14, -11, -9, -6,
+	-4, -1, 1, 4, 6, 9,
+	11, 14, 17, 19, 22, 24,
+	27, 29, 32, 34, 37, 39,
+	-35, -33, -31, -28, -26, -24,
+	-21, -19, -17, -15, -12, -10,
+	-8, -6, -3, -1, 1, 3,
+	6, 8, 10, 12, 15, 17,
+	19, 21, 24, 26, 28, 31,
+	33, 35, -31, -29, -27, -25,
+	-23, -21, -19, -17, -15, -13,
+	-11, -9, -7, -5, -3, -1,
+	1, 3, 5, 7, 9, 11,
+	13, 15, 17, 19, 21, 23,
+	25, 27, 29, 31, -26, -24,
+	-23, -21, -19, -18, -16, -14,
+	-13, -11, -9, -8, -6, -4,
+	-3, -1, 1, 3, 4, 6,
+	8, 9, 11, 13, 14, 16,
+	18, 19, 21, 23, 24, 26,
+	-21, -20, -19, -17, -16, -14,
+	-13, -12, -10, -9, -8, -6,
+	-5, -3, -2, -1, 1, 2,
+	3, 5, 6, 8, 9, 10,
+	12, 13, 14, 16, 17, 19,
+	20, 21, -17, -16, -15, -13,
+	-12, -11, -10, -9, -8, -7,
+	-6, -5, -4, -3, -2, -1,
+	1, 2, 3, 4, 5, 6,
+	7, 8, 9, 10, 11, 12,
+	13, 15, 16, 17, -12, -11,
+	-10, -10, -9, -8, -7, -7,
+	-6, -5, -4, -3, -3, -2,
+	-1, 0, 0, 1, 2, 3,
+	3, 4, 5, 6, 7, 7,
+	8, 9, 10, 10, 11, 12,
+	-7, -7, -6, -6, -5, -5,
+	-4, -4, -3, -3, -3, -2,
+	-2, -1, -1, 0, 0, 1,
+	1, 2, 2, 3, 3, 3,
+	4, 4, 5, 5, 6, 6,
+	7, 7, -2, -2, -2, -2,
+	-2, -2, -1, -1, -1, -1,
+	-1, -1, -1, 0, 0, 0,
+	0, 0, 0, 1, 1, 1,
+	1, 1, 1, 1, 2, 2,
+	2, 2, 2, 2
+};
+
+//
+// sinctbl_sin
+//
+// Returns what sinctbl.v would produce in o_val, sign extended, 4 clocks
+// after i_phase is given to it.
+//
+static inline int32_t	sinctbl_sin(uint32_t i_phase) {
+	const	uint32_t	lmsk = (1u<<(SINCTBL_PW-2))-1;
+	uint32_t	index, fidx;
+	int64_t		v;
+
+	index = i_phase & lmsk;
+	if ((i_phase >> (SINCTBL_PW-2))&1)
+		index = (~index) & lmsk;
+	fidx = ((index >> (SINCTBL_BB+SINCTBL_CB)) << SINCTBL_CB)
+		| (index & ((1u<<SINCTBL_CB)-1));
+	v = (int64_t)sinctbl_coarse[index >> SINCTBL_CB] + sinctbl_fine[fidx];
+	v = mdl_sext(v, SINCTBL_CW) >> SINCTBL_GB;
+	if ((i_phase >> (SINCTBL_PW-1))&1)
+		v = -v;
+	return (int32_t)mdl_sext(v, SINCTBL_OW);
+}
+
+#endif	// SINCTBL_MODEL_H
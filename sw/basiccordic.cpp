@@ -45,13 +45,19 @@
 #include "legal.h"
 #include "cordiclib.h"
 #include "basiccordic.h"
+#include "swmodel.h"
+#include "lanes.h"
+#include "channels.h"
 
 void	basiccordic(FILE *fp, FILE *fhp, const char *fname,
 		int nstages, int iw, int ow, int nxtra,
 		int phase_bits,
-		bool with_reset, bool with_aux, bool async_reset) {
-	int	working_width = iw;
-	const	char *name;
+		bool with_reset, bool with_aux, bool async_reset,
+		FILE *fmp, int nlanes, int kstages, int nchannels,
+		bool phase_acc) {
+	int	working_width = iw, npipe;
+	const	char *name, *depth;
+	std::string	lanename, pipeparam;
 	const	char PURPOSE[] =
 	"This file executes a vector rotation on the values\n"
 	"//\t\t(i_xval, i_yval).  This vector is rotated left by\n"
@@ -71,6 +77,23 @@ void	basiccordic(FILE *fp, FILE *fhp, const char *fname,
 		working_width = ow;
 	working_width += nxtra;
 
+	// With kstages > 1, each pipeline stage applies kstages CORDIC
+	// stages.  Round the number of stages up to a multiple of kstages,
+	// since the extra stages cost no more clocks.
+	npipe = nstages;
+	depth = "NSTAGES";
+	if (kstages > 1) {
+		char	str[160];
+
+		nstages = ((nstages + kstages - 1) / kstages) * kstages;
+		npipe = nstages / kstages;
+		depth = "NPIPE";
+		sprintf(str, "\t\t\tKSTAGES=%2d,\t// CORDIC stages per clock\n"
+			"\t\t\tNPIPE=%2d,\t// Pipeline stages, KSTAGES CORDIC stages each\n",
+			kstages, npipe);
+		pipeparam = str;
+	}
+
 	std::string	resetw = (!with_reset)?""
 			: ((async_reset)?"i_areset_n" : "i_reset");
 	std::string	always_reset = "\talways @(posedge i_clk)\n\t";
@@ -82,6 +105,15 @@ void	basiccordic(FILE *fp, FILE *fhp, const char *fname,
 				"\tif (i_reset)\n";
 
 	name = modulename(fname);
+	// With more than one lane, this module becomes the lane, and the
+	// module by the requested name is built from copies of it below.
+	// Likewise, with more than one channel, this module becomes the
+	// core the channels share.
+	lanename = name;
+	if (nlanes > 1)
+		lanename += "_lane";
+	else if (nchannels > 1)
+		lanename += "_core";
 
 	fprintf(fp, "`default_nettype\tnone\n//\n");
 	fprintf(fp,
@@ -89,7 +121,7 @@ void	basiccordic(FILE *fp, FILE *fhp, const char *fname,
 		"\t\to_xval, o_yval%s);\n"
 		"\tlocalparam\tIW=%2d,\t// The number of bits in our inputs\n"
 		"\t\t\tOW=%2d,\t// The number of output bits to produce\n"
-		"\t\t\tNSTAGES=%2d,\n"
+		"\t\t\tNSTAGES=%2d,\n%s"
 		"\t\t\tXTRA=%2d,// Extra bits for internal precision\n"
 		"\t\t\tWW=%2d,\t// Our working bit-width\n"
 		"\t\t\tPW=%2d;\t// Bits in our phase variables\n"
@@ -97,9 +129,10 @@ void	basiccordic(FILE *fp, FILE *fhp, const char *fname,
 		"\tinput\twire\tsigned\t[(IW-1):0]\t\ti_xval, i_yval;\n"
 		"\tinput\twire\t\t[(PW-1):0]\t\t\ti_phase;\n"
 		"\toutput\treg\tsigned\t[(OW-1):0]\to_xval, o_yval;\n",
-		name, resetw.c_str(), (with_reset)?", ":"",
+		lanename.c_str(), resetw.c_str(), (with_reset)?", ":"",
 		(with_aux)?" i_aux,":"", (with_aux)?", o_aux":"",
-		iw, ow, nstages, nxtra, working_width, phase_bits,
+		iw, ow, nstages, pipeparam.c_str(),
+		nxtra, working_width, phase_bits,
 		resetw.c_str(), (with_reset)?", ":"");
 
 	if (with_aux) {
@@ -132,9 +165,9 @@ void	basiccordic(FILE *fp, FILE *fhp, const char *fname,
 		"\t// Declare variables for all of the separate stages\n");
 
 	fprintf(fp,
-		"\treg	signed	[(WW-1):0]	xv	[0:(NSTAGES)];\n"
-		"\treg	signed	[(WW-1):0]	yv	[0:(NSTAGES)];\n"
-		"\treg		[(PW-1):0]	ph	[0:(NSTAGES)];\n\n");
+		"\treg	signed	[(WW-1):0]	xv	[0:(%s)];\n"
+		"\treg	signed	[(WW-1):0]	yv	[0:(%s)];\n"
+		"\treg		[(PW-1):0]	ph	[0:(%s)];\n\n", depth, depth, depth);
 
 	if (with_aux) {
 		fprintf(fp,
@@ -148,17 +181,17 @@ void	basiccordic(FILE *fp, FILE *fhp, const char *fname,
 "\t// are input together with i_aux, then when o_xval and o_yval are set\n"
 "\t// to this value, o_aux *must* contain the value that was in i_aux.\n"
 "\t//\n"
-"\treg\t\t[(NSTAGES):0]\tax;\n"
-"\n");
+"\treg\t\t[(%s):0]\tax;\n"
+"\n", depth);
 
 		fprintf(fp, "%s", always_reset.c_str());
 
 		if (with_reset)
 			fprintf(fp,
-				"\t\tax <= {(NSTAGES+1){1'b0}};\n\telse ");
+				"\t\tax <= {(%s+1){1'b0}};\n\telse ", depth);
 		fprintf(fp, "if (i_ce)\n"
-			"\t\tax <= { ax[(NSTAGES-1):0], i_aux };\n"
-			"\n");
+			"\t\tax <= { ax[(%s-1):0], i_aux };\n"
+			"\n", depth);
 	}
 
 	fprintf(fp,
@@ -251,63 +284,149 @@ void	basiccordic(FILE *fp, FILE *fhp, const char *fname,
 
 	cordic_angles(fp, nstages, phase_bits);
 
-	fprintf(fp,"\n"
+	if (kstages > 1) {
+		char	sidx[32], shift[32], xi[16], yi[16], pi[16];
+
+		fprintf(fp,"\n"
 		"\tgenvar	i;\n"
-		"\tgenerate for(i=0; i<NSTAGES; i=i+1) begin : CORDICops\n");
-	fprintf(fp,
-		"\t\t// Here\'s where we are going to put the actual CORDIC\n"
-		"\t\t// we\'ve been studying and discussing.  Everything up to\n"
-		"\t\t// this point has simply been necessary preliminaries.\n");
-	fprintf(fp, "%s", always_reset.c_str());
-	if (with_reset) {
+		"\tgenerate for(i=0; i<NPIPE; i=i+1) begin : CORDICops\n");
 		fprintf(fp,
+		"\t\t// Here\'s where we are going to put the actual CORDIC\n"
+		"\t\t// we\'ve been studying and discussing.  Each pipeline\n"
+		"\t\t// stage applies KSTAGES CORDIC stages, KSTAGES*i through\n"
+		"\t\t// KSTAGES*i+KSTAGES-1, each acting upon the result of the\n"
+		"\t\t// one before.  It takes only 1/KSTAGES as many clocks to\n"
+		"\t\t// get through all of the stages, but no fewer adders, and\n"
+		"\t\t// the KSTAGES adders of each clock are chained together.\n");
+
+		strcpy(xi, "xv[i]"); strcpy(yi, "yv[i]"); strcpy(pi, "ph[i]");
+		for(int j=0; j<kstages-1; j++) {
+			if (j == 0)
+				strcpy(sidx, "KSTAGES*i");
+			else
+				sprintf(sidx, "KSTAGES*i+%d", j);
+			sprintf(shift, "KSTAGES*i+%d", j+1);
+			fprintf(fp, "\n"
+			"\t\t// Stage %s\n"
+			"\t\twire\tsigned\t[(WW-1):0]\tsx%d, sy%d;\n"
+			"\t\twire\t\t[(PW-1):0]\tsph%d;\n"
+			"\t\twire\t\t\t\tskip%d;\n\n"
+			"\t\tassign\tskip%d = (cordic_angle[%s] == 0)||(%s >= WW);\n"
+			"\t\tassign\tsx%d = (skip%d) ? %s\n"
+			"\t\t\t: (%s[(PW-1)]) ? (%s + (%s>>>(%s)))\n"
+			"\t\t\t: (%s - (%s>>>(%s)));\n"
+			"\t\tassign\tsy%d = (skip%d) ? %s\n"
+			"\t\t\t: (%s[(PW-1)]) ? (%s - (%s>>>(%s)))\n"
+			"\t\t\t: (%s + (%s>>>(%s)));\n"
+			"\t\tassign\tsph%d = (skip%d) ? %s\n"
+			"\t\t\t: (%s[(PW-1)]) ? (%s + cordic_angle[%s])\n"
+			"\t\t\t: (%s - cordic_angle[%s]);\n",
+				sidx, j+1, j+1, j+1, j,
+				j, sidx, sidx,
+				j+1, j, xi, pi, xi, yi, shift, xi, yi, shift,
+				j+1, j, yi, pi, yi, xi, shift, yi, xi, shift,
+				j+1, j, pi, pi, pi, sidx, pi, sidx);
+			sprintf(xi, "sx%d", j+1);
+			sprintf(yi, "sy%d", j+1);
+			sprintf(pi, "sph%d", j+1);
+		}
+
+		sprintf(sidx, "KSTAGES*i+%d", kstages-1);
+		sprintf(shift, "KSTAGES*i+%d", kstages);
+		fprintf(fp, "\n\t\t// Stage %s, the last of this clock\n", sidx);
+		fprintf(fp, "%s", always_reset.c_str());
+		if (with_reset) {
+			fprintf(fp,
 			"\t\tbegin\n"
 			"\t\t\txv[i+1] <= 0;\n"
 			"\t\t\tyv[i+1] <= 0;\n"
 			"\t\t\tph[i+1] <= 0;\n"
 			"\t\tend else ");
-	} else
-		fprintf(fp, "\t\t");
+		} else
+			fprintf(fp, "\t\t");
 
-	fprintf(fp,
+		fprintf(fp,
 		"if (i_ce)\n"
 		"\t\tbegin\n"
-		"\t\t\tif ((cordic_angle[i] == 0)||(i >= WW))\n"
-		"\t\t\tbegin // Do nothing but move our outputs\n"
-		"\t\t\t// forward one stage, since we have more\n"
-		"\t\t\t// stages than valid data\n"
-		"\t\t\t\txv[i+1] <= xv[i];\n"
-		"\t\t\t\tyv[i+1] <= yv[i];\n"
-		"\t\t\t\tph[i+1] <= ph[i];\n"
-		"\t\t\tend else if (ph[i][(PW-1)]) // Negative phase\n"
+		"\t\t\tif ((cordic_angle[%s] == 0)||(%s >= WW))\n"
 		"\t\t\tbegin\n"
-		"\t\t\t\t// If the phase is negative, rotate by the\n"
-		"\t\t\t\t// CORDIC angle in a clockwise direction.\n"
-		"\t\t\t\txv[i+1] <= xv[i] + (yv[i]>>>(i+1));\n"
-		"\t\t\t\tyv[i+1] <= yv[i] - (xv[i]>>>(i+1));\n"
-		"\t\t\t\tph[i+1] <= ph[i] + cordic_angle[i];\n"
+		"\t\t\t\txv[i+1] <= %s;\n"
+		"\t\t\t\tyv[i+1] <= %s;\n"
+		"\t\t\t\tph[i+1] <= %s;\n"
+		"\t\t\tend else if (%s[(PW-1)]) // Negative phase\n"
+		"\t\t\tbegin\n"
+		"\t\t\t\txv[i+1] <= %s + (%s>>>(%s));\n"
+		"\t\t\t\tyv[i+1] <= %s - (%s>>>(%s));\n"
+		"\t\t\t\tph[i+1] <= %s + cordic_angle[%s];\n"
 		"\t\t\tend else begin\n"
-		"\t\t\t\t// On the other hand, if the phase is\n"
-		"\t\t\t\t// positive ... rotate in the\n"
-		"\t\t\t\t// counter-clockwise direction\n"
-		"\t\t\t\txv[i+1] <= xv[i] - (yv[i]>>>(i+1));\n"
-		"\t\t\t\tyv[i+1] <= yv[i] + (xv[i]>>>(i+1));\n"
-		"\t\t\t\tph[i+1] <= ph[i] - cordic_angle[i];\n"
+		"\t\t\t\txv[i+1] <= %s - (%s>>>(%s));\n"
+		"\t\t\t\tyv[i+1] <= %s + (%s>>>(%s));\n"
+		"\t\t\t\tph[i+1] <= %s - cordic_angle[%s];\n"
 		"\t\t\tend\n"
 		"\t\tend\n"
-		"\tend endgenerate\n\n");
+		"\tend endgenerate\n\n",
+			sidx, sidx, xi, yi, pi, pi,
+			xi, yi, shift, yi, xi, shift, pi, sidx,
+			xi, yi, shift, yi, xi, shift, pi, sidx);
+	} else {
+		fprintf(fp,"\n"
+			"\tgenvar	i;\n"
+			"\tgenerate for(i=0; i<NSTAGES; i=i+1) begin : CORDICops\n");
+		fprintf(fp,
+			"\t\t// Here\'s where we are going to put the actual CORDIC\n"
+			"\t\t// we\'ve been studying and discussing.  Everything up to\n"
+			"\t\t// this point has simply been necessary preliminaries.\n");
+		fprintf(fp, "%s", always_reset.c_str());
+		if (with_reset) {
+			fprintf(fp,
+				"\t\tbegin\n"
+				"\t\t\txv[i+1] <= 0;\n"
+				"\t\t\tyv[i+1] <= 0;\n"
+				"\t\t\tph[i+1] <= 0;\n"
+				"\t\tend else ");
+		} else
+			fprintf(fp, "\t\t");
+
+		fprintf(fp,
+			"if (i_ce)\n"
+			"\t\tbegin\n"
+			"\t\t\tif ((cordic_angle[i] == 0)||(i >= WW))\n"
+			"\t\t\tbegin // Do nothing but move our outputs\n"
+			"\t\t\t// forward one stage, since we have more\n"
+			"\t\t\t// stages than valid data\n"
+			"\t\t\t\txv[i+1] <= xv[i];\n"
+			"\t\t\t\tyv[i+1] <= yv[i];\n"
+			"\t\t\t\tph[i+1] <= ph[i];\n"
+			"\t\t\tend else if (ph[i][(PW-1)]) // Negative phase\n"
+			"\t\t\tbegin\n"
+			"\t\t\t\t// If the phase is negative, rotate by the\n"
+			"\t\t\t\t// CORDIC angle in a clockwise direction.\n"
+			"\t\t\t\txv[i+1] <= xv[i] + (yv[i]>>>(i+1));\n"
+			"\t\t\t\tyv[i+1] <= yv[i] - (xv[i]>>>(i+1));\n"
+			"\t\t\t\tph[i+1] <= ph[i] + cordic_angle[i];\n"
+			"\t\t\tend else begin\n"
+			"\t\t\t\t// On the other hand, if the phase is\n"
+			"\t\t\t\t// positive ... rotate in the\n"
+			"\t\t\t\t// counter-clockwise direction\n"
+			"\t\t\t\txv[i+1] <= xv[i] - (yv[i]>>>(i+1));\n"
+			"\t\t\t\tyv[i+1] <= yv[i] + (xv[i]>>>(i+1));\n"
+			"\t\t\t\tph[i+1] <= ph[i] - cordic_angle[i];\n"
+			"\t\t\tend\n"
+			"\t\tend\n"
+			"\tend endgenerate\n\n");
+	}
 
 	if (working_width > ow+1) {
 		fprintf(fp,
 			"\t// Round our result towards even\n"
 			"\twire\t[(WW-1):0]\tpre_xval, pre_yval;\n\n"
-			"\tassign\tpre_xval = xv[NSTAGES] + $signed({{(OW){1\'b0}},\n"
-				"\t\t\t\txv[NSTAGES][(WW-OW)],\n"
-				"\t\t\t\t{(WW-OW-1){!xv[NSTAGES][WW-OW]}}});\n"
-			"\tassign\tpre_yval = yv[NSTAGES] + $signed({{(OW){1\'b0}},\n"
-				"\t\t\t\tyv[NSTAGES][(WW-OW)],\n"
-				"\t\t\t\t{(WW-OW-1){!yv[NSTAGES][WW-OW]}}});\n"
-			"\n");
+			"\tassign\tpre_xval = xv[%s] + $signed({{(OW){1\'b0}},\n"
+				"\t\t\t\txv[%s][(WW-OW)],\n"
+				"\t\t\t\t{(WW-OW-1){!xv[%s][WW-OW]}}});\n"
+			"\tassign\tpre_yval = yv[%s] + $signed({{(OW){1\'b0}},\n"
+				"\t\t\t\tyv[%s][(WW-OW)],\n"
+				"\t\t\t\t{(WW-OW-1){!yv[%s][WW-OW]}}});\n"
+			"\n", depth, depth, depth, depth, depth, depth);
 		fprintf(fp, "%s", always_reset.c_str());
 
 		if (with_reset)
@@ -323,7 +442,7 @@ void	basiccordic(FILE *fp, FILE *fhp, const char *fname,
 			"\t\to_yval <= pre_yval[(WW-1):(WW-OW)];\n");
 		if (with_aux)
 			fprintf(fp,
-			"\t\to_aux <= ax[NSTAGES];\n");
+			"\t\to_aux <= ax[%s];\n", depth);
 		fprintf(fp, "\tend\n\n");
 
 		fprintf(fp, "\t// Make Verilator happy with pre_.val\n"
@@ -348,15 +467,31 @@ void	basiccordic(FILE *fp, FILE *fhp, const char *fname,
 		fprintf(fp,
 			"if (i_ce)\n"
 			"\tbegin\t// We accumulate a bit during our processing, so shift by one\n"
-			"\t\to_xval <= xv[NSTAGES][(WW-1):(WW-OW)];\n"
-			"\t\to_yval <= yv[NSTAGES][(WW-1):(WW-OW)];\n");
+			"\t\to_xval <= xv[%s][(WW-1):(WW-OW)];\n"
+			"\t\to_yval <= yv[%s][(WW-1):(WW-OW)];\n", depth, depth);
 		if (with_aux)
-			fprintf(fp, "\t\to_aux  <= ax[NSTAGES];\n");
+			fprintf(fp, "\t\to_aux  <= ax[%s];\n", depth);
 		fprintf(fp, "\tend\n\n");
 	}
 
 	fprintf(fp, "endmodule\n");
 
+	if (nlanes > 1) {
+		const LANEPORT	inputs[] = {
+			{ "i_xval",  "IW", iw },
+			{ "i_yval",  "IW", iw },
+			{ "i_phase", "PW", phase_bits } },
+				outputs[] = {
+			{ "o_xval",  "OW", ow },
+			{ "o_yval",  "OW", ow } };
+
+		lanes_wrapper(fp, name, lanename.c_str(), nlanes,
+			with_reset, with_aux, async_reset,
+			3, inputs, 2, outputs);
+	} else if (nchannels > 1)
+		channels_wrapper(fp, name, lanename.c_str(), nchannels,
+			phase_acc, npipe+2, iw, ow, phase_bits,
+			with_reset, with_aux, async_reset);
 
 	if (NULL != fhp) {
 		char	*str = new char[strlen(name)+4], *ptr;
@@ -380,6 +515,16 @@ void	basiccordic(FILE *fp, FILE *fhp, const char *fname,
 		fprintf(fhp, "const int	WW = %d;\n", working_width);
 		fprintf(fhp, "const int	PW = %d;\n", phase_bits);
 		fprintf(fhp, "const int	NSTAGES = %d;\n", nstages);
+		if (kstages > 1) {
+			fprintf(fhp, "const int	KSTAGES = %d;\n", kstages);
+			fprintf(fhp, "const int	NPIPE = %d;\n", npipe);
+		}
+		if (nlanes > 1)
+			fprintf(fhp, "const int	NLANES = %d;\n", nlanes);
+		if (nchannels > 1)
+			fprintf(fhp, "const int	NCHANNELS = %d;\n", nchannels);
+		if (phase_acc)
+			fprintf(fhp, "#define\tPHASE_ACCUMULATOR\n");
 		fprintf(fhp, "const double	QUANTIZATION_VARIANCE = %.4e; // (Units^2)\n",
 			transform_quantization_variance(nstages,
 				working_width-iw,
@@ -412,7 +557,13 @@ void	basiccordic(FILE *fp, FILE *fhp, const char *fname,
 			fprintf(fhp, "#define\tHAS_RESET_WIRE\n");
 		if (with_aux)
 			fprintf(fhp, "#define\tHAS_AUX_WIRES\n");
+		cordic_template(fhp, name);
 		fprintf(fhp, "#endif\t// %s\n", str);
 		delete[] str;
 	}
+
+	if (NULL != fmp)
+		basiccordic_model(fmp, name, nstages, iw, ow, nxtra,
+			working_width, phase_bits,
+			npipe+2+((phase_acc)?1:0));
 }
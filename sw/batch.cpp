@@ -0,0 +1,223 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename: 	batch.cpp
+//
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	Builds every core listed in a manifest from within one process.
+//		Each line of the manifest holds the arguments of one gencordic
+//	command line, exactly as they would be given on the command line, e.g.
+//
+//		# The demonstration rotator
+//		-c -m -f ../rtl/cordic.v -i 12 -o 12 -t p2r -x 2
+//
+//	The lines are handed out to a pool of worker threads, so that several
+//	cores are built at once.  Nothing is shared between the cores but the
+//	quadratic table fits, which quadtbl.cpp keeps once made, so that every
+//	qtbl core of the same table size uses the same fit.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2017-2018, Gisselquist Technology, LLC
+//
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+//
+// License:	GPL, v3, as defined and found on www.gnu.org,
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+//
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <vector>
+#include <string>
+
+#include "batch.h"
+
+typedef	struct	{
+	int			line;	// Manifest line number, for errors
+	std::string		cmd;	// The line, less any comment
+	std::vector<char *>	argv;
+	int			status;
+} BATCH_JOB;
+
+typedef	struct	{
+	std::vector<BATCH_JOB>	jobs;
+	BATCH_FN		fn;
+	pthread_mutex_t		lock;
+	unsigned		next;
+} BATCH_WORK;
+
+//
+// batch_parse
+//
+// Splits one line of the manifest into its arguments, returning false if
+// there are none.
+static	bool	batch_parse(BATCH_JOB *job, const char *line) {
+	const char	*ptr = line, *end;
+
+	end = strchr(line, '#');
+	if (NULL == end)
+		end = line + strlen(line);
+	while((ptr < end)&&(isspace(*ptr)))
+		ptr++;
+	while((end > ptr)&&(isspace(end[-1])))
+		end--;
+	job->cmd.assign(ptr, end-ptr);
+
+	job->argv.push_back(strdup("gencordic"));
+	while(ptr < end) {
+		const char	*arg;
+
+		while((ptr < end)&&(isspace(*ptr)))
+			ptr++;
+		if (ptr >= end)
+			break;
+		arg = ptr;
+		while((ptr < end)&&(!isspace(*ptr)))
+			ptr++;
+		job->argv.push_back(strndup(arg, ptr-arg));
+	}
+
+	if (job->argv.size() < 2) {
+		free(job->argv[0]);
+		job->argv.clear();
+		return false;
+	}
+
+	// Some getopt()s expect argv[argc] == NULL
+	job->argv.push_back(NULL);
+	return true;
+}
+
+//
+// batch_same
+//
+// Returns true if both jobs have the same arguments, and so would build the
+// same files
+static	bool	batch_same(const BATCH_JOB *a, const BATCH_JOB *b) {
+	if (a->argv.size() != b->argv.size())
+		return false;
+	for(unsigned k=1; k+1<a->argv.size(); k++)
+		if (0 != strcmp(a->argv[k], b->argv[k]))
+			return false;
+	return true;
+}
+
+static	void	*batch_worker(void *arg) {
+	BATCH_WORK	*w = (BATCH_WORK *)arg;
+
+	while(1) {
+		BATCH_JOB	*job;
+
+		pthread_mutex_lock(&w->lock);
+		job = (w->next < w->jobs.size()) ? &w->jobs[w->next++] : NULL;
+		pthread_mutex_unlock(&w->lock);
+
+		if (NULL == job)
+			break;
+		job->status = w->fn((int)job->argv.size()-1, job->argv.data());
+	}
+
+	return NULL;
+}
+
+int	batch(const char *fname, int nthreads, BATCH_FN fn) {
+	BATCH_WORK	w;
+	pthread_t	*threads;
+	FILE		*fp;
+	char		line[4096];
+	int		lineno = 0, nfailed = 0, nrun;
+
+	if (NULL == (fp = fopen(fname, "r"))) {
+		fprintf(stderr, "ERR: Cannot open manifest %s\n", fname);
+		perror("O/S Err:");
+		return EXIT_FAILURE;
+	}
+
+	while(fgets(line, sizeof(line), fp)) {
+		BATCH_JOB	job;
+		bool		dup = false;
+
+		lineno++;
+		job.line   = lineno;
+		job.status = EXIT_SUCCESS;
+		if (!batch_parse(&job, line))
+			continue;
+
+		for(unsigned k=0; k<w.jobs.size() && !dup; k++)
+			dup = batch_same(&w.jobs[k], &job);
+		if (dup) {
+			fprintf(stderr, "WARNING: %s:%d repeats an earlier line, and will only be built once\n", fname, lineno);
+			for(unsigned k=0; k<job.argv.size(); k++)
+				free(job.argv[k]);
+			continue;
+		}
+
+		w.jobs.push_back(job);
+	} fclose(fp);
+
+	if (nthreads <= 0)
+		nthreads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+	if (nthreads > (int)w.jobs.size())
+		nthreads = (int)w.jobs.size();
+	if (nthreads < 1)
+		nthreads = 1;
+
+	w.fn   = fn;
+	w.next = 0;
+	pthread_mutex_init(&w.lock, NULL);
+
+	// The calling thread works alongside the others, so a single thread
+	// runs everything in manifest order
+	threads = new pthread_t[nthreads];
+	nrun = 1;
+	for(int k=1; k<nthreads; k++) {
+		if (0 != pthread_create(&threads[k], NULL, batch_worker, &w)) {
+			fprintf(stderr, "WARNING: Could only start %d batch threads\n", nrun);
+			break;
+		} nrun++;
+	}
+	batch_worker(&w);
+	for(int k=1; k<nrun; k++)
+		pthread_join(threads[k], NULL);
+	delete[] threads;
+	pthread_mutex_destroy(&w.lock);
+
+	for(unsigned k=0; k<w.jobs.size(); k++) {
+		if (w.jobs[k].status != EXIT_SUCCESS) {
+			fprintf(stderr, "ERR: %s:%d failed: %s\n", fname,
+				w.jobs[k].line, w.jobs[k].cmd.c_str());
+			nfailed++;
+		}
+		for(unsigned j=0; j<w.jobs[k].argv.size(); j++)
+			free(w.jobs[k].argv[j]);
+	}
+
+	printf("Built %d of %d cores from %s on %d thread%s\n",
+		(int)w.jobs.size()-nfailed, (int)w.jobs.size(), fname,
+		nrun, (nrun > 1) ? "s":"");
+	return (nfailed > 0) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
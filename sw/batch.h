@@ -0,0 +1,62 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename: 	batch.h
+//
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	Declares the batch builder, which works through a manifest of
+//		gencordic command lines, building several cores at once.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2017-2018, Gisselquist Technology, LLC
+//
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+//
+// License:	GPL, v3, as defined and found on www.gnu.org,
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+//
+#ifndef	BATCH_H
+#define	BATCH_H
+
+//
+// BATCH_FN
+//
+// Builds one core, given the arguments from one line of the manifest.  As
+// with main(), argv[0] is the program name, and the return value is an exit
+// code.
+//
+typedef	int	(*BATCH_FN)(int argc, char **argv);
+
+//
+// batch
+//
+// Reads the manifest in fname, one command line per line, and hands each to
+// fn on one of nthreads worker threads (one per CPU if nthreads is zero or
+// less).  Blank lines, and everything following a '#', are ignored.  Lines
+// repeating an earlier line exactly are only built once.  Returns
+// EXIT_SUCCESS if every line built, EXIT_FAILURE otherwise.
+//
+extern	int	batch(const char *fname, int nthreads, BATCH_FN fn);
+
+#endif	// BATCH_H
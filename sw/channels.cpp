@@ -0,0 +1,214 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename: 	channels.cpp
+//
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	Many low rate channels don't each need a core of their own.
+//		A pipelined core takes a new sample on every clock, whoever
+//	it belongs to, so one core can be shared between them all by handing
+//	it the channels' samples in turn, time multiplexed, so long as each
+//	result can be traced back to its channel.  That's what this wrapper is
+//	for: each sample comes in with the number of its channel, and that
+//	number travels down a delay line alongside the pipeline--just as the
+//	aux bit does--to come back out with the sample's result.
+//
+//	Optionally, each channel may also keep its own phase.  The phases are
+//	held in a small RAM, one entry per channel, small enough to be built
+//	from distributed (LUT) RAM, rather than one register per channel.
+//	i_phase then steps the channel's phase, rather than setting it, and
+//	the sample is rotated by the channel's new phase.  Every channel may
+//	then be its own numerically controlled oscillator, or mixer.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2017, Gisselquist Technology, LLC
+//
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+//
+// License:	GPL, v3, as defined and found on www.gnu.org,
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+//
+#include <stdio.h>
+#include <string>
+#include <assert.h>
+
+#include "cordiclib.h"
+#include "lanes.h"
+#include "channels.h"
+
+//
+// channels_wrapper
+//
+// Writes out module name, sharing the module core between nchannels
+// channels.  The core is expected to have ports i_clk, i_ce, the reset (if
+// any), i_xval, i_yval, i_phase, i_aux and o_aux (if with_aux), o_xval and
+// o_yval, in that order, and to take latency clock enables to get a sample
+// from its inputs to its outputs.  With phase_acc, every channel keeps its
+// own phase, stepped by i_phase, at the cost of one more clock of latency.
+//
+void	channels_wrapper(FILE *fp, const char *name, const char *core,
+		int nchannels, bool phase_acc, int latency,
+		int iw, int ow, int phase_bits, bool with_reset,
+		bool with_aux, bool async_reset) {
+	std::string	resetn;
+	const char	*src;
+	int	cw = nextlg((unsigned)nchannels);
+
+	assert(nchannels > 1);
+	assert(latency > 1);
+
+	resetn = (!with_reset) ? "" : (async_reset) ? "i_areset_n" : "i_reset";
+
+	fprintf(fp,
+		"\n\n"
+		"//\n"
+		"// %s\n"
+		"//\n"
+		"// One %s, shared between %d channels.  Samples may come from the\n"
+		"// channels in any order, one per clock enable, each with the number\n"
+		"// of its channel on i_chan.  That number comes back out on o_chan,\n"
+		"// alongside the sample\'s result.\n",
+		name, core, nchannels);
+	if (phase_acc)
+		fprintf(fp,
+		"//\n"
+		"// Each channel also keeps its own phase.  i_phase is added to the\n"
+		"// phase of channel i_chan, and the sample is rotated by the sum.\n"
+		"// The phases start at zero, and aren\'t cleared by any reset.\n");
+	fprintf(fp,
+		"//\n"
+		"module	%s(i_clk, %s%si_ce, i_chan, i_xval, i_yval, i_phase,%s\n"
+		"\t\to_chan, o_xval, o_yval%s);\n"
+		"\tlocalparam\tNCHAN=%2d,\t// Channels sharing the core\n"
+		"\t\t\tCW=%2d,\t// Bits in a channel number\n"
+		"\t\t\tIW=%2d,\t// The number of bits in our inputs\n"
+		"\t\t\tOW=%2d,\t// The number of output bits to produce\n"
+		"\t\t\tPW=%2d,\t// Bits in our phase variables\n"
+		"\t\t\tCORE_LATENCY=%2d;\t// Clocks through the core\n"
+		"\tinput\twire\t\t\t\ti_clk, %s%si_ce;\n"
+		"\tinput\twire\t\t[(CW-1):0]\t\ti_chan;\n"
+		"\tinput\twire\tsigned\t[(IW-1):0]\t\ti_xval, i_yval;\n"
+		"\tinput\twire\t\t[(PW-1):0]\t\ti_phase;\n"
+		"\toutput\twire\t\t[(CW-1):0]\t\to_chan;\n"
+		"\toutput\twire\tsigned\t[(OW-1):0]\to_xval, o_yval;\n",
+		name, resetn.c_str(), (with_reset) ? ", " : "",
+		(with_aux) ? " i_aux," : "", (with_aux) ? ", o_aux" : "",
+		nchannels, cw, iw, ow, phase_bits, latency,
+		resetn.c_str(), (with_reset) ? ", " : "");
+
+	if (with_aux)
+		fprintf(fp,
+			"\tinput\twire\t\t\t\ti_aux;\n"
+			"\toutput\twire\t\t\t\to_aux;\n");
+
+	fprintf(fp, "\n"
+		"\twire\t\t[(CW-1):0]\tcore_chan;\n"
+		"\twire\tsigned\t[(IW-1):0]\tcore_xval, core_yval;\n"
+		"\twire\t\t[(PW-1):0]\tcore_phase;\n");
+	if (with_aux)
+		fprintf(fp, "\twire\t\t\t\tcore_aux;\n");
+	fprintf(fp, "\n");
+
+	if (phase_acc) {
+		fprintf(fp,
+		"\t//\n"
+		"\t// Each channel\'s phase.  This is read asynchronously, and\n"
+		"\t// written on the clock, so as to fit in distributed RAM.  A\n"
+		"\t// channel may therefore follow itself on the very next clock.\n"
+		"\t//\n"
+		"\treg\t\t[(PW-1):0]\tchan_phase\t[0:(NCHAN-1)];\n"
+		"\twire\t\t[(PW-1):0]\tnext_phase;\n"
+		"\treg\t\t[(CW-1):0]\tacc_chan;\n"
+		"\treg\tsigned\t[(IW-1):0]\tacc_xval, acc_yval;\n"
+		"\treg\t\t[(PW-1):0]\tacc_phase;\n"
+		"%s"
+		"\n"
+		"\tinteger\tk;\n"
+		"\tinitial\tfor(k=0; k<NCHAN; k=k+1)\n"
+		"\t\tchan_phase[k] = 0;\n"
+		"\n"
+		"\tassign\tnext_phase = chan_phase[i_chan] + i_phase;\n"
+		"\n"
+		"\talways @(posedge i_clk)\n"
+		"\tif (i_ce)\n"
+		"\t\tchan_phase[i_chan] <= next_phase;\n"
+		"\n"
+		"\t// Then hand the sample to the core, one clock later, along\n"
+		"\t// with its channel\'s new phase\n",
+		(with_aux) ? "\treg\t\t\t\tacc_aux;\n" : "");
+
+		lane_register(fp, "\t", with_reset, async_reset,
+			"acc_chan", "i_chan");
+		fprintf(fp, "\n");
+		lane_register(fp, "\t", with_reset, async_reset,
+			"acc_xval", "i_xval");
+		fprintf(fp, "\n");
+		lane_register(fp, "\t", with_reset, async_reset,
+			"acc_yval", "i_yval");
+		fprintf(fp, "\n");
+		lane_register(fp, "\t", with_reset, async_reset,
+			"acc_phase", "next_phase");
+		if (with_aux) {
+			fprintf(fp, "\n");
+			lane_register(fp, "\t", with_reset, async_reset,
+				"acc_aux", "i_aux");
+		}
+		fprintf(fp, "\n");
+		src = "acc";
+	} else
+		src = "i";
+
+	fprintf(fp,
+		"\tassign\tcore_chan  = %s_chan;\n"
+		"\tassign\tcore_xval  = %s_xval;\n"
+		"\tassign\tcore_yval  = %s_yval;\n"
+		"\tassign\tcore_phase = %s_phase;\n",
+		src, src, src, src);
+	if (with_aux)
+		fprintf(fp, "\tassign\tcore_aux   = %s_aux;\n", src);
+
+	fprintf(fp, "\n"
+		"\t%s\n"
+		"\tu_core(.i_clk(i_clk), ", core);
+	if (with_reset)
+		fprintf(fp, ".%s(%s), ", resetn.c_str(), resetn.c_str());
+	fprintf(fp, ".i_ce(i_ce),\n"
+		"\t\t.i_xval(core_xval), .i_yval(core_yval), "
+			".i_phase(core_phase),\n");
+	if (with_aux)
+		fprintf(fp, "\t\t.i_aux(core_aux), .o_aux(o_aux),\n");
+	fprintf(fp, "\t\t.o_xval(o_xval), .o_yval(o_yval));\n\n");
+
+	fprintf(fp,
+		"\t//\n"
+		"\t// The channel number follows its sample through the core,\n"
+		"\t// one clock enable at a time, just like the aux bit\n"
+		"\t//\n"
+		"\treg\t[(CORE_LATENCY*CW-1):0]\tchan_pipe;\n\n");
+	lane_register(fp, "\t", with_reset, async_reset, "chan_pipe",
+		"{ chan_pipe[((CORE_LATENCY-1)*CW-1):0], core_chan }");
+	fprintf(fp, "\n"
+		"\tassign\to_chan = chan_pipe[(CORE_LATENCY*CW-1):((CORE_LATENCY-1)*CW)];\n"
+		"endmodule\n");
+}
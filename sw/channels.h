@@ -0,0 +1,48 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename: 	channels.h
+//
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	Declares the wrapper that shares one pipelined core between
+//		several time multiplexed channels.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2017, Gisselquist Technology, LLC
+//
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+//
+// License:	GPL, v3, as defined and found on www.gnu.org,
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+#ifndef	CHANNELS_H
+#define	CHANNELS_H
+
+#include <stdio.h>
+
+extern	void	channels_wrapper(FILE *fp, const char *name, const char *core,
+			int nchannels, bool phase_acc, int latency,
+			int iw, int ow, int phase_bits, bool with_reset,
+			bool with_aux, bool async_reset);
+
+#endif	// CHANNELS_H
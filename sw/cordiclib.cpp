@@ -120,7 +120,49 @@ double	transform_quantization_variance(int nstages, int xtrabits, int dropped_bi
 	return current_variance;
 }
 
-void	cordic_angles(FILE *fp, int nstages, int phase_bits, bool mem) {
+double	radix4_vectoring_variance(int nstages, int iw, int working_width) {
+	double	magnitude, variance;
+
+	// The magnitude of a full scale input, at the working width, once
+	// pre-rotated and run through the stages
+	magnitude = (1ul<<(iw-1))-1.;
+	magnitude *= pow(2.0, working_width-iw-2);
+	magnitude *= sqrt(2.0) * radix4_gain(nstages);
+
+	// Only the errors of the stages matter, not those of the input,
+	// since it's the phase of the quantized input we are after
+	variance = radix4_quantization_variance(nstages, 0, 0) - 1./12.;
+	return variance / (magnitude * magnitude);
+}
+
+// cordic_angle_value
+//
+// Returns the k'th CORDIC angle, atan(2^-(k+1)), in integer phase units.
+// This is the one place where the angle gets truncated from a double to
+// an integer, so that the Verilog and the software models built from it
+// will always agree.
+//
+unsigned long	cordic_angle_value(int k, int phase_bits) {
+	double	x;
+
+	x = atan2(1., pow(2,k+1));
+
+	// Convert this value from radians to our integer phase units
+	x *= (4.0 * (1ul<<(phase_bits-2))) / (M_PI * 2.0);
+
+	// Here's where we truncate our phase from a double to an
+	// integer
+	return (unsigned)x;
+}
+
+// cordic_angles
+//
+// Writes out the angle of every CORDIC stage.  With mem set, these go into a
+// table, read through a registered cangle, or through a cangle[] with one
+// entry for each of nports readers.
+//
+void	cordic_angles(FILE *fp, int nstages, int phase_bits, bool mem,
+		int nports) {
 	fprintf(fp,
 		"\t//\n"
 		"\t// In many ways, the key to this whole algorithm lies in the angles\n"
@@ -135,7 +177,11 @@ void	cordic_angles(FILE *fp, int nstages, int phase_bits, bool mem) {
 		nstages = (1<<nextlg(nstages));
 		fprintf(fp, "\treg\t[%d:0]\tcordic_angle [0:%d];\n",
 			phase_bits-1, nstages-1);
-		fprintf(fp, "\treg\t[%d:0]\tcangle;\n\n", phase_bits-1);
+		if (nports > 1)
+			fprintf(fp, "\treg\t[%d:0]\tcangle [0:%d];\n\n",
+				phase_bits-1, nports-1);
+		else
+			fprintf(fp, "\treg\t[%d:0]\tcangle;\n\n", phase_bits-1);
 	} else {
 		fprintf(fp, "\twire\t[%d:0]\tcordic_angle [0:(NSTAGES-1)];\n\n",
 			phase_bits-1);
@@ -144,18 +190,11 @@ void	cordic_angles(FILE *fp, int nstages, int phase_bits, bool mem) {
 	// assert(phase_bits <= 32);
 
 	for(unsigned k=0; k<(unsigned)nstages; k++) {
-		double		x, deg;
+		double		deg;
 		unsigned long	phase_value;
 
-		x = atan2(1., pow(2,k+1));
-		deg = x * 180.0 / M_PI;
-
-		// Convert this value from radians to our integer phase units
-		x *= (4.0 * (1ul<<(phase_bits-2))) / (M_PI * 2.0);
-
-		// Here's where we truncate our phase from a double to an
-		// integer
-		phase_value = (unsigned)x;
+		deg = atan2(1., pow(2,k+1)) * 180.0 / M_PI;
+		phase_value = cordic_angle_value(k, phase_bits);
 
 		if (phase_bits <= 16) {
 			if (mem) {
@@ -252,3 +291,103 @@ int	calc_phase_bits(const int output_width) {
 		phase_bits = 3;
 	return phase_bits;
 }
+
+int	radix4_rotations(int k, int nstages, int working_width,
+		int phase_bits) {
+	int	n = 0;
+
+	for(int j=k; (j<k+2)&&(j<nstages); j++) {
+		if ((cordic_angle_value(j, phase_bits) == 0)
+				||(j >= working_width))
+			break;
+		n++;
+	} return n;
+}
+
+unsigned long	radix4_angle_value(int k, int sigma, int phase_bits) {
+	double	x;
+
+	// The digit sigma = 3 rotates by both angles, sigma = 1 by the first
+	// less the second
+	x = atan2(1., pow(2,k+1));
+	if (sigma == 3)
+		x += atan2(1., pow(2,k+2));
+	else
+		x -= atan2(1., pow(2,k+2));
+
+	// Convert this value from radians to our integer phase units.  Since
+	// one constant replaces two, it can be rounded rather than truncated
+	x *= (4.0 * (1ul<<(phase_bits-2))) / (M_PI * 2.0);
+	return (unsigned long)(x + 0.5);
+}
+
+double	radix4_gain(int nstages) {
+	double	gain = 1.0;
+
+	// Every digit of a stage has the same gain, that of the two radix-2
+	// stages it replaces: |(1+j2^-s)(1+j2^-(s+1))|
+	for(int k=0; k<nstages; k+=2) {
+		double	dgain;
+
+		dgain = 1.0 + pow(2.0,-2.*(k+1));
+		if (k+1 < nstages)
+			dgain *= 1.0 + pow(2.0,-2.*(k+2));
+		gain = gain * sqrt(dgain);
+	}
+
+	return gain;
+}
+
+double	radix4_phase_variance(int nstages, int phase_bits) {
+	double	RAD_TO_PHASE = (1ul << (phase_bits-1)) / M_PI;
+	double	variance;
+
+	variance = 1./12.;
+	for(int k=0; k<nstages; k+=2) {
+		double	x, err;
+
+		if (k+1 < nstages) {
+			// Each stage uses one of two rounded angles.
+			// Either is as likely as the other.
+			x = (atan2(1., pow(2,k+1)) + atan2(1., pow(2,k+2)))
+				* RAD_TO_PHASE;
+			err = radix4_angle_value(k, 3, phase_bits) - x;
+			variance += err * err / 2.;
+
+			x = (atan2(1., pow(2,k+1)) - atan2(1., pow(2,k+2)))
+				* RAD_TO_PHASE;
+			err = radix4_angle_value(k, 1, phase_bits) - x;
+			variance += err * err / 2.;
+		} else {
+			// A radix-2 stage left over at the end
+			x = atan2(1., pow(2,k+1)) * RAD_TO_PHASE;
+			err = cordic_angle_value(k, phase_bits) - x;
+			variance += err * err;
+		}
+	}
+
+	variance /= pow(RAD_TO_PHASE,2.);
+	return variance;
+}
+
+double	radix4_quantization_variance(int nstages, int xtrabits, int dropped_bits) {
+	double	current_variance;
+
+	current_variance = pow(2,2*xtrabits)/12.;
+
+	for(int k=0; k<nstages; k+=2) {
+		if (k+1 < nstages) {
+			// Each stage rounds three shifted terms into each of
+			// x and y for the digits +/-3, or two for +/-1, so
+			// that it adds 5/24 on average.
+			current_variance = (1+pow(4,-k-1))*(1+pow(4,-k-2))
+				* current_variance + 5./24.;
+		} else
+			current_variance = (1+pow(4,-k-1))*current_variance
+				+ 1./3.;
+	}
+
+	if (dropped_bits > 0)
+		current_variance = pow(2,-2*dropped_bits)*current_variance + 1/12.;
+	return current_variance;
+}
@@ -45,9 +45,48 @@ extern	int	nextlg(unsigned);
 extern	double	cordic_gain(int nstages);
 extern	double	phase_variance(int nstages, int phase_bits);
 extern	double	transform_quantization_variance(int nstages, int xtrabits, int dropped_bits);
-extern	void	cordic_angles(FILE *fp, int nstages, int phase_bits, bool mem = false);
+extern	unsigned long	cordic_angle_value(int k, int phase_bits);
+extern	void	cordic_angles(FILE *fp, int nstages, int phase_bits, bool mem = false,
+			int nports = 1);
 extern	int	calc_stages(const int working_width, const int phase_bits);
 extern	int	calc_stages(const int phase_bits);
 extern	int	calc_phase_bits(const int output_width);
 
+//
+// The radix-4 cores, p2r4 and r2p4, apply the CORDIC stages two at a time.
+// Each pipeline stage picks one digit, sigma, of +/-1 or +/-3, applying
+// rotations by +/- atan(2^-s) and +/- atan(2^-(s+1)) together as
+//
+//	x' = x - sigma 2^-(s+1) y - (|sigma|-2) 2^-(2s+1) x
+//	y' = y + sigma 2^-(s+1) x - (|sigma|-2) 2^-(2s+1) y
+//
+// The last term keeps the gain of every digit the same, so the gain of the
+// core is that of the radix-2 stages it replaces, while it takes only half
+// as many clocks.  An odd stage left over at the end is a radix-2 one.
+//
+// radix4_rotations returns how many of the radix-2 stages k and k+1 the
+// stage starting at k applies: two, for a radix-4 stage, one if the second
+// would be skipped, or zero if both would be.  As with the radix-2 cores, a
+// stage is skipped once its angle or its shift is too small to matter.
+//
+// radix4_angle_value returns the angle of the digit sigma (1 or 3) formed
+// from radix-2 stages k and k+1, rounded to integer phase units.  The rest
+// are the radix-4 versions of the functions above, save that each shifted
+// term within a radix-4 stage is rounded rather than truncated.
+//
+// radix4_vectoring_variance returns the phase variance, in radians^2, that
+// the rounding errors in y leave behind when the rectangular to polar core
+// drives a full scale input to the x axis.  The angle table alone, as
+// radix4_phase_variance() counts it, is no longer the larger of the two.
+//
+extern	int	radix4_rotations(int k, int nstages, int working_width,
+			int phase_bits);
+extern	unsigned long	radix4_angle_value(int k, int sigma, int phase_bits);
+extern	double	radix4_gain(int nstages);
+extern	double	radix4_phase_variance(int nstages, int phase_bits);
+extern	double	radix4_quantization_variance(int nstages, int xtrabits,
+			int dropped_bits);
+extern	double	radix4_vectoring_variance(int nstages, int iw,
+			int working_width);
+
 #endif
@@ -0,0 +1,421 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename: 	ctbl.cpp
+//
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	Builds a quarter-wave sine table lookup from two much smaller
+//		tables, after Sunderland's and Nicholas' compressed sine
+//	ROMs.  The quarter-wave index is split into three pieces, A, B, and C,
+//	MSB first, so that the phase is x+d, where x covers A and B and d the
+//	much smaller C.  Then,
+//
+//		sin(x+d) = sin(x)cos(d) + cos(x)sin(d)
+//			~= sin(x) + cos(xa)sin(d)
+//
+//	where xa is x save that B has been replaced by the center of its range.
+//	The first term comes from a coarse table indexed by {A,B}, the second
+//	from a fine table indexed by {A,C}, and the two are added together.
+//	Since sin(d) is small, the fine table needs only a few bits, and since
+//	neither table is indexed by the full phase, the two together are a
+//	small fraction of the size of the quarter-wave table they replace.
+//
+//	Of all the ways of splitting the phase, the one taking the fewest table
+//	bits whose predicted error is no worse than that of the quarter-wave
+//	table itself is the one that gets built.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2017, Gisselquist Technology, LLC
+//
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+//
+// License:	GPL, v3, as defined and found on www.gnu.org,
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+//
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <math.h>
+#include <assert.h>
+#include "hexfile.h"
+
+#include "legal.h"
+#include "swmodel.h"
+#include "estimate.h"
+#include "ctbl.h"
+
+//
+// The truncated quarter-wave table is never more than one LSB off, so
+// neither may we be
+static	const	double	CTBL_MAXERR = 1.0;
+
+// The most guard bits either table will carry below the output LSB
+static	const	int	CTBL_MAXGUARD = 3;
+
+// Clocks from input to output
+static	const	int	CTBL_LATENCY = 4;
+
+// The number of bits required to hold v as a signed number
+static	int	signed_bits(long v) {
+	int	b = 1;
+
+	if (v < 0)
+		v = -v-1;
+	while(v > 0) {
+		b++;
+		v >>= 1;
+	}
+	return b;
+}
+
+//
+// ctbl_error
+//
+// The error of each output is the error of the approximation above, plus
+// that of rounding both table entries to 2^-gbits of an LSB, plus that of
+// dropping the guard bits from their sum at the end.  Of the approximation,
+//
+//	sin(x+d) - sin(x) - cos(xa)sin(d)
+//		= sin(x)(cos(d)-1) + (cos(x)-cos(xa))sin(d)
+//
+// so its magnitude is no more than d^2/2 + |x-xa||d|.
+//
+double	ctbl_error(int phase_bits, int ow, int abits, int bbits,
+		int cbits, int gbits) {
+	double	maxv = (double)((1l<<(ow-1))-1l),
+		dph = 2.0 * M_PI / (double)(1ul << phase_bits),
+		d, dx, err;
+
+	assert(abits + bbits + cbits == phase_bits-2);
+	d  = dph * ((double)(1l<<(cbits-1)) - 0.5);
+	dx = dph * (double)(1l<<(cbits-1)) * (double)((1l<<bbits)-1);
+	err = maxv * (d * d / 2.0 + dx * d);
+
+	if (gbits == 0)
+		err += 1.0;
+	else
+		err += 0.5 + pow(2.0, -gbits);
+	return err;
+}
+
+// The number of bits it takes to hold every entry of the fine table
+static	int	ctbl_finebits(int phase_bits, int ow, int cbits, int gbits) {
+	double	maxv = (double)((1l<<(ow-1))-1l),
+		dph = 2.0 * M_PI / (double)(1ul << phase_bits);
+	long	mx;
+
+	mx = (long)floor(maxv * (double)(1l<<gbits)
+			* sin(dph * ((double)(1l<<(cbits-1)) - 0.5)) + 0.5);
+	return signed_bits(mx);
+}
+
+//
+// ctbl_choose
+//
+// Picks the split taking the fewest table bits, all told, from those
+// predicted to be within CTBL_MAXERR.  Should none be, as happens for the
+// smallest tables, the split with the least predicted error is used
+// instead.  Returns false if no split fits at all.
+static	bool	ctbl_choose(int phase_bits, int ow, CTBL_SPLIT *s) {
+	const	int	lw = phase_bits-2;
+	long	best = -1;
+	double	leasterr = 0.0;
+	CTBL_SPLIT	fallback;
+
+	memset(s, 0, sizeof(CTBL_SPLIT));
+	memset(&fallback, 0, sizeof(CTBL_SPLIT));
+	for(int a=1; a<lw-1; a++)
+	for(int c=1; a+c<lw; c++)
+	for(int g=0; g<=CTBL_MAXGUARD; g++) {
+		int	b = lw-a-c, cw = ow+g,
+			fw = ctbl_finebits(phase_bits, ow, c, g);
+		long	bits;
+		double	err;
+
+		// Both tables need at least four entries, and the fine table
+		// must be narrower than the coarse one it's added to
+		if ((a+b < 2)||(a+c < 2)||(cw > 30)||(fw >= cw))
+			continue;
+
+		err  = ctbl_error(phase_bits, ow, a, b, c, g);
+		bits = (1l<<(a+b))*cw + (1l<<(a+c))*fw;
+		if ((err <= CTBL_MAXERR)&&((best < 0)||(bits < best))) {
+			best = bits;
+			s->abits = a; s->bbits = b; s->cbits = c;
+			s->gbits = g; s->cw = cw; s->fw = fw;
+			s->prederr = err;
+		} else if ((fallback.cw == 0)||(err < leasterr)) {
+			leasterr = err;
+			fallback.abits = a; fallback.bbits = b;
+			fallback.cbits = c; fallback.gbits = g;
+			fallback.cw = cw; fallback.fw = fw;
+			fallback.prederr = err;
+		}
+	}
+
+	if ((best < 0)&&(fallback.cw == 0))
+		return false;
+	else if (best < 0)
+		*s = fallback;
+	return true;
+}
+
+//
+// ctbl_fill
+//
+// Fills the two tables, then runs every quarter-wave phase through them
+// just as the Verilog will, recording the worst error found.  Should any
+// output land above the largest positive value, the coarse entry behind
+// it is pulled down to keep the negation from overflowing.  Returns false
+// should the fine table come out no narrower than the coarse.
+static	bool	ctbl_fill(int phase_bits, int ow, CTBL_SPLIT *s,
+		long *coarse, long *fine) {
+	const	int	a = s->abits, b = s->bbits, c = s->cbits, g = s->gbits;
+	const	long	maxv = (1l<<(ow-1))-1l;
+	const	double	scale = (double)maxv * (double)(1l<<g),
+			dph = 2.0 * M_PI / (double)(1ul << phase_bits);
+	const	long	bias = (g > 0) ? (1l<<(g-1)) : 0,
+			top = ((maxv+1)<<g) - 1;
+	long	mxfine = 0;
+
+	// The coarse table holds sin(x), at the center of C's range, with the
+	// half LSB that rounds the final result already added in
+	for(long k=0; k<(1l<<(a+b)); k++) {
+		double	ph = dph * (double)((k<<c) + (1l<<(c-1)));
+
+		coarse[k] = (long)floor(scale * sin(ph) + 0.5) + bias;
+	}
+
+	// The fine table holds cos(xa)sin(d), for d measured from that center
+	for(long k=0; k<(1l<<(a+c)); k++) {
+		long	av = k >> c, cv = k & ((1l<<c)-1);
+		double	xa = dph * (double)((av << (b+c)) + (1l<<(b+c-1))),
+			d  = dph * ((double)cv + 0.5 - (double)(1l<<(c-1)));
+
+		fine[k] = (long)floor(scale * cos(xa) * sin(d) + 0.5);
+		if (labs(fine[k]) > labs(mxfine))
+			mxfine = fine[k];
+	}
+	s->fw = signed_bits(mxfine);
+	if (s->fw >= s->cw)
+		return false;
+
+	// Keep every sum at or below maxv, once the guard bits are dropped
+	for(long k=0; k<(1l<<(a+b)); k++) {
+		long	av = k >> b, mx = 0;
+
+		for(long cv=0; cv<(1l<<c); cv++) {
+			long	v = coarse[k] + fine[(av<<c)|cv];
+
+			if ((cv == 0)||(v > mx))
+				mx = v;
+		}
+		if (mx > top)
+			coarse[k] -= mx - top;
+	}
+
+	s->mxerr = 0.0;
+	for(long n=0; n<(1l<<(phase_bits-2)); n++) {
+		long	av = n >> (b+c), v;
+		double	err;
+
+		v = (coarse[n>>c] + fine[(av<<c)|(n & ((1l<<c)-1))]) >> g;
+		err = fabs((double)v
+			- (double)maxv * sin(dph * ((double)n + 0.5)));
+		if (err > s->mxerr)
+			s->mxerr = err;
+	}
+	return true;
+}
+
+bool	ctbl(FILE *fp, const char *fname, int phase_bits, int ow,
+		bool with_reset, bool with_aux, bool async_reset, FILE *fmp,
+		CTBL_SPLIT *split, CORE_ESTIMATE *est) {
+	const	char	PURPOSE[] =
+	"A quarter-wave sine table lookup, using the symmetry of the\n"
+	"//\t\tsine wave to cut the table to a quarter of its size, but then\n"
+	"//\tbuilding that quarter wave from two much smaller tables: a coarse\n"
+	"//\ttable of the sine wave, and a fine table of the correction to it\n"
+	"//\tacross each coarse step.  The two are added together, trading one\n"
+	"//\tadder and a clock for most of the table.";
+	char		*name;
+	CTBL_SPLIT	s;
+	long		*coarse, *fine;
+	std::string	tname;
+
+	if ((phase_bits <= 4)||(phase_bits >= 28)) {
+		fprintf(stderr, "ERR: Requested phase width, %d, is outside of the 5 to 27 bits the ctbl core supports\n", phase_bits);
+		return false;
+	} else if (!ctbl_choose(phase_bits, ow, &s)) {
+		fprintf(stderr, "ERR: No coarse/fine table split fits a %d bit output\n", ow);
+		return false;
+	}
+
+	coarse = new long[(1l<<(s.abits+s.bbits))];
+	fine   = new long[(1l<<(s.abits+s.cbits))];
+	if (!ctbl_fill(phase_bits, ow, &s, coarse, fine)) {
+		fprintf(stderr, "ERR: The fine table, at %d bits, is no narrower than the coarse\n", s.fw);
+		delete[] coarse;
+		delete[] fine;
+		return false;
+	}
+
+	legal(fp, fname, PROJECT, PURPOSE);
+	name = modulename(fname);
+
+	std::string	resetw = (!with_reset) ? ""
+				: (async_reset) ? "i_areset_n":"i_reset";
+	std::string	always_reset;
+	if ((with_reset)&&(async_reset))
+		always_reset = "\talways @(posedge i_clk, negedge i_areset_n)\n"
+			"\tif (!i_areset_n)\n";
+	else if (with_reset)
+		always_reset = "\talways @(posedge i_clk)\n"
+			"\tif (i_reset)\n";
+	else
+		always_reset = "\talways @(posedge i_clk)\n\t";
+
+	fprintf(fp,
+		"module	%s(i_clk, %s%si_ce, i_phase, %so_val%s);\n"
+		"\t//\n"
+		"\tparameter\tPW =%2d, // Number of bits in the input phase\n"
+		"\t\t\tOW =%2d; // Number of output bits\n"
+		"\t//\n"
+		"\t// The quarter wave index, LW bits, is split into AB, BB, and CB\n"
+		"\t// bits, MSB first.  Both tables carry GB bits below the output\n"
+		"\t// LSB, which are dropped once their entries are added.\n"
+		"\tlocalparam\tLW = PW-2,\n"
+		"\t\t\tAB = %d, BB = %d, CB = %d,\n"
+		"\t\t\tGB = %d,\n"
+		"\t\t\tCW = OW+GB,\t// Coarse table width\n"
+		"\t\t\tFW = %d;\t// Fine table width\n"
+		"\t//\n"
+		"\tinput\t\t\t\ti_clk, %s%si_ce;\n"
+		"\tinput\twire\t[(PW-1):0]\ti_phase;\n"
+		"\toutput\treg\t[(OW-1):0]\to_val;\n",
+		name,
+		resetw.c_str(), (with_reset) ? ", ":"",
+		(with_aux)   ? "i_aux, ":"",
+		(with_aux)   ? ", o_aux":"",
+		phase_bits, ow, s.abits, s.bbits, s.cbits, s.gbits, s.fw,
+		resetw.c_str(), (with_reset) ? ", ":"");
+
+	if (with_aux)
+		fprintf(fp, "\t//\n"
+			"\tinput\twire\t\t\ti_aux;\n"
+			"\toutput\treg\t\t\to_aux;\n");
+
+	fprintf(fp,
+		"\n"
+		"\treg\t[(CW-1):0]\tcoarse\t[0:((1<<(AB+BB))-1)];\n"
+		"\treg\t[(FW-1):0]\tfine\t[0:((1<<(AB+CB))-1)];\n"
+		"\n"
+		"\tinitial\t$readmemh(\"%s_coarse.hex\", coarse);\n"
+		"\tinitial\t$readmemh(\"%s_fine.hex\", fine);\n"
+		"\n"
+		"\treg\t[2:0]\t\tnegate;\n"
+		"\treg\t[(LW-1):0]\tindex;\n"
+		"\treg\t[(CW-1):0]\tcval, sum;\n"
+		"\treg\t[(FW-1):0]\tfval;\n"
+		"\n", name, name);
+
+	fprintf(fp, "%s", always_reset.c_str());
+
+	if (with_reset)
+		fprintf(fp,
+			"\tbegin\n"
+			"\t\tnegate  <= 3\'b000;\n"
+			"\t\tindex   <= 0;\n"
+			"\t\tcval    <= 0;\n"
+			"\t\tfval    <= 0;\n"
+			"\t\tsum     <= 0;\n"
+			"\t\to_val   <= 0;\n"
+			"\tend else ");
+
+	fprintf(fp,
+		"if (i_ce)\n"
+		"\tbegin\n"
+			"\t\t// Clock #1\n"
+			"\t\tnegate[0] <= i_phase[(PW-1)];\n"
+			"\t\tif (i_phase[(PW-2)])\n"
+			"\t\t\tindex <= ~i_phase[(PW-3):0];\n"
+			"\t\telse\n"
+			"\t\t\tindex <=  i_phase[(PW-3):0];\n"
+			"\n"
+			"\t\t// Clock #2, both tables at once\n"
+			"\t\tcval <= coarse[index[(LW-1):CB]];\n"
+			"\t\tfval <= fine[{ index[(LW-1):(LW-AB)], index[(CB-1):0] }];\n"
+			"\t\tnegate[1] <= negate[0];\n"
+			"\n"
+			"\t\t// Clock #3, add the correction to the coarse value\n"
+			"\t\tsum <= cval + { {(CW-FW){fval[FW-1]}}, fval };\n"
+			"\t\tnegate[2] <= negate[1];\n"
+			"\n"
+			"\t\t// Output Clock, dropping the guard bits.  The coarse\n"
+			"\t\t// table already holds the half LSB that rounds them.\n"
+			"\t\tif (negate[2])\n"
+			"\t\t\to_val <= -sum[(CW-1):GB];\n"
+			"\t\telse\n"
+			"\t\t\to_val <=  sum[(CW-1):GB];\n"
+		"\tend\n\n");
+
+	if (with_aux) {
+		fprintf(fp, "\treg [2:0]\taux;\n");
+		fprintf(fp, "%s", always_reset.c_str());
+		if(with_reset)
+			fprintf(fp, "\t\t{ o_aux, aux } <= 0;\n"
+				"\telse ");
+		fprintf(fp, "if (i_ce)\n\t\t{ o_aux, aux } <= { aux, i_aux };\n");
+	}
+
+	fprintf(fp, "endmodule\n");
+
+	{
+		char	*noext = strdup(fname), *ptr;
+
+		if (NULL != (ptr = strrchr(noext, '.')))
+			*ptr = '\0';
+		tname = std::string(noext) + std::string("_coarse");
+		hextable(tname.c_str(), s.abits+s.bbits, s.cw, coarse);
+		tname = std::string(noext) + std::string("_fine");
+		hextable(tname.c_str(), s.abits+s.cbits, s.fw, fine);
+		free(noext);
+	}
+
+	if (NULL != fmp)
+		ctbl_model(fmp, name, phase_bits, ow, s.abits, s.bbits,
+			s.cbits, s.gbits, s.cw, s.fw, CTBL_LATENCY,
+			coarse, fine);
+
+	if (NULL != est)
+		estimate_ctbl(est, phase_bits, ow, s.abits+s.bbits, s.cw,
+			s.abits+s.cbits, s.fw);
+	if (NULL != split)
+		*split = s;
+
+	delete[] coarse;
+	delete[] fine;
+	return true;
+}
@@ -0,0 +1,79 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename: 	ctbl.h
+//
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	Declares the compressed quarter-wave sine table generator,
+//		and the split of the phase it settles on.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2017, Gisselquist Technology, LLC
+//
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+//
+// License:	GPL, v3, as defined and found on www.gnu.org,
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+#ifndef	CTBL_H
+#define	CTBL_H
+
+#include <stdio.h>
+#include "estimate.h"
+
+//
+// CTBL_SPLIT
+//
+// The quarter-wave index, of phase_bits-2 bits, is split into A, B, and C,
+// from the MSB down.  The coarse table is indexed by {A,B}, the fine
+// table by {A,C}.
+//
+typedef	struct	{
+	int	abits, bbits, cbits;
+	int	gbits;		// Guard bits, kept below the output LSB
+	int	cw, fw;		// Coarse and fine table widths
+	double	prederr;	// Predicted worst case error, in output LSBs
+	double	mxerr;		// ... and that found across every phase
+} CTBL_SPLIT;
+
+//
+// ctbl_error
+//
+// Predicts the worst case error, in output LSBs, of a table split as given
+// for a phase_bits phase and an ow bit output.
+//
+extern	double	ctbl_error(int phase_bits, int ow, int abits, int bbits,
+			int cbits, int gbits);
+
+//
+// ctbl
+//
+// Writes out the core, returning false, before writing anything, should no
+// table split fit the widths given.
+//
+extern	bool	ctbl(FILE *fp, const char *fname, int phase_bits, int ow,
+			bool with_reset, bool with_aux, bool async_reset,
+			FILE *fmp = NULL, CTBL_SPLIT *split = NULL,
+			CORE_ESTIMATE *est = NULL);
+
+#endif	// CTBL_H
@@ -0,0 +1,123 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename: 	engines.cpp
+//
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	A sequential core spends NSTAGES clocks or so on every sample,
+//		and won't take another until it is done.  Building it from
+//	several engines, each a copy of the one CORDIC stage used over and over
+//	again, lets it take a new sample as soon as any engine is free.  The
+//	engines share the pre-rotation ahead of them, the table of angles, and
+//	the rounding and output registers behind them, so the extra area is
+//	that of the engines alone.
+//
+//	The samples go to the engines in turn, and since every engine takes
+//	just as long, they finish in that same turn.  The results therefore
+//	come out in the order the samples went in, with no reordering needed.
+//
+//	What's here is the logic common to both sequential cores, handing
+//	samples out to the engines and following them back out again.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2017, Gisselquist Technology, LLC
+//
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+//
+// License:	GPL, v3, as defined and found on www.gnu.org,
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+//
+#include <stdio.h>
+#include <string>
+#include <assert.h>
+
+#include "cordiclib.h"
+#include "lanes.h"
+#include "engines.h"
+
+//
+// engines_dispatch
+//
+// Declares the per engine idle, pre_valid, and last_state bits, and writes
+// out the two pointers: wr_engine, the engine the next sample goes to, and
+// rd_engine, the engine whose result comes out next.  A sample is accepted
+// on any clock i_stb is high and wr_engine is idle.  The core itself then
+// sets idle[k], and last_state[k] on the engine's last clock of a sample.
+//
+void	engines_dispatch(FILE *fp, int nengines, bool with_reset,
+		bool async_reset) {
+	std::string	always_reset = lane_always("\t", with_reset,
+				async_reset);
+	int	lge = nextlg((unsigned)nengines);
+
+	assert(nengines > 1);
+
+	fprintf(fp, "\n\n"
+	"\t//\n"
+	"\t// Engine dispatch\n"
+	"\t//\n"
+	"\t// Each new sample goes to the next engine in turn, wr_engine, as\n"
+	"\t// soon as that engine is idle.  Since every engine takes just as\n"
+	"\t// long, the engines also finish in turn, and rd_engine follows\n"
+	"\t// wr_engine around to pick out the engine whose result is next.\n"
+	"\t//\n"
+	"\tlocalparam\tNENGINES = %d;\n"
+	"\treg\t[%d:0]\t\twr_engine, rd_engine;\n"
+	"\treg\t[(NENGINES-1):0]\tidle, pre_valid;\n"
+	"\twire\t[(NENGINES-1):0]\tstart, last_state;\n"
+	"\twire\t\t\taccept;\n\n", nengines, lge-1);
+
+	fprintf(fp,
+	"\tassign\taccept = (i_stb)&&(idle[wr_engine]);\n"
+	"\tassign\tstart  = (accept) ? ({ {(NENGINES-1){1\'b0}}, 1\'b1 }\n"
+	"\t\t\t\t\t<< wr_engine) : 0;\n\n");
+
+	fprintf(fp, "\tinitial\twr_engine = 0;\n%s", always_reset.c_str());
+	if (with_reset)
+		fprintf(fp, "\t\twr_engine <= 0;\n\telse ");
+	if (nengines == (1<<lge))
+		fprintf(fp, "if (accept)\n"
+			"\t\twr_engine <= wr_engine + 1\'b1;\n\n");
+	else
+		fprintf(fp, "if (accept)\n"
+			"\t\twr_engine <= (wr_engine == %d) ? 0\n"
+			"\t\t\t\t: (wr_engine + 1\'b1);\n\n", nengines-1);
+
+	fprintf(fp, "\tinitial\trd_engine = 0;\n%s", always_reset.c_str());
+	if (with_reset)
+		fprintf(fp, "\t\trd_engine <= 0;\n\telse ");
+	if (nengines == (1<<lge))
+		fprintf(fp, "if (last_state[rd_engine])\n"
+			"\t\trd_engine <= rd_engine + 1\'b1;\n\n");
+	else
+		fprintf(fp, "if (last_state[rd_engine])\n"
+			"\t\trd_engine <= (rd_engine == %d) ? 0\n"
+			"\t\t\t\t: (rd_engine + 1\'b1);\n\n", nengines-1);
+
+	fprintf(fp, "\t// Load the engine that\'s just been handed a sample\n"
+		"\tinitial\tpre_valid = 0;\n%s", always_reset.c_str());
+	if (with_reset)
+		fprintf(fp, "\t\tpre_valid <= 0;\n\telse\n\t");
+	fprintf(fp, "\tpre_valid <= start;\n\n");
+}
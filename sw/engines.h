@@ -0,0 +1,46 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename: 	engines.h
+//
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	Declares the routines that hand the samples of a sequential
+//		core out to its engines, and collect the results back up.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2017, Gisselquist Technology, LLC
+//
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+//
+// License:	GPL, v3, as defined and found on www.gnu.org,
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+#ifndef	ENGINES_H
+#define	ENGINES_H
+
+#include <stdio.h>
+
+extern	void	engines_dispatch(FILE *fp, int nengines, bool with_reset,
+			bool async_reset);
+
+#endif	// ENGINES_H
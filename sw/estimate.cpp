@@ -0,0 +1,404 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename: 	estimate.cpp
+//
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	Estimates what each core will cost once synthesized.  See
+//		estimate.h.
+//
+//	Every adder is counted as one LUT per bit, and every register bit as
+//	one flip-flop.  Tables of 1Kb or less are placed in distributed RAM,
+//	one LUT per 64 entries per bit, and larger ones in 18Kb block RAMs.
+//	Multiplies are split across as many DSP slices as their widths
+//	require.  Each count follows the structure the matching generator
+//	writes out, but synthesis will merge, share, and retime what it can,
+//	and so should usually do somewhat better.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2017-2018, Gisselquist Technology, LLC
+//
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+//
+// License:	GPL, v3, as defined and found on www.gnu.org,
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+//
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cordiclib.h"
+#include "hybridcordic.h"
+#include "estimate.h"
+
+// The largest table placed in distributed rather than block RAM
+static	const	long	LUTRAM_BITS = 1024;
+
+static	void	est_clear(CORE_ESTIMATE *e) {
+	memset(e, 0, sizeof(*e));
+}
+
+// Adds count adders, each width bits wide
+static	void	est_adders(CORE_ESTIMATE *e, int count, int width) {
+	int	k;
+
+	if ((count <= 0)||(width <= 0))
+		return;
+	for(k=0; k<e->nadd; k++)
+		if (e->add_width[k] == width)
+			break;
+	if (k >= e->nadd) {
+		if (e->nadd >= EST_MAXADD)
+			k = EST_MAXADD-1;
+		else {
+			e->add_count[k] = 0;
+			e->add_width[k] = width;
+			e->nadd++;
+		}
+	}
+	e->add_count[k] += count;
+	e->adder_luts   += count * width;
+}
+
+// The number of 18Kb block RAMs a depth by width table needs
+static	int	bram18(long depth, int width) {
+	// The widest port a block RAM offers at each depth
+	static	const	struct { long depth; int width; } cfg[] = {
+		{   512, 36 }, {  1024, 18 }, {  2048, 9 },
+		{  4096,  4 }, {  8192,  2 }, { 16384, 1 } };
+
+	for(int k=0; k<(int)(sizeof(cfg)/sizeof(cfg[0])); k++)
+		if (depth <= cfg[k].depth)
+			return (width + cfg[k].width - 1) / cfg[k].width;
+	return (int)((depth + 16383) / 16384) * width;
+}
+
+// Adds a table of depth entries, each width bits wide
+static	void	est_table(CORE_ESTIMATE *e, long depth, int width) {
+	long	bits = depth * width;
+
+	e->rom_bits += bits;
+	if (bits <= LUTRAM_BITS)
+		e->lutram_luts += width * (int)((depth + 63) / 64);
+	else
+		e->bram18 += bram18(depth, width);
+}
+
+// The number of aw by bw multipliers an a by b multiply requires
+static	int	mult_dsps(int a, int b, int aw, int bw) {
+	int	t;
+
+	if ((aw <= 0)||(bw <= 0)) {
+		aw = 25;
+		bw = 18;
+	}
+	// The wider operand goes on the wider port
+	if (a < b) { t = a; a = b; b = t; }
+	if (aw < bw) { t = aw; aw = bw; bw = t; }
+	return ((a + aw - 1) / aw) * ((b + bw - 1) / bw);
+}
+
+static	void	est_crit(CORE_ESTIMATE *e, int width, int adders) {
+	if ((adders > e->crit_adders)
+			||((adders == e->crit_adders)&&(width > e->crit_bits))) {
+		e->crit_adders = adders;
+		e->crit_bits   = width;
+	}
+}
+
+static	void	est_area(CORE_ESTIMATE *e) {
+	e->area = e->adder_luts + e->other_luts
+		+ (int)((e->rom_bits + 63) / 64);
+}
+
+void	estimate_cordic(CORE_ESTIMATE *e, GENCORDIC_TYPE type,
+		int nstages, int ww, int ow, int phase_bits,
+		int iters, int rom_bits, int nengines, int kstages) {
+	const	int	stage_ffs = 2*ww + phase_bits;
+	bool	to_polar = (type == GC_R2P)||(type == GC_SR2P)
+				||(type == GC_R2P4);
+	// A p2r core rounds both x and y, an r2p core only the magnitude
+	int	nout = (to_polar) ? 1 : 2,
+		out_ffs = (to_polar) ? (ow + phase_bits) : (2*ow);
+	int	nst, cnt;
+
+	est_clear(e);
+	switch(type) {
+	case GC_SP2R: case GC_SR2P:
+		// One stage, used over and over, following the pre-rotation.
+		// Each engine has its own stage and state counter, while the
+		// pre-rotation, the angle table, and the rounding are shared.
+		e->latency = (type == GC_SP2R) ? nstages+1 : nstages+3;
+		e->clocks  = (e->latency + nengines - 1) / nengines;
+		cnt = nextlg(e->latency);
+		est_adders(e, 4*nengines, ww);
+		est_adders(e, 2*nengines, phase_bits);
+		est_adders(e, nout, ow);
+		e->other_luts = cnt * nengines;
+		e->ffs = (stage_ffs + cnt + 2) * nengines + out_ffs;
+		if (nengines > 1) {
+			int	lge = nextlg(nengines);
+
+			// The two engine pointers, each engine's own copy of
+			// the angle it is working on, and a tree of 4:1 muxes,
+			// one per LUT, to pick out the engine that's done
+			e->other_luts += 2*lge + (nout*ww
+				+ ((to_polar) ? phase_bits : 0))
+					* ((nengines + 1) / 3);
+			e->ffs += 2*lge + (nengines-1) * phase_bits;
+		}
+		est_crit(e, (ww > phase_bits) ? ww : phase_bits, 1);
+		break;
+	case GC_HP2R: {
+		int	first, lgtbl, nfine, tw;
+
+		// A table lookup and complex multiply replace the first
+		// stages, leaving only the fine stages to the CORDIC
+		lgtbl = hybrid_lgtbl(nstages, ww, phase_bits,
+				(rom_bits > 0) ? rom_bits : DEF_ROMBITS, &first);
+		tw = hybrid_table_width(ww);
+		nfine = nstages - first;
+		e->latency = nfine + 4;
+		e->clocks  = 1;
+		est_table(e, 1l<<lgtbl, tw);
+		est_table(e, 1l<<lgtbl, tw);
+		e->dsps = 4 * mult_dsps(ww, tw, 0, 0);
+		est_adders(e, 2, ww+tw+1);
+		est_adders(e, 2*nfine, ww);
+		est_adders(e, nfine, phase_bits);
+		est_adders(e, 2, ow);
+		e->ffs = 2*ww + 2*tw + 4*(ww+tw) + 2*ww
+			+ nfine * stage_ffs + 2*ow;
+		est_crit(e, ww+tw+1, 1);
+		} break;
+	case GC_P2R4: case GC_R2P4:
+		// Two stages per clock, as one radix-4 digit.  Each of x and
+		// y sums up to four terms, the rounding bits of the shifted
+		// ones going in as carries, while the digit is picked by two
+		// phase comparisons (p2r4), or by one rotation of y (r2p4),
+		// before those sums may begin.
+		nst = (nstages + 1) / 2;
+		e->latency = nst + 2;
+		e->clocks  = 1;
+		est_adders(e, 2 + 6*nst + ((to_polar) ? nst : 0), ww);
+		est_adders(e, ((to_polar) ? 1 : 3) * nst + 1, phase_bits);
+		est_adders(e, nout, ow);
+		e->ffs = (nst+1) * stage_ffs + out_ffs;
+		est_crit(e, (ww > phase_bits) ? ww : phase_bits, 3);
+		break;
+	default:
+		if (iters > 0) {
+			int	npass = (nstages + iters - 1) / iters;
+
+			// One pass of iters stages, used over and over
+			e->latency = npass + 2;
+			e->clocks  = e->latency;
+			cnt = nextlg(e->clocks);
+			est_adders(e, 2*(iters+1), ww);
+			est_adders(e, iters+1, phase_bits);
+			est_adders(e, nout, ow);
+			e->other_luts = cnt;
+			e->ffs = stage_ffs + out_ffs + cnt + 2;
+			est_crit(e, (ww > phase_bits) ? ww : phase_bits, iters);
+		} else if (kstages > 1) {
+			// kstages stages per clock, chained within the clock
+			nst = ((nstages + kstages - 1) / kstages) * kstages;
+			e->latency = nst/kstages + 2;
+			e->clocks  = 1;
+			est_adders(e, 2*(nst+1), ww);
+			est_adders(e, nst+1, phase_bits);
+			est_adders(e, nout, ow);
+			e->ffs = (nst/kstages+1) * stage_ffs + out_ffs;
+			est_crit(e, (ww > phase_bits) ? ww : phase_bits, kstages);
+		} else {
+			// One stage per clock, plus the pre-rotation
+			e->latency = nstages + 2;
+			e->clocks  = 1;
+			est_adders(e, 2*(nstages+1), ww);
+			est_adders(e, nstages+1, phase_bits);
+			est_adders(e, nout, ow);
+			e->ffs = (nstages+1) * stage_ffs + out_ffs;
+			est_crit(e, (ww > phase_bits) ? ww : phase_bits, 1);
+		} break;
+	}
+	est_area(e);
+}
+
+void	estimate_table(CORE_ESTIMATE *e, GENCORDIC_TYPE type,
+		int phase_bits, int ow) {
+	est_clear(e);
+	e->clocks = 1;
+	if (type == GC_QTR) {
+		// A quarter of the table, with the index and the result
+		// negated as the quadrant requires
+		e->latency = 3;
+		est_table(e, 1l<<(phase_bits-2), ow);
+		est_adders(e, 1, phase_bits-2);
+		est_adders(e, 1, ow);
+		e->ffs = phase_bits + 2*ow;
+		est_crit(e, (phase_bits-2 > ow) ? phase_bits-2 : ow, 1);
+	} else {
+		e->latency = 1;
+		est_table(e, 1l<<phase_bits, ow);
+		e->ffs = ow;
+	}
+	est_area(e);
+}
+
+void	estimate_ctbl(CORE_ESTIMATE *e, int phase_bits, int ow,
+		int lgcoarse, int cw, int lgfine, int fw) {
+	est_clear(e);
+	e->latency = 4;
+	e->clocks  = 1;
+	est_table(e, 1l<<lgcoarse, cw);
+	est_table(e, 1l<<lgfine, fw);
+	// Folding the index, adding the correction, and negating the result
+	est_adders(e, 1, phase_bits-2);
+	est_adders(e, 1, cw);
+	est_adders(e, 1, ow);
+	e->ffs = 3 + (phase_bits-2) + cw + fw + cw + ow;
+	est_crit(e, (phase_bits-2 > cw) ? phase_bits-2 : cw, 1);
+	est_area(e);
+}
+
+void	estimate_quadtbl(CORE_ESTIMATE *e, int ww, int ow, int lgtbl,
+		int cbits, int lbits, int qbits, int dxbits,
+		int mpy_aw, int mpy_bw, int mpy_delay) {
+	int	xdly = mpy_delay-1;
+
+	est_clear(e);
+	e->latency = 6 + 2*xdly;
+	e->clocks  = 1;
+	est_table(e, 1l<<lgtbl, cbits);
+	est_table(e, 1l<<lgtbl, lbits);
+	est_table(e, 1l<<lgtbl, qbits);
+	e->dsps = mult_dsps(qbits, dxbits, mpy_aw, mpy_bw)
+		+ mult_dsps(lbits, dxbits, mpy_aw, mpy_bw);
+	// (Q*DX+L)*DX+C, then rounding
+	est_adders(e, 1, lbits);
+	est_adders(e, 1, cbits);
+	est_adders(e, 1, ww);
+	// Clock by clock, from the table outputs to the result, and then
+	// whatever delays the multiplies need
+	e->ffs = (cbits+lbits+qbits+dxbits) + (qbits+dxbits)
+		+ (cbits+lbits+dxbits) + lbits + (cbits+dxbits)
+		+ (lbits+dxbits) + cbits + cbits + ow
+		+ xdly * ((qbits+dxbits) + (cbits+lbits+dxbits)
+			+ (lbits+dxbits) + cbits);
+	est_crit(e, (cbits > ww) ? cbits : ww, 1);
+	est_area(e);
+}
+
+void	estimate_channels(CORE_ESTIMATE *e, int nchannels, bool phase_acc,
+		int iw, int phase_bits) {
+	int	cw = nextlg((unsigned)nchannels);
+
+	if (nchannels <= 1)
+		return;
+	e->channels = nchannels;
+
+	if (phase_acc) {
+		// The registers ahead of the core, and the phase RAM.  Read
+		// asynchronously, the RAM is always distributed RAM, however
+		// many channels there are.
+		e->latency++;
+		e->ffs += cw + 2*iw + phase_bits;
+		est_adders(e, 1, phase_bits);
+		e->rom_bits    += (long)nchannels * phase_bits;
+		e->lutram_luts += phase_bits * ((nchannels + 63) / 64);
+	}
+
+	// The channel number alongside every clock of the core
+	e->ffs += cw * (e->latency - ((phase_acc) ? 1 : 0));
+	est_area(e);
+}
+
+void	estimate_lanes(CORE_ESTIMATE *e, int nlanes, bool with_aux,
+		bool shared_tbls) {
+	if (nlanes > 1) {
+		// Sharing its tables, the core needs only one copy of them
+		// for every two lanes
+		int	ntbls = (shared_tbls) ? (nlanes+1)/2 : nlanes;
+
+		e->ffs *= nlanes;
+		for(int k=0; k<e->nadd; k++)
+			e->add_count[k] *= nlanes;
+		e->adder_luts  *= nlanes;
+		e->other_luts  *= nlanes;
+		e->rom_bits    *= ntbls;
+		e->bram18      *= ntbls;
+		e->lutram_luts *= ntbls;
+		e->dsps        *= nlanes;
+		est_area(e);
+	}
+
+	// One aux bit per clock of the pipeline, or just the one for a
+	// core that takes a sample at a time
+	if (with_aux)
+		e->ffs += (e->clocks > 1) ? 1 : e->latency;
+}
+
+void	estimate_report(FILE *fp, const CORE_ESTIMATE *e) {
+	bool	listed[EST_MAXADD] = { false };
+
+	fprintf(fp, "Estimated resources (before synthesis):\n"
+		"\tLatency         : %2d clocks\n"
+		"\tClocks/output   : %2d\n"
+		"\tFlip-flops      : %5d\n",
+		e->latency, e->clocks, e->ffs);
+
+	// List the adders, widest first
+	fprintf(fp, "\tAdders          :");
+	if (e->nadd == 0)
+		fprintf(fp, " (none)");
+	for(int n=0; n<e->nadd; n++) {
+		int	w = -1;
+
+		for(int k=0; k<e->nadd; k++)
+			if ((!listed[k])&&((w < 0)
+					||(e->add_width[k] > e->add_width[w])))
+				w = k;
+		listed[w] = true;
+		fprintf(fp, "%s %d x %d bits", (n > 0) ? ",":"",
+			e->add_count[w], e->add_width[w]);
+	}
+	fprintf(fp, "\n"
+		"\tAdder LUTs      : %5d\n", e->adder_luts);
+	if (e->other_luts > 0)
+		fprintf(fp, "\tOther LUTs      : %5d\n", e->other_luts);
+	if (e->rom_bits > 0)
+		fprintf(fp, "\tTable bits      : %ld (%d BRAM18, %d LUTRAM LUTs)\n",
+			e->rom_bits, e->bram18, e->lutram_luts);
+	if (e->dsps > 0)
+		fprintf(fp, "\tMultipliers     : %2d DSPs\n", e->dsps);
+	if (e->channels > 1)
+		fprintf(fp, "\tChannels        : %2d, %d LUTs apiece\n",
+			e->channels, (e->area + e->channels - 1) / e->channels);
+	if (e->crit_adders > 0)
+		fprintf(fp, "\tLongest path    : %d adder%s of %d bits\n",
+			e->crit_adders, (e->crit_adders > 1) ? "s":"",
+			e->crit_bits);
+	else
+		fprintf(fp, "\tLongest path    : table lookup\n");
+}
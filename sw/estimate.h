@@ -0,0 +1,140 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename: 	estimate.h
+//
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	Rough estimates of what each core will cost once synthesized:
+//		its flip-flops, its adders by width, its table bits (and the
+//	block or distributed RAM they'll take), its multipliers, and the
+//	longest carry chain within any one clock.  These are estimates to
+//	steer a design before synthesis, not a substitute for it.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2017-2018, Gisselquist Technology, LLC
+//
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+//
+// License:	GPL, v3, as defined and found on www.gnu.org,
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+//
+#ifndef	ESTIMATE_H
+#define	ESTIMATE_H
+
+#include <stdio.h>
+#include "libgencordic.h"
+
+// The most distinct adder widths any one core has
+#define	EST_MAXADD	6
+
+typedef	struct	{
+	int	latency;	// Clocks from input to output
+	int	clocks;		// Clocks per output
+	int	ffs;		// Flip-flops
+	int	nadd;		// Adders, counted by width
+	int	add_count[EST_MAXADD], add_width[EST_MAXADD];
+	int	adder_luts;	// One LUT per adder bit
+	int	other_luts;	// Counters and the like
+	long	rom_bits;	// Bits across every table
+	int	bram18;		// 18Kb block RAMs, for the larger tables
+	int	lutram_luts;	// LUTs, for the smaller tables
+	int	dsps;		// Multipliers
+	int	crit_bits;	// The widest carry chain in any one clock ...
+	int	crit_adders;	// ... and how many adders are chained there
+	int	area;		// LUTs all told, counting one for every 64 table
+				// bits no matter where the table goes
+	int	channels;	// Channels sharing the core, zero for just one
+} CORE_ESTIMATE;
+
+//
+// estimate_cordic
+//
+// Estimates the cost of a CORDIC core of any of the p2r, sp2r, hp2r, p2r4,
+// r2p, sr2p, or r2p4 types, given the working width it is built with, ww.
+// A p2r or r2p core with iters > 0 is the one built by -k, and one with
+// kstages > 1 the one built by -K.  rom_bits is the table budget of an hp2r
+// core, and nengines the number of engines in an sp2r or sr2p core.
+//
+extern	void	estimate_cordic(CORE_ESTIMATE *e, GENCORDIC_TYPE type,
+			int nstages, int ww, int ow, int phase_bits,
+			int iters = 0, int rom_bits = 0, int nengines = 1,
+			int kstages = 1);
+
+//
+// estimate_table
+//
+// Estimates the cost of a tbl or qtr table lookup core.
+//
+extern	void	estimate_table(CORE_ESTIMATE *e, GENCORDIC_TYPE type,
+			int phase_bits, int ow);
+
+//
+// estimate_ctbl
+//
+// Estimates the cost of a ctbl core, given the sizes of the coarse and fine
+// tables ctbl() chose for it.
+//
+extern	void	estimate_ctbl(CORE_ESTIMATE *e, int phase_bits, int ow,
+			int lgcoarse, int cw, int lgfine, int fw);
+
+//
+// estimate_quadtbl
+//
+// Estimates the cost of a qtbl core, given the table size and bit widths
+// quadtbl() chose for it.  The multiplies are sized for mpy_aw by mpy_bw
+// bit multipliers, or for a DSP48's 25x18 should these be zero.
+//
+extern	void	estimate_quadtbl(CORE_ESTIMATE *e, int ww, int ow, int lgtbl,
+			int cbits, int lbits, int qbits, int dxbits,
+			int mpy_aw, int mpy_bw, int mpy_delay);
+
+//
+// estimate_channels
+//
+// Accounts for a core shared between nchannels channels: the delay line
+// carrying each sample's channel number, and, with phase_acc, the phase
+// kept for every channel and the extra clock it costs.
+//
+extern	void	estimate_channels(CORE_ESTIMATE *e, int nchannels,
+			bool phase_acc, int iw, int phase_bits);
+
+//
+// estimate_lanes
+//
+// Accounts for the aux pipeline, if any, and for a core built with nlanes
+// lanes--each of which is counted as a full copy of the core, save that
+// with shared_tbls each copy of its tables serves two lanes.
+//
+extern	void	estimate_lanes(CORE_ESTIMATE *e, int nlanes, bool with_aux,
+			bool shared_tbls = false);
+
+//
+// estimate_report
+//
+// Writes an estimate out in the same form as the rest of gencordic's -v
+// output.
+//
+extern	void	estimate_report(FILE *fp, const CORE_ESTIMATE *e);
+
+#endif	// ESTIMATE_H
@@ -0,0 +1,522 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename: 	explore.cpp
+//
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	A design space explorer for the CORDIC and plain table cores
+//		gencordic can build.  Rather than building and simulating every candidate, this
+//	uses the same analytic noise estimates found in cordiclib.cpp to
+//	predict the carrier to noise ratio (CNR) of each design point, together
+//	with its latency, its throughput (in clocks per output), and a rough
+//	area estimate.  Designs beaten in every one of these measures by some
+//	other design are dropped, leaving only the Pareto front.
+//
+//	The CNR prediction treats the input phase as a quantized version of
+//	a continuous phase, distributes the CORDIC's residual angle (what's
+//	left after the last rotation) uniformly across that last rotation's
+//	reach, and adds in the quantization noise accumulated through each
+//	stage.  It is an estimate, not a measurement--use the bench/cpp test
+//	benches to confirm any design you finally choose.
+//
+//	Latency, throughput, and area all come from estimate.cpp, the same
+//	model gencordic -v reports.  Area is measured in (roughly) six-input
+//	LUTs: one per adder bit, plus one for every 64 bits of table ROM.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2017-2018, Gisselquist Technology, LLC
+//
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+//
+// License:	GPL, v3, as defined and found on www.gnu.org,
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+//
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <assert.h>
+
+#include "cordiclib.h"
+#include "explore.h"
+#include "estimate.h"
+
+//
+// Not every core type is swept.  The hybrid (hp2r), compressed table (ctbl),
+// and quadratically interpolated (qtbl) cores each pick their own table
+// sizes as they are built, by searching for the smallest tables meeting
+// some error or latency goal, so there's no closed form for their noise to
+// predict it by here.  Run gencordic -v on those directly instead.
+typedef	enum	{ CT_P2R=0, CT_SP2R, CT_R2P, CT_SR2P, CT_P2R4, CT_R2P4,
+		CT_TBL, CT_QTR
+	} CORE_TYPE;
+
+static	const	char	*core_names[] = {
+		"p2r", "sp2r", "r2p", "sr2p", "p2r4", "r2p4", "tbl", "qtr" };
+
+static	const	GENCORDIC_TYPE	core_gctype[] = {
+		GC_P2R, GC_SP2R, GC_R2P, GC_SR2P, GC_P2R4, GC_R2P4,
+		GC_TBL, GC_QTR };
+
+//
+// Only designs that compute the same function compete against each other:
+// rotators (p2r, sp2r, p2r4), rectangular to polar converters (r2p, sr2p,
+// r2p4), and sinewave tables (tbl, qtr).
+static	int	core_function(CORE_TYPE ct) {
+	switch(ct) {
+	case CT_P2R: case CT_SP2R: case CT_P2R4:	return 0;
+	case CT_R2P: case CT_SR2P: case CT_R2P4:	return 1;
+	default:					return 2;
+	}
+}
+
+typedef	struct	{
+	CORE_TYPE	ctype;
+	int		nxtra, phase_bits, nstages, ww;
+	double		cnr;
+	int		latency, clocks, area;
+	long		rom_bits;
+	int		ffs, bram18, dsps;
+	bool		pareto;
+} DESIGN_POINT;
+
+// The limits of our sweep
+static	const	int	MAX_XTRA      = 8,
+			MIN_STAGES    = 4,
+			MIN_PHASEBITS = 4,
+			MAX_PHASEBITS = 32,	// The limit of the models
+			MAX_LGTABLE   = 24;	// The limit of sintable.cpp
+
+//
+// Work is handed out to the worker threads in blocks of this many points
+static	const	int	EXPLORE_BLOCK = 64;
+
+typedef	struct	{
+	DESIGN_POINT	*dp;
+	int		npts, next, iw, ow;
+	bool		check_dominance;
+	pthread_mutex_t	lock;
+} EXPLORE_WORK;
+
+//
+// residual_variance
+//
+// The variance, in radians^2, of the angle left over once a CORDIC's last
+// rotation, by atan(2^-last_shift), is complete.
+static	double	residual_variance(int last_shift) {
+	double	reach;
+
+	if (last_shift <= 0)
+		reach = M_PI / 4.0;
+	else
+		reach = atan2(1., pow(2,last_shift));
+	return reach * reach / 3.0;
+}
+
+//
+// predict
+//
+// Fills in the CNR, latency, throughput, and area of one design point.
+static	void	predict(DESIGN_POINT *d, int iw, int ow) {
+	const	double	amplitude_in = (1ul<<(iw-1))-1.;
+	double	amplitude, qvar, pvar, delta;
+	int	neff, xtra, lim;
+	CORE_ESTIMATE	est;
+
+	switch(d->ctype) {
+	case CT_P2R: case CT_SP2R: case CT_P2R4:
+		// Only those stages with a non-zero angle, that shift by
+		// less than the working width, have any effect.  The
+		// sequential core, on the other hand, only ever applies
+		// its first NSTAGES-2 rotations.  The radix-4 core skips
+		// stages just as the radix-2 one does, and so has the
+		// same gain.
+		if (d->ctype != CT_SP2R)
+			neff = d->nstages;
+		else
+			neff = d->nstages-2;
+		lim = calc_stages(d->ww, d->phase_bits);
+		if (neff > lim)
+			neff = lim;
+		if (neff < 0)
+			neff = 0;
+		xtra = d->ww - iw - 1;
+		amplitude = amplitude_in * cordic_gain(neff) * pow(2.,ow-iw-1);
+		break;
+	case CT_R2P: case CT_SR2P: case CT_R2P4:
+		// The pipelined cores skip the same stages the p2r core
+		// does, the sequential core only those with no angle
+		neff = d->nstages;
+		if (d->ctype != CT_SR2P)
+			lim = calc_stages(d->ww, d->phase_bits);
+		else
+			lim = calc_stages(d->phase_bits);
+		if (neff > lim)
+			neff = lim;
+		// The first stage rotates by 45 degrees, growing the
+		// magnitude by sqrt(2)
+		xtra = d->ww - iw - 2;
+		amplitude = amplitude_in * cordic_gain(neff) * pow(2.,ow-iw-2)
+				* M_SQRT2;
+		break;
+	default:
+		neff = 0;
+		xtra = 0;
+		amplitude = (1ul<<(ow-1))-1.;
+		break;
+	}
+
+	switch(d->ctype) {
+	case CT_P2R: case CT_SP2R: case CT_R2P: case CT_SR2P:
+		qvar = transform_quantization_variance(neff, xtra, d->ww-ow);
+		pvar = phase_variance(neff, d->phase_bits)
+			+ residual_variance(neff);
+		d->rom_bits = 0;
+		break;
+	case CT_P2R4: case CT_R2P4:
+		// Every shifted term is rounded, and the r2p4 phase also
+		// carries whatever rounding is left in y once the vector
+		// has been driven to the x axis
+		qvar = radix4_quantization_variance(neff, xtra, d->ww-ow);
+		pvar = radix4_phase_variance(neff, d->phase_bits)
+			+ residual_variance(neff);
+		if (d->ctype == CT_R2P4)
+			pvar += radix4_vectoring_variance(neff, iw, d->ww);
+		d->rom_bits = 0;
+		break;
+	case CT_TBL:
+		// The table entries are truncated towards zero, and are
+		// indexed by the phase at the beginning of each step
+		delta = 2.0 * M_PI / (double)(1ul << d->phase_bits);
+		qvar = 1./3.;
+		pvar = delta * delta / 3.;
+		d->rom_bits = (1l << d->phase_bits) * ow;
+		break;
+	case CT_QTR: default:
+		// ... whereas the quarter wave table is indexed by the
+		// phase in the middle of each step
+		delta = 2.0 * M_PI / (double)(1ul << d->phase_bits);
+		qvar = 1./3.;
+		pvar = delta * delta / 12.;
+		d->rom_bits = (1l << (d->phase_bits-2)) * ow;
+		break;
+	}
+
+	// These estimates aren't good to any better than a tenth of a dB, so
+	// don't let differences finer than that keep a design on the front
+	d->cnr = 10.0 * log10(amplitude * amplitude
+			/ (qvar + amplitude * amplitude * pvar));
+	d->cnr = round(d->cnr * 10.0) / 10.0;
+
+	// The same estimates gencordic -v reports for the core it builds
+	if (d->ctype == CT_TBL || d->ctype == CT_QTR)
+		estimate_table(&est, core_gctype[d->ctype], d->phase_bits, ow);
+	else
+		estimate_cordic(&est, core_gctype[d->ctype], d->nstages, d->ww,
+			ow, d->phase_bits);
+	d->latency = est.latency;
+	d->clocks  = est.clocks;
+	d->area    = est.area;
+	d->ffs     = est.ffs;
+	d->bram18  = est.bram18;
+	d->dsps    = est.dsps;
+}
+
+//
+// dominates
+//
+// Returns true if design a does the same job as design b while being at
+// least as good in every measure, and better in at least one.  Of two
+// identical designs, the first one listed wins.
+static	bool	dominates(const DESIGN_POINT *a, int ia,
+			const DESIGN_POINT *b, int ib) {
+	if (core_function(a->ctype) != core_function(b->ctype))
+		return false;
+	if ((a->cnr < b->cnr)||(a->latency > b->latency)
+			||(a->clocks > b->clocks)||(a->area > b->area))
+		return false;
+	if ((a->cnr > b->cnr)||(a->latency < b->latency)
+			||(a->clocks < b->clocks)||(a->area < b->area))
+		return true;
+	return (ia < ib);
+}
+
+//
+// explore_worker
+//
+// Each worker grabs a block of design points at a time, and either predicts
+// their performance or checks whether any other design beats them.
+static	void	*explore_worker(void *arg) {
+	EXPLORE_WORK	*w = (EXPLORE_WORK *)arg;
+
+	while(1) {
+		int	first, last;
+
+		pthread_mutex_lock(&w->lock);
+		first = w->next;
+		w->next += EXPLORE_BLOCK;
+		pthread_mutex_unlock(&w->lock);
+
+		if (first >= w->npts)
+			break;
+		last = first + EXPLORE_BLOCK;
+		if (last > w->npts)
+			last = w->npts;
+
+		for(int k=first; k<last; k++) {
+			if (!w->check_dominance) {
+				predict(&w->dp[k], w->iw, w->ow);
+				continue;
+			}
+
+			w->dp[k].pareto = true;
+			for(int j=0; j<w->npts; j++) {
+				if ((j != k)&&(dominates(&w->dp[j], j,
+							&w->dp[k], k))) {
+					w->dp[k].pareto = false;
+					break;
+				}
+			}
+		}
+	}
+
+	return NULL;
+}
+
+static	void	explore_run(EXPLORE_WORK *w, int nthreads) {
+	pthread_t	*threads = new pthread_t[nthreads];
+	int		nstarted;
+
+	// Should we run out of threads, this one picks up whatever blocks
+	// the others leave
+	w->next = 0;
+	for(nstarted=0; nstarted<nthreads; nstarted++)
+		if (0 != pthread_create(&threads[nstarted], NULL,
+				explore_worker, w))
+			break;
+	if (nstarted < nthreads)
+		explore_worker(w);
+	for(int k=0; k<nstarted; k++)
+		pthread_join(threads[k], NULL);
+	delete[] threads;
+}
+
+//
+// by_latency
+//
+// Orders the front by function, then by latency, throughput, and area,
+// with the best CNR first among otherwise equal designs
+static	int	by_latency(const void *va, const void *vb) {
+	const	DESIGN_POINT	*a = *(const DESIGN_POINT **)va,
+				*b = *(const DESIGN_POINT **)vb;
+
+	if (core_function(a->ctype) != core_function(b->ctype))
+		return core_function(a->ctype) - core_function(b->ctype);
+	if (a->latency != b->latency)
+		return a->latency - b->latency;
+	if (a->clocks != b->clocks)
+		return a->clocks - b->clocks;
+	if (a->area != b->area)
+		return a->area - b->area;
+	if (a->cnr != b->cnr)
+		return (a->cnr > b->cnr) ? -1 : 1;
+	return (a < b) ? -1 : 1;
+}
+
+//
+// explore_command
+//
+// Writes the gencordic command line that will build this design
+static	void	explore_command(char *str, const DESIGN_POINT *d,
+			int iw, int ow) {
+	if ((d->ctype == CT_TBL)||(d->ctype == CT_QTR))
+		sprintf(str, "gencordic -t %s -o %d -p %d",
+			core_names[d->ctype], ow, d->phase_bits);
+	else
+		sprintf(str, "gencordic -t %s -i %d -o %d -x %d -p %d -n %d",
+			core_names[d->ctype], iw, ow, d->nxtra,
+			d->phase_bits, d->nstages);
+}
+
+void	explore(FILE *fp, bool json, int iw, int ow, int nxtra,
+		int nstages, int phase_bits, int nthreads) {
+	EXPLORE_WORK	w;
+	DESIGN_POINT	**front;
+	int		maxpts, nfront;
+	char		cmd[128];
+
+	assert((iw > 1)&&(ow > 1));
+	if (nthreads <= 0)
+		nthreads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+	if (nthreads <= 0)
+		nthreads = 1;
+
+	// Count (an upper bound on) how many design points we'll need
+	maxpts = 6 * (MAX_XTRA+1) * (MAX_PHASEBITS+1) * 65
+		+ 2 * (MAX_LGTABLE+1);
+	w.dp   = new DESIGN_POINT[maxpts];
+	w.npts = 0;
+	w.iw   = iw;
+	w.ow   = ow;
+	pthread_mutex_init(&w.lock, NULL);
+
+	//
+	// Enumerate every design point.  The generator adjusts its extra
+	// bits before building any CORDIC, so we do the same here so as to
+	// know the working width each design will have.
+	for(int ct=CT_P2R; ct<=CT_R2P4; ct++) {
+		bool	to_polar = (ct == CT_R2P)||(ct == CT_SR2P)
+				||(ct == CT_R2P4);
+		int	xlo = (nxtra >= 0) ? nxtra : 0,
+			xhi = (nxtra >= 0) ? nxtra : MAX_XTRA;
+
+		for(int x=xlo; x<=xhi; x++) {
+			int	ww = (iw > ow) ? iw : ow, adj, plo, phi;
+
+			if (to_polar) {
+				adj = (x+2 < 2) ? 2 : x+2;
+				ww += 2*adj;
+			} else {
+				adj = (x+1 < 1) ? 1 : x+1;
+				ww += adj;
+			}
+
+			if (phase_bits > 0) {
+				plo = phi = phase_bits;
+			} else {
+				plo = calc_phase_bits(ww) - 8;
+				phi = calc_phase_bits(ww) + 4;
+				if (plo < MIN_PHASEBITS)
+					plo = MIN_PHASEBITS;
+				if (phi > MAX_PHASEBITS)
+					phi = MAX_PHASEBITS;
+			}
+
+			for(int pw=plo; pw<=phi; pw++) {
+				int	nlo, nhi;
+
+				if (nstages > 0) {
+					nlo = nhi = nstages;
+				} else {
+					nlo = MIN_STAGES;
+					nhi = (to_polar) ? calc_stages(pw)
+						: calc_stages(ww, pw);
+					// The sequential p2r core leaves
+					// off its last two rotations
+					if (ct == CT_SP2R)
+						nhi += 2;
+				}
+
+				for(int n=nlo; n<=nhi; n++) {
+					DESIGN_POINT	*d = &w.dp[w.npts++];
+
+					assert(w.npts <= maxpts);
+					d->ctype = (CORE_TYPE)ct;
+					d->nxtra = x;
+					d->phase_bits = pw;
+					d->nstages = n;
+					d->ww = ww;
+				}
+			}
+		}
+	}
+
+	for(int ct=CT_TBL; ct<=CT_QTR; ct++) {
+		int	plo, phi;
+
+		if (phase_bits > 0) {
+			plo = phi = phase_bits;
+		} else {
+			plo = MIN_PHASEBITS;
+			phi = calc_phase_bits(ow) + 4;
+		}
+		if (phi > MAX_LGTABLE)
+			phi = MAX_LGTABLE;
+
+		for(int pw=plo; pw<=phi; pw++) {
+			DESIGN_POINT	*d = &w.dp[w.npts++];
+
+			assert(w.npts <= maxpts);
+			d->ctype = (CORE_TYPE)ct;
+			d->nxtra = 0;
+			d->phase_bits = pw;
+			d->nstages = 0;
+			d->ww = ow;
+		}
+	}
+
+	// Predict how well each design will do, then find which of them
+	// aren't beaten by any other
+	w.check_dominance = false;
+	explore_run(&w, nthreads);
+	w.check_dominance = true;
+	explore_run(&w, nthreads);
+
+	front = new DESIGN_POINT *[w.npts];
+	nfront = 0;
+	for(int k=0; k<w.npts; k++)
+		if (w.dp[k].pareto)
+			front[nfront++] = &w.dp[k];
+	qsort(front, nfront, sizeof(DESIGN_POINT *), by_latency);
+
+	if (json)
+		fprintf(fp, "[\n");
+	else
+		fprintf(fp, "type,iw,ow,nxtra,phase_bits,nstages,ww,cnr_db,"
+			"latency,clocks_per_output,area_luts,rom_bits,ffs,bram18,"
+			"dsps,command\n");
+	for(int k=0; k<nfront; k++) {
+		const	DESIGN_POINT	*d = front[k];
+
+		explore_command(cmd, d, iw, ow);
+		if (json)
+			fprintf(fp, "  { \"type\": \"%s\", \"iw\": %d, \"ow\": %d, "
+				"\"nxtra\": %d, \"phase_bits\": %d, "
+				"\"nstages\": %d, \"ww\": %d, "
+				"\"cnr_db\": %.1f, \"latency\": %d, "
+				"\"clocks_per_output\": %d, "
+				"\"area_luts\": %d, \"rom_bits\": %ld, "
+				"\"ffs\": %d, \"bram18\": %d, \"dsps\": %d, "
+				"\"command\": \"%s\" }%s\n",
+				core_names[d->ctype], iw, ow, d->nxtra,
+				d->phase_bits, d->nstages, d->ww, d->cnr,
+				d->latency, d->clocks, d->area, d->rom_bits,
+				d->ffs, d->bram18, d->dsps,
+				cmd, (k+1 < nfront) ? "," : "");
+		else
+			fprintf(fp, "%s,%d,%d,%d,%d,%d,%d,%.1f,%d,%d,%d,%ld,%d,%d,%d,%s\n",
+				core_names[d->ctype], iw, ow, d->nxtra,
+				d->phase_bits, d->nstages, d->ww, d->cnr,
+				d->latency, d->clocks, d->area, d->rom_bits,
+				d->ffs, d->bram18, d->dsps, cmd);
+	}
+	if (json)
+		fprintf(fp, "]\n");
+
+	pthread_mutex_destroy(&w.lock);
+	delete[] front;
+	delete[] w.dp;
+}
@@ -0,0 +1,60 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename: 	explore.h
+//
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	Declares the design space explorer.  Given the input and output
+//		widths a design needs, this sweeps the remaining generator
+//	parameters across the CORDIC (p2r, sp2r, p2r4, r2p, sr2p, r2p4) and
+//	plain table (tbl, qtr) core types, predicts the noise, latency, and
+//	area of each, and reports those designs that no other design beats.
+//	The hp2r, ctbl, and qtbl cores size their own tables as they are
+//	built, and so aren't swept.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2017-2018, Gisselquist Technology, LLC
+//
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+//
+// License:	GPL, v3, as defined and found on www.gnu.org,
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+//
+#ifndef	EXPLORE_H
+#define	EXPLORE_H
+
+#include <stdio.h>
+
+//
+// explore
+//
+// Any of nxtra, nstages, or phase_bits that are non-negative are held fixed
+// rather than swept.  The Pareto front is written to fp, as CSV or, if json
+// is set, as JSON, one design per line.  The sweep is spread across
+// nthreads worker threads.
+//
+extern	void	explore(FILE *fp, bool json, int iw, int ow, int nxtra,
+			int nstages, int phase_bits, int nthreads);
+
+#endif	// EXPLORE_H
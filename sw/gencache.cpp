@@ -0,0 +1,493 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename: 	gencache.cpp
+//
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	A cache of previously generated cores, so that rebuilding a
+//		core with the same parameters doesn't actually need to build
+//	anything.
+//
+//	Each cache entry lives in its own directory, named by a 64-bit FNV-1a
+//	hash of the generator's parameters and of the executable's size and
+//	modification time, so that relinking gencordic invalidates every
+//	entry.  Within that directory are the generated files, numbered
+//	0, 1, 2, ..., a MANIFEST listing where each belongs, and a LOG
+//	holding whatever the run printed with -v, to be printed again when
+//	the entry is restored.
+//
+//	Files are always copied in and out of the cache, never linked, so
+//	that nothing done to the generated files can change the cache.
+//
+//	While the cache is on, every output file is written to a temporary
+//	file first and only renamed into place if its content has changed.
+//	Unchanged files keep their timestamps, and so don't trigger any
+//	rebuild of whatever depends upon them downstream.  (A Makefile that
+//	wants to know a core is up to date should therefore keep a stamp of
+//	its own, rather than trusting the time stamps of the outputs.)
+//
+//	Since every output file is opened here, this is also where a library
+//	caller's sink takes the place of the disk.  Each file is then written
+//	to memory, and handed to the sink once the core is complete.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2017-2018, Gisselquist Technology, LLC
+//
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+//
+// License:	GPL, v3, as defined and found on www.gnu.org,
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+//
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <assert.h>
+#include <pthread.h>
+
+#include "gencache.h"
+#include "libgencordic.h"
+
+static	const	char	GENCACHE_VERSION[] = "gencordic-cache-2";
+static	const	int	GENCACHE_MAXFILES  = 32;
+
+// Every thread has its own cache state, so that a batch of cores may be
+// built at once
+static	thread_local	char	*cache_dir = NULL, *cache_key = NULL;
+static	thread_local	int	cache_nfiles = 0;
+static	thread_local	char	*cache_final[GENCACHE_MAXFILES],
+				*cache_temp[GENCACHE_MAXFILES];
+static	pthread_once_t	cache_once = PTHREAD_ONCE_INIT;
+static	int		cache_nthreads = 0;
+static	thread_local	int	cache_thread = -1;
+// The sink, if any, and the in-memory files headed for it
+static	thread_local	GENCORDIC_SINK	*mem_sink = NULL;
+static	thread_local	int	mem_nfiles = 0;
+static	thread_local	char	*mem_fname[GENCACHE_MAXFILES],
+				*mem_buf[GENCACHE_MAXFILES];
+static	thread_local	size_t	mem_len[GENCACHE_MAXFILES];
+// What this run has printed, to be kept with its entry
+static	thread_local	FILE	*log_fp = NULL;
+static	thread_local	char	*log_buf = NULL;
+static	thread_local	size_t	log_len = 0;
+
+static	unsigned long	fnv_hash(unsigned long h, const void *vp, size_t len) {
+	const	unsigned char	*p = (const unsigned char *)vp;
+
+	for(size_t k=0; k<len; k++) {
+		h ^= p[k];
+		h *= 0x100000001b3ul;
+	}
+	return h;
+}
+
+//
+// Removes any temporary files left behind should we exit before
+// gencache_commit()
+static	void	gencache_cleanup(void) {
+	for(int k=0; k<cache_nfiles; k++)
+		if (cache_temp[k])
+			unlink(cache_temp[k]);
+}
+
+static	void	gencache_atexit(void) {
+	atexit(gencache_cleanup);
+}
+
+//
+// tmpname
+//
+// Names a temporary file for base, unique to this process and thread.  buf
+// must have room for 32 characters more than base.
+static	void	tmpname(char *buf, const char *base) {
+	if (cache_thread < 0)
+		cache_thread = __sync_fetch_and_add(&cache_nthreads, 1);
+	sprintf(buf, "%s.gc%d.%d", base, (int)getpid(), cache_thread);
+}
+
+// Makes a directory, along with any parents it needs
+static	bool	mkdirs(const char *path) {
+	char	*str = strdup(path), *ptr;
+	bool	ok = true;
+
+	for(ptr = str+1; *ptr; ptr++) {
+		if (*ptr != '/')
+			continue;
+		*ptr = '\0';
+		if ((0 != mkdir(str, 0777))&&(errno != EEXIST))
+			ok = false;
+		*ptr = '/';
+	}
+	if ((0 != mkdir(str, 0777))&&(errno != EEXIST))
+		ok = false;
+	free(str);
+	return ok;
+}
+
+// Returns true if the two files have the same content
+static	bool	same_file(const char *a, const char *b) {
+	struct	stat	sa, sb;
+	FILE	*fa, *fb;
+	bool	same = true;
+	char	bufa[8192], bufb[8192];
+
+	if ((0 != stat(a, &sa))||(0 != stat(b, &sb)))
+		return false;
+	if (sa.st_size != sb.st_size)
+		return false;
+	if ((sa.st_dev == sb.st_dev)&&(sa.st_ino == sb.st_ino))
+		return true;
+
+	fa = fopen(a, "rb");
+	fb = fopen(b, "rb");
+	if ((NULL == fa)||(NULL == fb))
+		same = false;
+	while(same) {
+		size_t	na = fread(bufa, 1, sizeof(bufa), fa),
+			nb = fread(bufb, 1, sizeof(bufb), fb);
+
+		if ((na != nb)||(0 != memcmp(bufa, bufb, na)))
+			same = false;
+		else if (na == 0)
+			break;
+	}
+	if (fa)
+		fclose(fa);
+	if (fb)
+		fclose(fb);
+	return same;
+}
+
+static	bool	copy_file(const char *src, const char *dst) {
+	FILE	*fi, *fo;
+	char	buf[65536];
+	size_t	n;
+	bool	ok = true;
+
+	if (NULL == (fi = fopen(src, "rb")))
+		return false;
+	if (NULL == (fo = fopen(dst, "wb"))) {
+		fclose(fi);
+		return false;
+	}
+	while((n = fread(buf, 1, sizeof(buf), fi)) > 0)
+		if (n != fwrite(buf, 1, n, fo))
+			ok = false;
+	fclose(fi);
+	if (0 != fclose(fo))
+		ok = false;
+	return ok;
+}
+
+//
+// place_file
+//
+// Puts a copy of src at dst, with the new file appearing at dst all at
+// once.  Hard links would be faster, but then the next run to open dst for
+// writing, without the cache, would also rewrite the cache entry.
+static	bool	place_file(const char *src, const char *dst) {
+	char	*tmp = new char[strlen(dst)+32];
+	bool	ok;
+
+	tmpname(tmp, dst);
+	unlink(tmp);
+	ok = copy_file(src, tmp);
+	if ((ok)&&(0 != rename(tmp, dst)))
+		ok = false;
+	if (!ok)
+		unlink(tmp);
+	delete[] tmp;
+	return ok;
+}
+
+void	gencache_init(const char *dir, const char *params) {
+	unsigned long	h = 0xcbf29ce484222325ul;
+	struct	stat	sb;
+
+	h = fnv_hash(h, GENCACHE_VERSION, strlen(GENCACHE_VERSION));
+	h = fnv_hash(h, params, strlen(params));
+
+	// Any change to the generator, as evidenced by a change in its
+	// size or time stamp, invalidates the cache
+	if (0 == stat("/proc/self/exe", &sb)) {
+		unsigned long	id[3];
+
+		id[0] = sb.st_size;
+		id[1] = sb.st_mtim.tv_sec;
+		id[2] = sb.st_mtim.tv_nsec;
+		h = fnv_hash(h, id, sizeof(id));
+	} else {
+		fprintf(stderr, "WARNING: Cannot identify the generator, cache disabled\n");
+		return;
+	}
+
+	if (!mkdirs(dir)) {
+		fprintf(stderr, "WARNING: Cannot create cache directory %s\n", dir);
+		return;
+	}
+
+	gencache_close();
+	cache_dir = strdup(dir);
+	cache_key = new char[20];
+	sprintf(cache_key, "%016lx", h);
+	pthread_once(&cache_once, gencache_atexit);
+}
+
+bool	gencache_restore(void) {
+	char	*entry, *path, line[4096];
+	FILE	*fman;
+	bool	ok = true;
+	int	nf = 0;
+
+	if (NULL == cache_key)
+		return false;
+
+	entry = new char[strlen(cache_dir)+strlen(cache_key)+32];
+	sprintf(entry, "%s/%s/MANIFEST", cache_dir, cache_key);
+	fman = fopen(entry, "r");
+	if (NULL == fman) {
+		delete[] entry;
+		return false;
+	}
+
+	path = new char[strlen(entry)+16];
+	while((ok)&&(fgets(line, sizeof(line), fman))) {
+		int	slen = strlen(line);
+
+		if ((slen > 0)&&(line[slen-1] == '\n'))
+			line[--slen] = '\0';
+		if (slen == 0)
+			continue;
+		sprintf(path, "%s/%s/%d", cache_dir, cache_key, nf++);
+		if (!same_file(path, line))
+			ok = place_file(path, line);
+	}
+	fclose(fman);
+
+	// Then repeat whatever the original run had to say
+	sprintf(path, "%s/%s/LOG", cache_dir, cache_key);
+	if ((ok)&&(NULL != (fman = fopen(path, "r")))) {
+		size_t	n;
+
+		while((n = fread(line, 1, sizeof(line), fman)) > 0)
+			fwrite(line, 1, n, stdout);
+		fclose(fman);
+	}
+
+	if (!ok)
+		fprintf(stderr, "WARNING: Could not restore from cache entry %s\n", cache_key);
+
+	delete[] path;
+	delete[] entry;
+	return ok;
+}
+
+FILE	*gencache_log(void) {
+	if ((NULL == cache_key)||(NULL != mem_sink))
+		return stdout;
+	if (NULL == log_fp)
+		log_fp = open_memstream(&log_buf, &log_len);
+	return (log_fp) ? log_fp : stdout;
+}
+
+void	gencache_sink(GENCORDIC_SINK *sink) {
+	gencache_close();
+	mem_sink = sink;
+}
+
+//
+// mem_fopen
+//
+// Opens a file in memory, for the sink.  As with the cache, a file written
+// twice keeps only its last copy.
+static	FILE	*mem_fopen(const char *fname) {
+	int	k;
+
+	for(k=0; k<mem_nfiles; k++)
+		if (0 == strcmp(mem_fname[k], fname))
+			break;
+	if (k >= GENCACHE_MAXFILES) {
+		fprintf(stderr, "ERR: Too many generated files to keep\n");
+		return NULL;
+	} else if (k == mem_nfiles) {
+		mem_fname[k] = strdup(fname);
+		mem_buf[k] = NULL;
+		mem_nfiles++;
+	}
+
+	free(mem_buf[k]);
+	mem_buf[k] = NULL;
+	mem_len[k] = 0;
+	return open_memstream(&mem_buf[k], &mem_len[k]);
+}
+
+FILE	*gencache_fopen(const char *fname, const char *mode) {
+	FILE	*fp;
+	char	*tmp;
+
+	if (NULL != mem_sink)
+		return mem_fopen(fname);
+	else if (NULL == cache_key)
+		return fopen(fname, mode);
+
+	// Files that are written more than once, such as the quadtbl tables
+	// as the table size is searched for, just overwrite their last copy
+	for(int k=0; k<cache_nfiles; k++)
+		if (0 == strcmp(cache_final[k], fname))
+			return fopen(cache_temp[k], mode);
+
+	if (cache_nfiles >= GENCACHE_MAXFILES) {
+		fprintf(stderr, "ERR: Too many generated files to cache\n");
+		return NULL;
+	}
+
+	tmp = new char[strlen(fname)+32];
+	tmpname(tmp, fname);
+	fp = fopen(tmp, mode);
+	if (NULL == fp) {
+		delete[] tmp;
+		return NULL;
+	}
+
+	cache_final[cache_nfiles] = strdup(fname);
+	cache_temp[cache_nfiles]  = tmp;
+	cache_nfiles++;
+	return fp;
+}
+
+void	gencache_commit(void) {
+	char	*entry, *tmpent, *path;
+	FILE	*fman;
+	bool	ok;
+
+	if (NULL != mem_sink) {
+		for(int k=0; k<mem_nfiles; k++)
+			mem_sink->file(mem_fname[k],
+				(mem_buf[k]) ? mem_buf[k] : "", mem_len[k]);
+		gencache_close();
+		return;
+	} else if (NULL == cache_key)
+		return;
+
+	// Move every file into place, leaving those that haven't changed
+	// alone
+	for(int k=0; k<cache_nfiles; k++) {
+		if (same_file(cache_temp[k], cache_final[k]))
+			unlink(cache_temp[k]);
+		else if (0 != rename(cache_temp[k], cache_final[k])) {
+			fprintf(stderr, "ERR: Cannot rename %s to %s\n",
+				cache_temp[k], cache_final[k]);
+			unlink(cache_temp[k]);
+		}
+		delete[] cache_temp[k];
+		cache_temp[k] = NULL;
+	}
+
+	// Then build a new cache entry, in a temporary directory that gets
+	// renamed into place once complete
+	entry  = new char[strlen(cache_dir)+strlen(cache_key)+32];
+	tmpent = new char[strlen(cache_dir)+strlen(cache_key)+32];
+	path   = new char[strlen(cache_dir)+strlen(cache_key)+64];
+	sprintf(entry,  "%s/%s", cache_dir, cache_key);
+	tmpname(tmpent, entry);
+
+	ok = (0 == mkdir(tmpent, 0777));
+	sprintf(path, "%s/MANIFEST", tmpent);
+	fman = (ok) ? fopen(path, "w") : NULL;
+	ok = (NULL != fman);
+	for(int k=0; (ok)&&(k<cache_nfiles); k++) {
+		sprintf(path, "%s/%d", tmpent, k);
+		ok = copy_file(cache_final[k], path);
+		fprintf(fman, "%s\n", cache_final[k]);
+	}
+	if (fman)
+		fclose(fman);
+	if ((ok)&&(NULL != log_fp)) {
+		FILE	*flog;
+
+		fflush(log_fp);
+		sprintf(path, "%s/LOG", tmpent);
+		flog = fopen(path, "w");
+		ok = (NULL != flog);
+		if ((ok)&&(log_len != fwrite(log_buf, 1, log_len, flog)))
+			ok = false;
+		if ((flog)&&(0 != fclose(flog)))
+			ok = false;
+	}
+
+	// If someone else got there first, their entry is as good as ours
+	if ((!ok)||(0 != rename(tmpent, entry))) {
+		for(int k=0; k<cache_nfiles; k++) {
+			sprintf(path, "%s/%d", tmpent, k);
+			unlink(path);
+		}
+		sprintf(path, "%s/MANIFEST", tmpent);
+		unlink(path);
+		sprintf(path, "%s/LOG", tmpent);
+		unlink(path);
+		rmdir(tmpent);
+	}
+
+	delete[] path;
+	delete[] tmpent;
+	delete[] entry;
+
+	gencache_close();
+}
+
+void	gencache_close(void) {
+	gencache_cleanup();
+	for(int k=0; k<cache_nfiles; k++) {
+		free(cache_final[k]);
+		delete[] cache_temp[k];
+	}
+	cache_nfiles = 0;
+
+	free(cache_dir);
+	delete[] cache_key;
+	cache_dir = NULL;
+	cache_key = NULL;
+
+	// Whatever was said along the way still gets said, even if the
+	// core never made it into the cache
+	if (NULL != log_fp) {
+		fclose(log_fp);
+		if (log_len > 0)
+			fwrite(log_buf, 1, log_len, stdout);
+		free(log_buf);
+		log_fp  = NULL;
+		log_buf = NULL;
+		log_len = 0;
+	}
+
+	for(int k=0; k<mem_nfiles; k++) {
+		free(mem_fname[k]);
+		free(mem_buf[k]);
+	}
+	mem_nfiles = 0;
+	mem_sink = NULL;
+}
@@ -0,0 +1,115 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename: 	gencache.h
+//
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	Declares a cache of previously generated cores.  Given the
+//		same parameters and the same gencordic executable, a core
+//	comes out the same every time, so rather than building it again its
+//	files can simply be copied (or linked) back out of the cache.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2017-2018, Gisselquist Technology, LLC
+//
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+//
+// License:	GPL, v3, as defined and found on www.gnu.org,
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+//
+#ifndef	GENCACHE_H
+#define	GENCACHE_H
+
+#include <stdio.h>
+
+class	GENCORDIC_SINK;
+
+//
+// gencache_init
+//
+// Turns the cache on, keeping its entries under dir.  The key for this run
+// is formed from params, a description of every parameter that affects the
+// generated files, together with the identity of this executable.
+//
+extern	void	gencache_init(const char *dir, const char *params);
+
+//
+// gencache_restore
+//
+// If the cache holds the files from a run with the same key, copies them
+// into place, prints again whatever the original run printed to its
+// gencache_log(), and returns true.  Files that already hold the same
+// content are left untouched, time stamp and all.
+//
+extern	bool	gencache_restore(void);
+
+//
+// gencache_fopen
+//
+// Opens an output file.  With the cache on, the file is written to a
+// temporary file at first, and only moved into place (if it has changed)
+// by gencache_commit().  With a sink, the file is kept in memory instead.
+// Otherwise, this is just fopen().
+//
+extern	FILE	*gencache_fopen(const char *fname, const char *mode);
+
+//
+// gencache_commit
+//
+// Once every file has been written and closed, moves each into place and
+// saves copies of them all in the cache--or, with a sink, hands each to the
+// sink.
+//
+extern	void	gencache_commit(void);
+
+//
+// gencache_close
+//
+// Turns the cache back off, throwing away any files opened since
+// gencache_init() that haven't been committed.  gencache_commit() does this
+// itself once done.  Each thread keeps a cache of its own, so that several
+// cores may be built at once.
+//
+extern	void	gencache_close(void);
+
+//
+// gencache_log
+//
+// Returns where this run's verbose output should go.  With the cache on,
+// that's a buffer which gencache_commit() saves with the cache entry, and
+// which gets printed to stdout once the cache is closed.  Otherwise, it's
+// just stdout.
+//
+extern	FILE	*gencache_log(void);
+
+//
+// gencache_sink
+//
+// Sends every file this thread opens from now on to sink, rather than to
+// the disk or the cache, until the next gencache_commit() or
+// gencache_close().
+//
+extern	void	gencache_sink(GENCORDIC_SINK *sink);
+
+#endif	// GENCACHE_H
@@ -4,7 +4,14 @@
 //
 // Project:	A series of CORDIC related projects
 //
-// Purpose:
+// Purpose:	Writes out the tables used to initialize the block RAMs within
+//		the table based cores.  The .hex file, read by $readmemh()
+//	within the Verilog, is always written.  Xilinx .coe, Intel .mif, and
+//	raw binary .bin copies of the same table may be requested as well.
+//
+//	Tables may have many millions of entries, so rather than going through
+//	printf() once per entry, each file is formatted by hand into a large
+//	buffer that is then written out a block at a time.
 //
 // Creator:	Dan Gisselquist, Ph.D.
 //		Gisselquist Technology, LLC
@@ -41,12 +48,164 @@
 #include <math.h>
 #include <assert.h>
 
+#include "hexfile.h"
+#include "gencache.h"
+
 const	char	*DEFAULT_EXTENSION = ".hex";
 
+// The formats, beyond .hex, that every table is also to be written in.  Each
+// thread keeps its own, so that cores built at once may differ.
+static	thread_local	unsigned	table_formats = 0;
+
+static	const	char	*FORMAT_NAMES[] = { "hex", "bin", "coe", "mif" };
+static	const	int	NFORMATS = 4;
+
+//
+// TBLWRITER
+//
+// A simple buffered writer.  Output collects in buf, and is only handed to
+// the O/S once TBLWRITER_BUFSZ bytes have accumulated.
+static	const	size_t	TBLWRITER_BUFSZ = (1<<20);
+
+typedef	struct	{
+	FILE	*fp;
+	char	*buf;
+	size_t	len;
+} TBLWRITER;
+
+static	const	char	HEXDIGITS[] = "0123456789abcdef";
+
+static	void	tw_flush(TBLWRITER *tw) {
+	if (tw->len > 0)
+		fwrite(tw->buf, 1, tw->len, tw->fp);
+	tw->len = 0;
+}
+
+// Make certain at least n more bytes will fit in our buffer
+static	inline	void	tw_reserve(TBLWRITER *tw, size_t n) {
+	assert(n <= TBLWRITER_BUFSZ);
+	if (tw->len + n > TBLWRITER_BUFSZ)
+		tw_flush(tw);
+}
+
+static	void	tw_str(TBLWRITER *tw, const char *str) {
+	size_t	n = strlen(str);
+
+	tw_reserve(tw, n);
+	memcpy(&tw->buf[tw->len], str, n);
+	tw->len += n;
+}
+
+// Writes the nc least significant hex digits of v
+static	inline	void	tw_hex(TBLWRITER *tw, unsigned long v, int nc) {
+	char	*ptr;
+
+	tw_reserve(tw, nc);
+	ptr = &tw->buf[tw->len + nc];
+	for(int k=0; k<nc; k++) {
+		*--ptr = HEXDIGITS[v & 0x0f];
+		v >>= 4;
+	}
+	tw->len += nc;
+}
+
+static	inline	void	tw_byte(TBLWRITER *tw, char ch) {
+	tw_reserve(tw, 1);
+	tw->buf[tw->len++] = ch;
+}
+
+bool	hextable_formats(const char *list) {
+	const	char	*ptr = list;
+	unsigned	formats = 0;
+
+	while(*ptr) {
+		int	n = strcspn(ptr, ","), k;
+
+		for(k=0; k<NFORMATS; k++)
+			if ((n == (int)strlen(FORMAT_NAMES[k]))
+					&&(0 == strncmp(ptr, FORMAT_NAMES[k], n)))
+				break;
+		if (k >= NFORMATS) {
+			fprintf(stderr, "ERR: Unknown table format, %.*s\n", n, ptr);
+			return false;
+		}
+		formats |= (1u << k);
+		ptr += n;
+		if (*ptr == ',')
+			ptr++;
+	}
+
+	// .hex files are always written, since the Verilog depends upon them
+	table_formats = formats & ~1u;
+	return true;
+}
+
+//
+// write_table
+//
+// Writes one table, in one format, to tw
+static	void	write_table(TBLWRITER *tw, int format, const int lgtable,
+		const int ow, const long *data) {
+	int	tbl_entries = (1<<lgtable), nc = (ow+3)/4,
+		na = (lgtable+3)/4, nb = (ow+7)/8;
+	unsigned long	msk = (1ul<<ow)-1ul;
+	char	str[128];
+
+	switch(format) {
+	case 1: // Raw binary, little endian, (ow+7)/8 bytes per entry
+		for(int k=0; k<tbl_entries; k++) {
+			unsigned long	v = data[k] & msk;
+
+			for(int b=0; b<nb; b++) {
+				tw_byte(tw, (char)(v & 0x0ff));
+				v >>= 8;
+			}
+		} break;
+	case 2: // Xilinx memory coefficient (.coe) file
+		sprintf(str, "; %d entries of %d bits each\n", tbl_entries, ow);
+		tw_str(tw, str);
+		tw_str(tw, "memory_initialization_radix=16;\n"
+			"memory_initialization_vector=\n");
+		for(int k=0; k<tbl_entries; k++) {
+			tw_hex(tw, data[k] & msk, nc);
+			tw_str(tw, (k+1 < tbl_entries) ? ",\n" : ";\n");
+		} break;
+	case 3: // Intel (Altera) memory initialization (.mif) file
+		sprintf(str, "WIDTH=%d;\nDEPTH=%d;\n\n", ow, tbl_entries);
+		tw_str(tw, str);
+		tw_str(tw, "ADDRESS_RADIX=HEX;\nDATA_RADIX=HEX;\n\n"
+			"CONTENT BEGIN\n");
+		for(int k=0; k<tbl_entries; k++) {
+			tw_byte(tw, '\t');
+			tw_hex(tw, k, na);
+			tw_str(tw, " : ");
+			tw_hex(tw, data[k] & msk, nc);
+			tw_str(tw, ";\n");
+		}
+		tw_str(tw, "END;\n");
+		break;
+	default: // $readmemh() hex file, eight entries per line
+		for(int k=0; k<tbl_entries; k++) {
+			if (0 == (k%8)) {
+				if (k != 0)
+					tw_byte(tw, '\n');
+				tw_byte(tw, '@');
+				tw_hex(tw, k, 8);
+				tw_byte(tw, ' ');
+			}
+			tw_hex(tw, data[k] & msk, nc);
+			tw_byte(tw, ' ');
+		} tw_byte(tw, '\n');
+		break;
+	}
+}
+
 void	hextable(const char *fname, const int lgtable, const int ow,
 		const long *data, const char *extension) {
-	FILE	*hexfp;
+	TBLWRITER	tw;
 	char	*hexfname;
+	int	tbl_entries = (1<<lgtable), slen, format;
+	unsigned	formats;
 
 	if (ow >= 31) {
 		printf("Internal err: output width too large for internal data type");
@@ -58,36 +217,59 @@ void	hextable(const char *fname, const int lgtable, const int ow,
 		assert(lgtable >= 2);
 	}
 
-	// Append .hex to the filename
-	int slen = strlen(fname);
-	hexfname = new char [strlen(fname)+strlen(extension)+3];
-	strcpy(hexfname, fname);
-	if ((slen>4)&&(hexfname[slen-2]=='.'))
-		strcpy(&hexfname[slen-2], extension);
-	else
-		strcat(hexfname, extension);
-
-	// Open our file
-	hexfp = fopen(hexfname, "w");
-	if (NULL == hexfp) {
-		fprintf(stderr, "ERR: Cannot open %s for writing\n",
-			hexfname);
-	} else {
-		// Write the entriess to it.
-		int	tbl_entries = (1<<lgtable), nc = (ow+3)/4;
+	{
+		// Check that every entry fits within the table
 		long	msk = (1l<<ow)-1l;
 
 		for(int k=0; k<tbl_entries; k++) {
-			if (data[k] > 0)
-				assert(data[k] <= msk);
-			else
-				assert(data[k] >= -msk-1);
-			if (0 == (k%8))
-				fprintf(hexfp, "%s@%08x ", (k!=0)?"\n":"", k);
-			fprintf(hexfp, "%0*lx ", nc, data[k] & msk);
-		} fprintf(hexfp, "\n");
+			if ((data[k] > msk)||(data[k] < -msk-1)) {
+				fprintf(stderr, "Internal err: table entry %d, %ld, "
+					"doesn't fit in %d bits\n", k, data[k], ow);
+				assert((data[k] <= msk)&&(data[k] >= -msk-1));
+			}
+		}
+	}
+
+	// Figure out the format from the extension we've been given.  The
+	// table is written in this format, plus any others requested
+	for(format=NFORMATS-1; format>0; format--)
+		if (0 == strcmp(&extension[1], FORMAT_NAMES[format]))
+			break;
+	formats = table_formats | (1u << format);
+
+	tw.buf = new char[TBLWRITER_BUFSZ];
+	slen = strlen(fname);
+	hexfname = new char [slen+strlen(extension)+8];
+	for(int f=0; f<NFORMATS; f++) {
+		if (0 == (formats & (1u << f)))
+			continue;
+
+		// Replace any .v extension on our file name
+		strcpy(hexfname, fname);
+		if ((slen>4)&&(hexfname[slen-2]=='.'))
+			hexfname[slen-2] = '\0';
+		if (f == format)
+			strcat(hexfname, extension);
+		else {
+			strcat(hexfname, ".");
+			strcat(hexfname, FORMAT_NAMES[f]);
+		}
+
+		// Open our file
+		tw.fp = gencache_fopen(hexfname, (f == 1) ? "wb" : "w");
+		if (NULL == tw.fp) {
+			fprintf(stderr, "ERR: Cannot open %s for writing\n",
+				hexfname);
+			continue;
+		}
+
+		// Write the entries to it.
+		tw.len = 0;
+		write_table(&tw, f, lgtable, ow, data);
+		tw_flush(&tw);
+		fclose(tw.fp);
 	}
 
-	fclose(hexfp);
 	delete[] hexfname;
+	delete[] tw.buf;
 }
@@ -4,7 +4,8 @@
 //
 // Project:	A series of CORDIC related projects
 //
-// Purpose:
+// Purpose:	Declares the routines used to write out the tables that
+//		initialize the block RAMs within the table based cores.
 //
 // Creator:	Dan Gisselquist, Ph.D.
 //		Gisselquist Technology, LLC
@@ -42,4 +43,12 @@ extern const char *DEFAULT_EXTENSION; // =".hex";
 void	hextable(const char *fname, const int lgtable, const int ow,
 		const long *data, const char *extension = DEFAULT_EXTENSION);
 
+//
+// hextable_formats
+//
+// Takes a comma separated list of formats, drawn from hex, bin, coe, and
+// mif, that every table should also be written in.  Returns false if any
+// of them isn't recognized.
+bool	hextable_formats(const char *list);
+
 #endif	// HEXTABLE_H
@@ -0,0 +1,643 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename: 	hybridcordic.cpp
+//
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	Generates a polar to rectangular rotation core that combines a
+//		table lookup with a CORDIC.  The top LGTBL bits of the phase
+//	index a small table of sines and cosines, and a complex multiply by the
+//	value found there rotates the input by the center of that phase
+//	segment.  What's left is a phase of no more than half a segment, so
+//	the first (largest) CORDIC stages may be skipped entirely.  Only the
+//	fine stages remain, applied just as basiccordic would apply them.
+//
+//	The table size is chosen to give the lowest latency within a given
+//	budget of table bits.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2018, Gisselquist Technology, LLC
+//
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+//
+// License:	GPL, v3, as defined and found on www.gnu.org,
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+//
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <string.h>
+#include <string>
+#include <ctype.h>
+#include <assert.h>
+
+#include "legal.h"
+#include "cordiclib.h"
+#include "hybridcordic.h"
+#include "hexfile.h"
+#include "swmodel.h"
+
+// The widest table entry the hex file writer can handle
+#define	MAX_TW		30
+// Don't consider tables with more entries than 2^MAX_LGTBL
+#define	MAX_LGTBL	20
+
+int	hybrid_table_width(int ww) {
+	return (ww > MAX_TW) ? MAX_TW : ww;
+}
+
+//
+// hybrid_first
+//
+// Once the table has rotated the input by the center of its segment, the
+// phase left over is within +/- pi/2^lgtbl.  Returns the index of the
+// first CORDIC stage that still needs to be applied, i.e. the largest k
+// such that the CORDIC angles from k on can still sum to this much.
+static	int	hybrid_first(int lgtbl) {
+	double	half = M_PI / (double)(1ul << lgtbl), tail;
+	int	first = 0;
+
+	for(first=0; first<62; first++) {
+		tail = 0.0;
+		for(int k=first+1; k<64; k++)
+			tail += atan2(1., pow(2,k+1));
+		if (tail < half)
+			break;
+	}
+
+	return first;
+}
+
+int	hybrid_lgtbl(int nstages, int ww, int phase_bits, int rom_bits,
+		int *first) {
+	int	tw = hybrid_table_width(ww), best_lg = 2, best_first;
+
+	best_first = hybrid_first(best_lg);
+	if (best_first > nstages-1)
+		best_first = nstages-1;
+	for(int lg=best_lg+1; (lg <= phase_bits-2)&&(lg <= MAX_LGTBL); lg++) {
+		int	f;
+
+		// Each entry holds both a cosine and a sine
+		if ((2l * tw << lg) > (long)rom_bits)
+			break;
+
+		// Every stage we no longer need is one clock less latency.
+		// Keep at least one CORDIC stage, though.
+		f = hybrid_first(lg);
+		if (f > nstages-1)
+			f = nstages-1;
+		if (f > best_first) {
+			best_lg = lg;
+			best_first = f;
+		}
+	}
+
+	if (NULL != first)
+		*first = best_first;
+	return best_lg;
+}
+
+static	double	hybrid_gain(int first, int nstages) {
+	return cordic_gain(first + nstages) / cordic_gain(first);
+}
+
+//
+// hybrid_phase_variance
+//
+// As phase_variance(), but only for the CORDIC stages actually applied.  The
+// table angles are exact, so they add nothing.
+static	double	hybrid_phase_variance(int first, int nstages, int phase_bits) {
+	double	RAD_TO_PHASE = (1ul << (phase_bits-1)) / M_PI;
+	double	variance;
+
+	variance = 1./12.;
+	for(int k=first; k<first+nstages; k++) {
+		double	x, err;
+
+		x = atan2(1., pow(2,k+1)) * RAD_TO_PHASE;
+		err = cordic_angle_value(k, phase_bits) - x;
+		variance += err * err;
+	}
+
+	return variance / pow(RAD_TO_PHASE,2.);
+}
+
+//
+// hybrid_quantization_variance
+//
+// As transform_quantization_variance(), save that the incoming variance
+// also includes the rounding of the complex multiply, and the error in the
+// (quantized) table values multiplied by a full scale input.
+static	double	hybrid_quantization_variance(int first, int nstages,
+		int xtrabits, int dropped_bits, int ww, int tw) {
+	double	current_variance;
+
+	current_variance = pow(2,2*xtrabits)/12. + 1./12.
+			+ pow(2,2*(ww-tw-1))/12.;
+
+	for(int k=first; k<first+nstages; k++)
+		current_variance = (1+pow(4,-k-1))*current_variance + 1./3.;
+
+	if (dropped_bits > 0)
+		current_variance = pow(2,-2*dropped_bits)*current_variance + 1/12.;
+	return current_variance;
+}
+
+//
+// hybrid_angles
+//
+// Writes out the CORDIC angles for the stages following the table, in the
+// same form as cordic_angles(), so that cordic_angle[0] is the angle of
+// the first stage actually applied.
+static	void	hybrid_angles(FILE *fp, int first, int nstages, int phase_bits) {
+	fprintf(fp,
+		"\t//\n"
+		"\t// The angles of the CORDIC stages remaining after the table\n"
+		"\t// lookup.  cordic_angle[i] is atan(2^-(i+FIRST+1)), in units\n"
+		"\t// of our phase variable.\n"
+		"\t//\n"
+		"\twire\t[%d:0]\tcordic_angle [0:(NSTAGES-1)];\n\n",
+		phase_bits-1);
+
+	for(int k=0; k<nstages; k++) {
+		double		deg;
+		unsigned long	phase_value;
+
+		deg = atan2(1., pow(2,k+first+1)) * 180.0 / M_PI;
+		phase_value = cordic_angle_value(k+first, phase_bits);
+
+		if (phase_bits <= 16) {
+			fprintf(fp, "\tassign\tcordic_angle[%2d] = %2d\'h%0*lx; //%11.6f deg\n",
+				k, phase_bits, (phase_bits+3)/4,
+				phase_value, deg);
+		} else {
+			fprintf(fp, "\tassign\tcordic_angle[%2d] "
+				"= %2d\'h%0*lx_%04lx; //%11.6f deg\n",
+				k, phase_bits, (phase_bits-16+3)/4,
+				(phase_value >> 16), (phase_value & 0x0ffff),
+				deg);
+		}
+	}
+
+	fprintf(fp, "\t// Phase Quantization: %.6f (Radians)\n",
+			sqrt(hybrid_phase_variance(first, nstages, phase_bits)));
+	fprintf(fp, "\t// Gain is %.6f\n", hybrid_gain(first, nstages));
+}
+
+void	hybridcordic(FILE *fp, FILE *fhp, const char *fname,
+		int nstages, int iw, int ow, int nxtra,
+		int phase_bits, int rom_bits,
+		bool with_reset, bool with_aux, bool async_reset,
+		FILE *fmp) {
+	int	working_width = iw, tw, lgtbl, first, nfine;
+	const	char *name;
+	char	*noext;
+	long	*ctbl, *stbl;
+	const	char PURPOSE[] =
+	"This file executes a vector rotation on the values\n"
+	"//\t\t(i_xval, i_yval).  This vector is rotated left by\n"
+	"//\ti_phase.  The top LGTBL bits of i_phase look up a coarse rotation\n"
+	"//\tin a table of sines and cosines, applied with a complex multiply,\n"
+	"//\tand the CORDIC then only needs to apply the fine stages.",
+		HPURPOSE[] =
+	"This .h file notes the default parameter values from\n"
+	"//\t\twithin the generated file.  It is used to communicate\n"
+	"//\tinformation about the design to the bench testing code.";
+	legal(fp, fname, PROJECT, PURPOSE);
+	if (nxtra < 1)
+		nxtra = 1;
+	assert(phase_bits >= 4);
+
+	if (working_width < ow)
+		working_width = ow;
+	working_width += nxtra;
+	tw = hybrid_table_width(working_width);
+
+	lgtbl = hybrid_lgtbl(nstages, working_width, phase_bits, rom_bits,
+			&first);
+	nfine = nstages - first;
+	if ((2l * tw << lgtbl) > (long)rom_bits)
+		fprintf(stderr, "WARNING: The smallest table, %ld bits, exceeds "
+			"the table budget of %d bits\n",
+			(2l * tw << lgtbl), rom_bits);
+
+	std::string	resetw = (!with_reset)?""
+			: ((async_reset)?"i_areset_n" : "i_reset");
+	std::string	always_reset = "\talways @(posedge i_clk)\n\t";
+	if ((with_reset)&&(async_reset))
+		always_reset = "\talways @(posedge i_clk, negedge i_areset_n)\n"
+				"\tif (!i_areset_n)\n";
+	else if (with_reset)
+		always_reset = "\talways @(posedge i_clk)\n"
+				"\tif (i_reset)\n";
+
+	name = modulename(fname);
+	noext = strdup(fname);
+	{
+		char *ptr;
+		if (NULL != (ptr = strrchr(noext, '.')))
+			*ptr = '\0';
+	}
+
+	fprintf(fp, "`default_nettype\tnone\n//\n");
+	fprintf(fp,
+		"module	%s(i_clk, %s%si_ce, i_xval, i_yval, i_phase,%s\n"
+		"\t\to_xval, o_yval%s);\n"
+		"\tlocalparam\tIW=%2d,\t// The number of bits in our inputs\n"
+		"\t\t\tOW=%2d,\t// The number of output bits to produce\n"
+		"\t\t\tNSTAGES=%2d,\t// CORDIC stages following the table\n"
+		"\t\t\tFIRST=%2d,\t// Stages replaced by the table\n"
+		"\t\t\tLGTBL=%2d,\t// Log_2 of the number of table entries\n"
+		"\t\t\tTW=%2d,\t// Bits in each table entry\n"
+		"\t\t\tXTRA=%2d,// Extra bits for internal precision\n"
+		"\t\t\tWW=%2d,\t// Our working bit-width\n"
+		"\t\t\tPW=%2d;\t// Bits in our phase variables\n"
+		"\tinput\twire\t\t\t\ti_clk, %s%si_ce;\n"
+		"\tinput\twire\tsigned\t[(IW-1):0]\t\ti_xval, i_yval;\n"
+		"\tinput\twire\t\t[(PW-1):0]\t\t\ti_phase;\n"
+		"\toutput\treg\tsigned\t[(OW-1):0]\to_xval, o_yval;\n",
+		name, resetw.c_str(), (with_reset)?", ":"",
+		(with_aux)?" i_aux,":"", (with_aux)?", o_aux":"",
+		iw, ow, nfine, first, lgtbl, tw,
+		nxtra, working_width, phase_bits,
+		resetw.c_str(), (with_reset)?", ":"");
+
+	if (with_aux) {
+		fprintf(fp,
+			"\tinput\twire\t\t\t\ti_aux;\n"
+			"\toutput\treg\t\t\t\to_aux;\n");
+	}
+
+	fprintf(fp,
+		"\t// First step: expand our input to our working width.\n"
+		"\t// This is going to involve extending our input by one\n"
+		"\t// (or more) bits in addition to adding any xtra bits on\n"
+		"\t// bits on the right.  The one bit extra on the left is to\n"
+		"\t// allow for any accumulation due to the cordic gain\n"
+		"\t// within the algorithm.\n"
+		"\t// \n"
+		"\twire\tsigned [(WW-1):0]\te_xval, e_yval;\n");
+
+	if (working_width-iw-1 > 0) {
+		fprintf(fp,
+			"\tassign\te_xval = { {i_xval[(IW-1)]}, i_xval, {(WW-IW-1){1'b0}} };\n"
+			"\tassign\te_yval = { {i_yval[(IW-1)]}, i_yval, {(WW-IW-1){1'b0}} };\n\n");
+	} else {
+		fprintf(fp,
+			"\tassign\te_xval = { {i_xval[(IW-1)]}, i_xval };\n"
+			"\tassign\te_yval = { {i_yval[(IW-1)]}, i_yval };\n\n");
+	}
+
+	fprintf(fp,
+		"\t// Declare variables for all of the separate stages\n"
+		"\treg	signed	[(WW-1):0]	xv	[0:(NSTAGES)];\n"
+		"\treg	signed	[(WW-1):0]	yv	[0:(NSTAGES)];\n"
+		"\treg		[(PW-1):0]	ph	[0:(NSTAGES)];\n\n");
+
+	if (with_aux) {
+		fprintf(fp,
+"\t//\n"
+"\t// Handle the auxilliary logic.\n"
+"\t//\n"
+"\t// The auxilliary bit is designed so that you can place a valid bit into\n"
+"\t// the CORDIC function, and see when it comes out.  While the bit is\n"
+"\t// allowed to be anything, the requirement of this bit is that it *must*\n"
+"\t// be aligned with the output when done.  That is, if i_xval and i_yval\n"
+"\t// are input together with i_aux, then when o_xval and o_yval are set\n"
+"\t// to this value, o_aux *must* contain the value that was in i_aux.\n"
+"\t//\n"
+"\treg\t\t[(NSTAGES+2):0]\tax;\n"
+"\n");
+
+		fprintf(fp, "%s", always_reset.c_str());
+
+		if (with_reset)
+			fprintf(fp,
+				"\t\tax <= {(NSTAGES+3){1'b0}};\n\telse ");
+		fprintf(fp, "if (i_ce)\n"
+			"\t\tax <= { ax[(NSTAGES+1):0], i_aux };\n"
+			"\n");
+	}
+
+	fprintf(fp,
+		"\t//\n"
+		"\t// The coarse rotation.  Entry k of the table holds the\n"
+		"\t// cosine and sine of (k+1/2)*2pi/2^LGTBL, scaled by 2^(TW-1).\n"
+		"\t//\n"
+		"\treg\t[(TW-1):0]\tctbl [0:((1<<LGTBL)-1)];\n"
+		"\treg\t[(TW-1):0]\tstbl [0:((1<<LGTBL)-1)];\n\n"
+		"\tinitial begin\n"
+		"\t\t$readmemh(\"%s_ctbl.hex\", ctbl);\n"
+		"\t\t$readmemh(\"%s_stbl.hex\", stbl);\n"
+		"\tend\n\n", name, name);
+
+	fprintf(fp,
+		"\treg\tsigned\t[(TW-1):0]\tcv, sv;\n"
+		"\treg\tsigned\t[(WW-1):0]\ttx, ty;\n"
+		"\treg\t\t[(PW-1):0]\ttph, mph;\n"
+		"\treg\tsigned\t[(WW+TW-1):0]\tpxc, pys, pxs, pyc;\n\n");
+
+	fprintf(fp,
+		"\t// Clock one: Look up the coarse rotation.  What remains of the\n"
+		"\t// phase is its (signed) offset from the center of the table\n"
+		"\t// entry\'s segment.\n");
+	fprintf(fp, "%s", always_reset.c_str());
+	if (with_reset)
+		fprintf(fp,
+			"\tbegin\n"
+			"\t\tcv  <= 0;\n"
+			"\t\tsv  <= 0;\n"
+			"\t\ttx  <= 0;\n"
+			"\t\tty  <= 0;\n"
+			"\t\ttph <= 0;\n"
+			"\tend else ");
+	fprintf(fp, "if (i_ce)\n"
+		"\tbegin\n"
+		"\t\tcv  <= ctbl[i_phase[(PW-1):(PW-LGTBL)]];\n"
+		"\t\tsv  <= stbl[i_phase[(PW-1):(PW-LGTBL)]];\n"
+		"\t\ttx  <= e_xval;\n"
+		"\t\tty  <= e_yval;\n"
+		"\t\ttph <= { {(LGTBL+1){!i_phase[(PW-LGTBL-1)]}},\n"
+		"\t\t\t\ti_phase[(PW-LGTBL-2):0] };\n"
+		"\tend\n\n");
+
+	fprintf(fp,
+		"\t// Clock two: The four products of the complex multiply\n");
+	fprintf(fp, "%s", always_reset.c_str());
+	if (with_reset)
+		fprintf(fp,
+			"\tbegin\n"
+			"\t\tpxc <= 0;\n"
+			"\t\tpys <= 0;\n"
+			"\t\tpxs <= 0;\n"
+			"\t\tpyc <= 0;\n"
+			"\t\tmph <= 0;\n"
+			"\tend else ");
+	fprintf(fp, "if (i_ce)\n"
+		"\tbegin\n"
+		"\t\tpxc <= tx * cv;\n"
+		"\t\tpys <= ty * sv;\n"
+		"\t\tpxs <= tx * sv;\n"
+		"\t\tpyc <= ty * cv;\n"
+		"\t\tmph <= tph;\n"
+		"\tend\n\n");
+
+	fprintf(fp,
+		"\t// Clock three: Add the products together, and round them\n"
+		"\t// back down to our working width\n"
+		"\twire\tsigned\t[(WW+TW):0]\trx, ry;\n\n"
+		"\tassign\trx = pxc - pys\n"
+		"\t\t\t+ $signed({ {(WW+2){1\'b0}}, 1\'b1, {(TW-2){1\'b0}} });\n"
+		"\tassign\try = pxs + pyc\n"
+		"\t\t\t+ $signed({ {(WW+2){1\'b0}}, 1\'b1, {(TW-2){1\'b0}} });\n\n");
+	fprintf(fp, "%s", always_reset.c_str());
+	if (with_reset)
+		fprintf(fp,
+			"\tbegin\n"
+			"\t\txv[0] <= 0;\n"
+			"\t\tyv[0] <= 0;\n"
+			"\t\tph[0] <= 0;\n"
+			"\tend else ");
+	fprintf(fp, "if (i_ce)\n"
+		"\tbegin\n"
+		"\t\txv[0] <= rx[(WW+TW-2):(TW-1)];\n"
+		"\t\tyv[0] <= ry[(WW+TW-2):(TW-1)];\n"
+		"\t\tph[0] <= mph;\n"
+		"\tend\n\n");
+
+	fprintf(fp, "\t// Make Verilator happy with the bits of r.\n"
+		"\t// verilator lint_off UNUSED\n"
+		"\twire\t[(2*TW+1):0] unused_rv;\n"
+		"\tassign\tunused_rv = {\n"
+		"\t\trx[(WW+TW):(WW+TW-1)], rx[(TW-2):0],\n"
+		"\t\try[(WW+TW):(WW+TW-1)], ry[(TW-2):0]\n"
+		"\t\t};\n"
+		"\t// verilator lint_on UNUSED\n\n");
+
+	hybrid_angles(fp, first, nfine, phase_bits);
+
+	fprintf(fp,"\n"
+		"\tgenvar	i;\n"
+		"\tgenerate for(i=0; i<NSTAGES; i=i+1) begin : CORDICops\n");
+	fprintf(fp,
+		"\t\t// The CORDIC stages that the table couldn\'t replace.\n"
+		"\t\t// Stage i here is stage i+FIRST of a full CORDIC.\n");
+	fprintf(fp, "%s", always_reset.c_str());
+	if (with_reset) {
+		fprintf(fp,
+			"\t\tbegin\n"
+			"\t\t\txv[i+1] <= 0;\n"
+			"\t\t\tyv[i+1] <= 0;\n"
+			"\t\t\tph[i+1] <= 0;\n"
+			"\t\tend else ");
+	} else
+		fprintf(fp, "\t\t");
+
+	fprintf(fp,
+		"if (i_ce)\n"
+		"\t\tbegin\n"
+		"\t\t\tif ((cordic_angle[i] == 0)||(i+FIRST >= WW))\n"
+		"\t\t\tbegin // Do nothing but move our outputs\n"
+		"\t\t\t// forward one stage, since we have more\n"
+		"\t\t\t// stages than valid data\n"
+		"\t\t\t\txv[i+1] <= xv[i];\n"
+		"\t\t\t\tyv[i+1] <= yv[i];\n"
+		"\t\t\t\tph[i+1] <= ph[i];\n"
+		"\t\t\tend else if (ph[i][(PW-1)]) // Negative phase\n"
+		"\t\t\tbegin\n"
+		"\t\t\t\t// If the phase is negative, rotate by the\n"
+		"\t\t\t\t// CORDIC angle in a clockwise direction.\n"
+		"\t\t\t\txv[i+1] <= xv[i] + (yv[i]>>>(i+FIRST+1));\n"
+		"\t\t\t\tyv[i+1] <= yv[i] - (xv[i]>>>(i+FIRST+1));\n"
+		"\t\t\t\tph[i+1] <= ph[i] + cordic_angle[i];\n"
+		"\t\t\tend else begin\n"
+		"\t\t\t\t// On the other hand, if the phase is\n"
+		"\t\t\t\t// positive ... rotate in the\n"
+		"\t\t\t\t// counter-clockwise direction\n"
+		"\t\t\t\txv[i+1] <= xv[i] - (yv[i]>>>(i+FIRST+1));\n"
+		"\t\t\t\tyv[i+1] <= yv[i] + (xv[i]>>>(i+FIRST+1));\n"
+		"\t\t\t\tph[i+1] <= ph[i] - cordic_angle[i];\n"
+		"\t\t\tend\n"
+		"\t\tend\n"
+		"\tend endgenerate\n\n");
+
+	if (working_width > ow+1) {
+		fprintf(fp,
+			"\t// Round our result towards even\n"
+			"\twire\t[(WW-1):0]\tpre_xval, pre_yval;\n\n"
+			"\tassign\tpre_xval = xv[NSTAGES] + $signed({{(OW){1\'b0}},\n"
+				"\t\t\t\txv[NSTAGES][(WW-OW)],\n"
+				"\t\t\t\t{(WW-OW-1){!xv[NSTAGES][WW-OW]}}});\n"
+			"\tassign\tpre_yval = yv[NSTAGES] + $signed({{(OW){1\'b0}},\n"
+				"\t\t\t\tyv[NSTAGES][(WW-OW)],\n"
+				"\t\t\t\t{(WW-OW-1){!yv[NSTAGES][WW-OW]}}});\n"
+			"\n");
+		fprintf(fp, "%s", always_reset.c_str());
+
+		if (with_reset)
+			fprintf(fp, "\tbegin\n"
+			"\t\to_xval <= 0;\n"
+			"\t\to_yval <= 0;\n"
+			"\tend else ");
+
+		fprintf(fp,
+			"if (i_ce)\n"
+			"\tbegin\n"
+			"\t\to_xval <= pre_xval[(WW-1):(WW-OW)];\n"
+			"\t\to_yval <= pre_yval[(WW-1):(WW-OW)];\n");
+		if (with_aux)
+			fprintf(fp,
+			"\t\to_aux <= ax[NSTAGES+2];\n");
+		fprintf(fp, "\tend\n\n");
+
+		fprintf(fp, "\t// Make Verilator happy with pre_.val\n"
+			"\t// verilator lint_off UNUSED\n"
+			"\twire	[(2*(WW-OW)-1):0] unused_val;\n"
+			"\tassign\tunused_val = {\n"
+			"\t\tpre_xval[(WW-OW-1):0],\n"
+			"\t\tpre_yval[(WW-OW-1):0]\n"
+			"\t\t};\n"
+			"\t// verilator lint_on UNUSED\n");
+	} else {
+
+		fprintf(fp, "%s", always_reset.c_str());
+
+		if (with_reset)
+			fprintf(fp,
+			"\tbegin\n"
+			"\t\to_xval <= 0;\n"
+			"\t\to_yval <= 0;\n"
+			"\tend else ");
+
+		fprintf(fp,
+			"if (i_ce)\n"
+			"\tbegin\t// We accumulate a bit during our processing, so shift by one\n"
+			"\t\to_xval <= xv[NSTAGES][(WW-1):(WW-OW)];\n"
+			"\t\to_yval <= yv[NSTAGES][(WW-1):(WW-OW)];\n");
+		if (with_aux)
+			fprintf(fp, "\t\to_aux  <= ax[NSTAGES+2];\n");
+		fprintf(fp, "\tend\n\n");
+	}
+
+	fprintf(fp, "endmodule\n");
+
+	//
+	// Build the tables.  Since the angles are centered within each
+	// segment, no entry ever reaches +/- 1.0, save for rounding in
+	// the very largest tables.
+	//
+	{
+		long	maxv = (1l<<(tw-1))-1l;
+		double	scale = (double)(1l<<(tw-1));
+		std::string	tname;
+
+		ctbl = new long[(1<<lgtbl)];
+		stbl = new long[(1<<lgtbl)];
+		for(int k=0; k<(1<<lgtbl); k++) {
+			double	a = (k + 0.5) * 2.0 * M_PI / (double)(1<<lgtbl);
+
+			ctbl[k] = (long)floor(scale * cos(a) + 0.5);
+			stbl[k] = (long)floor(scale * sin(a) + 0.5);
+			if (ctbl[k] >  maxv) ctbl[k] =  maxv;
+			if (ctbl[k] < -maxv) ctbl[k] = -maxv;
+			if (stbl[k] >  maxv) stbl[k] =  maxv;
+			if (stbl[k] < -maxv) stbl[k] = -maxv;
+		}
+
+		tname = std::string(noext) + std::string("_ctbl");
+		hextable(tname.c_str(), lgtbl, tw, ctbl);
+		tname = std::string(noext) + std::string("_stbl");
+		hextable(tname.c_str(), lgtbl, tw, stbl);
+	}
+
+	if (NULL != fhp) {
+		char	*str = new char[strlen(name)+4], *ptr;
+		sprintf(str, "%s.h", name);
+		legal(fhp, str, PROJECT, HPURPOSE);
+		ptr = str;
+		while(*ptr) {
+			if ('.' == *ptr)
+				*ptr = '_';
+			else	*ptr = toupper(*ptr);
+			ptr++;
+		}
+		fprintf(fhp, "#ifndef	%s\n", str);
+		fprintf(fhp, "#define	%s\n", str);
+
+		double	qvar = hybrid_quantization_variance(first, nfine,
+				working_width-iw, working_width-ow,
+				working_width, tw),
+			pvar = hybrid_phase_variance(first, nfine, phase_bits),
+			gain = hybrid_gain(first, nfine);
+
+		if (async_reset)
+			fprintf(fhp, "#define\tASYNC_RESET\n");
+		fprintf(fhp, "const int	IW = %d;\n", iw);
+		fprintf(fhp, "const int	OW = %d;\n", ow);
+		fprintf(fhp, "const int	NEXTRA = %d;\n", nxtra);
+		fprintf(fhp, "const int	WW = %d;\n", working_width);
+		fprintf(fhp, "const int	PW = %d;\n", phase_bits);
+		fprintf(fhp, "const int	NSTAGES = %d;\n", nfine);
+		fprintf(fhp, "const int	FIRST = %d;\n", first);
+		fprintf(fhp, "const int	LGTBL = %d;\n", lgtbl);
+		fprintf(fhp, "const int	TW = %d;\n", tw);
+		fprintf(fhp, "const double	QUANTIZATION_VARIANCE = %.4e; // (Units^2)\n",
+			qvar);
+		fprintf(fhp, "const double	PHASE_VARIANCE_RAD = %.4e; // (Radians^2)\n",
+			pvar);
+		fprintf(fhp, "const double	GAIN = %.16f;\n", gain);
+		{
+			double	amplitude = (1ul<<(iw-1))-1.,
+				signal_energy, noise_energy;
+			amplitude *= (1ul<<((working_width-iw)));
+			amplitude *= gain;
+			amplitude *= pow(2.0,-(working_width-ow));
+			signal_energy = amplitude * amplitude;
+
+			noise_energy = qvar + signal_energy * pvar
+				* pow(2,gain);
+
+			fprintf(fhp, "const double\tBEST_POSSIBLE_CNR = %.2f;\n",
+				10.0 * log(signal_energy / noise_energy)
+					/log(10.0));
+		}
+		fprintf(fhp, "const bool\tHAS_RESET = %s;\n", with_reset?"true":"false");
+		fprintf(fhp, "const bool\tHAS_AUX   = %s;\n", with_aux?"true":"false");
+		if (with_reset)
+			fprintf(fhp, "#define\tHAS_RESET_WIRE\n");
+		if (with_aux)
+			fprintf(fhp, "#define\tHAS_AUX_WIRES\n");
+		fprintf(fhp, "#endif\t// %s\n", str);
+		delete[] str;
+	}
+
+	if (NULL != fmp)
+		hybridcordic_model(fmp, name, first, nfine, iw, ow, nxtra,
+			working_width, phase_bits, lgtbl, tw, ctbl, stbl);
+
+	delete[] ctbl;
+	delete[] stbl;
+	free(noext);
+}
@@ -0,0 +1,72 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename: 	hybridcordic.h
+//
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	Defines the interface to the hybrid table plus CORDIC rotation
+//		core.  The top bits of the phase index a small sine/cosine
+//	table, used to rotate the input by a coarse angle with a complex
+//	multiply, leaving only the fine stages for the CORDIC to apply.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2018, Gisselquist Technology, LLC
+//
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+//
+// License:	GPL, v3, as defined and found on www.gnu.org,
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+//
+#ifndef	HYBRIDCORDIC_H
+#define	HYBRIDCORDIC_H
+
+#include <stdio.h>
+
+// The default table budget, in bits: one 36Kb block RAM
+#define	DEF_ROMBITS	36864
+
+//
+// hybrid_table_width
+//
+// Returns the number of bits in each sine and cosine table entry of a core
+// with a working width of ww bits.
+extern	int	hybrid_table_width(int ww);
+
+//
+// hybrid_lgtbl
+//
+// Returns the log (base two) of the number of table entries giving the
+// lowest latency core whose tables fit within rom_bits, using the fewest
+// table entries to get there.  If first is given, it is set to the index of
+// the first CORDIC stage the core will still need to apply.
+extern	int	hybrid_lgtbl(int nstages, int ww, int phase_bits, int rom_bits,
+			int *first = NULL);
+
+void	hybridcordic(FILE *fp, FILE *fhp, const char *fname,
+		int nstages, int iw, int ow, int nxtra,
+		int phase_bits=32, int rom_bits = DEF_ROMBITS,
+		bool with_reset=true, bool with_aux = true,
+		bool async_reset=false, FILE *fmp = NULL);
+
+#endif	// HYBRIDCORDIC_H
@@ -0,0 +1,467 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename: 	iterpolar.cpp
+//
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	Generates a rectangular to polar CORDIC that sits between the
+//		sequential and the pipelined conversions.  Each clock applies
+//	several CORDIC stages (iterations) at once, one feeding the next, so
+//	a conversion takes NSTAGES/ITERS clocks (rounded up) rather than
+//	NSTAGES.  The results are identical to those of topolar, having the
+//	same parameters.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2018, Gisselquist Technology, LLC
+//
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+//
+// License:	GPL, v3, as defined and found on www.gnu.org,
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+//
+#include <stdio.h>
+#include <math.h>
+#include <string.h>
+#include <string>
+#include <ctype.h>
+#include <assert.h>
+
+#include "legal.h"
+#include "cordiclib.h"
+#include "iterpolar.h"
+#include "swmodel.h"
+
+void	iterpolar(FILE *fp, FILE *fhp, const char *fname,
+		int nstages, int iw, int ow, int nxtra,
+		int phase_bits, int iters,
+		bool with_reset, bool with_aux, bool async_reset,
+		FILE *fmp) {
+	int	working_width = iw, npass, lgstage, lgidx;
+	const	char *name;
+	char	idx[64];
+	const	char PURPOSE[] =
+	"This is a rectangular to polar conversion routine based upon an\n"
+	"//\t\tinternal CORDIC implementation.  Basically, the input is\n"
+	"//\tprovided in i_xval and i_yval.  The internal CORDIC rotator will rotate\n"
+	"//\t(i_xval, i_yval) until i_yval is approximately zero.  The resulting\n"
+	"//\txvalue and phase will be placed into o_mag and o_phase respectively.\n//\n"
+	"//\tThis particular version of the CORDIC processes one value at a\n"
+	"//\ttime, applying ITERS CORDIC stages on every clock.  It therefore\n"
+	"//\ttakes NPASS clocks to convert each value, where NPASS is NSTAGES\n"
+	"//\tdivided by ITERS and rounded up, and then one more to round the\n"
+	"//\tresult.",
+		HPURPOSE[] =
+	"This .h file notes the default parameter values from\n"
+	"//\t\twithin the generated iterpolar file.  It is used to communicate\n"
+	"//\tinformation about the design to the bench testing code.";
+	legal(fp, fname, PROJECT, PURPOSE);
+	if (nxtra < 2)
+		nxtra = 2;
+	// gencordic_build() turns away any -k core it can't build
+	assert(phase_bits >= 3);
+	assert(nstages >= 2);
+
+	if (working_width < ow)
+		working_width = ow;
+	working_width += nxtra;
+	working_width += nxtra;
+
+	if (iters < 1)
+		iters = 1;
+	else if (iters > nstages)
+		iters = nstages;
+	npass = (nstages + iters - 1) / iters;
+
+	// Bits required to count through every stage of every pass, and to
+	// index the table of CORDIC angles
+	lgstage = nextlg((unsigned)(npass * iters));
+	lgidx   = nextlg((unsigned)nstages);
+	if (lgstage < 1)
+		lgstage = 1;
+
+	std::string	resetw = (!with_reset)?""
+			: ((async_reset)?"i_areset_n" : "i_reset");
+	std::string	always_reset = "\talways @(posedge i_clk)\n\t";
+	if ((with_reset)&&(async_reset))
+		always_reset = "\talways @(posedge i_clk, negedge i_areset_n)\n"
+				"\tif (!i_areset_n)\n";
+	else if (with_reset)
+		always_reset = "\talways @(posedge i_clk)\n"
+				"\tif (i_reset)\n";
+
+	name = modulename(fname);
+
+	fprintf(fp, "`default_nettype\tnone\n//\n");
+	fprintf(fp,
+		"module	%s(i_clk, %s%si_stb, i_xval, i_yval,%s\n"
+		"\t\to_busy, o_done, o_mag, o_phase%s);\n"
+		"\tlocalparam\tIW=%2d,\t// The number of bits in our inputs\n"
+		"\t\t\tOW=%2d,\t// The number of output bits to produce\n"
+		"\t\t\tNSTAGES=%2d,\n"
+		"\t\t\tXTRA=%2d,// Extra bits for internal precision\n"
+		"\t\t\tWW=%2d,\t// Our working bit-width\n"
+		"\t\t\tPW=%2d,\t// Bits in our phase variables\n"
+		"\t\t\tITERS=%2d,// CORDIC stages applied per clock\n"
+		"\t\t\tNPASS=%2d;// Clocks required to apply them all\n"
+		"\tinput\twire\t\t\t\ti_clk, %s%si_stb;\n"
+		"\tinput\twire\tsigned\t[(IW-1):0]\ti_xval, i_yval;\n"
+		"\toutput\twire\t\t\t\to_busy;\n"
+		"\toutput\treg\t\t\t\to_done;\n"
+		"\toutput\treg\tsigned\t[(OW-1):0]\to_mag;\n"
+		"\toutput\treg\t\t[(PW-1):0]\to_phase;\n",
+		name, resetw.c_str(), (with_reset)?", ":"",
+		(with_aux)?" i_aux,":"", (with_aux)?", o_aux":"",
+		iw, ow, nstages, nxtra, working_width, phase_bits,
+		iters, npass,
+		resetw.c_str(), (with_reset)?", ":"");
+
+	if (with_aux) {
+		fprintf(fp,
+			"\tinput\twire\t\t\t\ti_aux;\n"
+			"\toutput\treg\t\t\t\to_aux;\n");
+	}
+
+	fprintf(fp,
+		"\t// First step: expand our input to our working width.\n"
+		"\t// This is going to involve extending our input by one\n"
+		"\t// (or more) bits in addition to adding any xtra bits on\n"
+		"\t// bits on the right.  The one bit extra on the left is to\n"
+		"\t// allow for any accumulation due to the cordic gain\n"
+		"\t// within the algorithm.\n"
+		"\t// \n"
+		"\twire\tsigned [(WW-1):0]\te_xval, e_yval;\n");
+
+	if (working_width-iw > 2) {
+		fprintf(fp,
+			"\tassign\te_xval = { {(2){i_xval[(IW-1)]}}, i_xval, {(WW-IW-2){1'b0}} };\n"
+			"\tassign\te_yval = { {(2){i_yval[(IW-1)]}}, i_yval, {(WW-IW-2){1'b0}} };\n\n");
+	} else if (working_width-iw > 1) {
+		fprintf(fp,
+			"\tassign\te_xval = { {(2){i_xval[(IW-1)]}}, i_xval };\n"
+			"\tassign\te_yval = { {(2){i_yval[(IW-1)]}}, i_yval };\n\n");
+	} else {
+		fprintf(fp,
+			"\tassign\te_xval = { {(2){i_xval[(IW-1)]}, i_xval[(IW-1):1] };\n"
+			"\tassign\te_yval = { {(2){i_yval[(IW-1)]}, i_yval[(IW-1):1] };\n\n");
+	}
+
+	fprintf(fp,
+		"\t// Declare variables for all of the separate stages\n");
+
+	fprintf(fp,
+		"\treg	signed	[(WW-1):0]	xv, yv;\n"
+		"\treg		[(PW-1):0]	ph;\n"
+		"\treg\t\t\t\tidle, last;\n");
+	if (npass > 1)
+		fprintf(fp, "\treg\t\t[%d:0]\t\tstage;\n", lgstage-1);
+	fprintf(fp, "\twire\t\t\t\tlast_pass;\n\n");
+
+	if (with_aux) {
+		fprintf(fp,
+"\t//\n"
+"\t// Handle the auxilliary logic.\n"
+"\t//\n"
+"\t// The auxilliary bit is designed so that you can place a valid bit into\n"
+"\t// the CORDIC function, and see when it comes out.  While the bit is\n"
+"\t// allowed to be anything, the requirement of this bit is that it *must*\n"
+"\t// be aligned with the output when done.  That is, if i_xval and i_yval\n"
+"\t// are input together with i_aux, then when o_xval and o_yval are set\n"
+"\t// to this value, o_aux *must* contain the value that was in i_aux.\n"
+"\t//\n"
+"\treg\t\taux;\n"
+"\n");
+
+		fprintf(fp, "%s", always_reset.c_str());
+
+		if (with_reset)
+			fprintf(fp,
+				"\t\taux <= 0;\n\telse ");
+		fprintf(fp, "if ((i_stb)&&(!o_busy))\n"
+			"\t\taux <= i_aux;\n"
+			"\n");
+	}
+
+	//
+	// The control logic.  idle is cleared when a value is accepted, and
+	// set again once the last pass has been made.  last is then true for
+	// the one clock it takes to round the result.
+	//
+	if (npass > 1)
+		fprintf(fp, "\tassign\tlast_pass = (!idle)&&(stage == %d\'d%d);\n\n",
+			lgstage, (npass-1)*iters);
+	else
+		fprintf(fp, "\tassign\tlast_pass = !idle;\n\n");
+
+	fprintf(fp, "\tinitial\tidle = 1\'b1;\n");
+	fprintf(fp, "%s", always_reset.c_str());
+	if (with_reset)
+		fprintf(fp, "\t\tidle <= 1\'b1;\n\telse ");
+	fprintf(fp, "if ((i_stb)&&(!o_busy))\n"
+			"\t\tidle <= 1\'b0;\n"
+			"\telse if (last_pass)\n"
+			"\t\tidle <= 1\'b1;\n\n");
+
+	fprintf(fp, "\tinitial\tlast = 1\'b0;\n");
+	fprintf(fp, "%s", always_reset.c_str());
+	if (with_reset)
+		fprintf(fp, "\t\tlast <= 1\'b0;\n\telse\n\t");
+	fprintf(fp, "\tlast <= last_pass;\n\n");
+
+	if (npass > 1) {
+		fprintf(fp, "\t// The first of the ITERS stages applied on this clock\n");
+		fprintf(fp, "\tinitial\tstage = 0;\n");
+		fprintf(fp, "%s", always_reset.c_str());
+		if (with_reset)
+			fprintf(fp, "\t\tstage <= 0;\n\telse ");
+		fprintf(fp, "if ((idle)||(last_pass))\n"
+			"\t\tstage <= 0;\n"
+			"\telse\n"
+			"\t\tstage <= stage + %d\'d%d;\n\n",
+			lgstage, iters);
+	}
+
+	cordic_angles(fp, nstages, phase_bits);
+
+	fprintf(fp, "\n"
+		"\t// Here\'s where we are going to put the actual CORDIC\n"
+		"\t// we\'ve been studying and discussing.  Each clock, the\n"
+		"\t// vector in xv, yv, and ph works its way through ITERS\n"
+		"\t// CORDIC stages, one feeding the next, before being\n"
+		"\t// registered again.\n"
+		"\twire	signed	[(WW-1):0]	ix	[0:ITERS];\n"
+		"\twire	signed	[(WW-1):0]	iy	[0:ITERS];\n"
+		"\twire		[(PW-1):0]	iph	[0:ITERS];\n"
+		"\twire		[%d:0]		istage	[0:(ITERS-1)];\n"
+		"\twire		[(PW-1):0]	iangle	[0:(ITERS-1)];\n\n"
+		"\tassign\tix[0]  = xv;\n"
+		"\tassign\tiy[0]  = yv;\n"
+		"\tassign\tiph[0] = ph;\n\n", lgstage-1);
+
+	for(int j=0; j<iters; j++) {
+		if (lgstage > lgidx)
+			sprintf(idx, "istage[%d][%d:0]", j, lgidx-1);
+		else
+			sprintf(idx, "istage[%d]", j);
+
+		fprintf(fp, "\t// Iteration %d\n", j);
+		if (npass > 1)
+			fprintf(fp, "\tassign\tistage[%d] = stage + %d\'d%d;\n",
+				j, lgstage, j);
+		else
+			fprintf(fp, "\tassign\tistage[%d] = %d\'d%d;\n",
+				j, lgstage, j);
+
+		// Stages beyond the last one, as when ITERS doesn't divide
+		// NSTAGES, have no angle and so do nothing
+		if (npass * iters > nstages)
+			fprintf(fp, "\tassign\tiangle[%d] = (istage[%d] < %d\'d%d)\n"
+				"\t\t\t? cordic_angle[%s] : {(PW){1\'b0}};\n",
+				j, j, lgstage, nstages, idx);
+		else
+			fprintf(fp, "\tassign\tiangle[%d] = cordic_angle[%s];\n",
+				j, idx);
+
+		fprintf(fp, "\n\twire\tthru_%d;\n", j);
+		if (working_width < nstages)
+			fprintf(fp, "\tassign\tthru_%d = (iangle[%d] == 0)"
+				"||(istage[%d] >= %d\'d%d);\n",
+				j, j, j, lgstage, working_width);
+		else
+			fprintf(fp, "\tassign\tthru_%d = (iangle[%d] == 0);\n",
+				j, j);
+
+		fprintf(fp,
+		"\t// If the vector is below the x-axis, rotate by the CORDIC\n"
+		"\t// angle in a positive direction, otherwise the other way\n"
+		"\tassign\tix[%d] = (thru_%d) ? ix[%d]\n"
+		"\t\t: (iy[%d][WW-1]) ? (ix[%d] - (iy[%d] >>> (istage[%d]+1)))\n"
+		"\t\t: (ix[%d] + (iy[%d] >>> (istage[%d]+1)));\n"
+		"\tassign\tiy[%d] = (thru_%d) ? iy[%d]\n"
+		"\t\t: (iy[%d][WW-1]) ? (iy[%d] + (ix[%d] >>> (istage[%d]+1)))\n"
+		"\t\t: (iy[%d] - (ix[%d] >>> (istage[%d]+1)));\n"
+		"\tassign\tiph[%d] = (thru_%d) ? iph[%d]\n"
+		"\t\t: (iy[%d][WW-1]) ? (iph[%d] - iangle[%d])\n"
+		"\t\t: (iph[%d] + iangle[%d]);\n\n",
+			j+1, j, j, j, j, j, j, j, j, j,
+			j+1, j, j, j, j, j, j, j, j, j,
+			j+1, j, j, j, j, j, j, j);
+	}
+
+	fprintf(fp,
+		"\t// Accept a new value, mapping it to within +/- 45 degrees\n"
+		"\t// as we do so, or otherwise apply the next ITERS stages.\n");
+
+	fprintf(fp, "\talways @(posedge i_clk)\n"
+		"\tif ((i_stb)&&(!o_busy))\n"
+		"\tbegin\n"
+		"\t\tcase({i_xval[IW-1], i_yval[IW-1]})\n");
+
+	fprintf(fp,
+		"\t\t2\'b01: begin // Rotate by -315 degrees\n"
+		"\t\t\txv <=  e_xval - e_yval;\n"
+		"\t\t\tyv <=  e_xval + e_yval;\n"
+		"\t\t\tph <= %d\'h%lx;\n"
+		"\t\t\tend\n",
+			phase_bits, (7ul << (phase_bits-3)));
+	fprintf(fp,
+		"\t\t2\'b10: begin // Rotate by -135 degrees\n"
+		"\t\t\txv <= -e_xval + e_yval;\n"
+		"\t\t\tyv <= -e_xval - e_yval;\n"
+		"\t\t\tph <= %d\'h%lx;\n"
+		"\t\t\tend\n",
+			phase_bits, (3ul << (phase_bits-3)));
+
+	fprintf(fp,
+		"\t\t2\'b11: begin // Rotate by -225 degrees\n"
+		"\t\t\txv <= -e_xval - e_yval;\n"
+		"\t\t\tyv <=  e_xval - e_yval;\n"
+		"\t\t\tph <= %d\'h%lx;\n"
+		"\t\t\tend\n",
+			phase_bits, (5ul << (phase_bits-3)));
+
+	fprintf(fp,
+		"\t\t// 2\'b00:\n"
+		"\t\tdefault: begin // Rotate by -45 degrees\n"
+		"\t\t\txv <=  e_xval + e_yval;\n"
+		"\t\t\tyv <= -e_xval + e_yval;\n"
+		"\t\t\tph <= %d\'h%lx;\n"
+		"\t\t\tend\n",
+			phase_bits, (1ul << (phase_bits-3)));
+
+	fprintf(fp,
+		"\t\tendcase\n"
+		"\tend else if (!idle)\n"
+		"\tbegin\n"
+		"\t\txv <= ix[ITERS];\n"
+		"\t\tyv <= iy[ITERS];\n"
+		"\t\tph <= iph[ITERS];\n"
+		"\tend\n\n");
+
+	if (working_width > ow+1) {
+		fprintf(fp,
+			"\t// Round our magnitude towards even\n"
+			"\twire\t[(WW-1):0]\tfinal_mag;\n\n"
+			"\tassign\tfinal_mag = xv + $signed({{(OW){1\'b0}},\n"
+				"\t\t\t\txv[(WW-OW)],\n"
+				"\t\t\t\t{(WW-OW-1){!xv[WW-OW]}}});\n"
+			"\n");
+	}
+
+	fprintf(fp, "\tinitial\to_done = 1\'b0;\n");
+	fprintf(fp, "%s", always_reset.c_str());
+	if (with_reset)
+		fprintf(fp, "\t\to_done <= 1\'b0;\n\telse\n\t");
+	fprintf(fp, "\to_done <= last;\n\n");
+
+	fprintf(fp, "%s", always_reset.c_str());
+	if (with_reset) {
+		fprintf(fp,
+			"\tbegin\n"
+			"\t\to_mag   <= 0;\n"
+			"\t\to_phase <= 0;\n");
+		if (with_aux)
+			fprintf(fp, "\t\to_aux  <= 0;\n");
+		fprintf(fp, "\tend else ");
+	}
+
+	if (working_width > ow+1)
+		fprintf(fp,
+			"if (last)\n"
+			"\tbegin\n"
+			"\t\to_mag   <= final_mag[WW-1:WW-OW];\n"
+			"\t\to_phase <= ph;\n");
+	else
+		fprintf(fp,
+			"if (last)\n"
+			"\tbegin\t// We accumulate a bit during our processing, so shift by one\n"
+			"\t\to_mag   <= xv[(WW-1):(WW-OW)];\n"
+			"\t\to_phase <= ph;\n");
+	if (with_aux)
+		fprintf(fp, "\t\to_aux  <= aux;\n");
+	fprintf(fp, "\tend\n\n");
+
+	fprintf(fp, "\tassign\to_busy = (!idle)||(last);\n\n");
+
+	if (working_width > ow+1) {
+		fprintf(fp, "\t// Make Verilator happy with final_mag\n"
+			"\t// verilator lint_off UNUSED\n"
+			"\twire	[(WW-OW-1):0] unused_val;\n"
+			"\tassign\tunused_val = final_mag[(WW-OW-1):0];\n"
+			"\t// verilator lint_on UNUSED\n");
+	}
+
+	fprintf(fp, "endmodule\n");
+
+
+	if (NULL != fhp) {
+		char	*str = new char[strlen(name)+4], *ptr;
+		sprintf(str, "%s.h", name);
+		legal(fhp, str, PROJECT, HPURPOSE);
+		ptr = str;
+		while(*ptr) {
+			if ('.' == *ptr)
+				*ptr = '_';
+			else	*ptr = toupper(*ptr);
+			ptr++;
+		}
+		fprintf(fhp, "#ifndef\t%s\n", str);
+		fprintf(fhp, "#define\t%s\n", str);
+
+		if (async_reset)
+			fprintf(fhp, "#define\tASYNC_RESET\n");
+
+		fprintf(fhp, "#ifdef\tCLOCKS_PER_OUTPUT\n");
+		fprintf(fhp, "#undef\tCLOCKS_PER_OUTPUT\n");
+		fprintf(fhp, "#endif\t// CLOCKS_PER_OUTPUT\n");
+		fprintf(fhp, "#define\tCLOCKS_PER_OUTPUT\t%d\n\n", npass+2);
+
+		fprintf(fhp, "const int	IW = %d;\n", iw);
+		fprintf(fhp, "const int	OW = %d;\n", ow);
+		fprintf(fhp, "const int	NEXTRA = %d;\n", nxtra);
+		fprintf(fhp, "const int	WW = %d;\n", working_width);
+		fprintf(fhp, "const int	PW = %d;\n", phase_bits);
+		fprintf(fhp, "const int	NSTAGES = %d;\n", nstages);
+		fprintf(fhp, "const int	ITERS = %d;\n", iters);
+		fprintf(fhp, "const double\tQUANTIZATION_VARIANCE = %.16f; // (Units^2)\n",
+			transform_quantization_variance(nstages,
+				working_width-iw, working_width-ow));
+		fprintf(fhp, "const double\tPHASE_VARIANCE_RAD = %.16f; // (Radians^2)\n",
+			phase_variance(nstages, phase_bits));
+		fprintf(fhp, "const double\tGAIN = %.16f;\n",
+			cordic_gain(nstages));
+		fprintf(fhp, "const bool\tHAS_RESET = %s;\n", with_reset?"true":"false");
+		fprintf(fhp, "const bool\tHAS_AUX   = %s;\n", with_aux?"true":"false");
+		if (with_reset)
+			fprintf(fhp, "#define\tHAS_RESET_WIRE\n");
+		if (with_aux)
+			fprintf(fhp, "#define\tHAS_AUX_WIRES\n");
+		fprintf(fhp, "#endif\t// %s\n", str);
+		delete[] str;
+	}
+
+	// Bit for bit, this core produces exactly what topolar would
+	if (NULL != fmp)
+		topolar_model(fmp, name, nstages, iw, ow, nxtra,
+			working_width, phase_bits, npass+2);
+}
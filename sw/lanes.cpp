@@ -0,0 +1,206 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename: 	lanes.cpp
+//
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	Builds a core that accepts several samples per clock out of a
+//		core that accepts only one.  The single sample core, or lane, is
+//	instantiated once per sample, with every port now NLANES samples wide.
+//	Sample k of any clock is found in bits [k*W +: W] of its port, where W
+//	is the width of a single sample, so sample zero is the earliest.  All
+//	of the lanes share the clock enable, and hence move in lock step, so
+//	only the first lane needs to carry the aux bit.
+//
+//	The table based cores build their lanes themselves, so that two lanes
+//	may share each copy of a table, but use the helpers here to write out
+//	each lane's registers.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2017, Gisselquist Technology, LLC
+//
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+//
+// License:	GPL, v3, as defined and found on www.gnu.org,
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+//
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <assert.h>
+
+#include "lanes.h"
+
+//
+// lane_always
+//
+// The start of a clocked always block, indented by tabs, through to the
+// condition checking the reset.  Without a reset, it ends with the tabs that
+// start the next line.
+std::string	lane_always(const char *tabs, bool with_reset,
+			bool async_reset) {
+	std::string	s = tabs;
+
+	if ((with_reset)&&(async_reset))
+		s += "always @(posedge i_clk, negedge i_areset_n)\n";
+	else
+		s += "always @(posedge i_clk)\n";
+	s += tabs;
+	if ((with_reset)&&(async_reset))
+		s += "if (!i_areset_n)\n";
+	else if (with_reset)
+		s += "if (i_reset)\n";
+	return s;
+}
+
+//
+// lane_register
+//
+// Writes out a clocked always block, at the given indentation, setting reg
+// to val on every clock enable, and to zero on any reset.
+void	lane_register(FILE *fp, const char *tabs, bool with_reset,
+			bool async_reset, const char *reg, const char *val) {
+	fprintf(fp, "%s", lane_always(tabs, with_reset, async_reset).c_str());
+	if (with_reset)
+		fprintf(fp, "%s\t%s <= 0;\n%selse ", tabs, reg, tabs);
+	fprintf(fp, "if (i_ce)\n%s\t%s <= %s;\n", tabs, reg, val);
+}
+
+//
+// lanes_wrapper
+//
+// Writes out module name, made from nlanes copies of the module lane.  The
+// lane is expected to have ports i_clk, i_ce, the reset (if any), i_aux and
+// o_aux (if with_aux), followed by the inputs and outputs given.
+void	lanes_wrapper(FILE *fp, const char *name, const char *lane,
+		int nlanes, bool with_reset, bool with_aux, bool async_reset,
+		int ninputs, const LANEPORT *inputs,
+		int noutputs, const LANEPORT *outputs) {
+	std::string	ports, params, resetn;
+	int		nports = ninputs + noutputs;
+
+	assert(nlanes > 1);
+	assert(ninputs > 0 && noutputs > 0);
+
+	resetn = (!with_reset) ? "" : (async_reset) ? "i_areset_n" : "i_reset";
+
+	// Collect the port list, and the width of each port--once per width
+	for(int k=0; k<nports; k++) {
+		const LANEPORT	*p = (k < ninputs) ? &inputs[k]
+					: &outputs[k-ninputs];
+		bool	dup = false;
+		char	str[64];
+
+		if (k == ninputs && with_aux)
+			ports += " i_aux,";
+		ports += (k == ninputs) ? "\n\t\t" : " ";
+		ports += p->name;
+		if (k+1 < nports)
+			ports += ",";
+
+		for(int j=0; j<k; j++) {
+			const LANEPORT	*q = (j < ninputs) ? &inputs[j]
+					: &outputs[j-ninputs];
+			if (strcmp(q->wname, p->wname)==0)
+				dup = true;
+		} if (dup)
+			continue;
+		snprintf(str, sizeof(str), "%s\n\t\t\t%s=%2d",
+			(params.empty()) ? "" : ",", p->wname, p->width);
+		params += str;
+	}
+
+	fprintf(fp,
+		"\n\n"
+		"//\n"
+		"// %s\n"
+		"//\n"
+		"// %d copies of %s, so as to accept %d samples per clock.  Sample k\n"
+		"// of each clock is found in bits [k*W +: W] of each port, where W is\n"
+		"// the width of one sample.  Sample zero is the earliest.\n"
+		"//\n"
+		"module	%s(i_clk, %s%si_ce,%s%s);\n"
+		"\tlocalparam\tNLANES=%2d,\t// Samples per clock%s;\n"
+		"\tinput\twire\t\t\t\ti_clk, %s%si_ce;\n",
+		name, nlanes, lane, nlanes, name,
+		resetn.c_str(), (with_reset) ? ", " : "",
+		ports.c_str(), (with_aux) ? ", o_aux" : "",
+		nlanes, params.c_str(),
+		resetn.c_str(), (with_reset) ? ", " : "");
+
+	for(int k=0; k<ninputs; k++)
+		fprintf(fp, "\tinput\twire\t[(NLANES*%s-1):0]\t%s;\n",
+			inputs[k].wname, inputs[k].name);
+	for(int k=0; k<noutputs; k++)
+		fprintf(fp, "\toutput\twire\t[(NLANES*%s-1):0]\t%s;\n",
+			outputs[k].wname, outputs[k].name);
+	if (with_aux)
+		fprintf(fp,
+			"\tinput\twire\t\t\t\ti_aux;\n"
+			"\toutput\twire\t\t\t\to_aux;\n"
+			"\n"
+			"\t// Every lane moves in lock step, so only the first lane"
+				" needs\n"
+			"\t// to carry the aux bit through.\n"
+			"\twire\t[(NLANES-1):0]\tlane_aux;\n");
+
+	fprintf(fp,
+		"\n"
+		"\tgenvar\tlane;\n"
+		"\tgenerate for(lane=0; lane<NLANES; lane=lane+1)\n"
+		"\tbegin : LANE\n"
+		"\t\t%s\n"
+		"\t\tu_lane(.i_clk(i_clk), ", lane);
+	if (with_reset)
+		fprintf(fp, ".%s(%s), ", resetn.c_str(), resetn.c_str());
+	fprintf(fp, ".i_ce(i_ce)");
+
+	for(int k=0; k<nports; k++) {
+		const LANEPORT	*p = (k < ninputs) ? &inputs[k]
+					: &outputs[k-ninputs];
+
+		fprintf(fp, ",\n\t\t\t.%s(%s[lane*%s +: %s])",
+			p->name, p->name, p->wname, p->wname);
+	}
+
+	if (with_aux)
+		fprintf(fp, ",\n"
+			"\t\t\t.i_aux((lane == 0) ? i_aux : 1\'b0),\n"
+			"\t\t\t.o_aux(lane_aux[lane])");
+	fprintf(fp, ");\n"
+		"\tend endgenerate\n");
+
+	if (with_aux)
+		fprintf(fp,
+			"\n"
+			"\tassign\to_aux = lane_aux[0];\n"
+			"\n"
+			"\t// Make verilator happy\n"
+			"\t// verilator lint_off UNUSED\n"
+			"\twire\tunused_aux;\n"
+			"\tassign\tunused_aux = &{ 1\'b0, lane_aux[(NLANES-1):1] };\n"
+			"\t// verilator lint_on  UNUSED\n");
+
+	fprintf(fp, "endmodule\n");
+}
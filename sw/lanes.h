@@ -0,0 +1,63 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename: 	lanes.h
+//
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	Declares the routine that wraps a single lane core so that it
+//		accepts several samples per clock.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2017, Gisselquist Technology, LLC
+//
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+//
+// License:	GPL, v3, as defined and found on www.gnu.org,
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+#ifndef	LANES_H
+#define	LANES_H
+
+#include <stdio.h>
+#include <string>
+
+//
+// LANEPORT
+//
+// Describes one data port of a lane: its name, and the name and value of
+// the localparam giving its width.
+typedef	struct	{
+	const char	*name, *wname;
+	int		width;
+} LANEPORT;
+
+extern	std::string	lane_always(const char *tabs, bool with_reset,
+			bool async_reset);
+extern	void	lane_register(FILE *fp, const char *tabs, bool with_reset,
+			bool async_reset, const char *reg, const char *val);
+extern	void	lanes_wrapper(FILE *fp, const char *name, const char *lane,
+			int nlanes, bool with_reset, bool with_aux,
+			bool async_reset, int ninputs, const LANEPORT *inputs,
+			int noutputs, const LANEPORT *outputs);
+
+#endif	// LANES_H
@@ -0,0 +1,767 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename: 	libgencordic.cpp
+//
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	Builds one core from a GENCORDIC_CONFIG, choosing any of its
+//		parameters that were left to their defaults, and calling the
+//	generator for its type.  See libgencordic.h.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2017-2018, Gisselquist Technology, LLC
+//
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+//
+// License:	GPL, v3, as defined and found on www.gnu.org,
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+//
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cordiclib.h"
+#include "topolar.h"
+#include "seqpolar.h"
+#include "basiccordic.h"
+#include "seqcordic.h"
+#include "itercordic.h"
+#include "iterpolar.h"
+#include "hybridcordic.h"
+#include "radix4cordic.h"
+#include "estimate.h"
+#include "sintable.h"
+#include "quadtbl.h"
+#include "ctbl.h"
+#include "hexfile.h"
+#include "gencache.h"
+#include "swmodel.h"
+#include "libgencordic.h"
+
+//
+// gc_types
+//
+// Every type of core, together with the fewest and the most phase bits it
+// can be built with (zero for no limit).  The limits on the table sizes are
+// arbitrary: few FPGAs have more than 16M of block RAM.  If you know what you
+// are doing, you can raise them to perhaps 30 without much hassle.  Beyond
+// that, beware of integer overflow.
+static	const	struct	{
+	const char	*name, *fname;
+	GENCORDIC_TYPE	type;
+	int		min_pw, max_pw;
+} gc_types[] = {
+	{ "p2r",  "basiccordic.v",  GC_P2R,  3,  0 },
+	{ "sp2r", "seqcordic.v",    GC_SP2R, 3,  0 },
+	{ "hp2r", "hybridcordic.v", GC_HP2R, 4,  0 },
+	{ "p2r4", "radix4cordic.v", GC_P2R4, 3,  0 },
+	{ "r2p",  "topolar.v",      GC_R2P,  3,  0 },
+	{ "sr2p", "seqpolar.v",     GC_SR2P, 3,  0 },
+	{ "r2p4", "radix4polar.v",  GC_R2P4, 3,  0 },
+	{ "tbl",  "sintable.v",     GC_TBL,  2, 23 },
+	{ "qtr",  "quarterwav.v",   GC_QTR,  4, 25 },
+	{ "qtbl", "quadtbl.v",      GC_QTBL, 5,  0 },
+	{ "ctbl", "sinctbl.v",      GC_CTBL, 5, 27 }
+};
+static	const	int	NTYPES = sizeof(gc_types)/sizeof(gc_types[0]);
+
+//
+// seq_engines
+//
+// A sequential core with more engines than the clocks it takes per sample
+// could never keep them all busy, so it gets no more than that.
+static	int	seq_engines(int nengines, int clocks) {
+	if (nengines > clocks) {
+		fprintf(stderr, "WARNING: A core taking %d clocks per sample can use no more\n"
+			"than %d engines.  Using -E %d\n", clocks, clocks, clocks);
+		return clocks;
+	} return nengines;
+}
+
+//
+// core_fits
+//
+// Returns true if a core of the given type can be built with these widths,
+// after those left to their defaults have been settled.  Otherwise, says why
+// not and returns false.
+static	bool	core_fits(GENCORDIC_TYPE type, int phase_bits, int ow,
+		int nxtra, int nstages, int iters) {
+	for(int k=0; k<NTYPES; k++) {
+		if (gc_types[k].type != type)
+			continue;
+		if (phase_bits < gc_types[k].min_pw) {
+			fprintf(stderr, "ERR: A %s core needs at least %d phase bits, not %d\n",
+				gc_types[k].name, gc_types[k].min_pw, phase_bits);
+			return false;
+		} else if ((gc_types[k].max_pw > 0)
+				&&(phase_bits > gc_types[k].max_pw)) {
+			fprintf(stderr, "ERR: A %s core may have no more than %d phase bits, not %d\n",
+				gc_types[k].name, gc_types[k].max_pw, phase_bits);
+			return false;
+		}
+	}
+
+	// The quadratic fit needs a few bits to work with, while the tables
+	// are written out with no more than 30 bits to an entry.  The qtbl
+	// coefficients are as wide as the core's output and extra bits
+	// together.
+	if ((type == GC_QTBL)&&(ow+nxtra < 7)) {
+		fprintf(stderr, "ERR: A qtbl core needs at least 7 bits, output and extra, not %d\n",
+			ow+nxtra);
+		return false;
+	} else if ((type == GC_QTBL)&&(ow+nxtra > 30)) {
+		fprintf(stderr, "ERR: A qtbl core may have no more than 30 bits, output and extra, not %d\n",
+			ow+nxtra);
+		return false;
+	} else if (((type == GC_TBL)||(type == GC_QTR)||(type == GC_CTBL))
+			&&((ow < 1)||(ow > 30))) {
+		fprintf(stderr, "ERR: A table core needs from 1 to 30 output bits, not %d\n",
+			ow);
+		return false;
+	}
+
+	// An iterative core counts through its stages, and needs at least two
+	// of them to count through
+	if ((iters > 0)&&(nstages < 2)) {
+		fprintf(stderr, "ERR: A core built with -k needs at least 2 CORDIC stages, not %d\n",
+			nstages);
+		return false;
+	}
+
+	// A radix-4 core needs a stage to hold its digit
+	if (((type == GC_P2R4)||(type == GC_R2P4))&&(nstages < 1)) {
+		fprintf(stderr, "ERR: A %s core needs at least 1 CORDIC stage, not %d\n",
+			(type == GC_P2R4) ? "p2r4" : "r2p4", nstages);
+		return false;
+	}
+
+	return true;
+}
+
+void	GENCORDIC_MEMSINK::file(const char *fname, const char *data, size_t len) {
+	GENCORDIC_FILE	f;
+
+	f.name = fname;
+	f.data.assign(data, len);
+	m_files.push_back(f);
+}
+
+const GENCORDIC_FILE	*GENCORDIC_MEMSINK::find(const char *fname) const {
+	for(size_t k=0; k<m_files.size(); k++)
+		if (m_files[k].name == fname)
+			return &m_files[k];
+	return NULL;
+}
+
+void	gencordic_config_init(GENCORDIC_CONFIG *cfg) {
+	cfg->type        = GC_R2P;
+	cfg->fname       = NULL;
+	cfg->iw          = -1;
+	cfg->ow          = -1;
+	cfg->nxtra       = 2;
+	cfg->phase_bits  = -1;
+	cfg->nstages     = -1;
+	cfg->nlanes      = 1;
+	cfg->nengines    = 1;
+	cfg->nchannels   = 1;
+	cfg->iters       = 0;
+	cfg->kstages     = 1;
+	cfg->rom_bits    = -1;
+	cfg->mpy_aw      = 0;
+	cfg->mpy_bw      = 0;
+	cfg->mpy_delay   = 1;
+	cfg->with_reset  = true;
+	cfg->async_reset = false;
+	cfg->with_aux    = true;
+	cfg->phase_acc   = false;
+	cfg->c_header    = false;
+	cfg->c_model     = false;
+	cfg->verbose     = false;
+	cfg->tbl_formats = "";
+	cfg->cache_dir   = NULL;
+}
+
+bool	gencordic_type(const char *name, GENCORDIC_TYPE *type, const char **fname) {
+	for(int k=0; k<NTYPES; k++) {
+		if (0 == strcmp(name, gc_types[k].name)) {
+			*type = gc_types[k].type;
+			if (fname)
+				*fname = gc_types[k].fname;
+			return true;
+		}
+	} return false;
+}
+
+//
+// model_fopen
+//
+// Opens the software model, named after the core's file name, fname, with
+// a _model.h suffix in place of the .v.  There's no model if the core goes
+// to stdout, fp, or if it won't fit in the model's arithmetic.
+static	FILE	*model_fopen(FILE *fp, const char *fname, bool fits) {
+	FILE	*fmp;
+	char	*strp;
+	int	slen;
+
+	if (fp == stdout) {
+		fprintf(stderr, "WARNING: Software models can only be created alongside a named output file\n");
+		return NULL;
+	} else if (!fits) {
+		fprintf(stderr, "WARNING: The software model is limited to 32 phase bits, a working\n"
+			"width under 62 bits, and tables no wider than 32 bits.  No model built\n");
+		return NULL;
+	}
+
+	strp = new char[strlen(fname)+10];
+	slen = strlen(fname);
+	strcpy(strp, fname);
+	if ((slen>2)&&(strp[slen-1] == 'v')&&(strp[slen-2]=='.'))
+		strp[slen-2] = '\0';
+	strcat(strp, "_model.h");
+	fmp = gencache_fopen(strp, "w");
+	if (NULL == fmp)
+		fprintf(stderr, "WARNING: Could not open %s\n", strp);
+	delete[] strp;
+	return fmp;
+}
+
+int	gencordic_build(const GENCORDIC_CONFIG *cfg, GENCORDIC_SINK *sink) {
+	const int	DEFAULT_BITWIDTH = 24;
+	int	nstages = cfg->nstages, iw = cfg->iw, ow = cfg->ow,
+		nxtra = cfg->nxtra, phase_bits = cfg->phase_bits, ww;
+	int	nlanes = cfg->nlanes, iters = cfg->iters,
+		kstages = cfg->kstages,
+		rom_bits = cfg->rom_bits, nengines = cfg->nengines,
+		nchannels = cfg->nchannels;
+	int	mpy_aw = cfg->mpy_aw, mpy_bw = cfg->mpy_bw,
+		mpy_delay = cfg->mpy_delay;
+	const char	*fname = cfg->fname, *cache_dir = cfg->cache_dir,
+			*tbl_formats = (cfg->tbl_formats) ? cfg->tbl_formats : "";
+	bool	with_reset = cfg->with_reset, with_aux = cfg->with_aux,
+		async_reset = cfg->async_reset, c_header = cfg->c_header,
+		phase_acc = cfg->phase_acc,
+		c_model = cfg->c_model, verbose = cfg->verbose;
+	GENCORDIC_TYPE	type = cfg->type;
+	bool	polar_to_rect = (type == GC_P2R)||(type == GC_SP2R)
+				||(type == GC_HP2R)||(type == GC_P2R4),
+		rect_to_polar = (type == GC_R2P)||(type == GC_SR2P)
+				||(type == GC_R2P4),
+		gen_sintable   = (type == GC_TBL),
+		gen_quarterwav = (type == GC_QTR),
+		gen_quadtbl    = (type == GC_QTBL),
+		gen_ctbl       = (type == GC_CTBL),
+		sequential = (type == GC_SP2R)||(type == GC_SR2P),
+		hybrid     = (type == GC_HP2R),
+		radix4     = (type == GC_P2R4)||(type == GC_R2P4);
+	FILE	*fp, *fhp, *fmp, *vfp;
+
+	if ((nlanes < 1)||(nengines < 1)||(nchannels < 1)||(iters < 0)
+			||(kstages < 1)
+			||(mpy_delay < 1)
+			||((mpy_aw > 0)&&((mpy_aw < 2)||(mpy_bw < 2)))) {
+		fprintf(stderr, "ERR: Bad core configuration\n");
+		return EXIT_FAILURE;
+	}
+
+	// Every core starts from its own table formats, whatever an earlier
+	// core built by this thread may have asked for
+	if (!hextable_formats(tbl_formats))
+		return EXIT_FAILURE;
+
+	// A sink's files need names, even if they never reach the disk
+	if ((NULL != sink)&&((NULL == fname)||(strlen(fname)==0)
+			||(strcmp(fname, "-")==0))) {
+		for(int k=0; k<NTYPES; k++)
+			if (gc_types[k].type == type)
+				fname = gc_types[k].fname;
+	}
+
+	if ((nlanes > 1)&&((sequential)||(hybrid)||(radix4)||(gen_ctbl))) {
+		fprintf(stderr, "WARNING: Only the p2r, r2p, tbl, qtr, and qtbl cores accept more\n"
+			"than one sample per clock.  Ignoring -P %d\n", nlanes);
+		nlanes = 1;
+	}
+
+	if ((iters > 0)&&((sequential)||(hybrid)||(radix4)
+			||((!polar_to_rect)&&(!rect_to_polar)))) {
+		fprintf(stderr, "WARNING: Only the p2r and r2p cores may be built with several\n"
+			"iterations per clock.  Ignoring -k %d\n", iters);
+		iters = 0;
+	} else if ((iters > 0)&&(nlanes > 1)) {
+		fprintf(stderr, "WARNING: A core built with -k accepts one sample at a time.\n"
+			"Ignoring -P %d\n", nlanes);
+		nlanes = 1;
+	}
+
+	if ((kstages > 1)&&((sequential)||(hybrid)||(radix4)
+			||((!polar_to_rect)&&(!rect_to_polar)))) {
+		fprintf(stderr, "WARNING: Only the p2r and r2p cores may be built with several\n"
+			"stages per pipeline register.  Ignoring -K %d\n", kstages);
+		kstages = 1;
+	} else if ((kstages > 1)&&(iters > 0)) {
+		fprintf(stderr, "WARNING: A core built with -k is not pipelined.  Ignoring -K %d\n", kstages);
+		kstages = 1;
+	}
+
+	if ((nengines > 1)&&(!sequential)) {
+		fprintf(stderr, "WARNING: Only the sp2r and sr2p cores are built from engines.  Ignoring -E %d\n", nengines);
+		nengines = 1;
+	}
+
+	if ((nchannels > 1)&&(type != GC_P2R)) {
+		fprintf(stderr, "WARNING: Only the p2r cores may be shared between channels.  Ignoring -T %d\n", nchannels);
+		nchannels = 1;
+	} else if ((nchannels > 1)&&((iters > 0)||(nlanes > 1))) {
+		fprintf(stderr, "WARNING: A core shared between channels takes one sample on every\n"
+			"clock, so it may not be built with -k or -P.  Ignoring -T %d\n", nchannels);
+		nchannels = 1;
+	}
+
+	if ((phase_acc)&&(nchannels <= 1)) {
+		fprintf(stderr, "WARNING: Only a core shared between channels keeps a phase per channel.  Ignoring -F\n");
+		phase_acc = false;
+	}
+
+	if ((rom_bits > 0)&&(!hybrid)) {
+		fprintf(stderr, "WARNING: Only the hp2r cores use a table budget.  Ignoring -B %d\n", rom_bits);
+	} else if (rom_bits < 0)
+		rom_bits = DEF_ROMBITS;
+
+	if (((mpy_aw > 0)||(mpy_delay > 1))&&(!gen_quadtbl)) {
+		fprintf(stderr, "WARNING: Only the qtbl cores use a multiplier.  Ignoring -D and -L\n");
+		mpy_aw = mpy_bw = 0;
+		mpy_delay = 1;
+	}
+
+	// Settle on the widths of the core before anything else, so that a
+	// core too small or too large to be built is turned away before any
+	// of its files are opened
+	if ((polar_to_rect)||(rect_to_polar)||(gen_quadtbl)) {
+		if ((iw < 0)&&(ow > 0))
+			iw = ow;
+		if (ow < 0)
+			ow = iw;
+		if ((iw < 0)||(ow < 0)) {
+			fprintf(stderr, "WARNING: Assuming an input and output bit-width of %d bits\n", DEFAULT_BITWIDTH);
+			iw = DEFAULT_BITWIDTH;
+			ow = DEFAULT_BITWIDTH;
+		}
+		ww = (ow > iw) ? ow:iw;
+		nxtra += (rect_to_polar) ? 2 : 1;
+		ww += nxtra;
+		if (phase_bits < 0)
+			phase_bits = calc_phase_bits(ww);
+		if (nstages < 0)
+			nstages = (rect_to_polar) ? calc_stages(phase_bits)
+				: calc_stages(ww, phase_bits);
+	} else {
+		if ((iw >= 0)&&(phase_bits < 0)) {
+			phase_bits = iw;
+			iw = -1;
+		}
+		if (iw >= 0)
+			fprintf(stderr, "WARNING: Input width parameter, -i %d, ignored for sine table generation\n", iw);
+		if ((phase_bits > 3)&&(ow < 0)) {
+			for(int k=phase_bits-2; k<phase_bits + 3; k++) {
+				int	pb;
+				pb = calc_phase_bits(k);
+				if (pb == phase_bits) {
+					ow = k;
+					break;
+				}
+			}
+		} if (ow < 0) {
+			fprintf(stderr, "WARNING: Assuming an output bit-width of %d bits\n", DEFAULT_BITWIDTH);
+			ow = DEFAULT_BITWIDTH;
+		} if (phase_bits < 0) {
+			// Left to its default, the phase width follows the
+			// output width, and may ask for a larger (or smaller)
+			// table than the core can have.  Settle for the
+			// nearest one it can.
+			phase_bits = calc_phase_bits(ow);
+			for(int k=0; k<NTYPES; k++) {
+				if (gc_types[k].type != type)
+					continue;
+				if (phase_bits < gc_types[k].min_pw) {
+					fprintf(stderr, "WARNING: A %s core needs at least %d phase bits.  Using -p %d\n",
+						gc_types[k].name, gc_types[k].min_pw,
+						gc_types[k].min_pw);
+					phase_bits = gc_types[k].min_pw;
+				} else if ((gc_types[k].max_pw > 0)
+						&&(phase_bits > gc_types[k].max_pw)) {
+					fprintf(stderr, "WARNING: A %s core may have no more than %d phase bits.  Using -p %d\n",
+						gc_types[k].name, gc_types[k].max_pw,
+						gc_types[k].max_pw);
+					phase_bits = gc_types[k].max_pw;
+				}
+			}
+		} ww = ow;
+	}
+
+	if (!core_fits(type, phase_bits, ow, nxtra, nstages, iters))
+		return EXIT_FAILURE;
+
+	if (NULL != sink)
+		gencache_sink(sink);
+	else if ((NULL != cache_dir)&&(NULL != fname)&&(strlen(fname) > 0)
+			&&(strcmp(fname, "-") != 0)) {
+		char	params[1024];
+
+		// Everything that might change what gets written
+		snprintf(params, sizeof(params),
+			"f=%s,n=%d,i=%d,o=%d,x=%d,p=%d,P=%d,k=%d,K=%d,B=%d,M=%s,"
+			"D=%dx%d,L=%d,E=%d,T=%d,"
+			"flags=%d%d%d%d%d%d%d%d%d%d%d%d%d%d%d%d",
+			fname, nstages, iw, ow, nxtra, phase_bits, nlanes, iters,
+			kstages, rom_bits, tbl_formats, mpy_aw, mpy_bw, mpy_delay,
+			nengines, nchannels,
+			with_reset, with_aux, polar_to_rect, rect_to_polar,
+			gen_sintable, gen_quarterwav, c_header, gen_quadtbl,
+			async_reset, sequential, c_model, verbose,
+			hybrid, phase_acc, gen_ctbl, radix4);
+		gencache_init(cache_dir, params);
+		if (gencache_restore()) {
+			if (verbose)
+				printf("Restored %s from the cache\n", fname);
+			gencache_close();
+			return EXIT_SUCCESS;
+		}
+	}
+
+	// Anything said with -v goes through the cache, to be said again
+	// should this core ever be restored from it
+	vfp = gencache_log();
+
+	fhp = NULL;
+	if ((NULL == fname)||(strlen(fname)==0)||(strcmp(fname, "-")==0)) {
+		fp = stdout;
+	} else if (NULL == (fp = gencache_fopen(fname, "w"))) {
+		fprintf(stderr, "ERR: Cannot open to %s for writing\n", fname);
+		perror("O/S Err:");
+		gencache_close();
+		return EXIT_FAILURE;
+	} else if ((c_header)&&(!gen_sintable)&&(!gen_quarterwav)
+			&&(!gen_ctbl)) {
+		char *strp = strdup(fname);
+		int	slen = strlen(fname);
+		if ((slen>2)&&(strp[slen-1] == 'v')&&(strp[slen-2]=='.')) {
+			strp[slen-1] = 'h';
+			fhp = gencache_fopen(strp, "w");
+			if (NULL == fhp)
+				fprintf(stderr, "WARNING: Could not open %s\n", strp);
+		} free(strp);
+	}
+
+	// The model file waits until the widths of the core are known, lest
+	// it be left behind empty for a core too wide to model
+	fmp = NULL;
+
+	if (polar_to_rect) {
+		if (sequential)
+			nengines = seq_engines(nengines, nstages+1);
+
+		if (verbose) {
+			fprintf(vfp, "Building %s cordic with the following parameters:\n"
+			"\tOutput file     : %s\n"
+			"\tInput  bits     : %2d\n"
+			"\tExtra  bits     : %2d (used in computation, dropped when done)\n"
+			"\tOutput bits     : %2d\n"
+			"\tPhase  bits     : %2d\n"
+			"\tNumber of stages: %2d\n",
+			(sequential)?"a sequential"
+				: (iters > 0)?"an iterative"
+				: (hybrid)?"a hybrid table and"
+				: (radix4)?"a radix-4":"a basic",
+			(fp == stdout)?"(stdout)":fname,
+			iw, nxtra, ow, phase_bits, nstages);
+			if (iters > 0)
+				fprintf(vfp, "\tStages per clock: %2d\n", iters);
+			else if (kstages > 1)
+				fprintf(vfp, "\tStages per clock: %2d\n", kstages);
+			else if (radix4)
+				fprintf(vfp, "\tStages per clock: %2d (one radix-4 digit)\n", 2);
+			if (nengines > 1)
+				fprintf(vfp, "\tEngines         : %2d\n", nengines);
+			if (nchannels > 1)
+				fprintf(vfp, "\tChannels        : %2d%s\n", nchannels,
+					(phase_acc) ? ", each with its own phase" : "");
+			if (hybrid) {
+				int	lgtbl, first;
+
+				lgtbl = hybrid_lgtbl(nstages, ww, phase_bits,
+						rom_bits, &first);
+				fprintf(vfp, "\tTable entries   : %2d (2^%d)\n"
+					"\tStages replaced : %2d\n",
+					1<<lgtbl, lgtbl, first);
+			}
+			if ((with_reset)&&(async_reset))
+				fprintf(vfp, "\tDesign will include an async reset signal\n");
+			else if (with_reset)
+				fprintf(vfp, "\tDesign will include a reset signal\n");
+			if (with_aux)
+				fprintf(vfp, "\tAux bits will be added to the design\n");
+		}
+
+		if (c_model)
+			fmp = model_fopen(fp, fname, model_fits((hybrid)
+				? ww + hybrid_table_width(ww) : ww, phase_bits));
+
+		if (sequential)
+			seqcordic(fp, fhp, fname,
+				nstages, iw, ow, nxtra, phase_bits,
+				with_reset, with_aux, async_reset, fmp,
+				nengines);
+		else if (hybrid)
+			hybridcordic(fp, fhp, fname,
+				nstages, iw, ow, nxtra, phase_bits, rom_bits,
+				with_reset, with_aux, async_reset, fmp);
+		else if (radix4)
+			radix4cordic(fp, fhp, fname,
+				nstages, iw, ow, nxtra, phase_bits,
+				with_reset, with_aux, async_reset, fmp);
+		else if (iters > 0)
+			itercordic(fp, fhp, fname,
+				nstages, iw, ow, nxtra, phase_bits, iters,
+				with_reset, with_aux, async_reset, fmp);
+		else
+			basiccordic(fp, fhp, fname,
+				nstages, iw, ow, nxtra, phase_bits,
+				with_reset, with_aux, async_reset, fmp, nlanes,
+				kstages, nchannels, phase_acc);
+
+		if (verbose) {
+			CORE_ESTIMATE	est;
+
+			estimate_cordic(&est, type, nstages, ww, ow, phase_bits,
+				iters, rom_bits, nengines, kstages);
+			estimate_channels(&est, nchannels, phase_acc, iw,
+				phase_bits);
+			estimate_lanes(&est, nlanes, with_aux);
+			estimate_report(vfp, &est);
+		}
+	} if (rect_to_polar) {
+		if (sequential)
+			nengines = seq_engines(nengines, nstages+3);
+		if (verbose) {
+			fprintf(vfp, "Building a%s rectangular-to-polar CORDIC converter with the\nfollowing parameters:\n"
+			"\tOutput file     : %s\n"
+			"\tInput  bits     : %2d\n"
+			"\tExtra  bits     : %2d (used in computation, dropped when done)\n"
+			"\tOutput bits     : %2d\n"
+			"\tPhase  bits     : %2d\n"
+			"\tNumber of stages: %2d\n",
+			(iters > 0)?"n iterative":(radix4)?" radix-4":"",
+			(fp == stdout)?"(stdout)":fname,
+			iw, nxtra, ow, phase_bits, nstages);
+			if (iters > 0)
+				fprintf(vfp, "\tStages per clock: %2d\n", iters);
+			else if (kstages > 1)
+				fprintf(vfp, "\tStages per clock: %2d\n", kstages);
+			else if (radix4)
+				fprintf(vfp, "\tStages per clock: %2d (one radix-4 digit)\n", 2);
+			if (nengines > 1)
+				fprintf(vfp, "\tEngines         : %2d\n", nengines);
+			if (with_reset)
+				fprintf(vfp, "\tDesign will include a reset signal\n");
+			if (with_aux)
+				fprintf(vfp, "\tAux bits will be added to the design\n");
+		}
+
+		// The polar cores add nxtra to their working width once more
+		if (c_model)
+			fmp = model_fopen(fp, fname,
+				model_fits(ww+nxtra, phase_bits));
+
+		if (sequential)
+			seqpolar(fp, fhp, fname,
+				nstages, iw, ow, nxtra, phase_bits,
+				with_reset, with_aux, async_reset, fmp,
+				nengines);
+		else if (radix4)
+			radix4polar(fp, fhp, fname,
+				nstages, iw, ow, nxtra, phase_bits,
+				with_reset, with_aux, async_reset, fmp);
+		else if (iters > 0)
+			iterpolar(fp, fhp, fname,
+				nstages, iw, ow, nxtra, phase_bits, iters,
+				with_reset, with_aux, async_reset, fmp);
+		else
+			topolar(fp, fhp, fname,
+				nstages, iw, ow, nxtra, phase_bits,
+				with_reset, with_aux, async_reset, fmp, nlanes,
+				kstages);
+
+		if (verbose) {
+			CORE_ESTIMATE	est;
+
+			// The polar cores add nxtra to their working width
+			// once more themselves
+			estimate_cordic(&est, type, nstages, ww+nxtra, ow,
+				phase_bits, iters, 0, nengines, kstages);
+			estimate_lanes(&est, nlanes, with_aux);
+			estimate_report(vfp, &est);
+		}
+	} if (gen_sintable) {
+		if (verbose) {
+			fprintf(vfp, "Building a Sinewave table lookup with the following parameters:\n"
+			"\tOutput file     : %s\n"
+			"\tInput  bits     : %2d\n"
+			"\tPhase  bits     : %2d\n"
+			"\tOutput bits     : %2d\n",
+			(fp == stdout)?"(stdout)":fname,
+			phase_bits, phase_bits, ow);
+			if ((with_reset)&&(async_reset))
+				fprintf(vfp, "\tDesign will include an async reset signal\n");
+			else if (with_reset)
+				fprintf(vfp, "\tDesign will include a reset signal\n");
+			if (with_aux)
+				fprintf(vfp, "\tAux bits will be added to the design\n");
+		}
+
+		if (c_model)
+			fmp = model_fopen(fp, fname,
+				table_model_fits(ow, phase_bits));
+
+		sintable(fp, fname, phase_bits, ow, with_reset, with_aux, async_reset,
+			fmp, nlanes);
+
+		if (verbose) {
+			CORE_ESTIMATE	est;
+
+			estimate_table(&est, type, phase_bits, ow);
+			estimate_lanes(&est, nlanes, with_aux, true);
+			estimate_report(vfp, &est);
+		}
+	} if ((gen_quarterwav)||(gen_ctbl)) {
+		if (verbose) {
+			fprintf(vfp, "Building a Sinewave table lookup with the following parameters:\n"
+			"\tOutput file     : %s\n"
+			"\tInput  bits     : %2d\n"
+			"\tPhase  bits     : %2d\n"
+			"\tOutput bits     : %2d\n",
+			(fp == stdout)?"(stdout)":fname,
+			phase_bits, phase_bits, ow);
+			if ((with_reset)&&(async_reset))
+				fprintf(vfp, "\tDesign will include an async reset signal\n");
+			else if (with_reset)
+				fprintf(vfp, "\tDesign will include a reset signal\n");
+			if (with_aux)
+				fprintf(vfp, "\tAux bits will be added to the design\n");
+		}
+
+		if (c_model)
+			fmp = model_fopen(fp, fname,
+				table_model_fits(ow, phase_bits));
+
+		if (gen_ctbl) {
+			CORE_ESTIMATE	est;
+			CTBL_SPLIT	split;
+
+			if (!ctbl(fp, fname, phase_bits, ow, with_reset,
+					with_aux, async_reset, fmp, &split, &est)) {
+				if (fp != stdout)
+					fclose(fp);
+				if (NULL != fmp)
+					fclose(fmp);
+				gencache_close();
+				return EXIT_FAILURE;
+			}
+
+			if (verbose) {
+				fprintf(vfp, "\tTable split     : %d:%d:%d, %d guard bits\n"
+				"\tCoarse table    : %2d x %d bits\n"
+				"\tFine table      : %2d x %d bits\n"
+				"\tPredicted error : %f LSBs (%f found)\n"
+				"\tCompression     : %.1fx over a quarter-wave table\n",
+				split.abits, split.bbits, split.cbits,
+				split.gbits,
+				split.abits+split.bbits, split.cw,
+				split.abits+split.cbits, split.fw,
+				split.prederr, split.mxerr,
+				(double)(1l<<(phase_bits-2)) * ow
+					/ (double)est.rom_bits);
+				estimate_report(vfp, &est);
+			}
+		} else {
+			quarterwav(fp, fname, phase_bits, ow, with_reset,
+				with_aux, async_reset, fmp, nlanes);
+
+			if (verbose) {
+				CORE_ESTIMATE	est;
+
+				estimate_table(&est, type, phase_bits, ow);
+				estimate_lanes(&est, nlanes, with_aux, true);
+				estimate_report(vfp, &est);
+			}
+		}
+	} if (gen_quadtbl) {
+		if (verbose) {
+			fprintf(vfp, "Building a quadratically interpolated table based sine-wave calculator\n"
+			"\tOutput file     : %s\n"
+			// "\tInput  bits     : %2d\n"
+			"\tExtra  bits     : %2d (used in computation, dropped when done)\n"
+			"\tOutput bits     : %2d\n"
+			"\tPhase  bits     : %2d\n",
+			// "\tNumber of stages: %2d\n",
+			(fp == stdout)?"(stdout)":fname, // iw,
+			nxtra, ow, phase_bits);
+			if ((with_reset)&&(async_reset))
+				fprintf(vfp, "\tDesign will include an async reset signal\n");
+			else if (with_reset)
+				fprintf(vfp, "\tDesign will include a reset signal\n");
+			if (with_aux)
+				fprintf(vfp, "\tAux bits will be added to the design\n");
+			if (mpy_aw > 0)
+				fprintf(vfp, "\tMultipliers     : %dx%d\n", mpy_aw, mpy_bw);
+			fprintf(vfp, "\tMultiply clocks : %2d\n", mpy_delay);
+		}
+
+		/*
+		basiccordic(fp, fhp, fname,
+			nstages, iw, ow, nxtra, phase_bits,
+			with_reset, with_aux);
+		*/
+		CORE_ESTIMATE	est;
+
+		// The coefficient table may be a bit wider than the core, to
+		// hold values a touch greater than one
+		if (c_model)
+			fmp = model_fopen(fp, fname,
+				table_model_fits(ww+2, phase_bits));
+
+		quadtbl(fp, fhp, fname, phase_bits, ow, nxtra, with_reset, with_aux,
+			async_reset, fmp, nlanes, mpy_aw, mpy_bw, mpy_delay, &est);
+		if (verbose)
+			estimate_report(vfp, &est);
+	}
+
+	if (fp != stdout)
+		fclose(fp);
+	if (NULL != fhp)
+		fclose(fhp);
+	if (NULL != fmp)
+		fclose(fmp);
+	gencache_commit();
+	return EXIT_SUCCESS;
+}
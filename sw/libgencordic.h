@@ -0,0 +1,161 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename: 	libgencordic.h
+//
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	The core generator, as a library.  A GENCORDIC_CONFIG holds
+//		everything gencordic's command line would, and
+//	gencordic_build() builds the core it describes.  Given a sink, every
+//	file the core is made of--the Verilog, any C header or software model,
+//	and every table--is handed to the sink as a block of memory rather than
+//	written to disk.
+//
+//	gencordic itself is just an argument parser wrapped around this
+//	library, so both always build the same cores.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2017-2018, Gisselquist Technology, LLC
+//
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+//
+// License:	GPL, v3, as defined and found on www.gnu.org,
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+//
+#ifndef	LIBGENCORDIC_H
+#define	LIBGENCORDIC_H
+
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+//
+// GENCORDIC_TYPE
+//
+// One per -t option, save explore, which builds no core.
+//
+typedef	enum	{
+	GC_P2R, GC_SP2R, GC_HP2R, GC_P2R4,
+	GC_R2P, GC_SR2P, GC_R2P4,
+	GC_TBL, GC_QTR, GC_QTBL, GC_CTBL
+} GENCORDIC_TYPE;
+
+//
+// GENCORDIC_CONFIG
+//
+// Any width, phase_bits, or nstages left negative is chosen for you, just
+// as when the matching option isn't given to gencordic.
+//
+typedef	struct	{
+	GENCORDIC_TYPE	type;		// -t
+	const char	*fname;		// -f, NULL for stdout
+	int	iw, ow;			// -i, -o
+	int	nxtra;			// -x
+	int	phase_bits;		// -p
+	int	nstages;		// -n
+	int	nlanes;			// -P
+	int	nengines;		// -E, sp2r and sr2p only
+	int	nchannels;		// -T, p2r only
+	int	iters;			// -k, zero for a pipelined core
+	int	kstages;		// -K, stages per pipeline register
+	int	rom_bits;		// -B, negative for the default
+	int	mpy_aw, mpy_bw;		// -D, zero for no limit
+	int	mpy_delay;		// -L
+	bool	with_reset;		// -r, or -R to clear it
+	bool	async_reset;		// -A, with with_reset
+	bool	with_aux;		// -a
+	bool	phase_acc;		// -F, with nchannels
+	bool	c_header;		// -c
+	bool	c_model;		// -m
+	bool	verbose;		// -v
+	const char	*tbl_formats;	// -M, "" for .hex alone
+	const char	*cache_dir;	// -C, NULL for no cache
+} GENCORDIC_CONFIG;
+
+//
+// GENCORDIC_SINK
+//
+// Receives each file of a core once the core is complete.  fname is the
+// name the file would have been written to, derived as always from the
+// config's fname.
+//
+class	GENCORDIC_SINK {
+public:
+	virtual	~GENCORDIC_SINK(void) {}
+	virtual	void	file(const char *fname, const char *data, size_t len) = 0;
+};
+
+//
+// GENCORDIC_MEMSINK
+//
+// A sink that just keeps a copy of every file, in the order received.
+//
+typedef	struct	{
+	std::string	name, data;
+} GENCORDIC_FILE;
+
+class	GENCORDIC_MEMSINK : public GENCORDIC_SINK {
+public:
+	std::vector<GENCORDIC_FILE>	m_files;
+
+	void	file(const char *fname, const char *data, size_t len);
+
+	// Returns the file of the given name, or NULL if there's none
+	const GENCORDIC_FILE	*find(const char *fname) const;
+	void	clear(void) { m_files.clear(); }
+};
+
+//
+// gencordic_config_init
+//
+// Fills cfg with gencordic's defaults: a rectangular to polar converter,
+// with reset and aux logic, written to stdout.
+//
+extern	void	gencordic_config_init(GENCORDIC_CONFIG *cfg);
+
+//
+// gencordic_type
+//
+// Looks up the core type named by a -t argument, such as "p2r" or "qtbl",
+// returning false if there's no such type.  If fname is given, it is set to
+// the file name gencordic uses for this type by default.
+//
+extern	bool	gencordic_type(const char *name, GENCORDIC_TYPE *type,
+			const char **fname = NULL);
+
+//
+// gencordic_build
+//
+// Builds the core described by cfg, returning EXIT_SUCCESS or EXIT_FAILURE.
+// A core that can't be built fails before any of its files are opened, and
+// never exits or aborts the calling program.
+// With a sink, nothing is written to disk: every file goes to the sink
+// instead, cfg->cache_dir is ignored, and a NULL cfg->fname names the
+// core after the default for its type.  Several threads may each build a
+// core at the same time.
+//
+extern	int	gencordic_build(const GENCORDIC_CONFIG *cfg,
+			GENCORDIC_SINK *sink = NULL);
+
+#endif	// LIBGENCORDIC_H
@@ -6,7 +6,7 @@
 //
 // Purpose:	This is the main() c++ file for the cordic core generator.
 //		It's primary purpose is to handle argument processing, and
-//	call the specific cordic processing engine.
+//	hand the result to the generator library (libgencordic.h) to build.
 //
 // Creator:	Dan Gisselquist, Ph.D.
 //		Gisselquist Technology, LLC
@@ -44,31 +44,93 @@
 #include <unistd.h>
 #include <ctype.h>
 #include <assert.h>
+#include <pthread.h>
 
-#include "cordiclib.h"
-#include "topolar.h"
-#include "seqpolar.h"
-#include "basiccordic.h"
-#include "seqcordic.h"
-#include "sintable.h"
-#include "quadtbl.h"
+#include "hybridcordic.h"
+#include "explore.h"
+#include "hexfile.h"
+#include "batch.h"
+#include "libgencordic.h"
 
 void	usage(void) {
 	fprintf(stderr,
-"USAGE: gencordic [-ahrv] [-f <fname>] [-i <iw>] [-o <ow>]\n"
-"\t\t[-n <stages>] [-p <phasebits>] [-t <type-of-cordic>] [-x <xtrabits>]\n"
+"USAGE: gencordic [-acFhmrv] [-B <bits>] [-C <cachedir>] [-D <aw>x<bw>]\n"
+"\t\t[-E <engines>] [-f <fname>] [-i <iw>] [-j <threads>] [-k <iters>]\n"
+"\t\t[-K <stages>] [-L <clocks>] [-o <ow>] [-M <formats>] [-n <stages>]\n"
+"\t\t[-p <phasebits>] [-P <lanes>] [-T <channels>] [-t <type-of-cordic>]\n"
+"\t\t[-x <xtrabits>]\n"
+"       gencordic -b <manifest> [-j <threads>]\n"
 "\n"
 "\t-a\t\tCreate an auxilliary bit, useful for tracking logic through\n"
 "\t\t\tthe cordic stages, and knowing when a valid output is ready.\n"
+"\t-b <manifest>\tBuilds every core listed in <manifest>, one set of\n"
+"\t\t\tgencordic arguments per line, several at a time.  Blank\n"
+"\t\t\tlines and anything following a # are ignored.\n"
+"\t-B <bits>\tLimits the sine and cosine tables of an hp2r core to\n"
+"\t\t\t<bits> bits in all.  The table size giving the lowest\n"
+"\t\t\tlatency within this budget is used.  The default is\n"
+"\t\t\t%d bits, one 36Kb block RAM.\n"
 "\t-c\t\tCreate\'s a C-header file containing the numbers of bits the\n"
 "\t\t\tcordic has been built for.\n"
+"\t-C <cachedir>\tKeeps a copy of every core built in <cachedir>, so that\n"
+"\t\t\tbuilding the same core again, with the same gencordic,\n"
+"\t\t\tjust copies it back out.  With this option, files whose\n"
+"\t\t\tcontent hasn\'t changed are never rewritten.\n"
+"\t-D <aw>x<bw>\tSizes the multiplies of a qtbl core to fit within one\n"
+"\t\t\t<aw> by <bw> bit signed multiplier, such as 25x18 for a\n"
+"\t\t\tDSP48E1 or 27x18 for a DSP48E2.  The table grows until\n"
+"\t\t\tits coefficients fit on the wider port, and any phase\n"
+"\t\t\tbits that don\'t fit on the narrower one are dropped.\n"
+"\t-E <engines>\tBuilds an sp2r or sr2p core from <engines> copies of its\n"
+"\t\t\tsequential engine, sharing one pre-rotation, one angle\n"
+"\t\t\ttable, and one output.  Each new sample goes to the next\n"
+"\t\t\tengine in turn, so that o_busy only stays high while\n"
+"\t\t\tthat engine is still working, and the results come out\n"
+"\t\t\tin the order the samples went in.\n"
 "\t-f <fname>\tSets the output filename to <fname>\n"
+"\t-F\t\tGives every channel of a -T core its own phase, kept in\n"
+"\t\t\tdistributed RAM.  i_phase then steps the phase of channel\n"
+"\t\t\ti_chan, and the sample is rotated by its channel's new\n"
+"\t\t\tphase.  This costs one more clock of latency.\n"
 "\t-h\t\tShow this message\n"
 "\t-i <iw>\tSets the input bit-width\n"
+"\t-j <threads>\tSets the number of threads used by -t explore, or the\n"
+"\t\t\tnumber of cores -b builds at once.  The default is one\n"
+"\t\t\tper CPU.\n"
+"\t-k <iters>\tBuilds a p2r or r2p core that accepts one sample at a time,\n"
+"\t\t\tlike sp2r and sr2p, but applies <iters> CORDIC stages\n"
+"\t\t\tper clock.  A sample then takes <stages>/<iters> clocks,\n"
+"\t\t\trounded up, plus two more.  The results match those of the\n"
+"\t\t\tpipelined core.\n"
+"\t-K <stages>\tBuilds a p2r or r2p pipeline that still accepts a sample\n"
+"\t\t\tevery clock, but registers its results only once every\n"
+"\t\t\t<stages> CORDIC stages, chaining <stages> adders within\n"
+"\t\t\teach clock.  The latency drops to the number of stages\n"
+"\t\t\tover <stages>, rounded up, plus two, for no fewer\n"
+"\t\t\tadders.  The results match those of the pipelined core.\n"
+"\t-L <clocks>\tGives each multiply of a qtbl core <clocks> clocks,\n"
+"\t\t\tso that it may use the multiplier\'s own pipeline\n"
+"\t\t\tregisters.  The default is one.  Each clock past the\n"
+"\t\t\tfirst adds two clocks of latency.\n"
+"\t-m\t\tCreates a bit-accurate C++ software model of the core, in a\n"
+"\t\t\theader file named after the core with a _model.h suffix.\n"
+"\t-M <formats>\tAlso writes any tables in each of these (comma separated)\n"
+"\t\t\tformats: bin (raw little-endian binary), coe (Xilinx), or\n"
+"\t\t\tmif (Intel).  The .hex file is always written.\n"
 "\t-n <stages>\tForces the number of cordic stages to <stages>\n"
 "\t-o <ow>\tSets the output bit-width\n"
-"\t-p <pw>\tSets the number of bits in the phase processor\n"
+"\t-p <pw>\tSets the number of bits in the phase processor.  Left\n"
+"\t\t\tunset, a tbl, qtr, or ctbl core gets no more than the\n"
+"\t\t\t23, 25, or 27 bits its table may have\n"
+"\t-P <lanes>\tBuilds a core accepting <lanes> samples per clock, packed\n"
+"\t\t\tinto ports <lanes> times as wide, with the earliest sample\n"
+"\t\t\tin the low order bits.  Only the p2r, r2p, tbl, qtr, and\n"
+"\t\t\tqtbl cores support more than one lane.\n"
 "\t-r\tCreate reset logic in the produced cordic\n"
+"\t-T <channels>\tShares one p2r core between <channels> time\n"
+"\t\t\tmultiplexed channels.  Each sample comes with the number\n"
+"\t\t\tof its channel on i_chan, and that number comes back out\n"
+"\t\t\ton o_chan alongside the sample's result.  See also -F.\n"
 "\t-t <type-of-cordic>\tDetermines which type of logic is created.  Two\n"
 "\t\t\ttypes of cordic\'s are supported:\n"
 "\t\tp2r\tPolar to rectangular.  Given a cmoplex vector, rotate it by\n"
@@ -76,185 +138,228 @@ void	usage(void) {
 "\t\t\twhen I think of a cordic.  You can use this to create sin/cos\n"
 "\t\t\tfunctions, or even to multiply by a complex conjugate.\n"
 "\t\tr2p\tRectangular to polar coordinate conversion\n"
+"\t\thp2r\tAs p2r, but using the top bits of the phase to look up a\n"
+"\t\t\tcoarse rotation in a sine/cosine table, applied with a\n"
+"\t\t\tcomplex multiply, and leaving only the fine stages to\n"
+"\t\t\tthe CORDIC.  See -B.\n"
+"\t\tp2r4\tAs p2r, but each pipeline stage applies two CORDIC stages\n"
+"\t\t\tat once, as one radix-4 digit, for half the latency at the\n"
+"\t\t\tsame precision and gain\n"
+"\t\tr2p4\tAs r2p, but built from the same radix-4 stages as p2r4\n"
 "\t\tqtr\tQuarter-wave table lookup sinewave generator\n"
 "\t\tqtbl\tQuadratically interpolated sinewave generator\n"
+"\t\tctbl\tQuarter-wave sinewave generator, built from a coarse table\n"
+"\t\t\tplus a much smaller fine correction table\n"
 "\t\ttbl\tStraight table lookup sinewave generator\n"
+"\t\texplore\tRather than building a core, predict the CNR, latency,\n"
+"\t\t\tand area of every CORDIC and plain table (tbl, qtr) core\n"
+"\t\t\tthat could be built with the given input and output\n"
+"\t\t\twidths, sweeping any of -x, -p, and -n that aren't given,\n"
+"\t\t\tand write out those designs that no other design beats.\n"
+"\t\t\tThe hp2r, ctbl, and qtbl cores, which size their own\n"
+"\t\t\ttables, are left out.  The result is CSV, or JSON if the\n"
+"\t\t\t-f file name ends in .json\n"
 "\t-v\tTurns on any verbose outputting\n"
 "\t-x <xtrabits>\tUses this many extra bits in rectangular\n"
-"\t\t\tvalue processing\n");
+"\t\t\tvalue processing\n", DEF_ROMBITS);
 }
 
-int	main(int argc, char **argv) {
+// getopt() keeps its state in globals, so only one thread at a time may
+// parse its arguments
+static	pthread_mutex_t	getopt_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static	int	gencordic_line(int argc, char **argv);
+
+//
+// gencordic
+//
+// Builds the one core described by argv, returning an exit code.  Within a
+// batch, several of these run at once, one per worker thread.
+static	int	gencordic(int argc, char **argv, bool in_batch) {
 	const int	DEFAULT_BITWIDTH = 24;
-	int	nstages = -1, iw=-1, ow=-1, nxtra=2, phase_bits=-1, ww;
-	const char	*fname = NULL;
-	bool	with_reset = true, with_aux = true;
-	bool	polar_to_rect = false, rect_to_polar = true, verbose=false,
-		gen_sintable = false, gen_quarterwav = false, c_header = false,
-		gen_quadtbl = false, async_reset = false,
-		sequential = false;
-	int	c;
-	FILE	*fp, *fhp;
+	GENCORDIC_CONFIG	cfg;
+	int	nthreads = 0;
+	const char	*manifest = NULL, *type_fname;
+	bool	design_space = false, fixed_xtra = false;
+	int	c, status = -1;
+
+	gencordic_config_init(&cfg);
 
-	while((c = getopt(argc, argv, "aAcf:hi:n:o:p:Rrt:vx:"))!=-1) {
+	pthread_mutex_lock(&getopt_lock);
+	optind = 1;
+	while((c = getopt(argc, argv, "aAb:B:cC:D:E:f:Fhi:j:k:K:L:mM:n:o:p:P:RrT:t:vx:"))!=-1) {
+		// Once done, getopt() is still run dry, and quietly, so that the
+		// next line of a batch starts parsing afresh
+		if (status >= 0)
+			continue;
 		switch(c) {
 		case 'a':
-			with_aux = true;
+			cfg.with_aux = true;
+			break;
+		case 'b':
+			manifest = strdup(optarg);
 			break;
 		case 'A':
-			async_reset = true;
-			with_reset = true;
+			cfg.async_reset = true;
+			cfg.with_reset = true;
 			break;
+		case 'B':
+			cfg.rom_bits = atoi(optarg);
+			if (cfg.rom_bits < 1) {
+				fprintf(stderr, "ERR: Bad table budget, -B %s\n", optarg);
+				status = EXIT_FAILURE;
+			} break;
 		case 'c':
-			c_header = true;
+			cfg.c_header = true;
+			break;
+		case 'C':
+			cfg.cache_dir = strdup(optarg);
 			break;
+		case 'D':
+			if ((sscanf(optarg, "%dx%d", &cfg.mpy_aw, &cfg.mpy_bw) != 2)
+					||(cfg.mpy_aw < 2)||(cfg.mpy_bw < 2)) {
+				fprintf(stderr, "ERR: Bad multiplier size, -D %s\n", optarg);
+				status = EXIT_FAILURE;
+			} break;
+		case 'E':
+			cfg.nengines = atoi(optarg);
+			if (cfg.nengines < 1) {
+				fprintf(stderr, "ERR: Bad number of engines, -E %s\n", optarg);
+				status = EXIT_FAILURE;
+			} break;
 		case 'f':
-			fname = strdup(optarg);
+			cfg.fname = strdup(optarg);
+			break;
+		case 'F':
+			cfg.phase_acc = true;
 			break;
 		case 'h':
 			usage();
-			exit(EXIT_SUCCESS);
+			status = EXIT_SUCCESS;
 			break;
 		case 'i':
-			iw = atoi(optarg);
+			cfg.iw = atoi(optarg);
+			break;
+		case 'j':
+			nthreads = atoi(optarg);
+			break;
+		case 'k':
+			cfg.iters = atoi(optarg);
+			if (cfg.iters < 1) {
+				fprintf(stderr, "ERR: Bad number of iterations per clock, -k %s\n", optarg);
+				status = EXIT_FAILURE;
+			} break;
+		case 'K':
+			cfg.kstages = atoi(optarg);
+			if (cfg.kstages < 1) {
+				fprintf(stderr, "ERR: Bad number of stages per clock, -K %s\n", optarg);
+				status = EXIT_FAILURE;
+			} break;
+		case 'L':
+			cfg.mpy_delay = atoi(optarg);
+			if (cfg.mpy_delay < 1) {
+				fprintf(stderr, "ERR: Bad multiplier latency, -L %s\n", optarg);
+				status = EXIT_FAILURE;
+			} break;
+		case 'm':
+			cfg.c_model = true;
+			break;
+		case 'M':
+			if (!hextable_formats(optarg))
+				status = EXIT_FAILURE;
+			else
+				cfg.tbl_formats = strdup(optarg);
 			break;
 		case 'n':
-			nstages = atoi(optarg);
+			cfg.nstages = atoi(optarg);
 			break;
 		case 'o':
-			ow = atoi(optarg);
+			cfg.ow = atoi(optarg);
 			break;
 		case 'p':
-			phase_bits = atoi(optarg);
+			cfg.phase_bits = atoi(optarg);
 			break;
+		case 'P':
+			cfg.nlanes = atoi(optarg);
+			if (cfg.nlanes < 1) {
+				fprintf(stderr, "ERR: Bad number of lanes, -P %s\n", optarg);
+				status = EXIT_FAILURE;
+			} break;
 		case 'R':
-			with_reset = false;
+			cfg.with_reset = false;
 			break;
 		case 'r':
-			with_reset = true;
+			cfg.with_reset = true;
 			break;
+		case 'T':
+			cfg.nchannels = atoi(optarg);
+			if (cfg.nchannels < 1) {
+				fprintf(stderr, "ERR: Bad number of channels, -T %s\n", optarg);
+				status = EXIT_FAILURE;
+			} break;
 		case 't':
-			rect_to_polar  = false;
-			polar_to_rect  = false;
-			gen_sintable   = false;
-			gen_quarterwav = false;
-			if (strcmp(optarg, "r2p")==0) {
-				if (fname == NULL)
-					fname = "topolar.v";
-				rect_to_polar = true;
-			} else if (strcmp(optarg, "sr2p")==0) {
-				if (fname == NULL)
-					fname = "seqpolar.v";
-				rect_to_polar = true;
-				sequential    = true;
-			} else if (strcmp(optarg, "p2r")==0) {
-				if (NULL == fname)
-					fname = "basiccordic.v";
-				polar_to_rect = true;
-			} else if (strcmp(optarg, "sp2r")==0) {
-				if (NULL == fname)
-					fname = "seqcordic.v";
-				polar_to_rect = true;
-				sequential = true;
-			} else if (strcmp(optarg, "tbl")==0) {
-				if (NULL == fname)
-					fname = "sintable.v";
-				gen_sintable = true;
-			} else if (strcmp(optarg, "qtr")==0) {
-				if (NULL == fname)
-					fname = "quarterwav.v";
-				gen_quarterwav = true;
-			} else if (strcmp(optarg, "qtbl")==0) {
-				if (NULL == fname)
-					fname = "quadtbl.v";
-				gen_quadtbl = true;
+			if (strcmp(optarg, "explore")==0) {
+				design_space = true;
+			} else if (gencordic_type(optarg, &cfg.type, &type_fname)) {
+				if (NULL == cfg.fname)
+					cfg.fname = type_fname;
 			} else {
 				fprintf(stderr, "ERR: Unsupported cordic mode, %s\n", optarg);
-				exit(EXIT_FAILURE);
+				status = EXIT_FAILURE;
 			} break;
 		case 'v':
-			verbose = true;
+			cfg.verbose = true;
 			break;
 		case 'x':
-			nxtra = atoi(optarg);
+			cfg.nxtra = atoi(optarg);
+			fixed_xtra = true;
 			break;
 		case '?':
 			if (isprint(optopt))
 				fprintf(stderr, "ERR: Unknown option, -%c\n", optopt);
 			else
 				fprintf(stderr, "ERR: Unknown option, 0x%02x\n", optopt);
-			exit(EXIT_FAILURE);
+			status = EXIT_FAILURE;
 			break;
 		default:
 			fprintf(stderr, "ERR: Failed to process arguments\n");
-			exit(EXIT_FAILURE);
+			status = EXIT_FAILURE;
 		}
-	}
+		if (status >= 0)
+			opterr = 0;
+	} opterr = 1;
+	pthread_mutex_unlock(&getopt_lock);
 
-	fhp = NULL;
-	if ((NULL == fname)||(strlen(fname)==0)||(strcmp(fname, "-")==0)) {
-		fp = stdout;
-	} else if (NULL == (fp = fopen(fname, "w"))) {
-		fprintf(stderr, "ERR: Cannot open to %s for writing\n", fname);
-		perror("O/S Err:");
-		exit(EXIT_FAILURE);
-	} else if ((c_header)&&(!gen_sintable)&&(!gen_quarterwav)) {
-		char *strp = strdup(fname);
-		int	slen = strlen(fname);
-		if ((slen>2)&&(strp[slen-1] == 'v')&&(strp[slen-2]=='.')) {
-			strp[slen-1] = 'h';
-			fhp = fopen(strp, "w");
-			if (NULL == fhp)
-				fprintf(stderr, "WARNING: Could not open %s\n", strp);
-		} free(strp);
+	// An iterative core counts through its stages, so it needs at least
+	// two of them.  Should -n be left to its default, gencordic_build()
+	// checks the stages it settles on instead
+	if ((status < 0)&&(cfg.iters > 0)&&(cfg.nstages >= 0)
+			&&(cfg.nstages < 2)
+			&&((cfg.type == GC_P2R)||(cfg.type == GC_R2P))) {
+		fprintf(stderr, "ERR: A core built with -k needs at least 2 CORDIC stages, not -n %d\n", cfg.nstages);
+		status = EXIT_FAILURE;
 	}
 
-	if (polar_to_rect) {
-		if ((iw < 0)&&(ow > 0))
-			iw = ow;
-		if (ow < 0)
-			ow = iw;
-		if ((iw < 0)||(ow < 0)) {
-			fprintf(stderr, "WARNING: Assuming an input and output bit-width of %d bits\n", DEFAULT_BITWIDTH);
-			iw = DEFAULT_BITWIDTH;
-			ow = DEFAULT_BITWIDTH;
-		}
-		ww = (ow > iw) ? ow:iw;
-		nxtra += 1;
-		ww += nxtra;
-		if (phase_bits < 0)
-			phase_bits = calc_phase_bits(ww);
-		if (nstages < 0)
-			nstages = calc_stages(ww, phase_bits);
+	// Within a batch, a bad line fails on its own, leaving the other
+	// workers, and their temporary files, to finish
+	if (status >= 0)
+		return status;
 
-		if (verbose) {
-			printf("Building a %s cordic with the following parameters:\n"
-			"\tOutput file     : %s\n"
-			"\tInput  bits     : %2d\n"
-			"\tExtra  bits     : %2d (used in computation, dropped when done)\n"
-			"\tOutput bits     : %2d\n"
-			"\tPhase  bits     : %2d\n"
-			"\tNumber of stages: %2d\n",
-			(sequential)?"sequential":"basic",
-			(fp == stdout)?"(stdout)":fname,
-			iw, nxtra, ow, phase_bits, nstages);
-			if ((with_reset)&&(async_reset))
-				printf("\tDesign will include an async reset signal\n");
-			else if (with_reset)
-				printf("\tDesign will include a reset signal\n");
-			if (with_aux)
-				printf("\tAux bits will be added to the design\n");
-		}
+	if ((NULL != manifest)&&(in_batch)) {
+		fprintf(stderr, "ERR: A manifest may not list another manifest\n");
+		return EXIT_FAILURE;
+	} else if (NULL != manifest)
+		return batch(manifest, nthreads, gencordic_line);
+
+	if (design_space) {
+		const char	*fname = cfg.fname;
+		int	iw = cfg.iw, ow = cfg.ow, slen;
+		FILE	*fp;
 
-		if (sequential)
-			seqcordic(fp, fhp, fname,
-				nstages, iw, ow, nxtra, phase_bits,
-				with_reset, with_aux, async_reset);
-		else
-			basiccordic(fp, fhp, fname,
-				nstages, iw, ow, nxtra, phase_bits,
-				with_reset, with_aux, async_reset);
-	} if (rect_to_polar) {
+		if ((cfg.nlanes > 1)||(cfg.iters > 0)||(cfg.kstages > 1)
+				||(cfg.nengines > 1)||(cfg.nchannels > 1))
+			fprintf(stderr, "WARNING: The design space explorer only "
+				"considers pipelined cores.  Ignoring -P, -k, -K, -E, and -T\n");
 		if ((iw < 0)&&(ow > 0))
 			iw = ow;
 		if (ow < 0)
@@ -263,154 +368,36 @@ int	main(int argc, char **argv) {
 			fprintf(stderr, "WARNING: Assuming an input and output bit-width of %d bits\n", DEFAULT_BITWIDTH);
 			iw = DEFAULT_BITWIDTH;
 			ow = DEFAULT_BITWIDTH;
-		} ww = (ow > iw) ? ow:iw;
-		nxtra += 2;
-		ww += nxtra;
-		if (phase_bits < 0)
-			phase_bits = calc_phase_bits(ww);
-		if (nstages < 0)
-			nstages = calc_stages(phase_bits);
-		if (verbose) {
-			printf("Building a rectangular-to-polar CORDIC converter with the\nfollowing parameters:\n"
-			"\tOutput file     : %s\n"
-			"\tInput  bits     : %2d\n"
-			"\tExtra  bits     : %2d (used in computation, dropped when done)\n"
-			"\tOutput bits     : %2d\n"
-			"\tPhase  bits     : %2d\n"
-			"\tNumber of stages: %2d\n",
-			(fp == stdout)?"(stdout)":fname,
-			iw, nxtra, ow, phase_bits, nstages);
-			if (with_reset)
-				printf("\tDesign will include a reset signal\n");
-			if (with_aux)
-				printf("\tAux bits will be added to the design\n");
 		}
 
-		if (sequential)
-			seqpolar(fp, fhp, fname,
-				nstages, iw, ow, nxtra, phase_bits,
-				with_reset, with_aux, async_reset);
-		else
-			topolar(fp, fhp, fname,
-				nstages, iw, ow, nxtra, phase_bits,
-				with_reset, with_aux, async_reset);
-	} if (gen_sintable) {
-		if ((iw >= 0)&&(phase_bits < 0)) {
-			phase_bits = iw;
-			iw = -1;
-		}
-		if (iw >= 0)
-			fprintf(stderr, "WARNING: Input width parameter, -i %d, ignored for sine table generation\n", iw);
-		if ((phase_bits > 3)&&(ow < 0)) {
-			for(int k=phase_bits-2; k<phase_bits + 3; k++) {
-				int	pb;
-				pb = calc_phase_bits(k);
-				if (pb == phase_bits) {
-					ow = k;
-					break;
-				}
-			}
-		} if (ow < 0) {
-			fprintf(stderr, "WARNING: Assuming an output bit-width of %d bits\n", DEFAULT_BITWIDTH);
-			ow = DEFAULT_BITWIDTH;
-		} if (phase_bits < 0)
-			phase_bits = calc_phase_bits(ow);
-		if (verbose) {
-			printf("Building a Sinewave table lookup with the following parameters:\n"
-			"\tOutput file     : %s\n"
-			"\tInput  bits     : %2d\n"
-			"\tPhase  bits     : %2d\n"
-			"\tOutput bits     : %2d\n",
-			(fp == stdout)?"(stdout)":fname,
-			phase_bits, phase_bits, ow);
-			if ((with_reset)&&(async_reset))
-				printf("\tDesign will include an async reset signal\n");
-			else if (with_reset)
-				printf("\tDesign will include a reset signal\n");
-			if (with_aux)
-				printf("\tAux bits will be added to the design\n");
-		}
+		if ((NULL == fname)||(strlen(fname)==0)||(strcmp(fname, "-")==0)) {
+			fp = stdout;
+			slen = 0;
+		} else if (NULL == (fp = fopen(fname, "w"))) {
+			fprintf(stderr, "ERR: Cannot open to %s for writing\n", fname);
+			perror("O/S Err:");
+			return EXIT_FAILURE;
+		} else
+			slen = strlen(fname);
 
-		sintable(fp, fname, phase_bits, ow, with_reset, with_aux, async_reset);
-	} if (gen_quarterwav) {
-		if ((iw >= 0)&&(phase_bits < 0)) {
-			phase_bits = iw;
-			iw = -1;
-		}
-		if (iw >= 0)
-			fprintf(stderr, "WARNING: Input width parameter, -i %d, ignored for sine table generation\n", iw);
-		if ((phase_bits > 3)&&(ow < 0)) {
-			for(int k=phase_bits-2; k<phase_bits + 3; k++) {
-				int	pb;
-				pb = calc_phase_bits(k);
-				if (pb == phase_bits) {
-					ow = k;
-					break;
-				}
-			}
-		} if (ow < 0) {
-			fprintf(stderr, "WARNING: Assuming an output bit-width of %d bits\n", DEFAULT_BITWIDTH);
-			ow = DEFAULT_BITWIDTH;
-		} if (phase_bits < 0)
-			phase_bits = calc_phase_bits(ow);
-		if (verbose) {
-			printf("Building a Sinewave table lookup with the following parameters:\n"
-			"\tOutput file     : %s\n"
-			"\tInput  bits     : %2d\n"
-			"\tPhase  bits     : %2d\n"
-			"\tOutput bits     : %2d\n",
-			(fp == stdout)?"(stdout)":fname,
-			phase_bits, phase_bits, ow);
-			if ((with_reset)&&(async_reset))
-				printf("\tDesign will include an async reset signal\n");
-			else if (with_reset)
-				printf("\tDesign will include a reset signal\n");
-			if (with_aux)
-				printf("\tAux bits will be added to the design\n");
-		}
+		if (cfg.verbose)
+			fprintf(stderr, "Exploring the design space for %d input "
+				"bits and %d output bits\n", iw, ow);
+		explore(fp, (slen > 5)&&(strcmp(&fname[slen-5], ".json")==0),
+			iw, ow, (fixed_xtra) ? cfg.nxtra : -1, cfg.nstages,
+			cfg.phase_bits, nthreads);
+		if (fp != stdout)
+			fclose(fp);
+		return EXIT_SUCCESS;
+	}
 
-		quarterwav(fp, fname, phase_bits, ow, with_reset, with_aux, async_reset);
-	} if (gen_quadtbl) {
-		if ((iw < 0)&&(ow > 0))
-			iw = ow;
-		if (ow < 0)
-			ow = iw;
-		if ((iw < 0)||(ow < 0)) {
-			fprintf(stderr, "WARNING: Assuming an input and output bit-width of %d bits\n", DEFAULT_BITWIDTH);
-			iw = DEFAULT_BITWIDTH;
-			ow = DEFAULT_BITWIDTH;
-		}
-		ww = (ow > iw) ? ow:iw;
-		nxtra += 1;
-		ww += nxtra;
-		if (phase_bits < 0)
-			phase_bits = calc_phase_bits(ww);
-		if (nstages < 0)
-			nstages = calc_stages(ww, phase_bits);
+	return gencordic_build(&cfg);
+}
 
-		if (verbose) {
-			printf("Building a quadratically interpolated table based sine-wave calculator\n"
-			"\tOutput file     : %s\n"
-			// "\tInput  bits     : %2d\n"
-			"\tExtra  bits     : %2d (used in computation, dropped when done)\n"
-			"\tOutput bits     : %2d\n"
-			"\tPhase  bits     : %2d\n",
-			// "\tNumber of stages: %2d\n",
-			(fp == stdout)?"(stdout)":fname, // iw,
-			nxtra, ow, phase_bits);
-			if ((with_reset)&&(async_reset))
-				printf("\tDesign will include an async reset signal\n");
-			else if (with_reset)
-				printf("\tDesign will include a reset signal\n");
-			if (with_aux)
-				printf("\tAux bits will be added to the design\n");
-		}
+static	int	gencordic_line(int argc, char **argv) {
+	return gencordic(argc, argv, true);
+}
 
-		/*
-		basiccordic(fp, fhp, fname,
-			nstages, iw, ow, nxtra, phase_bits,
-			with_reset, with_aux);
-		*/
-		quadtbl(fp, fhp, fname, phase_bits, ow, nxtra, with_reset, with_aux, async_reset);
-	}
+int	main(int argc, char **argv) {
+	return gencordic(argc, argv, false);
 }
@@ -42,11 +42,17 @@
 #include <string.h>
 #include <ctype.h>
 #include <assert.h>
+#include <float.h>
+#include <unistd.h>
+#include <pthread.h>
 
 #include "legal.h"
 #include "cordiclib.h"
 #include "quadtbl.h"
 #include "hexfile.h"
+#include "swmodel.h"
+#include "lanes.h"
+#include "estimate.h"
 
 static	const	bool	NO_QUADRATIC_COMPONENT = false;
 
@@ -61,49 +67,316 @@ static	long	max_integer(const int width) {
 
 typedef	std::string	STRING;
 
-/*
- * x = xo + dx
- * er = TBL.c[xo]+(TBL.l[xo]+TBL.q[xo] * dx) * dx - sin(2PI(xo+dx)/N)
- * der/ddx = TBL.l[xo]+2TBL.q[xo] * dx - 2PI/N cos(2PI(xo+dx)/N)
- */
-double	est_max_err(double c, double l, double q, double idx, int N) {
-	double	lft, rht, mid, ph;
-
-	ph = 2.0 * M_PI * idx / (double)N;
-	lft = c - sin(ph);
-	ph = 2.0 * M_PI * (idx+1) / (double)N;
-	rht = c + l + q - sin(ph);
-
-
-	// 
-	// The following is very brute force-ish.  It doesn't need to be.
-	// For large N, a sine-wave is *very* well behaved.  Brent's algorithm
-	// might make more sense here, *and* get us a better answer faster.
-	// This just gets me by until I look brents algorithm up in a text book
-	// (again).
-	//
-	mid = 0;
-	for(int k=0; k<64; k++) {
-		double	mer = 0.0, mph, mdx;
-
-		mdx = k / 64.0;
-		mph = 2.0*M_PI*(idx + mdx)/N;
-		mer = c + (l + q * mdx) * mdx - sin(mph);
-
-		if (fabs(mer) > fabs(mid))
-			mid = mer;
+//
+// Each table segment, idx, approximates sin(2PI(idx+dx)/N) for 0 <= dx < 1
+// with the quadratic c + (l + q * dx) * dx.  The error of this
+// approximation, and its derivative, are then
+//
+// er = c+(l+q * dx) * dx - sin(2PI(idx+dx)/N)
+// der/ddx = l+2q * dx - 2PI/N cos(2PI(idx+dx)/N)
+//
+typedef	struct	{
+	double	c, l, q, ph, dph;
+} QUADSEG;
+
+static	double	seg_err(const QUADSEG *s, double dx) {
+	return s->c + (s->l + s->q * dx) * dx - sin(s->ph + s->dph * dx);
+}
+
+static	double	seg_derr(const QUADSEG *s, double dx) {
+	return s->l + 2.0 * s->q * dx - s->dph * cos(s->ph + s->dph * dx);
+}
+
+//
+// seg_extremum
+//
+// Uses Brent's method to find the root of the error's derivative, and hence
+// the location of an extremum of the error, between a and b.  fa and fb are
+// the derivative at a and b, and must differ in sign.
+//
+static	double	seg_extremum(const QUADSEG *s, double a, double b,
+			double fa, double fb) {
+	const	double	TOL = 1e-10;
+	double	c = a, fc = fa, d = b-a, e = d;
+
+	for(int iter=0; iter<100; iter++) {
+		double	tol, m, p, q, r, t;
+
+		if ((fb > 0) == (fc > 0)) {
+			c = a; fc = fa; d = e = b-a;
+		} if (fabs(fc) < fabs(fb)) {
+			a = b; b = c; c = a;
+			fa = fb; fb = fc; fc = fa;
+		}
+
+		tol = 2.0 * DBL_EPSILON * fabs(b) + TOL;
+		m = 0.5 * (c - b);
+		if ((fabs(m) <= tol)||(fb == 0.0))
+			break;
+
+		if ((fabs(e) < tol)||(fabs(fa) <= fabs(fb))) {
+			// Bisect
+			d = e = m;
+		} else {
+			// Try interpolating, either linearly or with an
+			// inverse quadratic
+			t = fb / fa;
+			if (a == c) {
+				p = 2.0 * m * t;
+				q = 1.0 - t;
+			} else {
+				q = fa / fc;
+				r = fb / fc;
+				p = t * (2.0*m*q*(q-r) - (b-a)*(r-1.0));
+				q = (q-1.0) * (r-1.0) * (t-1.0);
+			}
+
+			if (p > 0)
+				q = -q;
+			else
+				p = -p;
+			if ((2.0*p < 3.0*m*q-fabs(tol*q))&&(p < fabs(0.5*e*q))) {
+				e = d;
+				d = p / q;
+			} else {
+				d = e = m;
+			}
+		}
+
+		a = b; fa = fb;
+		if (fabs(d) > tol)
+			b += d;
+		else
+			b += (m > 0) ? tol : -tol;
+		fb = seg_derr(s, b);
+	}
+
+	return b;
+}
+
+//
+// seg_extrema
+//
+// Finds the locations of the error's extrema within (0,1), returning how
+// many were found.  For any reasonable table size, the error is very nearly
+// a cubic, having no more than two such extrema, so we only ever look for
+// that many.  The derivative is first sampled to bracket each root, then
+// each bracket is handed to Brent's method.
+//
+static	int	seg_extrema(const QUADSEG *s, double *ext) {
+	const	int	NSAMPLES = 8;
+	double	lst, fl, fr;
+	int	next = 0;
+
+	lst = 0.0;
+	fl  = seg_derr(s, 0.0);
+	for(int k=1; (k<=NSAMPLES)&&(next < 2); k++) {
+		double	rt = k / (double)NSAMPLES;
+
+		fr = seg_derr(s, rt);
+		if ((fl == 0.0)&&(k > 1))
+			ext[next++] = lst;
+		else if ((fl > 0.0) != (fr > 0.0))
+			ext[next++] = seg_extremum(s, lst, rt, fl, fr);
+		lst = rt;
+		fl  = fr;
 	}
 
-	double	er;
-	er = lft;
-	if (fabs(er) < fabs(rht))
-		er = rht;
+	return next;
+}
+
+//
+// est_max_err
+//
+// Returns the largest error of one table segment, found by checking both
+// the end points and any extrema in between.
+//
+double	est_max_err(double c, double l, double q, double idx, int N) {
+	QUADSEG	s;
+	double	ext[2], er, mid;
+	int	next;
+
+	s.c = c; s.l = l; s.q = q;
+	s.ph  = 2.0 * M_PI * idx / (double)N;
+	s.dph = 2.0 * M_PI / (double)N;
+
+	er = seg_err(&s, 0.0);
+	mid = seg_err(&s, 1.0);
 	if (fabs(er) < fabs(mid))
 		er = mid;
 
+	next = seg_extrema(&s, ext);
+	for(int k=0; k<next; k++) {
+		mid = seg_err(&s, ext[k]);
+		if (fabs(er) < fabs(mid))
+			er = mid;
+	}
+
 	return er;
 }
 
+//
+// minimax_segment
+//
+// Finds the quadratic that minimizes the maximum error across one table
+// segment, using the Remez exchange algorithm.  The reference starts at the
+// extrema of the third order Chebyshev polynomial, which is nearly the
+// answer already, so this rarely takes more than two or three passes.
+//
+static	void	minimax_segment(double idx, int N, double &c, double &l,
+			double &q) {
+	const	int	MAXPASSES = 8;
+	double	ref[4] = { 0.0, 0.25, 0.75, 1.0 }, lsterr = 0.0;
+	QUADSEG	s;
+
+	s.ph  = 2.0 * M_PI * idx / (double)N;
+	s.dph = 2.0 * M_PI / (double)N;
+
+	for(int pass=0; pass<MAXPASSES; pass++) {
+		double	A[4][5], ext[2], mxerr;
+
+		// Solve for c + l t + q t^2 + (-1)^k E = sin(ph + dph t) at
+		// each of our four reference points, via Gaussian
+		// elimination with partial pivoting
+		for(int k=0; k<4; k++) {
+			A[k][0] = 1.0;
+			A[k][1] = ref[k];
+			A[k][2] = ref[k] * ref[k];
+			A[k][3] = (k&1) ? -1.0 : 1.0;
+			A[k][4] = sin(s.ph + s.dph * ref[k]);
+		}
+
+		for(int k=0; k<4; k++) {
+			int	pv = k;
+
+			for(int j=k+1; j<4; j++)
+				if (fabs(A[j][k]) > fabs(A[pv][k]))
+					pv = j;
+			if (pv != k)
+				for(int j=0; j<5; j++) {
+					double	tmp = A[k][j];
+					A[k][j] = A[pv][j];
+					A[pv][j] = tmp;
+				}
+			for(int j=k+1; j<4; j++) {
+				double	f = A[j][k] / A[k][k];
+				for(int i=k; i<5; i++)
+					A[j][i] -= f * A[k][i];
+			}
+		}
+
+		for(int k=3; k>=0; k--) {
+			for(int j=k+1; j<4; j++)
+				A[k][4] -= A[k][j] * A[j][4];
+			A[k][4] /= A[k][k];
+		}
+
+		s.c = A[0][4];
+		s.l = A[1][4];
+		s.q = A[2][4];
+
+		// Exchange our reference for the extrema of this new error
+		if (2 != seg_extrema(&s, ext))
+			break;
+		ref[1] = ext[0];
+		ref[2] = ext[1];
+
+		mxerr = fabs(seg_err(&s, 0.0));
+		for(int k=1; k<4; k++)
+			if (fabs(seg_err(&s, ref[k])) > mxerr)
+				mxerr = fabs(seg_err(&s, ref[k]));
+		// Quit once the error levels out, or once it's lost in the
+		// rounding noise of sin() itself
+		if ((fabs(mxerr - lsterr) <= 1e-3 * mxerr)
+				||(mxerr < 64.0 * DBL_EPSILON))
+			break;
+		lsterr = mxerr;
+	}
+
+	c = s.c;
+	l = s.l;
+	q = s.q;
+}
+
+//
+// Segments are fit in parallel across this many threads, so long as the
+// table has at least QUADTBL_MIN_PARALLEL entries.  For smaller tables it's
+// faster to just do the work than to start the threads.
+//
+static	const	int	QUADTBL_MIN_PARALLEL = 1024;
+
+typedef	struct	{
+	double	*table, *slope, *dslope, *err;
+	int	first, last, ln;
+	bool	fit;
+} QUADTBL_WORK;
+
+static	void	*quadtbl_worker(void *arg) {
+	QUADTBL_WORK	*w = (QUADTBL_WORK *)arg;
+
+	for(int i=w->first; i<w->last; i++) {
+		if (w->fit)
+			minimax_segment(i, w->ln, w->table[i],
+				w->slope[i], w->dslope[i]);
+		else
+			w->err[i] = est_max_err(w->table[i], w->slope[i],
+				w->dslope[i], i, w->ln);
+	}
+
+	return NULL;
+}
+
+//
+// quadtbl_segments
+//
+// Either fits (if fit is true) or measures the error of every segment in
+// the table, splitting the segments evenly amongst a set of threads.
+//
+static	void	quadtbl_segments(bool fit, int ln, double *table,
+			double *slope, double *dslope, double *err) {
+	int	nthreads = 1;
+	QUADTBL_WORK	*work;
+	pthread_t	*threads;
+
+	if (ln >= QUADTBL_MIN_PARALLEL)
+		nthreads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+	if (nthreads < 1)
+		nthreads = 1;
+
+	work    = new QUADTBL_WORK[nthreads];
+	threads = new pthread_t[nthreads];
+	for(int k=0; k<nthreads; k++) {
+		work[k].table  = table;
+		work[k].slope  = slope;
+		work[k].dslope = dslope;
+		work[k].err    = err;
+		work[k].ln     = ln;
+		work[k].fit    = fit;
+		work[k].first  = (int)((long)ln *  k    / nthreads);
+		work[k].last   = (int)((long)ln * (k+1) / nthreads);
+	}
+
+	if (nthreads == 1)
+		quadtbl_worker(&work[0]);
+	else {
+		int	nstarted;
+
+		// Should we run out of threads, whatever work is left gets
+		// done right here instead
+		for(nstarted=0; nstarted<nthreads; nstarted++)
+			if (0 != pthread_create(&threads[nstarted], NULL,
+					quadtbl_worker, &work[nstarted]))
+				break;
+		for(int k=nstarted; k<nthreads; k++)
+			quadtbl_worker(&work[k]);
+		for(int k=0; k<nstarted; k++)
+			pthread_join(threads[k], NULL);
+	}
+
+	delete[] threads;
+	delete[] work;
+}
+
 double	quadtbl_spur(int lgtbl) {
 	double	spur_magnitude;
 	spur_magnitude = pow(sinc(1.0-(1./(1<<lgtbl))),3.);
@@ -122,88 +395,110 @@ int	pick_tbl_size(int ww) {
 	} return 11;
 }
 
-void	build_quadtbls(const char *fname, const int lgsz, const int wid,
-		int &cbits, int &lbits, int &qbits, double &tblerr) {
-	int	tbl_entries = (1<<lgsz);
-	long	maxv = max_integer(wid);
-	double	dl = M_PI / (double)tbl_entries, dph= dl * 2.;
-	// double	scl = pow(sinc(1./tbl_entries),3);
-	long	*tbldata = new long[tbl_entries];
-	STRING	name;
-
-	assert(lgsz > 2);
-	assert(wid > 6);
+//
+// QUADFIT
+//
+// The minimax fit of every segment of a table of 2^lgsz entries, scaled to
+// fit within +/- 1, together with its largest error.  None of this depends
+// upon the width of the table, so once made a fit is kept, and shared by
+// every table of the same size--including those of other cores being built
+// at the same time, in a batch.
+typedef	struct	QUADFIT_S {
+	int		lgsz;
+	double		*table, *slope, *dslope, mxerr;
+	pthread_mutex_t	lock;	// Held while the fit is being made
+	struct QUADFIT_S	*next;
+} QUADFIT;
+
+static	QUADFIT		*quadfits = NULL;
+static	pthread_mutex_t	quadfit_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static	const QUADFIT	*quadtbl_fit(const int lgsz) {
+	QUADFIT	*f;
+
+	pthread_mutex_lock(&quadfit_lock);
+	for(f = quadfits; (f)&&(f->lgsz != lgsz); f = f->next)
+		;
+	if (NULL == f) {
+		f = new QUADFIT;
+		f->lgsz   = lgsz;
+		f->table  = NULL;
+		f->slope  = NULL;
+		f->dslope = NULL;
+		f->mxerr  = 0.0;
+		pthread_mutex_init(&f->lock, NULL);
+		f->next   = quadfits;
+		quadfits  = f;
+	} pthread_mutex_unlock(&quadfit_lock);
+
+	// Anyone else wanting this same fit waits here until it's made
+	pthread_mutex_lock(&f->lock);
+	if (NULL != f->table) {
+		pthread_mutex_unlock(&f->lock);
+		return f;
+	}
 
-	int	ln = tbl_entries;
+	int	ln = (1<<lgsz);
 	double	*table  = new double[ln];
 	double	*slope  = new double[ln];
 	double	*dslope = new double[ln];
 
-	// The base value, or constant term
-	for(int i=0; i<ln; i++)
-		table[i] = sin(dph * i + dl);
-
-	// The slope, or linear term
-	for(int i=1; i<ln-1; i++)
-		slope[i] = (table[i+1]-table[i-1])/2.0;
-	slope[0   ] = (table[1]-table[ln-1])/2.0;
-	slope[ln-1] = (table[0]-table[ln-2])/2.0;
-
-	// The quadratic term
-	for(int i=1; i<ln-1; i++)
-		dslope[i] = -(table[i]- 0.5*(table[i+1]+table[i-1]));
-	dslope[0   ] = -(table[0   ]-0.5*(table[1]+table[ln-1]));
-	dslope[ln-1] = -(table[ln-1]-0.5*(table[0]+table[ln-2]));
-
-	// Oops -- gotta adjust the base term again, creating the
-	// result you would get after filtering this with our
-	// quadratic.
-	for(int i=0; i<ln; i++)
-		table[i] = 0.75 * sin(dph*i+dl)
-			+ ( sin(dph*(i-1)+dl)
-			+   sin(dph*(i+1)+dl))/8.0;
-
-	// Now, shuffle this quadratic so that we can interpolate from
-	// the end, rather than the middle.
-	//
-	// Our current values and points provide us with
-	//      y(t) = a(t-del/2)^2 + b(t-del/2) + c
-	//              = at^2 + (b- a*del)t+ (a del^2/4 - b del/2 + c)
-	// const        double  del = 1.0 / (double)ln;
-	const   double  del = 1.0;
-	const   double  hlfdel = del / 2.0;
-	for(int i=0; i<ln; i++)
-		table[i] = dslope[i] * hlfdel * hlfdel
-				- slope[i] * hlfdel + table[i];
-	for(int i=0; i<ln; i++)
-		slope[i] = slope[i] - del * dslope[i];
-
-
-	// Next, adjust our magnitudes, so that we'll average an
-	// unscaled sine wave
-	double fctr = pow(1./sinc(dl),3);
-	for(int i=0; i<ln; i++)	table[i]  *= fctr;
-	for(int i=0; i<ln; i++)	slope[i]  *= fctr;
-	for(int i=0; i<ln; i++)	dslope[i] *= fctr;
+	// Fit each segment of the table with its own minimax quadratic
+	quadtbl_segments(true, ln, table, slope, dslope, NULL);
 
-	// Double check that we are still within bounds
-	double	mxtbl = 0.0, mxslope = 0.0, mxdslope = 0.0;
+	double	mxtbl = 0.0;
 
+	// The constant term can overshoot one by as much as the fit error.
+	// If it does, scale it back down so it still fits in our table.
+	// This lowers the gain by as much as the fit error as well, about
+	// 0.06 LSB at the output of the default 24-bit core.
 	for(int i=0; i<ln; i++)
 		mxtbl = (mxtbl >fabs( table[i]))?mxtbl : fabs(table[i]);
-	for(int i=0; i<ln; i++)
-		table[i]  *= 1./mxtbl;
-	for(int i=0; i<ln; i++)
-		slope[i]  *= 1./mxtbl;
-	for(int i=0; i<ln; i++)
-		dslope[i] *= 1./mxtbl;
+	if (mxtbl > 1.0) {
+		for(int i=0; i<ln; i++)
+			table[i]  *= 1./mxtbl;
+		for(int i=0; i<ln; i++)
+			slope[i]  *= 1./mxtbl;
+		for(int i=0; i<ln; i++)
+			dslope[i] *= 1./mxtbl;
+	}
+
+	double	mxerr = 0.0, *err = new double[ln];
 
-	double	mxerr = 0.0, err;
+	quadtbl_segments(false, ln, table, slope, dslope, err);
 	for(int i=0; i<ln; i++) {
-		err = est_max_err(table[i], slope[i], dslope[i], i, ln);
-		if (fabs(err) > fabs(mxerr))
-			mxerr = err;
+		if (fabs(err[i]) > fabs(mxerr))
+			mxerr = err[i];
 	}
+	delete[] err;
+
+	f->slope  = slope;
+	f->dslope = dslope;
+	f->mxerr  = mxerr;
+	f->table  = table;
+	pthread_mutex_unlock(&f->lock);
+	return f;
+}
+
+void	build_quadtbls(const char *fname, const int lgsz, const int wid,
+		int &cbits, int &lbits, int &qbits, double &tblerr,
+		long *ctbl, long *ltbl, long *qtbl) {
+	int	tbl_entries = (1<<lgsz);
+	long	maxv = max_integer(wid);
+	long	*tbldata = new long[tbl_entries];
+	STRING	name;
+
+	assert(lgsz > 2);
+	assert(wid > 6);
+
+	const	QUADFIT	*fit = quadtbl_fit(lgsz);
+	const	int	ln = tbl_entries;
+	const	double	*table = fit->table, *slope = fit->slope,
+			*dslope = fit->dslope;
+	double	mxerr = fit->mxerr;
+
+	// Double check that we are still within bounds
+	double	mxtbl = 0.0, mxslope = 0.0, mxdslope = 0.0;
 
 	printf("MXERR = %f * %ld (0x%08lx)\n", mxerr, maxv, maxv);
 	mxerr *= maxv;
@@ -236,46 +531,294 @@ void	build_quadtbls(const char *fname, const int lgsz, const int wid,
 
 	for(int k=0; k<tbl_entries; k++)
 		tbldata[k] = (long)(maxv * table[k]);
+	if (NULL != ctbl)
+		memcpy(ctbl, tbldata, sizeof(long)*tbl_entries);
 
 	name = STRING(fname) + STRING("_ctbl");
 	hextable(name.c_str(), lgsz, cbits, tbldata);
 
 	for(int k=0; k<tbl_entries; k++)
 		tbldata[k] = (long)(maxv * slope[k]);
+	if (NULL != ltbl)
+		memcpy(ltbl, tbldata, sizeof(long)*tbl_entries);
 
 	name = STRING(fname) + STRING("_ltbl");
 	hextable(name.c_str(), lgsz, lbits, tbldata);
 
 	for(int k=0; k<tbl_entries; k++)
 		tbldata[k] = (long)(maxv * dslope[k]);
+	if (NULL != qtbl)
+		memcpy(qtbl, tbldata, sizeof(long)*tbl_entries);
 
 	name = STRING(fname) + STRING("_qtbl");
 	hextable(name.c_str(), lgsz, qbits, tbldata);
 
-	delete[] table;
-	delete[] slope;
-	delete[] dslope;
 	delete[] tbldata;
 }
 
+//
+// quadtbl_fits
+//
+// Returns true if both multiplies of the interpolant fit within one
+// aw x bw multiplier, such as a DSP slice.  The coefficients (Q, and L plus
+// the quadratic correction) go on the wider of the two ports, aw, and dx on
+// the narrower one.  dx may be cut down to bw bits, dropping phase bits, but
+// only so long as the phase bits that remain, lgtbl+bw-1 of them, still
+// resolve the sine wave to within a quarter of an output LSB.  That error is
+// as much as PI * 2^(ow-(lgtbl+bw-1)) LSBs.  With no multiplier given (aw ==
+// 0), everything fits.
+static	bool	quadtbl_fits(int aw, int bw, int ow, int phase_bits,
+		int lgtbl, int lbits, int qbits) {
+	int	dxbits = phase_bits - lgtbl + 1;
+
+	if (aw <= 0)
+		return true;
+	if ((lbits > aw)||(qbits > aw))
+		return false;
+	if ((dxbits > bw)&&(lgtbl + bw - 1 < ow + 4))
+		return false;
+	return true;
+}
+
+//
+// dx_params
+//
+// Writes out the DXBITS parameter, and, when the low order phase bits have
+// been dropped to fit dx into the multiplier, the DXLSB parameter noting how
+// many.
+static	void	dx_params(FILE *fp, int dxlsb, int dxbits) {
+	if (dxlsb > 0)
+		fprintf(fp,
+			"\t\t\tDXLSB = %d,\t// Phase bits dropped to fit the multiplier\n"
+			"\t\t\tDXBITS= (PW-LGTBL-DXLSB)+1, // %d\n",
+			dxlsb, dxbits);
+	else
+		fprintf(fp,
+			"\t\t\tDXBITS= (PW-LGTBL)+1,    // %d\n", dxbits);
+}
+
+//
+// delay_chain
+//
+// Writes out n more registers following src, named src_d1 through src_dn,
+// so that src arrives alongside a product taking n clocks longer than it
+// otherwise would.  Returns the name of the last register, or src itself if
+// there are none.
+static	std::string	delay_chain(FILE *fp, const std::string &always_reset,
+		bool with_reset, const char *width, const char *src, int n) {
+	std::string	last = src;
+	char		name[64];
+
+	if (n < 1)
+		return last;
+
+	fprintf(fp, "\treg\tsigned\t%s\t", width);
+	for(int k=1; k<=n; k++)
+		fprintf(fp, "%s%s_d%d", (k>1) ? ", ":"", src, k);
+	fprintf(fp, ";\n");
+	for(int k=1; k<=n; k++)
+		fprintf(fp, "\tinitial\t%s_d%d = 0;\n", src, k);
+
+	fprintf(fp, "%s", always_reset.c_str());
+	if (with_reset) {
+		fprintf(fp, "\tbegin\n");
+		for(int k=1; k<=n; k++)
+			fprintf(fp, "\t\t%s_d%d <= 0;\n", src, k);
+		fprintf(fp, "\tend else ");
+	}
+
+	fprintf(fp, "if (i_ce) begin\n");
+	for(int k=1; k<=n; k++) {
+		snprintf(name, sizeof(name), "%s_d%d", src, k);
+		fprintf(fp, "\t\t%s <= %s;\n", name, last.c_str());
+		last = name;
+	}
+	fprintf(fp, "\tend\n\n");
+
+	return last;
+}
+
+//
+// quadtbl_lanes
+//
+// Writes out the module taking nlanes phases per clock.  This module reads
+// the tables, on clock zero, and hands what it reads to one copy of the
+// interpolating lane per phase.  Each copy of the tables is read from both
+// of its ports, so one copy serves two lanes.
+static	void	quadtbl_lanes(FILE *fp, const char *name, const char *lane,
+		int nlanes, int phase_bits, int ow, int nxtra, int lgtbl,
+		int dxlsb, int qbits, int lbits, int cbits, int nstages,
+		bool with_reset, bool with_aux, bool async_reset) {
+	std::string	resetw = (!with_reset) ? ""
+			: (async_reset) ? "i_areset_n" : "i_reset";
+
+	fprintf(fp,
+		"\n\n"
+		"//\n"
+		"// %s\n"
+		"//\n"
+		"// %d copies of %s, so as to accept %d phases per clock.  Phase k\n"
+		"// of each clock is found in i_phase[k*PW +: PW], and its result in\n"
+		"// o_sin[k*OW +: OW].  Phase zero is the earliest.\n"
+		"//\n"
+		"module	%s(i_clk, %s%si_ce, %si_phase, o_sin%s);\n"
+		"\tlocalparam\tNLANES=%2d,// Phases per clock\n"
+		"\t\t\tNTBLS =%2d,// Copies of the tables\n"
+		"\t\t\tPW=%2d,\t// Bits in our phase variable\n"
+		"\t\t\tOW=%2d;  // The number of output bits to produce\n"
+		"\tinput\twire\t\t\t\ti_clk, %s%si_ce%s;\n"
+		"\t//\n"
+		"%s"
+		"\tinput\twire\t[(NLANES*PW-1):0]\ti_phase;\n"
+		"%s"
+		"\toutput\twire\t[(NLANES*OW-1):0]\to_sin;\n",
+		name, nlanes, lane, nlanes,
+		name, resetw.c_str(), (with_reset)?", ":"",
+		(with_aux)?"i_aux, ":"",
+		(with_aux)?", o_aux":"",
+		nlanes, (nlanes+1)/2, phase_bits, ow,
+		resetw.c_str(), (with_reset)?", ":"",
+		(with_aux)?", i_aux":"",
+		(dxlsb > 0) ? "\t// verilator lint_off UNUSED\n" : "",
+		(dxlsb > 0) ? "\t// verilator lint_on  UNUSED\n" : "");
+
+	if (with_aux)
+		fprintf(fp, "\toutput\twire\t\t\t\to_aux;\n\n");
+
+	fprintf(fp, "\tlocalparam\tLGTBL=%d,\n", lgtbl);
+	dx_params(fp, dxlsb, phase_bits-lgtbl+1-dxlsb);
+	fprintf(fp,
+			"\t\t\tTBLENTRIES = (1<<LGTBL), // %d\n"
+			"\t\t\tQBITS = %d,\n"
+			"\t\t\tLBITS = %d,\n"
+			"\t\t\tCBITS = %d;\n\n",
+			(1<<lgtbl), qbits, lbits, cbits);
+
+	fprintf(fp,
+	"\treg\t[(NLANES*QBITS-1):0]\tqv;\n"
+	"\treg\t[(NLANES*LBITS-1):0]\tlv;\n"
+	"\treg\t[(NLANES*CBITS-1):0]\tcv;\n"
+	"\treg\t[(NLANES*DXBITS-1):0]\tdx;\n\n");
+
+	if (with_aux) {
+		fprintf(fp,
+		"\t// aux bit\n"
+		"\tlocalparam	NSTAGES=%d;\n"
+		"\treg	[(NSTAGES-1):0]	aux;\n"
+		"\tinitial	aux = 0;\n", nstages);
+		lane_register(fp, "\t", with_reset, async_reset,
+			"aux", "{ aux[(NSTAGES-2):0], i_aux }");
+		fprintf(fp,
+		"\tassign	o_aux = aux[(NSTAGES-1)];\n\n");
+	}
+
+	fprintf(fp,
+	"\t// Clock zero: each copy of the tables serves two lanes, one\n"
+	"\t// through each of its two read ports\n"
+	"\tgenvar\tk;\n"
+	"\tgenerate for(k=0; k<NTBLS; k=k+1)\n"
+	"\tbegin : TBL\n"
+	"\t\treg	[(CBITS-1):0]	ctbl [0:(TBLENTRIES-1)];\n"
+	"\t\treg	[(LBITS-1):0]	ltbl [0:(TBLENTRIES-1)];\n"
+	"\t\treg	[(QBITS-1):0]	qtbl [0:(TBLENTRIES-1)];\n"
+	"\n"
+	"\t\tinitial begin\n"
+	"\t\t\t$readmemh(\"%s_ctbl.hex\", ctbl);\n"
+	"\t\t\t$readmemh(\"%s_ltbl.hex\", ltbl);\n"
+	"\t\t\t$readmemh(\"%s_qtbl.hex\", qtbl);\n"
+	"\t\tend\n\n", name, name, name);
+
+	for(int port=0; port<2; port++) {
+		const char	*tabs = (port) ? "\t\t\t" : "\t\t",
+				*lp   = (port) ? "(2*k+1)" : "(2*k)",
+				*lsb  = (dxlsb > 0) ? "+DXLSB" : "";
+
+		if (port)
+			fprintf(fp,
+			"\n"
+			"\t\t// With an odd number of lanes, the last copy only\n"
+			"\t\t// needs the one port\n"
+			"\t\tif (2*k+1 < NLANES)\n"
+			"\t\tbegin : PORTB\n");
+		fprintf(fp, "%s", lane_always(tabs, with_reset,
+				async_reset).c_str());
+		if (with_reset)
+			fprintf(fp,
+			"%sbegin\n"
+			"%s\tqv[%s*QBITS +: QBITS] <= 0;\n"
+			"%s\tlv[%s*LBITS +: LBITS] <= 0;\n"
+			"%s\tcv[%s*CBITS +: CBITS] <= 0;\n"
+			"%s\tdx[%s*DXBITS +: DXBITS] <= 0;\n"
+			"%send else ", tabs, tabs, lp, tabs, lp,
+			tabs, lp, tabs, lp, tabs);
+		fprintf(fp,
+			"if (i_ce)\n"
+			"%sbegin\n"
+			"%s\tqv[%s*QBITS +: QBITS] <= qtbl[i_phase[(%s*PW+DXBITS%s-1) +: LGTBL]];\n"
+			"%s\tlv[%s*LBITS +: LBITS] <= ltbl[i_phase[(%s*PW+DXBITS%s-1) +: LGTBL]];\n"
+			"%s\tcv[%s*CBITS +: CBITS] <= ctbl[i_phase[(%s*PW+DXBITS%s-1) +: LGTBL]];\n"
+			"%s\tdx[%s*DXBITS +: DXBITS] <= { 1'b0, i_phase[%s*PW%s +: (DXBITS-1)] };\n"
+			"%send\n",
+			tabs, tabs, lp, lp, lsb, tabs, lp, lp, lsb,
+			tabs, lp, lp, lsb, tabs, lp, lp, lsb, tabs);
+	}
+	fprintf(fp,
+	"\t\tend\n"
+	"\tend endgenerate\n\n");
+
+	fprintf(fp,
+	"\t// Clocks one through %d\n"
+	"\tgenerate for(k=0; k<NLANES; k=k+1)\n"
+	"\tbegin : LANE\n"
+	"\t\t%s\n"
+	"\t\tu_lane(.i_clk(i_clk), ", nstages-1, lane);
+	if (with_reset)
+		fprintf(fp, ".%s(%s), ", resetw.c_str(), resetw.c_str());
+	fprintf(fp, ".i_ce(i_ce),\n"
+	"\t\t\t.i_qv(qv[k*QBITS +: QBITS]),\n"
+	"\t\t\t.i_lv(lv[k*LBITS +: LBITS]),\n"
+	"\t\t\t.i_cv(cv[k*CBITS +: CBITS]),\n"
+	"\t\t\t.i_dx(dx[k*DXBITS +: DXBITS]),\n"
+	"\t\t\t.o_sin(o_sin[k*OW +: OW]));\n"
+	"\tend endgenerate\n"
+	"endmodule\n");
+}
+
 void	quadtbl(FILE *fp, FILE *fhp, const char *fname, int phase_bits, int ow,
-		int nxtra, bool with_reset, bool with_aux, bool async_reset) {
+		int nxtra, bool with_reset, bool with_aux, bool async_reset,
+		FILE *fmp, int nlanes, int mpy_aw, int mpy_bw, int mpy_delay,
+		CORE_ESTIMATE *est) {
 	const	char	*name;
+	std::string	lanename;
+	// With more than one lane, the tables (and the aux bit) move out into
+	// the wrapper, leaving the lane with only the interpolation
+	bool	lane = (nlanes > 1);
 	char	*noext;
-	int	lgtbl = pick_tbl_size(ow+nxtra);
+	int	lgtbl;
 
-	int	cbits, lbits, qbits, dxbits = phase_bits-lgtbl+1;
+	int	cbits, lbits, qbits, dxbits, dxlsb;
 	int	ww = ow + nxtra;
 	double	tblerr;
+	long	*cdata = NULL, *ldata = NULL, *qdata = NULL;
+	// The wide and narrow multiplier ports
+	int	aw = (mpy_aw > mpy_bw) ? mpy_aw : mpy_bw,
+		bw = (mpy_aw > mpy_bw) ? mpy_bw : mpy_aw;
+	// Each multiply takes mpy_delay clocks, rather than one
+	int	xdly = mpy_delay - 1,
+		nstages = ((NO_QUADRATIC_COMPONENT)?4:6) + 2*xdly;
+	std::string	qprod, lprod, lvq, cvq, dxq, cvl;
 
 	assert(nxtra >= 0);
+	assert(mpy_delay >= 1);
 	assert(fp);
 	assert(phase_bits>4);
-	assert(phase_bits>lgtbl);
 	assert(fname);
 
 
 	name = modulename(fname);
+	lanename = name;
+	if (lane)
+		lanename += "_lane";
 	noext = strdup(fname);
 	{
 		char *ptr;
@@ -286,8 +829,32 @@ void	quadtbl(FILE *fp, FILE *fhp, const char *fname, int phase_bits, int ow,
 	lgtbl=3;
 	do {
 		lgtbl++;
-		build_quadtbls(noext, lgtbl, ow+nxtra, cbits, lbits, qbits, tblerr);
-	} while((fabs(tblerr) > 1.0)&&(lgtbl < 20));
+		if (NULL != fmp) {
+			// Keep a copy of the tables for the software model
+			delete[] cdata;
+			delete[] ldata;
+			delete[] qdata;
+			cdata = new long[(1<<lgtbl)];
+			ldata = new long[(1<<lgtbl)];
+			qdata = new long[(1<<lgtbl)];
+		}
+		build_quadtbls(noext, lgtbl, ow+nxtra, cbits, lbits, qbits, tblerr,
+			cdata, ldata, qdata);
+	// Larger tables need smaller coefficients, and fewer bits of dx, so
+	// keep growing the table until each multiply fits the multiplier
+	} while(((fabs(tblerr) > 1.0)||(!quadtbl_fits(aw, bw, ow,
+				phase_bits, lgtbl, lbits, qbits)))
+			&&(lgtbl < 20)&&(lgtbl+2 < phase_bits));
+
+	if (!quadtbl_fits(aw, bw, ow, phase_bits, lgtbl, lbits, qbits))
+		fprintf(stderr, "WARNING: No table size allows the multiplies to fit within %dx%d bits\n", aw, bw);
+
+	dxbits = phase_bits-lgtbl+1;
+	dxlsb  = 0;
+	if ((aw > 0)&&(dxbits > bw)) {
+		dxlsb  = dxbits - bw;
+		dxbits = bw;
+	}
 
 	printf("Rpt-Err: %f\n", tblerr);
 	const	char PURPOSE[] =
@@ -322,37 +889,74 @@ void	quadtbl(FILE *fp, FILE *fhp, const char *fname, int phase_bits, int ow,
 		always_reset = "\talways @(posedge i_clk)\n\t";
 
 	fprintf(fp, "`default_nettype\tnone\n//\n");
-	fprintf(fp,
-		"module	%s(i_clk, %s%si_ce, %si_phase, o_sin%s);\n"
+	if (lane) {
+		fprintf(fp,
+		"module	%s(i_clk, %s%si_ce, i_qv, i_lv, i_cv, i_dx, o_sin);\n"
 		"\tlocalparam\tPW=%2d,\t// Bits in our phase variable\n"
 		"\t\t\tOW=%2d,  // The number of output bits to produce\n"
 		"\t\t\tXTRA=%2d;// Extra bits for internal precision\n"
-		"\tinput\twire\t\t\t\ti_clk, %s%si_ce%s;\n"
-		"\t//\n"
-		"\tinput\twire\tsigned\t[(PW-1):0]\ti_phase;\n"
-		"\toutput\treg\tsigned\t[(OW-1):0]\to_sin;\n",
-		name, resetw.c_str(), (with_reset)?", ":"",
-		(with_aux)?" i_aux,":"",
-		(with_aux)?", o_aux":"",
+		"\tinput\twire\t\t\t\ti_clk, %s%si_ce;\n",
+		lanename.c_str(), resetw.c_str(), (with_reset)?", ":"",
 		phase_bits, ow, nxtra,
-		resetw.c_str(), (with_reset)?", ":"",
-		(with_aux)?", i_aux":"");
+		resetw.c_str(), (with_reset)?", ":"");
+	} else {
+		fprintf(fp,
+			"module	%s(i_clk, %s%si_ce, %si_phase, o_sin%s);\n"
+			"\tlocalparam\tPW=%2d,\t// Bits in our phase variable\n"
+			"\t\t\tOW=%2d,  // The number of output bits to produce\n"
+			"\t\t\tXTRA=%2d;// Extra bits for internal precision\n"
+			"\tinput\twire\t\t\t\ti_clk, %s%si_ce%s;\n"
+			"\t//\n"
+			"%s"
+			"\tinput\twire\tsigned\t[(PW-1):0]\ti_phase;\n"
+			"%s"
+			"\toutput\treg\tsigned\t[(OW-1):0]\to_sin;\n",
+			name, resetw.c_str(), (with_reset)?", ":"",
+			(with_aux)?" i_aux,":"",
+			(with_aux)?", o_aux":"",
+			phase_bits, ow, nxtra,
+			resetw.c_str(), (with_reset)?", ":"",
+			(with_aux)?", i_aux":"",
+			(dxlsb > 0) ? "\t// verilator lint_off UNUSED\n" : "",
+			(dxlsb > 0) ? "\t// verilator lint_on  UNUSED\n" : "");
 
 
-	if (with_aux)
-		fprintf(fp, "\toutput\treg\t\t\t\to_aux;\n\n");
+		if (with_aux)
+			fprintf(fp, "\toutput\treg\t\t\t\to_aux;\n\n");
+	}
 
+	fprintf(fp, "\tlocalparam\tLGTBL=%d,\n", lgtbl);
+	dx_params(fp, dxlsb, dxbits);
 	fprintf(fp,
-	"\tlocalparam\tLGTBL=%d,\n"
-			"\t\t\tDXBITS= (PW-LGTBL)+1,    // %d\n"
 			"\t\t\tTBLENTRIES = (1<<LGTBL), // %d\n"
 			"\t\t\tQBITS = %d,\n"
 			"\t\t\tLBITS = %d,\n"
 			"\t\t\tCBITS = %d,\n"
 			"\t\t\tWW    = (OW+XTRA); // Working width\n\n",
-			lgtbl, dxbits, (1<<lgtbl), qbits, lbits, cbits);
+			(1<<lgtbl), qbits, lbits, cbits);
 
-	if (NO_QUADRATIC_COMPONENT) {
+	if (lane) {
+		// The tables have already been read, on clock zero, by the
+		// time their values arrive here
+		assert(!NO_QUADRATIC_COMPONENT);
+		fprintf(fp,
+		"\tinput\twire\tsigned\t[(QBITS-1):0]\ti_qv;\n"
+		"\tinput\twire\tsigned\t[(LBITS-1):0]\ti_lv;\n"
+		"\tinput\twire\tsigned\t[(CBITS-1):0]\ti_cv;\n"
+		"\tinput\twire\tsigned\t[(DXBITS-1):0]\ti_dx;\n"
+		"\toutput\treg\tsigned\t[(OW-1):0]\to_sin;\n\n"
+		"\twire\tsigned\t[(CBITS-1):0]\tcv;\n"
+		"\treg\tsigned\t[(CBITS-1):0]\tcv_1, cv_2, cv_3;\n"
+		"\twire\tsigned\t[(LBITS-1):0]\tlv;\n"
+		"\treg\tsigned\t[(LBITS-1):0]\tlv_1;\n"
+		"\twire\tsigned\t[(QBITS-1):0]\tqv;\n"
+		"\twire\tsigned\t[(DXBITS-1):0]\tdx;\n"
+		"\treg\tsigned\t[(DXBITS-1):0]\tdx_1, dx_2;\n\n"
+		"\tassign\tqv = i_qv;\n"
+		"\tassign\tlv = i_lv;\n"
+		"\tassign\tcv = i_cv;\n"
+		"\tassign\tdx = i_dx;\n\n");
+	} else if (NO_QUADRATIC_COMPONENT) {
 		fprintf(fp,
 		"\treg\tsigned\t[(CBITS-1):0]\tcv, cv_1;\n"
 		"\treg\tsigned\t[(LBITS-1):0]\tlv;\n"
@@ -366,75 +970,81 @@ void	quadtbl(FILE *fp, FILE *fhp, const char *fname, int phase_bits, int ow,
 		"\treg\tsigned\t[(DXBITS-1):0]\tdx, dx_1, dx_2;\n\n");
 	}
 
-	fprintf(fp,
-	"\treg	[(CBITS-1):0]	ctbl [0:(TBLENTRIES-1)]; //=(0...2^(OX)-1)/2^32\n"
-	"\t// ltbl !=\n"
-	"\treg	[(LBITS-1):0]	ltbl [0:(TBLENTRIES-1)]; // %d x %d\n",
-		lbits, (1<<lgtbl));
+	if (!lane) {
+		fprintf(fp,
+		"\treg	[(CBITS-1):0]	ctbl [0:(TBLENTRIES-1)]; //=(0...2^(OX)-1)/2^32\n"
+		"\t// ltbl !=\n"
+		"\treg	[(LBITS-1):0]	ltbl [0:(TBLENTRIES-1)]; // %d x %d\n",
+			lbits, (1<<lgtbl));
 
-	if (!NO_QUADRATIC_COMPONENT)
+		if (!NO_QUADRATIC_COMPONENT)
+			fprintf(fp,
+		"\treg	[(QBITS-1):0]	qtbl [0:(TBLENTRIES-1)]; // %d x %d\n\n",
+			qbits, (1<<lgtbl));
+
+		fprintf(fp,
+		"\tinitial begin\n"
+		"\t\t$readmemh(\"%s_ctbl.hex\", ctbl);\n"
+		"\t\t$readmemh(\"%s_ltbl.hex\", ltbl);\n", name, name);
+		if (!NO_QUADRATIC_COMPONENT)
+			fprintf(fp,
+			"\t\t$readmemh(\"%s_qtbl.hex\", qtbl);\n", name);
 		fprintf(fp,
-	"\treg	[(QBITS-1):0]	qtbl [0:(TBLENTRIES-1)]; // %d x %d\n\n",
-		qbits, (1<<lgtbl));
+			"\tend\n\n");
 
-	fprintf(fp,
-	"\tinitial begin\n"
-	"\t\t$readmemh(\"%s_ctbl.hex\", ctbl);\n"
-	"\t\t$readmemh(\"%s_ltbl.hex\", ltbl);\n", name, name);
-	if (!NO_QUADRATIC_COMPONENT)
 		fprintf(fp,
-		"\t\t$readmemh(\"%s_qtbl.hex\", qtbl);\n", name);
-	fprintf(fp,
-		"\tend\n\n");
+		"\t// aux bit\n"
+		"\tlocalparam	NSTAGES=%d;\n", nstages);
 
-	fprintf(fp,
-	"\t// aux bit\n"
-	"\tlocalparam	NSTAGES=%d;\n",
-			(NO_QUADRATIC_COMPONENT)?4:6);
+		if (with_aux) {
+			fprintf(fp,
+			"\treg	[(NSTAGES-1):0]	aux;\n"
+			"\tinitial	aux = 0;\n");
 
-	if (with_aux) {
-		fprintf(fp,
-		"\treg	[(NSTAGES-1):0]	aux;\n"
-		"\tinitial	aux = 0;\n");
+			fprintf(fp, "%s", always_reset.c_str());
 
+			if (with_reset)
+				fprintf(fp,
+				"\t\taux <= 0;\n"
+				"\telse ");
+	
+			fprintf(fp,
+			"if (i_ce)\n"
+				"\t\t\taux <= { aux[(NSTAGES-2):0], i_aux };\n"
+				"\tassign	o_aux = aux[(NSTAGES-1)];\n\n");
+		}
+
+		fprintf(fp, "\t// Clock zero\n");
 		fprintf(fp, "%s", always_reset.c_str());
 
-		if (with_reset)
+		if (with_reset) {
+			fprintf(fp, "\tbegin\n");
+			if (!NO_QUADRATIC_COMPONENT)
+				fprintf(fp, "\t\tqv <= 0;\n");
 			fprintf(fp,
-			"\t\taux <= 0;\n"
-			"\telse ");
-	
+				"\t\tlv <= 0;\n"
+				"\t\tcv <= 0;\n"
+				"\t\tdx <= 0;\n"
+				"\tend else ");
+		}
+
 		fprintf(fp,
 		"if (i_ce)\n"
-			"\t\t\taux <= { aux[(NSTAGES-2):0], i_aux };\n"
-			"\tassign	o_aux = aux[(NSTAGES-1)];\n\n");
-	}
+		"\tbegin\n");
+		const char	*idx = (dxlsb > 0) ? "(PW-1):(DXBITS+DXLSB-1)"
+					: "(PW-1):(DXBITS-1)",
+				*dxr = (dxlsb > 0) ? "(DXBITS+DXLSB-2):DXLSB"
+					: "(DXBITS-2):0";
 
-	fprintf(fp, "\t// Clock zero\n");
-	fprintf(fp, "%s", always_reset.c_str());
-
-	if (with_reset) {
-		fprintf(fp, "\tbegin\n");
 		if (!NO_QUADRATIC_COMPONENT)
-			fprintf(fp, "\t\tqv <= 0;\n");
+			fprintf(fp,"\t\tqv <= qtbl[i_phase[%s]];\n", idx);
 		fprintf(fp,
-			"\t\tlv <= 0;\n"
-			"\t\tcv <= 0;\n"
-			"\t\tdx <= 0;\n"
-			"\tend else ");
+		"\t\tlv <= ltbl[i_phase[%s]];\n"
+		"\t\tcv <= ctbl[i_phase[%s]];\n"
+		"\t\tdx <= { 1'b0, i_phase[%s] };	// * 2^(-PW)\n"
+		"\tend\n\n", idx, idx, dxr);
 	}
 
-	fprintf(fp,
-	"if (i_ce)\n"
-	"\tbegin\n");
-	if (!NO_QUADRATIC_COMPONENT)
-		fprintf(fp,"\t\tqv <= qtbl[i_phase[(PW-1):(DXBITS-1)]];\n");
-	fprintf(fp,
-	"\t\tlv <= ltbl[i_phase[(PW-1):(DXBITS-1)]];\n"
-	"\t\tcv <= ctbl[i_phase[(PW-1):(DXBITS-1)]];\n"
-	"\t\tdx <= { 1'b0, i_phase[(DXBITS-2):0] };	// * 2^(-PW)\n"
-	"\tend\n\n");
-
 	fprintf(fp,
 	"\t//\n"
 	"\t// Here's our formula:\n"
@@ -467,6 +1077,11 @@ void	quadtbl(FILE *fp, FILE *fhp, const char *fname, int phase_bits, int ow,
 		" if (i_ce)\n"
 			"\t\tqprod <= qv * dx; // %d bits\n\n",
 				qbits+dxbits);
+
+		// Further product registers, for the multiplier's own
+		// pipeline to absorb
+		qprod = delay_chain(fp, always_reset, with_reset,
+			"[(QBITS+DXBITS-1):0]", "qprod", xdly);
 	}
 
 	fprintf(fp,
@@ -493,21 +1108,29 @@ void	quadtbl(FILE *fp, FILE *fhp, const char *fname, int phase_bits, int ow,
 		"\tend\n\n");
 
 	if (!NO_QUADRATIC_COMPONENT) {
+		// Hold everything else back until the product is ready
+		lvq = delay_chain(fp, always_reset, with_reset,
+			"[(LBITS-1):0]", "lv_1", xdly);
+		cvq = delay_chain(fp, always_reset, with_reset,
+			"[(CBITS-1):0]", "cv_1", xdly);
+		dxq = delay_chain(fp, always_reset, with_reset,
+			"[(DXBITS-1):0]", "dx_1", xdly);
+
 		fprintf(fp,
 		"\t// Clock %d\n"
 		"\treg\tsigned [(LBITS-1):0]\tlsum;\n"
 		"\twire\t[(LBITS-1):0]\tw_qprod;\n",
-			(NO_QUADRATIC_COMPONENT)?1:2);
+			2+xdly);
 
 		if (lbits-qbits-1>0) {
 			fprintf(fp,
-		"\tassign	w_qprod[(LBITS-1):(QBITS+1)] = { (%d){qprod[(QBITS+DXBITS-1)]} };\n",
-				lbits-qbits-1);
+		"\tassign	w_qprod[(LBITS-1):(QBITS+1)] = { (%d){%s[(QBITS+DXBITS-1)]} };\n",
+				lbits-qbits-1, qprod.c_str());
 		}
 		fprintf(fp,
 		"\tassign\tw_qprod[QBITS:0] // %d\n"
-			"\t\t\t= qprod[(QBITS+DXBITS-1):(DXBITS-1)]; // [%d:%d]\n",
-			qbits+1,qbits+dxbits-1, dxbits-1);
+			"\t\t\t= %s[(QBITS+DXBITS-1):(DXBITS-1)]; // [%d:%d]\n",
+			qbits+1, qprod.c_str(), qbits+dxbits-1, dxbits-1);
 
 		fprintf(fp, "%s", always_reset.c_str());
 		if (with_reset)
@@ -515,8 +1138,8 @@ void	quadtbl(FILE *fp, FILE *fhp, const char *fname, int phase_bits, int ow,
 
 		fprintf(fp,
 			"if (i_ce)\n"
-				"\t\tlsum <= w_qprod + lv%s; // %d bits\n\n",
-				(NO_QUADRATIC_COMPONENT)?"":"_1", lbits+1);
+				"\t\tlsum <= w_qprod + %s; // %d bits\n\n",
+				lvq.c_str(), lbits+1);
 
 		fprintf(fp, "%s", always_reset.c_str());
 		fprintf(fp,
@@ -526,15 +1149,15 @@ void	quadtbl(FILE *fp, FILE *fhp, const char *fname, int phase_bits, int ow,
 			"\tend else ");
 		fprintf(fp,
 			"if (i_ce) begin\n"
-				"\t\tcv_2 <= cv_1;\n"
-				"\t\tdx_2 <= dx_1;\n"
-			"\tend\n\n");
+				"\t\tcv_2 <= %s;\n"
+				"\t\tdx_2 <= %s;\n"
+			"\tend\n\n", cvq.c_str(), dxq.c_str());
 	}
 
 	fprintf(fp,
 	"\t// Clock %d\n"
 	"\treg\tsigned\t[(LBITS+DXBITS-1):0]\tlprod;\n",
-			(NO_QUADRATIC_COMPONENT)?1:2);
+			(NO_QUADRATIC_COMPONENT)?1:(3+xdly));
 	fprintf(fp, "%s", always_reset.c_str());
 	if (with_reset)
 		fprintf(fp,
@@ -562,6 +1185,11 @@ void	quadtbl(FILE *fp, FILE *fhp, const char *fname, int phase_bits, int ow,
 			(NO_QUADRATIC_COMPONENT)?1:3,
 			(NO_QUADRATIC_COMPONENT)?"":"_2");
 
+	lprod = delay_chain(fp, always_reset, with_reset,
+			"[(LBITS+DXBITS-1):0]", "lprod", xdly);
+	cvl = delay_chain(fp, always_reset, with_reset, "[(CBITS-1):0]",
+			(NO_QUADRATIC_COMPONENT) ? "cv_1" : "cv_3", xdly);
+
 //
 // TBLSZ	LBITS
 //	16	26
@@ -572,16 +1200,16 @@ void	quadtbl(FILE *fp, FILE *fhp, const char *fname, int phase_bits, int ow,
 	"\t// Clock %d\n"
 	"\treg	signed	[(CBITS-1):0]		r_value; // %d bits\n"
 	"\twire	signed	[(CBITS-1):0]		w_lprod;\n",
-			(NO_QUADRATIC_COMPONENT)?2:4,
+			((NO_QUADRATIC_COMPONENT)?2:4) + 2*xdly,
 			cbits);
 	if (cbits-lbits-1>0) {
 		fprintf(fp,
-	"\tassign	w_lprod[(CBITS-1):(LBITS+1)] = { (%d){lprod[(LBITS+DXBITS-1)]} };\n",
-			cbits-lbits-1);
+	"\tassign	w_lprod[(CBITS-1):(LBITS+1)] = { (%d){%s[(LBITS+DXBITS-1)]} };\n",
+			cbits-lbits-1, lprod.c_str());
 	}
 	fprintf(fp,
-	"\tassign	w_lprod[(LBITS):0] = lprod[(LBITS+DXBITS-1):(DXBITS-1)]; // %d bits\n",
-			lbits);
+	"\tassign	w_lprod[(LBITS):0] = %s[(LBITS+DXBITS-1):(DXBITS-1)]; // %d bits\n",
+			lprod.c_str(), lbits);
 /*
 	if (cbits-lbits>0) {
 		fprintf(fp,
@@ -599,8 +1227,7 @@ void	quadtbl(FILE *fp, FILE *fhp, const char *fname, int phase_bits, int ow,
 			"\telse ");
 
 	fprintf(fp, "if (i_ce)\n"
-			"\t\tr_value <= w_lprod + cv_%d;\n\n",
-			(NO_QUADRATIC_COMPONENT)?1:3);
+			"\t\tr_value <= w_lprod + %s;\n\n", cvl.c_str());
 
 	fprintf(fp,
 	"\t// Clock %d - round the output\n"
@@ -617,7 +1244,7 @@ void	quadtbl(FILE *fp, FILE *fhp, const char *fname, int phase_bits, int ow,
 				"\t\t\t\t{(WW-OW-1){!r_value[(WW-OW)]}} };\n"
 	"\t// verilator lint_on  UNUSED\n"
 	"\tinitial	o_sin = 0;\n",
-			(NO_QUADRATIC_COMPONENT)?3:5);
+			((NO_QUADRATIC_COMPONENT)?3:5) + 2*xdly);
 
 	fprintf(fp, "%s", always_reset.c_str());
 	if (with_reset)
@@ -633,21 +1260,26 @@ void	quadtbl(FILE *fp, FILE *fhp, const char *fname, int phase_bits, int ow,
 	"\t// verilator lint_off UNUSED\n"
 	"\twire	[(2*(DXBITS)+XTRA-1):0] unused;\n"
 	"\tassign	unused = {\n"
-			"\t\t\tlprod[(DXBITS-1):0],\n"
+			"\t\t\t%s[(DXBITS-1):0],\n"
 			// "\t\t\tr_value[(CBITS-1):WW],\n"
-			"\t\t\tr_value[(XTRA-1):0],\n");
+			"\t\t\tr_value[(XTRA-1):0],\n", lprod.c_str());
 	if (NO_QUADRATIC_COMPONENT) {
 		fprintf(fp,
 			"\t\t\t{ (DXBITS){1\'b0} }};\n");
 	} else {
 		fprintf(fp,
-			"\t\t\tqprod[(DXBITS-1):0] };\n");
+			"\t\t\t%s[(DXBITS-1):0] };\n", qprod.c_str());
 	}
 
 	fprintf(fp, "\t// verilator lint_on  UNUSED\n\n");
 
 	fprintf(fp, "endmodule\n");
 
+	if (lane)
+		quadtbl_lanes(fp, name, lanename.c_str(), nlanes, phase_bits,
+			ow, nxtra, lgtbl, dxlsb, qbits, lbits, cbits, nstages,
+			with_reset, with_aux, async_reset);
+
 	if (NULL != fhp) {
 		char	*str = new char[strlen(name)+4], *ptr;
 		sprintf(str, "%s.h", name);
@@ -664,11 +1296,24 @@ void	quadtbl(FILE *fp, FILE *fhp, const char *fname, int phase_bits, int ow,
 		fprintf(fhp, "const\tint\tOW         = %d; // bits\n", ow);
 		fprintf(fhp, "const\tint\tNEXTRA     = %d; // bits\n", nxtra);
 		fprintf(fhp, "const\tint\tPW         = %d; // bits\n", phase_bits);
+		if (lane)
+			fprintf(fhp, "const\tint\tNLANES     = %d;\n", nlanes);
+		fprintf(fhp, "const\tint\tLATENCY    = %d; // clocks\n", nstages);
+		if (aw > 0) {
+			fprintf(fhp, "const\tint\tMPY_AW     = %d; // bits\n", aw);
+			fprintf(fhp, "const\tint\tMPY_BW     = %d; // bits\n", bw);
+		}
 		fprintf(fhp, "const\tlong\tTBL_LGSZ  = %d; // (Units)\n",lgtbl);
 		fprintf(fhp, "const\tlong\tTBL_SZ    = %ld; // (Units)\n",(1l<<lgtbl));
 		fprintf(fhp, "const\tlong\tSCALE     = %ld; // (Units)\n",
 			max_integer(ow));
-		fprintf(fhp, "const\tdouble\tITBL_ERR  = %.2f; // (OW Units)\n",
+		// ITBL_ERR is the error of the table fit alone, in LSBs of the
+		// OW+NEXTRA bits the tables are built with.  The output error
+		// against (2^(OW-1)-1) * sin() is larger: it adds the rounding
+		// to OW bits, and the core's amplitude, max_integer(OW+NEXTRA)
+		// >> NEXTRA, isn't quite that of the reference.  Sweeping every
+		// phase of the default 24-bit, 26-phase-bit core finds 1.67 LSB.
+		fprintf(fhp, "const\tdouble\tITBL_ERR  = %.2f; // (OW+NEXTRA Units)\n",
 			tblerr);
 		fprintf(fhp, "const\tdouble\tTBL_ERR   = %.16f; // (sin Units)\n",
 			tblerr * pow(0.5,ow+nxtra));
@@ -696,5 +1341,18 @@ void	quadtbl(FILE *fp, FILE *fhp, const char *fname, int phase_bits, int ow,
 		delete[] str;
 	}
 
+	if (NULL != fmp)
+		quadtbl_model(fmp, name, phase_bits, ow, nxtra, lgtbl, dxlsb,
+			cbits, lbits, qbits, nstages, cdata, ldata, qdata);
+
+	if (NULL != est) {
+		estimate_quadtbl(est, ww, ow, lgtbl, cbits, lbits, qbits,
+			dxbits, mpy_aw, mpy_bw, mpy_delay);
+		estimate_lanes(est, nlanes, with_aux, true);
+	}
+
+	delete[] cdata;
+	delete[] ldata;
+	delete[] qdata;
 	free(noext);
 }
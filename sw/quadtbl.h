@@ -38,12 +38,18 @@
 #ifndef	QUADTBL_H
 #define	QUADTBL_H
 
+#include "estimate.h"
+
 extern	double	sinc(double v);
 extern	void	build_quadtbls(const char *fname,
 		const int lgsz, const int wid,
-		int &cbits, int &lbits, int &qbits, double &tblerr);
+		int &cbits, int &lbits, int &qbits, double &tblerr,
+		long *ctbl = NULL, long *ltbl = NULL, long *qtbl = NULL);
 extern	void	quadtbl(FILE *fp, FILE *fhp, const char *fname,
 		int phase_bits, int ow, int nxtra,
-		bool with_reset, bool with_aux, bool async_reset);
+		bool with_reset, bool with_aux, bool async_reset,
+		FILE *fmp = NULL, int nlanes = 1,
+		int mpy_aw = 0, int mpy_bw = 0, int mpy_delay = 1,
+		CORE_ESTIMATE *est = NULL);
 
 #endif
@@ -0,0 +1,864 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename: 	radix4cordic.cpp
+//
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	Generates radix-4 versions of cordic.v and topolar.v, the
+//		p2r4 and r2p4 cores.  Each pipeline stage of these cores
+//	picks one radix-4 digit, sigma, from +/-1 and +/-3, and so does the
+//	work of two radix-2 stages, by atan(2^-s) and atan(2^-(s+1)), in one
+//	clock:
+//
+//		x' = x - sigma 2^-(s+1) y - (|sigma|-2) 2^-(2s+1) x
+//		y' = y + sigma 2^-(s+1) x - (|sigma|-2) 2^-(2s+1) y
+//
+//	That's (1+j d1 2^-s)(1+j d2 2^-(s+1)), with sigma = 2 d1 + d2, and the
+//	last term is the cross term of that product.  It keeps the gain
+//	of every digit the same, so the gain of the core is a constant, and
+//	the one of the radix-2 stages it replaces.  The polar to rectangular
+//	core picks its digit by comparing the phase against two constants,
+//	the rectangular to polar core from the sign of y both before and
+//	after the first of the two rotations, so neither waits on a phase
+//	update in the middle of the stage.  This halves the latency of the
+//	core, save the two clocks of the pre-rotation and the rounding, for
+//	the same precision.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2018, Gisselquist Technology, LLC
+//
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+//
+// License:	GPL, v3, as defined and found on www.gnu.org,
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+//
+#include <stdio.h>
+#include <math.h>
+#include <string.h>
+#include <string>
+#include <ctype.h>
+#include <assert.h>
+
+#include "legal.h"
+#include "cordiclib.h"
+#include "radix4cordic.h"
+#include "swmodel.h"
+
+static	const	char HPURPOSE[] =
+	"This .h file notes the default parameter values from\n"
+	"//\t\twithin the generated file.  It is used to communicate\n"
+	"//\tinformation about the design to the bench testing code.";
+
+//
+// r4_phase
+//
+// Writes the phase value v into str as a Verilog constant
+static	const char	*r4_phase(char *str, unsigned long v, int phase_bits) {
+	sprintf(str, "%d\'h%0*lx", phase_bits, (phase_bits+3)/4,
+		v & ((1ul << phase_bits)-1ul));
+	return str;
+}
+
+//
+// r4_shift
+//
+// Writes v>>>s, rounded to nearest, into str.  Unlike the radix-2 stages,
+// whose truncation errors mostly cancel between their two digits, a
+// radix-4 digit's several truncated terms would bias each rotation.
+static	int	r4_shift(char *str, const char *v, int s) {
+	return sprintf(str, "((%s>>>%d) + $signed({ 1'b0, %s[%d] }))",
+		v, s, v, s-1);
+}
+
+//
+// r4_update
+//
+// Writes out the new value of v, either xv[i] or yv[i], once rotated by the
+// digit sigma at a shift of s.  u is the other of the two.  cs is the shift
+// of the gain correcting term, or zero if that term would be shifted off of
+// the bottom of the working width.
+static	void	r4_update(char *str, const char *v, const char *u, bool isy,
+		int sigma, int s, int cs) {
+	char	op = ((sigma > 0) == isy) ? '+' : '-';
+	bool	three = (sigma == 3)||(sigma == -3);
+	int	n;
+
+	n = sprintf(str, "%s", v);
+	if (three) {
+		n += sprintf(str+n, "\n\t\t\t\t%c ", op);
+		n += r4_shift(str+n, u, s);
+	}
+	n += sprintf(str+n, "\n\t\t\t\t%c ", op);
+	n += r4_shift(str+n, u, s+1);
+	if (cs > 0) {
+		n += sprintf(str+n, "\n\t\t\t\t%c ", (three) ? '-' : '+');
+		r4_shift(str+n, v, cs);
+	}
+}
+
+//
+// r4_stage_reset
+//
+// Starts the always block of pipeline stage i, through its if (i_ce)
+static	void	r4_stage_reset(FILE *fp, const std::string &always_reset,
+		bool with_reset, int i) {
+	fprintf(fp, "%s", always_reset.c_str());
+	if (with_reset)
+		fprintf(fp,
+			"\tbegin\n"
+			"\t\txv[%d] <= 0;\n"
+			"\t\tyv[%d] <= 0;\n"
+			"\t\tph[%d] <= 0;\n"
+			"\tend else ", i+1, i+1, i+1);
+	fprintf(fp, "if (i_ce)\n\tbegin\n");
+}
+
+//
+// r4_stage
+//
+// Writes out pipeline stage i, a radix-4 stage applying the radix-2 stages
+// k=2i and k+1.  cond[] holds the conditions selecting the first three of
+// the digits in digit[], in that order, leaving the last to the final else.
+// A digit rotating counter-clockwise subtracts its angle from the phase.
+static	void	r4_stage(FILE *fp, const std::string &always_reset,
+		bool with_reset, int i, int ww, int phase_bits,
+		const int digit[4], const char *cond[3],
+		const char *comment[4]) {
+	char	xi[16], yi[16], upd[320], a3[32], a1[32];
+	int	k = 2*i, s = k+1, cs = 2*s+1;
+
+	if (cs >= ww)
+		cs = 0;
+	sprintf(xi, "xv[%d]", i);
+	sprintf(yi, "yv[%d]", i);
+	r4_phase(a3, radix4_angle_value(k, 3, phase_bits), phase_bits);
+	r4_phase(a1, radix4_angle_value(k, 1, phase_bits), phase_bits);
+
+	r4_stage_reset(fp, always_reset, with_reset, i);
+	for(int d=0; d<4; d++) {
+		int	sigma = digit[d];
+
+		if (d == 0)
+			fprintf(fp, "\t\tif (%s)\t// %s\n\t\tbegin\n",
+				cond[d], comment[d]);
+		else if (d < 3)
+			fprintf(fp, "\t\tend else if (%s)\t// %s\n\t\tbegin\n",
+				cond[d], comment[d]);
+		else
+			fprintf(fp, "\t\tend else begin\t// %s\n", comment[d]);
+
+		r4_update(upd, xi, yi, false, sigma, s, cs);
+		fprintf(fp, "\t\t\txv[%d] <= %s;\n", i+1, upd);
+		r4_update(upd, yi, xi, true, sigma, s, cs);
+		fprintf(fp, "\t\t\tyv[%d] <= %s;\n", i+1, upd);
+		fprintf(fp, "\t\t\tph[%d] <= ph[%d] %c %s;\n", i+1, i,
+			(sigma > 0) ? '-' : '+',
+			((sigma == 3)||(sigma == -3)) ? a3 : a1);
+	}
+	fprintf(fp, "\t\tend\n\tend\n\n");
+}
+
+//
+// r2_stage
+//
+// Writes out pipeline stage i as a single radix-2 stage, k = 2i, or as no
+// stage at all if rotating is false.  ccw is the condition for rotating
+// counter-clockwise.
+static	void	r2_stage(FILE *fp, const std::string &always_reset,
+		bool with_reset, int i, int phase_bits, bool rotating,
+		const char *ccw) {
+	char	a[32];
+	int	k = 2*i;
+
+	r4_stage_reset(fp, always_reset, with_reset, i);
+	if (!rotating) {
+		fprintf(fp,
+			"\t\t// Do nothing but move our values forward one\n"
+			"\t\t// stage, since we have more stages than valid data\n"
+			"\t\txv[%d] <= xv[%d];\n"
+			"\t\tyv[%d] <= yv[%d];\n"
+			"\t\tph[%d] <= ph[%d];\n"
+			"\tend\n\n", i+1, i, i+1, i, i+1, i);
+		return;
+	}
+
+	r4_phase(a, cordic_angle_value(k, phase_bits), phase_bits);
+	fprintf(fp,
+		"\t\tif (%s)\n"
+		"\t\tbegin\n"
+		"\t\t\txv[%d] <= xv[%d] - (yv[%d]>>>%d);\n"
+		"\t\t\tyv[%d] <= yv[%d] + (xv[%d]>>>%d);\n"
+		"\t\t\tph[%d] <= ph[%d] - %s;\n"
+		"\t\tend else begin\n"
+		"\t\t\txv[%d] <= xv[%d] + (yv[%d]>>>%d);\n"
+		"\t\t\tyv[%d] <= yv[%d] - (xv[%d]>>>%d);\n"
+		"\t\t\tph[%d] <= ph[%d] + %s;\n"
+		"\t\tend\n"
+		"\tend\n\n", ccw,
+		i+1, i, i, k+1, i+1, i, i, k+1, i+1, i, a,
+		i+1, i, i, k+1, i+1, i, i, k+1, i+1, i, a);
+}
+
+//
+// r4_angles
+//
+// Describes the angles of every stage, in place of cordic_angles()
+static	void	r4_angles(FILE *fp, int nstages, int ww, int phase_bits) {
+	double	PHASE_TO_DEG = 360.0 / (double)(1ul << phase_bits);
+
+	fprintf(fp,
+		"\t//\n"
+		"\t// Each stage below rotates by one of four angles, picked by its\n"
+		"\t// digit.  The digits +/-3 rotate by atan(2^-s)+atan(2^-(s+1)),\n"
+		"\t// the digits +/-1 by atan(2^-s)-atan(2^-(s+1)), and each of\n"
+		"\t// these is rounded to the nearest phase unit.\n"
+		"\t//\n");
+	for(int k=0; k<nstages; k+=2) {
+		int	n = radix4_rotations(k, nstages, ww, phase_bits);
+
+		if (n == 2)
+			fprintf(fp, "\t// Stage %2d: s = %2d, %11.6f or %11.6f deg\n",
+				k/2, k+1,
+				radix4_angle_value(k, 3, phase_bits)
+					* PHASE_TO_DEG,
+				radix4_angle_value(k, 1, phase_bits)
+					* PHASE_TO_DEG);
+		else if (n == 1)
+			fprintf(fp, "\t// Stage %2d: s = %2d, %11.6f deg (radix-2)\n",
+				k/2, k+1,
+				cordic_angle_value(k, phase_bits)
+					* PHASE_TO_DEG);
+		else
+			fprintf(fp, "\t// Stage %2d: (none)\n", k/2);
+	}
+
+	fprintf(fp, "\t// Phase Quantization: %.6f (Radians)\n",
+			sqrt(radix4_phase_variance(nstages, phase_bits)));
+	fprintf(fp, "\t// Gain is %.6f\n", radix4_gain(nstages));
+	fprintf(fp, "\t// You can annihilate this gain by multiplying by 32\'h%08x\n",
+			(unsigned)(1.0/radix4_gain(nstages)
+					*(4.0 * (1ul<<30))));
+	fprintf(fp, "\t// and right shifting by 32 bits.\n\n");
+}
+
+//
+// r4_header
+//
+// Writes the -c header shared by both cores
+static	void	r4_header(FILE *fhp, const char *name, int nstages, int npipe,
+		int iw, int ow, int nxtra, int working_width, int phase_bits,
+		bool with_reset, bool with_aux, bool async_reset, bool p2r) {
+	char	*str = new char[strlen(name)+4], *ptr;
+
+	sprintf(str, "%s.h", name);
+	legal(fhp, str, PROJECT, HPURPOSE);
+	ptr = str;
+	while(*ptr) {
+		if ('.' == *ptr)
+			*ptr = '_';
+		else	*ptr = toupper(*ptr);
+		ptr++;
+	}
+	fprintf(fhp, "#ifndef	%s\n", str);
+	fprintf(fhp, "#define	%s\n", str);
+
+	if (async_reset)
+		fprintf(fhp, "#define\tASYNC_RESET\n");
+	fprintf(fhp, "const int	IW = %d;\n", iw);
+	fprintf(fhp, "const int	OW = %d;\n", ow);
+	fprintf(fhp, "const int	NEXTRA = %d;\n", nxtra);
+	fprintf(fhp, "const int	WW = %d;\n", working_width);
+	fprintf(fhp, "const int	PW = %d;\n", phase_bits);
+	// NSTAGES counts the radix-2 stages, so that it still tells the
+	// precision of the core, while NPIPE counts the clocks they take
+	fprintf(fhp, "const int	NSTAGES = %d;\n", nstages);
+	fprintf(fhp, "const int	NPIPE = %d;\n", npipe);
+	fprintf(fhp, "const double	QUANTIZATION_VARIANCE = %.4e; // (Units^2)\n",
+		radix4_quantization_variance(nstages,
+			working_width-iw, working_width-ow));
+	// The polar core's phase also carries the rounding errors of y
+	fprintf(fhp, "const double	PHASE_VARIANCE_RAD = %.4e; // (Radians^2)\n",
+		radix4_phase_variance(nstages, phase_bits) + ((p2r) ? 0.0
+		: radix4_vectoring_variance(nstages, iw, working_width)));
+	fprintf(fhp, "const double	GAIN = %.16f;\n", radix4_gain(nstages));
+	if (p2r) {
+		double	amplitude = (1ul<<(iw-1))-1.,
+			signal_energy, noise_energy;
+		amplitude *= (1ul<<((working_width-iw)));
+		amplitude *= radix4_gain(nstages);
+		amplitude *= pow(2.0,-(working_width-ow));
+		signal_energy = amplitude * amplitude;
+
+		noise_energy = radix4_quantization_variance(nstages,
+			working_width-iw, working_width-ow);
+		noise_energy += signal_energy
+			* radix4_phase_variance(nstages, phase_bits);
+
+		fprintf(fhp, "const double\tBEST_POSSIBLE_CNR = %.2f;\n",
+			10.0 * log(signal_energy / noise_energy) / log(10.0));
+	}
+	fprintf(fhp, "const bool\tHAS_RESET = %s;\n", with_reset?"true":"false");
+	fprintf(fhp, "const bool\tHAS_AUX   = %s;\n", with_aux?"true":"false");
+	if (with_reset)
+		fprintf(fhp, "#define\tHAS_RESET_WIRE\n");
+	if (with_aux)
+		fprintf(fhp, "#define\tHAS_AUX_WIRES\n");
+	fprintf(fhp, "#endif\t// %s\n", str);
+	delete[] str;
+}
+
+//
+// r4_aux
+//
+// Writes the o_aux delay line, NPIPE+1 stages long
+static	void	r4_aux(FILE *fp, const std::string &always_reset,
+		bool with_reset) {
+	fprintf(fp,
+"\t//\n"
+"\t// Handle the auxilliary logic.\n"
+"\t//\n"
+"\t// The auxilliary bit is designed so that you can place a valid bit into\n"
+"\t// the CORDIC function, and see when it comes out.  While the bit is\n"
+"\t// allowed to be anything, the requirement of this bit is that it *must*\n"
+"\t// be aligned with the output when done.  That is, if i_xval and i_yval\n"
+"\t// are input together with i_aux, then when the outputs are set\n"
+"\t// to this value, o_aux *must* contain the value that was in i_aux.\n"
+"\t//\n"
+"\treg\t\t[(NPIPE):0]\tax;\n"
+"\n");
+
+	fprintf(fp, "%s", always_reset.c_str());
+	if (with_reset)
+		fprintf(fp, "\t\tax <= {(NPIPE+1){1'b0}};\n\telse ");
+	fprintf(fp, "if (i_ce)\n"
+		"\t\tax <= { ax[(NPIPE-1):0], i_aux };\n"
+		"\n");
+}
+
+//
+// r4_always
+//
+// Returns the head of every always block, through its reset condition
+static	std::string	r4_always(bool with_reset, bool async_reset) {
+	if ((with_reset)&&(async_reset))
+		return "\talways @(posedge i_clk, negedge i_areset_n)\n"
+				"\tif (!i_areset_n)\n";
+	else if (with_reset)
+		return "\talways @(posedge i_clk)\n"
+				"\tif (i_reset)\n";
+	return "\talways @(posedge i_clk)\n\t";
+}
+
+void	radix4cordic(FILE *fp, FILE *fhp, const char *fname,
+		int nstages, int iw, int ow, int nxtra,
+		int phase_bits,
+		bool with_reset, bool with_aux, bool async_reset,
+		FILE *fmp) {
+	int	working_width = iw, npipe;
+	const	char *name;
+	const	char PURPOSE[] =
+	"This file executes a vector rotation on the values\n"
+	"//\t\t(i_xval, i_yval).  This vector is rotated left by\n"
+	"//\ti_phase.  i_phase is given by the angle, in radians, multiplied by\n"
+	"//\t2^32/(2pi).  In that fashion, a two pi value is zero just as a zero\n"
+	"//\tangle is zero.  Each pipeline stage applies two CORDIC rotations\n"
+	"//\tat once, as a single radix-4 digit.";
+	legal(fp, fname, PROJECT, PURPOSE);
+	if (nxtra < 1)
+		nxtra = 1;
+	assert(phase_bits >= 3);
+	assert(nstages >= 1);
+
+	if (working_width < ow)
+		working_width = ow;
+	working_width += nxtra;
+
+	npipe = (nstages + 1) / 2;
+
+	std::string	resetw = (!with_reset)?""
+			: ((async_reset)?"i_areset_n" : "i_reset");
+	std::string	always_reset = r4_always(with_reset, async_reset);
+
+	name = modulename(fname);
+
+	fprintf(fp, "`default_nettype\tnone\n//\n");
+	fprintf(fp,
+		"module	%s(i_clk, %s%si_ce, i_xval, i_yval, i_phase,%s\n"
+		"\t\to_xval, o_yval%s);\n"
+		"\tlocalparam\tIW=%2d,\t// The number of bits in our inputs\n"
+		"\t\t\tOW=%2d,\t// The number of output bits to produce\n"
+		"\t\t\tNSTAGES=%2d,\t// Radix-2 CORDIC stages\n"
+		"\t\t\tNPIPE=%2d,\t// Pipeline stages, two CORDIC stages each\n"
+		"\t\t\tXTRA=%2d,// Extra bits for internal precision\n"
+		"\t\t\tWW=%2d,\t// Our working bit-width\n"
+		"\t\t\tPW=%2d;\t// Bits in our phase variables\n"
+		"\tinput\twire\t\t\t\ti_clk, %s%si_ce;\n"
+		"\tinput\twire\tsigned\t[(IW-1):0]\t\ti_xval, i_yval;\n"
+		"\tinput\twire\t\t[(PW-1):0]\t\t\ti_phase;\n"
+		"\toutput\treg\tsigned\t[(OW-1):0]\to_xval, o_yval;\n",
+		name, resetw.c_str(), (with_reset)?", ":"",
+		(with_aux)?" i_aux,":"", (with_aux)?", o_aux":"",
+		iw, ow, nstages, npipe,
+		nxtra, working_width, phase_bits,
+		resetw.c_str(), (with_reset)?", ":"");
+
+	if (with_aux) {
+		fprintf(fp,
+			"\tinput\twire\t\t\t\ti_aux;\n"
+			"\toutput\treg\t\t\t\to_aux;\n");
+	}
+
+	fprintf(fp,
+		"\t// First step: expand our input to our working width.\n"
+		"\t// This is going to involve extending our input by one\n"
+		"\t// (or more) bits in addition to adding any xtra bits on\n"
+		"\t// bits on the right.  The one bit extra on the left is to\n"
+		"\t// allow for any accumulation due to the cordic gain\n"
+		"\t// within the algorithm.\n"
+		"\t// \n"
+		"\twire\tsigned [(WW-1):0]\te_xval, e_yval;\n");
+
+	if (working_width-iw-1 > 0) {
+		fprintf(fp,
+			"\tassign\te_xval = { {i_xval[(IW-1)]}, i_xval, {(WW-IW-1){1'b0}} };\n"
+			"\tassign\te_yval = { {i_yval[(IW-1)]}, i_yval, {(WW-IW-1){1'b0}} };\n\n");
+	} else {
+		fprintf(fp,
+			"\tassign\te_xval = { {i_xval[(IW-1)]}, i_xval };\n"
+			"\tassign\te_yval = { {i_yval[(IW-1)]}, i_yval };\n\n");
+	}
+
+	fprintf(fp,
+		"\t// Declare variables for all of the separate stages\n"
+		"\treg	signed	[(WW-1):0]	xv	[0:(NPIPE)];\n"
+		"\treg	signed	[(WW-1):0]	yv	[0:(NPIPE)];\n"
+		"\treg		[(PW-1):0]	ph	[0:(NPIPE)];\n\n");
+
+	if (with_aux)
+		r4_aux(fp, always_reset, with_reset);
+
+	fprintf(fp,
+		"\t// First stage, get rid of all but 45 degrees\n"
+		"\t//\tThe resulting phase needs to be between -45 and 45\n"
+		"\t//\t\tdegrees but in units of normalized phase\n");
+
+	fprintf(fp, "%s", always_reset.c_str());
+
+	if (with_reset)
+		fprintf(fp,
+			"\tbegin\n"
+			"\t\txv[0] <= 0;\n"
+			"\t\tyv[0] <= 0;\n"
+			"\t\tph[0] <= 0;\n"
+			"\tend else ");
+
+	fprintf(fp, "if (i_ce)\n"
+		"\tbegin\n"
+		"\t\t// Walk through all possible quick phase shifts necessary\n"
+		"\t\t// to constrain the input to within +/- 45 degrees.\n"
+		"\t\tcase(i_phase[(PW-1):(PW-3)])\n"
+		"\t\t3'b000: begin	// 0 .. 45, No change\n"
+		"\t\t\txv[0] <= e_xval;\n"
+		"\t\t\tyv[0] <= e_yval;\n"
+		"\t\t\tph[0] <= i_phase;\n"
+		"\t\t\tend\n"
+		"\t\t3'b001, 3'b010: begin	// 45 .. 135\n"
+		"\t\t\txv[0] <= -e_yval;\n"
+		"\t\t\tyv[0] <= e_xval;\n"
+		"\t\t\tph[0] <= i_phase - %d\'h%lx;\n"
+		"\t\t\tend\n"
+		"\t\t3'b011, 3'b100: begin	// 135 .. 225\n"
+		"\t\t\txv[0] <= -e_xval;\n"
+		"\t\t\tyv[0] <= -e_yval;\n"
+		"\t\t\tph[0] <= i_phase - %d\'h%lx;\n"
+		"\t\t\tend\n"
+		"\t\t3'b101, 3'b110: begin	// 225 .. 315\n"
+		"\t\t\txv[0] <= e_yval;\n"
+		"\t\t\tyv[0] <= -e_xval;\n"
+		"\t\t\tph[0] <= i_phase - %d\'h%lx;\n"
+		"\t\t\tend\n"
+		"\t\t3'b111: begin	// 315 .. 360, No change\n"
+		"\t\t\txv[0] <= e_xval;\n"
+		"\t\t\tyv[0] <= e_yval;\n"
+		"\t\t\tph[0] <= i_phase;\n"
+		"\t\t\tend\n"
+		"\t\tendcase\n"
+		"\tend\n"
+		"\n",
+		phase_bits, (1ul << (phase_bits-2)),
+		phase_bits, (2ul << (phase_bits-2)),
+		phase_bits, (3ul << (phase_bits-2)));
+
+	r4_angles(fp, nstages, working_width, phase_bits);
+
+	for(int i=0; i<npipe; i++) {
+		int	k = 2*i, n;
+
+		n = radix4_rotations(k, nstages, working_width, phase_bits);
+		fprintf(fp, "\t// Stage %d\n", i);
+		if (n == 2) {
+			const int	digit[4] = { 3, 1, -1, -3 };
+			char	pos[96], nonneg[32], neg[64], thr[32], nthr[32];
+			const char	*cond[3], *comment[4] = {
+					"Past the first angle",
+					"Short of the first angle",
+					"Short of minus the first angle",
+					"Past minus the first angle" };
+			unsigned long	t = cordic_angle_value(k, phase_bits);
+
+			// Pick the digit by comparing the phase against the
+			// first of the two angles, and its negative
+			r4_phase(thr, t, phase_bits);
+			r4_phase(nthr, (1ul << phase_bits) - t, phase_bits);
+			sprintf(pos, "(!ph[%d][(PW-1)])&&(ph[%d] >= %s)",
+				i, i, thr);
+			sprintf(nonneg, "!ph[%d][(PW-1)]", i);
+			sprintf(neg, "ph[%d] >= %s", i, nthr);
+			cond[0] = pos;
+			cond[1] = nonneg;
+			cond[2] = neg;
+			r4_stage(fp, always_reset, with_reset, i,
+				working_width, phase_bits, digit, cond,
+				comment);
+		} else {
+			char	ccw[32];
+
+			sprintf(ccw, "!ph[%d][(PW-1)]", i);
+			r2_stage(fp, always_reset, with_reset, i, phase_bits,
+				(n > 0), ccw);
+		}
+	}
+
+	if (working_width > ow+1) {
+		fprintf(fp,
+			"\t// Round our result towards even\n"
+			"\twire\t[(WW-1):0]\tpre_xval, pre_yval;\n\n"
+			"\tassign\tpre_xval = xv[NPIPE] + $signed({{(OW){1\'b0}},\n"
+				"\t\t\t\txv[NPIPE][(WW-OW)],\n"
+				"\t\t\t\t{(WW-OW-1){!xv[NPIPE][WW-OW]}}});\n"
+			"\tassign\tpre_yval = yv[NPIPE] + $signed({{(OW){1\'b0}},\n"
+				"\t\t\t\tyv[NPIPE][(WW-OW)],\n"
+				"\t\t\t\t{(WW-OW-1){!yv[NPIPE][WW-OW]}}});\n"
+			"\n");
+		fprintf(fp, "%s", always_reset.c_str());
+
+		if (with_reset)
+			fprintf(fp, "\tbegin\n"
+			"\t\to_xval <= 0;\n"
+			"\t\to_yval <= 0;\n"
+			"\tend else ");
+
+		fprintf(fp,
+			"if (i_ce)\n"
+			"\tbegin\n"
+			"\t\to_xval <= pre_xval[(WW-1):(WW-OW)];\n"
+			"\t\to_yval <= pre_yval[(WW-1):(WW-OW)];\n");
+		if (with_aux)
+			fprintf(fp,
+			"\t\to_aux <= ax[NPIPE];\n");
+		fprintf(fp, "\tend\n\n");
+
+		fprintf(fp, "\t// Make Verilator happy with pre_.val\n"
+			"\t// verilator lint_off UNUSED\n"
+			"\twire	[(2*(WW-OW)-1):0] unused_val;\n"
+			"\tassign\tunused_val = {\n"
+			"\t\tpre_xval[(WW-OW-1):0],\n"
+			"\t\tpre_yval[(WW-OW-1):0]\n"
+			"\t\t};\n"
+			"\t// verilator lint_on UNUSED\n");
+	} else {
+		fprintf(fp, "%s", always_reset.c_str());
+
+		if (with_reset)
+			fprintf(fp,
+			"\tbegin\n"
+			"\t\to_xval <= 0;\n"
+			"\t\to_yval <= 0;\n"
+			"\tend else ");
+
+		fprintf(fp,
+			"if (i_ce)\n"
+			"\tbegin\t// We accumulate a bit during our processing, so shift by one\n"
+			"\t\to_xval <= xv[NPIPE][(WW-1):(WW-OW)];\n"
+			"\t\to_yval <= yv[NPIPE][(WW-1):(WW-OW)];\n");
+		if (with_aux)
+			fprintf(fp, "\t\to_aux  <= ax[NPIPE];\n");
+		fprintf(fp, "\tend\n\n");
+	}
+
+	fprintf(fp, "endmodule\n");
+
+	if (NULL != fhp)
+		r4_header(fhp, name, nstages, npipe, iw, ow, nxtra,
+			working_width, phase_bits,
+			with_reset, with_aux, async_reset, true);
+
+	if (NULL != fmp)
+		radix4cordic_model(fmp, name, nstages, iw, ow, nxtra,
+			working_width, phase_bits);
+}
+
+void	radix4polar(FILE *fp, FILE *fhp, const char *fname,
+		int nstages, int iw, int ow, int nxtra,
+		int phase_bits,
+		bool with_reset, bool with_aux, bool async_reset,
+		FILE *fmp) {
+	int	working_width = iw, npipe;
+	const	char	*name;
+	const	char PURPOSE[] =
+	"This is a rectangular to polar conversion routine based upon an\n"
+	"//\t\tinternal CORDIC implementation.  Basically, the input is\n"
+	"//\tprovided in i_xval and i_yval.  The internal CORDIC rotator will rotate\n"
+	"//\t(i_xval, i_yval) until i_yval is approximately zero.  The resulting\n"
+	"//\txvalue and phase will be placed into o_xval and o_phase respectively.\n"
+	"//\tEach pipeline stage applies two CORDIC rotations at once, as a\n"
+	"//\tsingle radix-4 digit.";
+
+	legal(fp, fname, PROJECT, PURPOSE);
+	if (nxtra < 2)
+		nxtra = 2;
+	assert(phase_bits >= 3);
+	assert(nstages >= 1);
+
+	if (working_width < ow)
+		working_width = ow;
+	working_width += nxtra;
+
+	working_width += nxtra;
+
+	npipe = (nstages + 1) / 2;
+
+	name = modulename(fname);
+
+	std::string	resetw = (!with_reset) ? ""
+			: (async_reset) ? "i_areset_n, ":"i_reset, ";
+	std::string	always_reset = r4_always(with_reset, async_reset);
+
+	fprintf(fp, "`default_nettype\tnone\n//\n");
+	fprintf(fp,
+		"module	%s(i_clk, %si_ce, i_xval, i_yval,%s\n"
+		"\t\to_mag, o_phase%s);\n"
+		"\tlocalparam\tIW=%2d,\t// The number of bits in our inputs\n"
+		"\t\t\tOW=%2d,// The number of output bits to produce\n"
+		"\t\t\tNSTAGES=%2d,\t// Radix-2 CORDIC stages\n"
+		"\t\t\tNPIPE=%2d,\t// Pipeline stages, two CORDIC stages each\n"
+		"\t\t\tXTRA=%2d,// Extra bits for internal precision\n"
+		"\t\t\tWW=%2d,\t// Our working bit-width\n"
+		"\t\t\tPW=%2d;\t// Bits in our phase variables\n"
+		"\tinput\t\t\t\t\ti_clk, %si_ce;\n"
+		"\tinput\twire\tsigned\t[(IW-1):0]\ti_xval, i_yval;\n"
+		"\toutput\treg\tsigned\t[(OW-1):0]\to_mag;\n"
+		"\toutput\treg\t\t[(PW-1):0]\to_phase;\n",
+		name, resetw.c_str(),
+		(with_aux)?" i_aux,":"", (with_aux)?", o_aux":"",
+		iw, ow, nstages, npipe,
+		nxtra, working_width, phase_bits,
+		resetw.c_str());
+
+	if (with_aux) {
+		fprintf(fp,
+			"\tinput\twire\t\t\t\ti_aux;\n"
+			"\toutput\treg\t\t\t\to_aux;\n");
+	}
+
+	fprintf(fp,
+		"\t// First step: expand our input to our working width.\n"
+		"\t// This is going to involve extending our input by one\n"
+		"\t// (or more) bits in addition to adding any xtra bits on\n"
+		"\t// bits on the right.  The one bit extra on the left is to\n"
+		"\t// allow for any accumulation due to the cordic gain\n"
+		"\t// within the algorithm.\n"
+		"\t// \n"
+		"\twire\tsigned [(WW-1):0]\te_xval, e_yval;\n");
+
+	if (working_width-iw > 2) {
+		fprintf(fp,
+			"\tassign\te_xval = { {(2){i_xval[(IW-1)]}}, i_xval, {(WW-IW-2){1'b0}} };\n"
+			"\tassign\te_yval = { {(2){i_yval[(IW-1)]}}, i_yval, {(WW-IW-2){1'b0}} };\n\n");
+	} else {
+		fprintf(fp,
+			"\tassign\te_xval = { {(2){i_xval[(IW-1)]}}, i_xval };\n"
+			"\tassign\te_yval = { {(2){i_yval[(IW-1)]}}, i_yval };\n\n");
+	}
+
+	fprintf(fp,
+		"\t// Declare variables for all of the separate stages\n"
+		"\treg	signed	[(WW-1):0]	xv	[0:NPIPE];\n"
+		"\treg	signed	[(WW-1):0]	yv	[0:NPIPE];\n"
+		"\treg		[(PW-1):0]	ph	[0:NPIPE];\n\n");
+
+	if (with_aux)
+		r4_aux(fp, always_reset, with_reset);
+
+	fprintf(fp,
+		"\t// First stage, map to within +/- 45 degrees\n"
+		"%s", always_reset.c_str());
+	if (with_reset)
+		fprintf(fp,
+			"\tbegin\n"
+			"\t\txv[0] <= 0;\n"
+			"\t\tyv[0] <= 0;\n"
+			"\t\tph[0] <= 0;\n"
+			"\tend else ");
+	fprintf(fp, "if (i_ce)\n\t\t");
+
+	fprintf(fp,
+		"case({i_xval[IW-1], i_yval[IW-1]})\n"
+		"\t\t2\'b01: begin // Rotate by -315 degrees\n"
+		"\t\t\txv[0] <=  e_xval - e_yval;\n"
+		"\t\t\tyv[0] <=  e_xval + e_yval;\n"
+		"\t\t\tph[0] <= %d\'h%lx;\n"
+		"\t\t\tend\n"
+		"\t\t2\'b10: begin // Rotate by -135 degrees\n"
+		"\t\t\txv[0] <= -e_xval + e_yval;\n"
+		"\t\t\tyv[0] <= -e_xval - e_yval;\n"
+		"\t\t\tph[0] <= %d\'h%lx;\n"
+		"\t\t\tend\n"
+		"\t\t2\'b11: begin // Rotate by -225 degrees\n"
+		"\t\t\txv[0] <= -e_xval - e_yval;\n"
+		"\t\t\tyv[0] <=  e_xval - e_yval;\n"
+		"\t\t\tph[0] <= %d\'h%lx;\n"
+		"\t\t\tend\n"
+		"\t\t// 2\'b00:\n"
+		"\t\tdefault: begin // Rotate by -45 degrees\n"
+		"\t\t\txv[0] <=  e_xval + e_yval;\n"
+		"\t\t\tyv[0] <= -e_xval + e_yval;\n"
+		"\t\t\tph[0] <= %d\'h%lx;\n"
+		"\t\t\tend\n"
+		"\t\tendcase\n\n",
+		phase_bits, (7ul << (phase_bits-3)),
+		phase_bits, (3ul << (phase_bits-3)),
+		phase_bits, (5ul << (phase_bits-3)),
+		phase_bits, (1ul << (phase_bits-3)));
+
+	r4_angles(fp, nstages, working_width, phase_bits);
+
+	for(int i=0; i<npipe; i++) {
+		int	k = 2*i, n;
+
+		n = radix4_rotations(k, nstages, working_width, phase_bits);
+		fprintf(fp, "\t// Stage %d\n", i);
+		if (n == 2) {
+			const int	digit[4] = { 3, 1, -3, -1 };
+			char	below[32], rbelow[64], rabove[32];
+			const char	*cond[3], *comment[4] = {
+					"Below the axis, even once rotated",
+					"Below the axis, until rotated",
+					"Above the axis, even once rotated",
+					"Above the axis, until rotated" };
+
+			// Pick the digit from the sign of y, both before and
+			// after the first of the two rotations
+			fprintf(fp,
+			"\twire\tsigned\t[(WW-1):0]\try%d;\n\n"
+			"\tassign\try%d = (yv[%d][(WW-1)]) ? (yv[%d] + (xv[%d]>>>%d))\n"
+			"\t\t\t: (yv[%d] - (xv[%d]>>>%d));\n\n",
+				i, i, i, i, i, k+1, i, i, k+1);
+
+			sprintf(below, "yv[%d][(WW-1)]", i);
+			sprintf(rbelow, "(%s)&&(ry%d[(WW-1)])", below, i);
+			sprintf(rabove, "!ry%d[(WW-1)]", i);
+			cond[0] = rbelow;
+			cond[1] = below;
+			cond[2] = rabove;
+			r4_stage(fp, always_reset, with_reset, i,
+				working_width, phase_bits, digit, cond,
+				comment);
+		} else {
+			char	ccw[32];
+
+			sprintf(ccw, "yv[%d][(WW-1)]", i);
+			r2_stage(fp, always_reset, with_reset, i, phase_bits,
+				(n > 0), ccw);
+		}
+	}
+
+	if (working_width > ow+1) {
+		fprintf(fp,
+			"\t// Round our magnitude towards even\n"
+			"\twire\t[(WW-1):0]\tpre_mag;\n\n"
+			"\tassign\tpre_mag = xv[NPIPE] + $signed({{(OW){1\'b0}},\n"
+				"\t\t\t\txv[NPIPE][(WW-OW)],\n"
+				"\t\t\t\t{(WW-OW-1){!xv[NPIPE][WW-OW]}}});\n"
+			"\n");
+
+		fprintf(fp, "%s", always_reset.c_str());
+		if (with_reset) {
+			fprintf(fp,
+				"\tbegin\n"
+				"\t\to_mag   <= 0;\n"
+				"\t\to_phase <= 0;\n");
+			if (with_aux)
+				fprintf(fp,
+				"\t\to_aux <= 0;\n");
+			fprintf(fp, "\tend else ");
+		}
+
+		fprintf(fp, "if (i_ce)\n"
+			"\tbegin\n"
+			"\t\to_mag   <= pre_mag[(WW-1):(WW-OW)];\n"
+			"\t\to_phase <= ph[NPIPE];\n");
+		if (with_aux)
+			fprintf(fp,
+			"\t\to_aux <= ax[NPIPE];\n");
+		fprintf(fp, "\tend\n\n");
+
+		fprintf(fp, "\t// Make Verilator happy with pre_.val\n"
+			"\t// verilator lint_off UNUSED\n"
+			"\twire	[(WW-OW):0] unused_val;\n"
+			"\tassign\tunused_val = {"
+			" pre_mag[WW-1], pre_mag[(WW-OW-1):0] };\n"
+			"\t// verilator lint_on UNUSED\n");
+	} else {
+		fprintf(fp, "%s", always_reset.c_str());
+
+		if (with_reset) {
+			fprintf(fp, "\tbegin\n"
+			"\t\to_mag   <= 0;\n"
+			"\t\to_phase <= 0;\n");
+			if (with_aux)
+				fprintf(fp, "\t\to_aux  <= 0;\n");
+			fprintf(fp, "\tend else ");
+		}
+
+		fprintf(fp, "if (i_ce)\n"
+			"\tbegin\t// We accumulate a bit during our processing, so shift by one\n"
+			"\t\to_mag   <= xv[NPIPE][(WW-1):(WW-OW)];\n"
+			"\t\to_phase <= ph[NPIPE];\n");
+		if (with_aux)
+			fprintf(fp, "\t\to_aux  <= ax[NPIPE];\n");
+		fprintf(fp, "\tend\n\n");
+	}
+
+	fprintf(fp, "endmodule\n");
+
+	if (NULL != fhp)
+		r4_header(fhp, name, nstages, npipe, iw, ow, nxtra,
+			working_width, phase_bits,
+			with_reset, with_aux, async_reset, false);
+
+	if (NULL != fmp)
+		radix4polar_model(fmp, name, nstages, iw, ow, nxtra,
+			working_width, phase_bits);
+}
@@ -45,10 +45,265 @@
 #include "legal.h"
 #include "cordiclib.h"
 #include "topolar.h"
+#include "seqpolar.h"
+#include "lanes.h"
+#include "engines.h"
+#include "swmodel.h"
+
+//
+// seqpolar_engine
+//
+// Writes out everything following the angle table for a core with only the
+// one engine.
+//
+static	void	seqpolar_engine(FILE *fp, int nstages, int working_width,
+		int ow, bool with_reset, bool with_aux,
+		const std::string &always_reset) {
+	fprintf(fp, "\n\treg\t\tidle, pre_valid;\n");
+	fprintf(fp, "\treg\t[%d:0]\tstate;\n\n",
+			nextlg((unsigned)nstages+1)-1);
+	fprintf(fp, "\twire	last_state;\n");
+	fprintf(fp, "\tassign	last_state = (state >= %d);\n", nstages+1);
+	fprintf(fp,
+		"\n\tinitial\tidle = 1\'b1;\n%s", always_reset.c_str());
+	if (with_reset)
+		fprintf(fp, "\t\tidle <= 1\'b1;\n\telse ");
+	else
+		fprintf(fp, "\t");
+	fprintf(fp, "if (i_stb)\n"
+			"\t\tidle <= 1\'b0;\n"
+			"\telse if (last_state)\n"
+			"\t\tidle <= 1\'b1;\n\n");
+
+	fprintf(fp,
+		"\tinitial\tpre_valid = 1\'b0;\n%s", always_reset.c_str());
+	if (with_reset)
+		fprintf(fp, "\t\tpre_valid <= 1\'b0;\n\telse\n");
+	fprintf(fp, "\t\tpre_valid <= (i_stb)&&(idle);\n\n");
+
+
+	fprintf(fp,
+		"\tinitial\tstate = 0;\n%s", always_reset.c_str());
+	if (with_reset)
+		fprintf(fp, "\t\tstate <= 0;\n\telse ");
+	else
+		fprintf(fp, "\t");
+	fprintf(fp, "if (idle)\n"
+			"\t\tstate <= 0;\n"
+		"\telse if (last_state)\n"
+			"\t\tstate <= 0;\n"
+		"\telse\n"
+			"\t\tstate <= state + 1;\n\n");
+
+
+	fprintf(fp,
+		"\talways @(posedge i_clk)\n"
+		"\t\tcangle <= cordic_angle[state[%d:0]];\n\n",
+			nextlg((unsigned)nstages)-1);
+
+	fprintf(fp,
+		"\t// Here\'s where we are going to put the actual CORDIC\n"
+		"\t// rectangular to polar loop.  Everything up to this\n"
+		"\t// point has simply been necessary preliminaries.\n");
+
+	fprintf(fp, "\talways @(posedge i_clk)\n"
+		"\tif (pre_valid)\n"
+		"\tbegin\n"
+		"\t\txv <= prex;\n"
+		"\t\tyv <= prey;\n"
+		"\t\tph <= preph;\n"
+		"\tend else if (yv[(WW-1)]) // Below the axis\n"
+		"\tbegin\n"
+		"\t\t// If the vector is below the x-axis, rotate by\n"
+		"\t\t// the CORDIC angle in a positive direction.\n"
+		"\t\txv <= xv - (yv>>>state);\n"
+		"\t\tyv <= yv + (xv>>>state);\n"
+		"\t\tph <= ph - cangle;\n"
+		"\tend else begin\n"
+		"\t\t// On the other hand, if the vector is above the\n"
+		"\t\t// x-axis, then rotate in the other direction\n"
+		"\t\txv <= xv + (yv>>>state);\n"
+		"\t\tyv <= yv - (xv>>>state);\n"
+		"\t\tph <= ph + cangle;\n"
+		"\tend\n\n");
+
+	fprintf(fp, "%s", always_reset.c_str());
+	if (with_reset)
+		fprintf(fp, "\t\to_done <= 1\'b0;\n\telse\n");
+	fprintf(fp, "\t\to_done <= (last_state);\n\n");
+
+	if (working_width > ow+1) {
+		fprintf(fp,
+			"\t// Round our magnitude towards even\n"
+			"\twire\t[(WW-1):0]\tfinal_mag;\n\n"
+			"\tassign\tfinal_mag = xv + $signed({{(OW){1\'b0}},\n"
+				"\t\t\t\txv[(WW-OW)],\n"
+				"\t\t\t\t{(WW-OW-1){!xv[WW-OW]}}});\n"
+			"\n");
+
+
+		fprintf(fp, "\talways @(posedge i_clk)\n");
+		fprintf(fp,
+			"\tif (last_state)\n"
+			"\tbegin\n"
+			"\t\to_mag   <= final_mag[(WW-1):(WW-OW)];\n");
+	} else {
+		fprintf(fp, "\talways @(posedge i_clk)\n");
+		fprintf(fp,
+			"\tif (last_state)\n"
+			"\tbegin\t// We accumulate a bit during our processing, so shift by one\n"
+			"\t\to_mag   <= xv[(WW-1):(WW-OW)];\n");
+	}
+
+	fprintf(fp, "\t\to_phase <= ph;\n");
+	if (with_aux)
+		fprintf(fp,
+			"\t\to_aux <= aux;\n");
+	fprintf(fp, "\tend\n\n");
+
+	fprintf(fp, "\tassign\to_busy = !idle;\n\n");
+
+	if (working_width > ow+1) {
+		fprintf(fp, "\t// Make Verilator happy with pre_.val\n"
+			"\t// verilator lint_off UNUSED\n"
+			"\twire	[(WW-OW):0] unused_val;\n"
+			"\tassign\tunused_val = {"
+			" final_mag[WW-1], final_mag[(WW-OW-1):0] };\n"
+			"\t// verilator lint_on UNUSED\n");
+	}
+}
+
+//
+// seqpolar_engines
+//
+// Writes out everything following the angle table for a core built from
+// nengines engines.  Each engine is the one engine of seqpolar_engine(),
+// clock for clock, so that every sample sees just the same steps.
+//
+static	void	seqpolar_engines(FILE *fp, int nstages, int working_width,
+		int ow, bool with_reset, bool with_aux, bool async_reset,
+		int nengines) {
+	std::string	always_reset = lane_always("\t", with_reset, async_reset),
+			engine_reset = lane_always("\t\t", with_reset, async_reset);
+
+	engines_dispatch(fp, nengines, with_reset, async_reset);
+
+	fprintf(fp,
+		"\treg	signed	[(WW-1):0]	xv [0:(NENGINES-1)];\n"
+		"\treg	signed	[(WW-1):0]	yv [0:(NENGINES-1)];\n"
+		"\treg		[(PW-1):0]	ph [0:(NENGINES-1)];\n"
+		"\treg		[%d:0]		state [0:(NENGINES-1)];\n",
+		nextlg((unsigned)nstages+1)-1);
+	if (with_aux)
+		fprintf(fp,
+		"\t// Each engine keeps the aux bit of its own sample, so that it\n"
+		"\t// comes back out alongside that sample\'s result\n"
+		"\treg	[(NENGINES-1):0]	aux;\n");
+
+	fprintf(fp, "\n"
+		"\tgenvar	k;\n"
+		"\tgenerate for(k=0; k<NENGINES; k=k+1) begin : ENGINE\n"
+		"\t\tassign\tlast_state[k] = (state[k] >= %d);\n\n",
+		nstages+1);
+
+	fprintf(fp, "\t\tinitial\tidle[k] = 1\'b1;\n%s", engine_reset.c_str());
+	if (with_reset)
+		fprintf(fp, "\t\t\tidle[k] <= 1\'b1;\n\t\telse ");
+	fprintf(fp, "if (start[k])\n"
+			"\t\t\tidle[k] <= 1\'b0;\n"
+			"\t\telse if (last_state[k])\n"
+			"\t\t\tidle[k] <= 1\'b1;\n\n");
+
+	fprintf(fp, "\t\tinitial\tstate[k] = 0;\n%s", engine_reset.c_str());
+	if (with_reset)
+		fprintf(fp, "\t\t\tstate[k] <= 0;\n\t\telse ");
+	fprintf(fp, "if ((idle[k])||(last_state[k]))\n"
+			"\t\t\tstate[k] <= 0;\n"
+			"\t\telse\n"
+			"\t\t\tstate[k] <= state[k] + 1;\n\n");
+
+	fprintf(fp, "\t\t// This engine\'s own read of the angle table\n"
+			"\t\talways @(posedge i_clk)\n"
+			"\t\t\tcangle[k] <= cordic_angle[state[k][%d:0]];\n\n",
+			nextlg((unsigned)nstages)-1);
+
+	if (with_aux) {
+		fprintf(fp, "%s", engine_reset.c_str());
+		if (with_reset)
+			fprintf(fp, "\t\t\taux[k] <= 0;\n\t\telse ");
+		fprintf(fp, "if (start[k])\n"
+			"\t\t\taux[k] <= i_aux;\n\n");
+	}
+
+	fprintf(fp, "\t\talways @(posedge i_clk)\n"
+		"\t\tif (pre_valid[k])\n"
+		"\t\tbegin\n"
+		"\t\t\txv[k] <= prex;\n"
+		"\t\t\tyv[k] <= prey;\n"
+		"\t\t\tph[k] <= preph;\n"
+		"\t\tend else if (yv[k][(WW-1)]) // Below the axis\n"
+		"\t\tbegin\n"
+		"\t\t\txv[k] <= xv[k] - (yv[k]>>>state[k]);\n"
+		"\t\t\tyv[k] <= yv[k] + (xv[k]>>>state[k]);\n"
+		"\t\t\tph[k] <= ph[k] - cangle[k];\n"
+		"\t\tend else begin\n"
+		"\t\t\txv[k] <= xv[k] + (yv[k]>>>state[k]);\n"
+		"\t\t\tyv[k] <= yv[k] - (xv[k]>>>state[k]);\n"
+		"\t\t\tph[k] <= ph[k] + cangle[k];\n"
+		"\t\tend\n"
+		"\tend endgenerate\n\n");
+
+	fprintf(fp,
+		"\t// Only the engine finishing its sample gets rounded\n"
+		"\twire\tsigned\t[(WW-1):0]\trd_xv;\n"
+		"\twire\t[(WW-1):0]\tfinal_mag;\n\n"
+		"\tassign\trd_xv = xv[rd_engine];\n\n");
+	if (working_width > ow+1)
+		fprintf(fp,
+			"\t// Round our magnitude towards even\n"
+			"\tassign\tfinal_mag = rd_xv + $signed({{(OW){1\'b0}},\n"
+				"\t\t\t\trd_xv[(WW-OW)],\n"
+				"\t\t\t\t{(WW-OW-1){!rd_xv[WW-OW]}}});\n"
+			"\n");
+	else
+		fprintf(fp, "\tassign\tfinal_mag = rd_xv;\n\n");
+
+	fprintf(fp, "\tinitial\to_done = 1\'b0;\n%s", always_reset.c_str());
+	if (with_reset)
+		fprintf(fp, "\t\to_done <= 1\'b0;\n\telse\n\t");
+	fprintf(fp, "\to_done <= last_state[rd_engine];\n\n");
+
+	fprintf(fp, "\talways @(posedge i_clk)\n"
+		"\tif (last_state[rd_engine])\n"
+		"\tbegin\n"
+		"\t\to_mag   <= final_mag[(WW-1):(WW-OW)];\n"
+		"\t\to_phase <= ph[rd_engine];\n");
+	if (with_aux)
+		fprintf(fp,
+		"\t\to_aux <= aux[rd_engine];\n");
+	fprintf(fp, "\tend\n\n");
+
+	fprintf(fp, "\tassign\to_busy = !idle[wr_engine];\n\n");
+
+	if (working_width > ow+1) {
+		fprintf(fp, "\t// Make Verilator happy with pre_.val\n"
+			"\t// verilator lint_off UNUSED\n"
+			"\twire	[(WW-OW):0] unused_val;\n"
+			"\tassign\tunused_val = {"
+			" final_mag[WW-1], final_mag[(WW-OW-1):0] };\n"
+			"\t// verilator lint_on UNUSED\n");
+	} else if (working_width > ow) {
+		fprintf(fp, "\t// Make Verilator happy with pre_.val\n"
+			"\t// verilator lint_off UNUSED\n"
+			"\twire	[(WW-OW-1):0] unused_val;\n"
+			"\tassign\tunused_val = final_mag[(WW-OW-1):0];\n"
+			"\t// verilator lint_on UNUSED\n");
+	}
+}
 
 void	seqpolar(FILE *fp, FILE *fhp, const char *fname, int nstages, int iw, int ow,
 		int nxtra, int phase_bits, bool with_reset, bool with_aux,
-		bool async_reset) {
+		bool async_reset, FILE *fmp, int nengines) {
 	int	working_width = iw;
 	const	char	*name;
 	const	char PURPOSE[] =
@@ -142,11 +397,17 @@ void	seqpolar(FILE *fp, FILE *fhp, const char *fname, int nstages, int iw, int o
 	fprintf(fp,
 		"\t// Declare variables for all of the separate stages\n");
 
-	fprintf(fp,
-		"\treg	signed	[(WW-1):0]	xv, yv, prex, prey;\n"
-		"\treg		[(PW-1):0]	ph, preph;\n\n");
+	if (nengines > 1)
+		fprintf(fp,
+			"\treg	signed	[(WW-1):0]	prex, prey;\n"
+			"\treg		[(PW-1):0]	preph;\n\n");
+	else
+		fprintf(fp,
+			"\treg	signed	[(WW-1):0]	xv, yv, prex, prey;\n"
+			"\treg		[(PW-1):0]	ph, preph;\n\n");
 
-	if (with_aux) {
+	// With several engines, each keeps its own aux bit
+	if ((with_aux)&&(nengines <= 1)) {
 		fprintf(fp,
 "\t//\n"
 "\t// Handle the auxilliary logic.\n"
@@ -212,120 +473,14 @@ void	seqpolar(FILE *fp, FILE *fhp, const char *fname, int nstages, int iw, int o
 		"\t\tendcase\n",
 			phase_bits, (1ul << (phase_bits-3)));
 
-	cordic_angles(fp, nstages, phase_bits, true);
+	cordic_angles(fp, nstages, phase_bits, true, nengines);
 
-	fprintf(fp, "\n\treg\t\tidle, pre_valid;\n");
-	fprintf(fp, "\treg\t[%d:0]\tstate;\n\n",
-			nextlg((unsigned)nstages+1)-1);
-	fprintf(fp, "\twire	last_state;\n");
-	fprintf(fp, "\tassign	last_state = (state >= %d);\n", nstages+1);
-	fprintf(fp,
-		"\n\tinitial\tidle = 1\'b1;\n%s", always_reset.c_str());
-	if (with_reset)
-		fprintf(fp, "\t\tidle <= 1\'b1;\n\telse ");
+	if (nengines > 1)
+		seqpolar_engines(fp, nstages, working_width, ow, with_reset,
+			with_aux, async_reset, nengines);
 	else
-		fprintf(fp, "\t");
-	fprintf(fp, "if (i_stb)\n"
-			"\t\tidle <= 1\'b0;\n"
-			"\telse if (last_state)\n"
-			"\t\tidle <= 1\'b1;\n\n");
-
-	fprintf(fp,
-		"\tinitial\tpre_valid = 1\'b0;\n%s", always_reset.c_str());
-	if (with_reset)
-		fprintf(fp, "\t\tpre_valid <= 1\'b0;\n\telse\n");
-	fprintf(fp, "\t\tpre_valid <= (i_stb)&&(idle);\n\n");
-
-
-	fprintf(fp,
-		"\tinitial\tstate = 0;\n%s", always_reset.c_str());
-	if (with_reset)
-		fprintf(fp, "\t\tstate <= 0;\n\telse ");
-	else
-		fprintf(fp, "\t");
-	fprintf(fp, "if (idle)\n"
-			"\t\tstate <= 0;\n"
-		"\telse if (last_state)\n"
-			"\t\tstate <= 0;\n"
-		"\telse\n"
-			"\t\tstate <= state + 1;\n\n");
-
-
-	fprintf(fp,
-		"\talways @(posedge i_clk)\n"
-		"\t\tcangle <= cordic_angle[state[%d:0]];\n\n",
-			nextlg((unsigned)nstages)-1);
-
-	fprintf(fp,
-		"\t// Here\'s where we are going to put the actual CORDIC\n"
-		"\t// rectangular to polar loop.  Everything up to this\n"
-		"\t// point has simply been necessary preliminaries.\n");
-
-	fprintf(fp, "\talways @(posedge i_clk)\n"
-		"\tif (pre_valid)\n"
-		"\tbegin\n"
-		"\t\txv <= prex;\n"
-		"\t\tyv <= prey;\n"
-		"\t\tph <= preph;\n"
-		"\tend else if (yv[(WW-1)]) // Below the axis\n"
-		"\tbegin\n"
-		"\t\t// If the vector is below the x-axis, rotate by\n"
-		"\t\t// the CORDIC angle in a positive direction.\n"
-		"\t\txv <= xv - (yv>>>state);\n"
-		"\t\tyv <= yv + (xv>>>state);\n"
-		"\t\tph <= ph - cangle;\n"
-		"\tend else begin\n"
-		"\t\t// On the other hand, if the vector is above the\n"
-		"\t\t// x-axis, then rotate in the other direction\n"
-		"\t\txv <= xv + (yv>>>state);\n"
-		"\t\tyv <= yv - (xv>>>state);\n"
-		"\t\tph <= ph + cangle;\n"
-		"\tend\n\n");
-
-	fprintf(fp, "%s", always_reset.c_str());
-	if (with_reset)
-		fprintf(fp, "\t\to_done <= 1\'b0;\n\telse\n");
-	fprintf(fp, "\t\to_done <= (last_state);\n\n");
-
-	if (working_width > ow+1) {
-		fprintf(fp,
-			"\t// Round our magnitude towards even\n"
-			"\twire\t[(WW-1):0]\tfinal_mag;\n\n"
-			"\tassign\tfinal_mag = xv + $signed({{(OW){1\'b0}},\n"
-				"\t\t\t\txv[(WW-OW)],\n"
-				"\t\t\t\t{(WW-OW-1){!xv[WW-OW]}}});\n"
-			"\n");
-
-
-		fprintf(fp, "\talways @(posedge i_clk)\n");
-		fprintf(fp,
-			"\tif (last_state)\n"
-			"\tbegin\n"
-			"\t\to_mag   <= final_mag[(WW-1):(WW-OW)];\n");
-	} else {
-		fprintf(fp, "\talways @(posedge i_clk)\n");
-		fprintf(fp,
-			"\tif (last_state)\n"
-			"\tbegin\t// We accumulate a bit during our processing, so shift by one\n"
-			"\t\to_mag   <= xv[(WW-1):(WW-OW)];\n");
-	}
-
-	fprintf(fp, "\t\to_phase <= ph;\n");
-	if (with_aux)
-		fprintf(fp,
-			"\t\to_aux <= aux;\n");
-	fprintf(fp, "\tend\n\n");
-
-	fprintf(fp, "\tassign\to_busy = !idle;\n\n");
-
-	if (working_width > ow+1) {
-		fprintf(fp, "\t// Make Verilator happy with pre_.val\n"
-			"\t// verilator lint_off UNUSED\n"
-			"\twire	[(WW-OW):0] unused_val;\n"
-			"\tassign\tunused_val = {"
-			" final_mag[WW-1], final_mag[(WW-OW-1):0] };\n"
-			"\t// verilator lint_on UNUSED\n");
-	}
+		seqpolar_engine(fp, nstages, working_width, ow, with_reset,
+			with_aux, always_reset);
 
 	fprintf(fp, "endmodule\n");
 
@@ -349,6 +504,8 @@ void	seqpolar(FILE *fp, FILE *fhp, const char *fname, int nstages, int iw, int o
 		fprintf(fhp, "#undef\tCLOCKS_PER_OUTPUT\n");
 		fprintf(fhp, "#endif\t// CLOCKS_PER_OUTPUT\n");
 		fprintf(fhp, "#define\tCLOCKS_PER_OUTPUT\t%d\n", nstages+3);
+		if (nengines > 1)
+			fprintf(fhp, "#define\tNENGINES\t%d\n", nengines);
 
 		fprintf(fhp, "const int	IW = %d;\n", iw);
 		fprintf(fhp, "const int	OW = %d;\n", ow);
@@ -373,4 +530,8 @@ void	seqpolar(FILE *fp, FILE *fhp, const char *fname, int nstages, int iw, int o
 
 		delete[] str;
 	}
+
+	if (NULL != fmp)
+		seqpolar_model(fmp, name, nstages, iw, ow, nxtra,
+			working_width, phase_bits);
 }
@@ -44,6 +44,7 @@ extern	void	seqpolar(FILE *fp, FILE *fhp, const char *fname,
 			int nstages, int iw, int ow, int nxtra,
 			int phase_bits=32,
 			bool with_reset=true, bool with_aux = true,
-			bool async_reset = false);
+			bool async_reset = false, FILE *fmp = NULL,
+			int nengines = 1);
 
 #endif	// SEQPOLAR_H
@@ -43,112 +43,475 @@
 #include <string.h>
 #include <string>
 #include <math.h>
+#include <float.h>
+#include <unistd.h>
+#include <pthread.h>
 #include <assert.h>
 #include "hexfile.h"
 
 #include "legal.h"
+#include "swmodel.h"
+#include "lanes.h"
 
-void	sintable(FILE *fp, const char *fname, int lgtable, int ow,
-		bool with_reset, bool with_aux, bool async_reset) {
-	char	*name;
-	const	char	PURPOSE[] =
-	"This is a very simple sinewave table lookup approach\n"
-	"//\t\tapproach to generating a sine wave.  It has the lowest latency\n"
-	"//\tamong all sinewave generation alternatives.";
+//
+// Building a table by calling sin() once per entry gets slow when the table
+// has millions of entries.  Instead, the sine wave is built a block at a time
+// by rotating a phasor, (cos, sin), through each table step, starting every
+// block from a fresh call to sin() and cos() so that round-off never has
+// the chance to build up.  For the full sinewave table, only the first
+// quadrant is built this way--the rest is mirrored from it.
+//
+// The result must match, bit for bit, what calling sin() for every entry
+// would produce.  The rotation's error is bounded, so for every entry we
+// check that truncating anywhere within that bound gives the same integer.
+// The few that don't are then computed the slow way.
+//
+static	const	int	SINTBL_BLOCK = 256;
+
+//
+// Tables with fewer entries than this are just built by the calling thread
+static	const	int	SINTBL_MIN_PARALLEL = (1<<16);
+
+typedef	struct	{
+	long	*tbl, maxv;
+	int	lgtable, first, last;
+	bool	quarterwav;
+} SINTBL_WORK;
+
+//
+// sintbl_entry
+//
+// The slow way: exactly the value the table has always held
+static	long	sintbl_entry(long maxv, int lgtable, int k, bool quarterwav) {
+	int	tbl_entries = (1<<lgtable);
+	double	ph;
+
+	ph = 2.0 * M_PI * (double)k / (double)tbl_entries;
+	if (quarterwav)
+		ph+=       M_PI             / (double)tbl_entries;
+	return (long)((double)maxv * sin(ph));
+}
+
+//
+// sintbl_check
+//
+// Returns the table value for v, known to be within err of maxv * sin(),
+// or calls sintbl_entry() if the two could truncate differently.
+static	inline	long	sintbl_check(double v, double err, long maxv,
+			int lgtable, int k, bool quarterwav) {
+	long	lo = (long)(v - err), hi = (long)(v + err);
+
+	if (lo == hi)
+		return lo;
+	return sintbl_entry(maxv, lgtable, k, quarterwav);
+}
 
-	if (lgtable >= 24) {
-		fprintf(stderr, "ERR: Requested table size is greater than 16M\n\n");
-		fprintf(stderr, "While this is an arbitrary limit, few FPGA's have this kind of\n");
-		fprintf(stderr, "block RAM.  If you know what you are doing, you can change this\n");
-		fprintf(stderr, "limit up to perhaps 30 without much hassle.  Beyond that, be\n");
-		fprintf(stderr, "aware of integer overflow.\n");
-		exit(EXIT_FAILURE);
+static	void	*sintbl_worker(void *arg) {
+	SINTBL_WORK	*w = (SINTBL_WORK *)arg;
+	int	tbl_entries = (1<<w->lgtable), hlf = tbl_entries/2;
+	double	dph = 2.0 * M_PI / (double)tbl_entries,
+		cd = cos(dph), sd = sin(dph),
+		fmaxv = (double)w->maxv,
+		err;
+
+	// Rotating by dph costs us a few LSBs of round-off per step, and
+	// the phase of each entry may itself be off by an LSB or two of
+	// its own.  This is a generous bound on both.
+	err = fmaxv * (8.0 * SINTBL_BLOCK + 64.0) * DBL_EPSILON;
+
+	for(int blk=w->first; blk<w->last; blk+=SINTBL_BLOCK) {
+		double	ph, c, s;
+		int	end = blk + SINTBL_BLOCK;
+
+		if (end > w->last)
+			end = w->last;
+
+		ph = dph * blk;
+		if (w->quarterwav)
+			ph += dph / 2.0;
+		c = cos(ph);
+		s = sin(ph);
+
+		for(int k=blk; k<end; k++) {
+			double	v = fmaxv * s, t;
+
+			if (w->quarterwav) {
+				w->tbl[k] = sintbl_check(v, err, w->maxv,
+						w->lgtable, k, true);
+			} else {
+				// Mirror the first quadrant into the rest
+				// of the table
+				w->tbl[k] = sintbl_check(v, err, w->maxv,
+						w->lgtable, k, false);
+				if (k != 0)
+					w->tbl[tbl_entries-k]
+						= sintbl_check(-v, err,
+						w->maxv, w->lgtable,
+						tbl_entries-k, false);
+				if (k != tbl_entries/4) {
+					w->tbl[hlf-k] = sintbl_check(v, err,
+						w->maxv, w->lgtable,
+						hlf-k, false);
+					w->tbl[hlf+k] = sintbl_check(-v, err,
+						w->maxv, w->lgtable,
+						hlf+k, false);
+				}
+			}
+
+			t = c * cd - s * sd;
+			s = s * cd + c * sd;
+			c = t;
+		}
 	}
 
-	legal(fp, fname, PROJECT, PURPOSE);
-	fprintf(fp, "`default_nettype\tnone\n//\n");
-	name = modulename(fname);
+	return NULL;
+}
+
+//
+// sintbl_fill
+//
+// Fills tbl with either a full sinewave table of (1<<lgtable) entries or,
+// if quarterwav is set, the (1<<(lgtable-2)) entries of a quarter wave
+// table offset by half a step.  The work is split across threads, on block
+// boundaries, for any large table.
+//
+static	void	sintbl_fill(long *tbl, int lgtable, long maxv, bool quarterwav) {
+	int	tbl_entries = (1<<lgtable), nwork, nthreads = 1;
+	SINTBL_WORK	*work;
+	pthread_t	*threads;
+
+	// For the full table, work through the first quadrant, including
+	// the peak, and mirror the rest
+	nwork = (quarterwav) ? tbl_entries/4 : tbl_entries/4+1;
+	if (tbl_entries >= SINTBL_MIN_PARALLEL)
+		nthreads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+	if (nthreads < 1)
+		nthreads = 1;
+
+	work    = new SINTBL_WORK[nthreads];
+	threads = new pthread_t[nthreads];
+	for(int k=0; k<nthreads; k++) {
+		long	nblocks = (nwork+SINTBL_BLOCK-1)/SINTBL_BLOCK;
+
+		work[k].tbl     = tbl;
+		work[k].maxv    = maxv;
+		work[k].lgtable = lgtable;
+		work[k].quarterwav = quarterwav;
+		work[k].first   = (int)(nblocks *  k    / nthreads) * SINTBL_BLOCK;
+		work[k].last    = (int)(nblocks * (k+1) / nthreads) * SINTBL_BLOCK;
+		if (work[k].last > nwork)
+			work[k].last = nwork;
+	}
+
+	if (nthreads == 1)
+		sintbl_worker(&work[0]);
+	else {
+		int	nstarted;
+
+		// Should we run out of threads, whatever work is left gets
+		// done right here instead
+		for(nstarted=0; nstarted<nthreads; nstarted++)
+			if (0 != pthread_create(&threads[nstarted], NULL,
+					sintbl_worker, &work[nstarted]))
+				break;
+		for(int k=nstarted; k<nthreads; k++)
+			sintbl_worker(&work[k]);
+		for(int k=0; k<nstarted; k++)
+			pthread_join(threads[k], NULL);
+	}
+
+	delete[] threads;
+	delete[] work;
+}
 
+//
+// sintable_lanes
+//
+// The module for a sinewave table taking nlanes phases per clock.  Each copy
+// of the table is read from both of its ports, so one copy serves two lanes.
+static	void	sintable_lanes(FILE *fp, const char *name, int lgtable,
+			int ow, int nlanes, bool with_reset, bool with_aux,
+			bool async_reset) {
 	std::string	resetw = (!with_reset) ? ""
 				: (async_reset) ? "i_areset_n, ":"i_reset, ";
-	std::string	always_reset;
-	if ((with_reset)&&(async_reset))
-		always_reset = "\talways @(posedge i_clk, negedge i_areset_n)\n"
-			"\tif (!i_areset_n)\n";
-	else if (with_reset)
-		always_reset = "\talways @(posedge i_clk)\n"
-			"\tif (i_reset)\n";
-	else
-		always_reset = "\talways @(posedge i_clk)\n\t";
 
 	fprintf(fp,
 		"module	%s(i_clk, %si_ce, %si_phase, o_val%s);\n"
 		"\t//\n"
 		"\tparameter\tPW =%2d, // Number of bits in the input phase\n"
 		"\t\t\tOW =%2d; // Number of output bits\n"
+		"\tlocalparam\tNLANES=%2d,// Phases per clock\n"
+		"\t\t\tNTBLS =%2d;// Copies of the table\n"
 		"\t//\n"
 		"\tinput\twire\t\t\ti_clk, %si_ce;\n"
-		"\tinput\twire\t[(PW-1):0]\ti_phase;\n"
-		"\toutput\treg\t[(OW-1):0]\to_val;\n",
+		"\tinput\twire\t[(NLANES*PW-1):0]\ti_phase;\n"
+		"\toutput\twire\t[(NLANES*OW-1):0]\to_val;\n",
 		name,
 		resetw.c_str(),
 		(with_aux)   ? "i_aux, "  :"",
 		(with_aux)   ? ", o_aux"  :"",
-		lgtable, ow,
+		lgtable, ow, nlanes, (nlanes+1)/2,
 		resetw.c_str());
 	if (with_aux)
 		fprintf(fp,
 			"\t//\n"
 			"\tinput\twire\t\t\ti_aux;\n"
 			"\toutput\treg\t\t\to_aux;\n");
+
 	fprintf(fp,
 		"\n"
-		"\treg\t[(OW-1):0]\t\ttbl\t[0:((1<<PW)-1)];\n"
+		"\t// Phase k of each clock is found in i_phase[k*PW +: PW], and its\n"
+		"\t// result in o_val[k*OW +: OW].  Phase zero is the earliest.\n"
+		"\t// Each copy of the table serves two phases, one through each of\n"
+		"\t// its two read ports.\n"
+		"\tgenvar\tk;\n"
+		"\tgenerate for(k=0; k<NTBLS; k=k+1)\n"
+		"\tbegin : TBL\n"
+		"\t\treg\t[(OW-1):0]\t\ttbl\t[0:((1<<PW)-1)];\n"
+		"\t\treg\t[(OW-1):0]\t\tr_a;\n"
 		"\n"
-		"\tinitial\t$readmemh(\"%s.hex\", tbl);\n"
+		"\t\tinitial\t$readmemh(\"%s.hex\", tbl);\n"
 		"\n", name);
 
-	fprintf(fp, "%s", always_reset.c_str());
-	if (with_reset) {
-		fprintf(fp, 
-			"\t\to_val <= 0;\n"
-			"\telse ");
-	}
+	lane_register(fp, "\t\t", with_reset, async_reset,
+		"r_a", "tbl[i_phase[(2*k)*PW +: PW]]");
+	fprintf(fp,
+		"\n"
+		"\t\tassign\to_val[(2*k)*OW +: OW] = r_a;\n"
+		"\n"
+		"\t\t// With an odd number of lanes, the last copy only needs\n"
+		"\t\t// the one port\n"
+		"\t\tif (2*k+1 < NLANES)\n"
+		"\t\tbegin : PORTB\n"
+		"\t\t\treg\t[(OW-1):0]\tr_b;\n"
+		"\n");
+	lane_register(fp, "\t\t\t", with_reset, async_reset,
+		"r_b", "tbl[i_phase[(2*k+1)*PW +: PW]]");
+	fprintf(fp,
+		"\n"
+		"\t\t\tassign\to_val[(2*k+1)*OW +: OW] = r_b;\n"
+		"\t\tend\n"
+		"\tend endgenerate\n\n");
+
+	if (with_aux)
+		lane_register(fp, "\t", with_reset, async_reset,
+			"o_aux", "i_aux");
+	fprintf(fp, "endmodule\n");
+}
+
+//
+// quarterwav_lanes
+//
+// The module for a quarter wave table taking nlanes phases per clock.  As
+// with sintable_lanes(), each copy of the table serves two lanes.
+static	void	quarterwav_lanes(FILE *fp, const char *name, int lgtable,
+			int ow, int nlanes, bool with_reset, bool with_aux,
+			bool async_reset) {
+	std::string	resetw = (!with_reset) ? ""
+				: (async_reset) ? "i_areset_n, ":"i_reset, ";
+
+	fprintf(fp,
+		"module	%s(i_clk, %si_ce, i_phase, %so_val%s);\n"
+		"\t//\n"
+		"\tparameter\tPW =%2d, // Number of bits in the input phase\n"
+		"\t\t\tOW =%2d; // Number of output bits\n"
+		"\tlocalparam\tNLANES=%2d,// Phases per clock\n"
+		"\t\t\tNTBLS =%2d;// Copies of the table\n"
+		"\t//\n"
+		"\tinput\t\t\t\ti_clk, %si_ce;\n"
+		"\tinput\twire\t[(NLANES*PW-1):0]\ti_phase;\n"
+		"\toutput\treg\t[(NLANES*OW-1):0]\to_val;\n",
+		name,
+		resetw.c_str(),
+		(with_aux)   ? "i_aux, ":"",
+		(with_aux)   ? ", o_aux":"",
+		lgtable, ow, nlanes, (nlanes+1)/2,
+		resetw.c_str());
 
-	fprintf(fp, "if (i_ce)\n"
-		"\t\to_val <= tbl[i_phase];\n\n");
+	if (with_aux)
+		fprintf(fp, "\t//\n"
+			"\tinput\twire\t\t\ti_aux;\n"
+			"\toutput\treg\t\t\to_aux;\n");
+
+	fprintf(fp,
+		"\n"
+		"\t// Phase k of each clock is found in i_phase[k*PW +: PW], and its\n"
+		"\t// result in o_val[k*OW +: OW].  Phase zero is the earliest.\n"
+		"\treg\t[(NLANES-1):0]\t\tnegate, negate_1;\n"
+		"\treg\t[(NLANES*(PW-2)-1):0]\tindex;\n"
+		"\treg\t[(NLANES*OW-1):0]\ttblvalue;\n"
+		"\n"
+		"\tgenvar\tk;\n"
+		"\tgenerate for(k=0; k<NLANES; k=k+1)\n"
+		"\tbegin : LANE\n"
+		"\t\twire\t[(PW-1):0]\tphase;\n"
+		"\n"
+		"\t\tassign\tphase = i_phase[k*PW +: PW];\n"
+		"\n"
+		"%s", lane_always("\t\t", with_reset, async_reset).c_str());
+
+	if (with_reset)
+		fprintf(fp,
+			"\t\tbegin\n"
+			"\t\t\tnegate[k]   <= 1\'b0;\n"
+			"\t\t\tnegate_1[k] <= 1\'b0;\n"
+			"\t\t\tindex[k*(PW-2) +: (PW-2)] <= 0;\n"
+			"\t\t\to_val[k*OW +: OW] <= 0;\n"
+			"\t\tend else ");
+
+	fprintf(fp,
+		"if (i_ce)\n"
+		"\t\tbegin\n"
+			"\t\t\t// Clock #1\n"
+			"\t\t\tnegate[k] <= phase[(PW-1)];\n"
+			"\t\t\tif (phase[(PW-2)])\n"
+			"\t\t\t\tindex[k*(PW-2) +: (PW-2)] <= ~phase[(PW-3):0];\n"
+			"\t\t\telse\n"
+			"\t\t\t\tindex[k*(PW-2) +: (PW-2)] <=  phase[(PW-3):0];\n"
+			"\t\t\t// Clock #2, the table lookup itself, is below\n"
+			"\t\t\tnegate_1[k] <= negate[k];\n"
+			"\t\t\t// Output Clock\n"
+			"\t\t\tif (negate_1[k])\n"
+			"\t\t\t\to_val[k*OW +: OW] <= -tblvalue[k*OW +: OW];\n"
+			"\t\t\telse\n"
+			"\t\t\t\to_val[k*OW +: OW] <=  tblvalue[k*OW +: OW];\n"
+		"\t\tend\n"
+		"\tend endgenerate\n\n");
+
+	fprintf(fp,
+		"\t// Each copy of the table serves two lanes, one through each of\n"
+		"\t// its two read ports\n"
+		"\tgenerate for(k=0; k<NTBLS; k=k+1)\n"
+		"\tbegin : TBL\n"
+		"\t\treg\t[(OW-1):0]\tquartertable\t[0:((1<<(PW-2))-1)];\n"
+		"\n"
+		"\t\tinitial\t$readmemh(\"%s.hex\", quartertable);\n"
+		"\n", name);
+
+	lane_register(fp, "\t\t", with_reset, async_reset,
+		"tblvalue[(2*k)*OW +: OW]",
+		"quartertable[index[(2*k)*(PW-2) +: (PW-2)]]");
+	fprintf(fp,
+		"\n"
+		"\t\t// With an odd number of lanes, the last copy only needs\n"
+		"\t\t// the one port\n"
+		"\t\tif (2*k+1 < NLANES)\n"
+		"\t\tbegin : PORTB\n");
+	lane_register(fp, "\t\t\t", with_reset, async_reset,
+		"tblvalue[(2*k+1)*OW +: OW]",
+		"quartertable[index[(2*k+1)*(PW-2) +: (PW-2)]]");
+	fprintf(fp,
+		"\t\tend\n"
+		"\tend endgenerate\n\n");
 
 	if (with_aux) {
+		fprintf(fp, "\treg [1:0]\taux;\n");
+		lane_register(fp, "\t", with_reset, async_reset,
+			"{ o_aux, aux }", "{ aux, i_aux }");
+	}
+
+	fprintf(fp, "endmodule\n");
+}
+
+void	sintable(FILE *fp, const char *fname, int lgtable, int ow,
+		bool with_reset, bool with_aux, bool async_reset, FILE *fmp,
+		int nlanes) {
+	char	*name;
+	const	char	PURPOSE[] =
+	"This is a very simple sinewave table lookup approach\n"
+	"//\t\tapproach to generating a sine wave.  It has the lowest latency\n"
+	"//\tamong all sinewave generation alternatives.";
+
+	// gencordic_build() turns away any table it can't build
+	assert((lgtable >= 2)&&(lgtable < 24));
+
+	legal(fp, fname, PROJECT, PURPOSE);
+	fprintf(fp, "`default_nettype\tnone\n//\n");
+	name = modulename(fname);
+
+	std::string	resetw = (!with_reset) ? ""
+				: (async_reset) ? "i_areset_n, ":"i_reset, ";
+	std::string	always_reset;
+	if ((with_reset)&&(async_reset))
+		always_reset = "\talways @(posedge i_clk, negedge i_areset_n)\n"
+			"\tif (!i_areset_n)\n";
+	else if (with_reset)
+		always_reset = "\talways @(posedge i_clk)\n"
+			"\tif (i_reset)\n";
+	else
+		always_reset = "\talways @(posedge i_clk)\n\t";
+
+	if (nlanes > 1)
+		sintable_lanes(fp, name, lgtable, ow, nlanes,
+			with_reset, with_aux, async_reset);
+	else {
+		fprintf(fp,
+			"module	%s(i_clk, %si_ce, %si_phase, o_val%s);\n"
+			"\t//\n"
+			"\tparameter\tPW =%2d, // Number of bits in the input phase\n"
+			"\t\t\tOW =%2d; // Number of output bits\n"
+			"\t//\n"
+			"\tinput\twire\t\t\ti_clk, %si_ce;\n"
+			"\tinput\twire\t[(PW-1):0]\ti_phase;\n"
+			"\toutput\treg\t[(OW-1):0]\to_val;\n",
+			name,
+			resetw.c_str(),
+			(with_aux)   ? "i_aux, "  :"",
+			(with_aux)   ? ", o_aux"  :"",
+			lgtable, ow,
+			resetw.c_str());
+		if (with_aux)
+			fprintf(fp,
+				"\t//\n"
+				"\tinput\twire\t\t\ti_aux;\n"
+				"\toutput\treg\t\t\to_aux;\n");
+		fprintf(fp,
+			"\n"
+			"\treg\t[(OW-1):0]\t\ttbl\t[0:((1<<PW)-1)];\n"
+			"\n"
+			"\tinitial\t$readmemh(\"%s.hex\", tbl);\n"
+			"\n", name);
+
 		fprintf(fp, "%s", always_reset.c_str());
 		if (with_reset) {
 			fprintf(fp, 
-				"\t\to_aux <= 0;\n"
+				"\t\to_val <= 0;\n"
 				"\telse ");
 		}
+
 		fprintf(fp, "if (i_ce)\n"
-			"\t\to_aux <= i_aux;\n");
+			"\t\to_val <= tbl[i_phase];\n\n");
+
+		if (with_aux) {
+			fprintf(fp, "%s", always_reset.c_str());
+			if (with_reset) {
+				fprintf(fp, 
+					"\t\to_aux <= 0;\n"
+					"\telse ");
+			}
+			fprintf(fp, "if (i_ce)\n"
+				"\t\to_aux <= i_aux;\n");
+		}
+		fprintf(fp, "endmodule\n");
 	}
-	fprintf(fp, "endmodule\n");
 
 	long	*tbldata;
 	tbldata = new long[(1<<lgtable)];
-	int	tbl_entries = (1<<lgtable);
 	long	maxv = (1l<<(ow-1))-1l;
 
-	for(int k=0; k<tbl_entries; k++) {
-		double	ph;
-		ph = 2.0 * M_PI * (double)k / (double)tbl_entries;
-
-		tbldata[k]  = (long)maxv * sin(ph);
-	}
+	sintbl_fill(tbldata, lgtable, maxv, false);
 
 	hextable(fname, lgtable, ow, tbldata);
 
+	if (NULL != fmp)
+		sintable_model(fmp, name, lgtable, ow, tbldata, nlanes);
+
 	delete[] tbldata;
 }
 
 void	quarterwav(FILE *fp, const char *fname, int lgtable, int ow,
-		bool with_reset, bool with_aux, bool async_reset) {
+		bool with_reset, bool with_aux, bool async_reset, FILE *fmp,
+		int nlanes) {
 	char	*name;
 	const	char	PURPOSE[] =
 	"This is a touch more complicated than the simple sinewave table\n"
@@ -158,15 +521,8 @@ void	quarterwav(FILE *fp, const char *fname, int lgtable, int ow,
 	"//\tin fourths.  Generating the sinewave value, though, requires\n"
 	"//\ta little more logic to make this possible.";
 
-	assert(lgtable>2);
-	if (lgtable >= 26) {
-		fprintf(stderr, "ERR: Requested table size is greater than 16M\n\n");
-		fprintf(stderr, "While this is an arbitrary limit, few FPGA's have this kind of\n");
-		fprintf(stderr, "block RAM.  If you know what you are doing, you can change this\n");
-		fprintf(stderr, "limit up to perhaps 30 without much hassle.  Beyond that, be\n");
-		fprintf(stderr, "aware of integer overflow.\n");
-		exit(EXIT_FAILURE);
-	}
+	// gencordic_build() turns away any table it can't build
+	assert((lgtable >= 4)&&(lgtable < 26));
 
 	legal(fp, fname, PROJECT, PURPOSE);
 	name = modulename(fname);
@@ -184,94 +540,96 @@ void	quarterwav(FILE *fp, const char *fname, int lgtable, int ow,
 		always_reset = "\talways @(posedge i_clk)\n\t";
 
 
-	fprintf(fp,
-		"module	%s(i_clk, %s%si_ce, i_phase, %so_val%s);\n"
-		"\t//\n"
-		"\tparameter\tPW =%2d, // Number of bits in the input phase\n"
-		"\t\t\tOW =%2d; // Number of output bits\n"
-		"\t//\n"
-		"\tinput\t\t\t\ti_clk, %s%si_ce;\n"
-		"\tinput\twire\t[(PW-1):0]\ti_phase;\n"
-		"\toutput\treg\t[(OW-1):0]\to_val;\n",
-		name,
-		resetw.c_str(), (with_reset) ? ", ":"",
-		(with_aux)   ? "i_aux, ":"",
-		(with_aux)   ? ", o_aux":"",
-		lgtable, ow,
-		resetw.c_str(), (with_reset) ? ", ":"");
+	if (nlanes > 1)
+		quarterwav_lanes(fp, name, lgtable, ow, nlanes,
+			with_reset, with_aux, async_reset);
+	else {
+		fprintf(fp,
+			"module	%s(i_clk, %s%si_ce, i_phase, %so_val%s);\n"
+			"\t//\n"
+			"\tparameter\tPW =%2d, // Number of bits in the input phase\n"
+			"\t\t\tOW =%2d; // Number of output bits\n"
+			"\t//\n"
+			"\tinput\t\t\t\ti_clk, %s%si_ce;\n"
+			"\tinput\twire\t[(PW-1):0]\ti_phase;\n"
+			"\toutput\treg\t[(OW-1):0]\to_val;\n",
+			name,
+			resetw.c_str(), (with_reset) ? ", ":"",
+			(with_aux)   ? "i_aux, ":"",
+			(with_aux)   ? ", o_aux":"",
+			lgtable, ow,
+			resetw.c_str(), (with_reset) ? ", ":"");
 
-	if (with_aux)
-		fprintf(fp, "\t//\n"
-			"\tinput\twire\t\t\ti_aux;\n"
-			"\toutput\twire\t\t\to_aux;\n");
+		if (with_aux)
+			fprintf(fp, "\t//\n"
+				"\tinput\twire\t\t\ti_aux;\n"
+				"\toutput\twire\t\t\to_aux;\n");
 
-	fprintf(fp,
-		"\n"
-		"\treg\t[(OW-1):0]\t\tquartertable\t[0:((1<<(PW-2))-1)];\n"
-		"\n"
-		"\tinitial\t$readmemh(\"%s.hex\", quartertable);\n"
-		"\n"
-		"\treg\t[1:0]\tnegate;\n"
-		"\treg\t[(PW-3):0]\tindex;\n"
-		"\treg\t[(OW-1):0]\ttblvalue;\n"
-		"\n", name);
+		fprintf(fp,
+			"\n"
+			"\treg\t[(OW-1):0]\t\tquartertable\t[0:((1<<(PW-2))-1)];\n"
+			"\n"
+			"\tinitial\t$readmemh(\"%s.hex\", quartertable);\n"
+			"\n"
+			"\treg\t[1:0]\tnegate;\n"
+			"\treg\t[(PW-3):0]\tindex;\n"
+			"\treg\t[(OW-1):0]\ttblvalue;\n"
+			"\n", name);
 
-	fprintf(fp, "%s", always_reset.c_str());
+		fprintf(fp, "%s", always_reset.c_str());
+
+		if (with_reset)
+			fprintf(fp,
+				"\tbegin\n"
+				"\t\tnegate  <= 2\'b00;\n"
+				"\t\tindex   <= 0;\n"
+				"\t\ttblvalue<= 0;\n"
+				"\t\to_val   <= 0;\n"
+				"\tend else ");
 
-	if (with_reset)
 		fprintf(fp,
+			"if (i_ce)\n"
 			"\tbegin\n"
-			"\t\tnegate  <= 2\'b00;\n"
-			"\t\tindex   <= 0;\n"
-			"\t\ttblvalue<= 0;\n"
-			"\t\to_val   <= 0;\n"
-			"\tend else ");
+				"\t\t// Clock #1\n"
+				"\t\tnegate[0] <= i_phase[(PW-1)];\n"
+				"\t\tif (i_phase[(PW-2)])\n"
+				"\t\t\tindex <= ~i_phase[(PW-3):0];\n"
+				"\t\telse\n"
+				"\t\t\tindex <=  i_phase[(PW-3):0];\n"
+				""
+				"\t\t// Clock #2\n"
+				"\t\ttblvalue <= quartertable[index];\n"
+				"\t\tnegate[1] <= negate[0];\n"
+				""
+				"\t\t// Output Clock\n"
+				"\t\tif (negate[1])\n"
+				"\t\t\to_val <= -tblvalue;\n"
+				"\t\telse\n"
+				"\t\t\to_val <=  tblvalue;\n"
+			"\tend\n\n");
 
-	fprintf(fp,
-		"if (i_ce)\n"
-		"\tbegin\n"
-			"\t\t// Clock #1\n"
-			"\t\tnegate[0] <= i_phase[(PW-1)];\n"
-			"\t\tif (i_phase[(PW-2)])\n"
-			"\t\t\tindex <= ~i_phase[(PW-3):0];\n"
-			"\t\telse\n"
-			"\t\t\tindex <=  i_phase[(PW-3):0];\n"
-			""
-			"\t\t// Clock #2\n"
-			"\t\ttblvalue <= quartertable[index];\n"
-			"\t\tnegate[1] <= negate[0];\n"
-			""
-			"\t\t// Output Clock\n"
-			"\t\tif (negate[1])\n"
-			"\t\t\to_val <= -tblvalue;\n"
-			"\t\telse\n"
-			"\t\t\to_val <=  tblvalue;\n"
-		"\tend\n\n");
+		if (with_aux) {
+			fprintf(fp, "\treg [1:0]\taux;\n");
+			fprintf(fp, "%s", always_reset.c_str());
+			if(with_reset)
+				fprintf(fp, "\t\t{ o_aux, aux } <= 0;\n"
+					"\telse ");
+			fprintf(fp, "if (i_ce)\n\t\t{ o_aux, aux } <= { aux, i_aux };\n");
+		}
 
-	if (with_aux) {
-		fprintf(fp, "\treg [1:0]\taux;\n");
-		fprintf(fp, "%s", always_reset.c_str());
-		if(with_reset)
-			fprintf(fp, "\t\t{ o_aux, aux } <= 0;\n"
-				"\telse ");
-		fprintf(fp, "if (i_ce)\n\t\t{ o_aux, aux } <= { aux, i_aux };\n");
+		fprintf(fp, "endmodule\n");
 	}
 
-	fprintf(fp, "endmodule\n");
-
 	long	*tbldata;
 	tbldata = new long[(1<<lgtable)];
-	int	tbl_entries = (1<<lgtable);
 	long	maxv = (1l<<(ow-1))-1l;
 
-	for(int k=0; k<tbl_entries/4; k++) {
-		double	ph;
-		ph = 2.0 * M_PI * (double)k / (double)tbl_entries;
-		ph+=       M_PI             / (double)tbl_entries;
-		tbldata[k] = maxv * sin(ph);
-	}
+	sintbl_fill(tbldata, lgtable, maxv, true);
 
 	hextable(fname, lgtable-2, ow, tbldata);
 
+	if (NULL != fmp)
+		quarterwav_model(fmp, name, lgtable, ow, tbldata, nlanes);
+
 	delete[] tbldata;
 }
@@ -45,9 +45,11 @@
 #include <stdio.h>
 
 extern	void	sintable(FILE *fp, const char *fname, int lgtable, int ow,
-			bool with_reset, bool with_aux, bool async_reset);
+			bool with_reset, bool with_aux, bool async_reset,
+			FILE *fmp = NULL, int nlanes = 1);
 
 extern	void	quarterwav(FILE *fp, const char *fname, int lgtable, int ow,
-			bool with_reset, bool with_aux, bool async_reset);
+			bool with_reset, bool with_aux, bool async_reset,
+			FILE *fmp = NULL, int nlanes = 1);
 
 #endif
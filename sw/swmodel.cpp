@@ -0,0 +1,1432 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename: 	swmodel.cpp
+//
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	Writes bit-accurate C++ software models of the cores this
+//		generator produces.  Each model is a header-only file, named
+//	after the Verilog module plus a _model.h suffix, containing the same
+//	parameters, the same CORDIC angle table, and the same rounding as the
+//	Verilog it accompanies.  The models evaluate one sample at a time, as
+//	though each sample had been pushed through the core by itself, and so
+//	do not model the pipeline delay--that is captured in the _LATENCY
+//	value instead.
+//
+//	The CORDIC models also include a _batch() routine, producing the same
+//	results for an array of samples, but written so that the compiler can
+//	vectorize it across SIMD lanes.
+//
+//	Finally, the -c headers of the polar to rectangular cores get a
+//	cordic_model<IW,OW,NSTAGES,PW,XTRA> template: the same model again, but
+//	with its angles computed by the compiler (C++14 or later), for code
+//	that would rather not carry any table at all.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2017-2018, Gisselquist Technology, LLC
+//
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+//
+// License:	GPL, v3, as defined and found on www.gnu.org,
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+//
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <string.h>
+#include <ctype.h>
+#include <assert.h>
+
+#include "legal.h"
+#include "cordiclib.h"
+#include "swmodel.h"
+
+static	const	char	MPURPOSE[] =
+	"This is a bit-accurate C++ software model of the core\n"
+	"//\t\tfound in the Verilog file of the same name.  It was generated\n"
+	"//\tfrom the same parameters as that core, and should produce\n"
+	"//\tidentical outputs for identical inputs.  Call it in place of\n"
+	"//\trunning Verilator when you need the core's exact outputs at native\n"
+	"//\tspeed.";
+
+//
+// model_prefix
+//
+// Returns an upper case copy of the module name, for use as a prefix on
+// the constants found within the model.  The caller is responsible for
+// free()ing the result.
+static	char	*model_prefix(const char *name) {
+	char	*str = strdup(name), *ptr;
+
+	for(ptr = str; *ptr; ptr++)
+		*ptr = (isalnum(*ptr)) ? toupper(*ptr) : '_';
+	return str;
+}
+
+static	void	model_preamble(FILE *fmp, const char *name, const char *prefix) {
+	char	*str = new char[strlen(name)+16];
+
+	sprintf(str, "%s_model.h", name);
+	legal(fmp, str, PROJECT, MPURPOSE);
+	delete[] str;
+
+	fprintf(fmp, "#ifndef\t%s_MODEL_H\n", prefix);
+	fprintf(fmp, "#define\t%s_MODEL_H\n\n", prefix);
+	fprintf(fmp, "#include <stdint.h>\n#include <stddef.h>\n\n");
+
+	// The helpers are shared by every model, so that several models
+	// may be included into the same file without conflict
+	fprintf(fmp,
+	"#ifndef\tGENCORDIC_MODEL_HELPERS\n"
+	"#define\tGENCORDIC_MODEL_HELPERS\n"
+	"//\n"
+	"// mdl_sext\n"
+	"//\n"
+	"// Sign extend the bottom w bits of v, dropping everything above them.\n"
+	"// This captures the wrap-around of a w-bit Verilog register.\n"
+	"static inline int64_t\tmdl_sext(int64_t v, int w) {\n"
+	"\treturn (int64_t)((uint64_t)v << (64-w)) >> (64-w);\n"
+	"}\n\n"
+	"//\n"
+	"// mdl_shl\n"
+	"//\n"
+	"// A left shift, done unsigned so that it's defined even when v is\n"
+	"// negative.\n"
+	"static inline int64_t\tmdl_shl(int64_t v, int s) {\n"
+	"\treturn (int64_t)((uint64_t)v << s);\n"
+	"}\n\n"
+	"//\n"
+	"// mdl_asr\n"
+	"//\n"
+	"// An arithmetic right shift that, like Verilog's >>>, doesn't mind\n"
+	"// shifting by more bits than are in the word.\n"
+	"static inline int64_t\tmdl_asr(int64_t v, int s) {\n"
+	"\treturn (s >= 63) ? ((v < 0) ? -1 : 0) : (v >> s);\n"
+	"}\n\n"
+	"//\n"
+	"// mdl_round\n"
+	"//\n"
+	"// Drop a ww bit value down to ow bits.  If more than one bit is\n"
+	"// dropped, round towards even first, just like the generated cores do.\n"
+	"static inline int64_t\tmdl_round(int64_t v, int ww, int ow) {\n"
+	"\tint\tdrop = ww - ow;\n"
+	"\n"
+	"\tif (drop > 1) {\n"
+	"\t\tint64_t\thalf = (1ll<<(drop-1));\n"
+	"\n"
+	"\t\tv += ((v >> drop)&1) ? half : (half-1);\n"
+	"\t}\n"
+	"\treturn mdl_sext(v >> drop, ow);\n"
+	"}\n"
+	"#endif\t// GENCORDIC_MODEL_HELPERS\n\n");
+}
+
+static	void	model_postamble(FILE *fmp, const char *prefix) {
+	fprintf(fmp, "#endif\t// %s_MODEL_H\n", prefix);
+}
+
+//
+// model_params
+//
+// Writes out the parameters common to all of the CORDIC models.  These match
+// the localparam's within the Verilog.
+static	void	model_params(FILE *fmp, const char *prefix,
+		int nstages, int iw, int ow, int nxtra, int ww, int phase_bits,
+		int latency) {
+	fprintf(fmp,
+		"static const int\t%s_IW = %d,\t// The number of bits in our inputs\n"
+		"\t\t%s_OW = %d,\t// The number of output bits to produce\n"
+		"\t\t%s_NSTAGES = %d,\n"
+		"\t\t%s_XTRA = %d,\t// Extra bits for internal precision\n"
+		"\t\t%s_WW = %d,\t// Our working bit-width\n"
+		"\t\t%s_PW = %d,\t// Bits in our phase variables\n"
+		"\t\t%s_LATENCY = %d;\t// Clocks from input to output\n"
+		"static const uint64_t\t%s_PMASK = 0x%lxull;\n\n",
+		prefix, iw, prefix, ow, prefix, nstages, prefix, nxtra,
+		prefix, ww, prefix, phase_bits, prefix, latency,
+		prefix, (1ul<<phase_bits)-1ul);
+}
+
+//
+// model_angles
+//
+// Writes out the same CORDIC angles that cordic_angles() places into the
+// Verilog, starting from the angle of stage first.
+static	void	model_angles(FILE *fmp, const char *name, const char *prefix,
+		int nstages, int phase_bits, int first = 0) {
+	fprintf(fmp, "static const uint32_t\t%s_angle[%s_NSTAGES] = {",
+		name, prefix);
+	for(int k=0; k<nstages; k++) {
+		fprintf(fmp, "%s0x%0*lx%s", ((k%4)==0) ? "\n\t" : " ",
+			(phase_bits+3)/4, cordic_angle_value(k+first, phase_bits),
+			(k+1<nstages) ? ",":"");
+	} fprintf(fmp, "\n};\n\n");
+}
+
+//
+// model_p2r_prerotate
+//
+// The polar to rectangular cores start by rotating the input into a
+// sector within +/- 45 degrees of zero.  This writes out that step.
+static	void	model_p2r_prerotate(FILE *fmp, const char *prefix,
+		int phase_bits) {
+	fprintf(fmp,
+	"\t// First step: expand our input to our working width.\n"
+	"\te_xval = mdl_shl(mdl_sext(i_xval, %s_IW), %s_WW-%s_IW-1);\n"
+	"\te_yval = mdl_shl(mdl_sext(i_yval, %s_IW), %s_WW-%s_IW-1);\n"
+	"\tph = i_phase & %s_PMASK;\n\n",
+		prefix, prefix, prefix, prefix, prefix, prefix, prefix);
+
+	fprintf(fmp,
+	"\t// First stage, get rid of all but 45 degrees\n"
+	"\tswitch((ph >> (%s_PW-3))&7) {\n"
+	"\tcase 1: case 2:\t// 45 .. 135\n"
+	"\t\txv = -e_yval; yv =  e_xval; ph -= 0x%lxull; break;\n"
+	"\tcase 3: case 4:\t// 135 .. 225\n"
+	"\t\txv = -e_xval; yv = -e_yval; ph -= 0x%lxull; break;\n"
+	"\tcase 5: case 6:\t// 225 .. 315\n"
+	"\t\txv =  e_yval; yv = -e_xval; ph -= 0x%lxull; break;\n"
+	"\tdefault:\t// -45 .. 45, No change\n"
+	"\t\txv =  e_xval; yv =  e_yval; break;\n"
+	"\t}\n"
+	"\txv = mdl_sext(xv, %s_WW);\n"
+	"\tyv = mdl_sext(yv, %s_WW);\n"
+	"\tph &= %s_PMASK;\n\n",
+		prefix,
+		(1ul << (phase_bits-2)),
+		(2ul << (phase_bits-2)),
+		(3ul << (phase_bits-2)),
+		prefix, prefix, prefix);
+}
+
+//
+// model_r2p_prerotate
+//
+// The rectangular to polar cores start by rotating the input by some odd
+// multiple of 45 degrees, so as to land within +/- 45 degrees of the x-axis.
+static	void	model_r2p_prerotate(FILE *fmp, const char *prefix,
+		int phase_bits) {
+	fprintf(fmp,
+	"\t// First step: expand our input to our working width.\n"
+	"\te_xval = mdl_shl(mdl_sext(i_xval, %s_IW), %s_WW-%s_IW-2);\n"
+	"\te_yval = mdl_shl(mdl_sext(i_yval, %s_IW), %s_WW-%s_IW-2);\n\n",
+		prefix, prefix, prefix, prefix, prefix, prefix);
+
+	fprintf(fmp,
+	"\t// First stage, map to within +/- 45 degrees\n"
+	"\tswitch(((e_xval < 0)?2:0)|((e_yval < 0)?1:0)) {\n"
+	"\tcase 1:\t// Rotate by -315 degrees\n"
+	"\t\txv =  e_xval - e_yval; yv =  e_xval + e_yval; ph = 0x%lxull; break;\n"
+	"\tcase 2:\t// Rotate by -135 degrees\n"
+	"\t\txv = -e_xval + e_yval; yv = -e_xval - e_yval; ph = 0x%lxull; break;\n"
+	"\tcase 3:\t// Rotate by -225 degrees\n"
+	"\t\txv = -e_xval - e_yval; yv =  e_xval - e_yval; ph = 0x%lxull; break;\n"
+	"\tdefault:\t// Rotate by -45 degrees\n"
+	"\t\txv =  e_xval + e_yval; yv = -e_xval + e_yval; ph = 0x%lxull; break;\n"
+	"\t}\n"
+	"\txv = mdl_sext(xv, %s_WW);\n"
+	"\tyv = mdl_sext(yv, %s_WW);\n\n",
+		(7ul << (phase_bits-3)),
+		(3ul << (phase_bits-3)),
+		(5ul << (phase_bits-3)),
+		(1ul << (phase_bits-3)),
+		prefix, prefix);
+}
+
+//
+// model_batch
+//
+// Writes a batch version of the CORDIC model, processing n samples per call.
+// Rather than looping over the stages, every rotation is written out with
+// its shift and angle as constants.  The values are also kept left justified
+// within 32-bit words, so that the natural wrap-around of 32-bit unsigned
+// arithmetic matches that of the WW and PW bit registers within the core.
+// What's left is nothing but shifts, adds, and sign masks, with no branches
+// and no table lookups, so that the compiler's vectorizer can spread it
+// across as many SIMD lanes as the target has (8 with AVX2, 16 with AVX-512,
+// 4 with NEON) when built with -O3 and the appropriate -march.
+//
+// The rotations applied are those by atan(2^-first) through atan(2^-last),
+// skipping (if skip is set) those the pipelined cores skip.  Cores wider
+// than 32 bits fall back to calling the scalar model.
+static	void	model_batch(FILE *fmp, const char *name, bool p2r,
+		int iw, int ow, int ww, int phase_bits,
+		int first, int last, bool skip) {
+	const	char	*fn = (p2r) ? "p2r" : "r2p";
+
+	fprintf(fmp,
+	"//\n"
+	"// %s_%s_batch\n"
+	"//\n"
+	"// Applies %s_%s() to each of n samples.\n"
+	"//\n", name, fn, name, fn);
+	if (p2r)
+		fprintf(fmp,
+	"static inline void\t%s_p2r_batch(const int32_t *i_xval,\n"
+	"\t\t\tconst int32_t *i_yval, const uint32_t *i_phase,\n"
+	"\t\t\tint32_t *o_xval, int32_t *o_yval, size_t n) {\n", name);
+	else
+		fprintf(fmp,
+	"static inline void\t%s_r2p_batch(const int32_t *i_xval,\n"
+	"\t\t\tconst int32_t *i_yval,\n"
+	"\t\t\tint32_t *o_mag, uint32_t *o_phase, size_t n) {\n", name);
+
+	if ((ww > 32)||(phase_bits > 32)||(iw > 31)) {
+		fprintf(fmp,
+	"\t// This core is too wide for the 32-bit lanes of the fast path\n"
+	"\tfor(size_t i=0; i<n; i++)\n"
+	"\t\t%s_%s(i_xval[i], i_yval[i], %s);\n"
+	"}\n\n", name, fn,
+			(p2r) ? "i_phase[i], &o_xval[i], &o_yval[i]"
+				: "&o_mag[i], &o_phase[i]");
+		return;
+	}
+
+	const	unsigned long	MSK32 = 0x0ffffffffl;
+	unsigned long	lowmsk = ~((1ul << (32-ww))-1ul) & MSK32;
+
+	if (lowmsk != MSK32)
+		fprintf(fmp, "\tconst uint32_t\tLOWMSK = 0x%08lxu;\n\n", lowmsk);
+	fprintf(fmp,
+	"#if defined(__clang__)\n"
+	"#pragma clang loop vectorize(enable) interleave(enable)\n"
+	"#elif defined(__GNUC__)\n"
+	"#pragma GCC ivdep\n"
+	"#endif\n"
+	"\tfor(size_t i=0; i<n; i++) {\n"
+	"\t\tuint32_t\tex, ey, xv, yv, ph, m, t, u;\n\n"
+	"\t\t// Expand our inputs to our (left justified) working width\n"
+	"\t\tex = (uint32_t)((int32_t)((uint32_t)i_xval[i] << %d) >> %d);\n"
+	"\t\tey = (uint32_t)((int32_t)((uint32_t)i_yval[i] << %d) >> %d);\n",
+		32-iw, (p2r) ? 1 : 2, 32-iw, (p2r) ? 1 : 2);
+
+	if (p2r) {
+		fprintf(fmp,
+	"\t\tph = (uint32_t)i_phase[i] << %d;\n\n"
+	"\t\t// First stage, rotate by a multiple of 90 degrees to get\n"
+	"\t\t// rid of all but 45 degrees\n"
+	"\t\tt  = (ph + 0x20000000u) >> 30;\t// Quadrant\n"
+	"\t\tph -= t << 30;\n"
+	"\t\tm  = -(t & 1);\n"
+	"\t\tu  = (ex & ~m) | (ey & m);\n"
+	"\t\tey = (ey & ~m) | (ex & m);\n"
+	"\t\tm  = -(((t+1)>>1)&1);\n"
+	"\t\txv = (u ^ m) - m;\n"
+	"\t\tm  = -(t>>1);\n"
+	"\t\tyv = (ey ^ m) - m;\n\n",
+			32-phase_bits);
+	} else {
+		fprintf(fmp,
+	"\n"
+	"\t\t// First stage, map to within +/- 45 degrees\n"
+	"\t\tt  = (uint32_t)((int32_t)ex >> 31);\n"
+	"\t\tu  = (uint32_t)((int32_t)ey >> 31);\n"
+	"\t\tph = 0x20000000u + (t & 0x40000000u) + (u & 0xc0000000u)\n"
+	"\t\t\t+ (t & u & 0x80000000u);\n"
+	"\t\tm  = t ^ u;\n"
+	"\t\txv = ((ex + ey) & ~m) | ((ex - ey) & m);\n"
+	"\t\tyv = ((ey - ex) & ~m) | ((ex + ey) & m);\n"
+	"\t\txv = (xv ^ t) - t;\n"
+	"\t\tyv = (yv ^ t) - t;\n\n");
+	}
+
+	for(int k=first; k<=last; k++) {
+		unsigned long	a = cordic_angle_value(k-1, phase_bits);
+		int	s = (k > 31) ? 31 : k;
+
+		if ((skip)&&((a == 0)||(k-1 >= ww)))
+			continue;
+		a = (a << (32-phase_bits)) & MSK32;
+
+		fprintf(fmp, "\t\t// Rotate by atan(2^-%d)\n", k);
+		if (p2r)
+			fprintf(fmp, "\t\tm  = (uint32_t)((int32_t)ph >> 31);\n");
+		else
+			fprintf(fmp, "\t\tm  = (uint32_t)((int32_t)yv >> 31);\n");
+		fprintf(fmp,
+	"\t\tt  = (uint32_t)((int32_t)yv >> %d)%s;\n"
+	"\t\tu  = (uint32_t)((int32_t)xv >> %d)%s;\n",
+			s, (lowmsk != MSK32) ? " & LOWMSK" : "",
+			s, (lowmsk != MSK32) ? " & LOWMSK" : "");
+		if (p2r)
+			fprintf(fmp,
+	"\t\txv -= (t ^ m) - m;\n"
+	"\t\tyv += (u ^ m) - m;\n"
+	"\t\tph -= (0x%08lxu ^ m) - m;\n\n", a);
+		else
+			fprintf(fmp,
+	"\t\txv += (t ^ m) - m;\n"
+	"\t\tyv -= (u ^ m) - m;\n"
+	"\t\tph += (0x%08lxu ^ m) - m;\n\n", a);
+	}
+
+	// Round towards even, as the core does, if we drop more than one
+	// bit
+	if (ww > ow+1) {
+		unsigned long	bias = ((1ul << (ww-ow-1))-1ul) << (32-ww);
+
+		fprintf(fmp,
+		"\t\t// Round our result towards even\n"
+		"\t\txv += 0x%08lxu + (((xv >> %d)&1) << %d);\n",
+			bias, 32-ow, 32-ww);
+		if (p2r)
+			fprintf(fmp,
+		"\t\tyv += 0x%08lxu + (((yv >> %d)&1) << %d);\n",
+			bias, 32-ow, 32-ww);
+	}
+
+	if (p2r)
+		fprintf(fmp,
+	"\t\to_xval[i] = (int32_t)xv >> %d;\n"
+	"\t\to_yval[i] = (int32_t)yv >> %d;\n", 32-ow, 32-ow);
+	else
+		fprintf(fmp,
+	"\t\to_mag[i]   = (int32_t)xv >> %d;\n"
+	"\t\to_phase[i] = ph >> %d;\n", 32-ow, 32-phase_bits);
+
+	fprintf(fmp, "\t}\n}\n\n");
+}
+
+bool	model_fits(int ww, int phase_bits) {
+	return (phase_bits <= 32)&&(ww < 62);
+}
+
+bool	table_model_fits(int tw, int phase_bits) {
+	return (phase_bits <= 32)&&(tw <= 32);
+}
+
+void	basiccordic_model(FILE *fmp, const char *name,
+		int nstages, int iw, int ow, int nxtra, int ww,
+		int phase_bits, int latency) {
+	char	*prefix = model_prefix(name);
+
+	// The iterative cores produce the same results, only later
+	if (latency <= 0)
+		latency = nstages+2;
+
+	assert(phase_bits <= 32);
+	assert(ww < 62);
+
+	model_preamble(fmp, name, prefix);
+	model_params(fmp, prefix, nstages, iw, ow, nxtra, ww, phase_bits,
+		latency);
+	model_angles(fmp, name, prefix, nstages, phase_bits);
+
+	fprintf(fmp,
+	"//\n"
+	"// %s_p2r\n"
+	"//\n"
+	"// Rotates (i_xval, i_yval) left by i_phase, producing exactly what\n"
+	"// %s.v would produce in o_xval and o_yval %d clocks later.\n"
+	"//\n"
+	"static inline void\t%s_p2r(int32_t i_xval, int32_t i_yval,\n"
+	"\t\t\tuint32_t i_phase, int32_t *o_xval, int32_t *o_yval) {\n"
+	"\tint64_t\t\te_xval, e_yval, xv, yv, nx, ny;\n"
+	"\tuint64_t\tph;\n\n",
+		name, name, latency, name);
+
+	model_p2r_prerotate(fmp, prefix, phase_bits);
+
+	fprintf(fmp,
+	"\tfor(int k=0; k<%s_NSTAGES; k++) {\n"
+	"\t\tif ((%s_angle[k] == 0)||(k >= %s_WW))\n"
+	"\t\t\tcontinue;\n"
+	"\t\tif ((ph >> (%s_PW-1))&1) {\n"
+	"\t\t\t// Negative phase, rotate clockwise\n"
+	"\t\t\tnx = xv + mdl_asr(yv, k+1);\n"
+	"\t\t\tny = yv - mdl_asr(xv, k+1);\n"
+	"\t\t\tph = ph + %s_angle[k];\n"
+	"\t\t} else {\n"
+	"\t\t\tnx = xv - mdl_asr(yv, k+1);\n"
+	"\t\t\tny = yv + mdl_asr(xv, k+1);\n"
+	"\t\t\tph = ph - %s_angle[k];\n"
+	"\t\t}\n"
+	"\t\txv = mdl_sext(nx, %s_WW);\n"
+	"\t\tyv = mdl_sext(ny, %s_WW);\n"
+	"\t\tph &= %s_PMASK;\n"
+	"\t}\n\n"
+	"\t*o_xval = (int32_t)mdl_round(xv, %s_WW, %s_OW);\n"
+	"\t*o_yval = (int32_t)mdl_round(yv, %s_WW, %s_OW);\n"
+	"}\n\n",
+		prefix, name, prefix, prefix, name, name,
+		prefix, prefix, prefix,
+		prefix, prefix, prefix, prefix);
+
+	model_batch(fmp, name, true, iw, ow, ww, phase_bits,
+		1, nstages, true);
+
+	model_postamble(fmp, prefix);
+	free(prefix);
+}
+
+//
+// cordic_template
+//
+// Writes a header-only, constexpr C++ template version of the polar to
+// rectangular model into a -c header, followed by a typedef selecting this
+// core's configuration.  The template itself is written once per header,
+// guarded so that several headers may be included into the same file.
+void	cordic_template(FILE *fhp, const char *name) {
+	fprintf(fhp,
+	"#ifndef\tGENCORDIC_CORDIC_MODEL\n"
+	"#define\tGENCORDIC_CORDIC_MODEL\n"
+	"#if\t(__cplusplus >= 201402L)\n"
+	"#include <stdint.h>\n"
+	"#include <utility>\n"
+	"\n"
+	"//\n"
+	"// tmdl_atan_pow2\n"
+	"//\n"
+	"// atan(2^-n), for n > 0, from its Taylor series--summed smallest term\n"
+	"// first, so that the compiler can evaluate it to within a bit of what\n"
+	"// atan2() would return.\n"
+	"constexpr double\ttmdl_atan_pow2(int n) {\n"
+	"\tdouble\tx = 1.0, sum = 0.0;\n"
+	"\n"
+	"\tfor(int k=0; k<n; k++)\n"
+	"\t\tx *= 0.5;\n"
+	"\tconst double\tx2 = x * x;\n"
+	"\tfor(int k=30; k>=0; k--)\n"
+	"\t\tsum = ((k&1) ? -1.0 : 1.0) / (2*k+1) + x2 * sum;\n"
+	"\treturn x * sum;\n"
+	"}\n"
+	"\n"
+	"//\n"
+	"// tmdl_angle_value\n"
+	"//\n"
+	"// The k'th CORDIC angle, atan(2^-(k+1)), in pw-bit phase units, truncated\n"
+	"// just as cordic_angle_value() truncates it for the Verilog.\n"
+	"constexpr uint32_t\ttmdl_angle_value(int k, int pw) {\n"
+	"\tdouble\tx = tmdl_atan_pow2(k+1);\n"
+	"\n"
+	"\tx *= (4.0 * (double)(1ull<<(pw-2))) / (3.14159265358979323846 * 2.0);\n"
+	"\treturn (uint32_t)x;\n"
+	"}\n"
+	"\n"
+	"template<int NSTAGES>\n"
+	"struct\tTMDL_ANGLES {\n"
+	"\tuint32_t\tv[NSTAGES];\n"
+	"};\n"
+	"\n"
+	"template<int NSTAGES, int PW>\n"
+	"constexpr TMDL_ANGLES<NSTAGES>\ttmdl_angles(void) {\n"
+	"\tTMDL_ANGLES<NSTAGES>\ta = {};\n"
+	"\n"
+	"\tfor(int k=0; k<NSTAGES; k++)\n"
+	"\t\ta.v[k] = tmdl_angle_value(k, PW);\n"
+	"\treturn a;\n"
+	"}\n"
+	"\n"
+	"//\n"
+	"// cordic_model\n"
+	"//\n"
+	"// A header-only version of the polar to rectangular software model, for\n"
+	"// any IW, OW, NSTAGES, PW, and XTRA.  The angle table is built by the\n"
+	"// compiler, and each stage is unrolled with its shift and angle as\n"
+	"// constants, so there's nothing to set up at run time and no table to load.\n"
+	"// p2r() may itself be evaluated at compile time.\n"
+	"//\n"
+	"template<int IW, int OW, int NSTAGES, int PW, int XTRA>\n"
+	"struct\tcordic_model {\n"
+	"\tstatic constexpr int\tWW = ((IW > OW) ? IW : OW) + XTRA;\n"
+	"\tstatic constexpr uint64_t\tPMASK = (1ull << PW) - 1ull;\n"
+	"\tstatic constexpr TMDL_ANGLES<NSTAGES>\tangle = tmdl_angles<NSTAGES, PW>();\n"
+	"\n"
+	"\tstatic_assert((PW > 3)&&(PW <= 32), \"PW must be between 4 and 32\");\n"
+	"\tstatic_assert((XTRA >= 1)&&(WW < 62), \"WW must be between IW+1 and 61\");\n"
+	"\tstatic_assert((NSTAGES > 0)&&(OW <= 32), \"Unsupported NSTAGES or OW\");\n"
+	"\n"
+	"\tstatic constexpr int64_t\tsext(int64_t v, int w) {\n"
+	"\t\treturn (int64_t)((uint64_t)v << (64-w)) >> (64-w);\n"
+	"\t}\n"
+	"\n"
+	"\tstatic constexpr int64_t\tshl(int64_t v, int s) {\n"
+	"\t\treturn (int64_t)((uint64_t)v << s);\n"
+	"\t}\n"
+	"\n"
+	"\tstatic constexpr int64_t\tasr(int64_t v, int s) {\n"
+	"\t\treturn (s >= 63) ? ((v < 0) ? -1 : 0) : (v >> s);\n"
+	"\t}\n"
+	"\n"
+	"\tstatic constexpr int64_t\tround(int64_t v) {\n"
+	"\t\tif (WW - OW > 1)\n"
+	"\t\t\tv += ((v >> (WW-OW))&1) ? (1ll<<(WW-OW-1))\n"
+	"\t\t\t\t: ((1ll<<(WW-OW-1))-1);\n"
+	"\t\treturn sext(v >> (WW-OW), OW);\n"
+	"\t}\n"
+	"\n"
+	"\ttemplate<int K>\n"
+	"\tstatic constexpr int\tstage(int64_t &xv, int64_t &yv, uint64_t &ph) {\n"
+	"\t\tconstexpr uint64_t\ta = angle.v[K];\n"
+	"\t\tint64_t\tnx = xv, ny = yv;\n"
+	"\n"
+	"\t\tif ((a == 0)||(K >= WW))\n"
+	"\t\t\treturn 0;\n"
+	"\t\tif ((ph >> (PW-1))&1) {\n"
+	"\t\t\t// Negative phase, rotate clockwise\n"
+	"\t\t\tnx = xv + asr(yv, K+1);\n"
+	"\t\t\tny = yv - asr(xv, K+1);\n"
+	"\t\t\tph = ph + a;\n"
+	"\t\t} else {\n"
+	"\t\t\tnx = xv - asr(yv, K+1);\n"
+	"\t\t\tny = yv + asr(xv, K+1);\n"
+	"\t\t\tph = ph - a;\n"
+	"\t\t}\n"
+	"\t\txv = sext(nx, WW);\n"
+	"\t\tyv = sext(ny, WW);\n"
+	"\t\tph &= PMASK;\n"
+	"\t\treturn 0;\n"
+	"\t}\n"
+	"\n"
+	"\ttemplate<int... K>\n"
+	"\tstatic constexpr void\tstages(int64_t &xv, int64_t &yv, uint64_t &ph,\n"
+	"\t\t\tstd::integer_sequence<int, K...>) {\n"
+	"\t\tint\torder[] = { 0, stage<K>(xv, yv, ph)... };\n"
+	"\t\t(void)order;\n"
+	"\t}\n"
+	"\n"
+	"\t//\n"
+	"\t// p2r\n"
+	"\t//\n"
+	"\t// Rotates (i_xval, i_yval) left by i_phase, producing exactly what\n"
+	"\t// the core would produce in o_xval and o_yval.\n"
+	"\tstatic constexpr void\tp2r(int32_t i_xval, int32_t i_yval,\n"
+	"\t\t\tuint32_t i_phase, int32_t *o_xval, int32_t *o_yval) {\n"
+	"\t\tint64_t\t\te_xval = shl(sext(i_xval, IW), WW-IW-1),\n"
+	"\t\t\t\te_yval = shl(sext(i_yval, IW), WW-IW-1),\n"
+	"\t\t\t\txv = e_xval, yv = e_yval;\n"
+	"\t\tuint64_t\tph = i_phase & PMASK;\n"
+	"\n"
+	"\t\t// First stage, get rid of all but 45 degrees\n"
+	"\t\tswitch((ph >> (PW-3))&7) {\n"
+	"\t\tcase 1: case 2:\t// 45 .. 135\n"
+	"\t\t\txv = -e_yval; yv =  e_xval; ph -= 1ull << (PW-2); break;\n"
+	"\t\tcase 3: case 4:\t// 135 .. 225\n"
+	"\t\t\txv = -e_xval; yv = -e_yval; ph -= 2ull << (PW-2); break;\n"
+	"\t\tcase 5: case 6:\t// 225 .. 315\n"
+	"\t\t\txv =  e_yval; yv = -e_xval; ph -= 3ull << (PW-2); break;\n"
+	"\t\tdefault:\t// -45 .. 45, No change\n"
+	"\t\t\tbreak;\n"
+	"\t\t}\n"
+	"\t\txv = sext(xv, WW);\n"
+	"\t\tyv = sext(yv, WW);\n"
+	"\t\tph &= PMASK;\n"
+	"\n"
+	"\t\tstages(xv, yv, ph, std::make_integer_sequence<int, NSTAGES>());\n"
+	"\n"
+	"\t\t*o_xval = (int32_t)round(xv);\n"
+	"\t\t*o_yval = (int32_t)round(yv);\n"
+	"\t}\n"
+	"};\n"
+	"\n"
+	"template<int IW, int OW, int NSTAGES, int PW, int XTRA>\n"
+	"constexpr TMDL_ANGLES<NSTAGES>\tcordic_model<IW, OW, NSTAGES, PW, XTRA>::angle;\n"
+	"#endif\t// C++14\n"
+	"#endif\t// GENCORDIC_CORDIC_MODEL\n");
+
+	fprintf(fhp,
+	"#if\t(__cplusplus >= 201402L)\n"
+	"typedef\tcordic_model<IW, OW, NSTAGES, PW, NEXTRA>\t%s_model_t;\n"
+	"#endif\n", name);
+}
+
+void	seqcordic_model(FILE *fmp, const char *name,
+		int nstages, int iw, int ow, int nxtra, int ww,
+		int phase_bits) {
+	char	*prefix = model_prefix(name);
+
+	assert(phase_bits <= 32);
+	assert(ww < 62);
+
+	model_preamble(fmp, name, prefix);
+	model_params(fmp, prefix, nstages, iw, ow, nxtra, ww, phase_bits,
+		nstages+1);
+	model_angles(fmp, name, prefix, nstages, phase_bits);
+
+	fprintf(fmp,
+	"//\n"
+	"// %s_p2r\n"
+	"//\n"
+	"// Rotates (i_xval, i_yval) left by i_phase, producing exactly what\n"
+	"// %s.v would produce in o_xval and o_yval once o_done is set, %d\n"
+	"// clocks after i_stb.  The sequential core captures its output while\n"
+	"// the state counter reads NSTAGES-1, so only the rotations by\n"
+	"// 2^-1 through 2^-(NSTAGES-2) make it into the result.\n"
+	"//\n"
+	"static inline void\t%s_p2r(int32_t i_xval, int32_t i_yval,\n"
+	"\t\t\tuint32_t i_phase, int32_t *o_xval, int32_t *o_yval) {\n"
+	"\tint64_t\t\te_xval, e_yval, xv, yv, nx, ny;\n"
+	"\tuint64_t\tph;\n\n",
+		name, name, nstages+1, name);
+
+	model_p2r_prerotate(fmp, prefix, phase_bits);
+
+	fprintf(fmp,
+	"\tfor(int k=1; k<%s_NSTAGES-1; k++) {\n"
+	"\t\tif ((ph >> (%s_PW-1))&1) {\n"
+	"\t\t\tnx = xv + mdl_asr(yv, k);\n"
+	"\t\t\tny = yv - mdl_asr(xv, k);\n"
+	"\t\t\tph = ph + %s_angle[k-1];\n"
+	"\t\t} else {\n"
+	"\t\t\tnx = xv - mdl_asr(yv, k);\n"
+	"\t\t\tny = yv + mdl_asr(xv, k);\n"
+	"\t\t\tph = ph - %s_angle[k-1];\n"
+	"\t\t}\n"
+	"\t\txv = mdl_sext(nx, %s_WW);\n"
+	"\t\tyv = mdl_sext(ny, %s_WW);\n"
+	"\t\tph &= %s_PMASK;\n"
+	"\t}\n\n"
+	"\t*o_xval = (int32_t)mdl_round(xv, %s_WW, %s_OW);\n"
+	"\t*o_yval = (int32_t)mdl_round(yv, %s_WW, %s_OW);\n"
+	"}\n\n",
+		prefix, prefix, name, name,
+		prefix, prefix, prefix,
+		prefix, prefix, prefix, prefix);
+
+	model_batch(fmp, name, true, iw, ow, ww, phase_bits,
+		1, nstages-2, false);
+
+	model_postamble(fmp, prefix);
+	free(prefix);
+}
+
+void	topolar_model(FILE *fmp, const char *name,
+		int nstages, int iw, int ow, int nxtra, int ww,
+		int phase_bits, int latency) {
+	char	*prefix = model_prefix(name);
+
+	// The iterative cores produce the same results, only later
+	if (latency <= 0)
+		latency = nstages+2;
+
+	assert(phase_bits <= 32);
+	assert(ww < 62);
+
+	model_preamble(fmp, name, prefix);
+	model_params(fmp, prefix, nstages, iw, ow, nxtra, ww, phase_bits,
+		latency);
+	model_angles(fmp, name, prefix, nstages, phase_bits);
+
+	fprintf(fmp,
+	"//\n"
+	"// %s_r2p\n"
+	"//\n"
+	"// Converts (i_xval, i_yval) to polar coordinates, producing exactly\n"
+	"// what %s.v would produce in o_mag and o_phase %d clocks later.\n"
+	"//\n"
+	"static inline void\t%s_r2p(int32_t i_xval, int32_t i_yval,\n"
+	"\t\t\tint32_t *o_mag, uint32_t *o_phase) {\n"
+	"\tint64_t\t\te_xval, e_yval, xv, yv, nx, ny;\n"
+	"\tuint64_t\tph;\n\n",
+		name, name, latency, name);
+
+	model_r2p_prerotate(fmp, prefix, phase_bits);
+
+	fprintf(fmp,
+	"\tfor(int k=0; k<%s_NSTAGES; k++) {\n"
+	"\t\tif ((%s_angle[k] == 0)||(k >= %s_WW))\n"
+	"\t\t\tcontinue;\n"
+	"\t\tif (yv < 0) {\n"
+	"\t\t\t// Below the axis, rotate in the positive direction\n"
+	"\t\t\tnx = xv - mdl_asr(yv, k+1);\n"
+	"\t\t\tny = yv + mdl_asr(xv, k+1);\n"
+	"\t\t\tph = ph - %s_angle[k];\n"
+	"\t\t} else {\n"
+	"\t\t\tnx = xv + mdl_asr(yv, k+1);\n"
+	"\t\t\tny = yv - mdl_asr(xv, k+1);\n"
+	"\t\t\tph = ph + %s_angle[k];\n"
+	"\t\t}\n"
+	"\t\txv = mdl_sext(nx, %s_WW);\n"
+	"\t\tyv = mdl_sext(ny, %s_WW);\n"
+	"\t\tph &= %s_PMASK;\n"
+	"\t}\n\n"
+	"\t*o_mag   = (int32_t)mdl_round(xv, %s_WW, %s_OW);\n"
+	"\t*o_phase = (uint32_t)ph;\n"
+	"}\n\n",
+		prefix, name, prefix, name, name,
+		prefix, prefix, prefix,
+		prefix, prefix);
+
+	model_batch(fmp, name, false, iw, ow, ww, phase_bits,
+		1, nstages, true);
+
+	model_postamble(fmp, prefix);
+	free(prefix);
+}
+
+void	seqpolar_model(FILE *fmp, const char *name,
+		int nstages, int iw, int ow, int nxtra, int ww,
+		int phase_bits) {
+	char	*prefix = model_prefix(name);
+
+	assert(phase_bits <= 32);
+	assert(ww < 62);
+
+	model_preamble(fmp, name, prefix);
+	model_params(fmp, prefix, nstages, iw, ow, nxtra, ww, phase_bits,
+		nstages+3);
+	model_angles(fmp, name, prefix, nstages, phase_bits);
+
+	fprintf(fmp,
+	"//\n"
+	"// %s_r2p\n"
+	"//\n"
+	"// Converts (i_xval, i_yval) to polar coordinates, producing exactly\n"
+	"// what %s.v would produce in o_mag and o_phase once o_done is set,\n"
+	"// %d clocks after i_stb.\n"
+	"//\n"
+	"static inline void\t%s_r2p(int32_t i_xval, int32_t i_yval,\n"
+	"\t\t\tint32_t *o_mag, uint32_t *o_phase) {\n"
+	"\tint64_t\t\te_xval, e_yval, xv, yv, nx, ny;\n"
+	"\tuint64_t\tph;\n\n",
+		name, name, nstages+3, name);
+
+	model_r2p_prerotate(fmp, prefix, phase_bits);
+
+	fprintf(fmp,
+	"\tfor(int k=1; k<=%s_NSTAGES; k++) {\n"
+	"\t\tif (yv < 0) {\n"
+	"\t\t\tnx = xv - mdl_asr(yv, k);\n"
+	"\t\t\tny = yv + mdl_asr(xv, k);\n"
+	"\t\t\tph = ph - %s_angle[k-1];\n"
+	"\t\t} else {\n"
+	"\t\t\tnx = xv + mdl_asr(yv, k);\n"
+	"\t\t\tny = yv - mdl_asr(xv, k);\n"
+	"\t\t\tph = ph + %s_angle[k-1];\n"
+	"\t\t}\n"
+	"\t\txv = mdl_sext(nx, %s_WW);\n"
+	"\t\tyv = mdl_sext(ny, %s_WW);\n"
+	"\t\tph &= %s_PMASK;\n"
+	"\t}\n\n"
+	"\t*o_mag   = (int32_t)mdl_round(xv, %s_WW, %s_OW);\n"
+	"\t*o_phase = (uint32_t)ph;\n"
+	"}\n\n",
+		prefix, name, name,
+		prefix, prefix, prefix,
+		prefix, prefix);
+
+	model_batch(fmp, name, false, iw, ow, ww, phase_bits,
+		1, nstages, false);
+
+	model_postamble(fmp, prefix);
+	free(prefix);
+}
+
+//
+// model_table
+//
+// Writes one of a core's tables, exactly as it will be found in the block
+// RAM.  Hence, values are masked to the width of the
+// RAM and then sign extended back out again, since that's what the Verilog
+// will do when reading them into a signed register.
+static	void	model_table(FILE *fmp, const char *name, const char *tbl,
+		int lgtbl, int bits, const long *data) {
+	long	msk = (1l<<bits)-1l;
+
+	fprintf(fmp, "static const int32_t\t%s_%s[%d] = {",
+		name, tbl, (1<<lgtbl));
+	for(int k=0; k<(1<<lgtbl); k++) {
+		long	v = data[k] & msk;
+
+		if (v & (1l<<(bits-1)))
+			v |= ~msk;
+		fprintf(fmp, "%s%ld%s", ((k%6)==0) ? "\n\t" : " ", v,
+			(k+1 < (1<<lgtbl)) ? ",":"");
+	} fprintf(fmp, "\n};\n\n");
+}
+
+//
+// model_table_params
+//
+// The parameters shared by both of the table based sinewave models.  Since
+// these cores have no -c header, a core taking more than one phase per clock
+// gets its NLANES from here.
+static	void	model_table_params(FILE *fmp, const char *prefix,
+		int lgtable, int ow, int latency, int nlanes) {
+	fprintf(fmp,
+		"static const int\t%s_PW = %d,\t// Number of bits in the input phase\n"
+		"\t\t%s_OW = %d,\t// Number of output bits\n",
+		prefix, lgtable, prefix, ow);
+	if (nlanes > 1)
+		fprintf(fmp,
+		"\t\t%s_NLANES = %d,\t// Phases per clock, each its own lane\n",
+			prefix, nlanes);
+	fprintf(fmp,
+		"\t\t%s_LATENCY = %d;\t// Clocks from input to output\n\n",
+		prefix, latency);
+}
+
+void	sintable_model(FILE *fmp, const char *name, int lgtable, int ow,
+		const long *tbl, int nlanes) {
+	char	*prefix = model_prefix(name);
+
+	model_preamble(fmp, name, prefix);
+	model_table_params(fmp, prefix, lgtable, ow, 1, nlanes);
+
+	fprintf(fmp,
+	"//\n"
+	"// The table, exactly as found in %s.hex\n"
+	"//\n", name);
+	model_table(fmp, name, "tbl", lgtable, ow, tbl);
+
+	fprintf(fmp,
+	"//\n"
+	"// %s_sin\n"
+	"//\n"
+	"// Returns what %s.v would produce in o_val, sign extended, %d clock\n"
+	"// after i_phase is given to it.\n"
+	"//\n"
+	"static inline int32_t\t%s_sin(uint32_t i_phase) {\n"
+	"\treturn %s_tbl[i_phase & ((1u<<%s_PW)-1)];\n"
+	"}\n\n",
+		name, name, 1, name, name, prefix);
+
+	model_postamble(fmp, prefix);
+	free(prefix);
+}
+
+void	quarterwav_model(FILE *fmp, const char *name, int lgtable, int ow,
+		const long *tbl, int nlanes) {
+	char	*prefix = model_prefix(name);
+
+	model_preamble(fmp, name, prefix);
+	model_table_params(fmp, prefix, lgtable, ow, 3, nlanes);
+
+	fprintf(fmp,
+	"//\n"
+	"// The quarter wave table, exactly as found in %s.hex\n"
+	"//\n", name);
+	model_table(fmp, name, "tbl", lgtable-2, ow, tbl);
+
+	fprintf(fmp,
+	"//\n"
+	"// %s_sin\n"
+	"//\n"
+	"// Returns what %s.v would produce in o_val, sign extended, %d clocks\n"
+	"// after i_phase is given to it.\n"
+	"//\n"
+	"static inline int32_t\t%s_sin(uint32_t i_phase) {\n"
+	"\tuint32_t\tindex;\n"
+	"\tint64_t\t\tv;\n"
+	"\n"
+	"\tindex = i_phase & ((1u<<(%s_PW-2))-1);\n"
+	"\tif ((i_phase >> (%s_PW-2))&1)\n"
+	"\t\tindex = (~index) & ((1u<<(%s_PW-2))-1);\n"
+	"\tv = %s_tbl[index];\n"
+	"\tif ((i_phase >> (%s_PW-1))&1)\n"
+	"\t\tv = -v;\n"
+	"\treturn (int32_t)mdl_sext(v, %s_OW);\n"
+	"}\n\n",
+		name, name, 3, name,
+		prefix, prefix, prefix, name, prefix, prefix);
+
+	model_postamble(fmp, prefix);
+	free(prefix);
+}
+
+void	quadtbl_model(FILE *fmp, const char *name,
+		int phase_bits, int ow, int nxtra, int lgtbl, int dxlsb,
+		int cbits, int lbits, int qbits, int latency,
+		const long *ctbl, const long *ltbl, const long *qtbl) {
+	char	*prefix = model_prefix(name);
+
+	assert(phase_bits <= 32);
+	assert(cbits < 32);
+	assert(lbits > qbits);
+	assert(cbits > lbits);
+
+	model_preamble(fmp, name, prefix);
+	fprintf(fmp,
+		"static const int\t%s_PW = %d,\t// Bits in our phase variable\n"
+		"\t\t%s_OW = %d,\t// The number of output bits to produce\n"
+		"\t\t%s_XTRA = %d,\t// Extra bits for internal precision\n"
+		"\t\t%s_LGTBL = %d,\n",
+		prefix, phase_bits, prefix, ow, prefix, nxtra,
+		prefix, lgtbl);
+	if (dxlsb > 0)
+		fprintf(fmp,
+		"\t\t%s_DXLSB = %d,\t// Phase bits dropped to fit the multiplier\n",
+			prefix, dxlsb);
+	fprintf(fmp,
+		"\t\t%s_DXBITS = %d,\n"
+		"\t\t%s_QBITS = %d,\n"
+		"\t\t%s_LBITS = %d,\n"
+		"\t\t%s_CBITS = %d,\n"
+		"\t\t%s_WW = %d,\t// Working width\n"
+		"\t\t%s_LATENCY = %d;\t// Clocks from input to output\n\n",
+		prefix, phase_bits-lgtbl+1-dxlsb,
+		prefix, qbits, prefix, lbits, prefix, cbits,
+		prefix, ow+nxtra, prefix, latency);
+
+	model_table(fmp, name, "ctbl", lgtbl, cbits, ctbl);
+	model_table(fmp, name, "ltbl", lgtbl, lbits, ltbl);
+	model_table(fmp, name, "qtbl", lgtbl, qbits, qtbl);
+
+	fprintf(fmp,
+	"//\n"
+	"// %s_sin\n"
+	"//\n"
+	"// Returns what %s.v would produce in o_sin %d clocks after i_phase\n"
+	"// is given to it.\n"
+	"//\n"
+	"//	Out = (Q*DX+L)*DX+C\n"
+	"//\n"
+	"static inline int32_t\t%s_sin(uint32_t i_phase) {\n"
+	"\tconst	uint64_t\twmsk = (1ull<<%s_WW)-1;\n"
+	"\tuint32_t\tidx;\n"
+	"\tint64_t\t\tdx, qprod, lsum, lprod, r_value;\n"
+	"\tuint64_t\tw_value;\n"
+	"\n", name, name, latency, name, prefix);
+	if (dxlsb > 0)
+		fprintf(fmp,
+		"\tidx = (i_phase >> (%s_DXBITS+%s_DXLSB-1)) & ((1u<<%s_LGTBL)-1);\n"
+		"\tdx  = (i_phase >> %s_DXLSB) & ((1u<<(%s_DXBITS-1))-1);\n",
+			prefix, prefix, prefix, prefix, prefix);
+	else
+		fprintf(fmp,
+		"\tidx = (i_phase >> (%s_DXBITS-1)) & ((1u<<%s_LGTBL)-1);\n"
+		"\tdx  = i_phase & ((1u<<(%s_DXBITS-1))-1);\n",
+			prefix, prefix, prefix);
+	fprintf(fmp,
+	"\n"
+	"\tqprod = (int64_t)%s_qtbl[idx] * dx;\n"
+	"\tlsum  = mdl_sext(qprod >> (%s_DXBITS-1), %s_QBITS+1);\n"
+	"\tlsum  = mdl_sext(lsum + %s_ltbl[idx], %s_LBITS);\n"
+	"\tlprod = lsum * dx;\n"
+	"\tr_value = mdl_sext(lprod >> (%s_DXBITS-1), %s_LBITS+1);\n"
+	"\tr_value = mdl_sext(r_value + %s_ctbl[idx], %s_CBITS);\n"
+	"\n"
+	"\t// Round the output, unless doing so would overflow\n"
+	"\tw_value = (uint64_t)r_value & wmsk;\n"
+	"\tif ((!((w_value >> (%s_WW-1))&1))\n"
+	"\t\t\t&&(((w_value >> %s_XTRA) | (~0ull << (%s_WW-1-%s_XTRA)))\n"
+	"\t\t\t\t== ~0ull))\n"
+	"\t\t;\n"
+	"\telse if (((w_value >> (%s_WW-2)) == 3)\n"
+	"\t\t\t&&(((w_value >> %s_XTRA)\n"
+	"\t\t\t\t& ((1ull<<(%s_WW-2-%s_XTRA))-1)) == 0))\n"
+	"\t\t;\n"
+	"\telse if ((w_value >> %s_XTRA)&1)\n"
+	"\t\tw_value = (w_value + (1ull<<(%s_XTRA-1))) & wmsk;\n"
+	"\telse\n"
+	"\t\tw_value = (w_value + (1ull<<(%s_XTRA-1))-1) & wmsk;\n"
+	"\n"
+	"\treturn (int32_t)mdl_sext((int64_t)(w_value >> %s_XTRA), %s_OW);\n"
+	"}\n\n",
+		name, prefix, prefix, name, prefix,
+		prefix, prefix, name, prefix,
+		prefix, prefix, prefix, prefix,
+		prefix, prefix, prefix, prefix,
+		prefix, prefix, prefix,
+		prefix, prefix);
+
+	model_postamble(fmp, prefix);
+	free(prefix);
+}
+
+void	ctbl_model(FILE *fmp, const char *name,
+		int phase_bits, int ow, int abits, int bbits, int cbits,
+		int gbits, int cw, int fw, int latency,
+		const long *coarse, const long *fine) {
+	char	*prefix = model_prefix(name);
+
+	assert(phase_bits <= 32);
+	assert(cw < 32);
+	assert(fw < cw);
+
+	model_preamble(fmp, name, prefix);
+	fprintf(fmp,
+		"static const int\t%s_PW = %d,\t// Number of bits in the input phase\n"
+		"\t\t%s_OW = %d,\t// Number of output bits\n"
+		"\t\t%s_AB = %d,\t// Index bits shared by both tables\n"
+		"\t\t%s_BB = %d,\t// Index bits of the coarse table alone\n"
+		"\t\t%s_CB = %d,\t// Index bits of the fine table alone\n"
+		"\t\t%s_GB = %d,\t// Guard bits, below the output LSB\n"
+		"\t\t%s_CW = %d,\n"
+		"\t\t%s_FW = %d,\n"
+		"\t\t%s_LATENCY = %d;\t// Clocks from input to output\n\n",
+		prefix, phase_bits, prefix, ow, prefix, abits,
+		prefix, bbits, prefix, cbits, prefix, gbits,
+		prefix, cw, prefix, fw, prefix, latency);
+
+	model_table(fmp, name, "coarse", abits+bbits, cw, coarse);
+	model_table(fmp, name, "fine",   abits+cbits, fw, fine);
+
+	fprintf(fmp,
+	"//\n"
+	"// %s_sin\n"
+	"//\n"
+	"// Returns what %s.v would produce in o_val, sign extended, %d clocks\n"
+	"// after i_phase is given to it.\n"
+	"//\n"
+	"static inline int32_t\t%s_sin(uint32_t i_phase) {\n"
+	"\tconst	uint32_t\tlmsk = (1u<<(%s_PW-2))-1;\n"
+	"\tuint32_t\tindex, fidx;\n"
+	"\tint64_t\t\tv;\n"
+	"\n"
+	"\tindex = i_phase & lmsk;\n"
+	"\tif ((i_phase >> (%s_PW-2))&1)\n"
+	"\t\tindex = (~index) & lmsk;\n"
+	"\tfidx = ((index >> (%s_BB+%s_CB)) << %s_CB)\n"
+	"\t\t| (index & ((1u<<%s_CB)-1));\n"
+	"\tv = (int64_t)%s_coarse[index >> %s_CB] + %s_fine[fidx];\n"
+	"\tv = mdl_sext(v, %s_CW) >> %s_GB;\n"
+	"\tif ((i_phase >> (%s_PW-1))&1)\n"
+	"\t\tv = -v;\n"
+	"\treturn (int32_t)mdl_sext(v, %s_OW);\n"
+	"}\n\n",
+		name, name, latency, name, prefix,
+		prefix, prefix, prefix, prefix, prefix,
+		name, prefix, name,
+		prefix, prefix, prefix, prefix);
+
+	model_postamble(fmp, prefix);
+	free(prefix);
+}
+
+void	hybridcordic_model(FILE *fmp, const char *name,
+		int first, int nstages, int iw, int ow, int nxtra, int ww,
+		int phase_bits, int lgtbl, int tw,
+		const long *ctbl, const long *stbl) {
+	char	*prefix = model_prefix(name);
+	int	latency = nstages+4;
+
+	assert(phase_bits <= 32);
+	assert(ww + tw < 62);
+
+	model_preamble(fmp, name, prefix);
+	model_params(fmp, prefix, nstages, iw, ow, nxtra, ww, phase_bits,
+		latency);
+	fprintf(fmp,
+		"static const int\t%s_FIRST = %d,\t// Stages replaced by the table\n"
+		"\t\t%s_LGTBL = %d,\t// Log_2 of the number of table entries\n"
+		"\t\t%s_TW = %d;\t// Bits in each table entry\n\n",
+		prefix, first, prefix, lgtbl, prefix, tw);
+	model_angles(fmp, name, prefix, nstages, phase_bits, first);
+	model_table(fmp, name, "ctbl", lgtbl, tw, ctbl);
+	model_table(fmp, name, "stbl", lgtbl, tw, stbl);
+
+	fprintf(fmp,
+	"//\n"
+	"// %s_p2r\n"
+	"//\n"
+	"// Rotates (i_xval, i_yval) left by i_phase, producing exactly what\n"
+	"// %s.v would produce in o_xval and o_yval %d clocks later.\n"
+	"//\n"
+	"static inline void\t%s_p2r(int32_t i_xval, int32_t i_yval,\n"
+	"\t\t\tuint32_t i_phase, int32_t *o_xval, int32_t *o_yval) {\n"
+	"\tint64_t\t\te_xval, e_yval, xv, yv, nx, ny, cv, sv;\n"
+	"\tuint64_t\tph, idx;\n\n",
+		name, name, latency, name);
+
+	fprintf(fmp,
+	"\t// First step: expand our input to our working width.\n"
+	"\te_xval = mdl_shl(mdl_sext(i_xval, %s_IW), %s_WW-%s_IW-1);\n"
+	"\te_yval = mdl_shl(mdl_sext(i_yval, %s_IW), %s_WW-%s_IW-1);\n"
+	"\tph = i_phase & %s_PMASK;\n\n",
+		prefix, prefix, prefix, prefix, prefix, prefix, prefix);
+
+	fprintf(fmp,
+	"\t// Look up the coarse rotation, leaving the phase offset from the\n"
+	"\t// center of the table entry\'s segment\n"
+	"\tidx = ph >> (%s_PW-%s_LGTBL);\n"
+	"\tph  = ((ph & ((1ull<<(%s_PW-%s_LGTBL))-1))\n"
+	"\t\t- (1ull<<(%s_PW-%s_LGTBL-1))) & %s_PMASK;\n"
+	"\tcv  = %s_ctbl[idx];\n"
+	"\tsv  = %s_stbl[idx];\n\n"
+	"\t// Apply it with a complex multiply, rounding the result back\n"
+	"\t// down to our working width\n"
+	"\txv = e_xval * cv - e_yval * sv + (1ll<<(%s_TW-2));\n"
+	"\tyv = e_xval * sv + e_yval * cv + (1ll<<(%s_TW-2));\n"
+	"\txv = mdl_sext(xv >> (%s_TW-1), %s_WW);\n"
+	"\tyv = mdl_sext(yv >> (%s_TW-1), %s_WW);\n\n",
+		prefix, prefix, prefix, prefix, prefix, prefix, prefix,
+		name, name, prefix, prefix,
+		prefix, prefix, prefix, prefix);
+
+	fprintf(fmp,
+	"\tfor(int k=0; k<%s_NSTAGES; k++) {\n"
+	"\t\tint\ts = k + %s_FIRST + 1;\n\n"
+	"\t\tif ((%s_angle[k] == 0)||(s > %s_WW))\n"
+	"\t\t\tcontinue;\n"
+	"\t\tif ((ph >> (%s_PW-1))&1) {\n"
+	"\t\t\t// Negative phase, rotate clockwise\n"
+	"\t\t\tnx = xv + mdl_asr(yv, s);\n"
+	"\t\t\tny = yv - mdl_asr(xv, s);\n"
+	"\t\t\tph = ph + %s_angle[k];\n"
+	"\t\t} else {\n"
+	"\t\t\tnx = xv - mdl_asr(yv, s);\n"
+	"\t\t\tny = yv + mdl_asr(xv, s);\n"
+	"\t\t\tph = ph - %s_angle[k];\n"
+	"\t\t}\n"
+	"\t\txv = mdl_sext(nx, %s_WW);\n"
+	"\t\tyv = mdl_sext(ny, %s_WW);\n"
+	"\t\tph &= %s_PMASK;\n"
+	"\t}\n\n"
+	"\t*o_xval = (int32_t)mdl_round(xv, %s_WW, %s_OW);\n"
+	"\t*o_yval = (int32_t)mdl_round(yv, %s_WW, %s_OW);\n"
+	"}\n\n",
+		prefix, prefix, name, prefix, prefix, name, name,
+		prefix, prefix, prefix,
+		prefix, prefix, prefix, prefix);
+
+	fprintf(fmp,
+	"//\n"
+	"// %s_p2r_batch\n"
+	"//\n"
+	"// Applies %s_p2r() to each of n samples.\n"
+	"//\n"
+	"static inline void\t%s_p2r_batch(const int32_t *i_xval,\n"
+	"\t\t\tconst int32_t *i_yval, const uint32_t *i_phase,\n"
+	"\t\t\tint32_t *o_xval, int32_t *o_yval, size_t n) {\n"
+	"\t// The table lookups keep this off of the vectorized fast path\n"
+	"\tfor(size_t i=0; i<n; i++)\n"
+	"\t\t%s_p2r(i_xval[i], i_yval[i], i_phase[i], &o_xval[i], &o_yval[i]);\n"
+	"}\n\n", name, name, name, name);
+
+	model_postamble(fmp, prefix);
+	free(prefix);
+}
+
+//
+// model_r4_update
+//
+// Writes out the new value of v, either xv or yv, once rotated by the
+// radix-4 digit sigma at a shift of s, each term rounded, just as
+// r4_update() does for the Verilog.  u is the other of the two, and cs the shift of the gain
+// correcting term, or zero for none.
+static	void	model_r4_update(char *str, const char *v, const char *u,
+		bool isy, int sigma, int s, int cs) {
+	char	op = ((sigma > 0) == isy) ? '+' : '-';
+	bool	three = (sigma == 3)||(sigma == -3);
+	int	n;
+
+	n = sprintf(str, "%s", v);
+	if (three)
+		n += sprintf(str+n, "\n\t\t\t%c (mdl_asr(%s, %d) + (mdl_asr(%s, %d)&1))",
+			op, u, s, u, s-1);
+	n += sprintf(str+n, "\n\t\t\t%c (mdl_asr(%s, %d) + (mdl_asr(%s, %d)&1))",
+		op, u, s+1, u, s);
+	if (cs > 0)
+		sprintf(str+n, "\n\t\t\t%c (mdl_asr(%s, %d) + (mdl_asr(%s, %d)&1))",
+			(three) ? '-' : '+', v, cs, v, cs-1);
+}
+
+//
+// model_radix4_stage
+//
+// Writes out the pipeline stage of a radix-4 core starting from radix-2
+// stage k.  With p2r, the digit is picked from the phase, as radix4cordic()
+// picks it, otherwise from the sign of y, as radix4polar() does.
+static	void	model_radix4_stage(FILE *fmp, const char *prefix, bool p2r,
+		int k, int nstages, int ww, int phase_bits) {
+	int	n = radix4_rotations(k, nstages, ww, phase_bits),
+		s = k+1, cs = 2*s+1;
+	char	neg[64];
+
+	if (n == 0)
+		return;
+
+	sprintf(neg, "((ph >> (%s_PW-1))&1)", prefix);
+	if (n == 1) {
+		fprintf(fmp,
+		"\t// Stage %d, by atan(2^-%d) alone\n"
+		"\tif (%s%s) {\n"
+		"\t\tnx = xv - mdl_asr(yv, %d);\n"
+		"\t\tny = yv + mdl_asr(xv, %d);\n"
+		"\t\tph -= 0x%lxull;\n"
+		"\t} else {\n"
+		"\t\tnx = xv + mdl_asr(yv, %d);\n"
+		"\t\tny = yv - mdl_asr(xv, %d);\n"
+		"\t\tph += 0x%lxull;\n"
+		"\t}\n", k/2, s,
+			(p2r) ? "!" : "", (p2r) ? neg : "yv < 0",
+			s, s, cordic_angle_value(k, phase_bits),
+			s, s, cordic_angle_value(k, phase_bits));
+	} else {
+		const	int	p2r_digit[4] = { 3, 1, -1, -3 },
+				r2p_digit[4] = { 3, 1, -3, -1 };
+		const	int	*digit = (p2r) ? p2r_digit : r2p_digit;
+		unsigned long	t = cordic_angle_value(k, phase_bits);
+		char	cond[3][96], upd[320];
+
+		if (cs >= ww)
+			cs = 0;
+		fprintf(fmp, "\t// Stage %d, by atan(2^-%d) and atan(2^-%d)\n",
+			k/2, s, s+1);
+		if (p2r) {
+			sprintf(cond[0], "(!%s)&&(ph >= 0x%lxull)", neg, t);
+			sprintf(cond[1], "!%s", neg);
+			sprintf(cond[2], "ph >= 0x%lxull",
+				(1ul << phase_bits) - t);
+		} else {
+			fprintf(fmp,
+		"\try = mdl_sext((yv < 0) ? (yv + mdl_asr(xv, %d))\n"
+		"\t\t\t: (yv - mdl_asr(xv, %d)), %s_WW);\n", s, s, prefix);
+			sprintf(cond[0], "(yv < 0)&&(ry < 0)");
+			sprintf(cond[1], "yv < 0");
+			sprintf(cond[2], "ry >= 0");
+		}
+
+		for(int d=0; d<4; d++) {
+			int	sigma = digit[d];
+
+			if (d == 0)
+				fprintf(fmp, "\tif (%s) {\n", cond[d]);
+			else if (d < 3)
+				fprintf(fmp, "\t} else if (%s) {\n", cond[d]);
+			else
+				fprintf(fmp, "\t} else {\n");
+			model_r4_update(upd, "xv", "yv", false, sigma, s, cs);
+			fprintf(fmp, "\t\tnx = %s;\n", upd);
+			model_r4_update(upd, "yv", "xv", true, sigma, s, cs);
+			fprintf(fmp, "\t\tny = %s;\n", upd);
+			fprintf(fmp, "\t\tph %c= 0x%lxull;\n",
+				(sigma > 0) ? '-' : '+',
+				radix4_angle_value(k,
+					((sigma == 3)||(sigma == -3)) ? 3 : 1,
+					phase_bits));
+		} fprintf(fmp, "\t}\n");
+	}
+
+	fprintf(fmp,
+	"\txv = mdl_sext(nx, %s_WW);\n"
+	"\tyv = mdl_sext(ny, %s_WW);\n"
+	"\tph &= %s_PMASK;\n\n", prefix, prefix, prefix);
+}
+
+void	radix4cordic_model(FILE *fmp, const char *name,
+		int nstages, int iw, int ow, int nxtra, int ww,
+		int phase_bits) {
+	char	*prefix = model_prefix(name);
+	int	npipe = (nstages+1)/2, latency = npipe+2;
+
+	assert(phase_bits <= 32);
+	assert(ww < 62);
+
+	model_preamble(fmp, name, prefix);
+	model_params(fmp, prefix, nstages, iw, ow, nxtra, ww, phase_bits,
+		latency);
+	fprintf(fmp, "static const int\t%s_NPIPE = %d;\t// Pipeline stages\n\n",
+		prefix, npipe);
+
+	fprintf(fmp,
+	"//\n"
+	"// %s_p2r\n"
+	"//\n"
+	"// Rotates (i_xval, i_yval) left by i_phase, producing exactly what\n"
+	"// %s.v would produce in o_xval and o_yval %d clocks later.\n"
+	"//\n"
+	"static inline void\t%s_p2r(int32_t i_xval, int32_t i_yval,\n"
+	"\t\t\tuint32_t i_phase, int32_t *o_xval, int32_t *o_yval) {\n"
+	"\tint64_t\t\te_xval, e_yval, xv, yv, nx, ny;\n"
+	"\tuint64_t\tph;\n\n",
+		name, name, latency, name);
+
+	model_p2r_prerotate(fmp, prefix, phase_bits);
+
+	for(int k=0; k<nstages; k+=2)
+		model_radix4_stage(fmp, prefix, true, k, nstages, ww,
+			phase_bits);
+
+	fprintf(fmp,
+	"\t*o_xval = (int32_t)mdl_round(xv, %s_WW, %s_OW);\n"
+	"\t*o_yval = (int32_t)mdl_round(yv, %s_WW, %s_OW);\n"
+	"}\n\n", prefix, prefix, prefix, prefix);
+
+	fprintf(fmp,
+	"//\n"
+	"// %s_p2r_batch\n"
+	"//\n"
+	"// Applies %s_p2r() to each of n samples.\n"
+	"//\n"
+	"static inline void\t%s_p2r_batch(const int32_t *i_xval,\n"
+	"\t\t\tconst int32_t *i_yval, const uint32_t *i_phase,\n"
+	"\t\t\tint32_t *o_xval, int32_t *o_yval, size_t n) {\n"
+	"\t// The digit selection keeps this off of the vectorized fast path\n"
+	"\tfor(size_t i=0; i<n; i++)\n"
+	"\t\t%s_p2r(i_xval[i], i_yval[i], i_phase[i], &o_xval[i], &o_yval[i]);\n"
+	"}\n\n", name, name, name, name);
+
+	model_postamble(fmp, prefix);
+	free(prefix);
+}
+
+void	radix4polar_model(FILE *fmp, const char *name,
+		int nstages, int iw, int ow, int nxtra, int ww,
+		int phase_bits) {
+	char	*prefix = model_prefix(name);
+	int	npipe = (nstages+1)/2, latency = npipe+2;
+
+	assert(phase_bits <= 32);
+	assert(ww < 62);
+
+	model_preamble(fmp, name, prefix);
+	model_params(fmp, prefix, nstages, iw, ow, nxtra, ww, phase_bits,
+		latency);
+	fprintf(fmp, "static const int\t%s_NPIPE = %d;\t// Pipeline stages\n\n",
+		prefix, npipe);
+
+	fprintf(fmp,
+	"//\n"
+	"// %s_r2p\n"
+	"//\n"
+	"// Converts (i_xval, i_yval) to polar coordinates, producing exactly\n"
+	"// what %s.v would produce in o_mag and o_phase %d clocks later.\n"
+	"//\n"
+	"static inline void\t%s_r2p(int32_t i_xval, int32_t i_yval,\n"
+	"\t\t\tint32_t *o_mag, uint32_t *o_phase) {\n"
+	"\tint64_t\t\te_xval, e_yval, xv, yv, nx, ny, ry;\n"
+	"\tuint64_t\tph;\n\n",
+		name, name, latency, name);
+
+	model_r2p_prerotate(fmp, prefix, phase_bits);
+
+	for(int k=0; k<nstages; k+=2)
+		model_radix4_stage(fmp, prefix, false, k, nstages, ww,
+			phase_bits);
+
+	fprintf(fmp,
+	"\t(void)ry;\n"
+	"\t*o_mag   = (int32_t)mdl_round(xv, %s_WW, %s_OW);\n"
+	"\t*o_phase = (uint32_t)ph;\n"
+	"}\n\n", prefix, prefix);
+
+	fprintf(fmp,
+	"//\n"
+	"// %s_r2p_batch\n"
+	"//\n"
+	"// Applies %s_r2p() to each of n samples.\n"
+	"//\n"
+	"static inline void\t%s_r2p_batch(const int32_t *i_xval,\n"
+	"\t\t\tconst int32_t *i_yval,\n"
+	"\t\t\tint32_t *o_mag, uint32_t *o_phase, size_t n) {\n"
+	"\t// The digit selection keeps this off of the vectorized fast path\n"
+	"\tfor(size_t i=0; i<n; i++)\n"
+	"\t\t%s_r2p(i_xval[i], i_yval[i], &o_mag[i], &o_phase[i]);\n"
+	"}\n\n", name, name, name, name);
+
+	model_postamble(fmp, prefix);
+	free(prefix);
+}
@@ -0,0 +1,94 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename: 	swmodel.h
+//
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	Declares the routines used to write bit-accurate C++ software
+//		models of each of the cores this generator produces.  The
+//		CORDIC models also come with a _batch() variant, written so
+//		as to be vectorized by the compiler, for processing many
+//		samples at once.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2017-2018, Gisselquist Technology, LLC
+//
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+//
+// License:	GPL, v3, as defined and found on www.gnu.org,
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+//
+#ifndef	SWMODEL_H
+#define	SWMODEL_H
+
+#include <stdio.h>
+
+//
+// model_fits, table_model_fits
+//
+// The models hold the phase in 32 bits, and work in 64-bit arithmetic, or
+// in 32-bit tables for the table cores.  These return false for a core too
+// wide for its model: one with more than 32 phase bits, a working width of
+// 62 bits or more, or table entries wider than 32 bits.
+//
+extern	bool	model_fits(int ww, int phase_bits);
+extern	bool	table_model_fits(int tw, int phase_bits);
+
+extern	void	basiccordic_model(FILE *fmp, const char *name,
+			int nstages, int iw, int ow, int nxtra, int ww,
+			int phase_bits, int latency = 0);
+extern	void	cordic_template(FILE *fhp, const char *name);
+extern	void	seqcordic_model(FILE *fmp, const char *name,
+			int nstages, int iw, int ow, int nxtra, int ww,
+			int phase_bits);
+extern	void	topolar_model(FILE *fmp, const char *name,
+			int nstages, int iw, int ow, int nxtra, int ww,
+			int phase_bits, int latency = 0);
+extern	void	seqpolar_model(FILE *fmp, const char *name,
+			int nstages, int iw, int ow, int nxtra, int ww,
+			int phase_bits);
+extern	void	radix4cordic_model(FILE *fmp, const char *name,
+			int nstages, int iw, int ow, int nxtra, int ww,
+			int phase_bits);
+extern	void	radix4polar_model(FILE *fmp, const char *name,
+			int nstages, int iw, int ow, int nxtra, int ww,
+			int phase_bits);
+extern	void	hybridcordic_model(FILE *fmp, const char *name,
+			int first, int nstages, int iw, int ow, int nxtra,
+			int ww, int phase_bits, int lgtbl, int tw,
+			const long *ctbl, const long *stbl);
+extern	void	sintable_model(FILE *fmp, const char *name,
+			int lgtable, int ow, const long *tbl, int nlanes = 1);
+extern	void	quarterwav_model(FILE *fmp, const char *name,
+			int lgtable, int ow, const long *tbl, int nlanes = 1);
+extern	void	ctbl_model(FILE *fmp, const char *name,
+			int phase_bits, int ow, int abits, int bbits, int cbits,
+			int gbits, int cw, int fw, int latency,
+			const long *coarse, const long *fine);
+extern	void	quadtbl_model(FILE *fmp, const char *name,
+			int phase_bits, int ow, int nxtra, int lgtbl, int dxlsb,
+			int cbits, int lbits, int qbits, int latency,
+			const long *ctbl, const long *ltbl, const long *qtbl);
+
+#endif	// SWMODEL_H
@@ -45,12 +45,15 @@
 #include "legal.h"
 #include "cordiclib.h"
 #include "topolar.h"
+#include "swmodel.h"
+#include "lanes.h"
 
 void	topolar(FILE *fp, FILE *fhp, const char *fname, int nstages, int iw, int ow,
 		int nxtra, int phase_bits, bool with_reset, bool with_aux,
-		bool async_reset) {
-	int	working_width = iw;
-	const	char	*name;
+		bool async_reset, FILE *fmp, int nlanes, int kstages) {
+	int	working_width = iw, npipe;
+	const	char	*name, *depth;
+	std::string	lanename, pipeparam;
 	const	char PURPOSE[] =
 	"This is a rectangular to polar conversion routine based upon an\n"
 	"//\t\tinternal CORDIC implementation.  Basically, the input is\n"
@@ -72,7 +75,30 @@ void	topolar(FILE *fp, FILE *fhp, const char *fname, int nstages, int iw, int ow
 	working_width += nxtra;
 
 	working_width += nxtra;
+
+	// With kstages > 1, each pipeline stage applies kstages CORDIC
+	// stages.  Round the number of stages up to a multiple of kstages,
+	// since the extra stages cost no more clocks.
+	npipe = nstages;
+	depth = "NSTAGES";
+	if (kstages > 1) {
+		char	str[160];
+
+		nstages = ((nstages + kstages - 1) / kstages) * kstages;
+		npipe = nstages / kstages;
+		depth = "NPIPE";
+		sprintf(str, "\t\t\tKSTAGES=%2d,\t// CORDIC stages per clock\n"
+			"\t\t\tNPIPE=%2d,\t// Pipeline stages, KSTAGES CORDIC stages each\n",
+			kstages, npipe);
+		pipeparam = str;
+	}
+
 	name = modulename(fname);
+	// With more than one lane, this module becomes the lane, and the
+	// module by the requested name is built from copies of it below
+	lanename = name;
+	if (nlanes > 1)
+		lanename += "_lane";
 
 	std::string	resetw = (!with_reset) ? ""
 			: (async_reset) ? "i_areset_n, ":"i_reset, ";
@@ -90,7 +116,7 @@ void	topolar(FILE *fp, FILE *fhp, const char *fname, int nstages, int iw, int ow
 		"\t\to_mag, o_phase%s);\n"
 		"\tlocalparam\tIW=%2d,\t// The number of bits in our inputs\n"
 		"\t\t\tOW=%2d,// The number of output bits to produce\n"
-		"\t\t\tNSTAGES=%2d,\n"
+		"\t\t\tNSTAGES=%2d,\n%s"
 		"\t\t\tXTRA=%2d,// Extra bits for internal precision\n"
 		"\t\t\tWW=%2d,\t// Our working bit-width\n"
 		"\t\t\tPW=%2d;\t// Bits in our phase variables\n"
@@ -98,9 +124,10 @@ void	topolar(FILE *fp, FILE *fhp, const char *fname, int nstages, int iw, int ow
 		"\tinput\twire\tsigned\t[(IW-1):0]\ti_xval, i_yval;\n"
 		"\toutput\treg\tsigned\t[(OW-1):0]\to_mag;\n"
 		"\toutput\treg\t\t[(PW-1):0]\to_phase;\n",
-		name, resetw.c_str(),
+		lanename.c_str(), resetw.c_str(),
 		(with_aux)?" i_aux,":"", (with_aux)?", o_aux":"",
-		iw, ow, nstages, nxtra, working_width, phase_bits,
+		iw, ow, nstages, pipeparam.c_str(),
+		nxtra, working_width, phase_bits,
 		resetw.c_str());
 
 	if (with_aux) {
@@ -137,9 +164,9 @@ void	topolar(FILE *fp, FILE *fhp, const char *fname, int nstages, int iw, int ow
 		"\t// Declare variables for all of the separate stages\n");
 
 	fprintf(fp,
-		"\treg	signed	[(WW-1):0]	xv	[0:NSTAGES];\n"
-		"\treg	signed	[(WW-1):0]	yv	[0:NSTAGES];\n"
-		"\treg		[(PW-1):0]	ph	[0:NSTAGES];\n\n");
+		"\treg	signed	[(WW-1):0]	xv	[0:%s];\n"
+		"\treg	signed	[(WW-1):0]	yv	[0:%s];\n"
+		"\treg		[(PW-1):0]	ph	[0:%s];\n\n", depth, depth, depth);
 
 	if (with_aux) {
 		fprintf(fp,
@@ -153,19 +180,19 @@ void	topolar(FILE *fp, FILE *fhp, const char *fname, int nstages, int iw, int ow
 "\t// are input together with i_aux, then when o_xval and o_yval are set\n"
 "\t// to this value, o_aux *must* contain the value that was in i_aux.\n"
 "\t//\n"
-"\treg\t\t[(NSTAGES):0]\tax;\n"
-"\n");
+"\treg\t\t[(%s):0]\tax;\n"
+"\n", depth);
 
 		fprintf(fp, "%s", always_reset.c_str());
 
 		if (with_reset)
 			fprintf(fp,
-"\t\tax <= {(NSTAGES+1){1'b0}};\n"
-"\telse ");
+"\t\tax <= {(%s+1){1'b0}};\n"
+"\telse ", depth);
 
 		fprintf(fp, "if (i_ce)\n"
-"\t\tax <= { ax[(NSTAGES-1):0], i_aux };\n"
-"\n");
+"\t\tax <= { ax[(%s-1):0], i_aux };\n"
+"\n", depth);
 	}
 
 	fprintf(fp,
@@ -218,70 +245,167 @@ void	topolar(FILE *fp, FILE *fhp, const char *fname, int nstages, int iw, int ow
 
 	cordic_angles(fp, nstages, phase_bits);
 
-	fprintf(fp,"\n"
-		"\tgenvar\ti;\n"
-		"\tgenerate for(i=0; i<NSTAGES; i=i+1) begin : TOPOLARloop\n");
+	if (kstages > 1) {
+		char	sidx[32], shift[32], xi[16], yi[16], pi[16];
 
-	if ((with_reset)&&(async_reset))
-		fprintf(fp,
-			"\t\talways @(posedge i_clk, negedge i_areset_n)\n");
-	else
+		fprintf(fp,"\n"
+		"\tgenvar\ti;\n"
+		"\tgenerate for(i=0; i<NPIPE; i=i+1) begin : TOPOLARloop\n");
 		fprintf(fp,
-		"\t\talways @(posedge i_clk)\n");
-
-	fprintf(fp,
 		"\t\t// Here\'s where we are going to put the actual CORDIC\n"
-		"\t\t// rectangular to polar loop.  Everything up to this\n"
-		"\t\t// point has simply been necessary preliminaries.\n");
-	if (with_reset) {
-		if (async_reset)
-			fprintf(fp, "\t\tif (!i_areset_n)\n");
+		"\t\t// rectangular to polar loop.  Each pipeline stage applies\n"
+		"\t\t// KSTAGES CORDIC stages, KSTAGES*i through KSTAGES*i+KSTAGES-1,\n"
+		"\t\t// each acting upon the result of the one before.  It takes\n"
+		"\t\t// only 1/KSTAGES as many clocks to get through all of the\n"
+		"\t\t// stages, but no fewer adders, and the KSTAGES adders of\n"
+		"\t\t// each clock are chained together.\n");
+
+		strcpy(xi, "xv[i]"); strcpy(yi, "yv[i]"); strcpy(pi, "ph[i]");
+		for(int j=0; j<kstages-1; j++) {
+			if (j == 0)
+				strcpy(sidx, "KSTAGES*i");
+			else
+				sprintf(sidx, "KSTAGES*i+%d", j);
+			sprintf(shift, "KSTAGES*i+%d", j+1);
+			fprintf(fp, "\n"
+			"\t\t// Stage %s\n"
+			"\t\twire\tsigned\t[(WW-1):0]\tsx%d, sy%d;\n"
+			"\t\twire\t\t[(PW-1):0]\tsph%d;\n"
+			"\t\twire\t\t\t\tskip%d;\n\n"
+			"\t\tassign\tskip%d = (cordic_angle[%s] == 0)||(%s >= WW);\n"
+			"\t\tassign\tsx%d = (skip%d) ? %s\n"
+			"\t\t\t: (%s[(WW-1)]) ? (%s - (%s>>>(%s)))\n"
+			"\t\t\t: (%s + (%s>>>(%s)));\n"
+			"\t\tassign\tsy%d = (skip%d) ? %s\n"
+			"\t\t\t: (%s[(WW-1)]) ? (%s + (%s>>>(%s)))\n"
+			"\t\t\t: (%s - (%s>>>(%s)));\n"
+			"\t\tassign\tsph%d = (skip%d) ? %s\n"
+			"\t\t\t: (%s[(WW-1)]) ? (%s - cordic_angle[%s])\n"
+			"\t\t\t: (%s + cordic_angle[%s]);\n",
+				sidx, j+1, j+1, j+1, j,
+				j, sidx, sidx,
+				j+1, j, xi, yi, xi, yi, shift, xi, yi, shift,
+				j+1, j, yi, yi, yi, xi, shift, yi, xi, shift,
+				j+1, j, pi, yi, pi, sidx, pi, sidx);
+			sprintf(xi, "sx%d", j+1);
+			sprintf(yi, "sy%d", j+1);
+			sprintf(pi, "sph%d", j+1);
+		}
+
+		sprintf(sidx, "KSTAGES*i+%d", kstages-1);
+		sprintf(shift, "KSTAGES*i+%d", kstages);
+		fprintf(fp, "\n\t\t// Stage %s, the last of this clock\n", sidx);
+
+		if ((with_reset)&&(async_reset))
+			fprintf(fp,
+			"\t\talways @(posedge i_clk, negedge i_areset_n)\n");
 		else
-			fprintf(fp, "\t\tif (i_reset)\n");
-		fprintf(fp,
+			fprintf(fp,
+			"\t\talways @(posedge i_clk)\n");
+
+		if (with_reset) {
+			if (async_reset)
+				fprintf(fp, "\t\tif (!i_areset_n)\n");
+			else
+				fprintf(fp, "\t\tif (i_reset)\n");
+			fprintf(fp,
 			"\t\tbegin\n"
 			"\t\t\txv[i+1] <= 0;\n"
 			"\t\t\tyv[i+1] <= 0;\n"
 			"\t\t\tph[i+1] <= 0;\n"
 			"\t\tend else if (i_ce)\n");
-	} else
-		fprintf(fp,
+		} else
+			fprintf(fp,
 			"\t\tif (i_ce)\n");
 
-	fprintf(fp,
+		fprintf(fp,
 		"\t\tbegin\n"
-		"\t\t\tif ((cordic_angle[i] == 0)||(i >= WW))\n"
-		"\t\t\tbegin // Do nothing but move our vector\n"
-		"\t\t\t// forward one stage, since we have more\n"
-		"\t\t\t// stages than valid data\n"
-		"\t\t\t\txv[i+1] <= xv[i];\n"
-		"\t\t\t\tyv[i+1] <= yv[i];\n"
-		"\t\t\t\tph[i+1] <= ph[i];\n"
-		"\t\t\tend else if (yv[i][(WW-1)]) // Below the axis\n"
+		"\t\t\tif ((cordic_angle[%s] == 0)||(%s >= WW))\n"
 		"\t\t\tbegin\n"
-		"\t\t\t\t// If the vector is below the x-axis, rotate by\n"
-		"\t\t\t\t// the CORDIC angle in a positive direction.\n"
-		"\t\t\t\txv[i+1] <= xv[i] - (yv[i]>>>(i+1));\n"
-		"\t\t\t\tyv[i+1] <= yv[i] + (xv[i]>>>(i+1));\n"
-		"\t\t\t\tph[i+1] <= ph[i] - cordic_angle[i];\n"
+		"\t\t\t\txv[i+1] <= %s;\n"
+		"\t\t\t\tyv[i+1] <= %s;\n"
+		"\t\t\t\tph[i+1] <= %s;\n"
+		"\t\t\tend else if (%s[(WW-1)]) // Below the axis\n"
+		"\t\t\tbegin\n"
+		"\t\t\t\txv[i+1] <= %s - (%s>>>(%s));\n"
+		"\t\t\t\tyv[i+1] <= %s + (%s>>>(%s));\n"
+		"\t\t\t\tph[i+1] <= %s - cordic_angle[%s];\n"
 		"\t\t\tend else begin\n"
-		"\t\t\t\t// On the other hand, if the vector is above the\n"
-		"\t\t\t\t// x-axis, then rotate in the other direction\n"
-		"\t\t\t\txv[i+1] <= xv[i] + (yv[i]>>>(i+1));\n"
-		"\t\t\t\tyv[i+1] <= yv[i] - (xv[i]>>>(i+1));\n"
-		"\t\t\t\tph[i+1] <= ph[i] + cordic_angle[i];\n"
+		"\t\t\t\txv[i+1] <= %s + (%s>>>(%s));\n"
+		"\t\t\t\tyv[i+1] <= %s - (%s>>>(%s));\n"
+		"\t\t\t\tph[i+1] <= %s + cordic_angle[%s];\n"
 		"\t\t\tend\n"
 		"\t\tend\n"
-		"\tend endgenerate\n\n");
+		"\tend endgenerate\n\n",
+			sidx, sidx, xi, yi, pi, yi,
+			xi, yi, shift, yi, xi, shift, pi, sidx,
+			xi, yi, shift, yi, xi, shift, pi, sidx);
+	} else {
+		fprintf(fp,"\n"
+			"\tgenvar\ti;\n"
+			"\tgenerate for(i=0; i<NSTAGES; i=i+1) begin : TOPOLARloop\n");
+
+		if ((with_reset)&&(async_reset))
+			fprintf(fp,
+				"\t\talways @(posedge i_clk, negedge i_areset_n)\n");
+		else
+			fprintf(fp,
+			"\t\talways @(posedge i_clk)\n");
+
+		fprintf(fp,
+			"\t\t// Here\'s where we are going to put the actual CORDIC\n"
+			"\t\t// rectangular to polar loop.  Everything up to this\n"
+			"\t\t// point has simply been necessary preliminaries.\n");
+		if (with_reset) {
+			if (async_reset)
+				fprintf(fp, "\t\tif (!i_areset_n)\n");
+			else
+				fprintf(fp, "\t\tif (i_reset)\n");
+			fprintf(fp,
+				"\t\tbegin\n"
+				"\t\t\txv[i+1] <= 0;\n"
+				"\t\t\tyv[i+1] <= 0;\n"
+				"\t\t\tph[i+1] <= 0;\n"
+				"\t\tend else if (i_ce)\n");
+		} else
+			fprintf(fp,
+				"\t\tif (i_ce)\n");
+
+		fprintf(fp,
+			"\t\tbegin\n"
+			"\t\t\tif ((cordic_angle[i] == 0)||(i >= WW))\n"
+			"\t\t\tbegin // Do nothing but move our vector\n"
+			"\t\t\t// forward one stage, since we have more\n"
+			"\t\t\t// stages than valid data\n"
+			"\t\t\t\txv[i+1] <= xv[i];\n"
+			"\t\t\t\tyv[i+1] <= yv[i];\n"
+			"\t\t\t\tph[i+1] <= ph[i];\n"
+			"\t\t\tend else if (yv[i][(WW-1)]) // Below the axis\n"
+			"\t\t\tbegin\n"
+			"\t\t\t\t// If the vector is below the x-axis, rotate by\n"
+			"\t\t\t\t// the CORDIC angle in a positive direction.\n"
+			"\t\t\t\txv[i+1] <= xv[i] - (yv[i]>>>(i+1));\n"
+			"\t\t\t\tyv[i+1] <= yv[i] + (xv[i]>>>(i+1));\n"
+			"\t\t\t\tph[i+1] <= ph[i] - cordic_angle[i];\n"
+			"\t\t\tend else begin\n"
+			"\t\t\t\t// On the other hand, if the vector is above the\n"
+			"\t\t\t\t// x-axis, then rotate in the other direction\n"
+			"\t\t\t\txv[i+1] <= xv[i] + (yv[i]>>>(i+1));\n"
+			"\t\t\t\tyv[i+1] <= yv[i] - (xv[i]>>>(i+1));\n"
+			"\t\t\t\tph[i+1] <= ph[i] + cordic_angle[i];\n"
+			"\t\t\tend\n"
+			"\t\tend\n"
+			"\tend endgenerate\n\n");
+	}
 
 	if (working_width > ow+1) {
 		fprintf(fp,
 			"\t// Round our magnitude towards even\n"
 			"\twire\t[(WW-1):0]\tpre_mag;\n\n"
-			"\tassign\tpre_mag = xv[NSTAGES] + $signed({{(OW){1\'b0}},\n"
-				"\t\t\t\txv[NSTAGES][(WW-OW)],\n"
-				"\t\t\t\t{(WW-OW-1){!xv[NSTAGES][WW-OW]}}});\n"
-			"\n");
+			"\tassign\tpre_mag = xv[%s] + $signed({{(OW){1\'b0}},\n"
+				"\t\t\t\txv[%s][(WW-OW)],\n"
+				"\t\t\t\t{(WW-OW-1){!xv[%s][WW-OW]}}});\n"
+			"\n", depth, depth, depth);
 
 		fprintf(fp, "%s", always_reset.c_str());
 		if (with_reset) {
@@ -298,10 +422,10 @@ void	topolar(FILE *fp, FILE *fhp, const char *fname, int nstages, int iw, int ow
 		fprintf(fp, "if (i_ce)\n"
 			"\tbegin\n"
 			"\t\to_mag   <= pre_mag[(WW-1):(WW-OW)];\n"
-			"\t\to_phase <= ph[NSTAGES];\n");
+			"\t\to_phase <= ph[%s];\n", depth);
 		if (with_aux)
 			fprintf(fp,
-			"\t\to_aux <= ax[NSTAGES];\n");
+			"\t\to_aux <= ax[%s];\n", depth);
 		fprintf(fp, "\tend\n\n");
 
 		fprintf(fp, "\t// Make Verilator happy with pre_.val\n"
@@ -324,15 +448,28 @@ void	topolar(FILE *fp, FILE *fhp, const char *fname, int nstages, int iw, int ow
 
 		fprintf(fp, "if (i_ce)\n"
 			"\tbegin\t// We accumulate a bit during our processing, so shift by one\n"
-			"\t\to_mag   <= xv[NSTAGES][(WW-1):(WW-OW)];\n"
-			"\t\to_phase <= ph[NSTAGES];\n");
+			"\t\to_mag   <= xv[%s][(WW-1):(WW-OW)];\n"
+			"\t\to_phase <= ph[%s];\n", depth, depth);
 		if (with_aux)
-			fprintf(fp, "\t\to_aux  <= ax[NSTAGES];\n");
+			fprintf(fp, "\t\to_aux  <= ax[%s];\n", depth);
 		fprintf(fp, "\tend\n\n");
 	}
 
 	fprintf(fp, "endmodule\n");
 
+	if (nlanes > 1) {
+		const LANEPORT	inputs[] = {
+			{ "i_xval",  "IW", iw },
+			{ "i_yval",  "IW", iw } },
+				outputs[] = {
+			{ "o_mag",   "OW", ow },
+			{ "o_phase", "PW", phase_bits } };
+
+		lanes_wrapper(fp, name, lanename.c_str(), nlanes,
+			with_reset, with_aux, async_reset,
+			2, inputs, 2, outputs);
+	}
+
 	if (NULL != fhp) {
 		char	*str = new char[strlen(name)+4], *ptr;
 		sprintf(str, "%s.h", name);
@@ -354,6 +491,12 @@ void	topolar(FILE *fp, FILE *fhp, const char *fname, int nstages, int iw, int ow
 		fprintf(fhp, "const int	WW = %d;\n", working_width);
 		fprintf(fhp, "const int	PW = %d;\n", phase_bits);
 		fprintf(fhp, "const int	NSTAGES = %d;\n", nstages);
+		if (kstages > 1) {
+			fprintf(fhp, "const int	KSTAGES = %d;\n", kstages);
+			fprintf(fhp, "const int	NPIPE = %d;\n", npipe);
+		}
+		if (nlanes > 1)
+			fprintf(fhp, "const int	NLANES = %d;\n", nlanes);
 		fprintf(fhp, "const double\tQUANTIZATION_VARIANCE = %.16f; // (Units^2)\n",
 			transform_quantization_variance(nstages,
 				working_width-iw, working_width-ow));
@@ -371,4 +514,8 @@ void	topolar(FILE *fp, FILE *fhp, const char *fname, int nstages, int iw, int ow
 
 		delete[] str;
 	}
+
+	if (NULL != fmp)
+		topolar_model(fmp, name, nstages, iw, ow, nxtra,
+			working_width, phase_bits, npipe+2);
 }